@@ -0,0 +1,166 @@
+/**
+ * @file bench/bench_util.hpp
+ * @author Ryan Curtin
+ *
+ * A tiny micro-benchmark harness for the mlpack_bench target.  Benchmarks are
+ * registered at static initialization time with the MLPACK_BENCHMARK() macro;
+ * the harness runs each one with untimed warmup iterations followed by a
+ * fixed number of timed repetitions, and reports simple statistics so that
+ * runs can be compared across releases and machines.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BENCH_BENCH_UTIL_HPP
+#define MLPACK_BENCH_BENCH_UTIL_HPP
+
+#include <mlpack/core.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace mlpack {
+namespace bench {
+
+/**
+ * A single registered micro-benchmark.  The function performs one measured
+ * iteration of the kernel on data that was prepared (with a fixed random
+ * seed) outside of the timed region.
+ */
+struct Benchmark
+{
+  //! Name of the benchmark, e.g. "lmetric_evaluate".
+  std::string name;
+  //! One measured iteration of the kernel.
+  std::function<void()> function;
+  //! Number of timed repetitions to run.
+  size_t repetitions;
+};
+
+/**
+ * The global registry of benchmarks, filled by MLPACK_BENCHMARK() during
+ * static initialization.
+ */
+inline std::vector<Benchmark>& Registry()
+{
+  static std::vector<Benchmark> registry;
+  return registry;
+}
+
+/**
+ * Helper type whose constructor registers a benchmark; used only by the
+ * MLPACK_BENCHMARK() macro.
+ */
+struct RegisterBenchmark
+{
+  RegisterBenchmark(const std::string& name,
+                    std::function<void()> function,
+                    const size_t repetitions = 10)
+  {
+    Registry().push_back(Benchmark{ name, std::move(function), repetitions });
+  }
+};
+
+/**
+ * Statistics over the timed repetitions of one benchmark, in microseconds.
+ */
+struct BenchmarkResult
+{
+  double minimum;
+  double median;
+  double mean;
+  double stddev;
+};
+
+/**
+ * Run the given benchmark: a few untimed warmup iterations (which also fault
+ * in lazily-initialized state), then the timed repetitions.
+ *
+ * @param benchmark The benchmark to run.
+ * @param warmup Number of untimed warmup iterations.
+ */
+inline BenchmarkResult Run(const Benchmark& benchmark, const size_t warmup = 3)
+{
+  typedef std::chrono::steady_clock Clock;
+
+  for (size_t i = 0; i < warmup; ++i)
+    benchmark.function();
+
+  std::vector<double> samples(benchmark.repetitions);
+  for (size_t i = 0; i < benchmark.repetitions; ++i)
+  {
+    const Clock::time_point start = Clock::now();
+    benchmark.function();
+    const Clock::time_point stop = Clock::now();
+
+    samples[i] = (double) std::chrono::duration_cast<
+        std::chrono::microseconds>(stop - start).count();
+  }
+
+  std::sort(samples.begin(), samples.end());
+
+  BenchmarkResult result;
+  result.minimum = samples.front();
+  result.median = (samples.size() % 2 == 1) ?
+      samples[samples.size() / 2] :
+      0.5 * (samples[samples.size() / 2 - 1] + samples[samples.size() / 2]);
+
+  double sum = 0.0;
+  for (const double s : samples)
+    sum += s;
+  result.mean = sum / samples.size();
+
+  double sqDiffSum = 0.0;
+  for (const double s : samples)
+    sqDiffSum += (s - result.mean) * (s - result.mean);
+  result.stddev = (samples.size() > 1) ?
+      std::sqrt(sqDiffSum / (samples.size() - 1)) : 0.0;
+
+  return result;
+}
+
+//! Print the header of the results table.
+inline void PrintHeader(std::ostream& stream)
+{
+  stream << std::left << std::setw(32) << "benchmark"
+      << std::right << std::setw(6) << "reps"
+      << std::setw(14) << "min (us)"
+      << std::setw(14) << "median (us)"
+      << std::setw(14) << "mean (us)"
+      << std::setw(14) << "stddev (us)" << std::endl;
+}
+
+//! Print one row of the results table.
+inline void PrintResult(std::ostream& stream,
+                        const Benchmark& benchmark,
+                        const BenchmarkResult& result)
+{
+  stream << std::left << std::setw(32) << benchmark.name
+      << std::right << std::setw(6) << benchmark.repetitions
+      << std::fixed << std::setprecision(1)
+      << std::setw(14) << result.minimum
+      << std::setw(14) << result.median
+      << std::setw(14) << result.mean
+      << std::setw(14) << result.stddev << std::endl;
+}
+
+} // namespace bench
+} // namespace mlpack
+
+/**
+ * Register a micro-benchmark.  The function argument may be any nullary
+ * callable; it will be invoked once per (warmup or timed) iteration.
+ */
+#define MLPACK_BENCHMARK(name, function) \
+    static mlpack::bench::RegisterBenchmark \
+        MLPACK_TOKEN_PASTE(benchmarkRegistration, __LINE__)(name, function)
+
+#endif
@@ -0,0 +1,89 @@
+/**
+ * @file bench/core_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Micro-benchmarks for core kernels: LMetric::Evaluate(),
+ * HRectBound::MinDistance(), and CSV loading.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "bench_util.hpp"
+
+#include <mlpack/core/tree/hrectbound.hpp>
+
+#include <cstdio>
+
+using namespace mlpack;
+using namespace mlpack::bench;
+
+// Accumulator that keeps the compiler from optimizing the kernels away.
+static volatile double sink = 0.0;
+
+/**
+ * Fixed benchmark data, generated once with a fixed seed so that every run
+ * measures exactly the same inputs.
+ */
+struct CoreBenchData
+{
+  CoreBenchData() :
+      csvFile("mlpack_bench_data.csv")
+  {
+    math::RandomSeed(12345);
+
+    a = arma::randu<arma::mat>(100, 1000);
+    b = arma::randu<arma::mat>(100, 1000);
+
+    boundA = bound::HRectBound<metric::EuclideanDistance>(30);
+    boundB = bound::HRectBound<metric::EuclideanDistance>(30);
+    boundA |= arma::randu<arma::mat>(30, 100);
+    // Shift the second bound so the bounds do not overlap.
+    boundB |= (arma::randu<arma::mat>(30, 100) + 2.0);
+
+    const arma::mat csvData = arma::randu<arma::mat>(100, 10000);
+    data::Save(csvFile, csvData);
+  }
+
+  ~CoreBenchData() { std::remove(csvFile.c_str()); }
+
+  arma::mat a, b;
+  bound::HRectBound<metric::EuclideanDistance> boundA, boundB;
+  std::string csvFile;
+};
+
+static CoreBenchData coreData;
+
+// One iteration: 100 passes of 1000 Euclidean distance evaluations between
+// fixed 100-dimensional points.
+MLPACK_BENCHMARK("lmetric_evaluate", []()
+{
+  double sum = 0.0;
+  for (size_t pass = 0; pass < 100; ++pass)
+    for (size_t i = 0; i < coreData.a.n_cols; ++i)
+      sum += metric::EuclideanDistance::Evaluate(coreData.a.col(i),
+          coreData.b.col(i));
+  sink += sum;
+});
+
+// One iteration: 100k bound-to-bound and 100k point-to-bound minimum distance
+// evaluations on fixed 30-dimensional bounds.
+MLPACK_BENCHMARK("hrectbound_min_distance", []()
+{
+  double sum = 0.0;
+  for (size_t i = 0; i < 100000; ++i)
+    sum += coreData.boundA.MinDistance(coreData.boundB);
+  for (size_t i = 0; i < 100; ++i)
+    for (size_t j = 0; j < coreData.a.n_cols; ++j)
+      sum += coreData.boundA.MinDistance(coreData.a.col(j).head(30));
+  sink += sum;
+});
+
+// One iteration: load a fixed 100 x 10000 CSV file.
+MLPACK_BENCHMARK("csv_load", []()
+{
+  arma::mat loaded;
+  data::Load(coreData.csvFile, loaded, true);
+  sink += loaded(0, 0);
+});
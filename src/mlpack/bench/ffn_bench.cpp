@@ -0,0 +1,55 @@
+/**
+ * @file bench/ffn_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Micro-benchmark for FFN::Predict().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "bench_util.hpp"
+
+#include <mlpack/methods/ann/ffn.hpp>
+#include <mlpack/methods/ann/layer/layer.hpp>
+
+using namespace mlpack;
+using namespace mlpack::bench;
+
+static volatile double sink = 0.0;
+
+/**
+ * Fixed benchmark data and model, generated once with a fixed seed; the
+ * network weights are initialized eagerly so that the (random) initialization
+ * is reproducible and outside of the timed region.
+ */
+struct FFNBenchData
+{
+  FFNBenchData()
+  {
+    math::RandomSeed(12345);
+
+    dataset = arma::randu<arma::mat>(100, 1000);
+
+    model.Add<ann::Linear<>>(100, 50);
+    model.Add<ann::ReLULayer<>>();
+    model.Add<ann::Linear<>>(50, 10);
+    model.Add<ann::LogSoftMax<>>();
+    model.ResetParameters();
+  }
+
+  arma::mat dataset;
+  ann::FFN<> model;
+};
+
+static FFNBenchData ffnData;
+
+// One iteration: forward pass of 1000 100-dimensional points through a small
+// untrained network.
+MLPACK_BENCHMARK("ffn_predict", []()
+{
+  arma::mat predictions;
+  ffnData.model.Predict(ffnData.dataset, predictions);
+  sink += predictions(0, 0);
+});
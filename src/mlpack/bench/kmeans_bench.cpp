@@ -0,0 +1,51 @@
+/**
+ * @file bench/kmeans_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Micro-benchmark for NaiveKMeans::Iterate().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "bench_util.hpp"
+
+#include <mlpack/methods/kmeans/naive_kmeans.hpp>
+
+using namespace mlpack;
+using namespace mlpack::bench;
+
+static volatile double sink = 0.0;
+
+/**
+ * Fixed benchmark data, generated once with a fixed seed.
+ */
+struct KMeansBenchData
+{
+  KMeansBenchData()
+  {
+    math::RandomSeed(12345);
+
+    dataset = arma::randu<arma::mat>(10, 50000);
+    centroids = arma::randu<arma::mat>(10, 20);
+  }
+
+  arma::mat dataset;
+  arma::mat centroids;
+};
+
+static KMeansBenchData kmeansData;
+
+// One iteration: a single Lloyd iteration assigning 50k 10-dimensional points
+// to 20 clusters.
+MLPACK_BENCHMARK("naive_kmeans_iterate", []()
+{
+  metric::EuclideanDistance metric;
+  kmeans::NaiveKMeans<metric::EuclideanDistance, arma::mat>
+      lloyd(kmeansData.dataset, metric);
+
+  arma::mat newCentroids;
+  arma::Col<size_t> counts;
+  sink += lloyd.Iterate(kmeansData.centroids, newCentroids, counts);
+});
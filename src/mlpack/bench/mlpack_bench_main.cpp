@@ -0,0 +1,47 @@
+/**
+ * @file bench/mlpack_bench_main.cpp
+ * @author Ryan Curtin
+ *
+ * Entry point for the mlpack_bench micro-benchmark suite.  Runs every
+ * registered benchmark (optionally restricted to those whose name contains a
+ * given substring) and prints a statistics table.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "bench_util.hpp"
+
+#include <iostream>
+
+using namespace mlpack;
+using namespace mlpack::bench;
+using namespace std;
+
+int main(int argc, char** argv)
+{
+  // An optional single argument restricts the run to benchmarks whose name
+  // contains it as a substring.
+  const string filter = (argc > 1) ? argv[1] : "";
+
+  size_t matched = 0;
+  PrintHeader(cout);
+  for (const Benchmark& benchmark : Registry())
+  {
+    if (!filter.empty() && benchmark.name.find(filter) == string::npos)
+      continue;
+
+    const BenchmarkResult result = Run(benchmark);
+    PrintResult(cout, benchmark, result);
+    ++matched;
+  }
+
+  if (matched == 0)
+  {
+    cerr << "No benchmarks match '" << filter << "'!" << endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file bench/synthetic_data_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Micro-benchmarks for the synthetic dataset generators.  These are the
+ * generators the other benchmarks rely on for I/O-free input data, so their
+ * own cost at scale is worth tracking too.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "bench_util.hpp"
+
+#include <mlpack/core/data/synthetic_data.hpp>
+
+using namespace mlpack;
+using namespace mlpack::bench;
+
+static volatile double sink = 0.0;
+
+// 100k 20-dimensional points from 50 Gaussian clusters.
+MLPACK_BENCHMARK("gaussian_clusters_generate", []()
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  data::GaussianClusters(20, 100000, 50, 10.0, data, labels, 12345);
+  sink += data(0, 0);
+});
+
+// 100k points on a 5-dimensional manifold embedded in 100 dimensions.
+MLPACK_BENCHMARK("embedded_manifold_generate", []()
+{
+  arma::mat data;
+  data::EmbeddedManifold(5, 100, 100000, 0.01, data, 12345);
+  sink += data(0, 0);
+});
+
+// A power-law sparse matrix with 50k columns and up to 256 nonzeros each.
+MLPACK_BENCHMARK("power_law_sparse_generate", []()
+{
+  arma::sp_mat data;
+  data::PowerLawSparse(10000, 50000, 2.0, 256, data, 12345);
+  sink += (double) data.n_nonzero;
+});
+
+// A drifting labeled stream of 100k 20-dimensional points from 10 classes.
+MLPACK_BENCHMARK("drifting_stream_generate", []()
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  data::DriftingStream(20, 100000, 10, 5.0, data, labels, 12345);
+  sink += data(0, 0);
+});
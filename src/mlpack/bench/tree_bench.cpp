@@ -0,0 +1,46 @@
+/**
+ * @file bench/tree_bench.cpp
+ * @author Ryan Curtin
+ *
+ * Micro-benchmark for kd-tree construction.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "bench_util.hpp"
+
+#include <mlpack/core/tree/binary_space_tree.hpp>
+
+using namespace mlpack;
+using namespace mlpack::bench;
+
+static volatile double sink = 0.0;
+
+/**
+ * Fixed benchmark data, generated once with a fixed seed.
+ */
+struct TreeBenchData
+{
+  TreeBenchData()
+  {
+    math::RandomSeed(12345);
+
+    dataset = arma::randu<arma::mat>(10, 20000);
+  }
+
+  arma::mat dataset;
+};
+
+static TreeBenchData treeData;
+
+// One iteration: build a kd-tree on 20k 10-dimensional points.  The timed
+// region includes the dataset copy the constructor makes, matching what a
+// caller of NeighborSearch or similar pays.
+MLPACK_BENCHMARK("kdtree_construction", []()
+{
+  tree::KDTree<metric::EuclideanDistance, tree::EmptyStatistic, arma::mat>
+      tree(treeData.dataset);
+  sink += (double) tree.NumDescendants();
+});
@@ -90,54 +90,82 @@ void IO_SetParamVecInt(const std::string& paramName,
 // Call IO::SetParam<arma::mat>().
 // [[Rcpp::export]]
 void IO_SetParamMat(const std::string& paramName,
-                    const arma::mat& paramValue)
-{
-  IO::GetParam<arma::mat>(paramName) = paramValue.t();
+                    const Rcpp::NumericMatrix& paramValue)
+{
+  // Borrow the R matrix's memory instead of letting Rcpp copy it into a new
+  // Armadillo matrix; the transpose below is then the only copy of the data
+  // that is made.
+  const arma::mat alias(const_cast<double*>(paramValue.begin()),
+      paramValue.nrow(), paramValue.ncol(), false, true);
+  IO::GetParam<arma::mat>(paramName) = alias.t();
   IO::SetPassed(paramName);
 }
 
 // Call IO::SetParam<arma::Mat<size_t>>().
 // [[Rcpp::export]]
 void IO_SetParamUMat(const std::string& paramName,
-                     const arma::Mat<size_t>& paramValue)
-{
-  IO::GetParam<arma::Mat<size_t>>(paramName) = paramValue.t();
+                     const Rcpp::NumericMatrix& paramValue)
+{
+  // Borrow the R matrix's memory and convert in one pass, instead of letting
+  // Rcpp make an intermediate copy first.
+  const arma::mat alias(const_cast<double*>(paramValue.begin()),
+      paramValue.nrow(), paramValue.ncol(), false, true);
+  IO::GetParam<arma::Mat<size_t>>(paramName) =
+      arma::conv_to<arma::Mat<size_t>>::from(alias.t());
   IO::SetPassed(paramName);
 }
 
 // Call IO::SetParam<arma::rowvec>().
 // [[Rcpp::export]]
 void IO_SetParamRow(const std::string& paramName,
-                    const arma::rowvec& paramValue)
+                    const Rcpp::NumericVector& paramValue)
 {
-  IO::GetParam<arma::rowvec>(paramName) = std::move(paramValue);
+  // Borrow the R vector's memory instead of letting Rcpp copy it first, so
+  // only one copy of the data is made.
+  const arma::rowvec alias(const_cast<double*>(paramValue.begin()),
+      paramValue.size(), false, true);
+  IO::GetParam<arma::rowvec>(paramName) = alias;
   IO::SetPassed(paramName);
 }
 
 // Call IO::SetParam<arma::Row<size_t>>().
 // [[Rcpp::export]]
 void IO_SetParamURow(const std::string& paramName,
-                     const arma::Row<size_t>& paramValue)
-{
-  IO::GetParam<arma::Row<size_t>>(paramName) = paramValue - 1;
+                     const Rcpp::NumericVector& paramValue)
+{
+  // Borrow the R vector's memory and convert in one pass, instead of letting
+  // Rcpp make an intermediate copy first.
+  const arma::rowvec alias(const_cast<double*>(paramValue.begin()),
+      paramValue.size(), false, true);
+  IO::GetParam<arma::Row<size_t>>(paramName) =
+      arma::conv_to<arma::Row<size_t>>::from(alias - 1);
   IO::SetPassed(paramName);
 }
 
 // Call IO::SetParam<arma::vec>().
 // [[Rcpp::export]]
 void IO_SetParamCol(const std::string& paramName,
-                    const arma::vec& paramValue)
+                    const Rcpp::NumericVector& paramValue)
 {
-  IO::GetParam<arma::vec>(paramName) = std::move(paramValue);
+  // Borrow the R vector's memory instead of letting Rcpp copy it first, so
+  // only one copy of the data is made.
+  const arma::vec alias(const_cast<double*>(paramValue.begin()),
+      paramValue.size(), false, true);
+  IO::GetParam<arma::vec>(paramName) = alias;
   IO::SetPassed(paramName);
 }
 
 // Call IO::SetParam<arma::Col<size_t>>().
 // [[Rcpp::export]]
 void IO_SetParamUCol(const std::string& paramName,
-                     const arma::Col<size_t>& paramValue)
-{
-  IO::GetParam<arma::Col<size_t>>(paramName) = paramValue - 1;
+                     const Rcpp::NumericVector& paramValue)
+{
+  // Borrow the R vector's memory and convert in one pass, instead of letting
+  // Rcpp make an intermediate copy first.
+  const arma::vec alias(const_cast<double*>(paramValue.begin()),
+      paramValue.size(), false, true);
+  IO::GetParam<arma::Col<size_t>>(paramName) =
+      arma::conv_to<arma::Col<size_t>>::from(alias - 1);
   IO::SetPassed(paramName);
 }
 
@@ -145,9 +173,9 @@ void IO_SetParamUCol(const std::string& paramName,
 // [[Rcpp::export]]
 void IO_SetParamMatWithInfo(const std::string& paramName,
                             const LogicalVector& dimensions,
-                            const arma::mat& paramValue)
+                            const Rcpp::NumericMatrix& paramValue)
 {
-  data::DatasetInfo d(paramValue.n_cols);
+  data::DatasetInfo d(paramValue.ncol());
   for (size_t i = 0; i < d.Dimensionality(); ++i)
   {
     d.Type(i) = (dimensions[i]) ? data::Datatype::categorical :
@@ -155,8 +183,13 @@ void IO_SetParamMatWithInfo(const std::string& paramName,
   }
   std::get<0>(IO::GetParam<std::tuple<data::DatasetInfo, arma::mat>>(
       paramName)) = std::move(d);
+  // Borrow the R matrix's memory instead of letting Rcpp copy it into a new
+  // Armadillo matrix; the transpose below is then the only copy of the data
+  // that is made.
+  const arma::mat alias(const_cast<double*>(paramValue.begin()),
+      paramValue.nrow(), paramValue.ncol(), false, true);
   std::get<1>(IO::GetParam<std::tuple<data::DatasetInfo, arma::mat>>(
-      paramName)) = paramValue.t();
+      paramName)) = alias.t();
   IO::SetPassed(paramName);
 }
 
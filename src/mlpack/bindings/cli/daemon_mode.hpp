@@ -0,0 +1,231 @@
+/**
+ * @file bindings/cli/daemon_mode.hpp
+ * @author Ryan Curtin
+ *
+ * Daemon mode for command-line programs: run one long-lived process that
+ * reads successive command lines from stdin and executes each of them,
+ * caching input models between commands.  This amortizes process startup and
+ * model deserialization across many invocations.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_CLI_DAEMON_MODE_HPP
+#define MLPACK_BINDINGS_CLI_DAEMON_MODE_HPP
+
+#include <mlpack/core.hpp>
+#include "parse_command_line.hpp"
+#include "end_program.hpp"
+
+#include <boost/algorithm/string/trim.hpp>
+
+#include <iostream>
+#include <sstream>
+#include <unordered_set>
+
+namespace mlpack {
+namespace bindings {
+namespace cli {
+
+/**
+ * An input model that was loaded by a previous daemon command and is kept
+ * alive so that later commands using the same model file can skip
+ * deserialization.  The value member holds the parameter's
+ * std::tuple<Model*, std::string>, type-erased the same way ParamData stores
+ * it.
+ */
+struct CachedModel
+{
+  //! The file the model was loaded from.
+  std::string filename;
+  //! The type name of the parameter; used to look up the deleter.
+  std::string tname;
+  //! The parameter value (holding the pointer to the loaded model).
+  boost::any value;
+};
+
+/**
+ * Run the program as a daemon: read one full command line per stdin line and
+ * execute each of them in this process, until EOF or a line reading 'quit' or
+ * 'exit' is seen.  After each command, "OK" (or "ERROR <message>" on failure)
+ * is printed to stdout, so that a driving process can tell when the command
+ * has finished.
+ *
+ * Input models are cached between commands: if a command names the same input
+ * model file for the same parameter as the previous command, the
+ * already-loaded model is reused instead of being deserialized again.  Note
+ * that this assumes commands do not modify their input models (no current CLI
+ * program does).
+ *
+ * Tokenization of command lines is simple whitespace splitting; quoting is
+ * not supported, so filenames with spaces cannot be used in daemon mode.
+ *
+ * @param entryPoint The program's mlpackMain() function.
+ * @param parameterDefaults The parameter map as it was before any command
+ *     line was parsed; restored before each command so that options from one
+ *     command do not leak into the next.
+ * @param programName Name of the program (argv[0]); used as the first
+ *     argument of each parsed command.
+ */
+inline void RunDaemon(
+    void (*entryPoint)(),
+    const std::map<std::string, util::ParamData>& parameterDefaults,
+    const std::string& programName)
+{
+  // Cached input models from previous commands, keyed by parameter name.
+  std::map<std::string, CachedModel> modelCache;
+
+  Timer::EnableTiming();
+
+  // Tell the driving process that we are ready to accept commands.
+  std::cout << "READY" << std::endl;
+
+  std::string line;
+  while (std::getline(std::cin, line))
+  {
+    boost::trim(line);
+    if (line.empty())
+      continue;
+    if (line == "quit" || line == "exit")
+      break;
+
+    // Split the line into an argv-style array.
+    std::vector<std::string> tokens;
+    tokens.push_back(programName);
+    std::istringstream tokenStream(line);
+    std::string token;
+    while (tokenStream >> token)
+      tokens.push_back(token);
+
+    std::vector<char*> args(tokens.size());
+    for (size_t i = 0; i < tokens.size(); ++i)
+      args[i] = const_cast<char*>(tokens[i].c_str());
+
+    // Reset all parameters to their defaults, so that options and values from
+    // the previous command do not leak into this one.
+    IO::Parameters() = parameterDefaults;
+
+    try
+    {
+      ParseCommandLine((int) args.size(), args.data());
+
+      // Re-attach any cached models that this command requests with the same
+      // filename, so that they are not deserialized again; drop (and delete)
+      // cached models the command does not use.
+      std::map<std::string, util::ParamData>& parameters = IO::Parameters();
+      std::map<std::string, CachedModel>::iterator it = modelCache.begin();
+      while (it != modelCache.end())
+      {
+        bool reused = false;
+        if (parameters.count(it->first) > 0)
+        {
+          util::ParamData& d = parameters.at(it->first);
+
+          // The printable form of a model parameter is its filename.
+          std::string filename;
+          IO::GetSingleton().functionMap[d.tname]["GetPrintableParam"](d,
+              NULL, (void*) &filename);
+
+          if (d.input && filename == it->second.filename)
+          {
+            d.value = it->second.value;
+            d.loaded = true;
+            reused = true;
+          }
+        }
+
+        if (reused)
+        {
+          ++it;
+        }
+        else
+        {
+          util::ParamData tmp;
+          tmp.tname = it->second.tname;
+          tmp.value = it->second.value;
+          IO::GetSingleton().functionMap[tmp.tname]["DeleteAllocatedMemory"](
+              tmp, NULL, NULL);
+          it = modelCache.erase(it);
+        }
+      }
+
+      // Run the command.
+      Timer::Start("total_time");
+      entryPoint();
+      IO::GetSingleton().timer.StopAllTimers();
+
+      PrintOutputOptions();
+
+      // Put the input models this command loaded into the cache, and clean up
+      // all other memory we own.
+      std::unordered_set<void*> keepAddresses;
+      for (auto& pit : parameters)
+      {
+        util::ParamData& d = pit.second;
+        if (!d.input || !d.loaded)
+          continue;
+
+        // Only model parameters hold allocated memory.
+        void* address = NULL;
+        IO::GetSingleton().functionMap[d.tname]["GetAllocatedMemory"](d, NULL,
+            (void*) &address);
+        if (address == NULL)
+          continue;
+
+        std::string filename;
+        IO::GetSingleton().functionMap[d.tname]["GetPrintableParam"](d, NULL,
+            (void*) &filename);
+
+        modelCache[pit.first] = CachedModel{ filename, d.tname, d.value };
+        keepAddresses.insert(address);
+      }
+
+      CleanMemory(keepAddresses);
+
+      std::cout << "OK" << std::endl;
+    }
+    catch (const std::exception& e)
+    {
+      // Log::Fatal throws std::runtime_error after printing its message; any
+      // other exception lands here too, so a failed command does not take the
+      // daemon down.
+      IO::GetSingleton().timer.StopAllTimers();
+
+      // Clean up anything the failed command allocated, but keep the cached
+      // models (they may have been re-attached to the parameters).
+      std::unordered_set<void*> keepAddresses;
+      for (auto& c : modelCache)
+      {
+        util::ParamData tmp;
+        tmp.tname = c.second.tname;
+        tmp.value = c.second.value;
+        void* address = NULL;
+        IO::GetSingleton().functionMap[tmp.tname]["GetAllocatedMemory"](tmp,
+            NULL, (void*) &address);
+        if (address != NULL)
+          keepAddresses.insert(address);
+      }
+      CleanMemory(keepAddresses);
+
+      std::cout << "ERROR " << e.what() << std::endl;
+    }
+  }
+
+  // Delete whatever is left in the cache.
+  for (auto& c : modelCache)
+  {
+    util::ParamData tmp;
+    tmp.tname = c.second.tname;
+    tmp.value = c.second.value;
+    IO::GetSingleton().functionMap[tmp.tname]["DeleteAllocatedMemory"](tmp,
+        NULL, NULL);
+  }
+}
+
+} // namespace cli
+} // namespace bindings
+} // namespace mlpack
+
+#endif
@@ -15,19 +15,21 @@
 
 #include <mlpack/core/util/io.hpp>
 
+#include <unordered_map>
+#include <unordered_set>
+
 namespace mlpack {
 namespace bindings {
 namespace cli {
 
 /**
- * Handle command-line program termination.  If --help or --info was passed, we
- * won't make it here, so we don't have to write any contingencies for that.
+ * Print all output options and, if --verbose was given, the execution
+ * parameters and timers.  This is a piece of EndProgram(), split out so that
+ * daemon mode can print the output of each command without tearing the
+ * process down.
  */
-inline void EndProgram()
+inline void PrintOutputOptions()
 {
-  // Stop the CLI timers.
-  IO::GetSingleton().timer.StopAllTimers();
-
   // Print any output.
   std::map<std::string, util::ParamData>& parameters = IO::Parameters();
   for (auto& it : parameters)
@@ -65,10 +67,21 @@ inline void EndProgram()
       IO::GetSingleton().timer.PrintTimer(it2.first);
     }
   }
+}
 
-  // Lastly clean up any memory.  If we are holding any pointers, then we "own"
-  // them.  But we may hold the same pointer twice, so we have to be careful to
-  // not delete it multiple times.
+/**
+ * Clean up any memory held by the parameters.  If we are holding any pointers,
+ * then we "own" them.  But we may hold the same pointer twice, so we have to
+ * be careful to not delete it multiple times.  Any address in keepAddresses is
+ * left alone; daemon mode uses this to carry cached input models over to the
+ * next command.
+ *
+ * @param keepAddresses Addresses that must not be deleted.
+ */
+inline void CleanMemory(const std::unordered_set<void*>& keepAddresses =
+    std::unordered_set<void*>())
+{
+  std::map<std::string, util::ParamData>& parameters = IO::Parameters();
   std::unordered_map<void*, util::ParamData*> memoryAddresses;
   for (auto& it : parameters)
   {
@@ -77,7 +90,8 @@ inline void EndProgram()
     void* result;
     IO::GetSingleton().functionMap[data.tname]["GetAllocatedMemory"](data,
         NULL, (void*) &result);
-    if (result != NULL && memoryAddresses.count(result) == 0)
+    if (result != NULL && memoryAddresses.count(result) == 0 &&
+        keepAddresses.count(result) == 0)
       memoryAddresses[result] = &data;
   }
 
@@ -95,6 +109,21 @@ inline void EndProgram()
   }
 }
 
+/**
+ * Handle command-line program termination.  If --help or --info was passed, we
+ * won't make it here, so we don't have to write any contingencies for that.
+ */
+inline void EndProgram()
+{
+  // Stop the CLI timers.
+  IO::GetSingleton().timer.StopAllTimers();
+
+  PrintOutputOptions();
+
+  // Lastly clean up any memory.
+  CleanMemory();
+}
+
 } // namespace cli
 } // namespace bindings
 } // namespace mlpack
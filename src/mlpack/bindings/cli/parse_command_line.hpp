@@ -28,6 +28,11 @@ PARAM_STRING_IN("info", "Print help on a specific option.", "", "");
 PARAM_FLAG("verbose", "Display informational messages and the full list of "
     "parameters and timers at the end of execution.", "v");
 PARAM_FLAG("version", "Display the version of mlpack.", "V");
+PARAM_FLAG("daemon", "Run as a long-lived process: instead of executing once "
+    "and exiting, read successive command lines from stdin (one full set of "
+    "options per line) and execute each of them.  Input models are cached "
+    "between commands, so repeated invocations against the same model file "
+    "skip deserialization.  Send 'quit' or EOF to stop.", "");
 
 /**
  * Parse the command line, setting all of the options inside of the CLI object
@@ -129,6 +134,12 @@ void ParseCommandLine(int argc, char** argv)
     Log::Info.ignoreInput = false;
   }
 
+  // In daemon mode the startup command line does not need to carry the
+  // required options; each command read from stdin is checked when it is
+  // parsed instead.
+  if (IO::HasParam("daemon"))
+    return;
+
   // Now, issue an error if we forgot any required options.
   for (std::map<std::string, util::ParamData>::const_iterator iter =
        parameters.begin(); iter != parameters.end(); ++iter)
@@ -111,9 +111,23 @@ void IO_SetParamMat(const char* paramName,
                      const size_t cols,
                      const bool pointsAsRows)
 {
-  // Create the matrix as an alias.
-  arma::mat m(memptr, arma::uword(rows), arma::uword(cols), false, true);
-  IO::GetParam<arma::mat>(paramName) = pointsAsRows ? m.t() : std::move(m);
+  if (pointsAsRows)
+  {
+    // A transpose is needed, so a copy cannot be avoided.
+    arma::mat m(memptr, arma::uword(rows), arma::uword(cols), false, true);
+    IO::GetParam<arma::mat>(paramName) = m.t();
+  }
+  else
+  {
+    // The layout already matches, so reconstruct the parameter in place as an
+    // alias of the Julia array's memory, avoiding a copy.  (Assigning an
+    // alias would copy, since Armadillo cannot steal borrowed memory.)  The
+    // Julia glue keeps a reference to the array until the call completes.
+    arma::mat& param = IO::GetParam<arma::mat>(paramName);
+    param.~Mat();
+    new (&param) arma::mat(memptr, arma::uword(rows), arma::uword(cols),
+        false, false);
+  }
   IO::SetPassed(paramName);
 }
 
@@ -126,11 +140,22 @@ void IO_SetParamUMat(const char* paramName,
                       const size_t cols,
                       const bool pointsAsRows)
 {
-  // Create the matrix as an alias.
-  arma::Mat<size_t> m(memptr, arma::uword(rows), arma::uword(cols), false,
-      true);
-  IO::GetParam<arma::Mat<size_t>>(paramName) = pointsAsRows ? m.t() :
-      std::move(m);
+  if (pointsAsRows)
+  {
+    // A transpose is needed, so a copy cannot be avoided.
+    arma::Mat<size_t> m(memptr, arma::uword(rows), arma::uword(cols), false,
+        true);
+    IO::GetParam<arma::Mat<size_t>>(paramName) = m.t();
+  }
+  else
+  {
+    // Reconstruct the parameter in place as an alias of the Julia array's
+    // memory, avoiding a copy.
+    arma::Mat<size_t>& param = IO::GetParam<arma::Mat<size_t>>(paramName);
+    param.~Mat();
+    new (&param) arma::Mat<size_t>(memptr, arma::uword(rows),
+        arma::uword(cols), false, false);
+  }
   IO::SetPassed(paramName);
 }
 
@@ -141,8 +166,11 @@ void IO_SetParamRow(const char* paramName,
                      double* memptr,
                      const size_t cols)
 {
-  arma::rowvec m(memptr, arma::uword(cols), false, true);
-  IO::GetParam<arma::rowvec>(paramName) = std::move(m);
+  // Reconstruct the parameter in place as an alias of the Julia array's
+  // memory, avoiding a copy.
+  arma::rowvec& param = IO::GetParam<arma::rowvec>(paramName);
+  param.~Row();
+  new (&param) arma::rowvec(memptr, arma::uword(cols), false, false);
   IO::SetPassed(paramName);
 }
 
@@ -153,8 +181,11 @@ void IO_SetParamURow(const char* paramName,
                       size_t* memptr,
                       const size_t cols)
 {
-  arma::Row<size_t> m(memptr, arma::uword(cols), false, true);
-  IO::GetParam<arma::Row<size_t>>(paramName) = std::move(m);
+  // Reconstruct the parameter in place as an alias of the Julia array's
+  // memory, avoiding a copy.
+  arma::Row<size_t>& param = IO::GetParam<arma::Row<size_t>>(paramName);
+  param.~Row();
+  new (&param) arma::Row<size_t>(memptr, arma::uword(cols), false, false);
   IO::SetPassed(paramName);
 }
 
@@ -165,8 +196,11 @@ void IO_SetParamCol(const char* paramName,
                      double* memptr,
                      const size_t rows)
 {
-  arma::vec m(memptr, arma::uword(rows), false, true);
-  IO::GetParam<arma::vec>(paramName) = std::move(m);
+  // Reconstruct the parameter in place as an alias of the Julia array's
+  // memory, avoiding a copy.
+  arma::vec& param = IO::GetParam<arma::vec>(paramName);
+  param.~Col();
+  new (&param) arma::vec(memptr, arma::uword(rows), false, false);
   IO::SetPassed(paramName);
 }
 
@@ -177,8 +211,11 @@ void IO_SetParamUCol(const char* paramName,
                       size_t* memptr,
                       const size_t rows)
 {
-  arma::Col<size_t> m(memptr, arma::uword(rows), false, true);
-  IO::GetParam<arma::Col<size_t>>(paramName) = std::move(m);
+  // Reconstruct the parameter in place as an alias of the Julia array's
+  // memory, avoiding a copy.
+  arma::Col<size_t>& param = IO::GetParam<arma::Col<size_t>>(paramName);
+  param.~Col();
+  new (&param) arma::Col<size_t>(memptr, arma::uword(rows), false, false);
   IO::SetPassed(paramName);
 }
 
@@ -199,11 +236,24 @@ void IO_SetParamMatWithInfo(const char* paramName,
         data::Datatype::numeric;
   }
 
-  arma::mat m(memptr, arma::uword(rows), arma::uword(cols), false, true);
   std::get<0>(IO::GetParam<std::tuple<data::DatasetInfo, arma::mat>>(
       paramName)) = std::move(d);
-  std::get<1>(IO::GetParam<std::tuple<data::DatasetInfo, arma::mat>>(
-      paramName)) = pointsAreRows ? m.t() : std::move(m);
+  arma::mat& param = std::get<1>(
+      IO::GetParam<std::tuple<data::DatasetInfo, arma::mat>>(paramName));
+  if (pointsAreRows)
+  {
+    // A transpose is needed, so a copy cannot be avoided.
+    arma::mat m(memptr, arma::uword(rows), arma::uword(cols), false, true);
+    param = m.t();
+  }
+  else
+  {
+    // Reconstruct the parameter in place as an alias of the Julia array's
+    // memory, avoiding a copy.
+    param.~Mat();
+    new (&param) arma::mat(memptr, arma::uword(rows), arma::uword(cols),
+        false, false);
+  }
   IO::SetPassed(paramName);
 }
 
@@ -289,8 +289,8 @@ void PrintJL(const util::BindingDetails& doc,
   cout << endl;
 
   // Extract the results in order.
-  cout << "  return ";
-  string indentStr(9, ' ');
+  cout << "  results = (";
+  string indentStr(13, ' ');
   for (size_t i = 0; i < outputOptions.size(); ++i)
   {
     util::ParamData& d = parameters.at(outputOptions[i]);
@@ -301,8 +301,17 @@ void PrintJL(const util::BindingDetails& doc,
     if (i + 1 < outputOptions.size())
       cout << "," << endl << indentStr;
   }
+  cout << ")" << endl;
+  cout << endl;
 
-  cout << endl << "end" << endl;
+  // The outputs have been extracted, so any input arrays whose memory was
+  // aliased instead of copied no longer need to be kept alive.
+  cout << "  # Release references to any aliased input arrays." << endl;
+  cout << "  IOClearAliasedInputs()" << endl;
+  cout << endl;
+  cout << "  return results" << endl;
+
+  cout << "end" << endl;
 }
 
 } // namespace julia
@@ -50,6 +50,11 @@ cdef extern from "<mlpack/core.hpp>" namespace "arma" nogil:
     # Access the memory pointer directly.
     T* memptr() nogil
 
+  # In-place transpose; with the "lowmem" method no auxiliary matrix is
+  # allocated, so this can be used on matrices that alias numpy memory.
+  void inplace_trans(Mat[double]& X, const char* method) nogil
+  void inplace_trans(Mat[size_t]& X, const char* method) nogil
+
   cdef cppclass Col[T]:
     # Special constructor that uses auxiliary memory.
     Col(T* aux_mem,
@@ -48,12 +48,26 @@ cdef arma.Mat[double]* numpy_to_mat_d(numpy.ndarray[numpy.double_t, ndim=2] X, \
   """
   Convert a numpy ndarray to a matrix.  The memory will still be owned by numpy.
   """
+  cdef arma.Mat[double]* m
+
+  if takeOwnership and not isWin and not X.flags.c_contiguous and \
+      X.flags.f_contiguous and X.flags.owndata:
+    # Fortran-ordered memory is already laid out like an Armadillo matrix with
+    # the rows and columns swapped, so we can alias it directly and transpose
+    # it in place instead of holding a second copy of the data in memory.
+    m = new arma.Mat[double](<double*> X.data, X.shape[0], X.shape[1], False,
+        False)
+    PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
+    SetMemState[arma.Mat[double]](m[0], 0)
+    arma.inplace_trans(m[0], b"lowmem")
+    return m
+
   if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
     # If needed, make a copy where we own the memory.
     X = X.copy(order="C")
     takeOwnership = True
 
-  cdef arma.Mat[double]* m = new arma.Mat[double](<double*> X.data, X.shape[1],\
+  m = new arma.Mat[double](<double*> X.data, X.shape[1],\
       X.shape[0], isWin, False)
 
   # Take ownership of the memory, if we need to and we are not on Windows.
@@ -68,13 +82,27 @@ cdef arma.Mat[size_t]* numpy_to_mat_s(numpy.ndarray[numpy.npy_intp, ndim=2] X, \
   """
   Convert a numpy ndarray to a matrix.  The memory will still be owned by numpy.
   """
+  cdef arma.Mat[size_t]* m
+
+  if takeOwnership and not isWin and not X.flags.c_contiguous and \
+      X.flags.f_contiguous and X.flags.owndata:
+    # Fortran-ordered memory is already laid out like an Armadillo matrix with
+    # the rows and columns swapped, so we can alias it directly and transpose
+    # it in place instead of holding a second copy of the data in memory.
+    m = new arma.Mat[size_t](<size_t*> X.data, X.shape[0], X.shape[1], False,
+        False)
+    PyArray_CLEARFLAGS(X, numpy.NPY_OWNDATA)
+    SetMemState[arma.Mat[size_t]](m[0], 0)
+    arma.inplace_trans(m[0], b"lowmem")
+    return m
+
   if not X.flags.c_contiguous or (not X.flags.owndata and not isWin):
     # If needed, make a copy where we own the memory, except on Windows where
     # we never copy.
     X = X.copy(order="C")
     takeOwnership = True
 
-  cdef arma.Mat[size_t]* m = new arma.Mat[size_t](<size_t*> X.data, X.shape[1],
+  m = new arma.Mat[size_t](<size_t*> X.data, X.shape[1],
       X.shape[0], isWin, False)
 
   # Take ownership of the memory, if we need to.
@@ -53,8 +53,15 @@ def to_matrix(x, dtype=np.double, copy=False):
     else:
       return x, False
   elif (isinstance(x, np.ndarray) and x.dtype == dtype and x.flags.f_contiguous):
-    # A copy is always necessary here.
-    return x.copy("C"), True
+    if copy: # Copy the matrix if required.
+      return x.copy("C"), True
+    else:
+      # Pass the array through and let the conversion layer alias its memory
+      # directly and transpose it in place, instead of making a C-ordered
+      # copy.  The bindings take ownership of the array's memory in this case,
+      # so the caller's array is consumed; pass copy=True (i.e.
+      # copy_all_inputs) to keep it intact instead.
+      return x, True
   else:
     if isinstance(x, pd.core.series.Series) or isinstance(x, pd.DataFrame):
       # We can only avoid a copy if the dtype is the same and the copy flag is
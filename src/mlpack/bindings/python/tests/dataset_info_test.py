@@ -132,6 +132,23 @@ class TestToMatrix(unittest.TestCase):
 
     self.assertEqual(p1['data'], p2['data'])
 
+  def testFortranNumpyToMatrix(self):
+    """
+    Make sure a Fortran-ordered numpy matrix is passed through without a copy,
+    with ownership handed over to the bindings.
+    """
+    m1 = np.asfortranarray(np.random.randn(100, 5))
+    m2, takeOwnership = to_matrix(m1)
+
+    self.assertTrue(isinstance(m2, np.ndarray))
+    self.assertEqual(m2.dtype, np.dtype(np.double))
+    self.assertTrue(takeOwnership)
+
+    p1 = m1.__array_interface__
+    p2 = m2.__array_interface__
+
+    self.assertEqual(p1['data'], p2['data'])
+
   def testPandasToMatrixNoCategorical(self):
     """
     Make sure that if we pass a Pandas dataframe with no categorical features,
@@ -72,6 +72,7 @@
 #include <mlpack/core/util/io.hpp>
 #include <mlpack/core/util/deprecated.hpp>
 #include <mlpack/core/data/load.hpp>
+#include <mlpack/core/data/inspect.hpp>
 #include <mlpack/core/data/save.hpp>
 #include <mlpack/core/data/normalize_labels.hpp>
 #include <mlpack/core/math/clamp.hpp>
@@ -80,9 +81,12 @@
 #include <mlpack/core/math/lin_alg.hpp>
 #include <mlpack/core/math/range.hpp>
 #include <mlpack/core/math/round.hpp>
+#include <mlpack/core/math/sampling.hpp>
 #include <mlpack/core/math/shuffle_data.hpp>
 #include <mlpack/core/math/ccov.hpp>
+#include <mlpack/core/math/incremental_covariance.hpp>
 #include <mlpack/core/math/make_alias.hpp>
+#include <mlpack/core/math/make_positive_definite.hpp>
 #include <mlpack/core/dists/discrete_distribution.hpp>
 #include <mlpack/core/dists/gaussian_distribution.hpp>
 #include <mlpack/core/dists/laplace_distribution.hpp>
@@ -246,13 +246,29 @@ double KFoldCV<MLAlgorithm,
 {
   arma::vec evaluations(k);
 
-  size_t numInvalidScores = 0;
-  for (size_t i = 0; i < k; ++i)
+  // The folds are completely independent: each iteration trains its own model
+  // instance on no-copy aliases of the extended dataset, which is only read.
+  // Thus the folds can be trained concurrently.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
   {
     MLAlgorithm&& model  = base.Train(GetTrainingSubset(xs, i),
         GetTrainingSubset(ys, i), args...);
     evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
         GetValidationSubset(ys, i));
+    // Only the last fold's iteration takes this branch, so there is no write
+    // contention between folds; the guard protects against concurrent
+    // Evaluate() calls (as made by hpt::ParallelGridSearch).
+    if (i == (omp_size_t) k - 1)
+    {
+      #pragma omp critical (cvModel)
+      modelPtr.reset(new MLAlgorithm(std::move(model)));
+    }
+  }
+
+  size_t numInvalidScores = 0;
+  for (size_t i = 0; i < k; ++i)
+  {
     if (std::isnan(evaluations(i)) || std::isinf(evaluations(i)))
     {
       ++numInvalidScores;
@@ -260,8 +276,6 @@ double KFoldCV<MLAlgorithm,
           << "a score of " << evaluations(i) << "; ignoring when computing "
           << "the average score." << std::endl;
     }
-    if (i == k - 1)
-      modelPtr.reset(new MLAlgorithm(std::move(model)));
   }
 
   if (numInvalidScores == k)
@@ -288,7 +302,10 @@ double KFoldCV<MLAlgorithm,
 {
   arma::vec evaluations(k);
 
-  for (size_t i = 0; i < k; ++i)
+  // As in the unweighted case, each fold trains an independent model on
+  // read-only aliases, so the folds can be trained concurrently.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) k; ++i)
   {
     MLAlgorithm&& model = (weights.n_elem > 0) ?
         base.Train(GetTrainingSubset(xs, i), GetTrainingSubset(ys, i),
@@ -297,8 +314,11 @@ double KFoldCV<MLAlgorithm,
             args...);
     evaluations(i) = Metric::Evaluate(model, GetValidationSubset(xs, i),
         GetValidationSubset(ys, i));
-    if (i == k - 1)
+    if (i == (omp_size_t) k - 1)
+    {
+      #pragma omp critical (cvModel)
       modelPtr.reset(new MLAlgorithm(std::move(model)));
+    }
   }
 
   return arma::mean(evaluations);
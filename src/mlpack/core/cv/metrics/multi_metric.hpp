@@ -0,0 +1,205 @@
+/**
+ * @file core/cv/metrics/multi_metric.hpp
+ * @author Kirill Mishchenko
+ *
+ * An evaluator for several classification metrics at once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_MULTI_METRIC_HPP
+#define MLPACK_CORE_CV_METRICS_MULTI_METRIC_HPP
+
+#include <type_traits>
+
+#include <mlpack/core.hpp>
+#include <mlpack/core/cv/metrics/average_strategy.hpp>
+
+namespace mlpack {
+namespace cv {
+
+/**
+ * MultiMetric evaluates several classification metrics from a single run of
+ * classification.  The single-metric classes (Accuracy, Precision, Recall and
+ * F1) each classify the data themselves, so evaluating all of them on the same
+ * test set classifies it once per metric; MultiMetric instead classifies the
+ * data once in its constructor, builds the confusion counts in one pass (see
+ * data::ConfusionMatrix()), and derives every requested metric from the
+ * shared counts.  The values it returns are identical to those of the
+ * corresponding single-metric classes.
+ *
+ * @code
+ * MultiMetric metrics(model, data, labels);
+ * double accuracy = metrics.Accuracy();
+ * double precision = metrics.Precision<Macro>();
+ * double f1 = metrics.F1<Macro>();
+ * @endcode
+ *
+ * In the case of multiclass classification it is assumed that there are
+ * instances of every label from 0 to max(labels) among input data points.
+ */
+class MultiMetric
+{
+ public:
+  /**
+   * Run classification once and build the confusion counts that all of the
+   * metric accessors are derived from.
+   *
+   * @param model A classification model.
+   * @param data Column-major data containing test items.
+   * @param labels Ground truth (correct) labels for the test items.
+   */
+  template<typename MLAlgorithm, typename DataType>
+  MultiMetric(MLAlgorithm& model,
+              const DataType& data,
+              const arma::Row<size_t>& labels);
+
+  //! Calculate accuracy from the confusion counts.
+  double Accuracy() const;
+
+  /**
+   * Calculate precision from the confusion counts.
+   *
+   * @tparam AS An average strategy.
+   * @tparam PositiveClass In the case of binary classification (AS = Binary)
+   *     positives are assumed to have labels equal to this value.
+   */
+  template<AverageStrategy AS, size_t PositiveClass = 1>
+  double Precision() const;
+
+  /**
+   * Calculate recall from the confusion counts.
+   *
+   * @tparam AS An average strategy.
+   * @tparam PositiveClass In the case of binary classification (AS = Binary)
+   *     positives are assumed to have labels equal to this value.
+   */
+  template<AverageStrategy AS, size_t PositiveClass = 1>
+  double Recall() const;
+
+  /**
+   * Calculate F1 from the confusion counts.
+   *
+   * @tparam AS An average strategy.
+   * @tparam PositiveClass In the case of binary classification (AS = Binary)
+   *     positives are assumed to have labels equal to this value.
+   */
+  template<AverageStrategy AS, size_t PositiveClass = 1>
+  double F1() const;
+
+  //! Get the confusion counts (rows are predicted classes, columns are actual
+  //! classes).
+  const arma::Mat<size_t>& ConfusionMatrix() const { return confusion; }
+
+ private:
+  /**
+   * Calculate precision for binary classification.
+   */
+  template<AverageStrategy _AS,
+           size_t PC,
+           typename = std::enable_if_t<_AS == Binary>>
+  double PrecisionStrategy() const;
+
+  /**
+   * Calculate microaveraged precision (the same as accuracy).
+   */
+  template<AverageStrategy _AS,
+           size_t PC,
+           typename = std::enable_if_t<_AS == Micro>,
+           typename = void>
+  double PrecisionStrategy() const;
+
+  /**
+   * Calculate macroaveraged precision.
+   */
+  template<AverageStrategy _AS,
+           size_t PC,
+           typename = std::enable_if_t<_AS == Macro>,
+           typename = void,
+           typename = void>
+  double PrecisionStrategy() const;
+
+  /**
+   * Calculate recall for binary classification.
+   */
+  template<AverageStrategy _AS,
+           size_t PC,
+           typename = std::enable_if_t<_AS == Binary>>
+  double RecallStrategy() const;
+
+  /**
+   * Calculate microaveraged recall (the same as accuracy).
+   */
+  template<AverageStrategy _AS,
+           size_t PC,
+           typename = std::enable_if_t<_AS == Micro>,
+           typename = void>
+  double RecallStrategy() const;
+
+  /**
+   * Calculate macroaveraged recall.
+   */
+  template<AverageStrategy _AS,
+           size_t PC,
+           typename = std::enable_if_t<_AS == Macro>,
+           typename = void,
+           typename = void>
+  double RecallStrategy() const;
+
+  /**
+   * Calculate F1 for binary classification.
+   */
+  template<AverageStrategy _AS,
+           size_t PC,
+           typename = std::enable_if_t<_AS == Binary>>
+  double F1Strategy() const;
+
+  /**
+   * Calculate microaveraged F1 (the same as accuracy).
+   */
+  template<AverageStrategy _AS,
+           size_t PC,
+           typename = std::enable_if_t<_AS == Micro>,
+           typename = void>
+  double F1Strategy() const;
+
+  /**
+   * Calculate macroaveraged F1.
+   */
+  template<AverageStrategy _AS,
+           size_t PC,
+           typename = std::enable_if_t<_AS == Macro>,
+           typename = void,
+           typename = void>
+  double F1Strategy() const;
+
+  //! The number of true positives for the given class.
+  size_t TruePositives(const size_t c) const;
+
+  //! The number of points predicted to be of the given class.
+  size_t PositivePredictions(const size_t c) const;
+
+  //! The number of points actually of the given class.
+  size_t PositiveLabels(const size_t c) const;
+
+  //! The confusion counts; rows are predicted classes, columns are actual
+  //! classes.
+  arma::Mat<size_t> confusion;
+
+  //! The number of classes among the ground truth labels (max(labels) + 1);
+  //! macroaveraged metrics average over these classes.
+  size_t numLabelClasses;
+
+  //! The total number of test items.
+  size_t numPoints;
+};
+
+} // namespace cv
+} // namespace mlpack
+
+// Include implementation.
+#include "multi_metric_impl.hpp"
+
+#endif
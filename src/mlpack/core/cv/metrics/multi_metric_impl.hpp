@@ -0,0 +1,161 @@
+/**
+ * @file core/cv/metrics/multi_metric_impl.hpp
+ * @author Kirill Mishchenko
+ *
+ * The implementation of the class MultiMetric.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_CV_METRICS_MULTI_METRIC_IMPL_HPP
+#define MLPACK_CORE_CV_METRICS_MULTI_METRIC_IMPL_HPP
+
+#include <mlpack/core/cv/metrics/facilities.hpp>
+#include <mlpack/core/data/confusion_matrix.hpp>
+
+namespace mlpack {
+namespace cv {
+
+template<typename MLAlgorithm, typename DataType>
+MultiMetric::MultiMetric(MLAlgorithm& model,
+                         const DataType& data,
+                         const arma::Row<size_t>& labels)
+{
+  AssertSizes(data, labels, "MultiMetric()");
+
+  arma::Row<size_t> predictedLabels;
+  model.Classify(data, predictedLabels);
+
+  // The confusion matrix must be large enough for every class that appears
+  // among either the predictions or the ground truth.
+  const size_t numClasses =
+      std::max(arma::max(labels), arma::max(predictedLabels)) + 1;
+  data::ConfusionMatrix(predictedLabels, labels, confusion, numClasses);
+
+  numLabelClasses = arma::max(labels) + 1;
+  numPoints = labels.n_elem;
+}
+
+inline double MultiMetric::Accuracy() const
+{
+  return (double) arma::trace(confusion) / numPoints;
+}
+
+template<AverageStrategy AS, size_t PC /* PositiveClass */>
+double MultiMetric::Precision() const
+{
+  return PrecisionStrategy<AS, PC>();
+}
+
+template<AverageStrategy AS, size_t PC /* PositiveClass */>
+double MultiMetric::Recall() const
+{
+  return RecallStrategy<AS, PC>();
+}
+
+template<AverageStrategy AS, size_t PC /* PositiveClass */>
+double MultiMetric::F1() const
+{
+  return F1Strategy<AS, PC>();
+}
+
+template<AverageStrategy _AS, size_t PC, typename>
+double MultiMetric::PrecisionStrategy() const
+{
+  return double(TruePositives(PC)) / PositivePredictions(PC);
+}
+
+template<AverageStrategy _AS, size_t PC, typename, typename>
+double MultiMetric::PrecisionStrategy() const
+{
+  // Microaveraged precision is really the same as accuracy.
+  return Accuracy();
+}
+
+template<AverageStrategy _AS, size_t PC, typename, typename, typename>
+double MultiMetric::PrecisionStrategy() const
+{
+  arma::vec precisions = arma::vec(numLabelClasses);
+  for (size_t c = 0; c < numLabelClasses; ++c)
+    precisions(c) = double(TruePositives(c)) / PositivePredictions(c);
+
+  return arma::mean(precisions);
+}
+
+template<AverageStrategy _AS, size_t PC, typename>
+double MultiMetric::RecallStrategy() const
+{
+  return double(TruePositives(PC)) / PositiveLabels(PC);
+}
+
+template<AverageStrategy _AS, size_t PC, typename, typename>
+double MultiMetric::RecallStrategy() const
+{
+  // Microaveraged recall is really the same as accuracy.
+  return Accuracy();
+}
+
+template<AverageStrategy _AS, size_t PC, typename, typename, typename>
+double MultiMetric::RecallStrategy() const
+{
+  arma::vec recalls = arma::vec(numLabelClasses);
+  for (size_t c = 0; c < numLabelClasses; ++c)
+    recalls(c) = double(TruePositives(c)) / PositiveLabels(c);
+
+  return arma::mean(recalls);
+}
+
+template<AverageStrategy _AS, size_t PC, typename>
+double MultiMetric::F1Strategy() const
+{
+  double precision = double(TruePositives(PC)) / PositivePredictions(PC);
+  double recall = double(TruePositives(PC)) / PositiveLabels(PC);
+
+  return (precision + recall == 0.0) ? 0.0 :
+      2.0 * precision * recall / (precision + recall);
+}
+
+template<AverageStrategy _AS, size_t PC, typename, typename>
+double MultiMetric::F1Strategy() const
+{
+  // Microaveraged F1 is really the same as microaveraged precision and
+  // microaveraged recall, which are in turn the same as accuracy.
+  return Accuracy();
+}
+
+template<AverageStrategy _AS, size_t PC, typename, typename, typename>
+double MultiMetric::F1Strategy() const
+{
+  arma::vec f1s = arma::vec(numLabelClasses);
+  for (size_t c = 0; c < numLabelClasses; ++c)
+  {
+    double precision = double(TruePositives(c)) / PositivePredictions(c);
+    double recall = double(TruePositives(c)) / PositiveLabels(c);
+    f1s(c) = (precision + recall == 0.0) ? 0.0 :
+        2.0 * precision * recall / (precision + recall);
+  }
+
+  return arma::mean(f1s);
+}
+
+inline size_t MultiMetric::TruePositives(const size_t c) const
+{
+  return (c < confusion.n_rows) ? confusion(c, c) : 0;
+}
+
+inline size_t MultiMetric::PositivePredictions(const size_t c) const
+{
+  return (c < confusion.n_rows) ? arma::accu(confusion.row(c)) : 0;
+}
+
+inline size_t MultiMetric::PositiveLabels(const size_t c) const
+{
+  return (c < confusion.n_cols) ? arma::accu(confusion.col(c)) : 0;
+}
+
+} // namespace cv
+} // namespace mlpack
+
+#endif
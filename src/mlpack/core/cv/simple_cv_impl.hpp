@@ -293,9 +293,16 @@ double SimpleCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
 {
-  modelPtr.reset(new MLAlgorithm(base.Train(trainingXs, trainingYs, args...)));
+  std::unique_ptr<MLAlgorithm> model(
+      new MLAlgorithm(base.Train(trainingXs, trainingYs, args...)));
+  const double result = Metric::Evaluate(*model, validationXs, validationYs);
 
-  return Metric::Evaluate(*modelPtr, validationXs, validationYs);
+  // Publish the trained model.  The guard makes concurrent Evaluate() calls
+  // (as made by hpt::ParallelGridSearch) safe.
+  #pragma omp critical (cvModel)
+  modelPtr = std::move(model);
+
+  return result;
 }
 
 template<typename MLAlgorithm,
@@ -310,14 +317,20 @@ double SimpleCV<MLAlgorithm,
                 PredictionsType,
                 WeightsType>::TrainAndEvaluate(const MLAlgorithmArgs&... args)
 {
+  std::unique_ptr<MLAlgorithm> model;
   if (trainingWeights.n_elem > 0)
-    modelPtr.reset(new MLAlgorithm(
+    model.reset(new MLAlgorithm(
         base.Train(trainingXs, trainingYs, trainingWeights, args...)));
   else
-    modelPtr.reset(new MLAlgorithm(
+    model.reset(new MLAlgorithm(
         base.Train(trainingXs, trainingYs, args...)));
+  const double result = Metric::Evaluate(*model, validationXs, validationYs);
+
+  // Publish the trained model; see the unweighted overload.
+  #pragma omp critical (cvModel)
+  modelPtr = std::move(model);
 
-  return Metric::Evaluate(*modelPtr, validationXs, validationYs);
+  return result;
 }
 
 } // namespace cv
@@ -0,0 +1,152 @@
+/**
+ * @file core/data/async_checkpoint.hpp
+ * @author Ryan Curtin
+ *
+ * Asynchronous, double-buffered model checkpointing.  A checkpoint snapshots
+ * the model into a shadow copy on the calling thread and then serializes the
+ * copy to disk on a background thread, so long training runs can save
+ * periodic checkpoints without stalling for the duration of the write.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_ASYNC_CHECKPOINT_HPP
+#define MLPACK_CORE_DATA_ASYNC_CHECKPOINT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <future>
+#include <memory>
+
+#include "save.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The AsyncCheckpoint class periodically saves a model to disk while the
+ * model is being trained, without blocking the training thread for the
+ * duration of the write.  When Checkpoint() is called, the model is copied
+ * into an internal shadow buffer (this is the only work done on the calling
+ * thread), and then serialized to disk from the shadow buffer on a background
+ * thread via data::Save().  Because the background thread only ever reads the
+ * shadow copy, training may continue to modify the model immediately.
+ *
+ * At most one save is in flight at a time: if Checkpoint() is called while a
+ * previous save is still running, the new checkpoint is skipped, so
+ * checkpointing can never queue up more than one pending write.
+ *
+ * The class can be used directly by calling Checkpoint() at any safe point
+ * (any point where the model is not concurrently being modified), or it can
+ * be passed as a callback to an ensmallen optimizer---StepTaken() and
+ * EndEpoch() checkpoint the model every `interval` steps (or epochs).
+ *
+ * A simple example of use with FFN::Train():
+ *
+ * @code
+ * FFN<> model;
+ * ...
+ * AsyncCheckpoint<FFN<>> checkpointer(model, "model.bin", "model", 1000);
+ * model.Train(data, labels, opt, checkpointer);
+ * checkpointer.Wait();
+ * @endcode
+ *
+ * @tparam ModelType Type of the model to checkpoint; it must be copyable and
+ *     serializable (so that data::Save() accepts it).
+ */
+template<typename ModelType>
+class AsyncCheckpoint
+{
+ public:
+  /**
+   * Construct the checkpointer for the given model.  The model is held by
+   * reference, so it must outlive this object.
+   *
+   * @param model Model to checkpoint.
+   * @param filename File to save the model to (the format is detected from
+   *     the extension, as with data::Save()).
+   * @param name Name of the structure in the serialized file.
+   * @param interval Number of optimizer steps (or epochs) between
+   *     checkpoints, when used as an ensmallen callback.
+   */
+  AsyncCheckpoint(ModelType& model,
+                  const std::string& filename,
+                  const std::string& name = "model",
+                  const size_t interval = 1);
+
+  /**
+   * Destroy the checkpointer, waiting for any in-flight save to finish.
+   */
+  ~AsyncCheckpoint();
+
+  /**
+   * Snapshot the model and save it on a background thread.  If a previous
+   * save is still in flight, this checkpoint is skipped instead of blocking.
+   *
+   * @return true if a new checkpoint was started, false if it was skipped.
+   */
+  bool Checkpoint();
+
+  /**
+   * Block until any in-flight save has finished.
+   *
+   * @return true if the last started save succeeded (or if no save was ever
+   *     started), false otherwise.
+   */
+  bool Wait();
+
+  /**
+   * Callback for ensmallen optimizers, called after each optimizer step;
+   * checkpoints the model every `interval` steps.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool StepTaken(OptimizerType& /* optimizer */,
+                 FunctionType& /* function */,
+                 const MatType& /* coordinates */);
+
+  /**
+   * Callback for ensmallen optimizers, called at the end of each epoch;
+   * checkpoints the model every `interval` epochs.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool EndEpoch(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& /* coordinates */,
+                const size_t /* epoch */,
+                const double /* objective */);
+
+  //! Get the number of steps between checkpoints.
+  size_t Interval() const { return interval; }
+  //! Modify the number of steps between checkpoints.
+  size_t& Interval() { return interval; }
+
+  //! Get the filename that checkpoints are saved to.
+  const std::string& Filename() const { return filename; }
+
+ private:
+  //! The model being checkpointed.
+  ModelType& model;
+  //! File to save checkpoints to.
+  std::string filename;
+  //! Name of the structure in the serialized file.
+  std::string name;
+  //! Number of steps between checkpoints (for the callback hooks).
+  size_t interval;
+  //! Number of steps seen so far (for the callback hooks).
+  size_t steps;
+  //! Shadow copy of the model; only the background thread reads this.
+  std::unique_ptr<ModelType> shadow;
+  //! Result of the in-flight save, if any.
+  std::future<bool> saveResult;
+  //! Result of the last completed save.
+  bool lastResult;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "async_checkpoint_impl.hpp"
+
+#endif
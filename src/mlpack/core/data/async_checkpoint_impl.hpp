@@ -0,0 +1,107 @@
+/**
+ * @file core/data/async_checkpoint_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the AsyncCheckpoint class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_ASYNC_CHECKPOINT_IMPL_HPP
+#define MLPACK_CORE_DATA_ASYNC_CHECKPOINT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "async_checkpoint.hpp"
+
+namespace mlpack {
+namespace data {
+
+template<typename ModelType>
+AsyncCheckpoint<ModelType>::AsyncCheckpoint(ModelType& model,
+                                            const std::string& filename,
+                                            const std::string& name,
+                                            const size_t interval) :
+    model(model),
+    filename(filename),
+    name(name),
+    interval(std::max(interval, size_t(1))),
+    steps(0),
+    lastResult(true)
+{ /* Nothing to do. */ }
+
+template<typename ModelType>
+AsyncCheckpoint<ModelType>::~AsyncCheckpoint()
+{
+  Wait();
+}
+
+template<typename ModelType>
+bool AsyncCheckpoint<ModelType>::Checkpoint()
+{
+  // If the previous save is still running, skip this checkpoint rather than
+  // stalling the training thread.
+  if (saveResult.valid())
+  {
+    if (saveResult.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready)
+      return false;
+    lastResult = saveResult.get();
+  }
+
+  // Snapshot the model into the shadow buffer.  This copy is the only work
+  // done on the calling thread; the background thread reads the shadow copy
+  // exclusively, so the caller may modify the model as soon as we return.
+  shadow.reset(new ModelType(model));
+
+  ModelType* snapshot = shadow.get();
+  const std::string file = filename;
+  const std::string structName = name;
+  saveResult = std::async(std::launch::async,
+      [snapshot, file, structName]()
+      {
+        return Save(file, structName, *snapshot, false);
+      });
+
+  return true;
+}
+
+template<typename ModelType>
+bool AsyncCheckpoint<ModelType>::Wait()
+{
+  if (saveResult.valid())
+    lastResult = saveResult.get();
+  return lastResult;
+}
+
+template<typename ModelType>
+template<typename OptimizerType, typename FunctionType, typename MatType>
+bool AsyncCheckpoint<ModelType>::StepTaken(OptimizerType& /* optimizer */,
+                                           FunctionType& /* function */,
+                                           const MatType& /* coordinates */)
+{
+  if (++steps % interval == 0)
+    Checkpoint();
+
+  return false; // Never terminate the optimization.
+}
+
+template<typename ModelType>
+template<typename OptimizerType, typename FunctionType, typename MatType>
+bool AsyncCheckpoint<ModelType>::EndEpoch(OptimizerType& /* optimizer */,
+                                          FunctionType& /* function */,
+                                          const MatType& /* coordinates */,
+                                          const size_t epoch,
+                                          const double /* objective */)
+{
+  if (epoch % interval == 0)
+    Checkpoint();
+
+  return false; // Never terminate the optimization.
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -15,9 +15,54 @@
 
 #include <mlpack/prereqs.hpp>
 
+#include "elementwise_transform.hpp"
+
 namespace mlpack {
 namespace data {
 
+/**
+ * Given a matrix and a threshold, set values greater than the threshold to 1
+ * and values less than or equal to the threshold to 0, in place.  The
+ * compare-and-select is branchless and runs in one pass over the matrix
+ * memory, parallelized with OpenMP.
+ *
+ * @code
+ * arma::Mat<double> input = loadData();
+ * double threshold = 0.5;
+ *
+ * // Binarize the whole matrix in place against the threshold 0.5.
+ * Binarize(input, threshold);
+ * @endcode
+ *
+ * @param input Matrix to binarize in place.
+ * @param threshold Threshold can be any number.
+ */
+template<typename T>
+void Binarize(arma::Mat<T>& input, const double threshold)
+{
+  ElementwiseTransform(input, [threshold](const T value)
+      { return (T) (value > threshold); });
+}
+
+/**
+ * Given a matrix, a threshold, and a dimension, set values of the given
+ * dimension greater than the threshold to 1 and values less than or equal to
+ * the threshold to 0, in place.
+ *
+ * @param input Matrix to binarize in place.
+ * @param threshold Threshold can be any number.
+ * @param dimension Feature to apply the Binarize function to.
+ */
+template<typename T>
+void Binarize(arma::Mat<T>& input,
+              const double threshold,
+              const size_t dimension)
+{
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) input.n_cols; ++i)
+    input(dimension, i) = input(dimension, i) > threshold;
+}
+
 /**
  * Given an input dataset and threshold, set values greater than threshold to
  * 1 and values less than or equal to the threshold to 0. This overload applies
@@ -42,14 +87,8 @@ void Binarize(const arma::Mat<T>& input,
               arma::Mat<T>& output,
               const double threshold)
 {
-  output.copy_size(input);
-
-  const T *inPtr = input.memptr();
-  T *outPtr = output.memptr();
-
-  #pragma omp parallel for
-  for (omp_size_t i = 0; i < (omp_size_t) input.n_elem; ++i)
-    outPtr[i] = inPtr[i] > threshold;
+  ElementwiseTransform(input, output, [threshold](const T value)
+      { return (T) (value > threshold); });
 }
 
 /**
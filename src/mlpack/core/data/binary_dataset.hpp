@@ -0,0 +1,129 @@
+/**
+ * @file core/data/binary_dataset.hpp
+ * @author Ryan Curtin
+ *
+ * An mlpack-native indexed binary dataset format.  The format is seekable and
+ * stores per-dimension minimum/maximum statistics in the header, so repeated
+ * loads are pure sequential I/O, partial (column-range) loads need no full
+ * file scan, and consumers such as the scalers in core/data/scaler_methods
+ * can obtain data statistics without a pass over the data.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_BINARY_DATASET_HPP
+#define MLPACK_CORE_DATA_BINARY_DATASET_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+#include <string>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Metadata of an indexed binary dataset file, as stored in its header.
+ *
+ * The on-disk layout of the format (version 1) is:
+ *
+ *  - 8-byte magic string "MLPKBIN\0";
+ *  - uint32_t format version;
+ *  - uint32_t element size in bytes;
+ *  - uint64_t number of rows (dimensions);
+ *  - uint64_t number of columns (points);
+ *  - uint64_t number of columns per column group;
+ *  - per-dimension minima (rows doubles), then maxima (rows doubles);
+ *  - the column groups, each holding up to `groupCols` columns in
+ *    column-major order, with the start of every group padded to a 64-byte
+ *    file offset so that a group maps to aligned memory.
+ */
+struct BinaryDatasetInfo
+{
+  //! Number of rows (dimensions) of the stored matrix.
+  uint64_t rows;
+  //! Number of columns (points) of the stored matrix.
+  uint64_t cols;
+  //! Number of columns in each column group (the last group may be smaller).
+  uint64_t groupCols;
+  //! Size of a stored element, in bytes.
+  uint32_t elemSize;
+  //! Per-dimension minima of the stored data.
+  arma::vec mins;
+  //! Per-dimension maxima of the stored data.
+  arma::vec maxs;
+};
+
+/**
+ * Save the given matrix to the given file in the indexed binary dataset
+ * format, computing the per-dimension statistics for the header.
+ *
+ * @param filename Name of file to save to.
+ * @param matrix Matrix to save.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param groupCols Number of columns per 64-byte-aligned column group
+ *     (default 4096).
+ * @return Boolean value indicating success or failure of save.
+ */
+template<typename eT>
+bool SaveBinaryDataset(const std::string& filename,
+                       const arma::Mat<eT>& matrix,
+                       const bool fatal = false,
+                       const size_t groupCols = 4096);
+
+/**
+ * Load an entire matrix from a file in the indexed binary dataset format.
+ *
+ * @param filename Name of file to load from.
+ * @param matrix Matrix to load into.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool LoadBinaryDataset(const std::string& filename,
+                       arma::Mat<eT>& matrix,
+                       const bool fatal = false);
+
+/**
+ * Load a contiguous range of columns [firstCol, firstCol + numCols) from a
+ * file in the indexed binary dataset format.  Only the column groups that
+ * intersect the range are read, so the cost is proportional to the size of
+ * the range, not the size of the file.
+ *
+ * @param filename Name of file to load from.
+ * @param matrix Matrix to load the columns into.
+ * @param firstCol First column of the range to load.
+ * @param numCols Number of columns to load.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool LoadBinaryDataset(const std::string& filename,
+                       arma::Mat<eT>& matrix,
+                       const size_t firstCol,
+                       const size_t numCols,
+                       const bool fatal = false);
+
+/**
+ * Read only the header of a file in the indexed binary dataset format.  This
+ * provides the matrix shape and the per-dimension min/max statistics without
+ * touching the data itself, so scalers (e.g. MinMaxScaler) and splitters can
+ * skip their statistics pass.
+ *
+ * @param filename Name of file to inspect.
+ * @param info Metadata object to fill.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure.
+ */
+bool ReadBinaryDatasetInfo(const std::string& filename,
+                           BinaryDatasetInfo& info,
+                           const bool fatal = false);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "binary_dataset_impl.hpp"
+
+#endif
@@ -0,0 +1,313 @@
+/**
+ * @file core/data/binary_dataset_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the indexed binary dataset format reader and writer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_BINARY_DATASET_IMPL_HPP
+#define MLPACK_CORE_DATA_BINARY_DATASET_IMPL_HPP
+
+// In case it hasn't already been included.
+#include "binary_dataset.hpp"
+
+#include <cstring>
+#include <fstream>
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+//! Magic string identifying the indexed binary dataset format.
+static const char binaryDatasetMagic[8] = { 'M', 'L', 'P', 'K', 'B', 'I', 'N',
+    '\0' };
+
+//! Current version of the format.
+static const uint32_t binaryDatasetVersion = 1;
+
+//! Round the given file offset up to the next multiple of 64 bytes.
+inline uint64_t AlignTo64(const uint64_t offset)
+{
+  return (offset + 63) & ~uint64_t(63);
+}
+
+//! File offset at which the column groups start.
+inline uint64_t BinaryDatasetDataStart(const uint64_t rows)
+{
+  // Magic (8) + version (4) + element size (4) + rows/cols/groupCols (24),
+  // then the min and max statistics (2 * rows doubles), padded so the first
+  // column group is 64-byte aligned.
+  return AlignTo64(40 + 2 * rows * sizeof(double));
+}
+
+//! Size in the file of one full column group (including alignment padding).
+inline uint64_t BinaryDatasetGroupStride(const uint64_t rows,
+                                         const uint64_t groupCols,
+                                         const uint64_t elemSize)
+{
+  return AlignTo64(rows * groupCols * elemSize);
+}
+
+//! Read and validate the header; returns false (with a message) on failure.
+inline bool ReadBinaryDatasetHeader(std::ifstream& f,
+                                    const std::string& filename,
+                                    BinaryDatasetInfo& info,
+                                    std::string& error)
+{
+  char magic[8];
+  f.read(magic, 8);
+  if (!f.good() || std::memcmp(magic, binaryDatasetMagic, 8) != 0)
+  {
+    error = "File '" + filename + "' is not an mlpack indexed binary "
+        "dataset!";
+    return false;
+  }
+
+  uint32_t version;
+  f.read((char*) &version, sizeof(version));
+  if (!f.good() || version != binaryDatasetVersion)
+  {
+    error = "File '" + filename + "' has an unsupported indexed binary "
+        "dataset version!";
+    return false;
+  }
+
+  f.read((char*) &info.elemSize, sizeof(info.elemSize));
+  f.read((char*) &info.rows, sizeof(info.rows));
+  f.read((char*) &info.cols, sizeof(info.cols));
+  f.read((char*) &info.groupCols, sizeof(info.groupCols));
+  if (!f.good() || info.rows == 0 || info.groupCols == 0)
+  {
+    error = "File '" + filename + "' has a corrupt indexed binary dataset "
+        "header!";
+    return false;
+  }
+
+  info.mins.set_size(info.rows);
+  info.maxs.set_size(info.rows);
+  f.read((char*) info.mins.memptr(), info.rows * sizeof(double));
+  f.read((char*) info.maxs.memptr(), info.rows * sizeof(double));
+  if (!f.good())
+  {
+    error = "File '" + filename + "' has a truncated indexed binary dataset "
+        "header!";
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace details
+
+template<typename eT>
+bool SaveBinaryDataset(const std::string& filename,
+                       const arma::Mat<eT>& matrix,
+                       const bool fatal,
+                       const size_t groupCols)
+{
+  Timer::Start("saving_data");
+
+  std::ofstream f(filename, std::ios::binary);
+  if (!f.is_open())
+  {
+    Timer::Stop("saving_data");
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "' for writing. "
+          << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "' for writing; save "
+          << "failed." << std::endl;
+
+    return false;
+  }
+
+  // Compute the per-dimension statistics for the header.
+  arma::vec mins(matrix.n_rows), maxs(matrix.n_rows);
+  if (matrix.n_cols > 0)
+  {
+    mins = arma::conv_to<arma::vec>::from(arma::min(matrix, 1));
+    maxs = arma::conv_to<arma::vec>::from(arma::max(matrix, 1));
+  }
+  else
+  {
+    mins.zeros();
+    maxs.zeros();
+  }
+
+  const uint64_t rows = matrix.n_rows;
+  const uint64_t cols = matrix.n_cols;
+  const uint64_t gCols = groupCols;
+  const uint32_t elemSize = sizeof(eT);
+
+  f.write(details::binaryDatasetMagic, 8);
+  f.write((const char*) &details::binaryDatasetVersion, sizeof(uint32_t));
+  f.write((const char*) &elemSize, sizeof(elemSize));
+  f.write((const char*) &rows, sizeof(rows));
+  f.write((const char*) &cols, sizeof(cols));
+  f.write((const char*) &gCols, sizeof(gCols));
+  f.write((const char*) mins.memptr(), rows * sizeof(double));
+  f.write((const char*) maxs.memptr(), rows * sizeof(double));
+
+  // Pad so the first column group is 64-byte aligned, then write the groups,
+  // padding each to a 64-byte boundary.
+  const char zeros[64] = { 0 };
+  uint64_t offset = 40 + 2 * rows * sizeof(double);
+  f.write(zeros, details::AlignTo64(offset) - offset);
+  offset = details::AlignTo64(offset);
+
+  for (uint64_t start = 0; start < cols; start += gCols)
+  {
+    const uint64_t thisGroup = std::min(gCols, cols - start);
+    const uint64_t groupBytes = rows * thisGroup * sizeof(eT);
+    f.write((const char*) matrix.colptr(start), groupBytes);
+    offset += groupBytes;
+    f.write(zeros, details::AlignTo64(offset) - offset);
+    offset = details::AlignTo64(offset);
+  }
+
+  const bool success = f.good();
+  f.close();
+  Timer::Stop("saving_data");
+
+  if (!success)
+  {
+    if (fatal)
+      Log::Fatal << "Save to '" << filename << "' failed." << std::endl;
+    else
+      Log::Warn << "Save to '" << filename << "' failed." << std::endl;
+  }
+
+  return success;
+}
+
+template<typename eT>
+bool LoadBinaryDataset(const std::string& filename,
+                       arma::Mat<eT>& matrix,
+                       const bool fatal)
+{
+  BinaryDatasetInfo info;
+  if (!ReadBinaryDatasetInfo(filename, info, fatal))
+    return false;
+
+  return LoadBinaryDataset(filename, matrix, 0, info.cols, fatal);
+}
+
+template<typename eT>
+bool LoadBinaryDataset(const std::string& filename,
+                       arma::Mat<eT>& matrix,
+                       const size_t firstCol,
+                       const size_t numCols,
+                       const bool fatal)
+{
+  Timer::Start("loading_data");
+
+  std::ifstream f(filename, std::ios::binary);
+  std::string error;
+  BinaryDatasetInfo info;
+  if (!f.is_open())
+    error = "Cannot open file '" + filename + "'. ";
+  else
+    details::ReadBinaryDatasetHeader(f, filename, info, error);
+
+  if (error.empty() && info.elemSize != sizeof(eT))
+  {
+    std::ostringstream oss;
+    oss << "File '" << filename << "' holds " << info.elemSize << "-byte "
+        << "elements, but a matrix with " << sizeof(eT) << "-byte elements "
+        << "was requested!";
+    error = oss.str();
+  }
+
+  if (error.empty() && (firstCol + numCols > info.cols))
+  {
+    std::ostringstream oss;
+    oss << "Column range [" << firstCol << ", " << (firstCol + numCols)
+        << ") is out of bounds for file '" << filename << "' with "
+        << info.cols << " columns!";
+    error = oss.str();
+  }
+
+  if (!error.empty())
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << error << std::endl;
+    else
+      Log::Warn << error << std::endl;
+
+    return false;
+  }
+
+  matrix.set_size(info.rows, numCols);
+
+  // Read only the column groups that intersect the requested range.
+  const uint64_t dataStart = details::BinaryDatasetDataStart(info.rows);
+  const uint64_t stride = details::BinaryDatasetGroupStride(info.rows,
+      info.groupCols, info.elemSize);
+
+  size_t colsDone = 0;
+  while (colsDone < numCols)
+  {
+    const uint64_t col = firstCol + colsDone;
+    const uint64_t group = col / info.groupCols;
+    const uint64_t colInGroup = col % info.groupCols;
+
+    // Read from this column to the end of the group (or range).
+    const uint64_t colsInGroup = std::min((uint64_t) (numCols - colsDone),
+        info.groupCols - colInGroup);
+
+    f.seekg(dataStart + group * stride +
+        colInGroup * info.rows * sizeof(eT));
+    f.read((char*) matrix.colptr(colsDone),
+        colsInGroup * info.rows * sizeof(eT));
+
+    colsDone += colsInGroup;
+  }
+
+  const bool success = f.good();
+  Timer::Stop("loading_data");
+
+  if (!success)
+  {
+    if (fatal)
+      Log::Fatal << "File '" << filename << "' is truncated!" << std::endl;
+    else
+      Log::Warn << "File '" << filename << "' is truncated!" << std::endl;
+  }
+
+  return success;
+}
+
+inline bool ReadBinaryDatasetInfo(const std::string& filename,
+                                  BinaryDatasetInfo& info,
+                                  const bool fatal)
+{
+  std::ifstream f(filename, std::ios::binary);
+  std::string error;
+  if (!f.is_open())
+    error = "Cannot open file '" + filename + "'. ";
+  else
+    details::ReadBinaryDatasetHeader(f, filename, info, error);
+
+  if (!error.empty())
+  {
+    if (fatal)
+      Log::Fatal << error << std::endl;
+    else
+      Log::Warn << error << std::endl;
+
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
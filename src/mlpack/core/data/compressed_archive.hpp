@@ -0,0 +1,75 @@
+/**
+ * @file core/data/compressed_archive.hpp
+ * @author Ryan Curtin
+ *
+ * Chunked, compressed model archives.  Serialized models built around large
+ * matrices spend most of their bytes on highly redundant payloads; these
+ * functions serialize an object to an in-memory binary archive, split the
+ * archive into fixed-size chunks, and compress every chunk independently with
+ * an in-tree LZ77 byte codec.  Because the chunks share no state, compression
+ * and decompression both parallelize across cores, so large models both
+ * shrink and load/store faster than with a plain binary archive.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COMPRESSED_ARCHIVE_HPP
+#define MLPACK_CORE_DATA_COMPRESSED_ARCHIVE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Serialize the given object into a compressed archive file.  The object is
+ * first serialized into an in-memory boost binary archive, which is then
+ * split into fixed-size chunks; the chunks are compressed in parallel and
+ * written back to back after a small index of compressed chunk sizes.  A
+ * chunk that does not shrink under compression is stored raw, so the archive
+ * is never more than a few bytes per chunk larger than the uncompressed
+ * serialization.
+ *
+ * Like data::Save() with format::binary, the archive is not portable across
+ * machines with different endianness.
+ *
+ * @param filename File to save the compressed archive to.
+ * @param name Name of the object to serialize (as for data::Save()).
+ * @param t Object to serialize.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of the save.
+ */
+template<typename T>
+bool SaveCompressed(const std::string& filename,
+                    const std::string& name,
+                    T& t,
+                    const bool fatal = false);
+
+/**
+ * Load an object from a compressed archive file written by SaveCompressed().
+ * The chunks are decompressed in parallel, each directly into its own slice
+ * of the reassembled archive, and the object is then deserialized from the
+ * in-memory archive.
+ *
+ * @param filename File to load the compressed archive from.
+ * @param name Name of the object to deserialize (as passed to
+ *     SaveCompressed()).
+ * @param t Object to deserialize into.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of the load.
+ */
+template<typename T>
+bool LoadCompressed(const std::string& filename,
+                    const std::string& name,
+                    T& t,
+                    const bool fatal = false);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "compressed_archive_impl.hpp"
+
+#endif
@@ -0,0 +1,384 @@
+/**
+ * @file core/data/compressed_archive_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the chunked compressed model archive, including the
+ * in-tree LZ77 byte codec the chunks are compressed with.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_COMPRESSED_ARCHIVE_IMPL_HPP
+#define MLPACK_CORE_DATA_COMPRESSED_ARCHIVE_IMPL_HPP
+
+// In case it hasn't already been included.
+#include "compressed_archive.hpp"
+
+#include <mlpack/core/util/log.hpp>
+#include <mlpack/core/util/timers.hpp>
+#include <mlpack/core/util/parallel.hpp>
+
+#include <boost/serialization/serialization.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+//! Magic string identifying a compressed archive (and its format version).
+inline const char* CompressedArchiveMagic()
+{
+  return "mlpack_compressed_model_1\n";
+}
+
+//! Size of the independently compressed chunks (4MB).  Chunks this large
+//! amortize the per-chunk dictionary reset while leaving enough chunks for
+//! all cores on any model big enough for compression time to matter.
+const size_t compressedArchiveChunkSize = (size_t) 1 << 22;
+
+//! Append the LZ77 length extension encoding of value to out.
+inline void AppendLengthExtension(std::vector<unsigned char>& out,
+                                  size_t value)
+{
+  while (value >= 255)
+  {
+    out.push_back(255);
+    value -= 255;
+  }
+  out.push_back((unsigned char) value);
+}
+
+/**
+ * Compress a block of bytes with a greedy LZ77 scheme: sequences of a token
+ * byte (literal length and match length nibbles, each extended with 255-run
+ * bytes when saturated), the literals, a two-byte little-endian match offset,
+ * and an implied minimum match length of 4.  The final sequence of a block
+ * carries literals only.  The format is the classic byte-oriented LZ
+ * arrangement used by the zstd/LZ4 family; the match finder is a single
+ * 32K-entry hash table over 4-byte windows, tuned for speed over ratio.
+ */
+inline void CompressBlock(const unsigned char* in,
+                          const size_t inSize,
+                          std::vector<unsigned char>& out)
+{
+  out.clear();
+  out.reserve(inSize / 2);
+
+  std::vector<int64_t> table((size_t) 1 << 15, -1);
+
+  size_t literalStart = 0;
+  size_t i = 0;
+  while (i + 4 <= inSize)
+  {
+    uint32_t window;
+    std::memcpy(&window, in + i, 4);
+    const uint32_t hash = (window * 2654435761U) >> 17;
+
+    const int64_t candidate = table[hash];
+    table[hash] = (int64_t) i;
+
+    if (candidate >= 0 && (i - (size_t) candidate) <= 65535 &&
+        std::memcmp(in + candidate, in + i, 4) == 0)
+    {
+      // Extend the match as far as it goes.
+      size_t length = 4;
+      while (i + length < inSize &&
+          in[(size_t) candidate + length] == in[i + length])
+        ++length;
+
+      const size_t literals = i - literalStart;
+      const size_t offset = i - (size_t) candidate;
+
+      unsigned char token = (unsigned char)
+          ((std::min(literals, (size_t) 15) << 4) |
+           std::min(length - 4, (size_t) 15));
+      out.push_back(token);
+      if (literals >= 15)
+        AppendLengthExtension(out, literals - 15);
+      out.insert(out.end(), in + literalStart, in + i);
+      out.push_back((unsigned char) (offset & 0xff));
+      out.push_back((unsigned char) (offset >> 8));
+      if (length - 4 >= 15)
+        AppendLengthExtension(out, length - 4 - 15);
+
+      i += length;
+      literalStart = i;
+    }
+    else
+    {
+      ++i;
+    }
+  }
+
+  // The final sequence: remaining literals, no match.
+  const size_t literals = inSize - literalStart;
+  out.push_back((unsigned char) (std::min(literals, (size_t) 15) << 4));
+  if (literals >= 15)
+    AppendLengthExtension(out, literals - 15);
+  out.insert(out.end(), in + literalStart, in + inSize);
+}
+
+/**
+ * Decompress a block written by CompressBlock().  Returns false if the
+ * compressed data is malformed (truncated input, out-of-range offsets, or a
+ * size mismatch with the expected output size).
+ */
+inline bool DecompressBlock(const unsigned char* in,
+                            const size_t inSize,
+                            unsigned char* out,
+                            const size_t outSize)
+{
+  size_t ip = 0;
+  size_t op = 0;
+  while (ip < inSize)
+  {
+    const unsigned char token = in[ip++];
+
+    size_t literals = token >> 4;
+    if (literals == 15)
+    {
+      unsigned char extension;
+      do
+      {
+        if (ip >= inSize)
+          return false;
+        extension = in[ip++];
+        literals += extension;
+      } while (extension == 255);
+    }
+
+    if (ip + literals > inSize || op + literals > outSize)
+      return false;
+    std::memcpy(out + op, in + ip, literals);
+    ip += literals;
+    op += literals;
+
+    if (ip == inSize)
+      break; // The final sequence has no match.
+
+    if (ip + 2 > inSize)
+      return false;
+    const size_t offset = (size_t) in[ip] | ((size_t) in[ip + 1] << 8);
+    ip += 2;
+
+    size_t length = (size_t) (token & 15) + 4;
+    if ((token & 15) == 15)
+    {
+      unsigned char extension;
+      do
+      {
+        if (ip >= inSize)
+          return false;
+        extension = in[ip++];
+        length += extension;
+      } while (extension == 255);
+    }
+
+    if (offset == 0 || offset > op || op + length > outSize)
+      return false;
+    // The match may overlap its own output, so copy byte by byte.
+    for (size_t j = 0; j < length; ++j, ++op)
+      out[op] = out[op - offset];
+  }
+
+  return (op == outSize);
+}
+
+} // namespace details
+
+template<typename T>
+bool SaveCompressed(const std::string& filename,
+                    const std::string& name,
+                    T& t,
+                    const bool fatal)
+{
+  Timer::Start("saving_data");
+
+  // Serialize the object into an in-memory binary archive.
+  std::ostringstream oss(std::ios::binary);
+  {
+    boost::archive::binary_oarchive ar(oss);
+    ar << boost::serialization::make_nvp(name.c_str(), t);
+  }
+  const std::string archive = oss.str();
+  const unsigned char* bytes = (const unsigned char*) archive.data();
+
+  // Compress the chunks in parallel; each chunk is independent.
+  const size_t chunkSize = details::compressedArchiveChunkSize;
+  const size_t numChunks = (archive.size() + chunkSize - 1) / chunkSize;
+  std::vector<std::vector<unsigned char>> compressed(numChunks);
+  Parallel::For(0, numChunks, [&](const size_t i)
+  {
+    const size_t begin = i * chunkSize;
+    const size_t size = std::min(chunkSize, archive.size() - begin);
+    details::CompressBlock(bytes + begin, size, compressed[i]);
+    // If the chunk did not shrink, store it raw; a stored size equal to the
+    // uncompressed size marks a raw chunk.
+    if (compressed[i].size() >= size)
+      compressed[i].assign(bytes + begin, bytes + begin + size);
+  });
+
+  std::ofstream ofs(filename, std::ofstream::out | std::ofstream::binary);
+  if (!ofs.is_open())
+  {
+    Timer::Stop("saving_data");
+    if (fatal)
+      Log::Fatal << "Unable to open file '" << filename << "' to save object '"
+          << name << "'." << std::endl;
+    else
+      Log::Warn << "Unable to open file '" << filename << "' to save object '"
+          << name << "'." << std::endl;
+    return false;
+  }
+
+  // Header: magic, uncompressed archive size, and the compressed chunk sizes
+  // (the chunk size of the format is fixed, so offsets follow from these).
+  ofs.write(details::CompressedArchiveMagic(),
+      strlen(details::CompressedArchiveMagic()));
+  const uint64_t archiveSize = (uint64_t) archive.size();
+  ofs.write((const char*) &archiveSize, sizeof(uint64_t));
+  const uint64_t chunks = (uint64_t) numChunks;
+  ofs.write((const char*) &chunks, sizeof(uint64_t));
+  for (size_t i = 0; i < numChunks; ++i)
+  {
+    const uint64_t compressedSize = (uint64_t) compressed[i].size();
+    ofs.write((const char*) &compressedSize, sizeof(uint64_t));
+  }
+
+  for (size_t i = 0; i < numChunks; ++i)
+    ofs.write((const char*) compressed[i].data(), compressed[i].size());
+
+  Timer::Stop("saving_data");
+  return !ofs.fail();
+}
+
+template<typename T>
+bool LoadCompressed(const std::string& filename,
+                    const std::string& name,
+                    T& t,
+                    const bool fatal)
+{
+  Timer::Start("loading_data");
+
+  std::ifstream ifs(filename, std::ifstream::in | std::ifstream::binary);
+  if (!ifs.is_open())
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Unable to open file '" << filename << "' to load object '"
+          << name << "'." << std::endl;
+    else
+      Log::Warn << "Unable to open file '" << filename << "' to load object '"
+          << name << "'." << std::endl;
+    return false;
+  }
+
+  // Check the magic string before trusting any of the header fields.
+  const std::string magic = details::CompressedArchiveMagic();
+  std::vector<char> magicBuffer(magic.size());
+  ifs.read(magicBuffer.data(), magicBuffer.size());
+  bool valid = !ifs.fail() &&
+      std::equal(magic.begin(), magic.end(), magicBuffer.begin());
+
+  const size_t chunkSize = details::compressedArchiveChunkSize;
+  uint64_t archiveSize = 0, numChunks = 0;
+  std::vector<uint64_t> compressedSizes;
+  if (valid)
+  {
+    ifs.read((char*) &archiveSize, sizeof(uint64_t));
+    ifs.read((char*) &numChunks, sizeof(uint64_t));
+    valid = !ifs.fail() &&
+        (numChunks == (archiveSize + chunkSize - 1) / chunkSize);
+  }
+  if (valid && numChunks > 0)
+  {
+    compressedSizes.resize(numChunks);
+    ifs.read((char*) compressedSizes.data(), numChunks * sizeof(uint64_t));
+    valid = !ifs.fail();
+  }
+
+  // Read the compressed payload in one pass, then decompress every chunk in
+  // parallel, directly into its slice of the reassembled archive.
+  std::vector<size_t> offsets(numChunks + 1, 0);
+  for (size_t i = 0; valid && i < numChunks; ++i)
+    offsets[i + 1] = offsets[i] + (size_t) compressedSizes[i];
+
+  std::vector<unsigned char> payload;
+  std::string archive;
+  if (valid)
+  {
+    payload.resize(offsets[numChunks]);
+    ifs.read((char*) payload.data(), payload.size());
+    valid = !ifs.fail();
+  }
+
+  if (valid)
+  {
+    archive.resize((size_t) archiveSize);
+    std::vector<char> chunkValid(numChunks, 1);
+    Parallel::For(0, (size_t) numChunks, [&](const size_t i)
+    {
+      const size_t begin = i * chunkSize;
+      const size_t size = std::min(chunkSize, (size_t) archiveSize - begin);
+      unsigned char* out = (unsigned char*) &archive[0] + begin;
+      if ((size_t) compressedSizes[i] == size)
+      {
+        // A raw (incompressible) chunk.
+        std::memcpy(out, payload.data() + offsets[i], size);
+      }
+      else if (!details::DecompressBlock(payload.data() + offsets[i],
+          (size_t) compressedSizes[i], out, size))
+      {
+        chunkValid[i] = 0;
+      }
+    });
+
+    for (size_t i = 0; i < numChunks; ++i)
+      valid &= (chunkValid[i] != 0);
+  }
+
+  if (!valid)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "'" << filename << "' is not a valid compressed archive; "
+          << "unable to load object '" << name << "'." << std::endl;
+    else
+      Log::Warn << "'" << filename << "' is not a valid compressed archive; "
+          << "unable to load object '" << name << "'." << std::endl;
+    return false;
+  }
+
+  bool success = true;
+  try
+  {
+    std::istringstream iss(archive, std::ios::binary);
+    boost::archive::binary_iarchive ar(iss);
+    ar >> boost::serialization::make_nvp(name.c_str(), t);
+  }
+  catch (boost::archive::archive_exception& e)
+  {
+    success = false;
+    if (fatal)
+      Log::Fatal << e.what() << std::endl;
+    else
+      Log::Warn << e.what() << std::endl;
+  }
+
+  Timer::Stop("loading_data");
+  return success;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
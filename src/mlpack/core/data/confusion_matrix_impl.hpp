@@ -16,6 +16,8 @@
 // In case it hasn't been included yet.
 #include "confusion_matrix.hpp"
 
+#include <mlpack/core/util/parallel.hpp>
+
 namespace mlpack {
 namespace data {
 
@@ -52,12 +54,17 @@ void ConfusionMatrix(const arma::Row<size_t> predictors,
                      arma::Mat<eT>& output,
                      const size_t numClasses)
 {
-  // Loop over the actual labels and predicted labels and add the count.
-  output = arma::zeros<arma::Mat<eT> >(numClasses, numClasses);
-  for (size_t i = 0; i < predictors.n_elem; ++i)
-  {
-    output.at(predictors[i], responses[i])++;
-  }
+  // Loop over the actual labels and predicted labels and add the count.  Each
+  // thread accumulates counts into its own matrix; the per-thread matrices
+  // are then summed.
+  const arma::Mat<eT> identity =
+      arma::zeros<arma::Mat<eT> >(numClasses, numClasses);
+  output = Parallel::ReduceFor(predictors.n_elem, identity,
+      [&](arma::Mat<eT>& counts, const size_t i)
+      {
+        counts.at(predictors[i], responses[i])++;
+      },
+      [](arma::Mat<eT>& to, const arma::Mat<eT>& from) { to += from; });
 }
 
 } // namespace data
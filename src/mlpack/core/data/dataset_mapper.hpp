@@ -128,6 +128,28 @@ class DatasetMapper
   typename PolicyType::MappedType UnmapValue(const InputType& input,
                                              const size_t dimension);
 
+  /**
+   * Merge the mappings of another DatasetMapper of the same dimensionality
+   * into this one.  This is meant for parallel loading: each thread can
+   * accumulate mappings for its chunk of the data in a local mapper, lock
+   * free, and the local mappers are then merged into the final mapper.  For
+   * every mapped value of the other mapper whose mapping changed in the
+   * merge, `translations` receives an entry for its dimension mapping the
+   * other mapper's value to this mapper's value; values without an entry are
+   * unchanged.  The other mapper's mappings are walked in mapping order, so
+   * the merged mapping does not depend on unordered_map iteration order.
+   *
+   * This is only meaningful for policies that assign incrementing mappings
+   * (such as IncrementPolicy).
+   *
+   * @param other Mapper whose mappings should be merged into this one.
+   * @param translations Output translation tables, one per dimension.
+   */
+  void Merge(const DatasetMapper& other,
+             std::unordered_map<size_t,
+                 std::unordered_map<typename PolicyType::MappedType,
+                     typename PolicyType::MappedType>>& translations);
+
   //! Return the type of a given dimension (numeric or categorical).
   Datatype Type(const size_t dimension) const;
   //! Modify the type of a given dimension (be careful!).
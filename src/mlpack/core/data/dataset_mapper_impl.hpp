@@ -191,6 +191,65 @@ DatasetMapper<PolicyType, InputType>::UnmapValue(
   return maps[dimension].first.at(input);
 }
 
+template<typename PolicyType, typename InputType>
+inline void DatasetMapper<PolicyType, InputType>::Merge(
+    const DatasetMapper<PolicyType, InputType>& other,
+    std::unordered_map<size_t,
+        std::unordered_map<typename PolicyType::MappedType,
+            typename PolicyType::MappedType>>& translations)
+{
+  typedef typename PolicyType::MappedType MappedType;
+
+  translations.clear();
+  for (typename MapType::const_iterator dimIt = other.maps.begin();
+       dimIt != other.maps.end(); ++dimIt)
+  {
+    const size_t dimension = dimIt->first;
+    const ReverseMapType& otherReverse = dimIt->second.second;
+
+    ForwardMapType& forward = maps[dimension].first;
+    ReverseMapType& reverse = maps[dimension].second;
+
+    // Walk the other mapper's mappings in mapping order, so that the result
+    // of merging a fixed set of mappers is always the same.
+    for (size_t code = 0; code < otherReverse.size(); ++code)
+    {
+      const std::vector<InputType>& inputs =
+          otherReverse.at((MappedType) code);
+
+      // All of these inputs share one mapping in the other mapper, so the
+      // first one determines the merged mapping.
+      typename ForwardMapType::const_iterator it = forward.find(inputs[0]);
+      MappedType newCode;
+      if (it != forward.end())
+      {
+        newCode = it->second;
+      }
+      else
+      {
+        // The first mapping of a dimension makes it categorical, as in
+        // MapString().
+        if (forward.size() == 0)
+          types[dimension] = Datatype::categorical;
+
+        newCode = (MappedType) forward.size();
+      }
+
+      for (size_t i = 0; i < inputs.size(); ++i)
+      {
+        if (forward.count(inputs[i]) == 0)
+        {
+          forward[inputs[i]] = newCode;
+          reverse[newCode].push_back(inputs[i]);
+        }
+      }
+
+      if (newCode != (MappedType) code)
+        translations[dimension][(MappedType) code] = newCode;
+    }
+  }
+}
+
 // Get the type of a particular dimension.
 template<typename PolicyType, typename InputType>
 inline Datatype DatasetMapper<PolicyType, InputType>::Type(
@@ -0,0 +1,116 @@
+/**
+ * @file core/data/elementwise_transform.hpp
+ * @author Ryan Curtin
+ *
+ * Fused elementwise transformation utilities.  Full-matrix passes like
+ * binarization and feature scaling are pure memory-bandwidth operations; the
+ * helpers here apply an arbitrary transformation in one pass over the
+ * contiguous memory of the matrix, parallelized with OpenMP, instead of
+ * chaining several whole-matrix sweeps.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_ELEMENTWISE_TRANSFORM_HPP
+#define MLPACK_CORE_DATA_ELEMENTWISE_TRANSFORM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Apply the given transformation to every element of the input matrix,
+ * writing the result to the output matrix.  The transformation receives the
+ * element value and returns the transformed value; branchless bodies (e.g. a
+ * compare used as a value) auto-vectorize.  The pass runs over contiguous
+ * blocks of the matrix memory, parallelized with OpenMP.  The output may be
+ * the same matrix as the input.
+ *
+ * @param input Matrix to transform.
+ * @param output Matrix to store the transformed values into.
+ * @param transform Transformation to apply to each element.
+ */
+template<typename MatType, typename TransformType>
+void ElementwiseTransform(const MatType& input,
+                          MatType& output,
+                          TransformType transform)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  output.copy_size(input);
+
+  const ElemType* inMemory = input.memptr();
+  ElemType* outMemory = output.memptr();
+
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) input.n_elem; ++i)
+    outMemory[i] = transform(inMemory[i]);
+}
+
+/**
+ * Apply the given transformation to every element of the given matrix, in
+ * place.  See the two-matrix overload for details.
+ *
+ * @param matrix Matrix to transform.
+ * @param transform Transformation to apply to each element.
+ */
+template<typename MatType, typename TransformType>
+void ElementwiseTransform(MatType& matrix, TransformType transform)
+{
+  ElementwiseTransform(matrix, matrix, transform);
+}
+
+/**
+ * Apply the given dimension-aware transformation to every element of the
+ * input matrix, writing the result to the output matrix.  The transformation
+ * receives the element value and the dimension (row) of the element, so
+ * per-dimension scale-and-shift passes -- the pattern shared by the scaler
+ * methods -- fuse into a single sweep instead of one sweep per coefficient.
+ * The pass is parallelized with OpenMP over columns; the output may be the
+ * same matrix as the input.
+ *
+ * @param input Matrix to transform.
+ * @param output Matrix to store the transformed values into.
+ * @param transform Transformation to apply; called as
+ *      transform(value, dimension).
+ */
+template<typename MatType, typename TransformType>
+void DimensionwiseTransform(const MatType& input,
+                            MatType& output,
+                            TransformType transform)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  output.copy_size(input);
+
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) input.n_cols; ++j)
+  {
+    const ElemType* inColumn = input.colptr(j);
+    ElemType* outColumn = output.colptr(j);
+    for (size_t i = 0; i < input.n_rows; ++i)
+      outColumn[i] = transform(inColumn[i], i);
+  }
+}
+
+/**
+ * Apply the given dimension-aware transformation to every element of the
+ * given matrix, in place.  See the two-matrix overload for details.
+ *
+ * @param matrix Matrix to transform.
+ * @param transform Transformation to apply; called as
+ *      transform(value, dimension).
+ */
+template<typename MatType, typename TransformType>
+void DimensionwiseTransform(MatType& matrix, TransformType transform)
+{
+  DimensionwiseTransform(matrix, matrix, transform);
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
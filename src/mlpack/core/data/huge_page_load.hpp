@@ -0,0 +1,135 @@
+/**
+ * @file core/data/huge_page_load.hpp
+ * @author Ryan Curtin
+ *
+ * Loading of datasets into huge-page-backed memory.  A HugePageMatrix owns a
+ * HugePageBuffer and exposes the buffer as a dense Armadillo matrix, and
+ * HugePageLoad() fills one from any file format that data::Load() accepts,
+ * so memory-bound methods can iterate over the dataset with far fewer TLB
+ * misses.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_HUGE_PAGE_LOAD_HPP
+#define MLPACK_CORE_DATA_HUGE_PAGE_LOAD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/huge_pages.hpp>
+
+#include "load.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A dense matrix whose memory lives in a HugePageBuffer.  Size the matrix
+ * with Set() and access it through Matrix(), which returns a strict
+ * non-owning alias; the alias must not outlive this object.  Like the
+ * MmapMatrix handle, this exists because an arma::mat cannot be re-pointed
+ * at foreign memory after construction.
+ *
+ * @tparam eT Element type of the matrix.
+ */
+template<typename eT>
+class HugePageMatrix
+{
+ public:
+  //! Construct an empty matrix.
+  HugePageMatrix() : rows(0), cols(0) { }
+
+  //! Construct a matrix of the given shape.
+  HugePageMatrix(const size_t rows, const size_t cols) : rows(0), cols(0)
+  {
+    Set(rows, cols);
+  }
+
+  /**
+   * Allocate backing memory for a matrix of the given shape, releasing any
+   * current backing memory.  The contents are unspecified.
+   *
+   * @param newRows Number of rows.
+   * @param newCols Number of columns.
+   * @return true if the allocation succeeded.
+   */
+  bool Set(const size_t newRows, const size_t newCols)
+  {
+    if (!buffer.Allocate(newRows * newCols * sizeof(eT)))
+    {
+      rows = cols = 0;
+      return false;
+    }
+
+    rows = newRows;
+    cols = newCols;
+    return true;
+  }
+
+  /**
+   * Return a non-owning alias matrix over the buffer.  The alias is strict
+   * (it cannot be resized or pointed at other memory) and is only valid
+   * while this object holds the buffer.
+   */
+  arma::Mat<eT> Matrix() const
+  {
+    return arma::Mat<eT>((eT*) buffer.Memory(), rows, cols, false, true);
+  }
+
+  //! Get the number of rows.
+  size_t Rows() const { return rows; }
+  //! Get the number of columns.
+  size_t Cols() const { return cols; }
+  //! Return true if the backing memory is on explicit huge pages.
+  bool OnHugePages() const { return buffer.OnHugePages(); }
+
+ private:
+  //! The backing memory.
+  HugePageBuffer buffer;
+  //! Shape of the matrix.
+  size_t rows, cols;
+};
+
+/**
+ * Load the given file into a huge-page-backed matrix.  The file is parsed
+ * with data::Load() (so any format that data::Load() accepts works, with the
+ * usual transposition behavior), and the parsed matrix is then copied into
+ * freshly allocated huge-page-backed memory.
+ *
+ * @param filename Name of the file to load.
+ * @param matrix Handle that will own the dataset.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of the load.
+ */
+template<typename eT>
+bool HugePageLoad(const std::string& filename,
+                  HugePageMatrix<eT>& matrix,
+                  const bool fatal = false)
+{
+  arma::Mat<eT> parsed;
+  if (!Load(filename, parsed, fatal))
+    return false;
+
+  if (!matrix.Set(parsed.n_rows, parsed.n_cols))
+  {
+    if (fatal)
+      Log::Fatal << "HugePageLoad(): unable to allocate backing memory for '"
+          << filename << "'." << std::endl;
+    else
+      Log::Warn << "HugePageLoad(): unable to allocate backing memory for '"
+          << filename << "'." << std::endl;
+
+    return false;
+  }
+
+  arma::Mat<eT> alias = matrix.Matrix();
+  alias = parsed;
+
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
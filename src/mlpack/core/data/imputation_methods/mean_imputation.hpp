@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_IMPUTE_STRATEGIES_MEAN_IMPUTATION_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/parallel.hpp>
 
 namespace mlpack {
 namespace data {
@@ -96,6 +97,85 @@ class MeanImputation
       input(target.first, target.second) = mean;
     }
   }
+
+  /**
+   * Batch variant of Impute() for several dimensions at once.  Instead of
+   * rescanning the matrix for every dimension, a single parallel pass over
+   * the points accumulates the sums and counts of all requested dimensions,
+   * and a second fused pass writes the means into the missing entries.
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues Value to get rid of, per requested dimension.
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the input matrix is columnMajor or not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    const size_t numDims = dimensions.size();
+    const size_t numPoints = columnMajor ? input.n_cols : input.n_rows;
+
+    // Per-thread accumulators avoid synchronization in the counting pass.
+    const size_t numThreads = Parallel::NumThreads();
+    std::vector<double> sums(numThreads * numDims, 0.0);
+    std::vector<size_t> counts(numThreads * numDims, 0);
+
+    // The first pass accumulates the sum and count of every requested
+    // dimension, touching each point only once.
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) numPoints; ++i)
+    {
+      #ifdef HAS_OPENMP
+      const size_t thread = (size_t) omp_get_thread_num();
+      #else
+      const size_t thread = 0;
+      #endif
+      for (size_t j = 0; j < numDims; ++j)
+      {
+        const T value = columnMajor ? input(dimensions[j], i)
+                                    : input(i, dimensions[j]);
+        if (!(value == mappedValues[j] || std::isnan(value)))
+        {
+          sums[thread * numDims + j] += value;
+          counts[thread * numDims + j]++;
+        }
+      }
+    }
+
+    std::vector<double> means(numDims);
+    for (size_t j = 0; j < numDims; ++j)
+    {
+      double sum = 0;
+      size_t elems = 0;
+      for (size_t thread = 0; thread < numThreads; ++thread)
+      {
+        sum += sums[thread * numDims + j];
+        elems += counts[thread * numDims + j];
+      }
+
+      if (elems == 0)
+        Log::Fatal << "it is impossible to calculate mean; no valid elements "
+            << "in the dimension" << std::endl;
+
+      means[j] = sum / elems;
+    }
+
+    // The second pass writes the means into the missing entries; each point
+    // touches only its own elements, so the pass runs in parallel too.
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) numPoints; ++i)
+    {
+      for (size_t j = 0; j < numDims; ++j)
+      {
+        T& value = columnMajor ? input(dimensions[j], i)
+                               : input(i, dimensions[j]);
+        if (value == mappedValues[j] || std::isnan(value))
+          value = means[j];
+      }
+    }
+  }
 }; // class MeanImputation
 
 } // namespace data
@@ -85,6 +85,60 @@ class MedianImputation
        input(target.first, target.second) = median;
     }
   }
+
+  /**
+   * Batch variant of Impute() for several dimensions at once.  A single pass
+   * over the points gathers the valid values of all requested dimensions,
+   * the medians are then computed in parallel, and a second fused pass
+   * writes them into the missing entries.
+   *
+   * @param input Matrix that contains the mapped values.
+   * @param mappedValues Value to get rid of, per requested dimension.
+   * @param dimensions Indices of the dimensions to impute.
+   * @param columnMajor State of whether the input matrix is columnMajor or not.
+   */
+  void Impute(arma::Mat<T>& input,
+              const std::vector<T>& mappedValues,
+              const std::vector<size_t>& dimensions,
+              const bool columnMajor = true)
+  {
+    const size_t numDims = dimensions.size();
+    const size_t numPoints = columnMajor ? input.n_cols : input.n_rows;
+
+    // One pass over the points gathers the valid values of every requested
+    // dimension.
+    std::vector<std::vector<double>> elemsToKeep(numDims);
+    for (size_t i = 0; i < numPoints; ++i)
+    {
+      for (size_t j = 0; j < numDims; ++j)
+      {
+        const T value = columnMajor ? input(dimensions[j], i)
+                                    : input(i, dimensions[j]);
+        if (!(value == mappedValues[j] || std::isnan(value)))
+          elemsToKeep[j].push_back(value);
+      }
+    }
+
+    // Computing the medians sorts each dimension's values, so this is the
+    // expensive part; the dimensions are independent.
+    std::vector<double> medians(numDims);
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t j = 0; j < (omp_size_t) numDims; ++j)
+      medians[j] = arma::median(arma::vec(elemsToKeep[j]));
+
+    // The second pass writes the medians into the missing entries.
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) numPoints; ++i)
+    {
+      for (size_t j = 0; j < numDims; ++j)
+      {
+        T& value = columnMajor ? input(dimensions[j], i)
+                               : input(i, dimensions[j]);
+        if (value == mappedValues[j] || std::isnan(value))
+          value = medians[j];
+      }
+    }
+  }
 }; // class MedianImputation
 
 } // namespace data
@@ -65,6 +65,33 @@ class Imputer
     strategy.Impute(input, mappedValue, dimension, columnMajor);
   }
 
+  /**
+  * Given an input dataset, replace missing values of several dimensions with
+  * the given imputation strategy, overwriting the input matrix.  Strategies
+  * that provide a batch Impute() overload (e.g. MeanImputation and
+  * MedianImputation) compute the statistics of all requested dimensions in
+  * one pass over the data and apply them in a second fused pass, instead of
+  * rescanning the matrix once per dimension; other strategies are applied
+  * dimension by dimension.
+  *
+  * @param input Input dataset to apply imputation.
+  * @param missingValue User defined missing value; it can be anything.
+  * @param dimensions Dimensions to apply the imputation.
+  */
+  void Impute(arma::Mat<T>& input,
+              const std::string& missingValue,
+              const std::vector<size_t>& dimensions)
+  {
+    std::vector<T> mappedValues(dimensions.size());
+    for (size_t i = 0; i < dimensions.size(); ++i)
+    {
+      mappedValues[i] = static_cast<T>(
+          mapper.UnmapValue(missingValue, dimensions[i]));
+    }
+
+    ImputeBatch(input, mappedValues, dimensions, 0);
+  }
+
   //! Get the strategy.
   const StrategyType& Strategy() const { return strategy; }
 
@@ -78,6 +105,35 @@ class Imputer
   MapperType& Mapper() { return mapper; }
 
  private:
+  /**
+   * Apply the strategy to all requested dimensions at once.  This overload
+   * is selected when the strategy provides a batch Impute() method.
+   */
+  template<typename S = StrategyType>
+  auto ImputeBatch(arma::Mat<T>& input,
+                   const std::vector<T>& mappedValues,
+                   const std::vector<size_t>& dimensions,
+                   int)
+      -> decltype(std::declval<S&>().Impute(input, mappedValues, dimensions,
+                      true), void())
+  {
+    strategy.Impute(input, mappedValues, dimensions, columnMajor);
+  }
+
+  /**
+   * Fallback for strategies without a batch Impute() method: apply the
+   * strategy dimension by dimension.
+   */
+  template<typename S = StrategyType>
+  void ImputeBatch(arma::Mat<T>& input,
+                   const std::vector<T>& mappedValues,
+                   const std::vector<size_t>& dimensions,
+                   long)
+  {
+    for (size_t i = 0; i < dimensions.size(); ++i)
+      strategy.Impute(input, mappedValues[i], dimensions[i], columnMajor);
+  }
+
   // StrategyType
   StrategyType strategy;
 
@@ -0,0 +1,153 @@
+/**
+ * @file core/data/inspect.hpp
+ * @author Ryan Curtin
+ *
+ * Report the dimensions of a dataset file without loading its values.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_INSPECT_HPP
+#define MLPACK_CORE_DATA_INSPECT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "detect_file_type.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Determine the size of the dataset stored in the given file without
+ * converting any values: text formats (CSV, TSV, space-separated ASCII) are
+ * scanned for their line and field structure only, and the Armadillo ASCII
+ * and binary formats are answered from their headers.  This is much cheaper
+ * than data::Load() when only the dimensions are needed, e.g. to size
+ * downstream allocations or decide whether to subsample.
+ *
+ * The reported size matches the matrix that Load() would produce with its
+ * default transpose behavior: 'rows' is the dimensionality of the dataset
+ * (the number of fields per line) and 'cols' is the number of points (the
+ * number of nonempty lines).
+ *
+ * If the parameter 'fatal' is set to true, a std::runtime_error exception
+ * will be thrown if the file cannot be inspected.
+ *
+ * @param filename Name of file to inspect.
+ * @param rows Variable to store the dimensionality of the dataset in.
+ * @param cols Variable to store the number of points in.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of inspection.
+ */
+inline bool Inspect(const std::string& filename,
+                    size_t& rows,
+                    size_t& cols,
+                    const bool fatal = false)
+{
+  // Catch nonexistent files by opening the stream ourselves.
+  std::fstream stream;
+#ifdef  _WIN32 // Always open in binary mode on Windows.
+  stream.open(filename.c_str(), std::fstream::in | std::fstream::binary);
+#else
+  stream.open(filename.c_str(), std::fstream::in);
+#endif
+  if (!stream.is_open())
+  {
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "'; inspection failed."
+          << std::endl;
+
+    return false;
+  }
+
+  const arma::file_type type = AutoDetect(stream, filename);
+
+  if (type == arma::arma_ascii || type == arma::arma_binary)
+  {
+    // Both formats start with a text header: the format tag on the first
+    // line, then the stored number of rows and columns on the second.  Since
+    // Load() transposes after loading, the stored rows are the points and
+    // the stored columns are the dimensions.
+    std::string tag;
+    size_t storedRows, storedCols;
+    if (!(stream >> tag >> storedRows >> storedCols))
+    {
+      if (fatal)
+        Log::Fatal << "Cannot parse header of '" << filename << "'."
+            << std::endl;
+      else
+        Log::Warn << "Cannot parse header of '" << filename << "'; "
+            << "inspection failed." << std::endl;
+
+      return false;
+    }
+
+    rows = storedCols;
+    cols = storedRows;
+    return true;
+  }
+
+  if (type != arma::csv_ascii && type != arma::raw_ascii)
+  {
+    if (fatal)
+      Log::Fatal << "Cannot inspect '" << filename << "': only text formats "
+          << "and Armadillo formats with headers are supported." << std::endl;
+    else
+      Log::Warn << "Cannot inspect '" << filename << "': only text formats "
+          << "and Armadillo formats with headers are supported; inspection "
+          << "failed." << std::endl;
+
+    return false;
+  }
+
+  // Count the fields of the first nonempty line, then count the remaining
+  // nonempty lines without looking at their fields.
+  rows = 0;
+  cols = 0;
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    size_t pos = line.find_first_not_of(" \t\r");
+    if (pos == std::string::npos)
+      continue;
+
+    if (cols == 0)
+    {
+      if (type == arma::csv_ascii)
+      {
+        rows = 1;
+        for (size_t i = 0; i < line.size(); ++i)
+          if (line[i] == ',')
+            ++rows;
+      }
+      else
+      {
+        while (pos != std::string::npos)
+        {
+          ++rows;
+          const size_t end = line.find_first_of(" \t\r", pos);
+          pos = (end == std::string::npos) ? std::string::npos :
+              line.find_first_not_of(" \t\r", end);
+        }
+      }
+    }
+
+    ++cols;
+  }
+
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -104,6 +104,40 @@ bool Load(const std::string& filename,
           const bool fatal = false,
           const bool transpose = true);
 
+/**
+ * Loads only the given dimensions of a dataset from a text file (CSV, TSV, or
+ * space-separated ASCII), skipping value conversion for every other field.
+ * When only a few of many dimensions are needed, this avoids paying the full
+ * parse cost of the file: unrequested fields are scanned past but never
+ * converted, and the matrix holds only the requested dimensions.
+ *
+ * The dimensions are given as zero-based indices into the dimensions of the
+ * dataset (the fields of a line of the file), and may appear in any order;
+ * with the default transpose value of 'true', row i of the resulting matrix
+ * holds the dimension dimensions[i].  With 'transpose' set to false the
+ * result is in the file's orientation, one point per row, with the requested
+ * fields as its columns.
+ *
+ * Only text formats are supported, since binary formats cannot be scanned
+ * without reading every value; for those, load the full matrix and use
+ * submatrix views instead.  If the parameter 'fatal' is set to true, a
+ * std::runtime_error exception will be thrown on failure, including when a
+ * line has no field for a requested dimension.
+ *
+ * @param filename Name of file to load.
+ * @param matrix Matrix to load the requested dimensions into.
+ * @param dimensions Indices of the dimensions to load.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param transpose If true (default), points are columns of the result.
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool Load(const std::string& filename,
+          arma::Mat<eT>& matrix,
+          const std::vector<size_t>& dimensions,
+          const bool fatal = false,
+          const bool transpose = true);
+
 /**
  * Don't document these with doxygen; these declarations aren't helpful to
  * users.
@@ -398,6 +432,44 @@ bool Load(const std::vector<std::string>& files,
           ImageInfo& info,
           const bool fatal = false);
 
+/**
+ * Load a batch of images into the given matrix, one column per image,
+ * decoding the files in parallel.  Each decoded image is written directly
+ * into its column of the preallocated batch, so the per-image cost is one
+ * decode and one copy regardless of the batch size; with multiple threads
+ * available (OpenMP), decoding throughput scales with the number of cores.
+ * This is intended for training input pipelines that read far more images
+ * per epoch than a serial per-file Load() can supply.
+ *
+ * If targetWidth and targetHeight are nonzero, every image is resized to
+ * that size on the fly with nearest-neighbor sampling, so the files need not
+ * have matching dimensions.  With centerCrop set, the image is instead
+ * scaled so its shorter side matches the target and then cropped around the
+ * center, preserving the aspect ratio.  Without a target size, all files
+ * must match the dimensions of the first image.
+ *
+ * The number of channels is taken from the given ImageInfo (1 for
+ * grayscale, otherwise 3), and the info is updated with the dimensions of
+ * the batch.
+ *
+ * @param files Names of the image files to load.
+ * @param matrix Matrix to load the images into, one column per image.
+ * @param info An object of ImageInfo class.
+ * @param targetWidth If nonzero, resize every image to this width.
+ * @param targetHeight If nonzero, resize every image to this height.
+ * @param centerCrop If true, scale the shorter side and crop to the target.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool LoadImages(const std::vector<std::string>& files,
+                arma::Mat<eT>& matrix,
+                ImageInfo& info,
+                const size_t targetWidth = 0,
+                const size_t targetHeight = 0,
+                const bool centerCrop = false,
+                const bool fatal = false);
+
 // Implementation found in load_image.cpp.
 bool LoadImage(const std::string& filename,
                arma::Mat<unsigned char>& matrix,
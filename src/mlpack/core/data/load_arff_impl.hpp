@@ -16,11 +16,199 @@
 #include "load_arff.hpp"
 
 #include <boost/algorithm/string/trim.hpp>
+#include <mlpack/core/util/parallel.hpp>
 #include "is_naninf.hpp"
 
 namespace mlpack {
 namespace data {
 
+/**
+ * Parse one line of the @data section of an ARFF file into the given column
+ * of the (transposed) output matrix.  Lines that contain no quoting or
+ * escaping take a fast path that splits on commas in place and converts
+ * numeric cells directly from the line buffer; other lines fall back to the
+ * escape-aware tokenizer.
+ *
+ * @param line Line to parse (trimmed in place).
+ * @param row Index of the data row (column of the output matrix).
+ * @param headerLines Number of header lines before the @data section (used
+ *     for error reporting).
+ * @param matrix Preallocated matrix to parse into.
+ * @param info Mapper to use for categorical cells.
+ * @param categoryStrings Pre-specified category sets from the header, if any.
+ * @return true if any cell created or looked up a mapping in the mapper.
+ */
+template<typename eT, typename PolicyType>
+bool ParseARFFDataLine(std::string& line,
+                       const size_t row,
+                       const size_t headerLines,
+                       arma::Mat<eT>& matrix,
+                       DatasetMapper<PolicyType>& info,
+                       const std::map<size_t, std::vector<std::string>>&
+                           categoryStrings)
+{
+  boost::trim(line);
+
+  // If the first character is {, it is sparse data, and we can just say this
+  // is not handled for now...
+  if (line[0] == '{')
+    throw std::runtime_error("cannot yet parse sparse ARFF data");
+
+  bool anyMapped = false;
+
+  // Check that we are not too many columns in.
+  auto checkColumns = [&](const size_t col)
+  {
+    if (col >= matrix.n_rows)
+    {
+      std::stringstream error;
+      error << "Too many columns in line " << (headerLines + row) << ".";
+      throw std::runtime_error(error.str());
+    }
+  };
+
+  // Map a categorical token.  If the set of categories was pre-specified,
+  // then we must crash if this was not one of those categories.
+  auto mapCategorical = [&](const std::string& token, const size_t col) -> eT
+  {
+    const size_t currentNumMappings = info.NumMappings(col);
+    const eT result = info.template MapString<eT>(token, col);
+    anyMapped = true;
+
+    if (categoryStrings.count(col) > 0 &&
+        currentNumMappings < info.NumMappings(col))
+    {
+      std::stringstream error;
+      error << "Parse error at line " << (headerLines + row) << " token "
+          << col << ": category \"" << token << "\" not in the set of known"
+          << " categories for this dimension (";
+      for (size_t i = 0; i < categoryStrings.at(col).size() - 1; ++i)
+        error << "\"" << categoryStrings.at(col)[i] << "\", ";
+      error << "\"" << categoryStrings.at(col).back() << "\").";
+      throw std::runtime_error(error.str());
+    }
+
+    return result;
+  };
+
+  // Report a numeric cell that could not be parsed.  The '?' representing a
+  // missing value is not allowed, so if that occurs we issue a specific
+  // error.
+  auto numericError = [&](std::string token, const size_t col)
+  {
+    std::stringstream error;
+    boost::trim(token);
+    if (token == "?")
+      error << "Missing values ('?') not supported, ";
+    else
+      error << "Parse error ";
+    error << "at line " << (headerLines + row) << " token " << col
+        << ": \"" << token << "\".";
+    throw std::runtime_error(error.str());
+  };
+
+  if (!line.empty() && line.find_first_of("\"\\") == std::string::npos)
+  {
+    // Fast path: the line contains no quoting or escaping, so the cells are
+    // exactly the substrings between commas, and numeric cells can be
+    // converted in place without building a token string.
+    size_t col = 0;
+    size_t begin = 0;
+    while (true)
+    {
+      size_t end = line.find(',', begin);
+      if (end == std::string::npos)
+        end = line.size();
+
+      checkColumns(col);
+
+      // Strip spaces from either side of the cell.
+      size_t tokBegin = begin, tokEnd = end;
+      while (tokBegin < tokEnd && std::isspace((unsigned char) line[tokBegin]))
+        ++tokBegin;
+      while (tokEnd > tokBegin && std::isspace((unsigned char) line[tokEnd - 1]))
+        --tokEnd;
+
+      if (info.Type(col) == Datatype::categorical)
+      {
+        // We load transposed.
+        matrix(col, row) = mapCategorical(
+            line.substr(tokBegin, tokEnd - tokBegin), col);
+      }
+      else if (info.Type(col) == Datatype::numeric)
+      {
+        // Attempt to convert directly from the line buffer; strtod() stops
+        // at the comma (or any other non-numeric character), like the
+        // stream extraction of the fallback path.
+        const char* tokStart = line.c_str() + tokBegin;
+        char* tokStop = NULL;
+        eT val = (eT) std::strtod(tokStart, &tokStop);
+        if (tokStop == tokStart)
+        {
+          // No conversion was performed; check for NaN or inf before issuing
+          // an error.
+          val = eT(0);
+          if (!IsNaNInf(val, line.substr(tokBegin, tokEnd - tokBegin)))
+            numericError(line.substr(tokBegin, tokEnd - tokBegin), col);
+        }
+
+        matrix(col, row) = val; // We load transposed.
+      }
+
+      ++col;
+      if (end == line.size())
+        break;
+      begin = end + 1;
+    }
+  }
+  else
+  {
+    // The line contains quoting or escaping, so tokenize it with the
+    // escape-aware tokenizer.  Each line of the @data section must be a CSV.
+    typedef boost::tokenizer<boost::escaped_list_separator<char>> Tokenizer;
+    boost::escaped_list_separator<char> sep("\\", ",", "\"");
+    Tokenizer tok(line, sep);
+
+    size_t col = 0;
+    std::stringstream token;
+    for (Tokenizer::iterator it = tok.begin(); it != tok.end(); ++it)
+    {
+      checkColumns(col);
+
+      // What should this token be?
+      if (info.Type(col) == Datatype::categorical)
+      {
+        // Strip spaces before mapping.
+        std::string str = *it;
+        boost::trim(str);
+        matrix(col, row) = mapCategorical(str, col); // We load transposed.
+      }
+      else if (info.Type(col) == Datatype::numeric)
+      {
+        // Attempt to read as numeric.
+        token.clear();
+        token.str(*it);
+
+        eT val = eT(0);
+        token >> val;
+
+        if (token.fail())
+        {
+          // Check for NaN or inf.
+          if (!IsNaNInf(val, token.str()))
+            numericError(token.str(), col);
+        }
+
+        matrix(col, row) = val; // We load transposed.
+      }
+
+      ++col;
+    }
+  }
+
+  return anyMapped;
+}
+
 template<typename eT, typename PolicyType>
 void LoadARFF(const std::string& filename,
               arma::Mat<eT>& matrix,
@@ -176,121 +364,104 @@ void LoadARFF(const std::string& filename,
     }
   }
 
-  // We need to find out how many lines of data are in the file.
-  std::streampos pos = ifs.tellg();
-  size_t row = 0;
+  // Pull the rest of the file---the @data section---into memory in a single
+  // buffered pass.  This tells us how many lines of data are in the file, and
+  // lets the lines be parsed by an OpenMP team.
+  std::vector<std::string> lines;
   while (ifs.good())
   {
     std::getline(ifs, line, '\n');
-    ++row;
+    lines.push_back(std::move(line));
   }
-  // Uncount the EOF row.
-  --row;
-
-  // Since we've hit the EOF, we have to call clear() so we can seek again.
-  ifs.clear();
-  ifs.seekg(pos);
+  // Drop the EOF row.
+  if (!lines.empty())
+    lines.pop_back();
 
   // Now, set the size of the matrix.
-  matrix.set_size(dimensionality, row);
-
-  // Now we are looking at the @data section.
-  row = 0;
-  while (ifs.good())
+  matrix.set_size(dimensionality, lines.size());
+
+  // Now we are looking at the @data section.  Each line is one column of the
+  // matrix, so the threads write to disjoint parts of it.  Numeric cells do
+  // not touch the mapper, and categorical cells go through a thread-local
+  // mapper, so no synchronization is needed during the parse; the local
+  // mappers are merged afterwards, as in the parallel CSV path.  (Note that
+  // any categories that were specified in the header are already mapped, so
+  // only string attributes can create mappings here.)
+  const size_t numThreads = Parallel::NumThreads();
+  std::vector<DatasetMapper<PolicyType>> localMappers(numThreads, info);
+  std::vector<std::vector<size_t>> localLines(numThreads);
+
+  // Collect the first parsing error (exceptions cannot cross the parallel
+  // region boundary).
+  bool failed = false;
+  std::string errorMessage;
+
+  #pragma omp parallel
   {
-    std::getline(ifs, line, '\n');
-    boost::trim(line);
-    // Each line of the @data section must be a CSV (except sparse data, which
-    // we will handle later).  So now we can tokenize the
-    // CSV and parse it.  The '?' representing a missing value is not allowed,
-    // so if that occurs we throw an exception.  We also throw an exception if
-    // any piece of data does not match its type (categorical or numeric).
-
-    // If the first character is {, it is sparse data, and we can just say this
-    // is not handled for now...
-    if (line[0] == '{')
-      throw std::runtime_error("cannot yet parse sparse ARFF data");
-
-    // Tokenize the line.
-    typedef boost::tokenizer<boost::escaped_list_separator<char>> Tokenizer;
-    boost::escaped_list_separator<char> sep("\\", ",", "\"");
-    Tokenizer tok(line, sep);
-
-    size_t col = 0;
-    std::stringstream token;
-    for (Tokenizer::iterator it = tok.begin(); it != tok.end(); ++it)
+    #ifdef HAS_OPENMP
+    const size_t thread = (size_t) omp_get_thread_num();
+    #else
+    const size_t thread = 0;
+    #endif
+
+    #pragma omp for schedule(dynamic, 1024)
+    for (omp_size_t l = 0; l < (omp_size_t) lines.size(); ++l)
     {
-      // Check that we are not too many columns in.
-      if (col >= matrix.n_rows)
-      {
-        std::stringstream error;
-        error << "Too many columns in line " << (headerLines + row) << ".";
-        throw std::runtime_error(error.str());
-      }
+      if (failed)
+        continue;
 
-      // What should this token be?
-      if (info.Type(col) == Datatype::categorical)
+      try
       {
-        // Strip spaces before mapping.
-        std::string token = *it;
-        boost::trim(token);
-        const size_t currentNumMappings = info.NumMappings(col);
-        const eT result = info.template MapString<eT>(token, col);
-
-        // If the set of categories was pre-specified, then we must crash if
-        // this was not one of those categories.
-        if (categoryStrings.count(col) > 0 &&
-            currentNumMappings < info.NumMappings(col))
-        {
-          std::stringstream error;
-          error << "Parse error at line " << (headerLines + row) << " token "
-              << col << ": category \"" << token << "\" not in the set of known"
-              << " categories for this dimension (";
-          for (size_t i = 0; i < categoryStrings.at(col).size() - 1; ++i)
-            error << "\"" << categoryStrings.at(col)[i] << "\", ";
-          error << "\"" << categoryStrings.at(col).back() << "\").";
-          throw std::runtime_error(error.str());
-        }
-
-        // We load transposed.
-        matrix(col, row) = result;
+        if (ParseARFFDataLine(lines[l], (size_t) l, headerLines, matrix,
+            localMappers[thread], categoryStrings))
+          localLines[thread].push_back((size_t) l);
       }
-      else if (info.Type(col) == Datatype::numeric)
+      catch (std::exception& e)
       {
-        // Attempt to read as numeric.
-        token.clear();
-        token.str(*it);
-
-        eT val = eT(0);
-        token >> val;
-
-        if (token.fail())
+        #pragma omp critical (LoadARFFError)
         {
-          // Check for NaN or inf.
-          if (!IsNaNInf(val, token.str()))
+          if (!failed)
           {
-            // Okay, it's not NaN or inf.  If it's '?', we issue a specific
-            // error, otherwise we issue a general error.
-            std::stringstream error;
-            std::string tokenStr = token.str();
-            boost::trim(tokenStr);
-            if (tokenStr == "?")
-              error << "Missing values ('?') not supported, ";
-            else
-              error << "Parse error ";
-            error << "at line " << (headerLines + row) << " token " << col
-                << ": \"" << tokenStr << "\".";
-            throw std::runtime_error(error.str());
+            errorMessage = e.what();
+            failed = true;
           }
         }
-
-        // If we made it to here, we have a value.
-        matrix(col, row) = val; // We load transposed.
       }
+    }
+  }
 
-      ++col;
+  if (failed)
+    throw std::runtime_error(errorMessage);
+
+  // Merge the thread-local mappings into the output mapper in thread order
+  // (so the result does not depend on scheduling), then rewrite the cells
+  // each thread produced from its local mappings to the merged ones.
+  typedef typename PolicyType::MappedType MappedType;
+  std::vector<std::unordered_map<size_t,
+      std::unordered_map<MappedType, MappedType>>> translations(numThreads);
+  for (size_t t = 0; t < numThreads; ++t)
+    info.Merge(localMappers[t], translations[t]);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+  {
+    if (translations[t].empty())
+      continue;
+
+    for (size_t i = 0; i < localLines[t].size(); ++i)
+    {
+      const size_t l = localLines[t][i];
+      for (typename std::unordered_map<size_t,
+          std::unordered_map<MappedType, MappedType>>::const_iterator dimIt =
+          translations[t].begin(); dimIt != translations[t].end(); ++dimIt)
+      {
+        eT& cell = matrix(dimIt->first, l);
+        typename std::unordered_map<MappedType, MappedType>::const_iterator
+            valIt = dimIt->second.find((MappedType) cell);
+        if (valIt != dimIt->second.end())
+          cell = (eT) valIt->second;
+      }
     }
-    ++row;
   }
 }
 
@@ -58,6 +58,19 @@ class LoadCSV
   {
     CheckOpen();
 
+    #ifdef _OPENMP
+    // If the mapping policy completes all of its mappings during the first
+    // pass, the second (element-parsing) pass has no ordering constraints and
+    // the lines of the file can be parsed by an OpenMP team.  Policies that
+    // create mappings during the second pass (e.g. MissingPolicy) keep the
+    // sequential path so that mapping order is unchanged.
+    if (PolicyType::NeedsFirstPass && omp_get_max_threads() > 1)
+    {
+      LoadParallel(inout, infoSet, transpose);
+      return;
+    }
+    #endif
+
     if (transpose)
       TransposeParse(inout, infoSet);
     else
@@ -357,6 +370,277 @@ class LoadCSV
     }
   }
 
+  /**
+   * Split a single line of the file into tokens, mimicking the boost::spirit
+   * rules used by the sequential parser: quoted strings (with either quote
+   * character) are kept whole, and the delimiter depends on the extension of
+   * the file (',' for .csv, runs of spaces for .txt, and '\t' for .tsv).
+   * Tokens are trimmed of surrounding whitespace, and the quotes are retained
+   * as part of the token (just as the spirit raw[] rule retains them).
+   *
+   * @param line Line to split (already trimmed).
+   * @param tokens Vector to be filled with the extracted tokens.
+   */
+  void Tokenize(const std::string& line,
+                std::vector<std::string>& tokens) const
+  {
+    tokens.clear();
+
+    const char delim = (extension == "tsv") ? '\t' :
+        (extension == "txt") ? ' ' : ',';
+
+    size_t i = 0;
+    const size_t len = line.size();
+    while (i <= len)
+    {
+      // For space-delimited files, skip any extra delimiters between tokens.
+      if (extension == "txt")
+      {
+        while (i < len && line[i] == delim)
+          ++i;
+        if (i == len && !tokens.empty())
+          break;
+      }
+
+      std::string token;
+      if (i < len && (line[i] == '"' || line[i] == '\''))
+      {
+        // Quoted token: scan to the matching close quote, treating a doubled
+        // quote character as an escaped quote.
+        const char quote = line[i];
+        size_t j = i + 1;
+        while (j < len)
+        {
+          if (line[j] == quote)
+          {
+            if (j + 1 < len && line[j + 1] == quote)
+              j += 2; // Escaped quote; keep scanning.
+            else
+              break; // Closing quote.
+          }
+          else
+          {
+            ++j;
+          }
+        }
+        token = line.substr(i, std::min(j + 1, len) - i);
+        i = std::min(j + 1, len);
+        // Skip to the next delimiter.
+        while (i < len && line[i] != delim)
+          ++i;
+      }
+      else
+      {
+        // Unquoted token: scan to the next delimiter.
+        size_t j = i;
+        while (j < len && line[j] != delim)
+          ++j;
+        token = line.substr(i, j - i);
+        i = j;
+      }
+
+      boost::trim(token);
+      tokens.push_back(std::move(token));
+
+      if (i >= len)
+        break;
+      ++i; // Skip the delimiter.
+    }
+  }
+
+  /**
+   * Parse the elements of the file on an OpenMP team.  This assumes that any
+   * mappings needed by the DatasetMapper policy have been fully created by the
+   * first pass (i.e. PolicyType::NeedsFirstPass is true), so that the order in
+   * which lines are parsed does not matter.  Each line of the file corresponds
+   * to one column (transposed load) or one row (non-transposed load) of the
+   * output matrix, so threads write to disjoint parts of the matrix.  Any
+   * string that still needs to be passed through MapString() in a way that
+   * could mutate the DatasetMapper is serialized with a critical section.
+   *
+   * @param inout Matrix to load into.
+   * @param infoSet DatasetMapper to load with.
+   * @param transpose Whether the matrix is transposed on load.
+   */
+  template<typename T, typename PolicyType>
+  void LoadParallel(arma::Mat<T>& inout,
+                    DatasetMapper<PolicyType>& infoSet,
+                    const bool transpose)
+  {
+    // The first pass computes the matrix size and fills the DatasetMapper.
+    size_t rows, cols;
+    if (transpose)
+      GetTransposeMatrixSize<T>(rows, cols, infoSet);
+    else
+      GetMatrixSize<T>(rows, cols, infoSet);
+
+    inout.set_size(rows, cols);
+
+    // Pull all lines into memory so that they can be distributed to threads.
+    // (For an 8GB file this costs one pass of I/O, which is what the
+    // sequential parser pays for its second pass anyway.)
+    std::vector<std::string> lines;
+    lines.reserve(transpose ? cols : rows);
+    inFile.clear();
+    inFile.seekg(0, std::ios::beg);
+    std::string line;
+    while (std::getline(inFile, line))
+    {
+      boost::trim(line);
+      lines.push_back(std::move(line));
+    }
+
+    // Collect the first parsing error (exceptions cannot cross the parallel
+    // region boundary).
+    bool failed = false;
+    std::string errorMessage;
+
+    const size_t dims = transpose ? rows : cols;
+
+    // If any dimension is categorical, each thread maps its lines through a
+    // local DatasetMapper, lock free; the local mappers are merged when the
+    // parse finishes and the affected cells are rewritten from the local
+    // mappings to the merged ones.  This keeps the mapping table lookups out
+    // of any critical section.  Note that the mapper's dimensions are line
+    // indices for a non-transposed load, so its dimensionality is not the
+    // same as the number of tokens per line (`dims`) there.
+    bool hasCategorical = false;
+    for (size_t d = 0; d < infoSet.Dimensionality(); ++d)
+    {
+      if (infoSet.Type(d) == Datatype::categorical)
+        hasCategorical = true;
+    }
+
+    const size_t numThreads = (size_t) omp_get_max_threads();
+    std::vector<DatasetMapper<PolicyType>> localMappers;
+    std::vector<std::vector<size_t>> localLines(numThreads);
+    if (hasCategorical)
+      localMappers.resize(numThreads, infoSet);
+
+    #pragma omp parallel
+    {
+      const size_t thread = (size_t) omp_get_thread_num();
+      std::vector<std::string> tokens;
+      const auto parseLine = [&](const omp_size_t l)
+      {
+        if (failed)
+          return;
+
+        Tokenize(lines[l], tokens);
+
+        if (tokens.size() != dims)
+        {
+          #pragma omp critical (LoadCSVError)
+          {
+            if (!failed)
+            {
+              std::ostringstream oss;
+              oss << "LoadCSV::LoadParallel(): wrong number of dimensions ("
+                  << tokens.size() << ") on line " << l << "; should be "
+                  << dims << " dimensions.";
+              errorMessage = oss.str();
+              failed = true;
+            }
+          }
+          return;
+        }
+
+        bool anyMapped = false;
+        for (size_t d = 0; d < dims; ++d)
+        {
+          // For a transposed load each line is one column, and the dimension
+          // is the position within the line; for a non-transposed load each
+          // line is one dimension.
+          const size_t dim = transpose ? d : (size_t) l;
+
+          T val;
+          if (infoSet.Type(dim) == Datatype::numeric)
+          {
+            // Numeric dimensions cannot create new mappings, so MapString()
+            // is safe to call concurrently.
+            val = infoSet.template MapString<T>(std::string(tokens[d]), dim);
+          }
+          else
+          {
+            // Map through the thread's local mapper; the local mapping is
+            // translated to the merged mapping after the parse.
+            val = localMappers[thread].template MapString<T>(
+                std::string(tokens[d]), dim);
+            anyMapped = true;
+          }
+
+          if (transpose)
+            inout(d, l) = val;
+          else
+            inout(l, d) = val;
+        }
+
+        if (anyMapped)
+          localLines[thread].push_back((size_t) l);
+      };
+
+      if (hasCategorical)
+      {
+        // Static scheduling fixes which lines land in which thread's local
+        // mapper, so the merged categorical codes do not depend on how the
+        // runtime balances the load.
+        #pragma omp for schedule(static)
+        for (omp_size_t l = 0; l < (omp_size_t) lines.size(); ++l)
+          parseLine(l);
+      }
+      else
+      {
+        #pragma omp for schedule(dynamic, 1024)
+        for (omp_size_t l = 0; l < (omp_size_t) lines.size(); ++l)
+          parseLine(l);
+      }
+    }
+
+    if (failed)
+      throw std::runtime_error(errorMessage);
+
+    if (hasCategorical)
+    {
+      // Merge the thread-local mappings into the output mapper in thread
+      // order (so the result does not depend on scheduling), then rewrite
+      // the cells each thread produced from its local mappings to the
+      // merged ones.
+      typedef typename PolicyType::MappedType MappedType;
+      std::vector<std::unordered_map<size_t,
+          std::unordered_map<MappedType, MappedType>>>
+          translations(numThreads);
+      for (size_t t = 0; t < numThreads; ++t)
+        infoSet.Merge(localMappers[t], translations[t]);
+
+      #pragma omp parallel for schedule(dynamic)
+      for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+      {
+        if (translations[t].empty())
+          continue;
+
+        for (size_t i = 0; i < localLines[t].size(); ++i)
+        {
+          const size_t l = localLines[t][i];
+          for (size_t d = 0; d < dims; ++d)
+          {
+            const size_t dim = transpose ? d : l;
+            typename std::unordered_map<size_t,
+                std::unordered_map<MappedType, MappedType>>::const_iterator
+                dimIt = translations[t].find(dim);
+            if (dimIt == translations[t].end())
+              continue;
+
+            T& cell = transpose ? inout(d, l) : inout(l, d);
+            typename std::unordered_map<MappedType, MappedType>::
+                const_iterator valIt = dimIt->second.find((MappedType) cell);
+            if (valIt != dimIt->second.end())
+              cell = (T) valIt->second;
+          }
+        }
+      }
+    }
+  }
+
   //! Spirit rule for parsing.
   boost::spirit::qi::rule<std::string::iterator, iter_type()> stringRule;
   //! Spirit rule for delimiters (i.e. ',' for CSVs).
@@ -1,5 +1,5 @@
 /**
- * @file core/data/load_image_impl.hpp
+ * @file core/data/load_image_impl.hpp
  * @author Mehul Kumar Nirala
  *
  * An image loading utility implementation.
@@ -90,6 +90,182 @@ bool Load(const std::vector<std::string>& files,
   return true;
 }
 
+namespace details {
+
+/**
+ * Resize the given interleaved image buffer to the target size with
+ * nearest-neighbor sampling.  With centerCrop set, the image is scaled so
+ * that its shorter side matches the target and the overhang is cropped
+ * around the center, preserving the aspect ratio.
+ */
+inline void ResizeImage(const unsigned char* src,
+                        const size_t srcWidth,
+                        const size_t srcHeight,
+                        const size_t channels,
+                        unsigned char* dst,
+                        const size_t dstWidth,
+                        const size_t dstHeight,
+                        const bool centerCrop)
+{
+  double scaleX = (double) srcWidth / dstWidth;
+  double scaleY = (double) srcHeight / dstHeight;
+  double offsetX = 0.0, offsetY = 0.0;
+  if (centerCrop)
+  {
+    const double scale = std::min(scaleX, scaleY);
+    offsetX = (srcWidth - dstWidth * scale) / 2.0;
+    offsetY = (srcHeight - dstHeight * scale) / 2.0;
+    scaleX = scaleY = scale;
+  }
+
+  for (size_t y = 0; y < dstHeight; ++y)
+  {
+    const size_t srcY = std::min(srcHeight - 1,
+        (size_t) (offsetY + (y + 0.5) * scaleY));
+    for (size_t x = 0; x < dstWidth; ++x)
+    {
+      const size_t srcX = std::min(srcWidth - 1,
+          (size_t) (offsetX + (x + 0.5) * scaleX));
+
+      const unsigned char* s = src + (srcY * srcWidth + srcX) * channels;
+      unsigned char* d = dst + (y * dstWidth + x) * channels;
+      for (size_t c = 0; c < channels; ++c)
+        d[c] = s[c];
+    }
+  }
+}
+
+} // namespace details
+
+// Batch image loading API with parallel decode.
+template<typename eT>
+bool LoadImages(const std::vector<std::string>& files,
+                arma::Mat<eT>& matrix,
+                ImageInfo& info,
+                const size_t targetWidth,
+                const size_t targetHeight,
+                const bool centerCrop,
+                const bool fatal)
+{
+  if (files.size() == 0)
+  {
+    std::ostringstream oss;
+    oss << "LoadImages(): vector of image files is empty." << std::endl;
+
+    if (fatal)
+      Log::Fatal << oss.str();
+    else
+      Log::Warn << oss.str();
+
+    return false;
+  }
+
+  if ((targetWidth == 0) != (targetHeight == 0))
+  {
+    if (fatal)
+      Log::Fatal << "LoadImages(): targetWidth and targetHeight must be given "
+          << "together." << std::endl;
+    else
+      Log::Warn << "LoadImages(): targetWidth and targetHeight must be given "
+          << "together; load failed." << std::endl;
+
+    return false;
+  }
+
+  Timer::Start("loading_image");
+
+  // The decoded buffers hold either grayscale or RGB data.
+  const size_t channels = (info.Channels() == 1) ? 1 : 3;
+  const bool resize = (targetWidth > 0);
+
+  arma::Mat<unsigned char> tmpMatrix;
+  size_t width = targetWidth, height = targetHeight;
+  size_t startIndex = 0;
+
+  if (resize)
+  {
+    tmpMatrix.set_size(targetWidth * targetHeight * channels, files.size());
+  }
+  else
+  {
+    // Without a target size, the first image fixes the batch dimensions.
+    arma::Mat<unsigned char> img;
+    ImageInfo firstInfo(0, 0, channels);
+    if (!LoadImage(files[0], img, firstInfo, fatal))
+    {
+      Timer::Stop("loading_image");
+      return false;
+    }
+
+    width = firstInfo.Width();
+    height = firstInfo.Height();
+    tmpMatrix.set_size(img.n_rows, files.size());
+    tmpMatrix.col(0) = img;
+    startIndex = 1;
+  }
+
+  // Decode the images in parallel; each thread uses its own ImageInfo and
+  // writes straight into its column of the batch.
+  bool success = true;
+  std::string failureMessage;
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = startIndex; i < (omp_size_t) files.size(); ++i)
+  {
+    if (!success)
+      continue; // Another image already failed; finish up quickly.
+
+    arma::Mat<unsigned char> img;
+    ImageInfo localInfo(0, 0, channels);
+    if (!LoadImage(files[i], img, localInfo, false))
+    {
+      #pragma omp critical (LoadImagesError)
+      {
+        success = false;
+        failureMessage = "failed to load '" + files[i] + "'";
+      }
+    }
+    else if (resize)
+    {
+      details::ResizeImage(img.memptr(), localInfo.Width(),
+          localInfo.Height(), channels, tmpMatrix.colptr(i), targetWidth,
+          targetHeight, centerCrop);
+    }
+    else if (img.n_rows == tmpMatrix.n_rows)
+    {
+      std::copy(img.begin(), img.end(), tmpMatrix.colptr(i));
+    }
+    else
+    {
+      #pragma omp critical (LoadImagesError)
+      {
+        success = false;
+        failureMessage = "'" + files[i] + "' does not match the dimensions "
+            "of '" + files[0] + "'; pass a target size to resize";
+      }
+    }
+  }
+
+  if (!success)
+  {
+    Timer::Stop("loading_image");
+    if (fatal)
+      Log::Fatal << "LoadImages(): " << failureMessage << "." << std::endl;
+    else
+      Log::Warn << "LoadImages(): " << failureMessage << "; load failed."
+          << std::endl;
+
+    return false;
+  }
+
+  info.Width() = width;
+  info.Height() = height;
+  info.Channels() = channels;
+
+  matrix = arma::conv_to<arma::Mat<eT>>::from(tmpMatrix);
+  Timer::Stop("loading_image");
+  return true;
+}
+
 } // namespace data
 } // namespace mlpack
 
@@ -16,6 +16,7 @@
 
 #include <exception>
 #include <algorithm>
+#include <cstdlib>
 #include <mlpack/core/util/timers.hpp>
 
 #include "load_csv.hpp"
@@ -196,6 +197,165 @@ bool Load(const std::string& filename,
   return success;
 }
 
+// Load only the requested dimensions of a text-format dataset.
+template<typename eT>
+bool Load(const std::string& filename,
+          arma::Mat<eT>& matrix,
+          const std::vector<size_t>& dimensions,
+          const bool fatal,
+          const bool transpose)
+{
+  Timer::Start("loading_data");
+
+  if (dimensions.empty())
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "No dimensions to load from '" << filename << "'!"
+          << std::endl;
+    else
+      Log::Warn << "No dimensions to load from '" << filename << "'; load "
+          << "failed." << std::endl;
+
+    return false;
+  }
+
+  // Catch nonexistent files by opening the stream ourselves.
+  std::fstream stream;
+#ifdef  _WIN32 // Always open in binary mode on Windows.
+  stream.open(filename.c_str(), std::fstream::in | std::fstream::binary);
+#else
+  stream.open(filename.c_str(), std::fstream::in);
+#endif
+  if (!stream.is_open())
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "'; load failed."
+          << std::endl;
+
+    return false;
+  }
+
+  const arma::file_type loadType = AutoDetect(stream, filename);
+  if (loadType != arma::csv_ascii && loadType != arma::raw_ascii)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Loading dimensions of '" << filename << "' is only "
+          << "supported for text formats (CSV/TSV/ASCII)." << std::endl;
+    else
+      Log::Warn << "Loading dimensions of '" << filename << "' is only "
+          << "supported for text formats (CSV/TSV/ASCII); load failed."
+          << std::endl;
+
+    return false;
+  }
+
+  Log::Info << "Loading " << dimensions.size() << " dimensions of '"
+      << filename << "' as " << GetStringType(loadType) << ".  " << std::flush;
+
+  // Map each file dimension to the output rows that requested it, so that a
+  // field is converted at most once and unrequested fields never at all.
+  size_t maxDim = 0;
+  for (size_t i = 0; i < dimensions.size(); ++i)
+    maxDim = std::max(maxDim, dimensions[i]);
+
+  std::vector<std::vector<size_t>> outputRows(maxDim + 1);
+  for (size_t i = 0; i < dimensions.size(); ++i)
+    outputRows[dimensions[i]].push_back(i);
+
+  std::vector<eT> values;
+  std::vector<eT> pointValues(dimensions.size());
+  size_t points = 0;
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    // Skip blank lines.
+    size_t pos = line.find_first_not_of(" \t\r");
+    if (pos == std::string::npos)
+      continue;
+
+    size_t fieldIndex = 0;
+    size_t remaining = dimensions.size();
+    if (loadType == arma::csv_ascii)
+    {
+      pos = 0;
+      while (fieldIndex <= maxDim)
+      {
+        const size_t end = line.find(',', pos);
+        if (!outputRows[fieldIndex].empty())
+        {
+          const eT value = (eT) std::strtod(line.c_str() + pos, NULL);
+          for (size_t r = 0; r < outputRows[fieldIndex].size(); ++r)
+            pointValues[outputRows[fieldIndex][r]] = value;
+          remaining -= outputRows[fieldIndex].size();
+        }
+
+        ++fieldIndex;
+        if (end == std::string::npos)
+          break;
+        pos = end + 1;
+      }
+    }
+    else
+    {
+      while (pos != std::string::npos && fieldIndex <= maxDim)
+      {
+        if (!outputRows[fieldIndex].empty())
+        {
+          const eT value = (eT) std::strtod(line.c_str() + pos, NULL);
+          for (size_t r = 0; r < outputRows[fieldIndex].size(); ++r)
+            pointValues[outputRows[fieldIndex][r]] = value;
+          remaining -= outputRows[fieldIndex].size();
+        }
+
+        ++fieldIndex;
+        const size_t end = line.find_first_of(" \t\r", pos);
+        pos = (end == std::string::npos) ? std::string::npos :
+            line.find_first_not_of(" \t\r", end);
+      }
+    }
+
+    if (remaining != 0)
+    {
+      Log::Info << std::endl;
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << "Point " << points << " of '" << filename << "' has too "
+            << "few fields for the requested dimensions (maximum index "
+            << maxDim << ")." << std::endl;
+      else
+        Log::Warn << "Point " << points << " of '" << filename << "' has too "
+            << "few fields for the requested dimensions (maximum index "
+            << maxDim << "); load failed." << std::endl;
+
+      return false;
+    }
+
+    values.insert(values.end(), pointValues.begin(), pointValues.end());
+    ++points;
+  }
+
+  // The values were collected point by point, so they are already in
+  // column-major order for the transposed (dimensions x points) result.
+  matrix.set_size(dimensions.size(), points);
+  std::copy(values.begin(), values.end(), matrix.memptr());
+
+  Log::Info << "Size is " << (transpose ? matrix.n_rows : matrix.n_cols)
+      << " x " << (transpose ? matrix.n_cols : matrix.n_rows) << ".\n";
+
+  bool success = true;
+  if (!transpose)
+    success = inplace_transpose(matrix, fatal);
+
+  Timer::Stop("loading_data");
+
+  return success;
+}
+
 // Load with mappings.  Unfortunately we have to implement this ourselves.
 template<typename eT, typename PolicyType>
 bool Load(const std::string& filename,
@@ -0,0 +1,65 @@
+/**
+ * @file core/data/load_libsvm.hpp
+ * @author Ryan Curtin
+ *
+ * Load a sparse dataset in libsvm/svmlight format.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_LIBSVM_HPP
+#define MLPACK_CORE_DATA_LOAD_LIBSVM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Load a sparse dataset and its labels from a file in libsvm/svmlight format,
+ * where each line holds one point as
+ *
+ * @code
+ * <label> <index>:<value> <index>:<value> ... # optional comment
+ * @endcode
+ *
+ * The points are stored as the columns of the output matrix, following the
+ * usual mlpack convention, and the label of each point is stored in the
+ * corresponding element of the labels vector.  Labels are loaded as floating
+ * point values, so regression targets work too; for classification, pass the
+ * result through NormalizeLabels().
+ *
+ * The dimensionality of the data is inferred from the largest feature index
+ * in the file.  Feature indices are taken as 1-based (the libsvm convention)
+ * unless an index of 0 appears anywhere in the file, in which case the whole
+ * file is treated as 0-based.  Blank lines and comment lines are skipped,
+ * '#' starts a comment anywhere on a line, and svmlight 'qid:<n>' tokens are
+ * ignored.  Within each line the feature indices need not be sorted.
+ *
+ * The file is read in one pass and parsed in parallel: the first parse pass
+ * counts the nonzeros of every line (and finds the dimensionality), so the
+ * sparse matrix can be assembled in its exact final size with no incremental
+ * insertion; the second pass fills the preallocated structure.  The parsed
+ * output does not depend on the number of threads.
+ *
+ * @param filename Name of the file to load.
+ * @param data Sparse matrix to store the points in (one per column).
+ * @param labels Vector to store the label of each point in.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of the load.
+ */
+template<typename eT>
+bool LoadLibSVM(const std::string& filename,
+                arma::SpMat<eT>& data,
+                arma::Row<eT>& labels,
+                const bool fatal = false);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "load_libsvm_impl.hpp"
+
+#endif
@@ -0,0 +1,301 @@
+/**
+ * @file core/data/load_libsvm_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the libsvm/svmlight loader.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_LIBSVM_IMPL_HPP
+#define MLPACK_CORE_DATA_LOAD_LIBSVM_IMPL_HPP
+
+// In case it hasn't been included.
+#include "load_libsvm.hpp"
+
+#include <mlpack/core/util/log.hpp>
+#include <mlpack/core/util/memory_budget.hpp>
+#include <mlpack/core/util/timers.hpp>
+#include <mlpack/core/util/parallel.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+//! Advance p past spaces, tabs and carriage returns, but not past end.
+inline const char* SkipSpace(const char* p, const char* end)
+{
+  while (p != end && (*p == ' ' || *p == '\t' || *p == '\r'))
+    ++p;
+  return p;
+}
+
+//! Return true if the token starting at p is an svmlight 'qid:<n>' token.
+inline bool IsQidToken(const char* p, const char* end)
+{
+  return (end - p >= 4) && (std::strncmp(p, "qid:", 4) == 0);
+}
+
+} // namespace details
+
+template<typename eT>
+bool LoadLibSVM(const std::string& filename,
+                arma::SpMat<eT>& data,
+                arma::Row<eT>& labels,
+                const bool fatal)
+{
+  Timer::Start("loading_data");
+
+  // Read the whole file into memory with one sequential read; all parsing
+  // then happens in memory, where it can be split between threads.
+  std::ifstream stream(filename, std::ios::binary);
+  if (!stream.is_open())
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "'; load failed."
+          << std::endl;
+    return false;
+  }
+
+  stream.seekg(0, std::ios::end);
+  const size_t fileSize = (size_t) stream.tellg();
+  stream.seekg(0, std::ios::beg);
+  // Account the parse buffer against the process memory budget for the
+  // duration of the load, so schedulers can see the load-time peak.
+  MemoryRegistration bufferRegistration(fileSize);
+  std::string buffer(fileSize, '\0');
+  stream.read(&buffer[0], fileSize);
+  stream.close();
+
+  // Find the newline positions, one large block of the buffer per task; a
+  // numeric token can never span a newline, so the blocks are independent.
+  const size_t blockSize = (size_t) 1 << 22;
+  const size_t numBlocks = std::max((size_t) 1,
+      (fileSize + blockSize - 1) / blockSize);
+  std::vector<std::vector<size_t>> blockNewlines(numBlocks);
+  Parallel::For(0, numBlocks, [&](const size_t b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(fileSize, (b + 1) * blockSize);
+    for (size_t i = begin; i < end; ++i)
+    {
+      if (buffer[i] == '\n')
+        blockNewlines[b].push_back(i);
+    }
+  });
+
+  std::vector<size_t> lineBegins, lineEnds;
+  size_t lineBegin = 0;
+  for (size_t b = 0; b < numBlocks; ++b)
+  {
+    for (size_t i = 0; i < blockNewlines[b].size(); ++i)
+    {
+      lineBegins.push_back(lineBegin);
+      lineEnds.push_back(blockNewlines[b][i]);
+      lineBegin = blockNewlines[b][i] + 1;
+    }
+  }
+  if (lineBegin < fileSize) // The last line may have no trailing newline.
+  {
+    lineBegins.push_back(lineBegin);
+    lineEnds.push_back(fileSize);
+  }
+  const size_t numLines = lineBegins.size();
+
+  // First parse pass: per line, parse the label, count the nonzeros, and
+  // track the largest feature index.  Nothing is written into shared
+  // structures except per-line slots, so the lines can be parsed in any
+  // order by any number of threads.
+  std::vector<arma::uword> lineNonzeros(numLines, 0);
+  std::vector<arma::uword> lineMaxIndex(numLines, 0);
+  std::vector<double> lineLabels(numLines, 0.0);
+  std::vector<char> lineValid(numLines, 0);
+  std::vector<char> lineZeroBased(numLines, 0);
+  std::vector<char> lineBad(numLines, 0);
+
+  Parallel::For(0, numLines, [&](const size_t i)
+  {
+    const char* end = buffer.data() + lineEnds[i];
+    const char* p = details::SkipSpace(buffer.data() + lineBegins[i], end);
+    if (p == end || *p == '#')
+      return; // Blank line or comment-only line.
+
+    char* next;
+    lineLabels[i] = std::strtod(p, &next);
+    if (next == p)
+    {
+      lineBad[i] = 1;
+      return;
+    }
+    p = next;
+
+    while (true)
+    {
+      p = details::SkipSpace(p, end);
+      if (p == end || *p == '#')
+        break;
+
+      if (details::IsQidToken(p, end))
+      {
+        while (p != end && *p != ' ' && *p != '\t' && *p != '\r')
+          ++p;
+        continue;
+      }
+
+      const arma::uword index = (arma::uword) std::strtoull(p, &next, 10);
+      if (next == p || *next != ':')
+      {
+        lineBad[i] = 1;
+        return;
+      }
+      p = next + 1;
+      std::strtod(p, &next);
+      if (next == p)
+      {
+        lineBad[i] = 1;
+        return;
+      }
+      p = next;
+
+      if (index == 0)
+        lineZeroBased[i] = 1;
+      lineMaxIndex[i] = std::max(lineMaxIndex[i], index);
+      ++lineNonzeros[i];
+    }
+
+    lineValid[i] = 1;
+  });
+
+  for (size_t i = 0; i < numLines; ++i)
+  {
+    if (lineBad[i])
+    {
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << "Parse error on line " << (i + 1) << " of '" << filename
+            << "'; not a valid libsvm file." << std::endl;
+      else
+        Log::Warn << "Parse error on line " << (i + 1) << " of '" << filename
+            << "'; load failed." << std::endl;
+      return false;
+    }
+  }
+
+  // Assign a column to every valid line and build the exact column pointer
+  // array of the output, so the matrix can be assembled without any
+  // incremental insertion.
+  size_t numPoints = 0;
+  arma::uword totalNonzeros = 0;
+  arma::uword maxIndex = 0;
+  bool zeroBased = false;
+  std::vector<size_t> lineColumn(numLines, 0);
+  for (size_t i = 0; i < numLines; ++i)
+  {
+    if (!lineValid[i])
+      continue;
+    lineColumn[i] = numPoints++;
+    totalNonzeros += lineNonzeros[i];
+    maxIndex = std::max(maxIndex, lineMaxIndex[i]);
+    zeroBased |= (lineZeroBased[i] != 0);
+  }
+
+  // Feature indices are 1-based by convention, unless an index of 0 was seen.
+  const arma::uword base = zeroBased ? 0 : 1;
+  const arma::uword dimensionality =
+      (totalNonzeros == 0) ? 0 : (maxIndex - base + 1);
+
+  arma::uvec colPtr(numPoints + 1);
+  colPtr[0] = 0;
+  labels.set_size(numPoints);
+  for (size_t i = 0; i < numLines; ++i)
+  {
+    if (!lineValid[i])
+      continue;
+    const size_t col = lineColumn[i];
+    colPtr[col + 1] = colPtr[col] + lineNonzeros[i];
+    labels[col] = (eT) lineLabels[i];
+  }
+
+  // Second parse pass: every line writes its nonzeros directly into its own
+  // preallocated slice of the compressed-column arrays.
+  arma::uvec rowIndices(totalNonzeros);
+  arma::Col<eT> values(totalNonzeros);
+  Parallel::For(0, numLines, [&](const size_t i)
+  {
+    if (!lineValid[i])
+      return;
+
+    const char* end = buffer.data() + lineEnds[i];
+    const char* p = details::SkipSpace(buffer.data() + lineBegins[i], end);
+    char* next;
+    std::strtod(p, &next); // Skip the label; it was parsed in the first pass.
+    p = next;
+
+    arma::uword offset = colPtr[lineColumn[i]];
+    const arma::uword colBegin = offset;
+    bool sorted = true;
+    while (true)
+    {
+      p = details::SkipSpace(p, end);
+      if (p == end || *p == '#')
+        break;
+
+      if (details::IsQidToken(p, end))
+      {
+        while (p != end && *p != ' ' && *p != '\t' && *p != '\r')
+          ++p;
+        continue;
+      }
+
+      const arma::uword index = (arma::uword) std::strtoull(p, &next, 10);
+      p = next + 1;
+      const double value = std::strtod(p, &next);
+      p = next;
+
+      rowIndices[offset] = index - base;
+      values[offset] = (eT) value;
+      if (offset > colBegin && rowIndices[offset] <= rowIndices[offset - 1])
+        sorted = false;
+      ++offset;
+    }
+
+    // The compressed-column format needs the row indices of each column in
+    // ascending order; libsvm files almost always are, so only sort when a
+    // line actually violates the order.
+    if (!sorted)
+    {
+      std::vector<std::pair<arma::uword, eT>> entries(offset - colBegin);
+      for (arma::uword j = colBegin; j < offset; ++j)
+        entries[j - colBegin] = std::make_pair(rowIndices[j], values[j]);
+      std::sort(entries.begin(), entries.end());
+      for (arma::uword j = colBegin; j < offset; ++j)
+      {
+        rowIndices[j] = entries[j - colBegin].first;
+        values[j] = entries[j - colBegin].second;
+      }
+    }
+  });
+
+  data = arma::SpMat<eT>(rowIndices, colPtr, values, dimensionality,
+      numPoints);
+
+  Timer::Stop("loading_data");
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
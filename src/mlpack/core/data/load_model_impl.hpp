@@ -16,6 +16,7 @@
 #include "load.hpp"
 
 #include <algorithm>
+#include <vector>
 #include <mlpack/core/util/timers.hpp>
 
 #include "extension.hpp"
@@ -28,9 +29,36 @@
 #include <boost/tokenizer.hpp>
 #include <boost/algorithm/string.hpp>
 
+#ifndef _WIN32
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
 namespace mlpack {
 namespace data {
 
+namespace details {
+
+/**
+ * A minimal read-only streambuf over an existing memory region.  This lets a
+ * boost::archive::binary_iarchive deserialize a model directly out of a
+ * memory-mapped archive file: matrix payloads, which the binary archive stores
+ * as contiguous blobs, are then copied straight from the page cache instead of
+ * being pulled through small stream reads.
+ */
+class MemoryStreamBuf : public std::streambuf
+{
+ public:
+  MemoryStreamBuf(char* begin, const size_t size)
+  {
+    setg(begin, begin, begin + size);
+  }
+};
+
+} // namespace details
+
 // Load a model from file.
 template<typename T>
 bool Load(const std::string& filename,
@@ -62,8 +90,66 @@ bool Load(const std::string& filename,
     }
   }
 
+#ifndef _WIN32
+  // For binary archives, try to memory-map the file and deserialize straight
+  // from the mapping.  The model is then loaded with a handful of large
+  // copies out of the page cache instead of many small stream reads, which
+  // makes a substantial difference for models holding big matrices.
+  if (f == format::binary)
+  {
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd != -1)
+    {
+      struct stat fileStat;
+      const bool statOk = (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0);
+      void* mapping = statOk ?
+          mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0) :
+          MAP_FAILED;
+      // The mapping keeps its own reference to the file.
+      close(fd);
+
+      if (mapping != MAP_FAILED)
+      {
+        try
+        {
+          details::MemoryStreamBuf buf((char*) mapping, fileStat.st_size);
+          boost::archive::binary_iarchive ar(buf);
+          ar >> boost::serialization::make_nvp(name.c_str(), t);
+          munmap(mapping, fileStat.st_size);
+
+          return true;
+        }
+        catch (boost::archive::archive_exception& e)
+        {
+          munmap(mapping, fileStat.st_size);
+
+          if (fatal)
+            Log::Fatal << e.what() << std::endl;
+          else
+            Log::Warn << e.what() << std::endl;
+
+          return false;
+        }
+      }
+    }
+    // If the file could not be mapped, fall through to the stream-based
+    // loader below, which will produce the usual error messages on failure.
+  }
+#endif
+
   // Now load the given format.
   std::ifstream ifs;
+
+  // Use a large stream buffer for binary archives, so that the archive is
+  // read with a small number of large reads.  This must be set up before the
+  // file is opened.
+  std::vector<char> streamBuffer;
+  if (f == format::binary)
+  {
+    streamBuffer.resize(1 << 20);
+    ifs.rdbuf()->pubsetbuf(streamBuffer.data(), streamBuffer.size());
+  }
+
 #ifdef _WIN32 // Open non-text in binary mode on Windows.
   if (f == format::binary)
     ifs.open(filename, std::ifstream::in | std::ifstream::binary);
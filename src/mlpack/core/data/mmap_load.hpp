@@ -0,0 +1,134 @@
+/**
+ * @file core/data/mmap_load.hpp
+ * @author Ryan Curtin
+ *
+ * Memory-mapped zero-copy loading of dense numeric matrices.  Instead of
+ * parsing or copying the data into a freshly-allocated arma::mat, the on-disk
+ * file is mapped directly into the address space and wrapped with Armadillo's
+ * advanced (non-copying) matrix constructor, so the OS page cache can be
+ * shared between processes that load the same file.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MMAP_LOAD_HPP
+#define MLPACK_CORE_DATA_MMAP_LOAD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+#include <string>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * A handle to a dense matrix whose memory is backed by a memory-mapped file
+ * instead of heap-allocated memory.  The mapping is established with
+ * MmapMatrix::Load() and released when the object is destructed (or when
+ * Unmap() is called); any matrix returned by Matrix() must not outlive this
+ * object.
+ *
+ * The file is expected to hold the matrix elements in column-major order with
+ * no header, i.e., the format written by arma::raw_binary for a matrix that
+ * was stored column-major.  Because the file carries no shape information, the
+ * number of rows and columns must be given at load time.
+ *
+ * The mapping is private (copy-on-write), so elements may be modified without
+ * the changes being written back to disk; unmodified pages remain shared with
+ * other processes through the page cache.
+ *
+ * On systems without POSIX mmap() support, Load() falls back to reading the
+ * file into regular heap memory; the interface is unchanged but no sharing
+ * happens.
+ */
+template<typename eT>
+class MmapMatrix
+{
+ public:
+  //! Construct an empty (unmapped) handle.
+  MmapMatrix();
+
+  //! Release the mapping, if any.
+  ~MmapMatrix();
+
+  //! A mapping cannot be copied, but it can be moved.
+  MmapMatrix(const MmapMatrix&) = delete;
+  MmapMatrix& operator=(const MmapMatrix&) = delete;
+  MmapMatrix(MmapMatrix&& other);
+  MmapMatrix& operator=(MmapMatrix&& other);
+
+  /**
+   * Map the given file as a dense column-major matrix with the given shape.
+   * Any existing mapping held by this object is released first.  If the file
+   * cannot be opened or is smaller than rows * cols elements, the load fails.
+   *
+   * @param filename Name of file to map.
+   * @param rows Number of rows of the on-disk matrix.
+   * @param cols Number of columns of the on-disk matrix.
+   * @param fatal If an error should be reported as fatal (default false).
+   * @return Boolean value indicating success or failure of the load.
+   */
+  bool Load(const std::string& filename,
+            const size_t rows,
+            const size_t cols,
+            const bool fatal = false);
+
+  /**
+   * Return a non-owning alias matrix over the mapped memory.  The alias is
+   * strict (it cannot be resized or pointed at other memory) and is only valid
+   * while the mapping is held.
+   */
+  arma::Mat<eT> Matrix() const;
+
+  //! Return true if a file is currently mapped.
+  bool IsMapped() const { return mapping != NULL; }
+
+  //! Get the number of rows of the mapped matrix.
+  size_t Rows() const { return rows; }
+  //! Get the number of columns of the mapped matrix.
+  size_t Cols() const { return cols; }
+
+  //! Release the mapping (if any); Matrix() aliases become invalid.
+  void Unmap();
+
+ private:
+  //! Pointer to the mapped region (or heap fallback buffer), or NULL.
+  void* mapping;
+  //! Length of the mapped region in bytes.
+  size_t length;
+  //! File descriptor of the mapped file, or -1.
+  int fd;
+  //! True if `mapping` is a heap fallback buffer rather than an mmap region.
+  bool heapFallback;
+  //! Shape of the mapped matrix.
+  size_t rows, cols;
+};
+
+/**
+ * Map the given binary column-major file into the given MmapMatrix handle.
+ * This is a thin convenience wrapper around MmapMatrix::Load() that matches
+ * the calling style of data::Load().
+ *
+ * @param filename Name of file to map.
+ * @param rows Number of rows of the on-disk matrix.
+ * @param cols Number of columns of the on-disk matrix.
+ * @param matrix Handle that will own the mapping.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of the load.
+ */
+template<typename eT>
+bool MmapLoad(const std::string& filename,
+              const size_t rows,
+              const size_t cols,
+              MmapMatrix<eT>& matrix,
+              const bool fatal = false);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "mmap_load_impl.hpp"
+
+#endif
@@ -0,0 +1,264 @@
+/**
+ * @file core/data/mmap_load_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of memory-mapped zero-copy matrix loading.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_MMAP_LOAD_IMPL_HPP
+#define MLPACK_CORE_DATA_MMAP_LOAD_IMPL_HPP
+
+// In case it hasn't already been included.
+#include "mmap_load.hpp"
+
+#include <cstdio>
+
+#ifndef _WIN32
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+MmapMatrix<eT>::MmapMatrix() :
+    mapping(NULL),
+    length(0),
+    fd(-1),
+    heapFallback(false),
+    rows(0),
+    cols(0)
+{
+  // Nothing to do.
+}
+
+template<typename eT>
+MmapMatrix<eT>::~MmapMatrix()
+{
+  Unmap();
+}
+
+template<typename eT>
+MmapMatrix<eT>::MmapMatrix(MmapMatrix&& other) :
+    mapping(other.mapping),
+    length(other.length),
+    fd(other.fd),
+    heapFallback(other.heapFallback),
+    rows(other.rows),
+    cols(other.cols)
+{
+  other.mapping = NULL;
+  other.length = 0;
+  other.fd = -1;
+  other.heapFallback = false;
+  other.rows = 0;
+  other.cols = 0;
+}
+
+template<typename eT>
+MmapMatrix<eT>& MmapMatrix<eT>::operator=(MmapMatrix&& other)
+{
+  if (this != &other)
+  {
+    Unmap();
+
+    mapping = other.mapping;
+    length = other.length;
+    fd = other.fd;
+    heapFallback = other.heapFallback;
+    rows = other.rows;
+    cols = other.cols;
+
+    other.mapping = NULL;
+    other.length = 0;
+    other.fd = -1;
+    other.heapFallback = false;
+    other.rows = 0;
+    other.cols = 0;
+  }
+
+  return *this;
+}
+
+template<typename eT>
+void MmapMatrix<eT>::Unmap()
+{
+  if (mapping != NULL)
+  {
+    if (heapFallback)
+    {
+      delete[] (eT*) mapping;
+    }
+    else
+    {
+#ifndef _WIN32
+      munmap(mapping, length);
+#endif
+    }
+    mapping = NULL;
+  }
+
+#ifndef _WIN32
+  if (fd != -1)
+  {
+    close(fd);
+    fd = -1;
+  }
+#endif
+
+  length = 0;
+  heapFallback = false;
+  rows = 0;
+  cols = 0;
+}
+
+template<typename eT>
+bool MmapMatrix<eT>::Load(const std::string& filename,
+                          const size_t rows,
+                          const size_t cols,
+                          const bool fatal)
+{
+  Unmap();
+
+  const size_t bytesNeeded = rows * cols * sizeof(eT);
+
+#ifndef _WIN32
+  fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+  {
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "'. " << std::endl;
+
+    return false;
+  }
+
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) == -1 || (size_t) fileStat.st_size < bytesNeeded)
+  {
+    std::ostringstream oss;
+    oss << "File '" << filename << "' is too small to hold a " << rows << "x"
+        << cols << " matrix of " << sizeof(eT) << "-byte elements!"
+        << std::endl;
+
+    close(fd);
+    fd = -1;
+
+    if (fatal)
+      Log::Fatal << oss.str();
+    else
+      Log::Warn << oss.str();
+
+    return false;
+  }
+
+  // Map the file privately (copy-on-write), so that the caller may modify
+  // elements without writing the changes back to disk, while unmodified pages
+  // remain shared through the page cache.
+  void* map = mmap(NULL, bytesNeeded, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+      0);
+  if (map == MAP_FAILED)
+  {
+    close(fd);
+    fd = -1;
+
+    if (fatal)
+      Log::Fatal << "mmap() of file '" << filename << "' failed!" << std::endl;
+    else
+      Log::Warn << "mmap() of file '" << filename << "' failed!" << std::endl;
+
+    return false;
+  }
+
+  mapping = map;
+  length = bytesNeeded;
+  this->rows = rows;
+  this->cols = cols;
+
+  return true;
+#else
+  // No mmap() support; fall back to reading the file into heap memory.  The
+  // interface is unchanged, but no page sharing happens.
+  Log::Warn << "MmapMatrix::Load(): mmap() is not available on this platform; "
+      << "falling back to a regular read of '" << filename << "'."
+      << std::endl;
+
+  FILE* f = fopen(filename.c_str(), "rb");
+  if (f == NULL)
+  {
+    if (fatal)
+      Log::Fatal << "Cannot open file '" << filename << "'. " << std::endl;
+    else
+      Log::Warn << "Cannot open file '" << filename << "'. " << std::endl;
+
+    return false;
+  }
+
+  eT* buffer = new eT[rows * cols];
+  const size_t elemsRead = fread(buffer, sizeof(eT), rows * cols, f);
+  fclose(f);
+
+  if (elemsRead != rows * cols)
+  {
+    delete[] buffer;
+
+    std::ostringstream oss;
+    oss << "File '" << filename << "' is too small to hold a " << rows << "x"
+        << cols << " matrix of " << sizeof(eT) << "-byte elements!"
+        << std::endl;
+
+    if (fatal)
+      Log::Fatal << oss.str();
+    else
+      Log::Warn << oss.str();
+
+    return false;
+  }
+
+  mapping = buffer;
+  length = bytesNeeded;
+  heapFallback = true;
+  this->rows = rows;
+  this->cols = cols;
+
+  return true;
+#endif
+}
+
+template<typename eT>
+arma::Mat<eT> MmapMatrix<eT>::Matrix() const
+{
+  if (mapping == NULL)
+    return arma::Mat<eT>();
+
+  // Use the advanced constructor: don't copy the memory, and make the alias
+  // strict so Armadillo will never try to resize or free it.
+  return arma::Mat<eT>((eT*) mapping, rows, cols, false, true);
+}
+
+template<typename eT>
+bool MmapLoad(const std::string& filename,
+              const size_t rows,
+              const size_t cols,
+              MmapMatrix<eT>& matrix,
+              const bool fatal)
+{
+  Timer::Start("loading_data");
+  const bool success = matrix.Load(filename, rows, cols, fatal);
+  Timer::Stop("loading_data");
+
+  return success;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
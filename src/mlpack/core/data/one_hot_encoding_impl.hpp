@@ -169,6 +169,144 @@ void OneHotEncoding(const arma::Mat<eT>& input,
   OneHotEncoding(input, arma::Col<size_t>(indices), output);
 }
 
+/**
+ * Overloaded function for the above function, which produces a sparse
+ * output matrix directly.  A one-hot encoded dimension holds exactly one
+ * nonzero per point regardless of how many categories it has, so the
+ * memory use stays proportional to the number of nonzeros.
+ *
+ * @param input Input dataset to be encoded.
+ * @param indices Index of rows to be encoded.
+ * @param output Encoded sparse matrix.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    const arma::Col<size_t>& indices,
+                    arma::SpMat<eT>& output)
+{
+  // Handle the edge case where there is nothing to encode.
+  if (indices.n_elem == 0)
+  {
+    output = arma::SpMat<eT>(input);
+    return;
+  }
+
+  // This vector will eventually hold the offsets for each dimension in the
+  // one-hot encoded matrix, but first it will just hold the counts of
+  // dimensions for each dimension.
+  arma::Col<size_t> dimensionOffsets(input.n_rows, arma::fill::ones);
+  // This will hold the mappings from a value that should be one-hot encoded to
+  // the index of the dimension it should take.
+  std::unordered_map<size_t, std::unordered_map<eT, size_t>> mappings;
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    dimensionOffsets[indices[i]] = 0;
+    mappings.insert(
+        std::make_pair(indices[i], std::unordered_map<eT, size_t>()));
+  }
+
+  // A single counting pass develops the mappings and counts the nonzeros of
+  // each output column: encoded dimensions always contribute one nonzero per
+  // point, and the remaining dimensions contribute their nonzero values.
+  arma::Col<arma::uword> colOffsets(input.n_cols + 1, arma::fill::zeros);
+  for (size_t col = 0; col < input.n_cols; ++col)
+  {
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      if (mappings.count(row) != 0)
+      {
+        // We have to one-hot encode this point.
+        if (mappings[row].count(input(row, col)) == 0)
+          mappings[row][input(row, col)] = dimensionOffsets[row]++;
+
+        colOffsets[col + 1]++;
+      }
+      else if (input(row, col) != eT(0))
+      {
+        colOffsets[col + 1]++;
+      }
+    }
+  }
+
+  // Turn the dimension counts into offsets.  Note that the last element is the
+  // total number of dimensions, and the first element is the offset for
+  // dimension *2* (not 1).
+  for (size_t i = 1; i < dimensionOffsets.n_elem; ++i)
+    dimensionOffsets[i] += dimensionOffsets[i - 1];
+
+  // Turn the column counts into offsets into the batch-insertion arrays.
+  for (size_t i = 1; i < colOffsets.n_elem; ++i)
+    colOffsets[i] += colOffsets[i - 1];
+
+  // The mappings are complete now, so look them up through per-row pointers;
+  // the fill pass below only reads them.
+  std::vector<const std::unordered_map<eT, size_t>*> rowMappings(
+      input.n_rows, NULL);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    rowMappings[indices[i]] = &mappings[indices[i]];
+
+  // Fill the nonzero locations and values in parallel; each column writes
+  // only to its own slice of the arrays.
+  arma::umat locations(2, colOffsets[input.n_cols]);
+  arma::Col<eT> values(colOffsets[input.n_cols]);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t col = 0; col < (omp_size_t) input.n_cols; ++col)
+  {
+    arma::uword pos = colOffsets[col];
+    for (size_t row = 0; row < input.n_rows; ++row)
+    {
+      const size_t dimOffset = (row == 0) ? 0 : dimensionOffsets[row - 1];
+      if (rowMappings[row] != NULL)
+      {
+        locations(0, pos) = dimOffset + rowMappings[row]->at(input(row, col));
+        locations(1, pos) = col;
+        values[pos] = eT(1);
+        ++pos;
+      }
+      else if (input(row, col) != eT(0))
+      {
+        locations(0, pos) = dimOffset;
+        locations(1, pos) = col;
+        values[pos] = input(row, col);
+        ++pos;
+      }
+    }
+  }
+
+  // The locations are already sorted in column-major order and hold no
+  // explicit zeros, so the batch constructor can skip both checks.
+  output = arma::SpMat<eT>(locations, values,
+      dimensionOffsets[dimensionOffsets.n_elem - 1], input.n_cols,
+      false, false);
+}
+
+/**
+ * Overloaded function for the above function, which takes a matrix as input
+ * and also a DatasetInfo object and produces a sparse output matrix.
+ * This function encodes all the dimensions marked `Datatype::categorical`
+ * in the data::DatasetInfo.
+ *
+ * @param input Input dataset to be encoded.
+ * @param output Encoded sparse matrix.
+ * @param datasetInfo DatasetInfo object that has information about data.
+ */
+template<typename eT>
+void OneHotEncoding(const arma::Mat<eT>& input,
+                    arma::SpMat<eT>& output,
+                    const data::DatasetInfo& datasetInfo)
+{
+  std::vector<size_t> indices;
+  for (size_t i = 0; i < datasetInfo.Dimensionality(); ++i)
+  {
+    if (datasetInfo.Type(i) == data::Datatype::categorical)
+    {
+      indices.push_back(i);
+    }
+  }
+  OneHotEncoding(input, arma::Col<size_t>(indices), output);
+}
+
 } // namespace data
 } // namespace mlpack
 
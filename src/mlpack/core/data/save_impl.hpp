@@ -17,6 +17,8 @@
 #include "extension.hpp"
 #include "detect_file_type.hpp"
 
+#include <vector>
+
 #include <boost/serialization/serialization.hpp>
 #include <boost/archive/xml_oarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
@@ -294,6 +296,17 @@ bool Save(const std::string& filename,
 
   // Open the file to save to.
   std::ofstream ofs;
+
+  // Use a large stream buffer for binary archives, so that the archive is
+  // written with a small number of large writes.  This must be set up before
+  // the file is opened.
+  std::vector<char> streamBuffer;
+  if (f == format::binary)
+  {
+    streamBuffer.resize(1 << 20);
+    ofs.rdbuf()->pubsetbuf(streamBuffer.data(), streamBuffer.size());
+  }
+
 #ifdef _WIN32
   if (f == format::binary) // Open non-text types in binary mode on Windows.
     ofs.open(filename, std::ofstream::out | std::ofstream::binary);
@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_MAX_ABS_SCALE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/elementwise_transform.hpp>
 
 namespace mlpack {
 namespace data {
@@ -76,8 +77,10 @@ class MaxAbsScaler
       throw std::runtime_error("Call Fit() before Transform(), please"
         " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = input.each_col() / scale;
+    // One fused, OpenMP-parallel pass over the matrix.
+    DimensionwiseTransform(input, output,
+        [this](const double value, const size_t dimension)
+        { return value / scale[dimension]; });
   }
 
   /**
@@ -89,8 +92,9 @@ class MaxAbsScaler
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output)
   {
-    output.copy_size(input);
-    output = input.each_col() % scale;
+    DimensionwiseTransform(input, output,
+        [this](const double value, const size_t dimension)
+        { return value * scale[dimension]; });
   }
 
   //! Get the Min row vector.
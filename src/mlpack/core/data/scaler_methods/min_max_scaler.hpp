@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_SCALE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/elementwise_transform.hpp>
 
 namespace mlpack {
 namespace data {
@@ -99,8 +100,10 @@ class MinMaxScaler
       throw std::runtime_error("Call Fit() before Transform(), please"
           " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = (input.each_col() % scale).each_col() + scalerowmin;
+    // One fused pass over the matrix instead of two each_col() sweeps.
+    DimensionwiseTransform(input, output,
+        [this](const double value, const size_t dimension)
+        { return value * scale[dimension] + scalerowmin[dimension]; });
   }
 
   /**
@@ -112,8 +115,9 @@ class MinMaxScaler
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output)
   {
-    output.copy_size(input);
-    output = (input.each_col() - scalerowmin).each_col() / scale;
+    DimensionwiseTransform(input, output,
+        [this](const double value, const size_t dimension)
+        { return (value - scalerowmin[dimension]) / scale[dimension]; });
   }
 
   //! Get the Min row vector.
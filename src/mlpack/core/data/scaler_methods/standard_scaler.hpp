@@ -13,6 +13,7 @@
 #define MLPACK_CORE_DATA_STANDARD_SCALE_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/elementwise_transform.hpp>
 
 namespace mlpack {
 namespace data {
@@ -28,6 +29,12 @@ namespace data {
  * where u is the mean of the training samples and s is the standard deviation
  * of the training samples.
  *
+ * The scaler can also be fit incrementally: PartialFit() folds one chunk of
+ * columns at a time into the statistics (using Chan et al.'s numerically
+ * stable merging), so datasets far larger than memory can be fit in a single
+ * streaming pass.  Partially-fit scalers can additionally be combined with
+ * Merge(), so chunks may be processed in parallel and merged afterwards.
+ *
  * @code
  * arma::mat input;
  * Load("train.csv", input);
@@ -47,16 +54,93 @@ namespace data {
 class StandardScaler
 {
  public:
+  //! Create an unfitted scaler.
+  StandardScaler() : count(0) { }
+
   /**
-   * Function to fit features, to find out the min max and scale.
+   * Function to fit features, to find out the min max and scale.  This
+   * discards any statistics from previous calls to Fit() or PartialFit().
    *
    * @param input Dataset to fit.
    */
   template<typename MatType>
   void Fit(const MatType& input)
   {
+    count = input.n_cols;
     itemMean = arma::mean(input, 1);
-    itemStdDev = arma::stddev(input, 1, 1);
+    // Keep the sum of squared deviations from the mean, so that later
+    // PartialFit() calls can continue updating the statistics.
+    sumSquaredDev = arma::sum(arma::square(input.each_col() - itemMean), 1);
+    itemStdDev = arma::sqrt(sumSquaredDev / count);
+    // Handle zeros in scale vector.
+    itemStdDev.for_each([](arma::vec::elem_type& val) { val =
+        (val == 0) ? 1 : val; });
+  }
+
+  /**
+   * Fold one chunk of columns into the statistics, as if Fit() had been
+   * called on all chunks seen so far at once.  The scaler is usable with
+   * Transform() after any number of PartialFit() calls.
+   *
+   * @param input Chunk of the dataset to fit.
+   */
+  template<typename MatType>
+  void PartialFit(const MatType& input)
+  {
+    if (input.n_cols == 0)
+      return;
+
+    if (count == 0)
+    {
+      Fit(input);
+      return;
+    }
+
+    // Chan et al.'s update of the mean and the sum of squared deviations.
+    const size_t chunkCount = input.n_cols;
+    const size_t totalCount = count + chunkCount;
+    const arma::vec chunkMean = arma::mean(input, 1);
+    const arma::vec chunkSumSquaredDev =
+        arma::sum(arma::square(input.each_col() - chunkMean), 1);
+    const arma::vec delta = chunkMean - itemMean;
+
+    sumSquaredDev += chunkSumSquaredDev + arma::square(delta) *
+        ((double) count * chunkCount / totalCount);
+    itemMean += delta * ((double) chunkCount / totalCount);
+    count = totalCount;
+
+    itemStdDev = arma::sqrt(sumSquaredDev / count);
+    // Handle zeros in scale vector.
+    itemStdDev.for_each([](arma::vec::elem_type& val) { val =
+        (val == 0) ? 1 : val; });
+  }
+
+  /**
+   * Merge the partial statistics of another scaler into this one, as if this
+   * scaler had seen all of the columns the other scaler has seen.
+   *
+   * @param other Partially-fit scaler to merge in.
+   */
+  void Merge(const StandardScaler& other)
+  {
+    if (other.count == 0)
+      return;
+
+    if (count == 0)
+    {
+      *this = other;
+      return;
+    }
+
+    const size_t totalCount = count + other.count;
+    const arma::vec delta = other.itemMean - itemMean;
+
+    sumSquaredDev += other.sumSquaredDev + arma::square(delta) *
+        ((double) count * other.count / totalCount);
+    itemMean += delta * ((double) other.count / totalCount);
+    count = totalCount;
+
+    itemStdDev = arma::sqrt(sumSquaredDev / count);
     // Handle zeros in scale vector.
     itemStdDev.for_each([](arma::vec::elem_type& val) { val =
         (val == 0) ? 1 : val; });
@@ -76,8 +160,10 @@ class StandardScaler
       throw std::runtime_error("Call Fit() before Transform(), please"
         " refer to the documentation.");
     }
-    output.copy_size(input);
-    output = (input.each_col() - itemMean).each_col() / itemStdDev;
+    // One fused pass over the matrix instead of two each_col() sweeps.
+    DimensionwiseTransform(input, output,
+        [this](const double value, const size_t dimension)
+        { return (value - itemMean[dimension]) / itemStdDev[dimension]; });
   }
 
   /**
@@ -89,27 +175,37 @@ class StandardScaler
   template<typename MatType>
   void InverseTransform(const MatType& input, MatType& output)
   {
-    output.copy_size(input);
-    output = (input.each_col() % itemStdDev).each_col() + itemMean;
+    DimensionwiseTransform(input, output,
+        [this](const double value, const size_t dimension)
+        { return value * itemStdDev[dimension] + itemMean[dimension]; });
   }
 
   //! Get the mean row vector.
   const arma::vec& ItemMean() const { return itemMean; }
   //! Get the standard deviation row vector.
   const arma::vec& ItemStdDev() const { return itemStdDev; }
+  //! Get the number of columns the scaler has been fit on.
+  size_t Count() const { return count; }
 
   template<typename Archive>
   void serialize(Archive& ar, const unsigned int /* version */)
   {
     ar & BOOST_SERIALIZATION_NVP(itemMean);
     ar & BOOST_SERIALIZATION_NVP(itemStdDev);
+    ar & BOOST_SERIALIZATION_NVP(count);
+    ar & BOOST_SERIALIZATION_NVP(sumSquaredDev);
   }
 
  private:
+  // Number of columns the scaler has been fit on.
+  size_t count;
   // Vector which holds mean of each feature.
   arma::vec itemMean;
   // Vector which holds standard devation of each feature.
   arma::vec itemStdDev;
+  // Sum of squared deviations from the mean of each feature; kept so that
+  // PartialFit() and Merge() can continue updating the statistics.
+  arma::vec sumSquaredDev;
 }; // class StandardScaler
 
 } // namespace data
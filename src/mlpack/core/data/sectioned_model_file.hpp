@@ -0,0 +1,145 @@
+/**
+ * @file core/data/sectioned_model_file.hpp
+ * @author Ryan Curtin
+ *
+ * A sectioned model archive with lazy loading.  Each section of the file is a
+ * complete serialized object with a name, and a reader deserializes a section
+ * only when it is first asked for, so a caller that only needs some of the
+ * sections (for instance, a prediction service that does not need a stored
+ * reference dataset) never pays the time or memory for the others.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SECTIONED_MODEL_FILE_HPP
+#define MLPACK_CORE_DATA_SECTIONED_MODEL_FILE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The SectionedModelFile class reads and writes model files that are split
+ * into independently deserializable sections.  When writing, each call to
+ * Add() serializes one object into its own binary archive, and Save() writes
+ * an index (section names and sizes) followed by the archives.  When reading,
+ * Open() only parses the index; the file stays open, and each section is
+ * deserialized on the first call to Load() for its name, with a single seek
+ * to the section's offset.  Sections that are never asked for are never read.
+ *
+ * This is useful for models that carry large members that not every caller
+ * needs.  For instance, a training process can store the model and the
+ * dataset it was trained on as separate sections, and a prediction service
+ * can then open the file and materialize only the model:
+ *
+ * @code
+ * // Training process: save the model and the dataset separately.
+ * SectionedModelFile file;
+ * file.Add("model", rf);
+ * file.Add("dataset", dataset);
+ * file.Save("rf_model.bin");
+ *
+ * // Prediction service: the dataset section is never read.
+ * SectionedModelFile loaded("rf_model.bin");
+ * loaded.Load("model", rf);
+ * @endcode
+ *
+ * Sections are always stored in boost binary archive format, so a sectioned
+ * model file is not portable across machines with different endianness (the
+ * same restriction as data::Save() with format::binary).
+ */
+class SectionedModelFile
+{
+ public:
+  /**
+   * Create an empty sectioned model file, ready for Add() and Save().
+   */
+  SectionedModelFile();
+
+  /**
+   * Open a sectioned model file for lazy reading.  Only the index is parsed;
+   * use Load() to deserialize individual sections.  If the file cannot be
+   * opened or is not a sectioned model file, an error is printed (fatal if
+   * `fatal` is true) and Has() will return false for every name.
+   *
+   * @param filename File to open.
+   * @param fatal Whether an error should be fatal.
+   */
+  explicit SectionedModelFile(const std::string& filename,
+                              const bool fatal = false);
+
+  /**
+   * Serialize the given object into a new section with the given name.  The
+   * object is serialized immediately, so it may be modified or destroyed
+   * after Add() returns.
+   *
+   * @param name Name of the section.
+   * @param t Object to serialize.
+   */
+  template<typename T>
+  void Add(const std::string& name, const T& t);
+
+  /**
+   * Write all added sections to the given file.
+   *
+   * @param filename File to write.
+   * @param fatal Whether a write failure should be fatal.
+   * @return true on success.
+   */
+  bool Save(const std::string& filename, const bool fatal = false);
+
+  /**
+   * Open a sectioned model file for lazy reading (see the constructor taking
+   * a filename).
+   *
+   * @param filename File to open.
+   * @param fatal Whether an error should be fatal.
+   * @return true if the index was read successfully.
+   */
+  bool Open(const std::string& filename, const bool fatal = false);
+
+  /**
+   * Check whether a section with the given name exists.
+   */
+  bool Has(const std::string& name) const;
+
+  /**
+   * Deserialize the section with the given name into the given object.  Only
+   * the bytes of this section are read.  If the section does not exist or
+   * cannot be deserialized into the given type, an error is printed (fatal if
+   * `fatal` is true) and false is returned.
+   *
+   * @param name Name of the section to deserialize.
+   * @param t Object to deserialize into.
+   * @param fatal Whether an error should be fatal.
+   * @return true on success.
+   */
+  template<typename T>
+  bool Load(const std::string& name, T& t, const bool fatal = false);
+
+  //! Get the names of all sections, in the order they were added.
+  const std::vector<std::string>& SectionNames() const { return names; }
+
+ private:
+  //! Names of the sections, in file order.
+  std::vector<std::string> names;
+  //! Serialized section payloads (only used when writing).
+  std::vector<std::string> buffers;
+  //! Sizes of the sections, in bytes.
+  std::vector<uint64_t> lengths;
+  //! Absolute file offsets of the sections (only used when reading).
+  std::vector<uint64_t> offsets;
+  //! Stream the sections are lazily read from.
+  std::ifstream ifs;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "sectioned_model_file_impl.hpp"
+
+#endif
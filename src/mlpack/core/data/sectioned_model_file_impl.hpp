@@ -0,0 +1,230 @@
+/**
+ * @file core/data/sectioned_model_file_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the SectionedModelFile class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SECTIONED_MODEL_FILE_IMPL_HPP
+#define MLPACK_CORE_DATA_SECTIONED_MODEL_FILE_IMPL_HPP
+
+// In case it hasn't already been included.
+#include "sectioned_model_file.hpp"
+
+#include <boost/serialization/serialization.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+//! Magic string identifying a sectioned model file (and its format version).
+inline const char* SectionedModelFileMagic()
+{
+  return "mlpack_sectioned_model_1\n";
+}
+
+} // namespace details
+
+inline SectionedModelFile::SectionedModelFile()
+{
+  // Nothing to do.
+}
+
+inline SectionedModelFile::SectionedModelFile(const std::string& filename,
+                                              const bool fatal)
+{
+  Open(filename, fatal);
+}
+
+template<typename T>
+void SectionedModelFile::Add(const std::string& name, const T& t)
+{
+  std::ostringstream oss(std::ios::binary);
+  {
+    boost::archive::binary_oarchive ar(oss);
+    ar << boost::serialization::make_nvp(name.c_str(), t);
+  }
+
+  names.push_back(name);
+  buffers.push_back(oss.str());
+}
+
+inline bool SectionedModelFile::Save(const std::string& filename,
+                                     const bool fatal)
+{
+  std::ofstream ofs(filename, std::ofstream::out | std::ofstream::binary);
+  if (!ofs.is_open())
+  {
+    if (fatal)
+      Log::Fatal << "Unable to open file '" << filename << "' to save "
+          << "sectioned model." << std::endl;
+    else
+      Log::Warn << "Unable to open file '" << filename << "' to save "
+          << "sectioned model." << std::endl;
+
+    return false;
+  }
+
+  // The index holds the section names and sizes; the offsets follow from the
+  // sizes, since the sections are written back to back after the index.
+  lengths.resize(buffers.size());
+  for (size_t i = 0; i < buffers.size(); ++i)
+    lengths[i] = (uint64_t) buffers[i].size();
+
+  ofs.write(details::SectionedModelFileMagic(),
+      strlen(details::SectionedModelFileMagic()));
+  {
+    boost::archive::binary_oarchive ar(ofs);
+    ar << BOOST_SERIALIZATION_NVP(names);
+    ar << BOOST_SERIALIZATION_NVP(lengths);
+  }
+
+  for (size_t i = 0; i < buffers.size(); ++i)
+    ofs.write(buffers[i].data(), buffers[i].size());
+
+  return !ofs.fail();
+}
+
+inline bool SectionedModelFile::Open(const std::string& filename,
+                                     const bool fatal)
+{
+  names.clear();
+  buffers.clear();
+  lengths.clear();
+  offsets.clear();
+
+  if (ifs.is_open())
+    ifs.close();
+  ifs.clear();
+  ifs.open(filename, std::ifstream::in | std::ifstream::binary);
+  if (!ifs.is_open())
+  {
+    if (fatal)
+      Log::Fatal << "Unable to open file '" << filename << "' to load "
+          << "sectioned model." << std::endl;
+    else
+      Log::Warn << "Unable to open file '" << filename << "' to load "
+          << "sectioned model." << std::endl;
+
+    return false;
+  }
+
+  // Check the magic string, then read the index; the sections themselves are
+  // not read until they are asked for.
+  const size_t magicLen = strlen(details::SectionedModelFileMagic());
+  std::vector<char> magic(magicLen);
+  ifs.read(magic.data(), magicLen);
+  if (ifs.fail() ||
+      strncmp(magic.data(), details::SectionedModelFileMagic(), magicLen) != 0)
+  {
+    if (fatal)
+      Log::Fatal << "File '" << filename << "' is not a sectioned model "
+          << "file!" << std::endl;
+    else
+      Log::Warn << "File '" << filename << "' is not a sectioned model "
+          << "file!" << std::endl;
+
+    ifs.close();
+    return false;
+  }
+
+  try
+  {
+    boost::archive::binary_iarchive ar(ifs);
+    ar >> BOOST_SERIALIZATION_NVP(names);
+    ar >> BOOST_SERIALIZATION_NVP(lengths);
+  }
+  catch (boost::archive::archive_exception& e)
+  {
+    if (fatal)
+      Log::Fatal << e.what() << std::endl;
+    else
+      Log::Warn << e.what() << std::endl;
+
+    names.clear();
+    lengths.clear();
+    ifs.close();
+    return false;
+  }
+
+  // The sections are laid out back to back after the index.
+  offsets.resize(lengths.size());
+  uint64_t offset = (uint64_t) ifs.tellg();
+  for (size_t i = 0; i < lengths.size(); ++i)
+  {
+    offsets[i] = offset;
+    offset += lengths[i];
+  }
+
+  return true;
+}
+
+inline bool SectionedModelFile::Has(const std::string& name) const
+{
+  for (size_t i = 0; i < names.size(); ++i)
+    if (names[i] == name)
+      return true;
+
+  return false;
+}
+
+template<typename T>
+bool SectionedModelFile::Load(const std::string& name,
+                              T& t,
+                              const bool fatal)
+{
+  size_t index = names.size();
+  for (size_t i = 0; i < names.size(); ++i)
+  {
+    if (names[i] == name)
+    {
+      index = i;
+      break;
+    }
+  }
+
+  if (index == names.size() || index >= offsets.size())
+  {
+    if (fatal)
+      Log::Fatal << "No section '" << name << "' in sectioned model file!"
+          << std::endl;
+    else
+      Log::Warn << "No section '" << name << "' in sectioned model file!"
+          << std::endl;
+
+    return false;
+  }
+
+  try
+  {
+    ifs.clear();
+    ifs.seekg((std::streamoff) offsets[index]);
+    boost::archive::binary_iarchive ar(ifs);
+    ar >> boost::serialization::make_nvp(name.c_str(), t);
+  }
+  catch (boost::archive::archive_exception& e)
+  {
+    if (fatal)
+      Log::Fatal << e.what() << std::endl;
+    else
+      Log::Warn << e.what() << std::endl;
+
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -150,6 +150,144 @@ void Split(const arma::Mat<T>& input,
   }
 }
 
+/**
+ * Compute a train/test split as column indices only, without copying any data.
+ * The two output vectors form a permutation of the column indices
+ * [0, numPoints); they can be used to form views of the original dataset and
+ * labels, so the split itself moves no data.  Example usage below.
+ *
+ * @code
+ * arma::mat input = loadData();
+ * arma::Row<size_t> label = loadLabel();
+ * arma::uvec trainIndices, testIndices;
+ *
+ * // Split the dataset, with 30% of the data being held out for the test set.
+ * data::SplitIndices(input.n_cols, trainIndices, testIndices, 0.3);
+ *
+ * // The index vectors can be used wherever a view of the data is enough:
+ * model.Train(input.cols(trainIndices), label.cols(trainIndices));
+ * @endcode
+ *
+ * @param numPoints Number of points (columns) in the dataset to split.
+ * @param trainIndices Vector to store the indices of the training points into.
+ * @param testIndices Vector to store the indices of the test points into.
+ * @param testRatio Percentage of dataset to use for test set (between 0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *       sample is visited in linear order. (Default true.)
+ */
+inline void SplitIndices(const size_t numPoints,
+                         arma::uvec& trainIndices,
+                         arma::uvec& testIndices,
+                         const double testRatio,
+                         const bool shuffleData = true)
+{
+  if (numPoints == 0)
+  {
+    trainIndices.set_size(0);
+    testIndices.set_size(0);
+    return;
+  }
+
+  const size_t testSize = static_cast<size_t>(numPoints * testRatio);
+  const size_t trainSize = numPoints - testSize;
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, numPoints - 1, numPoints);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  if (trainSize > 0)
+    trainIndices = order.subvec(0, trainSize - 1);
+  else
+    trainIndices.set_size(0);
+
+  if (trainSize < numPoints)
+    testIndices = order.subvec(trainSize, numPoints - 1);
+  else
+    testIndices.set_size(0);
+}
+
+/**
+ * Compute a stratified train/test split as column indices only, without
+ * copying any data.  The class proportions among the given labels are
+ * preserved in both parts of the split: each class contributes testRatio of
+ * its points (rounded down) to the test set.  This replaces re-shuffling
+ * until a split happens to balance.  As with SplitIndices(), the two output
+ * vectors form a permutation of the column indices, so they can be used to
+ * form views of the original dataset and labels with no data movement.
+ *
+ * It is assumed that the labels take values from 0 to max(labels).
+ *
+ * @code
+ * arma::mat input = loadData();
+ * arma::Row<size_t> label = loadLabel();
+ * arma::uvec trainIndices, testIndices;
+ *
+ * // Split the dataset, with 30% of each class held out for the test set.
+ * data::StratifiedSplitIndices(label, trainIndices, testIndices, 0.3);
+ * @endcode
+ *
+ * @param inputLabel Labels of the points to split.
+ * @param trainIndices Vector to store the indices of the training points into.
+ * @param testIndices Vector to store the indices of the test points into.
+ * @param testRatio Percentage of each class to use for the test set (between
+ *       0 and 1).
+ * @param shuffleData If true, the sample order is shuffled; otherwise, each
+ *       sample is visited in linear order. (Default true.)
+ */
+template<typename U>
+void StratifiedSplitIndices(const arma::Row<U>& inputLabel,
+                            arma::uvec& trainIndices,
+                            arma::uvec& testIndices,
+                            const double testRatio,
+                            const bool shuffleData = true)
+{
+  const size_t numPoints = inputLabel.n_elem;
+  if (numPoints == 0)
+  {
+    trainIndices.set_size(0);
+    testIndices.set_size(0);
+    return;
+  }
+
+  // Count the points of each class, then compute how many of them belong in
+  // the test set.
+  const size_t numClasses = static_cast<size_t>(arma::max(inputLabel)) + 1;
+  arma::uvec classCounts = arma::zeros<arma::uvec>(numClasses);
+  for (size_t i = 0; i < numPoints; ++i)
+    classCounts[static_cast<size_t>(inputLabel[i])]++;
+
+  arma::uvec testCounts(numClasses);
+  for (size_t c = 0; c < numClasses; ++c)
+    testCounts[c] = static_cast<size_t>(classCounts[c] * testRatio);
+
+  const size_t testSize = arma::accu(testCounts);
+  trainIndices.set_size(numPoints - testSize);
+  testIndices.set_size(testSize);
+
+  arma::uvec order = arma::linspace<arma::uvec>(0, numPoints - 1, numPoints);
+  if (shuffleData)
+    order = arma::shuffle(order);
+
+  // Walk the (possibly shuffled) points; the first testCounts[c] points of
+  // each class go into the test set and the rest go into the training set.
+  arma::uvec testFilled = arma::zeros<arma::uvec>(numClasses);
+  size_t trainPos = 0;
+  size_t testPos = 0;
+  for (size_t i = 0; i < numPoints; ++i)
+  {
+    const size_t c = static_cast<size_t>(inputLabel[order[i]]);
+    if (testFilled[c] < testCounts[c])
+    {
+      testIndices[testPos++] = order[i];
+      testFilled[c]++;
+    }
+    else
+    {
+      trainIndices[trainPos++] = order[i];
+    }
+  }
+}
+
 /**
  * Given an input dataset and labels, split into a training set and test set.
  * Example usage below.  This overload returns the split dataset as a std::tuple
@@ -0,0 +1,135 @@
+/**
+ * @file core/data/streaming_dataset.hpp
+ * @author Ryan Curtin
+ *
+ * An out-of-core dataset abstraction that yields fixed-size column chunks
+ * from disk, so that incremental learners can be trained on datasets that do
+ * not fit in RAM.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_STREAMING_DATASET_HPP
+#define MLPACK_CORE_DATA_STREAMING_DATASET_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/log.hpp>
+
+#include <fstream>
+#include <future>
+#include <string>
+
+#include "extension.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * StreamingDataset reads a dataset from disk in fixed-size column chunks
+ * instead of loading the entire matrix into one arma::mat.  Each chunk is an
+ * arma::Mat<eT> with Dimensionality() rows and up to ChunkSize() columns, in
+ * the same (transposed, column-per-point) orientation that data::Load()
+ * produces.  While the caller processes one chunk, the next chunk is parsed
+ * on a background thread (double buffering), so I/O and parsing overlap with
+ * computation.
+ *
+ * Two file types are supported:
+ *
+ *  - delimited text (.csv, .tsv, .txt), where each line of the file is one
+ *    point; the dimensionality is taken from the first line.  Only numeric
+ *    values are supported---for categorical data, use data::Load() with a
+ *    DatasetMapper.
+ *  - raw binary (.bin), holding the elements of a column-major
+ *    dimensionality x points matrix with no header; the dimensionality must
+ *    be given to the constructor since the file carries no shape information.
+ *
+ * A typical out-of-core training loop with an incremental learner looks like:
+ *
+ * @code
+ * StreamingDataset<double> stream("data.csv", 10000);
+ * arma::mat chunk;
+ * while (stream.Next(chunk))
+ *   nbc.Train(chunk, GetLabels(chunk), true); // Incremental training.
+ * @endcode
+ */
+template<typename eT>
+class StreamingDataset
+{
+ public:
+  /**
+   * Open the given file for chunked streaming.  The file is opened
+   * immediately and the dimensionality is determined from the first line (for
+   * text files) or taken from the dimensionality parameter (for raw binary
+   * files); a std::runtime_error is thrown if the file cannot be opened or
+   * the dimensionality cannot be established.  Prefetch of the first chunk
+   * starts immediately.
+   *
+   * @param filename Name of the file to stream.
+   * @param chunkSize Maximum number of columns (points) per chunk.
+   * @param dimensionality Number of rows; required for raw binary files and
+   *     ignored for text files (default 0).
+   */
+  StreamingDataset(const std::string& filename,
+                   const size_t chunkSize,
+                   const size_t dimensionality = 0);
+
+  //! Wait for any outstanding prefetch and close the file.
+  ~StreamingDataset();
+
+  //! The stream holds file state and a prefetch buffer; it cannot be copied.
+  StreamingDataset(const StreamingDataset&) = delete;
+  StreamingDataset& operator=(const StreamingDataset&) = delete;
+
+  /**
+   * Retrieve the next chunk of the dataset.  The chunk will have
+   * Dimensionality() rows and between 1 and ChunkSize() columns (the last
+   * chunk of the file may be smaller).  Returns false when the end of the
+   * file has been reached, in which case the chunk is left empty.
+   *
+   * @param chunk Matrix to store the chunk in.
+   * @return True if a chunk was produced; false at end of file.
+   */
+  bool Next(arma::Mat<eT>& chunk);
+
+  //! Rewind the stream to the beginning of the file for another epoch.
+  void Reset();
+
+  //! Get the dimensionality (number of rows) of the dataset.
+  size_t Dimensionality() const { return dimensionality; }
+  //! Get the maximum number of columns per chunk.
+  size_t ChunkSize() const { return chunkSize; }
+  //! Get the number of columns that have been handed out so far.
+  size_t ColumnsRead() const { return columnsRead; }
+
+ private:
+  //! Synchronously parse the next chunk from the file.
+  arma::Mat<eT> ReadChunk();
+
+  //! Launch an asynchronous prefetch of the next chunk.
+  void Prefetch();
+
+  //! Name of the file being streamed.
+  std::string filename;
+  //! Maximum number of columns per chunk.
+  size_t chunkSize;
+  //! Number of rows of the dataset.
+  size_t dimensionality;
+  //! True if the file is raw binary (false for delimited text).
+  bool binary;
+  //! Open stream on the file.
+  std::ifstream inFile;
+  //! Number of columns handed out so far.
+  size_t columnsRead;
+  //! Pending asynchronously-parsed chunk, if any.
+  std::future<arma::Mat<eT>> pending;
+};
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "streaming_dataset_impl.hpp"
+
+#endif
@@ -0,0 +1,219 @@
+/**
+ * @file core/data/streaming_dataset_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the StreamingDataset out-of-core chunk reader.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_STREAMING_DATASET_IMPL_HPP
+#define MLPACK_CORE_DATA_STREAMING_DATASET_IMPL_HPP
+
+// In case it hasn't already been included.
+#include "streaming_dataset.hpp"
+
+#include <cstdlib>
+#include <sstream>
+
+namespace mlpack {
+namespace data {
+
+template<typename eT>
+StreamingDataset<eT>::StreamingDataset(const std::string& filename,
+                                       const size_t chunkSize,
+                                       const size_t dimensionality) :
+    filename(filename),
+    chunkSize(chunkSize),
+    dimensionality(dimensionality),
+    binary(Extension(filename) == "bin"),
+    inFile(filename, binary ? (std::ios::in | std::ios::binary) :
+        std::ios::in),
+    columnsRead(0)
+{
+  if (chunkSize == 0)
+    throw std::invalid_argument("StreamingDataset: chunkSize must be > 0!");
+
+  if (!inFile.is_open())
+  {
+    std::ostringstream oss;
+    oss << "StreamingDataset: cannot open file '" << filename << "'!";
+    throw std::runtime_error(oss.str());
+  }
+
+  if (binary)
+  {
+    if (dimensionality == 0)
+    {
+      throw std::invalid_argument("StreamingDataset: the dimensionality must "
+          "be specified for raw binary files!");
+    }
+  }
+  else
+  {
+    // Determine the dimensionality from the first line, then rewind.
+    std::string line;
+    if (!std::getline(inFile, line))
+    {
+      std::ostringstream oss;
+      oss << "StreamingDataset: file '" << filename << "' is empty!";
+      throw std::runtime_error(oss.str());
+    }
+
+    size_t dims = 0;
+    const char* pos = line.c_str();
+    while (*pos != '\0')
+    {
+      char* end;
+      (void) std::strtod(pos, &end);
+      if (end == pos)
+        ++pos; // Skip a delimiter or unparseable character.
+      else
+      {
+        ++dims;
+        pos = end;
+      }
+    }
+
+    if (dims == 0)
+    {
+      std::ostringstream oss;
+      oss << "StreamingDataset: no numeric values found on the first line of "
+          << "'" << filename << "'!";
+      throw std::runtime_error(oss.str());
+    }
+
+    this->dimensionality = dims;
+    inFile.clear();
+    inFile.seekg(0, std::ios::beg);
+  }
+
+  // Start prefetching the first chunk.
+  Prefetch();
+}
+
+template<typename eT>
+StreamingDataset<eT>::~StreamingDataset()
+{
+  // Wait for any outstanding prefetch before the stream is torn down.
+  if (pending.valid())
+    pending.wait();
+}
+
+template<typename eT>
+arma::Mat<eT> StreamingDataset<eT>::ReadChunk()
+{
+  arma::Mat<eT> chunk(dimensionality, chunkSize);
+
+  if (binary)
+  {
+    inFile.read((char*) chunk.memptr(),
+        dimensionality * chunkSize * sizeof(eT));
+    const size_t elemsRead = inFile.gcount() / sizeof(eT);
+    const size_t colsRead = elemsRead / dimensionality;
+
+    if (elemsRead % dimensionality != 0)
+    {
+      std::ostringstream oss;
+      oss << "StreamingDataset: file '" << filename << "' ends with a "
+          << "partial column (" << (elemsRead % dimensionality) << " of "
+          << dimensionality << " elements)!";
+      throw std::runtime_error(oss.str());
+    }
+
+    chunk.resize(dimensionality, colsRead);
+    return chunk;
+  }
+
+  // Text: parse up to chunkSize lines, one column per line.
+  size_t col = 0;
+  std::string line;
+  while (col < chunkSize && std::getline(inFile, line))
+  {
+    if (line.empty())
+      continue;
+
+    size_t dim = 0;
+    const char* pos = line.c_str();
+    while (*pos != '\0' && dim < dimensionality)
+    {
+      char* end;
+      const double val = std::strtod(pos, &end);
+      if (end == pos)
+        ++pos; // Skip a delimiter.
+      else
+      {
+        chunk(dim++, col) = (eT) val;
+        pos = end;
+      }
+    }
+
+    if (dim != dimensionality)
+    {
+      std::ostringstream oss;
+      oss << "StreamingDataset: wrong number of values (" << dim << ") on "
+          << "line " << (columnsRead + col) << " of '" << filename
+          << "'; should be " << dimensionality << "!";
+      throw std::runtime_error(oss.str());
+    }
+
+    ++col;
+  }
+
+  chunk.resize(dimensionality, col);
+  return chunk;
+}
+
+template<typename eT>
+void StreamingDataset<eT>::Prefetch()
+{
+  // Parse the next chunk on a background thread; the std::ifstream is only
+  // ever touched by one thread at a time, because Next() waits on the future
+  // before launching the next prefetch.
+  pending = std::async(std::launch::async,
+      [this]() { return ReadChunk(); });
+}
+
+template<typename eT>
+bool StreamingDataset<eT>::Next(arma::Mat<eT>& chunk)
+{
+  if (!pending.valid())
+    return false;
+
+  chunk = pending.get();
+  if (chunk.n_cols == 0)
+  {
+    chunk.clear();
+    return false;
+  }
+
+  columnsRead += chunk.n_cols;
+
+  // Start reading the chunk after this one while the caller works.
+  if (!inFile.eof())
+    Prefetch();
+
+  return true;
+}
+
+template<typename eT>
+void StreamingDataset<eT>::Reset()
+{
+  // Wait for any outstanding prefetch, then rewind and start over.
+  if (pending.valid())
+    pending.wait();
+
+  inFile.clear();
+  inFile.seekg(0, std::ios::beg);
+  columnsRead = 0;
+  pending = std::future<arma::Mat<eT>>();
+
+  Prefetch();
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,144 @@
+/**
+ * @file core/data/string_encoding_hash_dictionary.hpp
+ * @author Jeffin Sam
+ * @author Mikhail Lozhnikov
+ *
+ * Definition of the StringEncodingHashDictionary class, a drop-in
+ * replacement for StringEncodingDictionary that maps tokens to a fixed
+ * range of ids by hashing instead of storing them.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_STRING_ENCODING_HASH_DICTIONARY_HPP
+#define MLPACK_CORE_DATA_STRING_ENCODING_HASH_DICTIONARY_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/boost_backport/boost_backport_string_view.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The StringEncodingHashDictionary class maps each token to the value
+ * (hash(token) mod numBuckets) + 1 instead of assigning sequential labels
+ * from a stored mapping.  It provides the same interface as
+ * StringEncodingDictionary, but holds no per-token state: memory use is
+ * constant no matter how large the vocabulary grows, and since nothing is
+ * ever written, tokens of different documents can be encoded concurrently.
+ * The price is that distinct tokens may collide on one id; with a bucket
+ * count well above the number of frequent tokens, collisions are rare
+ * enough for most learning tasks (the hashing trick).
+ *
+ * Like the stored dictionary, ids start at one, so zero stays available as
+ * the padding value.
+ *
+ * @tparam Token Type of the tokens (an arithmetic type, or a string-like
+ *     type providing data() and size()).
+ */
+template<typename Token>
+class StringEncodingHashDictionary
+{
+ public:
+  //! A convenient alias for the token type.
+  using TokenType = Token;
+
+  //! The dictionary never changes while encoding, so concurrent encoding of
+  //! different documents is safe.
+  static const bool immutableDuringEncoding = true;
+
+  /**
+   * Construct the dictionary with the given number of hash buckets.
+   *
+   * @param numBuckets Number of distinct token ids.
+   */
+  StringEncodingHashDictionary(const size_t numBuckets = 262144) :
+      numBuckets(numBuckets)
+  { }
+
+  /**
+   * The function returns true: every token hashes to some bucket, so every
+   * token is considered known.
+   *
+   * @param * (token) The given token.
+   */
+  bool HasToken(const Token& /* token */) const { return true; }
+
+  /**
+   * The function returns the token id; nothing is stored, so "adding" a
+   * token is the same as looking it up.
+   *
+   * @param token The given token.
+   */
+  size_t AddToken(const Token& token) const { return Value(token); }
+
+  /**
+   * The function returns the id of the given token, i.e. its hash folded
+   * into the bucket range, plus one.
+   *
+   * @param token The given token.
+   */
+  size_t Value(const Token& token) const
+  {
+    return (size_t) (HashToken(token) % (uint64_t) numBuckets) + 1;
+  }
+
+  //! The size of the dictionary is the full bucket range.
+  size_t Size() const { return numBuckets; }
+
+  //! There is no stored state to clear.
+  void Clear() { }
+
+  //! Get the number of hash buckets.
+  size_t NumBuckets() const { return numBuckets; }
+  //! Modify the number of hash buckets.
+  size_t& NumBuckets() { return numBuckets; }
+
+  /**
+   * Serialize the class to the given archive.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(numBuckets);
+  }
+
+ private:
+  //! 64-bit FNV-1a hash of the given bytes.
+  static uint64_t Fnv1a(const unsigned char* bytes, const size_t length)
+  {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; ++i)
+    {
+      hash ^= (uint64_t) bytes[i];
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  //! Hash an arithmetic token by its value bytes.
+  template<typename T>
+  static typename std::enable_if<std::is_arithmetic<T>::value, uint64_t>::type
+  HashToken(const T& token)
+  {
+    return Fnv1a((const unsigned char*) &token, sizeof(T));
+  }
+
+  //! Hash a string-like token by its character bytes.
+  template<typename T>
+  static typename std::enable_if<!std::is_arithmetic<T>::value, uint64_t>::type
+  HashToken(const T& token)
+  {
+    return Fnv1a((const unsigned char*) token.data(), token.size());
+  }
+
+  //! Number of hash buckets.
+  size_t numBuckets;
+};
+
+} // namespace data
+} // namespace mlpack
+
+#endif
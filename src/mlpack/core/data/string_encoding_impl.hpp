@@ -20,6 +20,31 @@
 namespace mlpack {
 namespace data {
 
+namespace details {
+
+/**
+ * The type trait detects whether the given dictionary type declares itself
+ * immutable during encoding (a static boolean immutableDuringEncoding member
+ * equal to true).  Such dictionaries answer lookups without ever modifying
+ * their state, so different documents may be encoded concurrently.
+ */
+template<typename DicType>
+struct IsImmutableDictionary
+{
+ private:
+  template<typename U>
+  static typename std::enable_if<U::immutableDuringEncoding,
+      std::true_type>::type Test(int);
+
+  template<typename U>
+  static std::false_type Test(...);
+
+ public:
+  static const bool value = decltype(Test<DicType>(0))::value;
+};
+
+} // namespace details
+
 template<typename EncodingPolicyType, typename DictionaryType>
 template<typename ... ArgTypes>
 StringEncoding<EncodingPolicyType, DictionaryType>::StringEncoding(
@@ -109,6 +134,57 @@ EncodeHelper(const std::vector<std::string>& input,
 
   policy.Reset();
 
+  // If the policy encodes each token independently and the dictionary never
+  // changes while encoding, then no pass modifies any shared state and the
+  // documents can be processed in parallel.  Sparse matrices are excluded
+  // since concurrent element insertion is not safe.
+  const bool parallel = details::IsImmutableDictionary<DictionaryType>::value &&
+      StringEncodingPolicyTraits<PolicyType>::onePassEncoding &&
+      !arma::is_arma_sparse_type<MatType>::value;
+
+  if (parallel)
+  {
+    // The first pass counts the tokens of each document.
+    std::vector<size_t> tokenCounts(input.size(), 0);
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (omp_size_t i = 0; i < (omp_size_t) input.size(); ++i)
+    {
+      boost::string_view strView(input[i]);
+      auto token = tokenizer(strView);
+
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        tokenCounts[i]++;
+        token = tokenizer(strView);
+      }
+    }
+
+    for (size_t i = 0; i < input.size(); ++i)
+      numColumns = std::max(numColumns, tokenCounts[i]);
+
+    policy.InitMatrix(output, input.size(), numColumns, dictionary.Size());
+
+    // The second pass writes the encoded values; each document writes only
+    // to its own column of the output.
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (omp_size_t i = 0; i < (omp_size_t) input.size(); ++i)
+    {
+      boost::string_view strView(input[i]);
+      auto token = tokenizer(strView);
+      size_t numTokens = 0;
+
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        policy.Encode(output, dictionary.Value(token), i, numTokens);
+        token = tokenizer(strView);
+        numTokens++;
+      }
+    }
+
+    return;
+  }
+
   // The first pass adds the extracted tokens to the dictionary.
   for (size_t i = 0; i < input.size(); ++i)
   {
@@ -168,6 +244,29 @@ EncodeHelper(const std::vector<std::string>& input,
 {
   policy.Reset();
 
+  // If the dictionary never changes while encoding, then every token is
+  // already known and the documents can be encoded in parallel, each one
+  // writing only to its own line of the output.
+  if (details::IsImmutableDictionary<DictionaryType>::value)
+  {
+    output.resize(input.size());
+
+    #pragma omp parallel for schedule(dynamic, 64)
+    for (omp_size_t i = 0; i < (omp_size_t) input.size(); ++i)
+    {
+      boost::string_view strView(input[i]);
+      auto token = tokenizer(strView);
+
+      while (!tokenizer.IsTokenEmpty(token))
+      {
+        policy.Encode(output[i], dictionary.Value(token));
+        token = tokenizer(strView);
+      }
+    }
+
+    return;
+  }
+
   // The loop below extracts the tokens and writes the encoded values
   // at once.
   for (size_t i = 0; i < input.size(); ++i)
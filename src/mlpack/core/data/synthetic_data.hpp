@@ -0,0 +1,130 @@
+/**
+ * @file core/data/synthetic_data.hpp
+ * @author Ryan Curtin
+ *
+ * Parametric synthetic dataset generators.  These produce datasets with known
+ * structure at any requested size, directly into Armadillo matrices, so that
+ * scale benchmarks and tests do not need to ship or load real data.  Every
+ * generator takes an explicit seed and derives an independent random stream
+ * for each generated column from it, so the output is deterministic for a
+ * given seed regardless of how many threads the generation runs on.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SYNTHETIC_DATA_HPP
+#define MLPACK_CORE_DATA_SYNTHETIC_DATA_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace data {
+
+/**
+ * Generate a labeled mixture of spherical Gaussian clusters.  Cluster centers
+ * are placed uniformly at random in the hypercube [-separation, separation]^d
+ * and each point is drawn from a unit-variance Gaussian around the center of
+ * a uniformly chosen cluster, so the separation parameter directly controls
+ * how easy the clusters are to recover.
+ *
+ * @tparam eT Element type of the output matrix.
+ * @param dimensionality Dimensionality of the generated points.
+ * @param points Number of points to generate.
+ * @param clusters Number of Gaussian clusters.
+ * @param separation Half-width of the hypercube the centers are drawn from.
+ * @param data Matrix to store the generated points in (one per column).
+ * @param labels Vector to store the cluster index of each point in.
+ * @param seed Seed for the generation.
+ */
+template<typename eT>
+void GaussianClusters(const size_t dimensionality,
+                      const size_t points,
+                      const size_t clusters,
+                      const double separation,
+                      arma::Mat<eT>& data,
+                      arma::Row<size_t>& labels,
+                      const size_t seed = 0);
+
+/**
+ * Generate points on a random linear manifold of the given intrinsic
+ * dimensionality embedded in a higher-dimensional space, plus isotropic
+ * Gaussian noise.  Latent points are drawn from a unit Gaussian in the
+ * intrinsic space and mapped through a random Gaussian embedding matrix, so
+ * the generated dataset has (approximately) low rank with a noise floor
+ * controlled by noiseStddev.
+ *
+ * @tparam eT Element type of the output matrix.
+ * @param intrinsicDimensionality Dimensionality of the underlying manifold.
+ * @param dimensionality Dimensionality of the embedding space.
+ * @param points Number of points to generate.
+ * @param noiseStddev Standard deviation of the added ambient noise.
+ * @param data Matrix to store the generated points in (one per column).
+ * @param seed Seed for the generation.
+ */
+template<typename eT>
+void EmbeddedManifold(const size_t intrinsicDimensionality,
+                      const size_t dimensionality,
+                      const size_t points,
+                      const double noiseStddev,
+                      arma::Mat<eT>& data,
+                      const size_t seed = 0);
+
+/**
+ * Generate a sparse matrix whose column densities follow a power law, as in
+ * text or recommendation data: a few dense columns and a long tail of very
+ * sparse ones.  Column c receives max(1, maxColumnNonzeros * u^exponent)
+ * nonzeros, where u is uniform on (0, 1]; larger exponents give a heavier
+ * skew.  Nonzero positions are uniform within the column and values are
+ * uniform on (0, 1].
+ *
+ * @tparam eT Element type of the output matrix.
+ * @param rows Number of rows of the generated matrix.
+ * @param cols Number of columns of the generated matrix.
+ * @param exponent Power-law exponent of the column densities.
+ * @param maxColumnNonzeros Largest possible number of nonzeros in a column.
+ * @param data Sparse matrix to store the generated data in.
+ * @param seed Seed for the generation.
+ */
+template<typename eT>
+void PowerLawSparse(const size_t rows,
+                    const size_t cols,
+                    const double exponent,
+                    const size_t maxColumnNonzeros,
+                    arma::SpMat<eT>& data,
+                    const size_t seed = 0);
+
+/**
+ * Generate a labeled point stream with concept drift.  Each class starts as a
+ * unit-variance Gaussian at a random center and moves along a fixed random
+ * direction as the stream progresses: the point at stream position t is drawn
+ * around center + (t / points) * drift * direction.  Columns are ordered by
+ * stream position, so feeding the matrix left to right replays the drift.
+ *
+ * @tparam eT Element type of the output matrix.
+ * @param dimensionality Dimensionality of the generated points.
+ * @param points Number of points in the stream.
+ * @param numClasses Number of classes.
+ * @param drift Total distance each class center moves over the stream.
+ * @param data Matrix to store the generated points in (one per column, in
+ *     stream order).
+ * @param labels Vector to store the class of each point in.
+ * @param seed Seed for the generation.
+ */
+template<typename eT>
+void DriftingStream(const size_t dimensionality,
+                    const size_t points,
+                    const size_t numClasses,
+                    const double drift,
+                    arma::Mat<eT>& data,
+                    arma::Row<size_t>& labels,
+                    const size_t seed = 0);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "synthetic_data_impl.hpp"
+
+#endif
@@ -0,0 +1,216 @@
+/**
+ * @file core/data/synthetic_data_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the parametric synthetic dataset generators.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_SYNTHETIC_DATA_IMPL_HPP
+#define MLPACK_CORE_DATA_SYNTHETIC_DATA_IMPL_HPP
+
+#include <mlpack/core/util/parallel.hpp>
+
+// In case it hasn't been included yet.
+#include "synthetic_data.hpp"
+
+#include <random>
+
+namespace mlpack {
+namespace data {
+
+namespace details {
+
+/**
+ * Build the random stream for one generated column.  The seed and the column
+ * index are mixed through splitmix64 before seeding the engine, so that
+ * consecutive columns get well-separated streams and the output does not
+ * depend on which thread generates which column.
+ */
+inline std::mt19937_64 ColumnStream(const size_t seed, const size_t column)
+{
+  uint64_t z = (uint64_t) seed + 0x9e3779b97f4a7c15ULL * (column + 1);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return std::mt19937_64(z ^ (z >> 31));
+}
+
+} // namespace details
+
+template<typename eT>
+void GaussianClusters(const size_t dimensionality,
+                      const size_t points,
+                      const size_t clusters,
+                      const double separation,
+                      arma::Mat<eT>& data,
+                      arma::Row<size_t>& labels,
+                      const size_t seed)
+{
+  // The centers are generated serially from their own stream; there are only
+  // a few of them.
+  arma::Mat<eT> centers(dimensionality, clusters);
+  std::mt19937_64 centerStream = details::ColumnStream(seed, points);
+  std::uniform_real_distribution<double> centerDist(-separation, separation);
+  for (size_t i = 0; i < centers.n_elem; ++i)
+    centers[i] = (eT) centerDist(centerStream);
+
+  data.set_size(dimensionality, points);
+  labels.set_size(points);
+  Parallel::For(0, points, [&](const size_t i)
+  {
+    std::mt19937_64 stream = details::ColumnStream(seed, i);
+    std::uniform_int_distribution<size_t> clusterDist(0, clusters - 1);
+    std::normal_distribution<double> noise(0.0, 1.0);
+
+    const size_t cluster = clusterDist(stream);
+    labels[i] = cluster;
+    for (size_t d = 0; d < dimensionality; ++d)
+      data(d, i) = centers(d, cluster) + (eT) noise(stream);
+  });
+}
+
+template<typename eT>
+void EmbeddedManifold(const size_t intrinsicDimensionality,
+                      const size_t dimensionality,
+                      const size_t points,
+                      const double noiseStddev,
+                      arma::Mat<eT>& data,
+                      const size_t seed)
+{
+  // Generate the embedding matrix serially from its own stream.
+  arma::Mat<eT> embedding(dimensionality, intrinsicDimensionality);
+  std::mt19937_64 embeddingStream = details::ColumnStream(seed, points);
+  std::normal_distribution<double> gaussian(0.0, 1.0);
+  for (size_t i = 0; i < embedding.n_elem; ++i)
+    embedding[i] = (eT) gaussian(embeddingStream);
+
+  // Fill the latent points and the ambient noise in parallel, then lift the
+  // latent points into the embedding space with a single matrix product.
+  arma::Mat<eT> latent(intrinsicDimensionality, points);
+  data.set_size(dimensionality, points);
+  Parallel::For(0, points, [&](const size_t i)
+  {
+    std::mt19937_64 stream = details::ColumnStream(seed, i);
+    std::normal_distribution<double> latentDist(0.0, 1.0);
+    std::normal_distribution<double> noiseDist(0.0, noiseStddev);
+
+    for (size_t d = 0; d < intrinsicDimensionality; ++d)
+      latent(d, i) = (eT) latentDist(stream);
+    for (size_t d = 0; d < dimensionality; ++d)
+      data(d, i) = (eT) noiseDist(stream);
+  });
+
+  data += embedding * latent;
+}
+
+template<typename eT>
+void PowerLawSparse(const size_t rows,
+                    const size_t cols,
+                    const double exponent,
+                    const size_t maxColumnNonzeros,
+                    arma::SpMat<eT>& data,
+                    const size_t seed)
+{
+  // Generate each column independently, then assemble the matrix with the
+  // batch constructor; inserting into a sparse matrix element by element
+  // would be quadratic.
+  std::vector<std::vector<arma::uword>> colRows(cols);
+  std::vector<std::vector<eT>> colValues(cols);
+
+  Parallel::For(0, cols, [&](const size_t c)
+  {
+    std::mt19937_64 stream = details::ColumnStream(seed, c);
+    std::uniform_real_distribution<double> uniform(
+        std::numeric_limits<double>::min(), 1.0);
+    std::uniform_int_distribution<arma::uword> rowDist(0, rows - 1);
+
+    const size_t nonzeros = std::min((size_t) rows, std::max((size_t) 1,
+        (size_t) (maxColumnNonzeros * std::pow(uniform(stream), exponent))));
+
+    // Draw distinct row indices for this column.
+    std::vector<arma::uword>& rowIndices = colRows[c];
+    while (rowIndices.size() < nonzeros)
+    {
+      const arma::uword row = rowDist(stream);
+      if (std::find(rowIndices.begin(), rowIndices.end(), row) ==
+          rowIndices.end())
+        rowIndices.push_back(row);
+    }
+
+    colValues[c].resize(nonzeros);
+    for (size_t i = 0; i < nonzeros; ++i)
+      colValues[c][i] = (eT) uniform(stream);
+  });
+
+  size_t totalNonzeros = 0;
+  for (size_t c = 0; c < cols; ++c)
+    totalNonzeros += colRows[c].size();
+
+  arma::umat locations(2, totalNonzeros);
+  arma::Col<eT> values(totalNonzeros);
+  size_t loc = 0;
+  for (size_t c = 0; c < cols; ++c)
+  {
+    for (size_t i = 0; i < colRows[c].size(); ++i)
+    {
+      locations(0, loc) = colRows[c][i];
+      locations(1, loc) = c;
+      values[loc] = colValues[c][i];
+      ++loc;
+    }
+  }
+
+  data = arma::SpMat<eT>(locations, values, rows, cols);
+}
+
+template<typename eT>
+void DriftingStream(const size_t dimensionality,
+                    const size_t points,
+                    const size_t numClasses,
+                    const double drift,
+                    arma::Mat<eT>& data,
+                    arma::Row<size_t>& labels,
+                    const size_t seed)
+{
+  // Starting centers and (unit) drift directions, generated serially from
+  // their own stream.
+  arma::Mat<eT> centers(dimensionality, numClasses);
+  arma::Mat<eT> directions(dimensionality, numClasses);
+  std::mt19937_64 centerStream = details::ColumnStream(seed, points);
+  std::normal_distribution<double> gaussian(0.0, 1.0);
+  for (size_t i = 0; i < centers.n_elem; ++i)
+    centers[i] = (eT) gaussian(centerStream);
+  for (size_t c = 0; c < numClasses; ++c)
+  {
+    for (size_t d = 0; d < dimensionality; ++d)
+      directions(d, c) = (eT) gaussian(centerStream);
+    directions.col(c) /= std::max((eT) arma::norm(directions.col(c)),
+        std::numeric_limits<eT>::epsilon());
+  }
+
+  data.set_size(dimensionality, points);
+  labels.set_size(points);
+  Parallel::For(0, points, [&](const size_t i)
+  {
+    std::mt19937_64 stream = details::ColumnStream(seed, i);
+    std::uniform_int_distribution<size_t> classDist(0, numClasses - 1);
+    std::normal_distribution<double> noise(0.0, 1.0);
+
+    const size_t label = classDist(stream);
+    labels[i] = label;
+    const eT progress = (points > 1) ? (eT) i / (eT) (points - 1) : (eT) 0;
+    for (size_t d = 0; d < dimensionality; ++d)
+    {
+      data(d, i) = centers(d, label) +
+          progress * (eT) drift * directions(d, label) + (eT) noise(stream);
+    }
+  });
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
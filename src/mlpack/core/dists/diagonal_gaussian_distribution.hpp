@@ -132,6 +132,12 @@ class DiagonalGaussianDistribution
   //! Return the covariance matrix.
   const arma::vec& Covariance() const { return covariance; }
 
+  //! Return the cached inverse of the diagonal covariance.
+  const arma::vec& InvCov() const { return invCov; }
+
+  //! Return the cached log-determinant of the covariance.
+  double LogDetCov() const { return logDetCov; }
+
   //! Set the covariance matrix.
   void Covariance(const arma::vec& covariance);
 
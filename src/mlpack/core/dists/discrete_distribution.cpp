@@ -50,6 +50,69 @@ arma::vec DiscreteDistribution::Random() const
   return result;
 }
 
+/**
+ * Compute the matrix of log probabilities of each observation under each of
+ * the given distributions.
+ */
+void DiscreteDistribution::LogProbability(
+    const arma::mat& x,
+    const std::vector<DiscreteDistribution>& distributions,
+    arma::mat& logProbabilities)
+{
+  logProbabilities.zeros(distributions.size(), x.n_cols);
+  if (distributions.empty())
+    return;
+
+  // Ensure every distribution has the dimensionality of the observations.
+  for (size_t d = 0; d < distributions.size(); ++d)
+  {
+    if (distributions[d].Dimensionality() != x.n_rows)
+    {
+      Log::Fatal << "DiscreteDistribution::LogProbability(): distribution "
+          << d << " has dimensionality " << distributions[d].Dimensionality()
+          << " but the observations have dimension " << x.n_rows << "!"
+          << std::endl;
+    }
+  }
+
+  for (size_t dimension = 0; dimension < x.n_rows; ++dimension)
+  {
+    // Gather the log probability tables of all the distributions for this
+    // dimension into one matrix, so that each observation resolves to a
+    // single contiguous column of log probabilities.
+    const size_t numObs = distributions[0].Probabilities(dimension).n_elem;
+    arma::mat logTable(distributions.size(), numObs);
+    for (size_t d = 0; d < distributions.size(); ++d)
+    {
+      if (distributions[d].Probabilities(dimension).n_elem != numObs)
+      {
+        Log::Fatal << "DiscreteDistribution::LogProbability(): distribution "
+            << d << " has " << distributions[d].Probabilities(dimension).n_elem
+            << " possible observations in dimension " << dimension << ", but "
+            << "distribution 0 has " << numObs << "; all distributions must "
+            << "have the same number of possible observations!" << std::endl;
+      }
+      logTable.row(d) = arma::log(distributions[d].Probabilities(dimension)).t();
+    }
+
+    for (size_t i = 0; i < x.n_cols; ++i)
+    {
+      // Adding 0.5 helps ensure that we cast the floating point to a size_t
+      // correctly.
+      const size_t obs = size_t(x(dimension, i) + 0.5);
+
+      // Ensure that the observation is within the bounds.
+      if (obs >= numObs)
+      {
+        Log::Fatal << "DiscreteDistribution::LogProbability(): received "
+            << "observation " << obs << "; observation must be in [0, "
+            << numObs << "] for these distributions." << std::endl;
+      }
+      logProbabilities.col(i) += logTable.unsafe_col(obs);
+    }
+  }
+}
+
 /**
  * Estimate the probability distribution directly from the given observations.
  */
@@ -178,9 +178,8 @@ class DiscreteDistribution
    */
   void Probability(const arma::mat& x, arma::vec& probabilities) const
   {
-    probabilities.set_size(x.n_cols);
-    for (size_t i = 0; i < x.n_cols; ++i)
-      probabilities(i) = Probability(x.unsafe_col(i));
+    LogProbability(x, probabilities);
+    probabilities = exp(probabilities);
   }
 
   /**
@@ -193,11 +192,61 @@ class DiscreteDistribution
    */
   void LogProbability(const arma::mat& x, arma::vec& logProbabilities) const
   {
-    logProbabilities.set_size(x.n_cols);
-    for (size_t i = 0; i < x.n_cols; ++i)
-      logProbabilities(i) = log(Probability(x.unsafe_col(i)));
+    // Ensure the observations have the same dimension as the probabilities.
+    if (x.n_rows != probabilities.size())
+    {
+      Log::Fatal << "DiscreteDistribution::LogProbability(): observations "
+          << "have incorrect dimension " << x.n_rows << " but should have"
+          << " dimension " << probabilities.size() << "!" << std::endl;
+    }
+
+    logProbabilities.zeros(x.n_cols);
+    for (size_t dimension = 0; dimension < x.n_rows; ++dimension)
+    {
+      // Take the logarithm of the probability table once, so each observation
+      // only costs a table lookup and an addition.
+      const arma::vec logTable = arma::log(probabilities[dimension]);
+      for (size_t i = 0; i < x.n_cols; ++i)
+      {
+        // Adding 0.5 helps ensure that we cast the floating point to a size_t
+        // correctly.
+        const size_t obs = size_t(x(dimension, i) + 0.5);
+
+        // Ensure that the observation is within the bounds.
+        if (obs >= logTable.n_elem)
+        {
+          Log::Fatal << "DiscreteDistribution::LogProbability(): received "
+              << "observation " << obs << "; observation must be in [0, "
+              << logTable.n_elem << "] for this distribution." << std::endl;
+        }
+        logProbabilities[i] += logTable[obs];
+      }
+    }
   }
 
+  /**
+   * Compute the matrix of log probabilities of each observation (column) of
+   * the given matrix under each of the given distributions, so that
+   * logProbabilities(d, i) is the log probability of the i'th observation
+   * under the d'th distribution.  All of the distributions must have the same
+   * dimensionality and number of possible observations.
+   *
+   * This fills the whole matrix in a single pass over the observations by
+   * gathering from the distributions' log probability tables, which is much
+   * faster than one Probability() call per distribution per observation (as,
+   * e.g., the forward-backward recursions of a discrete HMM would otherwise
+   * do).
+   *
+   * @param x List of observations.
+   * @param distributions Distributions to compute log probabilities under.
+   * @param logProbabilities Output log-probability matrix; each row
+   *    corresponds to a distribution and each column to an observation.
+   */
+  static void LogProbability(const arma::mat& x,
+                             const std::vector<DiscreteDistribution>&
+                                 distributions,
+                             arma::mat& logProbabilities);
+
   /**
    * Return a randomly generated observation (one-dimensional vector; one
    * observation) according to the probability distribution defined by this
@@ -11,9 +11,12 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include "gamma_distribution.hpp"
+#include <mlpack/core/util/parallel.hpp>
 #include <boost/math/special_functions/trigamma.hpp>
 #include <boost/math/special_functions/polygamma.hpp>
 
+#include <algorithm>
+
 using namespace mlpack;
 using namespace mlpack::distribution;
 
@@ -55,9 +58,33 @@ void GammaDistribution::Train(const arma::mat& rdata, const double tol)
   if (arma::size(rdata) == arma::size(arma::mat()))
     return;
 
+  // Accumulate sum(log(x)) and sum(x) of each dataset row over column
+  // chunks, with each thread accumulating its own partial sums.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (rdata.n_cols + blockSize - 1) / blockSize;
+
+  typedef std::pair<arma::vec, arma::vec> PartialType;
+  const PartialType identity(arma::zeros<arma::vec>(rdata.n_rows),
+                             arma::zeros<arma::vec>(rdata.n_rows));
+
+  PartialType sums = Parallel::ReduceFor(numBlocks, identity,
+      [&](PartialType& partial, const size_t block)
+      {
+        const size_t begin = block * blockSize;
+        const size_t end = std::min(rdata.n_cols, begin + blockSize) - 1;
+
+        partial.first += arma::sum(arma::log(rdata.cols(begin, end)), 1);
+        partial.second += arma::sum(rdata.cols(begin, end), 1);
+      },
+      [](PartialType& to, const PartialType& from)
+      {
+        to.first += from.first;
+        to.second += from.second;
+      });
+
   // Calculate log(mean(x)) and mean(log(x)) of each dataset row.
-  const arma::vec meanLogxVec = arma::mean(arma::log(rdata), 1);
-  const arma::vec meanxVec = arma::mean(rdata, 1);
+  const arma::vec meanLogxVec = sums.first / rdata.n_cols;
+  const arma::vec meanxVec = sums.second / rdata.n_cols;
   const arma::vec logMeanxVec = arma::log(meanxVec);
 
   // Call the statistics-only GammaDistribution::Train() function to fit the
@@ -74,21 +101,37 @@ void GammaDistribution::Train(const arma::mat& rdata,
   if (arma::size(rdata) == arma::size(arma::mat()))
     return;
 
-  arma::vec meanLogxVec(rdata.n_rows, arma::fill::zeros);
-  arma::vec meanxVec(rdata.n_rows, arma::fill::zeros);
-  arma::vec logMeanxVec(rdata.n_rows, arma::fill::zeros);
-
-  for (size_t i = 0; i < rdata.n_cols; ++i)
-  {
-    meanLogxVec += probabilities(i) * arma::log(rdata.col(i));
-    meanxVec += probabilities(i) * rdata.col(i);
-  }
+  // Accumulate the probability-weighted statistics over column chunks, with
+  // each thread accumulating its own partial sums.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (rdata.n_cols + blockSize - 1) / blockSize;
+
+  typedef std::pair<arma::vec, arma::vec> PartialType;
+  const PartialType identity(arma::zeros<arma::vec>(rdata.n_rows),
+                             arma::zeros<arma::vec>(rdata.n_rows));
+
+  PartialType sums = Parallel::ReduceFor(numBlocks, identity,
+      [&](PartialType& partial, const size_t block)
+      {
+        const size_t begin = block * blockSize;
+        const size_t end = std::min(rdata.n_cols, begin + blockSize) - 1;
+
+        partial.first += arma::log(rdata.cols(begin, end)) *
+            probabilities.subvec(begin, end);
+        partial.second += rdata.cols(begin, end) *
+            probabilities.subvec(begin, end);
+      },
+      [](PartialType& to, const PartialType& from)
+      {
+        to.first += from.first;
+        to.second += from.second;
+      });
 
   double totProbability = arma::accu(probabilities);
 
-  meanLogxVec /= totProbability;
-  meanxVec /= totProbability;
-  logMeanxVec = arma::log(meanxVec);
+  const arma::vec meanLogxVec = sums.first / totProbability;
+  const arma::vec meanxVec = sums.second / totProbability;
+  const arma::vec logMeanxVec = arma::log(meanxVec);
 
   // Call the statistics-only GammaDistribution::Train() function to fit the
   // parameters. That function does all the work so we're done.
@@ -159,6 +202,76 @@ void GammaDistribution::Train(const arma::vec& logMeanxVec,
   }
 }
 
+// Fits one distribution per group from a single pass over labeled data.
+void GammaDistribution::Train(const arma::mat& rdata,
+                              const arma::Row<size_t>& labels,
+                              const size_t numGroups,
+                              std::vector<GammaDistribution>& distributions,
+                              const double tol)
+{
+  if (labels.n_elem != rdata.n_cols)
+    throw std::invalid_argument("GammaDistribution::Train(): number of labels "
+        "does not match number of observations!");
+  if (rdata.n_cols > 0 && labels.max() >= numGroups)
+    throw std::invalid_argument("GammaDistribution::Train(): labels must be "
+        "in the range [0, numGroups)!");
+
+  // Accumulate the per-group sufficient statistics (sum(log(x)), sum(x) and
+  // count) in one scan over the columns, processed in chunks distributed
+  // across threads.
+  struct GroupStats
+  {
+    arma::mat sumLogx;
+    arma::mat sumx;
+    arma::vec counts;
+  };
+
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (rdata.n_cols + blockSize - 1) / blockSize;
+
+  GroupStats identity;
+  identity.sumLogx = arma::zeros<arma::mat>(rdata.n_rows, numGroups);
+  identity.sumx = arma::zeros<arma::mat>(rdata.n_rows, numGroups);
+  identity.counts = arma::zeros<arma::vec>(numGroups);
+
+  GroupStats stats = Parallel::ReduceFor(numBlocks, identity,
+      [&](GroupStats& partial, const size_t block)
+      {
+        const size_t begin = block * blockSize;
+        const size_t end = std::min(rdata.n_cols, begin + blockSize);
+
+        for (size_t i = begin; i < end; ++i)
+        {
+          const size_t group = labels[i];
+          partial.sumLogx.col(group) += arma::log(rdata.col(i));
+          partial.sumx.col(group) += rdata.col(i);
+          partial.counts[group] += 1.0;
+        }
+      },
+      [](GroupStats& to, const GroupStats& from)
+      {
+        to.sumLogx += from.sumLogx;
+        to.sumx += from.sumx;
+        to.counts += from.counts;
+      });
+
+  // Now fit each group from its own statistics; this works on a handful of
+  // numbers per group, so its cost is independent of the data size.
+  distributions.assign(numGroups, GammaDistribution(rdata.n_rows));
+  for (size_t g = 0; g < numGroups; ++g)
+  {
+    // Groups with no points keep their zero-initialized parameters.
+    if (stats.counts[g] == 0.0)
+      continue;
+
+    const arma::vec meanLogxVec = stats.sumLogx.col(g) / stats.counts[g];
+    const arma::vec meanxVec = stats.sumx.col(g) / stats.counts[g];
+    const arma::vec logMeanxVec = arma::log(meanxVec);
+
+    distributions[g].Train(logMeanxVec, meanLogxVec, meanxVec, tol);
+  }
+}
+
 // Returns the probability of the provided observations.
 void GammaDistribution::Probability(const arma::mat& observations,
                                     arma::vec& probabilities) const
@@ -126,6 +126,33 @@ class GammaDistribution
              const arma::vec& meanxVec,
              const double tol = 1e-8);
 
+  /**
+   * Fit one Gamma distribution per group from a single pass over shared,
+   * labeled data.  The sufficient statistics of every group are accumulated
+   * in one parallel scan over the columns of the data, and each group's
+   * parameters are then fit from its own statistics, so fitting many
+   * distributions costs one traversal of the data instead of one Train()
+   * call (and one pass) per group.
+   *
+   * On return, distributions[g] is the distribution fit to the columns with
+   * label g.  Groups with no points are left with zero-initialized
+   * parameters.
+   *
+   * @param rdata Reference data to fit parameters to, one observation per
+   *     column.
+   * @param labels Group label of each observation, in [0, numGroups).
+   * @param numGroups Number of groups (distributions to fit).
+   * @param distributions Vector that the fitted distributions are stored in.
+   * @param tol Convergence tolerance. This is *not* an absolute measure:
+   *    It will stop the approximation once the *change* in the value is
+   *    smaller than tol.
+   */
+  static void Train(const arma::mat& rdata,
+                    const arma::Row<size_t>& labels,
+                    const size_t numGroups,
+                    std::vector<GammaDistribution>& distributions,
+                    const double tol = 1e-8);
+
   /**
    * This function returns the probability of a group of observations.
    *
@@ -101,23 +101,47 @@ void GaussianDistribution::Train(const arma::mat& observations)
     return;
   }
 
-  // Calculate the mean.
-  for (size_t i = 0; i < observations.n_cols; ++i)
-    mean += observations.col(i);
+  // Accumulate the sufficient statistics (sum of the observations and their
+  // scatter matrix) in a single blocked pass: each block contributes one
+  // rank-k update computed as a matrix product, and per-thread partial
+  // statistics are merged at the end.
+  const size_t blockSize = 256;
+  const size_t numBlocks = (observations.n_cols + blockSize - 1) / blockSize;
 
-  // Normalize the mean.
-  mean /= observations.n_cols;
+  arma::mat scatter(observations.n_rows, observations.n_rows,
+      arma::fill::zeros);
 
-  // Now calculate the covariance.
-  for (size_t i = 0; i < observations.n_cols; ++i)
+  #pragma omp parallel
   {
-    arma::vec obsNoMean = observations.col(i) - mean;
-    covariance += obsNoMean * trans(obsNoMean);
+    arma::vec localMean(observations.n_rows, arma::fill::zeros);
+    arma::mat localScatter(observations.n_rows, observations.n_rows,
+        arma::fill::zeros);
+
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+    {
+      const size_t begin = b * blockSize;
+      const size_t end = std::min(begin + blockSize,
+          (size_t) observations.n_cols);
+
+      localMean += arma::sum(observations.cols(begin, end - 1), 1);
+      localScatter += observations.cols(begin, end - 1) *
+          arma::trans(observations.cols(begin, end - 1));
+    }
+
+    #pragma omp critical (GaussianDistributionTrain)
+    {
+      mean += localMean;
+      scatter += localScatter;
+    }
   }
 
-  // Finish estimating the covariance by normalizing, with the (1 / (n - 1)) so
-  // that it is the unbiased estimator.
-  covariance /= (observations.n_cols - 1);
+  // Normalize the mean, then remove its contribution from the scatter matrix,
+  // normalizing with (1 / (n - 1)) so that the covariance is the unbiased
+  // estimator.
+  mean /= observations.n_cols;
+  covariance = (scatter - observations.n_cols * (mean * arma::trans(mean))) /
+      (observations.n_cols - 1);
 
   // Ensure that the covariance is positive definite.
   gmm::PositiveDefiniteConstraint::ApplyConstraint(covariance);
@@ -148,12 +172,45 @@ void GaussianDistribution::Train(const arma::mat& observations,
 
   double sumProb = 0;
 
-  // First calculate the mean, and save the sum of all the probabilities for
-  // later normalization.
-  for (size_t i = 0; i < observations.n_cols; ++i)
+  // Accumulate the weighted sufficient statistics (weighted sum, weighted
+  // scatter matrix and total weight) in a single blocked pass; each block is
+  // one matrix product and per-thread partial statistics are merged at the
+  // end.
+  const size_t blockSize = 256;
+  const size_t numBlocks = (observations.n_cols + blockSize - 1) / blockSize;
+
+  arma::mat scatter(observations.n_rows, observations.n_rows,
+      arma::fill::zeros);
+
+  #pragma omp parallel
   {
-    mean += probabilities[i] * observations.col(i);
-    sumProb += probabilities[i];
+    arma::vec localMean(observations.n_rows, arma::fill::zeros);
+    arma::mat localScatter(observations.n_rows, observations.n_rows,
+        arma::fill::zeros);
+    double localSumProb = 0;
+
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+    {
+      const size_t begin = b * blockSize;
+      const size_t end = std::min(begin + blockSize,
+          (size_t) observations.n_cols);
+
+      const arma::mat block = observations.cols(begin, end - 1);
+      const arma::rowvec blockProb =
+          arma::trans(probabilities.subvec(begin, end - 1));
+
+      localMean += block * arma::trans(blockProb);
+      localScatter += (block.each_row() % blockProb) * arma::trans(block);
+      localSumProb += arma::accu(blockProb);
+    }
+
+    #pragma omp critical (GaussianDistributionTrain)
+    {
+      mean += localMean;
+      scatter += localScatter;
+      sumProb += localSumProb;
+    }
   }
 
   if (sumProb == 0)
@@ -165,20 +222,11 @@ void GaussianDistribution::Train(const arma::mat& observations,
     return;
   }
 
-  // Normalize.
-  if (sumProb > 0)
-    mean /= sumProb;
-
-  // Now find the covariance.
-  for (size_t i = 0; i < observations.n_cols; ++i)
-  {
-    arma::vec obsNoMean = observations.col(i) - mean;
-    covariance += probabilities[i] * (obsNoMean * trans(obsNoMean));
-  }
+  // Normalize the mean, then remove its contribution from the scatter matrix.
+  mean /= sumProb;
 
   // This is probably biased, but I don't know how to unbias it.
-  if (sumProb > 0)
-    covariance /= sumProb;
+  covariance = (scatter - sumProb * (mean * arma::trans(mean))) / sumProb;
 
   // Ensure that the covariance is positive definite.
   gmm::PositiveDefiniteConstraint::ApplyConstraint(covariance);
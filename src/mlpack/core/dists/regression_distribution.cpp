@@ -65,6 +65,86 @@ double RegressionDistribution::Probability(const arma::vec& observation) const
   return err.Probability(observation(0)-fitted.t());
 }
 
+/**
+ * Evaluate probability density function at each observation of the given
+ * matrix.
+ */
+void RegressionDistribution::Probability(const arma::mat& observations,
+                                         arma::vec& probabilities) const
+{
+  LogProbability(observations, probabilities);
+  probabilities = exp(probabilities);
+}
+
+/**
+ * Evaluate log probability density function at each observation of the given
+ * matrix.
+ */
+void RegressionDistribution::LogProbability(const arma::mat& observations,
+                                            arma::vec& logProbabilities) const
+{
+  // Fit all observations with one prediction call, then evaluate all the
+  // residuals under the error distribution with one batched call.
+  arma::rowvec fitted;
+  rf.Predict(observations.rows(1, observations.n_rows - 1), fitted);
+  const arma::mat residuals = observations.row(0) - fitted;
+  err.LogProbability(residuals, logProbabilities);
+}
+
+/**
+ * Evaluate the log probability density functions of many regression
+ * distributions at each observation of the given matrix.
+ */
+void RegressionDistribution::LogProbability(
+    const arma::mat& x,
+    const std::vector<RegressionDistribution>& distributions,
+    arma::mat& logProbabilities)
+{
+  const size_t states = distributions.size();
+  logProbabilities.set_size(states, x.n_cols);
+  if (states == 0)
+    return;
+
+  const arma::mat& predictors = x.rows(1, x.n_rows - 1);
+
+  // Stack each distribution's regression coefficients into one row of slopes
+  // plus an intercept, and collect the per-distribution error variances.
+  arma::mat slopes(states, predictors.n_rows);
+  arma::vec intercepts(states);
+  arma::vec invVariances(states);
+  arma::vec logNormalizers(states);
+  for (size_t state = 0; state < states; ++state)
+  {
+    const arma::vec& parameters = distributions[state].Parameters();
+    if (parameters.n_elem == predictors.n_rows + 1)
+    {
+      // The first element is the intercept.
+      intercepts(state) = parameters(0);
+      slopes.row(state) = parameters.subvec(1, parameters.n_elem - 1).t();
+    }
+    else
+    {
+      intercepts(state) = 0.0;
+      slopes.row(state) = parameters.t();
+    }
+
+    const double variance = distributions[state].Err().Covariance()(0, 0);
+    invVariances(state) = -0.5 / variance;
+    logNormalizers(state) = -0.5 * std::log(2.0 * M_PI * variance);
+  }
+
+  // One GEMM gives the fitted values of every distribution over the whole
+  // sequence; the residuals only enter the densities squared, so the sign of
+  // (fitted - response) does not matter.
+  logProbabilities = slopes * predictors;
+  logProbabilities.each_col() += intercepts;
+  logProbabilities.each_row() -= x.row(0);
+
+  logProbabilities = arma::square(logProbabilities);
+  logProbabilities.each_col() %= invVariances;
+  logProbabilities.each_col() += logNormalizers;
+}
+
 void RegressionDistribution::Predict(const arma::mat& points,
                                      arma::vec& predictions) const
 {
@@ -132,6 +132,50 @@ class RegressionDistribution
     return log(Probability(observation));
   }
 
+  /**
+   * Evaluate probability density function at each observation (column) of the
+   * given matrix.  The regression predictions for all observations are
+   * computed with a single call, which is much faster than evaluating each
+   * observation separately.
+   *
+   * @param observations List of observations.
+   * @param probabilities Output probabilities for each observation.
+   */
+  void Probability(const arma::mat& observations,
+                   arma::vec& probabilities) const;
+
+  /**
+   * Evaluate log probability density function at each observation (column) of
+   * the given matrix.  The regression predictions for all observations are
+   * computed with a single call, which is much faster than evaluating each
+   * observation separately.
+   *
+   * @param observations List of observations.
+   * @param logProbabilities Output log-probabilities for each observation.
+   */
+  void LogProbability(const arma::mat& observations,
+                      arma::vec& logProbabilities) const;
+
+  /**
+   * Evaluate the log probability density functions of many regression
+   * distributions at each observation (column) of the given matrix.  The
+   * regression coefficients of all distributions are stacked into one matrix,
+   * so the fitted values for every distribution over the whole sequence are
+   * computed with a single matrix product and the Gaussian densities of the
+   * residuals are evaluated vectorized (this is what the emission evaluation
+   * of an HMM regression model would otherwise do state by state).
+   *
+   * @param x List of observations, with the response in the first row and
+   *    the predictors in the remaining rows.
+   * @param distributions Distributions to compute log probabilities under.
+   * @param logProbabilities Output log-probability matrix; each row
+   *    corresponds to a distribution and each column to an observation.
+   */
+  static void LogProbability(const arma::mat& x,
+                             const std::vector<RegressionDistribution>&
+                                 distributions,
+                             arma::mat& logProbabilities);
+
   /**
    * Calculate y_i for each data point in points.
    *
@@ -119,9 +119,17 @@ double CVFunction<CVType, MLAlgorithm, TotalArgs, BoundArgs...>::Evaluate(
 {
   double objective = cv.Evaluate(args...);
 
-  // Change the best model if we have got a better score, or if we probably
-  // have not assigned any valid (trained) model yet.
-  if (bestObjective > objective ||
+  // Change the best model if we have got a score at least as good, or if we
+  // probably have not assigned any valid (trained) model yet.  Ties keep the
+  // most recently evaluated model, so that an optimizer that evaluates
+  // configurations concurrently (like ParallelGridSearch) can re-evaluate the
+  // winning configuration sequentially afterwards and be sure the best model
+  // comes from that final run.  The update is guarded since concurrent
+  // evaluations may reach it at the same time; the guard shares its name with
+  // the one around model publication in the cross-validation classes, so the
+  // model is not replaced while we are moving from it.
+  #pragma omp critical (cvModel)
+  if (bestObjective >= objective ||
       bestObjective == std::numeric_limits<double>::max())
   {
     bestObjective = objective;
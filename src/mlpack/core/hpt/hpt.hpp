@@ -14,6 +14,7 @@
 
 #include <mlpack/core/cv/meta_info_extractor.hpp>
 #include <mlpack/core/hpt/deduce_hp_types.hpp>
+#include <mlpack/core/hpt/parallel_grid_search.hpp>
 #include <ensmallen.hpp>
 
 namespace mlpack {
@@ -71,8 +72,8 @@ namespace hpt {
  * @tparam Metric A metric to assess the quality of a trained model.
  * @tparam CV A cross-validation strategy used to assess a set of
  *     hyper-parameters.
- * @tparam OptimizerType An optimization strategy (GridSearch and
- *     GradientDescent are supported).
+ * @tparam OptimizerType An optimization strategy (GridSearch,
+ *     hpt::ParallelGridSearch and GradientDescent are supported).
  * @tparam MatType The type of data.
  * @tparam PredictionsType The type of predictions (should be passed when the
  *     predictions type is a template parameter in Train methods of the given
@@ -0,0 +1,92 @@
+/**
+ * @file core/hpt/parallel_grid_search.hpp
+ *
+ * Grid search and random search over hyper-parameter configurations with
+ * concurrent evaluation of candidates.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_PARALLEL_GRID_SEARCH_HPP
+#define MLPACK_CORE_HPT_PARALLEL_GRID_SEARCH_HPP
+
+#include <mlpack/core.hpp>
+
+namespace mlpack {
+namespace hpt {
+
+/**
+ * A drop-in replacement for ens::GridSearch in HyperParameterTuner that
+ * evaluates candidate configurations concurrently.
+ *
+ * The candidate configurations of a grid are completely independent of each
+ * other, so they are distributed over the available threads with a dynamic
+ * schedule (slow configurations do not stall the rest of the sweep).  Setting
+ * MaxTrials() to a nonzero value turns the full sweep into a random search:
+ * a uniform sample of up to that many distinct grid points is evaluated
+ * instead of the whole grid.
+ *
+ * After the concurrent sweep the best configuration is evaluated once more
+ * sequentially.  This keeps the state of function objects that track the best
+ * model they have seen (such as CVFunction) consistent with the returned
+ * configuration.
+ *
+ * The given function's Evaluate() method must be safe to call from several
+ * threads at once; the cross-validation wrappers in mlpack satisfy this.
+ *
+ * @code
+ * HyperParameterTuner<LARS, MSE, SimpleCV, ParallelGridSearch>
+ *     tuner(validationSize, xs, ys);
+ * tuner.Optimizer().MaxTrials() = 100; // Random search over 100 grid points.
+ * @endcode
+ */
+class ParallelGridSearch
+{
+ public:
+  /**
+   * Construct a parallel grid search optimizer.
+   *
+   * @param maxTrials If nonzero and less than the grid size, evaluate only up
+   *     to this many randomly chosen grid points (random search).
+   */
+  ParallelGridSearch(const size_t maxTrials = 0) : maxTrials(maxTrials) {}
+
+  //! Get the maximum number of configurations to try (0 means the full grid).
+  size_t MaxTrials() const { return maxTrials; }
+  //! Modify the maximum number of configurations to try.
+  size_t& MaxTrials() { return maxTrials; }
+
+  /**
+   * Find the configuration of the given grid that minimizes the given
+   * function.  The interface matches ens::GridSearch::Optimize(): categorical
+   * dimensions are swept over all of their categories, while numeric
+   * dimensions keep the values passed in bestParameters.
+   *
+   * @param function Function to minimize; its Evaluate() method must be safe
+   *     for concurrent invocation.
+   * @param bestParameters Variable for the best configuration to be stored in.
+   * @param categoricalDimensions Whether each dimension is categorical.
+   * @param numCategories Number of categories in each categorical dimension.
+   * @return The minimum objective found.
+   */
+  template<typename FunctionType, typename MatType>
+  typename MatType::elem_type Optimize(
+      FunctionType& function,
+      MatType& bestParameters,
+      const std::vector<bool>& categoricalDimensions,
+      const arma::Row<size_t>& numCategories);
+
+ private:
+  //! The maximum number of configurations to evaluate (0 means no limit).
+  size_t maxTrials;
+};
+
+} // namespace hpt
+} // namespace mlpack
+
+// Include implementation
+#include "parallel_grid_search_impl.hpp"
+
+#endif
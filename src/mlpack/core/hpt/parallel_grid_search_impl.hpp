@@ -0,0 +1,115 @@
+/**
+ * @file core/hpt/parallel_grid_search_impl.hpp
+ *
+ * Implementation of the ParallelGridSearch optimizer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_HPT_PARALLEL_GRID_SEARCH_IMPL_HPP
+#define MLPACK_CORE_HPT_PARALLEL_GRID_SEARCH_IMPL_HPP
+
+namespace mlpack {
+namespace hpt {
+
+template<typename FunctionType, typename MatType>
+typename MatType::elem_type ParallelGridSearch::Optimize(
+    FunctionType& function,
+    MatType& bestParameters,
+    const std::vector<bool>& categoricalDimensions,
+    const arma::Row<size_t>& numCategories)
+{
+  typedef typename MatType::elem_type ElemType;
+
+  // Collect the categorical dimensions; these span the grid.  Numeric
+  // dimensions keep the values passed in bestParameters.
+  std::vector<size_t> catDims;
+  size_t gridSize = 1;
+  for (size_t d = 0; d < categoricalDimensions.size(); ++d)
+  {
+    if (!categoricalDimensions[d])
+      continue;
+
+    if (numCategories[d] == 0)
+    {
+      std::ostringstream oss;
+      oss << "ParallelGridSearch::Optimize(): the categorical dimension " << d
+          << " has no categories" << std::endl;
+      throw std::invalid_argument(oss.str());
+    }
+
+    catDims.push_back(d);
+    gridSize *= numCategories[d];
+  }
+
+  // Without categorical dimensions there is only one configuration to try.
+  if (catDims.empty())
+    return function.Evaluate(bestParameters);
+
+  // Decide which grid points to evaluate: the full grid, or a uniform sample
+  // of maxTrials distinct points (random search).
+  arma::uvec trials;
+  if (maxTrials > 0 && maxTrials < gridSize)
+    math::ObtainDistinctSamples(0, gridSize, maxTrials, trials);
+  else
+    trials = arma::linspace<arma::uvec>(0, gridSize - 1, gridSize);
+
+  arma::Col<ElemType> objectives(trials.n_elem);
+
+  // The candidates are independent, so they are distributed over the
+  // available threads; the dynamic schedule acts as a work queue, so a slow
+  // configuration does not stall the remaining ones.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t t = 0; t < (omp_size_t) trials.n_elem; ++t)
+  {
+    // Decode the mixed-radix grid index into a parameter vector.
+    MatType parameters = bestParameters;
+    size_t index = trials[t];
+    for (size_t i = 0; i < catDims.size(); ++i)
+    {
+      parameters(catDims[i]) = (ElemType)(index % numCategories[catDims[i]]);
+      index /= numCategories[catDims[i]];
+    }
+
+    objectives[t] = function.Evaluate(parameters);
+  }
+
+  // Select the best configuration, ignoring invalid objectives.
+  size_t bestTrial = trials.n_elem;
+  ElemType bestObjective = std::numeric_limits<ElemType>::max();
+  for (size_t t = 0; t < trials.n_elem; ++t)
+  {
+    if (!std::isnan(objectives[t]) && !std::isinf(objectives[t]) &&
+        objectives[t] < bestObjective)
+    {
+      bestObjective = objectives[t];
+      bestTrial = t;
+    }
+  }
+
+  if (bestTrial == trials.n_elem)
+  {
+    Log::Warn << "ParallelGridSearch::Optimize(): no configuration produced a "
+        << "valid objective!" << std::endl;
+    return bestObjective;
+  }
+
+  size_t index = trials[bestTrial];
+  for (size_t i = 0; i < catDims.size(); ++i)
+  {
+    bestParameters(catDims[i]) = (ElemType)(index % numCategories[catDims[i]]);
+    index /= numCategories[catDims[i]];
+  }
+
+  // Evaluate the winning configuration once more, sequentially.  For function
+  // objects that track the best model they have seen (such as CVFunction)
+  // this restores a consistent model after the concurrent sweep.
+  return function.Evaluate(bestParameters);
+}
+
+} // namespace hpt
+} // namespace mlpack
+
+#endif
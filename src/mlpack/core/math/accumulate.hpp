@@ -0,0 +1,58 @@
+/**
+ * @file core/math/accumulate.hpp
+ * @author Ryan Curtin
+ *
+ * Accumulate an Armadillo expression into a double regardless of the
+ * expression's element type.  When methods are used with single-precision
+ * data (e.g. MatType = arma::fmat), sums over many points can lose enough
+ * precision to destabilize objective functions; AccuDouble() keeps the
+ * elementwise work in the native type but performs the final reduction with a
+ * double accumulator.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_ACCUMULATE_HPP
+#define MLPACK_CORE_MATH_ACCUMULATE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Accumulate the given expression into a double.  The expression already has
+ * double-precision elements, so a plain accu() suffices.
+ */
+template<typename ExprType>
+typename std::enable_if<
+    std::is_same<typename ExprType::elem_type, double>::value, double>::type
+AccuDouble(const ExprType& expr)
+{
+  return arma::accu(expr);
+}
+
+/**
+ * Accumulate the given expression into a double.  The expression has a
+ * narrower element type, so evaluate it in the native type and then reduce
+ * with a double accumulator, so that the precision of the sum does not depend
+ * on the element type.
+ */
+template<typename ExprType>
+typename std::enable_if<
+    !std::is_same<typename ExprType::elem_type, double>::value, double>::type
+AccuDouble(const ExprType& expr)
+{
+  const arma::Mat<typename ExprType::elem_type> result(expr);
+  double total = 0.0;
+  for (arma::uword i = 0; i < result.n_elem; ++i)
+    total += (double) result[i];
+  return total;
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif
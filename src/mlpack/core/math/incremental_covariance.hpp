@@ -0,0 +1,155 @@
+/**
+ * @file core/math/incremental_covariance.hpp
+ * @author Ryan Curtin
+ *
+ * IncrementalCovariance incrementally computes the same quantity as
+ * ColumnCovariance(X), but from a stream of column chunks, so that the full
+ * matrix never needs to be in memory at once.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_INCREMENTAL_COVARIANCE_HPP
+#define MLPACK_CORE_MATH_INCREMENTAL_COVARIANCE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Incrementally computed mean and covariance of the columns of a dataset.
+ * Chunks of columns are folded in one at a time with Update(), using Chan et
+ * al.'s numerically stable merging of partial statistics, so fitting is a
+ * single streaming pass over data of any size.  Two objects can also be
+ * combined with Merge(), so chunks may be processed in parallel (or on
+ * different machines) and their statistics merged afterwards.
+ *
+ * After any sequence of updates and merges, Covariance() returns exactly what
+ * ColumnCovariance() would return for the concatenation of all of the chunks
+ * (up to floating-point round-off).
+ *
+ * @code
+ * @article{Chan1983,
+ *   author  = {Chan, T. F. and Golub, G. H. and LeVeque, R. J.},
+ *   title   = {Algorithms for Computing the Sample Variance: Analysis and
+ *              Recommendations},
+ *   journal = {The American Statistician},
+ *   volume  = {37},
+ *   number  = {3},
+ *   year    = {1983},
+ * }
+ * @endcode
+ *
+ * @tparam eT Element type of the data (double or float).
+ */
+template<typename eT = double>
+class IncrementalCovariance
+{
+ public:
+  //! Create the object with no observations.
+  IncrementalCovariance() : count(0) { }
+
+  /**
+   * Fold a chunk of columns into the statistics.
+   *
+   * @param chunk Matrix whose columns are the new observations.
+   */
+  void Update(const arma::Mat<eT>& chunk)
+  {
+    if (chunk.n_cols == 0)
+      return;
+
+    const arma::Col<eT> chunkMean = arma::mean(chunk, 1);
+    const arma::Mat<eT> centered = chunk.each_col() - chunkMean;
+
+    if (count == 0)
+    {
+      mean = chunkMean;
+      comoment = centered * centered.t();
+      count = chunk.n_cols;
+      return;
+    }
+
+    // Chan et al.'s update of the mean and the comoment matrix (the sum of
+    // outer products of deviations from the mean).
+    const size_t chunkCount = chunk.n_cols;
+    const size_t totalCount = count + chunkCount;
+    const arma::Col<eT> delta = chunkMean - mean;
+
+    comoment += centered * centered.t() + (delta * delta.t()) *
+        (eT) ((double) count * chunkCount / totalCount);
+    mean += delta * ((eT) chunkCount / (eT) totalCount);
+    count = totalCount;
+  }
+
+  /**
+   * Merge the partial statistics of another object into this one, as if this
+   * object had seen all of the columns the other object has seen.
+   *
+   * @param other Partial statistics to merge in.
+   */
+  void Merge(const IncrementalCovariance& other)
+  {
+    if (other.count == 0)
+      return;
+
+    if (count == 0)
+    {
+      *this = other;
+      return;
+    }
+
+    const size_t totalCount = count + other.count;
+    const arma::Col<eT> delta = other.mean - mean;
+
+    comoment += other.comoment + (delta * delta.t()) *
+        (eT) ((double) count * other.count / totalCount);
+    mean += delta * ((eT) other.count / (eT) totalCount);
+    count = totalCount;
+  }
+
+  /**
+   * Return the covariance of all columns seen so far.  This matches
+   * ColumnCovariance() with the same norm_type: 0 normalizes by N - 1 and 1
+   * normalizes by N.
+   *
+   * @param normType Normalization type (0 or 1).
+   */
+  arma::Mat<eT> Covariance(const size_t normType = 0) const
+  {
+    if (normType > 1)
+    {
+      Log::Fatal << "IncrementalCovariance::Covariance(): norm_type must be 0 "
+          << "or 1!" << std::endl;
+    }
+
+    if (count == 0)
+      return arma::Mat<eT>();
+
+    const eT normVal = (normType == 0) ?
+        ((count > 1) ? eT(count - 1) : eT(1)) : eT(count);
+    return comoment / normVal;
+  }
+
+  //! Get the mean of all columns seen so far.
+  const arma::Col<eT>& Mean() const { return mean; }
+
+  //! Get the number of columns seen so far.
+  size_t Count() const { return count; }
+
+ private:
+  //! The number of columns seen so far.
+  size_t count;
+  //! The mean of the columns seen so far.
+  arma::Col<eT> mean;
+  //! The sum of outer products of deviations from the mean.
+  arma::Mat<eT> comoment;
+};
+
+} // namespace math
+} // namespace mlpack
+
+#endif
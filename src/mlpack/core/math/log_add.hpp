@@ -36,6 +36,16 @@ T LogAdd(T x, T y);
 template<typename T>
 typename T::elem_type AccuLog(const T& x);
 
+/**
+ * Compute the elementwise log-addition of two equally-sized Armadillo objects
+ * of log values, accumulating into the first: x[i] = log(e^x[i] + e^y[i]).
+ *
+ * @param x object of log values to accumulate into
+ * @param y object of log values to add
+ */
+template<typename T>
+void LogAddBatch(T& x, const T& y);
+
 } // namespace math
 } // namespace mlpack
 
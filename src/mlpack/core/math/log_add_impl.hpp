@@ -71,6 +71,19 @@ typename T::elem_type AccuLog(const T& x)
   return sum;
 }
 
+/**
+ * Elementwise log-addition of two equally-sized objects of log values.
+ *
+ * @param x object of log values to accumulate into
+ * @param y object of log values to add
+ */
+template<typename T>
+void LogAddBatch(T& x, const T& y)
+{
+  for (size_t i = 0; i < x.n_elem; ++i)
+    x[i] = LogAdd(x[i], y[i]);
+}
+
 } // namespace math
 } // namespace mlpack
 
@@ -0,0 +1,103 @@
+/**
+ * @file core/math/make_positive_definite.hpp
+ * @author Ryan Curtin
+ *
+ * Repair a symmetric matrix so that it is positive definite, using Cholesky
+ * factorization attempts instead of an eigendecomposition.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_MAKE_POSITIVE_DEFINITE_HPP
+#define MLPACK_CORE_MATH_MAKE_POSITIVE_DEFINITE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * Modify the given symmetric matrix, if necessary, so that it is positive
+ * definite (i.e. so that it can be Cholesky-decomposed), and return the
+ * diagonal shift that was applied (0 if the matrix was already positive
+ * definite).
+ *
+ * The repair works entirely through Cholesky factorization attempts: if the
+ * factorization of the matrix fails, a diagonal shift large enough to make it
+ * succeed is found by doubling, and then reduced by bisection until it is
+ * within the given relative tolerance of the smallest sufficient shift.
+ * Every trial costs one Cholesky factorization, which LAPACK computes with a
+ * blocked (and, with a threaded BLAS, multithreaded) algorithm; even a dozen
+ * trials are far cheaper than the eigendecomposition this replaces for large
+ * matrices, and a matrix that is already positive definite costs exactly one
+ * factorization.
+ *
+ * The upper triangle of the matrix is used, and the matrix is symmetrized on
+ * return.
+ *
+ * @param matrix Symmetric matrix to repair (overwritten).
+ * @param tolerance Relative tolerance on the applied diagonal shift.
+ * @return The diagonal shift that was applied.
+ */
+inline double MakePositiveDefinite(arma::mat& matrix,
+                                   const double tolerance = 0.1)
+{
+  matrix = arma::symmatu(matrix);
+
+  arma::mat chol;
+  if (arma::chol(chol, matrix))
+    return 0.0;
+
+  // The factorization failed, so the matrix needs a diagonal shift.  Scale
+  // the initial guess to the matrix, then double it until the factorization
+  // succeeds.  By the Gershgorin circle theorem the smallest eigenvalue is no
+  // smaller than -max(sum(abs(matrix), 1)), so the doubling terminates for
+  // any finite matrix.
+  const double scale = std::max(arma::abs(matrix.diag()).max(),
+      std::numeric_limits<double>::min());
+  double upper = std::numeric_limits<double>::epsilon() * scale;
+
+  arma::mat shifted;
+  size_t trials = 0;
+  while (true)
+  {
+    shifted = matrix;
+    shifted.diag() += upper;
+    if (arma::chol(chol, shifted))
+      break;
+
+    if (++trials > 100)
+    {
+      Log::Fatal << "MakePositiveDefinite(): cannot repair matrix; does it "
+          << "contain non-finite values?" << std::endl;
+    }
+
+    upper *= 2.0;
+  }
+
+  // Now bisect between the largest known-insufficient shift and the smallest
+  // known-sufficient one, so that the matrix is perturbed no more than
+  // necessary.
+  double lower = (trials == 0) ? 0.0 : upper / 2.0;
+  while (upper - lower > tolerance * upper)
+  {
+    const double mid = 0.5 * (lower + upper);
+
+    shifted = matrix;
+    shifted.diag() += mid;
+    if (arma::chol(chol, shifted))
+      upper = mid;
+    else
+      lower = mid;
+  }
+
+  matrix.diag() += upper;
+  return upper;
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif // MLPACK_CORE_MATH_MAKE_POSITIVE_DEFINITE_HPP
@@ -15,6 +15,8 @@
 
 #include "multiply_slices.hpp"
 
+#include <mlpack/core/util/parallel.hpp>
+
 namespace mlpack {
 namespace math /** Miscellaneous math routines. */ {
 
@@ -56,25 +58,27 @@ CubeType MultiplyCube2Cube(const CubeType& cubeA,
 
   CubeType z(rows, cols, slices);
 
+  // The per-slice products are independent, so the batch of equal-shape
+  // multiplications is distributed over threads.
   if (aTranspose && bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = arma::trans(cubeB.slice(i) * cubeA.slice(i));
+    Parallel::For((size_t) 0, slices, [&](const size_t i)
+        { z.slice(i) = arma::trans(cubeB.slice(i) * cubeA.slice(i)); });
   }
   else if (bTranspose && !aTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = cubeA.slice(i) * cubeB.slice(i).t();
+    Parallel::For((size_t) 0, slices, [&](const size_t i)
+        { z.slice(i) = cubeA.slice(i) * cubeB.slice(i).t(); });
   }
   else if (aTranspose && !bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = cubeA.slice(i).t() * cubeB.slice(i);
+    Parallel::For((size_t) 0, slices, [&](const size_t i)
+        { z.slice(i) = cubeA.slice(i).t() * cubeB.slice(i); });
   }
   else
   {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = cubeA.slice(i) * cubeB.slice(i);
+    Parallel::For((size_t) 0, slices, [&](const size_t i)
+        { z.slice(i) = cubeA.slice(i) * cubeB.slice(i); });
   }
   return z;
 }
@@ -116,23 +120,29 @@ CubeType MultiplyMat2Cube(const MatType& matA,
 
   if (aTranspose && bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = arma::trans(cubeB.slice(i) * matA);
+    Parallel::For((size_t) 0, slices, [&](const size_t i)
+        { z.slice(i) = arma::trans(cubeB.slice(i) * matA); });
   }
   else if (bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = matA * cubeB.slice(i).t();
-  }
-  else if (aTranspose)
-  {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = matA.t() * cubeB.slice(i);
+    Parallel::For((size_t) 0, slices, [&](const size_t i)
+        { z.slice(i) = matA * cubeB.slice(i).t(); });
   }
   else
   {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = matA * cubeB.slice(i);
+    // All slices share the left operand, so the whole batch collapses into a
+    // single GEMM: the cube's slices are contiguous in memory, making it a
+    // (n_rows x n_cols * n_slices) matrix.
+    typedef typename CubeType::elem_type ElemType;
+    const arma::Mat<ElemType> flatB(
+        const_cast<CubeType&>(cubeB).memptr(), cubeB.n_rows,
+        cubeB.n_cols * slices, false, false);
+    arma::Mat<ElemType> flatZ(z.memptr(), rows, cols * slices, false, false);
+
+    if (aTranspose)
+      flatZ = matA.t() * flatB;
+    else
+      flatZ = matA * flatB;
   }
   return z;
 }
@@ -172,23 +182,23 @@ CubeType MultiplyCube2Mat(const CubeType& cubeA,
 
   if (aTranspose && bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = arma::trans(matB * cubeA.slice(i));
+    Parallel::For((size_t) 0, slices, [&](const size_t i)
+        { z.slice(i) = arma::trans(matB * cubeA.slice(i)); });
   }
   else if (bTranspose && !aTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = cubeA.slice(i) * matB.t();
+    Parallel::For((size_t) 0, slices, [&](const size_t i)
+        { z.slice(i) = cubeA.slice(i) * matB.t(); });
   }
   else if (aTranspose && !bTranspose)
   {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = cubeA.slice(i).t() * matB;
+    Parallel::For((size_t) 0, slices, [&](const size_t i)
+        { z.slice(i) = cubeA.slice(i).t() * matB; });
   }
   else
   {
-    for (size_t i = 0; i < slices; ++i)
-      z.slice(i) = cubeA.slice(i) * matB;
+    Parallel::For((size_t) 0, slices, [&](const size_t i)
+        { z.slice(i) = cubeA.slice(i) * matB; });
   }
   return z;
 }
@@ -8,6 +8,7 @@
  * 3-clause BSD license along with mlpack.  If not, see
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
+#include <cstdint>
 #include <random>
 #include <mlpack/mlpack_export.hpp>
 
@@ -20,6 +21,11 @@ MLPACK_EXPORT std::mt19937 randGen;
 MLPACK_EXPORT std::uniform_real_distribution<> randUniformDist(0.0, 1.0);
 // Global normal distribution.
 MLPACK_EXPORT std::normal_distribution<> randNormalDist(0.0, 1.0);
+// Root seed for the per-thread random streams.
+MLPACK_EXPORT uint64_t randStreamSeed = 0;
+// Starts at 1 so that every freshly-created thread-local stream (which
+// starts at generation 0) seeds itself on first use.
+MLPACK_EXPORT uint64_t randStreamGeneration = 1;
 
 } // namespace math
 } // namespace mlpack
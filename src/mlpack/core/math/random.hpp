@@ -13,8 +13,15 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/mlpack_export.hpp>
+#include <mlpack/core/util/parallel.hpp>
 #include <random>
 
+#include "random_stream.hpp"
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
 namespace mlpack {
 namespace math /** Miscellaneous math routines. */ {
 
@@ -29,6 +36,37 @@ extern MLPACK_EXPORT std::mt19937 randGen;
 extern MLPACK_EXPORT std::uniform_real_distribution<> randUniformDist;
 // Global normal distribution.
 extern MLPACK_EXPORT std::normal_distribution<> randNormalDist;
+// Root seed for the per-thread random streams.
+extern MLPACK_EXPORT uint64_t randStreamSeed;
+// Incremented on every reseed, so that already-created per-thread streams
+// know to reseed themselves.
+extern MLPACK_EXPORT uint64_t randStreamGeneration;
+
+/**
+ * Get the random stream of the calling thread.  Each thread has its own
+ * counter-based stream, seeded deterministically from the root seed (set by
+ * RandomSeed()) and the thread's id, so the parallel code paths that draw
+ * random numbers neither contend on a shared generator nor depend on the
+ * interleaving of the threads.
+ */
+inline RandomStream& RandGen()
+{
+  thread_local RandomStream stream;
+  thread_local uint64_t generation = 0;
+
+  if (generation != randStreamGeneration)
+  {
+    #ifdef HAS_OPENMP
+      const uint64_t streamId = (uint64_t) omp_get_thread_num();
+    #else
+      const uint64_t streamId = 0;
+    #endif
+    stream.Seed(randStreamSeed, streamId);
+    generation = randStreamGeneration;
+  }
+
+  return stream;
+}
 
 /**
  * Set the random seed used by the random functions (Random() and RandInt()).
@@ -41,6 +79,8 @@ inline void RandomSeed(const size_t seed)
 {
   #if (!defined(BINDING_TYPE) || BINDING_TYPE != BINDING_TYPE_TEST)
     randGen.seed((uint32_t) seed);
+    randStreamSeed = (uint64_t) seed;
+    ++randStreamGeneration; // Existing per-thread streams reseed lazily.
     #if (BINDING_TYPE == BINDING_TYPE_R)
       // To suppress Found ‘srand’, possibly from ‘srand’ (C).
       (void) seed;
@@ -65,6 +105,8 @@ inline void FixedRandomSeed()
 {
   const static size_t seed = rand();
   randGen.seed((uint32_t) seed);
+  randStreamSeed = (uint64_t) seed;
+  ++randStreamGeneration;
   srand((unsigned int) seed);
   arma::arma_rng::set_seed(seed);
 }
@@ -72,17 +114,21 @@ inline void FixedRandomSeed()
 inline void CustomRandomSeed(const size_t seed)
 {
   randGen.seed((uint32_t) seed);
+  randStreamSeed = (uint64_t) seed;
+  ++randStreamGeneration;
   srand((unsigned int) seed);
   arma::arma_rng::set_seed(seed);
 }
 #endif
 
 /**
- * Generates a uniform random number between 0 and 1.
+ * Generates a uniform random number between 0 and 1, from the calling
+ * thread's random stream.
  */
 inline double Random()
 {
-  return randUniformDist(randGen);
+  thread_local std::uniform_real_distribution<> uniformDist(0.0, 1.0);
+  return uniformDist(RandGen());
 }
 
 /**
@@ -90,7 +136,7 @@ inline double Random()
  */
 inline double Random(const double lo, const double hi)
 {
-  return lo + (hi - lo) * randUniformDist(randGen);
+  return lo + (hi - lo) * Random();
 }
 
 /**
@@ -109,7 +155,7 @@ inline double RandBernoulli(const double input)
  */
 inline int RandInt(const int hiExclusive)
 {
-  return (int) std::floor((double) hiExclusive * randUniformDist(randGen));
+  return (int) std::floor((double) hiExclusive * Random());
 }
 
 /**
@@ -117,16 +163,28 @@ inline int RandInt(const int hiExclusive)
  */
 inline int RandInt(const int lo, const int hiExclusive)
 {
-  return lo + (int) std::floor((double) (hiExclusive - lo)
-                               * randUniformDist(randGen));
+  return lo + (int) std::floor((double) (hiExclusive - lo) * Random());
 }
 
 /**
- * Generates a normally distributed random number with mean 0 and variance 1.
+ * Generates a normally distributed random number with mean 0 and variance 1,
+ * from the calling thread's random stream.
  */
 inline double RandNormal()
 {
-  return randNormalDist(randGen);
+  thread_local std::normal_distribution<> normalDist(0.0, 1.0);
+  thread_local uint64_t generation = 0;
+
+  // The normal distribution carries state (a cached second value), which
+  // must be discarded when the stream is reseeded, or the first draw after
+  // RandomSeed() would not be reproducible.
+  if (generation != randStreamGeneration)
+  {
+    normalDist.reset();
+    generation = randStreamGeneration;
+  }
+
+  return normalDist(RandGen());
 }
 
 /**
@@ -138,22 +196,103 @@ inline double RandNormal()
  */
 inline double RandNormal(const double mean, const double variance)
 {
-  return variance * randNormalDist(randGen) + mean;
+  return variance * RandNormal() + mean;
 }
 
 /**
- * Obtains no more than maxNumSamples distinct samples. Each sample belongs to
- * [loInclusive, hiExclusive).
+ * The number of elements that each block of a parallel random fill covers.
+ * Every block is generated by its own counter-based stream, so the block size
+ * fixes the mapping from element index to stream independently of how many
+ * threads execute the fill.
+ */
+static const size_t randomFillBlockSize = 4096;
+
+/**
+ * Fill the given matrix with uniformly distributed random values in
+ * [lowerBound, upperBound), in parallel.  The fill is keyed by a single draw
+ * from the calling thread's stream; each fixed-size block of elements is then
+ * generated by a stream derived from that key and the block index, so for a
+ * given random seed the result is identical no matter how many threads
+ * perform the fill.
+ *
+ * @param W Matrix to fill; its size is left unchanged.
+ * @param lowerBound The lower bound (inclusive).
+ * @param upperBound The upper bound (exclusive).
+ */
+template<typename eT>
+inline void RandomFill(arma::Mat<eT>& W,
+                       const double lowerBound,
+                       const double upperBound)
+{
+  const uint64_t fillSeed = RandGen()();
+  const size_t blocks = (W.n_elem + randomFillBlockSize - 1) /
+      randomFillBlockSize;
+
+  eT* memory = W.memptr();
+  Parallel::For((size_t) 0, blocks, [&](const size_t block)
+  {
+    RandomStream stream(fillSeed, block);
+    std::uniform_real_distribution<> dist(lowerBound, upperBound);
+
+    const size_t begin = block * randomFillBlockSize;
+    const size_t end = std::min(begin + randomFillBlockSize,
+        (size_t) W.n_elem);
+    for (size_t i = begin; i < end; ++i)
+      memory[i] = (eT) dist(stream);
+  });
+}
+
+/**
+ * Fill the given matrix with normally distributed random values, in parallel,
+ * using the same per-block streams as RandomFill(), so the result for a given
+ * random seed does not depend on the number of threads.  As with
+ * RandNormal(), the variance parameter scales a unit normal draw.
+ *
+ * @param W Matrix to fill; its size is left unchanged.
+ * @param mean Mean of the distribution.
+ * @param variance Variance of the distribution.
+ */
+template<typename eT>
+inline void RandomFillGaussian(arma::Mat<eT>& W,
+                               const double mean,
+                               const double variance)
+{
+  const uint64_t fillSeed = RandGen()();
+  const size_t blocks = (W.n_elem + randomFillBlockSize - 1) /
+      randomFillBlockSize;
+
+  eT* memory = W.memptr();
+  Parallel::For((size_t) 0, blocks, [&](const size_t block)
+  {
+    RandomStream stream(fillSeed, block);
+    std::normal_distribution<> dist(0.0, 1.0);
+
+    const size_t begin = block * randomFillBlockSize;
+    const size_t end = std::min(begin + randomFillBlockSize,
+        (size_t) W.n_elem);
+    for (size_t i = begin; i < end; ++i)
+      memory[i] = (eT) (variance * dist(stream) + mean);
+  });
+}
+
+/**
+ * Obtains no more than maxNumSamples distinct samples using the given random
+ * number generator.  Each sample belongs to [loInclusive, hiExclusive).
+ * Passing an explicit generator allows sampling from a private stream, e.g.
+ * one per thread or one per query point, without touching the global
+ * generator.
  *
  * @param loInclusive The lower bound (inclusive).
  * @param hiExclusive The high bound (exclusive).
  * @param maxNumSamples The maximum number of samples to obtain.
  * @param distinctSamples The samples that will be obtained.
+ * @param gen Random number generator to draw from.
  */
 inline void ObtainDistinctSamples(const size_t loInclusive,
                                   const size_t hiExclusive,
                                   const size_t maxNumSamples,
-                                  arma::uvec& distinctSamples)
+                                  arma::uvec& distinctSamples,
+                                  std::mt19937& gen)
 {
   const size_t samplesRangeSize = hiExclusive - loInclusive;
 
@@ -163,8 +302,10 @@ inline void ObtainDistinctSamples(const size_t loInclusive,
 
     samples.zeros(samplesRangeSize);
 
+    std::uniform_real_distribution<> uniformDist;
     for (size_t i = 0; i < maxNumSamples; ++i)
-      samples [ (size_t) math::RandInt(samplesRangeSize) ]++;
+      samples [ (size_t) std::floor((double) samplesRangeSize *
+          uniformDist(gen)) ]++;
 
     distinctSamples = arma::find(samples > 0);
 
@@ -179,6 +320,24 @@ inline void ObtainDistinctSamples(const size_t loInclusive,
   }
 }
 
+/**
+ * Obtains no more than maxNumSamples distinct samples. Each sample belongs to
+ * [loInclusive, hiExclusive).
+ *
+ * @param loInclusive The lower bound (inclusive).
+ * @param hiExclusive The high bound (exclusive).
+ * @param maxNumSamples The maximum number of samples to obtain.
+ * @param distinctSamples The samples that will be obtained.
+ */
+inline void ObtainDistinctSamples(const size_t loInclusive,
+                                  const size_t hiExclusive,
+                                  const size_t maxNumSamples,
+                                  arma::uvec& distinctSamples)
+{
+  ObtainDistinctSamples(loInclusive, hiExclusive, maxNumSamples,
+      distinctSamples, randGen);
+}
+
 } // namespace math
 } // namespace mlpack
 
@@ -0,0 +1,105 @@
+/**
+ * @file core/math/random_stream.hpp
+ * @author Ryan Curtin
+ *
+ * A small counter-based random number generator.  Unlike the Mersenne
+ * Twister, a counter-based generator carries almost no state (a key and a
+ * counter), so an arbitrary number of decorrelated streams can be created
+ * cheaply by deriving each stream's key from a root seed and a stream id.
+ * This is what allows every thread to have its own deterministic stream (see
+ * RandGen() in random.hpp) instead of all threads contending on one shared
+ * generator.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_RANDOM_STREAM_HPP
+#define MLPACK_CORE_MATH_RANDOM_STREAM_HPP
+
+#include <cstdint>
+#include <limits>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * A counter-based random number generator: each output is produced by mixing
+ * an incrementing counter with a fixed key, using the SplitMix64 finalizer.
+ * The key is derived from a root seed and a stream id, so that
+ * (seed, streamId) deterministically identifies the whole stream, and
+ * different stream ids give decorrelated sequences for the same seed.
+ *
+ * The class satisfies the UniformRandomBitGenerator concept, so it can be
+ * used with the <random> distributions.
+ */
+class RandomStream
+{
+ public:
+  //! The type of the generated values.
+  typedef uint64_t result_type;
+
+  /**
+   * Create a stream with the given root seed and stream id.
+   *
+   * @param seed Root seed shared by all streams.
+   * @param streamId Id of this stream; different ids give decorrelated
+   *     sequences.
+   */
+  RandomStream(const uint64_t seed = 0, const uint64_t streamId = 0)
+  {
+    Seed(seed, streamId);
+  }
+
+  /**
+   * Reset the stream to the beginning of the sequence identified by the
+   * given root seed and stream id.
+   */
+  void Seed(const uint64_t seed, const uint64_t streamId = 0)
+  {
+    // Mix the seed and stream id together so that neighboring seeds or
+    // stream ids still give unrelated keys.
+    key = Mix(seed + 0x9e3779b97f4a7c15ULL * (streamId + 1));
+    counter = 0;
+  }
+
+  //! The smallest value that can be generated.
+  static constexpr result_type min() { return 0; }
+  //! The largest value that can be generated.
+  static constexpr result_type max()
+  {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  //! Generate the next value in the stream.
+  result_type operator()()
+  {
+    return Mix(key + (++counter) * 0x9e3779b97f4a7c15ULL);
+  }
+
+ private:
+  /**
+   * The SplitMix64 finalizer: a bijective mixing function whose output
+   * passes standard statistical test batteries when fed sequential inputs.
+   */
+  static uint64_t Mix(uint64_t z)
+  {
+    z ^= (z >> 30);
+    z *= 0xbf58476d1ce4e5b9ULL;
+    z ^= (z >> 27);
+    z *= 0x94d049bb133111ebULL;
+    z ^= (z >> 31);
+    return z;
+  }
+
+  //! The key of this stream, derived from the seed and stream id.
+  uint64_t key;
+  //! The position in the stream.
+  uint64_t counter;
+};
+
+} // namespace math
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file core/math/sampling.hpp
+ * @author Ryan Curtin
+ *
+ * Sampling utilities: counter-based random streams, parallel weighted
+ * reservoir sampling and stratified class-balanced sampling.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_SAMPLING_HPP
+#define MLPACK_CORE_MATH_SAMPLING_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace math {
+
+/**
+ * A counter-based random stream.  Instead of advancing internal state, the
+ * stream maps (seed, stream id, counter) to a random value with a fixed
+ * mixing function, so the value for any counter can be computed independently
+ * of every other counter.  This makes randomized loops trivially
+ * parallelizable while staying bitwise reproducible regardless of thread
+ * count or iteration order: thread t can draw the value for iteration i
+ * directly.
+ *
+ * Distinct stream ids with the same seed yield independent sequences, which
+ * is the intended way to give each parallel task its own randomness.
+ */
+class RandomStream
+{
+ public:
+  /**
+   * Create a random stream.
+   *
+   * @param seed Seed shared by all streams of one run.
+   * @param stream Stream identifier; streams with different ids produce
+   *     independent sequences.
+   */
+  RandomStream(const uint64_t seed, const uint64_t stream = 0);
+
+  //! Get the raw 64 random bits for the given counter.
+  uint64_t Bits(const uint64_t counter) const;
+
+  //! Get a uniform value in [0, 1) for the given counter.
+  double Uniform(const uint64_t counter) const;
+
+  //! Get a uniform integer in [0, n) for the given counter (n must be > 0).
+  uint64_t RandInt(const uint64_t counter, const uint64_t n) const;
+
+ private:
+  //! The mixed key derived from the seed and the stream id.
+  uint64_t key;
+};
+
+/**
+ * Sample k indices without replacement with probability proportional to the
+ * given weights, using the exponential-key reservoir method: each index draws
+ * the key log(u) / w from its own counter of a RandomStream and the k largest
+ * keys win.  The keys are independent, so the scan parallelizes over the
+ * weights with per-thread reservoirs merged at the end, and the result is
+ * reproducible for a given seed regardless of thread count.
+ *
+ * Indices with nonpositive weight are never selected.  If fewer than k
+ * indices have positive weight, only those are returned.
+ *
+ * @param weights Selection weight of each index.
+ * @param k Number of indices to sample.
+ * @param seed Seed for the random stream.
+ * @return Selected indices, in no particular order.
+ */
+arma::uvec WeightedReservoirSample(const arma::vec& weights,
+                                   const size_t k,
+                                   const uint64_t seed);
+
+/**
+ * Sample up to samplesPerClass indices of each class without replacement, so
+ * the result is class-balanced regardless of the class frequencies.  Classes
+ * with fewer points than samplesPerClass contribute all of their points.
+ * Each class is sampled from its own RandomStream, so the classes can be
+ * processed in parallel and the result is reproducible for a given seed
+ * regardless of thread count.
+ *
+ * @param labels Class label of each index; labels must be in
+ *     [0, numClasses).
+ * @param numClasses Number of classes.
+ * @param samplesPerClass Number of indices to sample from each class.
+ * @param seed Seed for the random streams.
+ * @return Selected indices, grouped by class.
+ */
+arma::uvec StratifiedSample(const arma::Row<size_t>& labels,
+                            const size_t numClasses,
+                            const size_t samplesPerClass,
+                            const uint64_t seed);
+
+} // namespace math
+} // namespace mlpack
+
+// Include implementation.
+#include "sampling_impl.hpp"
+
+#endif
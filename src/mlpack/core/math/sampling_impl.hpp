@@ -0,0 +1,188 @@
+/**
+ * @file core/math/sampling_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the sampling utilities: counter-based random streams,
+ * parallel weighted reservoir sampling and stratified class-balanced
+ * sampling.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_MATH_SAMPLING_IMPL_HPP
+#define MLPACK_CORE_MATH_SAMPLING_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "sampling.hpp"
+
+#include <queue>
+
+namespace mlpack {
+namespace math {
+
+namespace sampling_internal {
+
+/**
+ * A 64-bit finalizing mixer (the splitmix64 finalizer): a cheap bijection
+ * whose output bits are well distributed, used as the counter-based mixing
+ * function of RandomStream.
+ */
+inline uint64_t Mix(uint64_t x)
+{
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+} // namespace sampling_internal
+
+inline RandomStream::RandomStream(const uint64_t seed, const uint64_t stream) :
+    key(sampling_internal::Mix(seed + 0x9e3779b97f4a7c15ULL * (stream + 1)))
+{
+  // Nothing to do here.
+}
+
+inline uint64_t RandomStream::Bits(const uint64_t counter) const
+{
+  // Two mixing rounds decorrelate adjacent counters completely.
+  return sampling_internal::Mix(
+      sampling_internal::Mix(counter + 0x9e3779b97f4a7c15ULL) ^ key);
+}
+
+inline double RandomStream::Uniform(const uint64_t counter) const
+{
+  // Use the top 53 bits to fill the double's mantissa.
+  return (Bits(counter) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+inline uint64_t RandomStream::RandInt(const uint64_t counter,
+                                      const uint64_t n) const
+{
+  return Bits(counter) % n;
+}
+
+inline arma::uvec WeightedReservoirSample(const arma::vec& weights,
+                                          const size_t k,
+                                          const uint64_t seed)
+{
+  typedef std::pair<double, arma::uword> Candidate;
+
+  const RandomStream stream(seed);
+
+  // Keep the k largest keys seen so far in a min-heap, so the smallest
+  // surviving key is always on top.
+  std::priority_queue<Candidate, std::vector<Candidate>,
+      std::greater<Candidate>> best;
+
+  #pragma omp parallel
+  {
+    std::priority_queue<Candidate, std::vector<Candidate>,
+        std::greater<Candidate>> localBest;
+
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t i = 0; i < (omp_size_t) weights.n_elem; ++i)
+    {
+      if (weights[i] <= 0.0)
+        continue;
+
+      // Exponential-key reservoir sampling: the k indices with the largest
+      // log(u) / w keys form a without-replacement sample proportional to
+      // the weights.  The key only depends on the index's own counter, so
+      // the loop order does not affect the result.
+      const double key = std::log(stream.Uniform(i)) / weights[i];
+
+      if (localBest.size() < k)
+        localBest.push(Candidate(key, i));
+      else if (key > localBest.top().first)
+      {
+        localBest.pop();
+        localBest.push(Candidate(key, i));
+      }
+    }
+
+    #pragma omp critical (WeightedReservoirSample)
+    {
+      while (!localBest.empty())
+      {
+        if (best.size() < k)
+          best.push(localBest.top());
+        else if (localBest.top().first > best.top().first)
+        {
+          best.pop();
+          best.push(localBest.top());
+        }
+        localBest.pop();
+      }
+    }
+  }
+
+  arma::uvec result(best.size());
+  for (size_t i = 0; !best.empty(); ++i)
+  {
+    result[i] = best.top().second;
+    best.pop();
+  }
+
+  return result;
+}
+
+inline arma::uvec StratifiedSample(const arma::Row<size_t>& labels,
+                                   const size_t numClasses,
+                                   const size_t samplesPerClass,
+                                   const uint64_t seed)
+{
+  if (numClasses == 0)
+    throw std::invalid_argument("StratifiedSample(): numClasses must be > 0!");
+
+  if (!labels.is_empty() && labels.max() >= numClasses)
+  {
+    throw std::invalid_argument("StratifiedSample(): labels must be in "
+        "[0, numClasses)!");
+  }
+
+  // Group the indices by class.
+  std::vector<std::vector<arma::uword>> classIndices(numClasses);
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    classIndices[labels[i]].push_back(i);
+
+  // Compute where each class's sample begins in the output.
+  std::vector<size_t> offsets(numClasses + 1, 0);
+  for (size_t c = 0; c < numClasses; ++c)
+  {
+    offsets[c + 1] = offsets[c] +
+        std::min(samplesPerClass, classIndices[c].size());
+  }
+
+  arma::uvec result(offsets[numClasses]);
+
+  // Each class draws from its own stream, so the classes can be processed in
+  // any order (or concurrently) without changing the result.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t c = 0; c < (omp_size_t) numClasses; ++c)
+  {
+    std::vector<arma::uword>& pool = classIndices[c];
+    const size_t take = std::min(samplesPerClass, pool.size());
+    const RandomStream stream(seed, c + 1);
+
+    // Partial Fisher-Yates shuffle: after step j, pool[0..j] is a uniform
+    // without-replacement sample of the class.
+    for (size_t j = 0; j < take; ++j)
+    {
+      const size_t swap = j + stream.RandInt(j, pool.size() - j);
+      std::swap(pool[j], pool[swap]);
+      result[offsets[c] + j] = pool[j];
+    }
+  }
+
+  return result;
+}
+
+} // namespace math
+} // namespace mlpack
+
+#endif
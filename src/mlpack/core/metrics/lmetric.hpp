@@ -72,6 +72,12 @@ class LMetric
   /**
    * Computes the distance between two points.
    *
+   * If both vectors are sparse (e.g. columns of an arma::sp_mat), the
+   * distance is computed by merging their nonzero index lists, so the cost is
+   * proportional to the number of nonzero elements rather than the
+   * dimensionality.  This makes tree construction on very sparse
+   * high-dimensional data (such as TF-IDF matrices) far cheaper.
+   *
    * @tparam VecTypeA Type of first vector (generally arma::vec or
    *      arma::sp_vec).
    * @tparam VecTypeB Type of second vector.
@@ -18,6 +18,219 @@
 namespace mlpack {
 namespace metric {
 
+namespace lmetric_internal {
+
+//! Picks the sparse implementations below when both vector types are sparse
+//! Armadillo types (e.g. columns of an arma::sp_mat, which is what tree
+//! construction hands to the metric).  Mixed dense/sparse arguments take the
+//! dense path, which Armadillo handles directly.
+template<typename VecTypeA, typename VecTypeB>
+struct UseSparse
+{
+  typedef typename std::conditional<
+      arma::is_arma_sparse_type<VecTypeA>::value &&
+      arma::is_arma_sparse_type<VecTypeB>::value,
+      std::true_type, std::false_type>::type type;
+};
+
+/**
+ * Accumulate |a_i - b_i|^Power over two sparse vectors by merging their
+ * nonzero index lists; positions where both vectors are zero contribute
+ * nothing, so the cost is proportional to the number of nonzeros instead of
+ * the dimensionality.  On very sparse data (e.g. TF-IDF matrices that are a
+ * fraction of a percent dense) this is orders of magnitude cheaper than
+ * evaluating dense expressions on the columns.
+ */
+template<int Power, typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type SparsePowerSum(const VecTypeA& a,
+                                            const VecTypeB& b)
+{
+  typedef typename VecTypeA::elem_type ElemType;
+
+  ElemType sum = 0;
+  typename VecTypeA::const_iterator aIt = a.begin();
+  typename VecTypeB::const_iterator bIt = b.begin();
+
+  while (aIt != a.end() || bIt != b.end())
+  {
+    ElemType diff;
+    if (bIt == b.end() || (aIt != a.end() && aIt.row() < bIt.row()))
+    {
+      diff = (*aIt);
+      ++aIt;
+    }
+    else if (aIt == a.end() || bIt.row() < aIt.row())
+    {
+      diff = (*bIt);
+      ++bIt;
+    }
+    else
+    {
+      diff = (*aIt) - (*bIt);
+      ++aIt;
+      ++bIt;
+    }
+
+    // The compiler resolves this branch at compile time.
+    if (Power == 1)
+      sum += std::abs(diff);
+    else if (Power == 2)
+      sum += diff * diff;
+    else
+      sum += std::pow(std::abs(diff), (ElemType) Power);
+  }
+
+  return sum;
+}
+
+/**
+ * The L-infinity analog of SparsePowerSum(): the largest |a_i - b_i| over the
+ * merged nonzero positions.  Positions where both vectors are zero differ by
+ * zero and so can never exceed the running maximum.
+ */
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type SparseMaxAbs(const VecTypeA& a,
+                                          const VecTypeB& b)
+{
+  typedef typename VecTypeA::elem_type ElemType;
+
+  ElemType max = 0;
+  typename VecTypeA::const_iterator aIt = a.begin();
+  typename VecTypeB::const_iterator bIt = b.begin();
+
+  while (aIt != a.end() || bIt != b.end())
+  {
+    ElemType diff;
+    if (bIt == b.end() || (aIt != a.end() && aIt.row() < bIt.row()))
+    {
+      diff = (*aIt);
+      ++aIt;
+    }
+    else if (aIt == a.end() || bIt.row() < aIt.row())
+    {
+      diff = (*bIt);
+      ++bIt;
+    }
+    else
+    {
+      diff = (*aIt) - (*bIt);
+      ++aIt;
+      ++bIt;
+    }
+
+    if (std::abs(diff) > max)
+      max = std::abs(diff);
+  }
+
+  return max;
+}
+
+// Dense and sparse implementations of each specialization, selected by tag
+// dispatch so that only the applicable one is instantiated for a given pair
+// of vector types.
+
+template<int Power, typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type UnspecializedImpl(const VecTypeA& a,
+                                               const VecTypeB& b,
+                                               const std::false_type&)
+{
+  typename VecTypeA::elem_type sum = 0;
+  for (size_t i = 0; i < a.n_elem; ++i)
+    sum += std::pow(fabs(a[i] - b[i]), Power);
+
+  return sum;
+}
+
+template<int Power, typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type UnspecializedImpl(const VecTypeA& a,
+                                               const VecTypeB& b,
+                                               const std::true_type&)
+{
+  return SparsePowerSum<Power>(a, b);
+}
+
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type L1Impl(const VecTypeA& a,
+                                    const VecTypeB& b,
+                                    const std::false_type&)
+{
+  return arma::accu(abs(a - b));
+}
+
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type L1Impl(const VecTypeA& a,
+                                    const VecTypeB& b,
+                                    const std::true_type&)
+{
+  return SparsePowerSum<1>(a, b);
+}
+
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type L2SquaredImpl(const VecTypeA& a,
+                                           const VecTypeB& b,
+                                           const std::false_type&)
+{
+  return accu(arma::square(a - b));
+}
+
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type L2SquaredImpl(const VecTypeA& a,
+                                           const VecTypeB& b,
+                                           const std::true_type&)
+{
+  return SparsePowerSum<2>(a, b);
+}
+
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type L2Impl(const VecTypeA& a,
+                                    const VecTypeB& b,
+                                    const std::false_type&)
+{
+  return arma::norm(a - b, 2);
+}
+
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type L2Impl(const VecTypeA& a,
+                                    const VecTypeB& b,
+                                    const std::true_type&)
+{
+  return std::sqrt(SparsePowerSum<2>(a, b));
+}
+
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type L3SumImpl(const VecTypeA& a,
+                                       const VecTypeB& b,
+                                       const std::false_type&)
+{
+  return arma::accu(arma::pow(arma::abs(a - b), 3.0));
+}
+
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type L3SumImpl(const VecTypeA& a,
+                                       const VecTypeB& b,
+                                       const std::true_type&)
+{
+  return SparsePowerSum<3>(a, b);
+}
+
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type LInfImpl(const VecTypeA& a,
+                                      const VecTypeB& b,
+                                      const std::false_type&)
+{
+  return arma::as_scalar(arma::max(arma::abs(a - b)));
+}
+
+template<typename VecTypeA, typename VecTypeB>
+typename VecTypeA::elem_type LInfImpl(const VecTypeA& a,
+                                      const VecTypeB& b,
+                                      const std::true_type&)
+{
+  return SparseMaxAbs(a, b);
+}
+
+} // namespace lmetric_internal
+
 // Unspecialized implementation.  This should almost never be used...
 template<int Power, bool TakeRoot>
 template<typename VecTypeA, typename VecTypeB>
@@ -25,9 +238,9 @@ typename VecTypeA::elem_type LMetric<Power, TakeRoot>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  typename VecTypeA::elem_type sum = 0;
-  for (size_t i = 0; i < a.n_elem; ++i)
-    sum += std::pow(fabs(a[i] - b[i]), Power);
+  typename VecTypeA::elem_type sum =
+      lmetric_internal::UnspecializedImpl<Power>(a, b,
+      typename lmetric_internal::UseSparse<VecTypeA, VecTypeB>::type());
 
   if (!TakeRoot) // The compiler should optimize this correctly at compile-time.
     return sum;
@@ -42,7 +255,8 @@ typename VecTypeA::elem_type LMetric<1, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::accu(abs(a - b));
+  return lmetric_internal::L1Impl(a, b,
+      typename lmetric_internal::UseSparse<VecTypeA, VecTypeB>::type());
 }
 
 template<>
@@ -51,7 +265,8 @@ typename VecTypeA::elem_type LMetric<1, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::accu(abs(a - b));
+  return lmetric_internal::L1Impl(a, b,
+      typename lmetric_internal::UseSparse<VecTypeA, VecTypeB>::type());
 }
 
 // L2-metric specializations.
@@ -61,7 +276,8 @@ typename VecTypeA::elem_type LMetric<2, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::norm(a - b, 2);
+  return lmetric_internal::L2Impl(a, b,
+      typename lmetric_internal::UseSparse<VecTypeA, VecTypeB>::type());
 }
 
 template<>
@@ -70,7 +286,8 @@ typename VecTypeA::elem_type LMetric<2, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return accu(arma::square(a - b));
+  return lmetric_internal::L2SquaredImpl(a, b,
+      typename lmetric_internal::UseSparse<VecTypeA, VecTypeB>::type());
 }
 
 // L3-metric specialization (not very likely to be used, but just in case).
@@ -80,11 +297,9 @@ typename VecTypeA::elem_type LMetric<3, true>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  typename VecTypeA::elem_type sum = 0;
-  for (size_t i = 0; i < a.n_elem; ++i)
-    sum += std::pow(fabs(a[i] - b[i]), 3.0);
-
-  return std::pow(arma::accu(arma::pow(arma::abs(a - b), 3.0)), 1.0 / 3.0);
+  return std::pow(lmetric_internal::L3SumImpl(a, b,
+      typename lmetric_internal::UseSparse<VecTypeA, VecTypeB>::type()),
+      1.0 / 3.0);
 }
 
 template<>
@@ -93,7 +308,8 @@ typename VecTypeA::elem_type LMetric<3, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::accu(arma::pow(arma::abs(a - b), 3.0));
+  return lmetric_internal::L3SumImpl(a, b,
+      typename lmetric_internal::UseSparse<VecTypeA, VecTypeB>::type());
 }
 
 // L-infinity (Chebyshev distance) specialization
@@ -103,7 +319,8 @@ typename VecTypeA::elem_type LMetric<INT_MAX, false>::Evaluate(
     const VecTypeA& a,
     const VecTypeB& b)
 {
-  return arma::as_scalar(arma::max(arma::abs(a - b)));
+  return lmetric_internal::LInfImpl(a, b,
+      typename lmetric_internal::UseSparse<VecTypeA, VecTypeB>::type());
 }
 
 } // namespace metric
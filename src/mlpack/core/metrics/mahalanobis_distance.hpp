@@ -51,6 +51,21 @@ namespace metric {
  *
  * which is faster to evaluate.
  *
+ * Internally the class caches the lower Cholesky factor L of Q (so that
+ * Q = L L^T) the first time a distance is evaluated, and evaluates
+ *
+ * @f[
+ * d(x, y)^2 = \| L^T (x - y) \|^2
+ * @f]
+ *
+ * with a triangular matrix-vector product instead of the full quadratic form.
+ * The same factor backs the batch Transform() method, which stretches a whole
+ * block of points at once so that plain (squared) Euclidean distances on the
+ * transformed points equal Mahalanobis distances on the originals; batch
+ * callers should prefer that route, since it turns the per-pair work into a
+ * single matrix multiplication.  The cached factor is invalidated whenever the
+ * covariance is accessed through the non-const Covariance() accessor.
+ *
  * @tparam TakeRoot If true, takes the root of the output.  It is slightly
  *   faster to leave this at the default of false, but this means the metric may
  *   not satisfy the triangle inequality and may not be usable for methods that
@@ -64,7 +79,7 @@ class MahalanobisDistance
    * Initialize the Mahalanobis distance with the empty matrix as covariance.
    * Don't call Evaluate() until you set the covariance with Covariance()!
    */
-  MahalanobisDistance() { }
+  MahalanobisDistance() : factorized(false), hasFactor(false) { }
 
   /**
    * Initialize the Mahalanobis distance with the identity matrix of the given
@@ -73,7 +88,9 @@ class MahalanobisDistance
    * @param dimensionality Dimesnsionality of the covariance matrix.
    */
   MahalanobisDistance(const size_t dimensionality) :
-      covariance(arma::eye<arma::mat>(dimensionality, dimensionality)) { }
+      covariance(arma::eye<arma::mat>(dimensionality, dimensionality)),
+      factorized(false),
+      hasFactor(false) { }
 
   /**
    * Initialize the Mahalanobis distance with the given covariance matrix.  The
@@ -82,7 +99,9 @@ class MahalanobisDistance
    * @param covariance The covariance matrix to use for this distance.
    */
   MahalanobisDistance(arma::mat covariance) :
-      covariance(std::move(covariance)) { }
+      covariance(std::move(covariance)),
+      factorized(false),
+      hasFactor(false) { }
 
   /**
    * Evaluate the distance between the two given points using this Mahalanobis
@@ -96,6 +115,41 @@ class MahalanobisDistance
   template<typename VecTypeA, typename VecTypeB>
   double Evaluate(const VecTypeA& a, const VecTypeB& b);
 
+  /**
+   * Stretch a block of points (one per column) through the Cholesky factor of
+   * the covariance, so that the squared Euclidean distance between two
+   * transformed columns equals the (unrooted) Mahalanobis distance between
+   * the original columns.  The transformation is a single triangular matrix
+   * multiplication, so batch algorithms should transform their points once
+   * and then use plain Euclidean kernels (e.g. PairwiseDistances() with an
+   * LMetric) instead of evaluating this metric pair by pair.
+   *
+   * @param points Points to transform (one per column).
+   * @param transformed Matrix to store the transformed points in.
+   */
+  void Transform(const arma::mat& points, arma::mat& transformed)
+  {
+    transformed = arma::trans(Factor()) * points;
+  }
+
+  /**
+   * Return the cached lower Cholesky factor L of the covariance matrix, such
+   * that the covariance is L L^T, computing it first if the covariance has
+   * changed since the last factorization.  Throws std::invalid_argument if
+   * the covariance matrix is not positive definite.
+   */
+  const arma::mat& Factor()
+  {
+    if (!factorized)
+      Factorize();
+    if (!hasFactor)
+    {
+      throw std::invalid_argument("MahalanobisDistance::Factor(): covariance "
+          "matrix is not positive definite!");
+    }
+    return factor;
+  }
+
   /**
    * Access the covariance matrix.
    *
@@ -104,19 +158,43 @@ class MahalanobisDistance
   const arma::mat& Covariance() const { return covariance; }
 
   /**
-   * Modify the covariance matrix.
+   * Modify the covariance matrix.  This invalidates the cached Cholesky
+   * factor; it will be recomputed on the next evaluation.
    *
    * @return Reference to the covariance matrix.
    */
-  arma::mat& Covariance() { return covariance; }
+  arma::mat& Covariance()
+  {
+    factorized = false;
+    hasFactor = false;
+    return covariance;
+  }
 
   //! Serialize the Mahalanobis distance.
   template<typename Archive>
   void serialize(Archive& ar, const unsigned int version);
 
  private:
+  /**
+   * Attempt to compute the lower Cholesky factor of the covariance matrix.
+   * If the covariance is not positive definite, hasFactor is left false and
+   * evaluations fall back to the full quadratic form.
+   */
+  void Factorize()
+  {
+    hasFactor = arma::chol(factor, covariance, "lower");
+    factorized = true;
+  }
+
   //! The covariance matrix associated with this distance.
   arma::mat covariance;
+  //! The cached lower Cholesky factor of the covariance matrix.
+  arma::mat factor;
+  //! Whether a factorization of the current covariance has been attempted.
+  bool factorized;
+  //! Whether the factorization succeeded (i.e. the covariance is positive
+  //! definite).
+  bool hasFactor;
 };
 
 } // namespace metric
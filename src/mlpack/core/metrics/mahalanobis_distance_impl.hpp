@@ -25,7 +25,21 @@ template<typename VecTypeA, typename VecTypeB>
 double MahalanobisDistance<false>::Evaluate(const VecTypeA& a,
                                             const VecTypeB& b)
 {
+  if (!factorized)
+    Factorize();
+
   arma::vec m = (a - b);
+  if (hasFactor)
+  {
+    // With the covariance factored as L L^T, the quadratic form reduces to a
+    // squared norm of the stretched difference; the triangular product does
+    // half the work of the full quadratic form.
+    m = trans(factor) * m;
+    return arma::dot(m, m);
+  }
+
+  // The covariance is not positive definite; fall back to the full quadratic
+  // form, which is defined for any covariance matrix.
   arma::mat out = trans(m) * covariance * m; // 1x1
   return out[0];
 }
@@ -40,9 +54,21 @@ double MahalanobisDistance<true>::Evaluate(const VecTypeA& a,
 {
   // Check if covariance matrix has been initialized.
   if (covariance.n_rows == 0)
+  {
     covariance = arma::eye<arma::mat>(a.n_elem, a.n_elem);
+    factorized = false;
+  }
+
+  if (!factorized)
+    Factorize();
 
   arma::vec m = (a - b);
+  if (hasFactor)
+  {
+    m = trans(factor) * m;
+    return sqrt(arma::dot(m, m));
+  }
+
   arma::mat out = trans(m) * covariance * m; // 1x1;
   return sqrt(out[0]);
 }
@@ -54,6 +80,14 @@ void MahalanobisDistance<TakeRoot>::serialize(Archive& ar,
                                               const unsigned int /* version */)
 {
   ar & BOOST_SERIALIZATION_NVP(covariance);
+
+  // The factor is cheap to recompute, so it is not serialized; make sure a
+  // stale one is not reused after loading.
+  if (Archive::is_loading::value)
+  {
+    factorized = false;
+    hasFactor = false;
+  }
 }
 
 } // namespace metric
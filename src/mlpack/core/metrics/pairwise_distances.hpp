@@ -0,0 +1,133 @@
+/**
+ * @file core/metrics/pairwise_distances.hpp
+ * @author Ryan Curtin
+ *
+ * Batch evaluation of a metric between all pairs of columns of two matrices.
+ * For the L2 metrics the computation reduces to a single matrix
+ * multiplication, which is far faster than evaluating the metric one pair at
+ * a time.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_PAIRWISE_DISTANCES_HPP
+#define MLPACK_CORE_METRICS_PAIRWISE_DISTANCES_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "lmetric.hpp"
+#include "mahalanobis_distance.hpp"
+
+namespace mlpack {
+namespace metric {
+
+/**
+ * Compute the distance between every column of a and every column of b,
+ * storing the result in distances, so that distances(i, j) holds the distance
+ * between a.col(i) and b.col(j).  distances is sized (a.n_cols x b.n_cols).
+ *
+ * This overload works for any metric by evaluating it one pair at a time.
+ * Prefer it over hand-written double loops anyway: the specialized overloads
+ * below are selected automatically when the metric is an LMetric, and those
+ * are far faster.
+ *
+ * Callers working with very large matrices should pass blocks of columns, so
+ * that the output matrix stays small enough to be cache- and memory-friendly.
+ *
+ * @param a First set of points (one point per column).
+ * @param b Second set of points (one point per column).
+ * @param distances Output matrix of pairwise distances.
+ * @param metric Metric to use for evaluations.
+ */
+template<typename MetricType, typename MatTypeA, typename MatTypeB>
+void PairwiseDistances(const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::Mat<typename MatTypeA::elem_type>& distances,
+                       const MetricType& metric);
+
+/**
+ * Compute all pairwise L2 (or squared L2) distances between the columns of a
+ * and the columns of b.  This uses the expansion
+ *
+ * @f[
+ * \| x - y \|^2 = \| x \|^2 + \| y \|^2 - 2 x^T y
+ * @f]
+ *
+ * so that the dominant cost is a single matrix multiplication, which the BLAS
+ * implementation blocks for cache.  Small negative values arising from
+ * floating-point cancellation are clamped to zero before the (optional) root
+ * is taken.
+ *
+ * @param a First set of points (one point per column).
+ * @param b Second set of points (one point per column).
+ * @param distances Output matrix of pairwise distances.
+ * @param metric L2 metric (EuclideanDistance or SquaredEuclideanDistance).
+ */
+template<bool TakeRoot, typename MatTypeA, typename MatTypeB>
+void PairwiseDistances(const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::Mat<typename MatTypeA::elem_type>& distances,
+                       const LMetric<2, TakeRoot>& metric);
+
+/**
+ * Compute all pairwise L1 (Manhattan) distances between the columns of a and
+ * the columns of b, one column of the output at a time with vectorized
+ * absolute-difference sums.
+ *
+ * @param a First set of points (one point per column).
+ * @param b Second set of points (one point per column).
+ * @param distances Output matrix of pairwise distances.
+ * @param metric L1 metric.
+ */
+template<bool TakeRoot, typename MatTypeA, typename MatTypeB>
+void PairwiseDistances(const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::Mat<typename MatTypeA::elem_type>& distances,
+                       const LMetric<1, TakeRoot>& metric);
+
+/**
+ * Compute all pairwise L-infinity (Chebyshev) distances between the columns
+ * of a and the columns of b, one column of the output at a time with
+ * vectorized absolute-difference maxima.
+ *
+ * @param a First set of points (one point per column).
+ * @param b Second set of points (one point per column).
+ * @param distances Output matrix of pairwise distances.
+ * @param metric Chebyshev metric.
+ */
+template<bool TakeRoot, typename MatTypeA, typename MatTypeB>
+void PairwiseDistances(const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::Mat<typename MatTypeA::elem_type>& distances,
+                       const LMetric<INT_MAX, TakeRoot>& metric);
+
+/**
+ * Compute all pairwise Mahalanobis distances between the columns of a and the
+ * columns of b.  Both point sets are stretched through the metric's cached
+ * Cholesky factor first (see MahalanobisDistance::Transform()), after which
+ * the distances reduce to plain (squared) Euclidean distances and the L2
+ * specialization above applies; the whole computation is two triangular
+ * matrix multiplications and one GEMM instead of a quadratic form per pair.
+ *
+ * The metric is taken by non-const reference because the first call may need
+ * to compute and cache the factorization.
+ *
+ * @param a First set of points (one point per column).
+ * @param b Second set of points (one point per column).
+ * @param distances Output matrix of pairwise distances.
+ * @param metric Mahalanobis metric; its covariance must be positive definite.
+ */
+template<bool TakeRoot>
+void PairwiseDistances(const arma::mat& a,
+                       const arma::mat& b,
+                       arma::mat& distances,
+                       MahalanobisDistance<TakeRoot>& metric);
+
+} // namespace metric
+} // namespace mlpack
+
+// Include implementation.
+#include "pairwise_distances_impl.hpp"
+
+#endif
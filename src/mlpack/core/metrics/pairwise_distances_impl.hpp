@@ -0,0 +1,128 @@
+/**
+ * @file core/metrics/pairwise_distances_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of batch pairwise metric evaluation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_METRICS_PAIRWISE_DISTANCES_IMPL_HPP
+#define MLPACK_CORE_METRICS_PAIRWISE_DISTANCES_IMPL_HPP
+
+// In case it hasn't been included.
+#include "pairwise_distances.hpp"
+
+namespace mlpack {
+namespace metric {
+
+// Generic implementation: evaluate the metric one pair at a time.
+template<typename MetricType, typename MatTypeA, typename MatTypeB>
+void PairwiseDistances(const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::Mat<typename MatTypeA::elem_type>& distances,
+                       const MetricType& metric)
+{
+  distances.set_size(a.n_cols, b.n_cols);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      distances(i, j) = metric.Evaluate(a.col(i), b.col(j));
+}
+
+// L2 specialization: one matrix multiplication for the cross terms.
+template<bool TakeRoot, typename MatTypeA, typename MatTypeB>
+void PairwiseDistances(const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::Mat<typename MatTypeA::elem_type>& distances,
+                       const LMetric<2, TakeRoot>& /* metric */)
+{
+  typedef typename MatTypeA::elem_type ElemType;
+
+  // Squared norms of every column.  arma::dot() works for dense and sparse
+  // columns alike.
+  arma::Col<ElemType> aNorms(a.n_cols);
+  for (size_t i = 0; i < a.n_cols; ++i)
+    aNorms[i] = arma::dot(a.col(i), a.col(i));
+
+  arma::Row<ElemType> bNorms(b.n_cols);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    bNorms[j] = arma::dot(b.col(j), b.col(j));
+
+  // ||x - y||^2 = ||x||^2 + ||y||^2 - 2 x^T y; the cross terms are a single
+  // matrix multiplication, which BLAS blocks for cache.
+  distances = ElemType(-2) * (arma::trans(a) * b);
+  distances.each_col() += aNorms;
+  distances.each_row() += bNorms;
+
+  // Floating-point cancellation in the expansion can produce tiny negative
+  // values for (near-)identical points; clamp these to zero.
+  distances.transform(
+      [](ElemType v) { return (v < ElemType(0)) ? ElemType(0) : v; });
+
+  if (TakeRoot) // The compiler should optimize this correctly at compile-time.
+    distances = arma::sqrt(distances);
+}
+
+// L1 specialization: vectorized absolute-difference sums, one output column
+// at a time.  The root does not matter for the L1 metric.
+template<bool TakeRoot, typename MatTypeA, typename MatTypeB>
+void PairwiseDistances(const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::Mat<typename MatTypeA::elem_type>& distances,
+                       const LMetric<1, TakeRoot>& /* metric */)
+{
+  typedef typename MatTypeA::elem_type ElemType;
+
+  distances.set_size(a.n_cols, b.n_cols);
+  arma::Mat<ElemType> diffs;
+  for (size_t j = 0; j < b.n_cols; ++j)
+  {
+    diffs = a;
+    diffs.each_col() -= arma::Col<ElemType>(b.col(j));
+    distances.col(j) = arma::trans(arma::sum(arma::abs(diffs), 0));
+  }
+}
+
+// L-infinity specialization: vectorized absolute-difference maxima, one
+// output column at a time.  The root does not matter for the Chebyshev
+// metric.
+template<bool TakeRoot, typename MatTypeA, typename MatTypeB>
+void PairwiseDistances(const MatTypeA& a,
+                       const MatTypeB& b,
+                       arma::Mat<typename MatTypeA::elem_type>& distances,
+                       const LMetric<INT_MAX, TakeRoot>& /* metric */)
+{
+  typedef typename MatTypeA::elem_type ElemType;
+
+  distances.set_size(a.n_cols, b.n_cols);
+  arma::Mat<ElemType> diffs;
+  for (size_t j = 0; j < b.n_cols; ++j)
+  {
+    diffs = a;
+    diffs.each_col() -= arma::Col<ElemType>(b.col(j));
+    distances.col(j) = arma::trans(arma::max(arma::abs(diffs), 0));
+  }
+}
+
+// Mahalanobis specialization: stretch both point sets once, then reuse the
+// L2 specialization on the transformed points.
+template<bool TakeRoot>
+void PairwiseDistances(const arma::mat& a,
+                       const arma::mat& b,
+                       arma::mat& distances,
+                       MahalanobisDistance<TakeRoot>& metric)
+{
+  arma::mat aTransformed, bTransformed;
+  metric.Transform(a, aTransformed);
+  metric.Transform(b, bTransformed);
+
+  PairwiseDistances(aTransformed, bTransformed, distances,
+      LMetric<2, TakeRoot>());
+}
+
+} // namespace metric
+} // namespace mlpack
+
+#endif
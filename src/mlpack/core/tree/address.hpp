@@ -68,8 +68,9 @@ void PointToAddress(AddressType& address, const VecType& point)
   arma::Col<AddressElemType> result(point.n_elem);
 
   constexpr size_t order = sizeof(AddressElemType) * CHAR_BIT;
-  // Calculate the number of bits for the exponent.
-  const int numExpBits = std::ceil(std::log2(
+  // Calculate the number of bits for the exponent.  This only depends on the
+  // types involved, so it is computed once.
+  static const int numExpBits = std::ceil(std::log2(
       std::numeric_limits<VecElemType>::max_exponent -
       std::numeric_limits<VecElemType>::min_exponent + 1.0));
 
@@ -126,16 +127,31 @@ void PointToAddress(AddressType& address, const VecType& point)
 
   address.zeros(point.n_elem);
 
-  // Interleave the bits of the new representation across all the elements
-  // in the address vector.
+  // In the one-dimensional case there is nothing to interleave.
+  if (point.n_elem == 1)
+  {
+    address(0) = result(0);
+    return;
+  }
+
+  // Interleave the bits of the new representation across all the elements in
+  // the address vector.  The bits are consumed most-significant-first from
+  // each element and streamed into the output words, so every shift in the
+  // loop is by a constant distance and no per-bit index arithmetic is needed.
+  size_t row = 0;
+  size_t used = 0;
+  AddressElemType word = 0;
   for (size_t i = 0; i < order; ++i)
     for (size_t j = 0; j < point.n_elem; ++j)
     {
-      size_t bit = (i * point.n_elem + j) % order;
-      size_t row = (i * point.n_elem + j) / order;
-
-      address(row) |= (((result(j) >> (order - 1 - i)) & 1) <<
-          (order - 1 - bit));
+      word = (word << 1) | (result(j) >> (order - 1));
+      result(j) <<= 1;
+      if (++used == order)
+      {
+        address(row++) = word;
+        word = 0;
+        used = 0;
+      }
     }
 }
 
@@ -163,8 +179,9 @@ void AddressToPoint(VecType& point, const AddressType& address)
       "correspond to the address element type.");
 
   constexpr size_t order = sizeof(AddressElemType) * CHAR_BIT;
-  // Calculate the number of bits for the exponent.
-  const int numExpBits = std::ceil(std::log2(
+  // Calculate the number of bits for the exponent.  This only depends on the
+  // types involved, so it is computed once.
+  static const int numExpBits = std::ceil(std::log2(
       std::numeric_limits<VecElemType>::max_exponent -
       std::numeric_limits<VecElemType>::min_exponent + 1.0));
 
@@ -176,15 +193,34 @@ void AddressToPoint(VecType& point, const AddressType& address)
   // Calculate the number of bits for the mantissa.
   const int numMantBits = order - numExpBits - 1;
 
-  for (size_t i = 0; i < order; ++i)
-    for (size_t j = 0; j < address.n_elem; ++j)
-    {
-      size_t bit = (i * address.n_elem + j) % order;
-      size_t row = (i * address.n_elem + j) / order;
-
-      rearrangedAddress(j) |= (((address(row) >> (order - 1 - bit)) & 1) <<
-          (order - 1 - i));
-    }
+  if (address.n_elem == 1)
+  {
+    // In the one-dimensional case there is nothing to deinterleave.
+    rearrangedAddress(0) = address(0);
+  }
+  else
+  {
+    // Deinterleave the bits: the address words are consumed
+    // most-significant-first and the bits are distributed round-robin across
+    // the dimensions, so every shift in the loop is by a constant distance
+    // and no per-bit index arithmetic is needed.
+    size_t row = 0;
+    size_t used = 0;
+    AddressElemType word = address(0);
+    for (size_t i = 0; i < order; ++i)
+      for (size_t j = 0; j < address.n_elem; ++j)
+      {
+        rearrangedAddress(j) = (rearrangedAddress(j) << 1) |
+            (word >> (order - 1));
+        word <<= 1;
+        if (++used == order)
+        {
+          used = 0;
+          if (++row < address.n_elem)
+            word = address(row);
+        }
+      }
+  }
 
   for (size_t i = 0; i < rearrangedAddress.n_elem; ++i)
   {
@@ -22,8 +22,8 @@ namespace mlpack {
 namespace bound {
 
 //! Empty Constructor.
-template<typename MetricType, typename VecType>
-BallBound<MetricType, VecType>::BallBound() :
+template<typename MetricType, typename ElemType, typename VecType>
+BallBound<MetricType, ElemType, VecType>::BallBound() :
     radius(std::numeric_limits<ElemType>::lowest()),
     metric(new MetricType()),
     ownsMetric(true)
@@ -34,8 +34,8 @@ BallBound<MetricType, VecType>::BallBound() :
  *
  * @param dimension Dimensionality of ball bound.
  */
-template<typename MetricType, typename VecType>
-BallBound<MetricType, VecType>::BallBound(const size_t dimension) :
+template<typename MetricType, typename ElemType, typename VecType>
+BallBound<MetricType, ElemType, VecType>::BallBound(const size_t dimension) :
     radius(std::numeric_limits<ElemType>::lowest()),
     center(dimension),
     metric(new MetricType()),
@@ -48,8 +48,8 @@ BallBound<MetricType, VecType>::BallBound(const size_t dimension) :
  * @param radius Radius of ball bound.
  * @param center Center of ball bound.
  */
-template<typename MetricType, typename VecType>
-BallBound<MetricType, VecType>::BallBound(const ElemType radius,
+template<typename MetricType, typename ElemType, typename VecType>
+BallBound<MetricType, ElemType, VecType>::BallBound(const ElemType radius,
                                            const VecType& center) :
     radius(radius),
     center(center),
@@ -58,8 +58,8 @@ BallBound<MetricType, VecType>::BallBound(const ElemType radius,
 { /* Nothing to do. */ }
 
 //! Copy Constructor. To prevent memory leaks.
-template<typename MetricType, typename VecType>
-BallBound<MetricType, VecType>::BallBound(const BallBound& other) :
+template<typename MetricType, typename ElemType, typename VecType>
+BallBound<MetricType, ElemType, VecType>::BallBound(const BallBound& other) :
     radius(other.radius),
     center(other.center),
     metric(other.metric),
@@ -67,8 +67,8 @@ BallBound<MetricType, VecType>::BallBound(const BallBound& other) :
 { /* Nothing to do. */ }
 
 //! For the same reason as the copy constructor: to prevent memory leaks.
-template<typename MetricType, typename VecType>
-BallBound<MetricType, VecType>& BallBound<MetricType, VecType>::operator=(
+template<typename MetricType, typename ElemType, typename VecType>
+BallBound<MetricType, ElemType, VecType>& BallBound<MetricType, ElemType, VecType>::operator=(
     const BallBound& other)
 {
   radius = other.radius;
@@ -78,8 +78,8 @@ BallBound<MetricType, VecType>& BallBound<MetricType, VecType>::operator=(
 }
 
 //! Move constructor.
-template<typename MetricType, typename VecType>
-BallBound<MetricType, VecType>::BallBound(BallBound&& other) :
+template<typename MetricType, typename ElemType, typename VecType>
+BallBound<MetricType, ElemType, VecType>::BallBound(BallBound&& other) :
     radius(other.radius),
     center(other.center),
     metric(other.metric),
@@ -93,17 +93,17 @@ BallBound<MetricType, VecType>::BallBound(BallBound&& other) :
 }
 
 //! Destructor to release allocated memory.
-template<typename MetricType, typename VecType>
-BallBound<MetricType, VecType>::~BallBound()
+template<typename MetricType, typename ElemType, typename VecType>
+BallBound<MetricType, ElemType, VecType>::~BallBound()
 {
   if (ownsMetric)
     delete metric;
 }
 
 //! Get the range in a certain dimension.
-template<typename MetricType, typename VecType>
-math::RangeType<typename BallBound<MetricType, VecType>::ElemType>
-BallBound<MetricType, VecType>::operator[](const size_t i) const
+template<typename MetricType, typename ElemType, typename VecType>
+math::RangeType<ElemType>
+BallBound<MetricType, ElemType, VecType>::operator[](const size_t i) const
 {
   if (radius < 0)
     return math::Range();
@@ -114,8 +114,8 @@ BallBound<MetricType, VecType>::operator[](const size_t i) const
 /**
  * Determines if a point is within the bound.
  */
-template<typename MetricType, typename VecType>
-bool BallBound<MetricType, VecType>::Contains(const VecType& point) const
+template<typename MetricType, typename ElemType, typename VecType>
+bool BallBound<MetricType, ElemType, VecType>::Contains(const VecType& point) const
 {
   if (radius < 0)
     return false;
@@ -126,10 +126,10 @@ bool BallBound<MetricType, VecType>::Contains(const VecType& point) const
 /**
  * Calculates minimum bound-to-point squared distance.
  */
-template<typename MetricType, typename VecType>
+template<typename MetricType, typename ElemType, typename VecType>
 template<typename OtherVecType>
-typename BallBound<MetricType, VecType>::ElemType
-BallBound<MetricType, VecType>::MinDistance(
+ElemType
+BallBound<MetricType, ElemType, VecType>::MinDistance(
     const OtherVecType& point,
     typename std::enable_if_t<IsVector<OtherVecType>::value>* /* junk */) const
 {
@@ -142,9 +142,9 @@ BallBound<MetricType, VecType>::MinDistance(
 /**
  * Calculates minimum bound-to-bound squared distance.
  */
-template<typename MetricType, typename VecType>
-typename BallBound<MetricType, VecType>::ElemType
-BallBound<MetricType, VecType>::MinDistance(const BallBound& other)
+template<typename MetricType, typename ElemType, typename VecType>
+ElemType
+BallBound<MetricType, ElemType, VecType>::MinDistance(const BallBound& other)
     const
 {
   if (radius < 0)
@@ -160,10 +160,10 @@ BallBound<MetricType, VecType>::MinDistance(const BallBound& other)
 /**
  * Computes maximum distance.
  */
-template<typename MetricType, typename VecType>
+template<typename MetricType, typename ElemType, typename VecType>
 template<typename OtherVecType>
-typename BallBound<MetricType, VecType>::ElemType
-BallBound<MetricType, VecType>::MaxDistance(
+ElemType
+BallBound<MetricType, ElemType, VecType>::MaxDistance(
     const OtherVecType& point,
     typename std::enable_if_t<IsVector<OtherVecType>::value>* /* junk */) const
 {
@@ -176,9 +176,9 @@ BallBound<MetricType, VecType>::MaxDistance(
 /**
  * Computes maximum distance.
  */
-template<typename MetricType, typename VecType>
-typename BallBound<MetricType, VecType>::ElemType
-BallBound<MetricType, VecType>::MaxDistance(const BallBound& other)
+template<typename MetricType, typename ElemType, typename VecType>
+ElemType
+BallBound<MetricType, ElemType, VecType>::MaxDistance(const BallBound& other)
     const
 {
   if (radius < 0)
@@ -192,10 +192,10 @@ BallBound<MetricType, VecType>::MaxDistance(const BallBound& other)
  *
  * Example: bound1.MinDistanceSq(other) for minimum squared distance.
  */
-template<typename MetricType, typename VecType>
+template<typename MetricType, typename ElemType, typename VecType>
 template<typename OtherVecType>
-math::RangeType<typename BallBound<MetricType, VecType>::ElemType>
-BallBound<MetricType, VecType>::RangeDistance(
+math::RangeType<ElemType>
+BallBound<MetricType, ElemType, VecType>::RangeDistance(
     const OtherVecType& point,
     typename std::enable_if_t<IsVector<OtherVecType>::value>* /* junk */) const
 {
@@ -210,9 +210,9 @@ BallBound<MetricType, VecType>::RangeDistance(
   }
 }
 
-template<typename MetricType, typename VecType>
-math::RangeType<typename BallBound<MetricType, VecType>::ElemType>
-BallBound<MetricType, VecType>::RangeDistance(
+template<typename MetricType, typename ElemType, typename VecType>
+math::RangeType<ElemType>
+BallBound<MetricType, ElemType, VecType>::RangeDistance(
     const BallBound& other) const
 {
   if (radius < 0)
@@ -230,9 +230,9 @@ BallBound<MetricType, VecType>::RangeDistance(
 /**
  * Expand the bound to include the given bound.
  *
-template<typename MetricType, typename VecType>
+template<typename MetricType, typename ElemType, typename VecType>
 const BallBound<VecType>&
-BallBound<MetricType, VecType>::operator|=(
+BallBound<MetricType, ElemType, VecType>::operator|=(
     const BallBound<VecType>& other)
 {
   double dist = metric->Evaluate(center, other);
@@ -250,28 +250,31 @@ BallBound<MetricType, VecType>::operator|=(
  * The difference lies in the way we initialize the ball bound. The way we
  * expand the bound is same.
  */
-template<typename MetricType, typename VecType>
+template<typename MetricType, typename ElemType, typename VecType>
 template<typename MatType>
-const BallBound<MetricType, VecType>&
-BallBound<MetricType, VecType>::operator|=(const MatType& data)
+const BallBound<MetricType, ElemType, VecType>&
+BallBound<MetricType, ElemType, VecType>::operator|=(const MatType& data)
 {
   if (radius < 0)
   {
-    center = data.col(0);
+    center = arma::conv_to<VecType>::from(data.col(0));
     radius = 0;
   }
 
   // Now iteratively add points.
   for (size_t i = 0; i < data.n_cols; ++i)
   {
-    const ElemType dist = metric->Evaluate(center, (VecType) data.col(i));
+    // Convert the point to the bound's element type; for a lower-precision
+    // bound this is where any narrowing happens.
+    const VecType point = arma::conv_to<VecType>::from(data.col(i));
+    const ElemType dist = metric->Evaluate(center, point);
 
     // See if the new point lies outside the bound.
     if (dist > radius)
     {
       // Move towards the new point and increase the radius just enough to
       // accommodate the new point.
-      const VecType diff = data.col(i) - center;
+      const VecType diff = point - center;
       center += ((dist - radius) / (2 * dist)) * diff;
       radius = 0.5 * (dist + radius);
     }
@@ -281,9 +284,9 @@ BallBound<MetricType, VecType>::operator|=(const MatType& data)
 }
 
 //! Serialize the BallBound.
-template<typename MetricType, typename VecType>
+template<typename MetricType, typename ElemType, typename VecType>
 template<typename Archive>
-void BallBound<MetricType, VecType>::serialize(
+void BallBound<MetricType, ElemType, VecType>::serialize(
     Archive& ar,
     const unsigned int /* version */)
 {
@@ -59,7 +59,7 @@ class BinarySpaceTree
   //! The type of element held in MatType.
   typedef typename MatType::elem_type ElemType;
 
-  typedef SplitType<BoundType<MetricType>, MatType> Split;
+  typedef SplitType<BoundType<MetricType, ElemType>, MatType> Split;
 
  private:
   //! The left child node.
@@ -75,7 +75,7 @@ class BinarySpaceTree
   //! children).
   size_t count;
   //! The bound object for this node.
-  BoundType<MetricType> bound;
+  BoundType<MetricType, ElemType> bound;
   //! Any extra data contained in the node.
   StatisticType stat;
   //! The distance from the centroid of this node to the centroid of the parent.
@@ -109,8 +109,12 @@ class BinarySpaceTree
    *
    * @param data Dataset to create tree from.  This will be copied!
    * @param maxLeafSize Size of each leaf in the tree.
+   * @param parallel If true, build independent subtrees with OpenMP tasks
+   *     (default false).
    */
-  BinarySpaceTree(const MatType& data, const size_t maxLeafSize = 20);
+  BinarySpaceTree(const MatType& data,
+                  const size_t maxLeafSize = 20,
+                  const bool parallel = false);
 
   /**
    * Construct this as the root node of a binary space tree using the given
@@ -123,10 +127,13 @@ class BinarySpaceTree
    * @param oldFromNew Vector which will be filled with the old positions for
    *     each new point.
    * @param maxLeafSize Size of each leaf in the tree.
+   * @param parallel If true, build independent subtrees with OpenMP tasks
+   *     (default false).
    */
   BinarySpaceTree(const MatType& data,
                   std::vector<size_t>& oldFromNew,
-                  const size_t maxLeafSize = 20);
+                  const size_t maxLeafSize = 20,
+                  const bool parallel = false);
 
   /**
    * Construct this as the root node of a binary space tree using the given
@@ -142,11 +149,14 @@ class BinarySpaceTree
    * @param newFromOld Vector which will be filled with the new positions for
    *     each old point.
    * @param maxLeafSize Size of each leaf in the tree.
+   * @param parallel If true, build independent subtrees with OpenMP tasks
+   *     (default false).
    */
   BinarySpaceTree(const MatType& data,
                   std::vector<size_t>& oldFromNew,
                   std::vector<size_t>& newFromOld,
-                  const size_t maxLeafSize = 20);
+                  const size_t maxLeafSize = 20,
+                  const bool parallel = false);
 
   /**
    * Construct this as the root node of a binary space tree using the given
@@ -156,9 +166,12 @@ class BinarySpaceTree
    *
    * @param data Dataset to create tree from.
    * @param maxLeafSize Size of each leaf in the tree.
+   * @param parallel If true, build independent subtrees with OpenMP tasks
+   *     (default false).
    */
   BinarySpaceTree(MatType&& data,
-                  const size_t maxLeafSize = 20);
+                  const size_t maxLeafSize = 20,
+                  const bool parallel = false);
 
   /**
    * Construct this as the root node of a binary space tree using the given
@@ -171,10 +184,13 @@ class BinarySpaceTree
    * @param oldFromNew Vector which will be filled with the old positions for
    *     each new point.
    * @param maxLeafSize Size of each leaf in the tree.
+   * @param parallel If true, build independent subtrees with OpenMP tasks
+   *     (default false).
    */
   BinarySpaceTree(MatType&& data,
                   std::vector<size_t>& oldFromNew,
-                  const size_t maxLeafSize = 20);
+                  const size_t maxLeafSize = 20,
+                  const bool parallel = false);
 
   /**
    * Construct this as the root node of a binary space tree using the given
@@ -190,11 +206,14 @@ class BinarySpaceTree
    * @param newFromOld Vector which will be filled with the new positions for
    *     each old point.
    * @param maxLeafSize Size of each leaf in the tree.
+   * @param parallel If true, build independent subtrees with OpenMP tasks
+   *     (default false).
    */
   BinarySpaceTree(MatType&& data,
                   std::vector<size_t>& oldFromNew,
                   std::vector<size_t>& newFromOld,
-                  const size_t maxLeafSize = 20);
+                  const size_t maxLeafSize = 20,
+                  const bool parallel = false);
 
   /**
    * Construct this node as a child of the given parent, starting at column
@@ -211,7 +230,7 @@ class BinarySpaceTree
   BinarySpaceTree(BinarySpaceTree* parent,
                   const size_t begin,
                   const size_t count,
-                  SplitType<BoundType<MetricType>, MatType>& splitter,
+                  SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
                   const size_t maxLeafSize = 20);
 
   /**
@@ -237,7 +256,7 @@ class BinarySpaceTree
                   const size_t begin,
                   const size_t count,
                   std::vector<size_t>& oldFromNew,
-                  SplitType<BoundType<MetricType>, MatType>& splitter,
+                  SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
                   const size_t maxLeafSize = 20);
 
   /**
@@ -267,7 +286,7 @@ class BinarySpaceTree
                   const size_t count,
                   std::vector<size_t>& oldFromNew,
                   std::vector<size_t>& newFromOld,
-                  SplitType<BoundType<MetricType>, MatType>& splitter,
+                  SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
                   const size_t maxLeafSize = 20);
 
   /**
@@ -316,9 +335,9 @@ class BinarySpaceTree
   ~BinarySpaceTree();
 
   //! Return the bound object for this node.
-  const BoundType<MetricType>& Bound() const { return bound; }
+  const BoundType<MetricType, ElemType>& Bound() const { return bound; }
   //! Return the bound object for this node.
-  BoundType<MetricType>& Bound() { return bound; }
+  BoundType<MetricType, ElemType>& Bound() { return bound; }
 
   //! Return the statistic object for this node.
   const StatisticType& Stat() const { return stat; }
@@ -508,6 +527,36 @@ class BinarySpaceTree
   void Center(arma::vec& center) const { bound.Center(center); }
 
  private:
+  //! Subtrees smaller than this are built serially during a parallel build.
+  static const size_t parallelBuildCutoff = 10000;
+
+  /**
+   * Split the root node, optionally inside an OpenMP parallel region so that
+   * SplitNode() can build independent subtrees as tasks.
+   *
+   * @param parallel If true, open a parallel region for the build.
+   * @param maxLeafSize Maximum number of points held in a leaf.
+   * @param splitter Instantiated SplitType object.
+   */
+  void RootSplit(const bool parallel,
+                 const size_t maxLeafSize,
+                 SplitType<BoundType<MetricType, ElemType>, MatType>& splitter);
+
+  /**
+   * Split the root node, optionally inside an OpenMP parallel region so that
+   * SplitNode() can build independent subtrees as tasks.  Also returns a list
+   * of the changed indices.
+   *
+   * @param parallel If true, open a parallel region for the build.
+   * @param oldFromNew Vector holding permuted indices.
+   * @param maxLeafSize Maximum number of points held in a leaf.
+   * @param splitter Instantiated SplitType object.
+   */
+  void RootSplit(const bool parallel,
+                 std::vector<size_t>& oldFromNew,
+                 const size_t maxLeafSize,
+                 SplitType<BoundType<MetricType, ElemType>, MatType>& splitter);
+
   /**
    * Splits the current node, assigning its left and right children recursively.
    *
@@ -515,7 +564,7 @@ class BinarySpaceTree
    * @param splitter Instantiated SplitType object.
    */
   void SplitNode(const size_t maxLeafSize,
-                 SplitType<BoundType<MetricType>, MatType>& splitter);
+                 SplitType<BoundType<MetricType, ElemType>, MatType>& splitter);
 
   /**
    * Splits the current node, assigning its left and right children recursively.
@@ -527,7 +576,7 @@ class BinarySpaceTree
    */
   void SplitNode(std::vector<size_t>& oldFromNew,
                  const size_t maxLeafSize,
-                 SplitType<BoundType<MetricType>, MatType>& splitter);
+                 SplitType<BoundType<MetricType, ElemType>, MatType>& splitter);
 
   /**
    * Update the bound of the current node. This method does not take into
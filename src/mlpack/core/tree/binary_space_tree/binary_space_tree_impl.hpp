@@ -31,7 +31,8 @@ template<typename MetricType,
 BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 BinarySpaceTree(
     const MatType& data,
-    const size_t maxLeafSize) :
+    const size_t maxLeafSize,
+    const bool parallel) :
     left(NULL),
     right(NULL),
     parent(NULL),
@@ -42,8 +43,8 @@ BinarySpaceTree(
     dataset(new MatType(data)) // Copies the dataset.
 {
   // Do the actual splitting of this node.
-  SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(maxLeafSize, splitter);
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  RootSplit(parallel, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -59,7 +60,8 @@ BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 BinarySpaceTree(
     const MatType& data,
     std::vector<size_t>& oldFromNew,
-    const size_t maxLeafSize) :
+    const size_t maxLeafSize,
+    const bool parallel) :
     left(NULL),
     right(NULL),
     parent(NULL),
@@ -75,8 +77,8 @@ BinarySpaceTree(
     oldFromNew[i] = i; // Fill with unharmed indices.
 
   // Now do the actual splitting.
-  SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  RootSplit(parallel, oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -93,7 +95,8 @@ BinarySpaceTree(
     const MatType& data,
     std::vector<size_t>& oldFromNew,
     std::vector<size_t>& newFromOld,
-    const size_t maxLeafSize) :
+    const size_t maxLeafSize,
+    const bool parallel) :
     left(NULL),
     right(NULL),
     parent(NULL),
@@ -109,8 +112,8 @@ BinarySpaceTree(
     oldFromNew[i] = i; // Fill with unharmed indices.
 
   // Now do the actual splitting.
-  SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  RootSplit(parallel, oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -128,7 +131,10 @@ template<typename MetricType,
          template<typename SplitBoundType, typename SplitMatType>
              class SplitType>
 BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
-BinarySpaceTree(MatType&& data, const size_t maxLeafSize) :
+BinarySpaceTree(
+    MatType&& data,
+    const size_t maxLeafSize,
+    const bool parallel) :
     left(NULL),
     right(NULL),
     parent(NULL),
@@ -139,8 +145,8 @@ BinarySpaceTree(MatType&& data, const size_t maxLeafSize) :
     dataset(new MatType(std::move(data)))
 {
   // Do the actual splitting of this node.
-  SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(maxLeafSize, splitter);
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  RootSplit(parallel, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -156,7 +162,8 @@ BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 BinarySpaceTree(
     MatType&& data,
     std::vector<size_t>& oldFromNew,
-    const size_t maxLeafSize) :
+    const size_t maxLeafSize,
+    const bool parallel) :
     left(NULL),
     right(NULL),
     parent(NULL),
@@ -172,8 +179,8 @@ BinarySpaceTree(
     oldFromNew[i] = i; // Fill with unharmed indices.
 
   // Now do the actual splitting.
-  SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  RootSplit(parallel, oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -190,7 +197,8 @@ BinarySpaceTree(
     MatType&& data,
     std::vector<size_t>& oldFromNew,
     std::vector<size_t>& newFromOld,
-    const size_t maxLeafSize) :
+    const size_t maxLeafSize,
+    const bool parallel) :
     left(NULL),
     right(NULL),
     parent(NULL),
@@ -206,8 +214,8 @@ BinarySpaceTree(
     oldFromNew[i] = i; // Fill with unharmed indices.
 
   // Now do the actual splitting.
-  SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  SplitType<BoundType<MetricType, ElemType>, MatType> splitter;
+  RootSplit(parallel, oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -229,7 +237,7 @@ BinarySpaceTree(
     BinarySpaceTree* parent,
     const size_t begin,
     const size_t count,
-    SplitType<BoundType<MetricType>, MatType>& splitter,
+    SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
     const size_t maxLeafSize) :
     left(NULL),
     right(NULL),
@@ -258,7 +266,7 @@ BinarySpaceTree(
     const size_t begin,
     const size_t count,
     std::vector<size_t>& oldFromNew,
-    SplitType<BoundType<MetricType>, MatType>& splitter,
+    SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
     const size_t maxLeafSize) :
     left(NULL),
     right(NULL),
@@ -292,7 +300,7 @@ BinarySpaceTree(
     const size_t count,
     std::vector<size_t>& oldFromNew,
     std::vector<size_t>& newFromOld,
-    SplitType<BoundType<MetricType>, MatType>& splitter,
+    SplitType<BoundType<MetricType, ElemType>, MatType>& splitter,
     const size_t maxLeafSize) :
     left(NULL),
     right(NULL),
@@ -858,6 +866,67 @@ inline size_t BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
   return (begin + index);
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    RootSplit(const bool parallel,
+              const size_t maxLeafSize,
+              SplitType<BoundType<MetricType, ElemType>, MatType>& splitter)
+{
+  #ifdef _OPENMP
+  if (parallel)
+  {
+    // Open a parallel region so that SplitNode() can spawn OpenMP tasks for
+    // independent subtrees; one thread starts the recursion, and subtrees
+    // below the task cutoff are built serially by whichever thread picks them
+    // up.
+    #pragma omp parallel
+    #pragma omp single
+    SplitNode(maxLeafSize, splitter);
+
+    return;
+  }
+  #else
+  (void) parallel;
+  #endif
+
+  SplitNode(maxLeafSize, splitter);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+    RootSplit(const bool parallel,
+              std::vector<size_t>& oldFromNew,
+              const size_t maxLeafSize,
+              SplitType<BoundType<MetricType, ElemType>, MatType>& splitter)
+{
+  #ifdef _OPENMP
+  if (parallel)
+  {
+    // Children fill disjoint ranges of oldFromNew, so the tasks spawned by
+    // SplitNode() never write to the same element.
+    #pragma omp parallel
+    #pragma omp single
+    SplitNode(oldFromNew, maxLeafSize, splitter);
+
+    return;
+  }
+  #else
+  (void) parallel;
+  #endif
+
+  SplitNode(oldFromNew, maxLeafSize, splitter);
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -866,7 +935,7 @@ template<typename MetricType,
              class SplitType>
 void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
     SplitNode(const size_t maxLeafSize,
-              SplitType<BoundType<MetricType>, MatType>& splitter)
+              SplitType<BoundType<MetricType, ElemType>, MatType>& splitter)
 {
   // We need to expand the bounds of this node properly.
   UpdateBound(bound);
@@ -904,10 +973,28 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
-      maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      splitter, maxLeafSize);
+  #ifdef _OPENMP
+  if (omp_in_parallel() && count >= parallelBuildCutoff)
+  {
+    // The two subtrees touch disjoint column ranges of the dataset, so they
+    // can be built as independent tasks; small subtrees stay serial to avoid
+    // task overhead.
+    #pragma omp task shared(splitter)
+    left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
+        maxLeafSize);
+    #pragma omp task shared(splitter)
+    right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
+        splitter, maxLeafSize);
+    #pragma omp taskwait
+  }
+  else
+  #endif
+  {
+    left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
+        maxLeafSize);
+    right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
+        splitter, maxLeafSize);
+  }
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -933,7 +1020,7 @@ template<typename MetricType,
 void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
 SplitNode(std::vector<size_t>& oldFromNew,
           const size_t maxLeafSize,
-          SplitType<BoundType<MetricType>, MatType>& splitter)
+          SplitType<BoundType<MetricType, ElemType>, MatType>& splitter)
 {
   // We need to expand the bounds of this node properly.
   UpdateBound(bound);
@@ -972,10 +1059,28 @@ SplitNode(std::vector<size_t>& oldFromNew,
 
   // Now that we know the split column, we will recursively split the children
   // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
-      splitter, maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      oldFromNew, splitter, maxLeafSize);
+  #ifdef _OPENMP
+  if (omp_in_parallel() && count >= parallelBuildCutoff)
+  {
+    // The two subtrees touch disjoint column ranges of the dataset (and
+    // disjoint ranges of oldFromNew), so they can be built as independent
+    // tasks; small subtrees stay serial to avoid task overhead.
+    #pragma omp task shared(splitter, oldFromNew)
+    left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
+        splitter, maxLeafSize);
+    #pragma omp task shared(splitter, oldFromNew)
+    right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
+        oldFromNew, splitter, maxLeafSize);
+    #pragma omp taskwait
+  }
+  else
+  #endif
+  {
+    left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
+        splitter, maxLeafSize);
+    right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
+        oldFromNew, splitter, maxLeafSize);
+  }
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -0,0 +1,134 @@
+/**
+ * @file core/tree/binary_space_tree/packed_tree.hpp
+ * @author Ryan Curtin
+ *
+ * A cache-friendly packed (pool-backed) representation of a built
+ * BinarySpaceTree with an HRectBound.  All nodes live contiguously in
+ * breadth-first order, child links are 32-bit indices, and the bounds are
+ * stored in structure-of-arrays form, so traversal touches a small contiguous
+ * region of memory instead of chasing heap pointers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_PACKED_TREE_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_PACKED_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * PackedTree is a read-only, flattened copy of a built BinarySpaceTree (or
+ * any binary tree exposing Left()/Right()/Begin()/Count() and an HRectBound
+ * via Bound()).  The nodes are laid out contiguously in breadth-first order;
+ * each node is 20 bytes (32-bit child, begin, and count fields), and the
+ * bound coordinates are held in two dim x numNodes matrices, so bound
+ * evaluations over many nodes are sequential memory accesses.
+ *
+ * The packed tree references the (reordered) dataset of the source tree, so
+ * the source tree's dataset must outlive the packed tree.  Point indices
+ * returned by Search() refer to that reordered dataset, exactly as the
+ * indices held by the source tree's leaves do.
+ *
+ * Search() implements exact single-tree k-nearest-neighbor search with the
+ * Euclidean metric using an explicit stack over the packed layout; it is
+ * intended for serving workloads where the tree is built once and queried
+ * many times.
+ *
+ * @tparam TreeType Type of the source tree (a BinarySpaceTree instantiation
+ *     with an HRectBound, e.g. KDTree).
+ */
+template<typename TreeType>
+class PackedTree
+{
+ public:
+  //! The element type held by the source tree's dataset.
+  typedef typename TreeType::ElemType ElemType;
+  //! The matrix type held by the source tree.
+  typedef typename TreeType::Mat MatType;
+
+  /**
+   * Flatten the given built tree into packed breadth-first storage.  The
+   * source tree can be freed afterwards, but its dataset must be kept alive.
+   *
+   * @param tree Built tree to pack.
+   */
+  PackedTree(const TreeType& tree);
+
+  //! Get the number of nodes in the packed tree.
+  size_t NumNodes() const { return nodes.size(); }
+  //! Get the dimensionality of the packed bounds.
+  size_t Dimensionality() const { return lo.n_rows; }
+
+  //! Return true if the given node is a leaf.
+  bool IsLeaf(const size_t i) const { return nodes[i].left == noChild; }
+  //! Get the index of the left child of the given node.
+  size_t Left(const size_t i) const { return nodes[i].left; }
+  //! Get the index of the right child of the given node.
+  size_t Right(const size_t i) const { return nodes[i].right; }
+  //! Get the index of the first point held by the given node's subtree.
+  size_t Begin(const size_t i) const { return nodes[i].begin; }
+  //! Get the number of points held by the given node's subtree.
+  size_t Count(const size_t i) const { return nodes[i].count; }
+
+  /**
+   * Compute the minimum distance between the bound of the given node and the
+   * given point (Euclidean metric).
+   */
+  template<typename VecType>
+  ElemType MinDistance(const size_t i, const VecType& point) const;
+
+  /**
+   * Perform exact k-nearest-neighbor search for a single query point over
+   * the packed tree.  Returned neighbor indices refer to the reordered
+   * dataset of the source tree (apply the tree's oldFromNew mapping to
+   * recover original indices).
+   *
+   * @param query Query point.
+   * @param k Number of neighbors to find.
+   * @param neighbors Vector to store neighbor indices into.
+   * @param distances Vector to store neighbor distances into.
+   */
+  template<typename VecType>
+  void Search(const VecType& query,
+              const size_t k,
+              arma::Col<size_t>& neighbors,
+              arma::Col<ElemType>& distances) const;
+
+ private:
+  //! Sentinel child index denoting "no child" (leaf).
+  static const uint32_t noChild = 0xFFFFFFFF;
+
+  /**
+   * One packed node: child links and the point range, all 32-bit.  The bound
+   * lives in the lo/hi matrices, indexed by the node's position.
+   */
+  struct PackedNode
+  {
+    uint32_t left;
+    uint32_t right;
+    uint32_t begin;
+    uint32_t count;
+  };
+
+  //! The nodes, in breadth-first order (node 0 is the root).
+  std::vector<PackedNode> nodes;
+  //! Lower bound coordinates; column i is the lower corner of node i's bound.
+  arma::Mat<ElemType> lo;
+  //! Upper bound coordinates; column i is the upper corner of node i's bound.
+  arma::Mat<ElemType> hi;
+  //! Reference to the (reordered) dataset of the source tree.
+  const MatType& dataset;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "packed_tree_impl.hpp"
+
+#endif
@@ -0,0 +1,198 @@
+/**
+ * @file core/tree/binary_space_tree/packed_tree_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the PackedTree flattened tree representation.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_PACKED_TREE_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_PACKED_TREE_IMPL_HPP
+
+// In case it hasn't already been included.
+#include "packed_tree.hpp"
+
+#include <queue>
+
+namespace mlpack {
+namespace tree {
+
+template<typename TreeType>
+PackedTree<TreeType>::PackedTree(const TreeType& tree) :
+    dataset(tree.Dataset())
+{
+  // First, count the nodes so the pool can be allocated in one shot.
+  size_t numNodes = 0;
+  std::queue<const TreeType*> countQueue;
+  countQueue.push(&tree);
+  while (!countQueue.empty())
+  {
+    const TreeType* node = countQueue.front();
+    countQueue.pop();
+    ++numNodes;
+    if (node->Left())
+      countQueue.push(node->Left());
+    if (node->Right())
+      countQueue.push(node->Right());
+  }
+
+  if (numNodes > (size_t) noChild)
+  {
+    throw std::invalid_argument("PackedTree: tree has too many nodes for "
+        "32-bit child links!");
+  }
+
+  nodes.resize(numNodes);
+  lo.set_size(tree.Dataset().n_rows, numNodes);
+  hi.set_size(tree.Dataset().n_rows, numNodes);
+
+  // Now lay the nodes out in breadth-first order.  Children of node i are
+  // assigned the next free slots when i is dequeued, so all levels are
+  // contiguous.
+  std::queue<std::pair<const TreeType*, size_t>> queue;
+  queue.push(std::make_pair(&tree, (size_t) 0));
+  size_t nextFree = 1;
+  while (!queue.empty())
+  {
+    const TreeType* node = queue.front().first;
+    const size_t index = queue.front().second;
+    queue.pop();
+
+    nodes[index].begin = (uint32_t) node->Begin();
+    nodes[index].count = (uint32_t) node->Count();
+
+    for (size_t d = 0; d < lo.n_rows; ++d)
+    {
+      lo(d, index) = node->Bound()[d].Lo();
+      hi(d, index) = node->Bound()[d].Hi();
+    }
+
+    if (node->Left())
+    {
+      nodes[index].left = (uint32_t) nextFree;
+      nodes[index].right = (uint32_t) (nextFree + 1);
+      queue.push(std::make_pair(node->Left(), nextFree));
+      queue.push(std::make_pair(node->Right(), nextFree + 1));
+      nextFree += 2;
+    }
+    else
+    {
+      nodes[index].left = noChild;
+      nodes[index].right = noChild;
+    }
+  }
+}
+
+template<typename TreeType>
+template<typename VecType>
+typename PackedTree<TreeType>::ElemType PackedTree<TreeType>::MinDistance(
+    const size_t i,
+    const VecType& point) const
+{
+  // Squared distance from the point to the box, computed over the SoA bound
+  // storage (this is the HRectBound minimum distance for the Euclidean
+  // metric).
+  ElemType sum = 0;
+  for (size_t d = 0; d < lo.n_rows; ++d)
+  {
+    const ElemType v = point[d];
+    ElemType diff = 0;
+    if (v < lo(d, i))
+      diff = lo(d, i) - v;
+    else if (v > hi(d, i))
+      diff = v - hi(d, i);
+    sum += diff * diff;
+  }
+
+  return std::sqrt(sum);
+}
+
+template<typename TreeType>
+template<typename VecType>
+void PackedTree<TreeType>::Search(const VecType& query,
+                                  const size_t k,
+                                  arma::Col<size_t>& neighbors,
+                                  arma::Col<ElemType>& distances) const
+{
+  neighbors.set_size(k);
+  distances.set_size(k);
+  neighbors.fill(size_t(-1));
+  distances.fill(std::numeric_limits<ElemType>::max());
+
+  // Depth-first traversal over the packed layout with an explicit stack; the
+  // nearer child is pushed last so it is visited first.
+  std::vector<std::pair<ElemType, uint32_t>> stack;
+  stack.reserve(64);
+  stack.push_back(std::make_pair(MinDistance(0, query), (uint32_t) 0));
+
+  while (!stack.empty())
+  {
+    const ElemType minDist = stack.back().first;
+    const uint32_t index = stack.back().second;
+    stack.pop_back();
+
+    // Prune if the node cannot contain a closer neighbor.
+    if (minDist > distances[k - 1])
+      continue;
+
+    if (nodes[index].left == noChild)
+    {
+      // Base cases against all points of the leaf.
+      const size_t begin = nodes[index].begin;
+      const size_t end = begin + nodes[index].count;
+      for (size_t p = begin; p < end; ++p)
+      {
+        ElemType sum = 0;
+        for (size_t d = 0; d < lo.n_rows; ++d)
+        {
+          const ElemType diff = query[d] - dataset(d, p);
+          sum += diff * diff;
+        }
+        const ElemType dist = std::sqrt(sum);
+
+        if (dist < distances[k - 1])
+        {
+          // Insert into the sorted k-best list.
+          size_t pos = k - 1;
+          while (pos > 0 && dist < distances[pos - 1])
+          {
+            distances[pos] = distances[pos - 1];
+            neighbors[pos] = neighbors[pos - 1];
+            --pos;
+          }
+          distances[pos] = dist;
+          neighbors[pos] = p;
+        }
+      }
+    }
+    else
+    {
+      const uint32_t left = nodes[index].left;
+      const uint32_t right = nodes[index].right;
+      const ElemType leftDist = MinDistance(left, query);
+      const ElemType rightDist = MinDistance(right, query);
+
+      // Push the farther child first so the nearer one is expanded next.
+      if (leftDist < rightDist)
+      {
+        if (rightDist <= distances[k - 1])
+          stack.push_back(std::make_pair(rightDist, right));
+        stack.push_back(std::make_pair(leftDist, left));
+      }
+      else
+      {
+        if (leftDist <= distances[k - 1])
+          stack.push_back(std::make_pair(leftDist, left));
+        stack.push_back(std::make_pair(rightDist, right));
+      }
+    }
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
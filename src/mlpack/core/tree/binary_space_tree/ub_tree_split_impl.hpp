@@ -15,6 +15,7 @@
 
 #include "ub_tree_split.hpp"
 #include <mlpack/core/tree/bounds.hpp>
+#include <mlpack/core/util/parallel.hpp>
 
 namespace mlpack {
 namespace tree {
@@ -147,13 +148,14 @@ void UBTreeSplit<BoundType, MatType>::InitializeAddresses(const MatType& data)
 {
   addresses.resize(data.n_cols);
 
-  // Calculate all addresses.
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // Calculate all addresses.  Each point is independent of the others, so the
+  // whole block may be encoded in parallel.
+  Parallel::For((size_t) 0, data.n_cols, [&](const size_t i)
   {
     addresses[i].first.zeros(data.n_rows);
     bound::addr::PointToAddress(addresses[i].first, data.col(i));
     addresses[i].second = i;
-  }
+  });
 }
 
 template<typename BoundType, typename MatType>
@@ -11,6 +11,7 @@
  */
 #include "cosine_tree.hpp"
 #include <mlpack/core/util/log.hpp>
+#include <mlpack/core/util/parallel.hpp>
 
 #include <boost/math/distributions/normal.hpp>
 
@@ -29,13 +30,14 @@ CosineTree::CosineTree(const arma::mat& dataset) :
   indices.resize(numColumns);
   l2NormsSquared.zeros(numColumns);
 
-  // Set indices and calculate squared norms of the columns.
-  for (size_t i = 0; i < numColumns; ++i)
+  // Set indices and calculate squared norms of the columns.  The columns are
+  // independent, so the norms are computed in parallel.
+  Parallel::For(0, numColumns, [&](const size_t i)
   {
     indices[i] = i;
-    double l2Norm = arma::norm(dataset.col(i), 2);
+    const double l2Norm = arma::norm(dataset.col(i), 2);
     l2NormsSquared(i) = l2Norm * l2Norm;
-  }
+  });
 
   // Frobenius norm of columns in the node.
   frobNormSquared = arma::accu(l2NormsSquared);
@@ -72,7 +74,10 @@ CosineTree::CosineTree(CosineTree& parentNode,
   // Calculate centroid of columns in the node.
   CalculateCentroid();
 
-  splitPointIndex = ColumnSampleLS();
+  // The split point is sampled by CosineNodeSplit() after this constructor
+  // returns, so that sibling nodes built concurrently do not both use the
+  // random number generator.
+  splitPointIndex = 0;
 }
 
 CosineTree::CosineTree(const arma::mat& dataset,
@@ -430,7 +435,9 @@ double CosineTree::MonteCarloError(CosineTree* node,
     projectionSize = treeQueue.size();
 
   // For each sample, calculate the weighted projection onto the current basis.
-  for (size_t i = 0; i < numSamples; ++i)
+  // The samples are independent, and the projections against the whole basis
+  // dominate the cost of the error estimate, so they run in parallel.
+  Parallel::For(0, numSamples, [&](const size_t i)
   {
     // Initialize projection as a vector of zeros.
     arma::vec projection;
@@ -463,7 +470,7 @@ double CosineTree::MonteCarloError(CosineTree* node,
 
     // Calculate the weighted projection magnitude.
     weightedMagnitudes(i) = frobProjectionSquared / probabilities(i);
-  }
+  });
 
   // Compute mean and standard deviation of the weighted samples.
   double mu = arma::mean(weightedMagnitudes);
@@ -536,9 +543,22 @@ void CosineTree::CosineNodeSplit()
       rightIndices.push_back(i);
   }
 
-  // Split the node into left and right children.
-  left = new CosineTree(*this, leftIndices);
-  right = new CosineTree(*this, rightIndices);
+  // Split the node into left and right children.  The children only read the
+  // parent and the dataset, so they are built concurrently; the expensive
+  // parts of each construction (the centroid reduction) degrade to serial
+  // when built inside this task group, so the cores are used once.
+  //
+  // The split point of each child is sampled after construction rather than
+  // inside it, so that the random number generator is not used from two
+  // tasks at once.
+  CosineTree *newLeft = NULL, *newRight = NULL;
+  Parallel::Invoke(
+      [&]() { newLeft = new CosineTree(*this, leftIndices); },
+      [&]() { newRight = new CosineTree(*this, rightIndices); });
+  newLeft->splitPointIndex = newLeft->ColumnSampleLS();
+  newRight->splitPointIndex = newRight->ColumnSampleLS();
+  left = newLeft;
+  right = newRight;
 }
 
 void CosineTree::ColumnSamplesLS(std::vector<size_t>& sampledIndices,
@@ -633,7 +653,11 @@ void CosineTree::CalculateCosines(arma::vec& cosines)
   // Initialize cosine vector as a vector of zeros.
   cosines.zeros(numColumns);
 
-  for (size_t i = 0; i < numColumns; ++i)
+  const arma::vec splitPoint = dataset->col(indices[splitPointIndex]);
+
+  // The cosines of the columns are independent of each other, so they are
+  // computed in parallel.
+  Parallel::For(0, numColumns, [&](const size_t i)
   {
     // If norm is zero, store cosine value as zero. Else, calculate cosine value
     // between two vectors.
@@ -643,23 +667,24 @@ void CosineTree::CalculateCosines(arma::vec& cosines)
     }
     else
     {
-      cosines(i) =
-          std::abs(arma::norm_dot(dataset->col(indices[splitPointIndex]),
-                                  dataset->col(indices[i])));
+      cosines(i) = std::abs(arma::norm_dot(splitPoint,
+                                           dataset->col(indices[i])));
     }
-  }
+  });
 }
 
 void CosineTree::CalculateCentroid()
 {
-  // Initialize centroid as vector of zeros.
-  centroid.zeros(dataset->n_rows);
-
-  // Calculate centroid of columns in the node.
-  for (size_t i = 0; i < numColumns; ++i)
-  {
-    centroid += dataset->col(indices[i]);
-  }
+  // Sum the columns of the node with a parallel reduction; the partials are
+  // combined in a fixed tree order, so the centroid does not depend on the
+  // thread budget beyond floating-point reassociation across blocks.
+  centroid = Parallel::ReduceFor(numColumns,
+      arma::vec(arma::zeros<arma::vec>(dataset->n_rows)),
+      [&](arma::vec& partial, const size_t i)
+      {
+        partial += dataset->col(indices[i]);
+      },
+      [](arma::vec& to, arma::vec& from) { to += from; });
   centroid /= numColumns;
 }
 
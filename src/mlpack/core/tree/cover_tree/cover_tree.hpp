@@ -433,6 +433,28 @@ class CoverTree
   //! Get the instantiated metric.
   MetricType& Metric() const { return *metric; }
 
+  /**
+   * Rearrange the dataset so that the points are held in traversal
+   * (depth-first) order.  The cover tree does not reorder the dataset during
+   * construction, so the descendant points of a node may be scattered across
+   * the entire matrix; after this pass they are contiguous, which greatly
+   * improves cache behavior of base cases during traversals.  The tree will
+   * take ownership of a rearranged copy of the dataset (the original dataset
+   * is left unmodified unless the tree already owned it).
+   *
+   * Because the points are rearranged, any indices returned by a traversal
+   * must be mapped back to the original dataset with the given oldFromNew
+   * vector, in the same way that neighbor_search/unmap.hpp handles trees that
+   * rearrange the dataset during construction: oldFromNew[i] is the original
+   * index of the point that is at index i after the rearrangement.
+   *
+   * This may only be called on the root of the tree.
+   *
+   * @param oldFromNew Will be filled with the mapping from new point indices
+   *      to old point indices.
+   */
+  void RearrangeDataset(std::vector<size_t>& oldFromNew);
+
  private:
   //! Reference to the matrix which this tree is built on.
   const MatType* dataset;
@@ -549,6 +571,34 @@ class CoverTree
    */
   void RemoveNewImplicitNodes();
 
+  /**
+   * Assign each point a position in a depth-first traversal of the tree.
+   * Several nodes may reference the same point (each self-child references the
+   * same point as its parent), so only the first encounter of a point assigns
+   * its position.  Used by RearrangeDataset().
+   *
+   * @param newFromOld Mapping from old point indices to new point indices;
+   *      must be initialized to dataset->n_cols (an invalid index) in every
+   *      element.
+   * @param oldFromNew Mapping from new point indices to old point indices.
+   * @param nextIndex The next unassigned position; incremented as positions
+   *      are assigned.
+   */
+  void BuildTraversalOrder(std::vector<size_t>& newFromOld,
+                           std::vector<size_t>& oldFromNew,
+                           size_t& nextIndex) const;
+
+  /**
+   * Recursively update the point index and dataset pointer of every node in
+   * the tree after the dataset has been rearranged.  Used by
+   * RearrangeDataset().
+   *
+   * @param newFromOld Mapping from old point indices to new point indices.
+   * @param newDataset The rearranged dataset.
+   */
+  void MapPointIndices(const std::vector<size_t>& newFromOld,
+                       const MatType* newDataset);
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
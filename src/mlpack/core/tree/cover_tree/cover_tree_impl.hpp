@@ -801,6 +801,85 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::Descendant(
   return (size_t() - 1);
 }
 
+//! Rearrange the dataset into traversal order.
+template<
+    typename MetricType,
+    typename StatisticType,
+    typename MatType,
+    typename RootPointPolicy
+>
+void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
+    RearrangeDataset(std::vector<size_t>& oldFromNew)
+{
+  if (parent != NULL)
+  {
+    Log::Fatal << "CoverTree::RearrangeDataset(): only the root of the tree "
+        << "may rearrange the dataset!" << std::endl;
+  }
+
+  // Assign each point its position in a depth-first traversal of the tree.
+  // dataset->n_cols is used as the sentinel for "not yet assigned".
+  std::vector<size_t> newFromOld(dataset->n_cols, dataset->n_cols);
+  oldFromNew.resize(dataset->n_cols);
+  size_t nextIndex = 0;
+  BuildTraversalOrder(newFromOld, oldFromNew, nextIndex);
+
+  // Build the rearranged dataset.
+  MatType* newDataset = new MatType(dataset->n_rows, dataset->n_cols);
+  for (size_t i = 0; i < dataset->n_cols; ++i)
+    newDataset->col(i) = dataset->col(oldFromNew[i]);
+
+  if (localDataset)
+    delete dataset;
+  localDataset = true;
+
+  // Update the point index and dataset pointer of every node.
+  MapPointIndices(newFromOld, newDataset);
+}
+
+//! Assign each point its position in a depth-first traversal.
+template<
+    typename MetricType,
+    typename StatisticType,
+    typename MatType,
+    typename RootPointPolicy
+>
+void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
+    BuildTraversalOrder(std::vector<size_t>& newFromOld,
+                        std::vector<size_t>& oldFromNew,
+                        size_t& nextIndex) const
+{
+  // Only the first encounter of a point assigns its position; the self-child
+  // (and its self-child, and so on) references the same point as this node.
+  if (newFromOld[point] == newFromOld.size())
+  {
+    newFromOld[point] = nextIndex;
+    oldFromNew[nextIndex] = point;
+    ++nextIndex;
+  }
+
+  for (size_t i = 0; i < children.size(); ++i)
+    children[i]->BuildTraversalOrder(newFromOld, oldFromNew, nextIndex);
+}
+
+//! Update the point indices and dataset pointers after a rearrangement.
+template<
+    typename MetricType,
+    typename StatisticType,
+    typename MatType,
+    typename RootPointPolicy
+>
+void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
+    MapPointIndices(const std::vector<size_t>& newFromOld,
+                    const MatType* newDataset)
+{
+  point = newFromOld[point];
+  dataset = newDataset;
+
+  for (size_t i = 0; i < children.size(); ++i)
+    children[i]->MapPointIndices(newFromOld, newDataset);
+}
+
 /**
  * Return the index of the nearest child node to the given query point.  If
  * this is a leaf node, it will return NumChildren() (invalid index).
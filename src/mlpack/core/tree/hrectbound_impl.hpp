@@ -14,12 +14,182 @@
 
 #include <math.h>
 
+#if defined(__AVX2__)
+  #include <immintrin.h>
+#endif
+
 // In case it has not been included yet.
 #include "hrectbound.hpp"
 
 namespace mlpack {
 namespace bound {
 
+#if defined(__AVX2__)
+namespace simd {
+
+// The RangeType<double> array underlying an HRectBound is an interleaved
+// (lo, hi) sequence; the kernels below load four ranges with two 256-bit
+// loads and deinterleave in registers with unpacklo/unpackhi.  The resulting
+// lane order is permuted, but that is irrelevant to a sum reduction.
+
+//! Horizontal sum of the four lanes of a 256-bit double vector.
+inline double HorizontalSum(const __m256d v)
+{
+  const __m128d low = _mm256_castpd256_pd128(v);
+  const __m128d high = _mm256_extractf128_pd(v, 1);
+  const __m128d sum2 = _mm_add_pd(low, high);
+  const __m128d swapped = _mm_unpackhi_pd(sum2, sum2);
+  return _mm_cvtsd_f64(_mm_add_sd(sum2, swapped));
+}
+
+/**
+ * Sum of squared per-dimension minimum distances between two interleaved
+ * (lo, hi) bound arrays (the LMetric<2> bound-to-bound kernel, without the
+ * final root).
+ */
+inline double MinDistanceSquaredSum(const double* m,
+                                    const double* o,
+                                    const size_t dim)
+{
+  const __m256d zero = _mm256_setzero_pd();
+  __m256d sum = zero;
+
+  size_t d = 0;
+  for (; d + 4 <= dim; d += 4)
+  {
+    const __m256d m0 = _mm256_loadu_pd(m + 2 * d);
+    const __m256d m1 = _mm256_loadu_pd(m + 2 * d + 4);
+    const __m256d o0 = _mm256_loadu_pd(o + 2 * d);
+    const __m256d o1 = _mm256_loadu_pd(o + 2 * d + 4);
+
+    const __m256d mLo = _mm256_unpacklo_pd(m0, m1);
+    const __m256d mHi = _mm256_unpackhi_pd(m0, m1);
+    const __m256d oLo = _mm256_unpacklo_pd(o0, o1);
+    const __m256d oHi = _mm256_unpackhi_pd(o0, o1);
+
+    // dist = max(oLo - mHi, 0) + max(mLo - oHi, 0); at most one is nonzero.
+    const __m256d lower = _mm256_max_pd(_mm256_sub_pd(oLo, mHi), zero);
+    const __m256d higher = _mm256_max_pd(_mm256_sub_pd(mLo, oHi), zero);
+    const __m256d dist = _mm256_add_pd(lower, higher);
+
+    sum = _mm256_add_pd(sum, _mm256_mul_pd(dist, dist));
+  }
+
+  double result = HorizontalSum(sum);
+
+  // Scalar tail for the remaining dimensions.
+  for (; d < dim; ++d)
+  {
+    const double lower = std::max(o[2 * d] - m[2 * d + 1], 0.0);
+    const double higher = std::max(m[2 * d] - o[2 * d + 1], 0.0);
+    const double dist = lower + higher;
+    result += dist * dist;
+  }
+
+  return result;
+}
+
+/**
+ * Sum of squared per-dimension maximum distances between two interleaved
+ * (lo, hi) bound arrays (the LMetric<2> bound-to-bound kernel, without the
+ * final root).
+ */
+inline double MaxDistanceSquaredSum(const double* m,
+                                    const double* o,
+                                    const size_t dim)
+{
+  const __m256d signMask = _mm256_set1_pd(-0.0);
+  __m256d sum = _mm256_setzero_pd();
+
+  size_t d = 0;
+  for (; d + 4 <= dim; d += 4)
+  {
+    const __m256d m0 = _mm256_loadu_pd(m + 2 * d);
+    const __m256d m1 = _mm256_loadu_pd(m + 2 * d + 4);
+    const __m256d o0 = _mm256_loadu_pd(o + 2 * d);
+    const __m256d o1 = _mm256_loadu_pd(o + 2 * d + 4);
+
+    const __m256d mLo = _mm256_unpacklo_pd(m0, m1);
+    const __m256d mHi = _mm256_unpackhi_pd(m0, m1);
+    const __m256d oLo = _mm256_unpacklo_pd(o0, o1);
+    const __m256d oHi = _mm256_unpackhi_pd(o0, o1);
+
+    // v = max(|oHi - mLo|, |mHi - oLo|).
+    const __m256d a = _mm256_andnot_pd(signMask, _mm256_sub_pd(oHi, mLo));
+    const __m256d b = _mm256_andnot_pd(signMask, _mm256_sub_pd(mHi, oLo));
+    const __m256d v = _mm256_max_pd(a, b);
+
+    sum = _mm256_add_pd(sum, _mm256_mul_pd(v, v));
+  }
+
+  double result = HorizontalSum(sum);
+
+  for (; d < dim; ++d)
+  {
+    const double v = std::max(std::fabs(o[2 * d + 1] - m[2 * d]),
+        std::fabs(m[2 * d + 1] - o[2 * d]));
+    result += v * v;
+  }
+
+  return result;
+}
+
+/**
+ * Sums of squared per-dimension minimum and maximum distances between two
+ * interleaved (lo, hi) bound arrays, computed in one pass (the LMetric<2>
+ * RangeDistance kernel, without the final roots).
+ */
+inline void RangeDistanceSquaredSums(const double* m,
+                                     const double* o,
+                                     const size_t dim,
+                                     double& loSumOut,
+                                     double& hiSumOut)
+{
+  const __m256d zero = _mm256_setzero_pd();
+  __m256d loSum = zero;
+  __m256d hiSum = zero;
+
+  size_t d = 0;
+  for (; d + 4 <= dim; d += 4)
+  {
+    const __m256d m0 = _mm256_loadu_pd(m + 2 * d);
+    const __m256d m1 = _mm256_loadu_pd(m + 2 * d + 4);
+    const __m256d o0 = _mm256_loadu_pd(o + 2 * d);
+    const __m256d o1 = _mm256_loadu_pd(o + 2 * d + 4);
+
+    const __m256d mLo = _mm256_unpacklo_pd(m0, m1);
+    const __m256d mHi = _mm256_unpackhi_pd(m0, m1);
+    const __m256d oLo = _mm256_unpacklo_pd(o0, o1);
+    const __m256d oHi = _mm256_unpackhi_pd(o0, o1);
+
+    // vLo = max(max(v1, v2), 0) and vHi = -min(v1, v2), where
+    // v1 = oLo - mHi and v2 = mLo - oHi.
+    const __m256d v1 = _mm256_sub_pd(oLo, mHi);
+    const __m256d v2 = _mm256_sub_pd(mLo, oHi);
+    const __m256d vLo = _mm256_max_pd(_mm256_max_pd(v1, v2), zero);
+    const __m256d vHi = _mm256_sub_pd(zero, _mm256_min_pd(v1, v2));
+
+    loSum = _mm256_add_pd(loSum, _mm256_mul_pd(vLo, vLo));
+    hiSum = _mm256_add_pd(hiSum, _mm256_mul_pd(vHi, vHi));
+  }
+
+  loSumOut = HorizontalSum(loSum);
+  hiSumOut = HorizontalSum(hiSum);
+
+  for (; d < dim; ++d)
+  {
+    const double v1 = o[2 * d] - m[2 * d + 1];
+    const double v2 = m[2 * d] - o[2 * d + 1];
+    const double vLo = std::max(std::max(v1, v2), 0.0);
+    const double vHi = -std::min(v1, v2);
+    loSumOut += vLo * vLo;
+    hiSumOut += vHi * vHi;
+  }
+}
+
+} // namespace simd
+#endif // __AVX2__
+
 /**
  * Empty constructor.
  */
@@ -229,6 +399,22 @@ ElemType HRectBound<MetricType, ElemType>::MinDistance(const HRectBound& other)
 {
   Log::Assert(dim == other.dim);
 
+  #if defined(__AVX2__)
+  // Explicitly vectorized kernel for the Euclidean (LMetric<2>) case with
+  // double-precision bounds; the interleaved (lo, hi) storage is
+  // deinterleaved in registers.
+  if (MetricType::Power == 2 && std::is_same<ElemType, double>::value &&
+      dim >= 4)
+  {
+    const double sqSum = simd::MinDistanceSquaredSum(
+        (const double*) bounds, (const double*) other.bounds, dim);
+    if (MetricType::TakeRoot)
+      return (ElemType) std::sqrt(sqSum);
+    else
+      return (ElemType) sqSum;
+  }
+  #endif
+
   ElemType sum = 0;
   const math::RangeType<ElemType>* mbound = bounds;
   const math::RangeType<ElemType>* obound = other.bounds;
@@ -330,10 +516,23 @@ inline ElemType HRectBound<MetricType, ElemType>::MaxDistance(
     const HRectBound& other)
     const
 {
-  ElemType sum = 0;
-
   Log::Assert(dim == other.dim);
 
+  #if defined(__AVX2__)
+  if (MetricType::Power == 2 && std::is_same<ElemType, double>::value &&
+      dim >= 4)
+  {
+    const double sqSum = simd::MaxDistanceSquaredSum(
+        (const double*) bounds, (const double*) other.bounds, dim);
+    if (MetricType::TakeRoot)
+      return (ElemType) std::sqrt(sqSum);
+    else
+      return (ElemType) sqSum;
+  }
+  #endif
+
+  ElemType sum = 0;
+
   ElemType v;
   for (size_t d = 0; d < dim; d++)
   {
@@ -371,11 +570,28 @@ inline math::RangeType<ElemType>
 HRectBound<MetricType, ElemType>::RangeDistance(
     const HRectBound& other) const
 {
+  Log::Assert(dim == other.dim);
+
+  #if defined(__AVX2__)
+  if (MetricType::Power == 2 && std::is_same<ElemType, double>::value &&
+      dim >= 4)
+  {
+    double loSqSum, hiSqSum;
+    simd::RangeDistanceSquaredSums((const double*) bounds,
+        (const double*) other.bounds, dim, loSqSum, hiSqSum);
+    if (MetricType::TakeRoot)
+    {
+      return math::RangeType<ElemType>((ElemType) std::sqrt(loSqSum),
+                                       (ElemType) std::sqrt(hiSqSum));
+    }
+    else
+      return math::RangeType<ElemType>((ElemType) loSqSum, (ElemType) hiSqSum);
+  }
+  #endif
+
   ElemType loSum = 0;
   ElemType hiSum = 0;
 
-  Log::Assert(dim == other.dim);
-
   ElemType v1, v2, vLo, vHi;
   for (size_t d = 0; d < dim; d++)
   {
@@ -515,8 +731,31 @@ HRectBound<MetricType, ElemType>::operator|=(const MatType& data)
 {
   Log::Assert(data.n_rows == dim);
 
-  arma::Col<ElemType> mins(min(data, 1));
-  arma::Col<ElemType> maxs(max(data, 1));
+  arma::Col<ElemType> mins =
+      arma::conv_to<arma::Col<ElemType>>::from(arma::min(data, 1));
+  arma::Col<ElemType> maxs =
+      arma::conv_to<arma::Col<ElemType>>::from(arma::max(data, 1));
+
+  // If the bound is stored at lower precision than the data, the conversion
+  // above rounds to nearest and may shrink the range so that an extremal
+  // point falls marginally outside of it.  Nudge any such limit one step
+  // outward, so the bound stays conservative and pruning stays correct.
+  typedef typename MatType::elem_type DataType;
+  if (std::is_floating_point<ElemType>::value &&
+      sizeof(ElemType) < sizeof(DataType))
+  {
+    const arma::Col<DataType> trueMins = arma::min(data, 1);
+    const arma::Col<DataType> trueMaxs = arma::max(data, 1);
+    for (size_t i = 0; i < dim; ++i)
+    {
+      if ((DataType) mins[i] > trueMins[i])
+        mins[i] = std::nextafter(mins[i],
+            -std::numeric_limits<ElemType>::infinity());
+      if ((DataType) maxs[i] < trueMaxs[i])
+        maxs[i] = std::nextafter(maxs[i],
+            std::numeric_limits<ElemType>::infinity());
+    }
+  }
 
   minWidth = std::numeric_limits<ElemType>::max();
   for (size_t i = 0; i < dim; ++i)
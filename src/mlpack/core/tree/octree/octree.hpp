@@ -157,6 +157,37 @@ class Octree
          std::vector<size_t>& newFromOld,
          const size_t maxLeafSize = 20);
 
+  /**
+   * Build an octree on the given dataset by Morton-encoding all points once,
+   * sorting the codes with a parallel radix sort, and deriving the tree
+   * structure from the sorted code prefixes.  This produces the same kind of
+   * tree as the constructors, but the dataset is rearranged with a single
+   * sort and one sequential gather instead of per-node passes over the data,
+   * which is much faster on large low-dimensional datasets (e.g. 3-d point
+   * clouds).
+   *
+   * The Morton codes use (64 / dimensions) bits per dimension (at most 16);
+   * if the dimensionality is greater than 64, the recursive splitting
+   * constructor strategy is used instead.
+   *
+   * @param data Dataset to create tree from.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  static Octree BuildMorton(MatType data, const size_t maxLeafSize = 20);
+
+  /**
+   * Build an octree with BuildMorton(), also filling the vector of mappings
+   * from old point indices to new point indices.
+   *
+   * @param data Dataset to create tree from.
+   * @param oldFromNew Vector which will be filled with the old positions for
+   *      each new point.
+   * @param maxLeafSize Maximum number of points in a leaf node.
+   */
+  static Octree BuildMorton(MatType data,
+                            std::vector<size_t>& oldFromNew,
+                            const size_t maxLeafSize = 20);
+
   /**
    * Construct this node as a child of the given parent, starting at column
    * begin and using count points.  The ordering of that subset of points in the
@@ -439,6 +470,24 @@ class Octree
                  std::vector<size_t>& oldFromNew,
                  const size_t maxLeafSize);
 
+  /**
+   * Recursively create the children of this node from the sorted Morton
+   * codes: all points of one child share the same code prefix at the current
+   * level, so each child's column range is found with a binary search
+   * instead of a pass over the points.  This is used by BuildMorton(), after
+   * the dataset has been rearranged into Morton order.
+   *
+   * @param codes Morton codes of the points, sorted and aligned with the
+   *      dataset columns.
+   * @param level Depth of this node (the root is at level 0).
+   * @param bitsPerDim Number of bits each dimension contributes to a code.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void MortonSplitNode(const std::vector<uint64_t>& codes,
+                       const size_t level,
+                       const size_t bitsPerDim,
+                       const size_t maxLeafSize);
+
   /**
    * This is used for sorting points while splitting.
    */
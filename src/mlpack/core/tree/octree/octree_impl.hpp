@@ -14,11 +14,96 @@
 
 #include "octree.hpp"
 #include <mlpack/core/tree/perform_split.hpp>
+#include <algorithm>
 #include <stack>
 
 namespace mlpack {
 namespace tree {
 
+//! Internal helpers for the Morton-sorted bulk build.
+namespace octree_internal {
+
+/**
+ * Stable least-significant-digit radix sort of the given Morton codes,
+ * carrying the original column indices along.  The codes are processed in
+ * 8-bit digits; each pass histograms per-thread chunks of the input, turns
+ * the histograms into disjoint output ranges with a bucket-major prefix sum,
+ * and scatters in parallel, so the sort scales with the number of threads
+ * while staying stable.
+ *
+ * @param codes Morton codes to sort.
+ * @param indices Indices to permute alongside the codes.
+ * @param activeBits Number of meaningful low bits in each code.
+ */
+inline void RadixSortMortonCodes(std::vector<uint64_t>& codes,
+                                 std::vector<size_t>& indices,
+                                 const size_t activeBits)
+{
+  const size_t n = codes.size();
+  if (n <= 1)
+    return;
+
+  #ifdef _OPENMP
+  const size_t numThreads = (size_t) omp_get_max_threads();
+  #else
+  const size_t numThreads = 1;
+  #endif
+
+  std::vector<uint64_t> codeBuffer(n);
+  std::vector<size_t> indexBuffer(n);
+  std::vector<size_t> counts(numThreads * 256);
+
+  const size_t numPasses = (activeBits + 7) / 8;
+  for (size_t pass = 0; pass < numPasses; ++pass)
+  {
+    const size_t shift = 8 * pass;
+
+    // Each thread histograms its own contiguous chunk of the input.
+    std::fill(counts.begin(), counts.end(), 0);
+    #pragma omp parallel for schedule(static, 1)
+    for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+    {
+      const size_t chunkBegin = (n * t) / numThreads;
+      const size_t chunkEnd = (n * (t + 1)) / numThreads;
+      for (size_t i = chunkBegin; i < chunkEnd; ++i)
+        counts[t * 256 + ((codes[i] >> shift) & 0xff)]++;
+    }
+
+    // Exclusive prefix sum in bucket-major, thread-minor order: every
+    // (bucket, thread) pair gets a disjoint range of output slots, and lower
+    // input positions get lower slots, which keeps the sort stable.
+    size_t total = 0;
+    for (size_t bucket = 0; bucket < 256; ++bucket)
+    {
+      for (size_t t = 0; t < numThreads; ++t)
+      {
+        const size_t c = counts[t * 256 + bucket];
+        counts[t * 256 + bucket] = total;
+        total += c;
+      }
+    }
+
+    // Scatter each chunk into its reserved slots.
+    #pragma omp parallel for schedule(static, 1)
+    for (omp_size_t t = 0; t < (omp_size_t) numThreads; ++t)
+    {
+      const size_t chunkBegin = (n * t) / numThreads;
+      const size_t chunkEnd = (n * (t + 1)) / numThreads;
+      for (size_t i = chunkBegin; i < chunkEnd; ++i)
+      {
+        const size_t slot = counts[t * 256 + ((codes[i] >> shift) & 0xff)]++;
+        codeBuffer[slot] = codes[i];
+        indexBuffer[slot] = indices[i];
+      }
+    }
+
+    codes.swap(codeBuffer);
+    indices.swap(indexBuffer);
+  }
+}
+
+} // namespace octree_internal
+
 //! Construct the tree.
 template<typename MetricType, typename StatisticType, typename MatType>
 Octree<MetricType, StatisticType, MatType>::Octree(const MatType& dataset,
@@ -340,6 +425,113 @@ Octree<MetricType, StatisticType, MatType>::Octree(
   stat = StatisticType(*this);
 }
 
+//! Build the tree from Morton-sorted points.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>
+Octree<MetricType, StatisticType, MatType>::BuildMorton(
+    MatType data,
+    const size_t maxLeafSize)
+{
+  std::vector<size_t> oldFromNew;
+  return BuildMorton(std::move(data), oldFromNew, maxLeafSize);
+}
+
+//! Build the tree from Morton-sorted points, and store mappings.
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>
+Octree<MetricType, StatisticType, MatType>::BuildMorton(
+    MatType data,
+    std::vector<size_t>& oldFromNew,
+    const size_t maxLeafSize)
+{
+  Octree root;
+  *root.dataset = std::move(data);
+  root.count = root.dataset->n_cols;
+  root.bound = bound::HRectBound<MetricType>(root.dataset->n_rows);
+
+  oldFromNew.resize(root.dataset->n_cols);
+  for (size_t i = 0; i < root.dataset->n_cols; ++i)
+    oldFromNew[i] = i;
+
+  if (root.count == 0)
+  {
+    root.stat = StatisticType(root);
+    return root;
+  }
+
+  // Calculate empirical center of data.
+  root.bound |= *root.dataset;
+  arma::vec center;
+  root.bound.Center(center);
+
+  double maxWidth = 0.0;
+  for (size_t i = 0; i < root.bound.Dim(); ++i)
+    if (root.bound[i].Hi() - root.bound[i].Lo() > maxWidth)
+      maxWidth = root.bound[i].Hi() - root.bound[i].Lo();
+
+  const size_t dims = root.dataset->n_rows;
+  const size_t bitsPerDim = (dims > 64) ? 0 :
+      std::min((size_t) 16, (size_t) 64 / dims);
+
+  if (bitsPerDim == 0 || maxWidth == 0.0)
+  {
+    // The codes cannot resolve any splits (too many dimensions, or all
+    // points identical), so fall back to the recursive splitting strategy of
+    // the constructors.
+    root.SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
+  }
+  else
+  {
+    // Quantize each point onto a 2^bitsPerDim grid over the root cell
+    // [center - maxWidth, center + maxWidth] and interleave the bits, last
+    // dimension most significant within each level---the same order in which
+    // SplitNode() halves the dimensions---so that sorted code order matches
+    // the point order the recursive build would produce.
+    const size_t n = root.dataset->n_cols;
+    const double cellsPerDim = (double) ((uint64_t) 1 << bitsPerDim);
+    std::vector<uint64_t> codes(n);
+
+    #pragma omp parallel for
+    for (omp_size_t i = 0; i < (omp_size_t) n; ++i)
+    {
+      uint64_t cells[64];
+      for (size_t d = 0; d < dims; ++d)
+      {
+        const double scaled = ((*root.dataset)(d, i) -
+            (center[d] - maxWidth)) / (2.0 * maxWidth) * cellsPerDim;
+        cells[d] = (uint64_t) std::min(std::max(std::floor(scaled), 0.0),
+            cellsPerDim - 1.0);
+      }
+
+      uint64_t code = 0;
+      for (size_t level = 0; level < bitsPerDim; ++level)
+        for (size_t d = dims; d > 0; --d)
+          code = (code << 1) |
+              ((cells[d - 1] >> (bitsPerDim - 1 - level)) & 1);
+      codes[i] = code;
+    }
+
+    octree_internal::RadixSortMortonCodes(codes, oldFromNew,
+        dims * bitsPerDim);
+
+    // Gather the points into Morton order with a single sequential pass;
+    // after this, every node of the tree is a contiguous column range.
+    MatType sorted(dims, n);
+    for (size_t i = 0; i < n; ++i)
+      sorted.col(i) = root.dataset->col(oldFromNew[i]);
+    *root.dataset = std::move(sorted);
+
+    root.MortonSplitNode(codes, 0, bitsPerDim, maxLeafSize);
+  }
+
+  root.furthestDescendantDistance = 0.5 * root.bound.Diameter();
+
+  // Initialize the statistic.
+  root.stat = StatisticType(root);
+
+  return root;
+}
+
 //! Copy the given tree.
 template<typename MetricType, typename StatisticType, typename MatType>
 Octree<MetricType, StatisticType, MatType>::Octree(const Octree& other) :
@@ -946,6 +1138,68 @@ void Octree<MetricType, StatisticType, MatType>::SplitNode(
   }
 }
 
+//! Split the node using the sorted Morton codes.
+template<typename MetricType, typename StatisticType, typename MatType>
+void Octree<MetricType, StatisticType, MatType>::MortonSplitNode(
+    const std::vector<uint64_t>& codes,
+    const size_t level,
+    const size_t bitsPerDim,
+    const size_t maxLeafSize)
+{
+  // No need to split if we have fewer than the maximum number of points in
+  // this node, and no way to split once the code bits are exhausted (any
+  // points left share a single grid cell).
+  if (count <= maxLeafSize || level >= bitsPerDim)
+    return;
+
+  // The child index of a point at this level is the group of n_rows bits
+  // that many levels below the top of its code, so all points of one child
+  // are contiguous in the sorted order and each child's range can be found
+  // with a binary search.
+  const size_t dims = dataset->n_rows;
+  const size_t lowBits = dims * (bitsPerDim - level - 1);
+
+  size_t childBegin = begin;
+  while (childBegin < begin + count)
+  {
+    const uint64_t prefix = codes[childBegin] >> lowBits;
+    const size_t childEnd = std::upper_bound(codes.begin() + childBegin,
+        codes.begin() + begin + count, prefix,
+        [lowBits](const uint64_t p, const uint64_t code)
+        { return p < (code >> lowBits); }) - codes.begin();
+
+    // The child's point range is already in place, so none of the splitting
+    // constructors apply; create it directly.
+    Octree* child = new Octree();
+    delete child->dataset; // The default constructor allocated an empty one.
+    child->dataset = dataset;
+    child->parent = this;
+    child->begin = childBegin;
+    child->count = childEnd - childBegin;
+
+    // Calculate empirical center of the child's data.
+    child->bound = bound::HRectBound<MetricType>(dims);
+    child->bound |= dataset->cols(childBegin, childEnd - 1);
+
+    child->MortonSplitNode(codes, level + 1, bitsPerDim, maxLeafSize);
+
+    // Calculate the distance from the empirical center of the child to the
+    // empirical center of this node.
+    arma::vec childCenter, ourCenter;
+    child->bound.Center(childCenter);
+    bound.Center(ourCenter);
+    child->parentDistance = metric.Evaluate(childCenter, ourCenter);
+
+    child->furthestDescendantDistance = 0.5 * child->bound.Diameter();
+
+    // Initialize the statistic.
+    child->stat = StatisticType(*child);
+
+    children.push_back(child);
+    childBegin = childEnd;
+  }
+}
+
 } // namespace tree
 } // namespace mlpack
 
@@ -245,6 +245,21 @@ class RectangleTree
    */
   void InsertPoint(const size_t point, std::vector<bool>& relevels);
 
+  /**
+   * Inserts a batch of points into the tree.  The batch is first ordered by
+   * recursive tiling, so that consecutive insertions descend to nearby
+   * leaves, and all insertions share one reinsertion-level vector, so
+   * R*-type forced reinsertion runs at most once per level for the whole
+   * batch instead of once per level per point.  This keeps the cost of
+   * streaming updates steady even when many inserted points land in the same
+   * region of the tree.
+   *
+   * This may only be called on the root node of the tree.
+   *
+   * @param pointIndices The indices of the points in the dataset to insert.
+   */
+  void InsertPoints(std::vector<size_t> pointIndices);
+
   /**
    * Inserts a node into the tree, tracking which levels have been inserted
    * into.  The node will be inserted so that the tree remains valid.
@@ -564,6 +579,35 @@ class RectangleTree
    */
   void BuildStatistics(RectangleTree* node);
 
+  /**
+   * Build the tree with Sort-Tile-Recursive (STR) bulk loading: the points
+   * are ordered by recursive tiling, packed into leaves at full fanout, and
+   * the upper levels are assembled bottom-up.  This is much faster than
+   * iterated insertion and produces a better-packed tree, but it can only be
+   * used by tree variants whose auxiliary information does not need to
+   * observe individual insertions.
+   *
+   * @param firstDataIndex The index of the first data point.
+   */
+  void BulkLoad(const size_t firstDataIndex);
+
+  /**
+   * Order the index range [rangeBegin, rangeEnd) of the given index vector by
+   * recursive tiling: the range is sorted along the given dimension and
+   * partitioned into slabs, which are tiled by the remaining dimensions (in
+   * parallel, if OpenMP is enabled).  Afterwards, consecutive runs of
+   * maxLeafSize indices form spatially compact leaves.
+   *
+   * @param indices Vector of point indices to order.
+   * @param rangeBegin First position of the range to order.
+   * @param rangeEnd One past the last position of the range to order.
+   * @param dim The dimension to sort the range along.
+   */
+  void SortTileRecursive(std::vector<size_t>& indices,
+                         const size_t rangeBegin,
+                         const size_t rangeEnd,
+                         const size_t dim) const;
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
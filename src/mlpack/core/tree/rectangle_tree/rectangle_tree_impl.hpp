@@ -16,6 +16,9 @@
 #include "rectangle_tree.hpp"
 
 #include <mlpack/core/util/log.hpp>
+#include <mlpack/core/util/parallel.hpp>
+
+#include <algorithm>
 
 namespace mlpack {
 namespace tree {
@@ -70,11 +73,23 @@ RectangleTree(const MatType& data,
     points(maxLeafSize + 1), // Add one to make splitting the node simpler.
     auxiliaryInfo(this)
 {
-  // For now, just insert the points in order.
-  RectangleTree* root = this;
+  // Tree variants whose auxiliary information does not need to observe
+  // individual insertions can be bulk-loaded, which is much faster and gives
+  // a better-packed tree.  The other variants (e.g. the Hilbert R-tree and
+  // the R+ tree family) maintain per-insertion invariants, so they are built
+  // by iterated insertion.
+  if (std::is_same<AuxiliaryInformationType<RectangleTree>,
+                   NoAuxiliaryInformation<RectangleTree>>::value)
+  {
+    BulkLoad(firstDataIndex);
+  }
+  else
+  {
+    RectangleTree* root = this;
 
-  for (size_t i = firstDataIndex; i < data.n_cols; ++i)
-    root->InsertPoint(i);
+    for (size_t i = firstDataIndex; i < data.n_cols; ++i)
+      root->InsertPoint(i);
+  }
 
   // Initialize statistic recursively after tree construction is complete.
   BuildStatistics(this);
@@ -111,11 +126,20 @@ RectangleTree(MatType&& data,
     points(maxLeafSize + 1), // Add one to make splitting the node simpler.
     auxiliaryInfo(this)
 {
-  // For now, just insert the points in order.
-  RectangleTree* root = this;
+  // See the batch constructor above: bulk loading can only be used by tree
+  // variants without insertion-dependent auxiliary information.
+  if (std::is_same<AuxiliaryInformationType<RectangleTree>,
+                   NoAuxiliaryInformation<RectangleTree>>::value)
+  {
+    BulkLoad(firstDataIndex);
+  }
+  else
+  {
+    RectangleTree* root = this;
 
-  for (size_t i = firstDataIndex; i < dataset->n_cols; ++i)
-    root->InsertPoint(i);
+    for (size_t i = firstDataIndex; i < dataset->n_cols; ++i)
+      root->InsertPoint(i);
+  }
 
   // Initialize statistic recursively after tree construction is complete.
   BuildStatistics(this);
@@ -459,6 +483,156 @@ void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
   auxiliaryInfo.NullifyData();
 }
 
+/**
+ * Build the tree with Sort-Tile-Recursive bulk loading.
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+    BulkLoad(const size_t firstDataIndex)
+{
+  if (dataset->n_cols <= firstDataIndex)
+    return;
+  const size_t n = dataset->n_cols - firstDataIndex;
+
+  // Order the points by recursive tiling, so that consecutive runs of
+  // maxLeafSize indices are spatially compact.
+  std::vector<size_t> indices(n);
+  for (size_t i = 0; i < n; ++i)
+    indices[i] = firstDataIndex + i;
+  SortTileRecursive(indices, 0, n, 0);
+
+  // If everything fits into a single node, the root is a leaf.
+  if (n <= maxLeafSize)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      points[count++] = indices[i];
+      bound |= dataset->col(indices[i]);
+    }
+    numDescendants = n;
+    return;
+  }
+
+  // Pack the ordered points into leaves at full fanout.  When the tail of the
+  // range would underfill the last leaf, the previous leaf leaves enough
+  // points behind to keep every leaf at the minimum fill.
+  std::vector<RectangleTree*> level;
+  size_t pos = 0;
+  while (pos < n)
+  {
+    size_t size = std::min(maxLeafSize, n - pos);
+    if (n - pos - size > 0 && n - pos - size < minLeafSize)
+      size = n - pos - minLeafSize;
+
+    RectangleTree* leaf = new RectangleTree(this);
+    for (size_t j = 0; j < size; ++j)
+    {
+      leaf->points[leaf->count++] = indices[pos + j];
+      leaf->bound |= dataset->col(indices[pos + j]);
+    }
+    leaf->numDescendants = size;
+    level.push_back(leaf);
+    pos += size;
+  }
+
+  // Now assemble the upper levels bottom-up, grouping consecutive nodes
+  // (which are spatially close due to the tiling) until the remaining nodes
+  // fit into the root.  The tail is redistributed in the same way as for the
+  // leaves.
+  while (level.size() > maxNumChildren)
+  {
+    std::vector<RectangleTree*> nextLevel;
+    pos = 0;
+    while (pos < level.size())
+    {
+      size_t size = std::min(maxNumChildren, level.size() - pos);
+      if (level.size() - pos - size > 0 &&
+          level.size() - pos - size < minNumChildren)
+        size = level.size() - pos - minNumChildren;
+
+      RectangleTree* node = new RectangleTree(this);
+      for (size_t j = 0; j < size; ++j)
+      {
+        RectangleTree* child = level[pos + j];
+        node->children[node->numChildren++] = child;
+        child->parent = node;
+        node->bound |= child->bound;
+        node->numDescendants += child->numDescendants;
+      }
+      nextLevel.push_back(node);
+      pos += size;
+    }
+    level = std::move(nextLevel);
+  }
+
+  // Attach what remains to this node, which becomes the root.
+  for (size_t i = 0; i < level.size(); ++i)
+  {
+    RectangleTree* child = level[i];
+    children[numChildren++] = child;
+    child->parent = this;
+    bound |= child->bound;
+    numDescendants += child->numDescendants;
+  }
+}
+
+/**
+ * Order a range of point indices by recursive tiling.
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+    SortTileRecursive(std::vector<size_t>& indices,
+                      const size_t rangeBegin,
+                      const size_t rangeEnd,
+                      const size_t dim) const
+{
+  const size_t n = rangeEnd - rangeBegin;
+  if (n <= maxLeafSize)
+    return;
+
+  // Sort the range along the current dimension.
+  std::sort(indices.begin() + rangeBegin, indices.begin() + rangeEnd,
+      [&](const size_t a, const size_t b)
+      { return (*dataset)(dim, a) < (*dataset)(dim, b); });
+
+  // The last dimension only needs the sort; the leaves are then consecutive
+  // runs of the sorted range.
+  if (dim + 1 >= dataset->n_rows)
+    return;
+
+  // Partition the range into slabs, such that each slab can be tiled into
+  // roughly equal numbers of full leaves by the remaining dimensions.  The
+  // slabs are independent, so they are tiled in parallel.
+  const size_t leaves = (n + maxLeafSize - 1) / maxLeafSize;
+  const size_t remainingDims = dataset->n_rows - dim;
+  const size_t slabs = std::max<size_t>(1, (size_t) std::ceil(
+      std::pow((double) leaves, 1.0 / (double) remainingDims)));
+  const size_t slabSize = (n + slabs - 1) / slabs;
+  if (slabSize >= n)
+    return;
+
+  Parallel::For(0, slabs, [&](const size_t s)
+  {
+    const size_t slabBegin = rangeBegin + s * slabSize;
+    if (slabBegin >= rangeEnd)
+      return;
+    SortTileRecursive(indices, slabBegin,
+        std::min(rangeEnd, slabBegin + slabSize), dim + 1);
+  });
+}
+
 /**
  * Recurse through the tree and insert the point at the leaf node chosen
  * by the heuristic.
@@ -497,6 +671,39 @@ void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
   children[descentNode]->InsertPoint(point, lvls);
 }
 
+/**
+ * Inserts a batch of points into the tree with shared reinsertion tracking.
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+                   AuxiliaryInformationType>::
+    InsertPoints(std::vector<size_t> pointIndices)
+{
+  if (pointIndices.empty())
+    return;
+
+  // Order the batch so that consecutive insertions are spatially close and
+  // tend to descend into the same subtree, which amortizes the descent and
+  // split costs across the batch.
+  SortTileRecursive(pointIndices, 0, pointIndices.size(), 0);
+
+  // All insertions share the reinsertion marks, so forced reinsertion runs at
+  // most once per level for the entire batch.  The vector is grown with
+  // fresh marks as splits deepen the tree.
+  std::vector<bool> lvls(TreeDepth(), true);
+  for (size_t i = 0; i < pointIndices.size(); ++i)
+  {
+    if (lvls.size() < TreeDepth())
+      lvls.resize(TreeDepth(), true);
+    InsertPoint(pointIndices[i], lvls);
+  }
+}
+
 /**
  * Inserts a point into the tree, tracking which levels have been inserted into.
  */
@@ -67,9 +67,9 @@ class AxisParallelProjVector
    * @param bound Bound to be projected.
    * @return Range of projected values.
    */
-  template<typename MetricType, typename VecType>
-  math::RangeType<typename VecType::elem_type> Project(
-      const bound::BallBound<MetricType, VecType>& bound) const
+  template<typename MetricType, typename ElemType, typename VecType>
+  math::RangeType<ElemType> Project(
+      const bound::BallBound<MetricType, ElemType, VecType>& bound) const
   {
     return bound[dim];
   };
@@ -128,11 +128,10 @@ class ProjVector
    * @param bound Bound to be projected.
    * @return Range of projected values.
    */
-  template<typename MetricType, typename VecType>
-  math::RangeType<typename VecType::elem_type> Project(
-      const bound::BallBound<MetricType, VecType>& bound) const
+  template<typename MetricType, typename ElemType, typename VecType>
+  math::RangeType<ElemType> Project(
+      const bound::BallBound<MetricType, ElemType, VecType>& bound) const
   {
-    typedef typename VecType::elem_type ElemType;
     const double center = Project(bound.Center());
     const ElemType radius = bound.Radius();
     return math::RangeType<ElemType>(center - radius, center + radius);
@@ -0,0 +1,97 @@
+/**
+ * @file core/tree/time_bounded_single_tree_traverser.hpp
+ * @author Ryan Curtin
+ *
+ * A hybrid greedy-then-refine traverser for latency-bounded search.  It first
+ * performs a greedy descent to the most promising leaf (like
+ * GreedySingleTreeTraverser), collecting the branches that descent pruned,
+ * then refines those branches in best-first order until a caller-supplied
+ * deadline expires.  The RuleType class must implement 'GetBestChild()',
+ * 'Score()' and 'Rescore()'.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_TIME_BOUNDED_SINGLE_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_TIME_BOUNDED_SINGLE_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A single tree traverser that trades exactness for a hard latency bound.
+ * The traversal runs in two phases:
+ *
+ *  1. Greedy descent: recurse to the child with the best score at every
+ *     level, running base cases along the way, so a full set of candidate
+ *     results is available almost immediately.  The siblings skipped during
+ *     the descent are scored and kept in a priority queue instead of being
+ *     discarded.
+ *  2. Best-first refinement: repeatedly expand the queued node with the best
+ *     score, enqueueing its children, until either the queue is exhausted
+ *     (the result is then exact, up to the rule's own approximation) or the
+ *     time budget runs out.
+ *
+ * When the traversal stops early, ErrorBound() returns the best score still
+ * outstanding in the queue: no unexamined reference point can beat that
+ * bound, which quantifies how far from exact the current-best results can
+ * be.  If the queue was exhausted, ErrorBound() returns DBL_MAX.
+ *
+ * @tparam TreeType The tree type being traversed.
+ * @tparam RuleType The rule set to use during traversal.
+ */
+template<typename TreeType, typename RuleType>
+class TimeBoundedSingleTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the time-bounded single tree traverser with the given rule
+   * set and per-Traverse() time budget.
+   *
+   * @param rule The rule set to use.
+   * @param timeBudget Time budget for each Traverse() call, in microseconds.
+   */
+  TimeBoundedSingleTreeTraverser(RuleType& rule, const size_t timeBudget);
+
+  /**
+   * Traverse the tree with the given point, stopping refinement when the
+   * time budget expires.
+   *
+   * @param queryIndex The index of the point in the query set which is being
+   *     used as the query point.
+   * @param referenceNode The tree node to be traversed.
+   */
+  void Traverse(const size_t queryIndex, TreeType& referenceNode);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+
+  //! Get the best score left unexplored when the last Traverse() stopped, or
+  //! DBL_MAX if the traversal ran to completion.
+  double ErrorBound() const { return errorBound; }
+
+ private:
+  //! Reference to the rules with which the tree will be traversed.
+  RuleType& rule;
+
+  //! Time budget for each Traverse() call, in microseconds.
+  size_t timeBudget;
+
+  //! The number of nodes which have been pruned during traversal.
+  size_t numPrunes;
+
+  //! The best score left unexplored when the last Traverse() stopped.
+  double errorBound;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "time_bounded_single_tree_traverser_impl.hpp"
+
+#endif
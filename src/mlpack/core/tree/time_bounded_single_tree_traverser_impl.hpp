@@ -0,0 +1,118 @@
+/**
+ * @file core/tree/time_bounded_single_tree_traverser_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the greedy-then-refine traverser for latency-bounded
+ * search.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_TIME_BOUNDED_SINGLE_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_TIME_BOUNDED_SINGLE_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "time_bounded_single_tree_traverser.hpp"
+
+#include <chrono>
+#include <queue>
+
+namespace mlpack {
+namespace tree {
+
+template<typename TreeType, typename RuleType>
+TimeBoundedSingleTreeTraverser<TreeType, RuleType>::
+TimeBoundedSingleTreeTraverser(RuleType& rule, const size_t timeBudget) :
+    rule(rule),
+    timeBudget(timeBudget),
+    numPrunes(0),
+    errorBound(DBL_MAX)
+{ /* Nothing to do. */ }
+
+template<typename TreeType, typename RuleType>
+void TimeBoundedSingleTreeTraverser<TreeType, RuleType>::Traverse(
+    const size_t queryIndex,
+    TreeType& referenceNode)
+{
+  // The deadline is fixed before any work happens, so the greedy phase also
+  // counts against the budget (it is cheap: one root-to-leaf path).
+  const std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::now() +
+      std::chrono::microseconds(timeBudget);
+
+  // The frontier of unexplored branches, ordered so the node with the best
+  // (smallest) score is expanded first.
+  typedef std::pair<double, TreeType*> FrontierEntry;
+  std::priority_queue<FrontierEntry, std::vector<FrontierEntry>,
+      std::greater<FrontierEntry>> frontier;
+
+  // Phase one: greedy descent to the most promising leaf, running base cases
+  // along the way so that candidate results are available immediately.  The
+  // siblings the descent skips are scored and queued instead of discarded.
+  TreeType* node = &referenceNode;
+  while (true)
+  {
+    for (size_t i = 0; i < node->NumPoints(); ++i)
+      rule.BaseCase(queryIndex, node->Point(i));
+
+    if (node->IsLeaf())
+      break;
+
+    const size_t bestChild = rule.GetBestChild(queryIndex, *node);
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+    {
+      if (i == bestChild)
+        continue;
+
+      const double score = rule.Score(queryIndex, node->Child(i));
+      if (score == DBL_MAX)
+        ++numPrunes;
+      else
+        frontier.push(FrontierEntry(score, &node->Child(i)));
+    }
+
+    node = &node->Child(bestChild);
+  }
+
+  // Phase two: best-first refinement of the queued branches until the queue
+  // is exhausted or the deadline passes.
+  while (!frontier.empty())
+  {
+    if (std::chrono::steady_clock::now() >= deadline)
+      break;
+
+    const FrontierEntry entry = frontier.top();
+    frontier.pop();
+
+    // The results may have improved since this node was scored.
+    if (rule.Rescore(queryIndex, *entry.second, entry.first) == DBL_MAX)
+    {
+      ++numPrunes;
+      continue;
+    }
+
+    TreeType* refineNode = entry.second;
+    for (size_t i = 0; i < refineNode->NumPoints(); ++i)
+      rule.BaseCase(queryIndex, refineNode->Point(i));
+
+    for (size_t i = 0; i < refineNode->NumChildren(); ++i)
+    {
+      const double score = rule.Score(queryIndex, refineNode->Child(i));
+      if (score == DBL_MAX)
+        ++numPrunes;
+      else
+        frontier.push(FrontierEntry(score, &refineNode->Child(i)));
+    }
+  }
+
+  // Whatever is left in the frontier was never examined; its best score
+  // bounds how much better any missed reference point could be.
+  errorBound = frontier.empty() ? DBL_MAX : frontier.top().first;
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
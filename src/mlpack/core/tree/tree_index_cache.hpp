@@ -0,0 +1,146 @@
+/**
+ * @file core/tree/tree_index_cache.hpp
+ * @author Ryan Curtin
+ *
+ * Defines the TreeIndexCache class, a persistent cross-run cache of built
+ * tree indexes.  The cache stores only the tree topology (bounds, node
+ * ranges, statistics) and the point permutation, keyed by a fast fingerprint
+ * of the dataset contents, so that a later run working on the same data can
+ * attach a freshly loaded dataset to the cached topology and skip tree
+ * construction entirely.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_TREE_INDEX_CACHE_HPP
+#define MLPACK_CORE_TREE_TREE_INDEX_CACHE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The TreeIndexCache class persists built tree indexes across runs.  Building
+ * a tree on a large dataset is often far more expensive than the queries that
+ * follow, and batch jobs frequently rebuild the identical tree on the
+ * identical reference file.  Serializing the whole tree does not help much,
+ * because the serialized form contains a copy of the (permuted) dataset.
+ *
+ * This cache stores only what cannot be recomputed cheaply: the tree topology
+ * and the permutation that tree building applied to the points.  An entry is
+ * keyed by a string; Fingerprint() provides a fast content hash of a dataset
+ * for use as that key, so the cache naturally invalidates when the data
+ * changes.  On a cache hit, Load() deserializes the topology, permutes the
+ * freshly loaded dataset the same way the original build did, and attaches it
+ * to the tree---no construction pass over the points is needed.
+ *
+ * The resulting tree can be handed to the tree-accepting constructors of
+ * NeighborSearch, KDE, RangeSearch, and so on, exactly like a tree built in
+ * the current process.  Any tree type that provides a loading constructor
+ * from a boost archive and a Dataset() accessor (BinarySpaceTree, Octree, and
+ * the other mlpack trees) can be cached.
+ *
+ * A typical use:
+ *
+ * @code
+ * arma::mat dataset;
+ * data::Load("reference.csv", dataset);
+ *
+ * tree::TreeIndexCache cache("/var/cache/mlpack-trees");
+ * const std::string key = tree::TreeIndexCache::Fingerprint(dataset);
+ *
+ * std::vector<size_t> oldFromNew;
+ * KDTreeType* tree = cache.Load<KDTreeType>(key, dataset, oldFromNew);
+ * if (!tree)
+ * {
+ *   tree = new KDTreeType(dataset, oldFromNew);
+ *   cache.Save(key, *tree, oldFromNew);
+ * }
+ * @endcode
+ */
+class TreeIndexCache
+{
+ public:
+  /**
+   * Create a cache that stores its entries in the given directory.  The
+   * directory must already exist; entries are regular files inside it.
+   *
+   * @param directory Directory to store cache entries in.
+   */
+  TreeIndexCache(const std::string& directory) : directory(directory) { }
+
+  /**
+   * Compute a fast fingerprint of the dataset contents, suitable as a cache
+   * key: two datasets with the same dimensions and element values receive
+   * the same fingerprint.  This is a 64-bit FNV-1a hash over the raw element
+   * memory, so it costs one sequential pass over the data.
+   *
+   * @param dataset Dataset to fingerprint.
+   * @return Fingerprint as a hexadecimal string.
+   */
+  template<typename MatType>
+  static std::string Fingerprint(const MatType& dataset);
+
+  /**
+   * Store the topology of the given tree and the permutation its build
+   * applied to the points under the given key, replacing any existing entry.
+   * The tree's dataset is not written; the tree itself is left unchanged.
+   *
+   * @param key Cache key (typically a Fingerprint() of the original data).
+   * @param tree Tree whose topology should be stored.
+   * @param oldFromNew Permutation produced when the tree was built.
+   * @return True if the entry was written successfully.
+   */
+  template<typename TreeType>
+  bool Save(const std::string& key,
+            TreeType& tree,
+            const std::vector<size_t>& oldFromNew);
+
+  /**
+   * Load the tree stored under the given key and attach the given dataset to
+   * it: the dataset (in its original order, as loaded from disk) is permuted
+   * the same way the original build permuted it, and becomes the tree's
+   * dataset.  The caller takes ownership of the returned tree.
+   *
+   * If there is no entry under the key, or the entry does not match the
+   * number of points in the dataset, NULL is returned and the tree should be
+   * built normally.
+   *
+   * @param key Cache key the tree was stored under.
+   * @param dataset Dataset in original order to attach to the tree.
+   * @param oldFromNew Vector to store the cached permutation in.
+   * @return The cached tree with the dataset attached, or NULL on a miss.
+   */
+  template<typename TreeType>
+  TreeType* Load(const std::string& key,
+                 const typename TreeType::Mat& dataset,
+                 std::vector<size_t>& oldFromNew) const;
+
+  /**
+   * Return true if the cache holds an entry under the given key.
+   *
+   * @param key Cache key to look up.
+   */
+  bool Has(const std::string& key) const;
+
+  //! Get the directory the cache stores its entries in.
+  const std::string& Directory() const { return directory; }
+
+ private:
+  //! Return the path of the entry file for the given key.
+  std::string FilePath(const std::string& key) const;
+
+  //! Directory the cache entries are stored in.
+  std::string directory;
+}; // class TreeIndexCache
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "tree_index_cache_impl.hpp"
+
+#endif
@@ -0,0 +1,162 @@
+/**
+ * @file core/tree/tree_index_cache_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the TreeIndexCache class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_TREE_INDEX_CACHE_IMPL_HPP
+#define MLPACK_CORE_TREE_TREE_INDEX_CACHE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "tree_index_cache.hpp"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/vector.hpp>
+
+namespace mlpack {
+namespace tree {
+
+template<typename MatType>
+std::string TreeIndexCache::Fingerprint(const MatType& dataset)
+{
+  // 64-bit FNV-1a over the dimensions and the raw element memory.
+  uint64_t hash = 14695981039346656037ULL;
+  const uint64_t prime = 1099511628211ULL;
+
+  auto mix = [&hash, prime](const unsigned char* bytes, const size_t length)
+  {
+    for (size_t i = 0; i < length; ++i)
+    {
+      hash ^= (uint64_t) bytes[i];
+      hash *= prime;
+    }
+  };
+
+  const size_t rows = dataset.n_rows;
+  const size_t cols = dataset.n_cols;
+  mix((const unsigned char*) &rows, sizeof(size_t));
+  mix((const unsigned char*) &cols, sizeof(size_t));
+  mix((const unsigned char*) dataset.memptr(),
+      dataset.n_elem * sizeof(typename MatType::elem_type));
+
+  std::ostringstream oss;
+  oss << std::hex << std::setfill('0') << std::setw(16) << hash;
+  return oss.str();
+}
+
+template<typename TreeType>
+bool TreeIndexCache::Save(const std::string& key,
+                          TreeType& tree,
+                          const std::vector<size_t>& oldFromNew)
+{
+  std::ofstream ofs(FilePath(key), std::ofstream::out | std::ofstream::binary);
+  if (!ofs.is_open())
+  {
+    Log::Warn << "TreeIndexCache::Save(): cannot open '" << FilePath(key)
+        << "' for writing; tree not cached." << std::endl;
+    return false;
+  }
+
+  // Swap the dataset out of the tree so that the archive holds only the
+  // topology and the permutation.  Every node shares the root's dataset
+  // object, so swapping its contents empties it for all of them; it is
+  // swapped back before returning.
+  typename TreeType::Mat& data =
+      const_cast<typename TreeType::Mat&>(tree.Dataset());
+  typename TreeType::Mat empty;
+  data.swap(empty);
+
+  bool success = true;
+  try
+  {
+    boost::archive::binary_oarchive ar(ofs);
+
+    size_t numPoints = oldFromNew.size();
+    ar << BOOST_SERIALIZATION_NVP(numPoints);
+    ar << BOOST_SERIALIZATION_NVP(oldFromNew);
+    ar << BOOST_SERIALIZATION_NVP(tree);
+  }
+  catch (boost::archive::archive_exception& e)
+  {
+    Log::Warn << "TreeIndexCache::Save(): cannot write entry '" << key
+        << "': " << e.what() << "; tree not cached." << std::endl;
+    success = false;
+  }
+
+  // Put the dataset back into the tree.
+  data.swap(empty);
+
+  return success;
+}
+
+template<typename TreeType>
+TreeType* TreeIndexCache::Load(const std::string& key,
+                               const typename TreeType::Mat& dataset,
+                               std::vector<size_t>& oldFromNew) const
+{
+  std::ifstream ifs(FilePath(key), std::ifstream::in | std::ifstream::binary);
+  if (!ifs.is_open())
+    return NULL; // Cache miss.
+
+  TreeType* tree = NULL;
+  try
+  {
+    boost::archive::binary_iarchive ar(ifs);
+
+    size_t numPoints;
+    ar >> BOOST_SERIALIZATION_NVP(numPoints);
+    if (numPoints != dataset.n_cols)
+    {
+      Log::Warn << "TreeIndexCache::Load(): entry '" << key << "' was built "
+          << "on " << numPoints << " points but the dataset has "
+          << dataset.n_cols << "; ignoring the cached tree." << std::endl;
+      return NULL;
+    }
+
+    ar >> BOOST_SERIALIZATION_NVP(oldFromNew);
+    tree = new TreeType(ar);
+  }
+  catch (boost::archive::archive_exception& e)
+  {
+    Log::Warn << "TreeIndexCache::Load(): cannot read entry '" << key << "': "
+        << e.what() << "; ignoring the cached tree." << std::endl;
+    delete tree;
+    return NULL;
+  }
+
+  // Attach the dataset: permute it the same way the original build did, and
+  // place it into the empty dataset the archive restored.
+  typename TreeType::Mat permuted(dataset.n_rows, dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    permuted.col(i) = dataset.col(oldFromNew[i]);
+
+  const_cast<typename TreeType::Mat&>(tree->Dataset()) = std::move(permuted);
+
+  return tree;
+}
+
+inline bool TreeIndexCache::Has(const std::string& key) const
+{
+  std::ifstream ifs(FilePath(key));
+  return ifs.is_open();
+}
+
+inline std::string TreeIndexCache::FilePath(const std::string& key) const
+{
+  return directory + "/" + key + ".tree";
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
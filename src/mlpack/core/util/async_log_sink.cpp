@@ -0,0 +1,219 @@
+/**
+ * @file core/util/async_log_sink.cpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the AsyncLogSink class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "async_log_sink.hpp"
+
+#include <chrono>
+#include <map>
+
+using namespace mlpack;
+using namespace mlpack::util;
+
+AsyncLogSink::AsyncLogSink(std::streambuf* downstream, const size_t capacity) :
+    lineBuffer(*this),
+    downstream(downstream),
+    enqueuePos(0),
+    dequeuePos(0),
+    droppedMessages(0),
+    pushedMessages(0),
+    writtenMessages(0),
+    flushed(true),
+    done(false)
+{
+  // Round the capacity up to a power of two, so that ring positions can be
+  // mapped to cells with a mask.
+  size_t roundedCapacity = 1;
+  while (roundedCapacity < capacity)
+    roundedCapacity *= 2;
+
+  cells.reset(new Cell[roundedCapacity]);
+  mask = roundedCapacity - 1;
+  for (size_t i = 0; i < roundedCapacity; ++i)
+    cells[i].sequence.store(i, std::memory_order_relaxed);
+
+  writer = std::thread(&AsyncLogSink::WriterLoop, this);
+}
+
+AsyncLogSink::~AsyncLogSink()
+{
+  done.store(true);
+  wakeSignal.notify_one();
+  writer.join();
+}
+
+void AsyncLogSink::Flush()
+{
+  const size_t target = pushedMessages.load();
+  while (writtenMessages.load() < target || !flushed.load())
+  {
+    wakeSignal.notify_one();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+bool AsyncLogSink::Push(std::string&& message)
+{
+  // This is a bounded multi-producer queue: each cell carries a sequence
+  // number that tells producers and the consumer whose turn it is to use the
+  // cell, so no locks are needed.
+  size_t pos = enqueuePos.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    Cell& cell = cells[pos & mask];
+    const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    const intptr_t difference = (intptr_t) sequence - (intptr_t) pos;
+
+    if (difference == 0)
+    {
+      // The cell is free; try to claim it.
+      if (enqueuePos.compare_exchange_weak(pos, pos + 1,
+          std::memory_order_relaxed))
+      {
+        cell.message = std::move(message);
+        cell.sequence.store(pos + 1, std::memory_order_release);
+        pushedMessages.fetch_add(1, std::memory_order_relaxed);
+        wakeSignal.notify_one();
+        return true;
+      }
+    }
+    else if (difference < 0)
+    {
+      // The ring is full; drop the message instead of blocking the producer.
+      droppedMessages.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    else
+    {
+      // Another producer claimed this position; reload and retry.
+      pos = enqueuePos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool AsyncLogSink::Pop(std::string& message)
+{
+  size_t pos = dequeuePos.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    Cell& cell = cells[pos & mask];
+    const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+    const intptr_t difference = (intptr_t) sequence - (intptr_t) (pos + 1);
+
+    if (difference == 0)
+    {
+      if (dequeuePos.compare_exchange_weak(pos, pos + 1,
+          std::memory_order_relaxed))
+      {
+        message = std::move(cell.message);
+        // Mark the cell free for the producer one lap ahead.
+        cell.sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+      }
+    }
+    else if (difference < 0)
+    {
+      return false; // The ring is empty.
+    }
+    else
+    {
+      pos = dequeuePos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void AsyncLogSink::WriterLoop()
+{
+  std::ostream out(downstream);
+  std::string message;
+
+  for (;;)
+  {
+    if (Pop(message))
+    {
+      flushed.store(false);
+      out << message;
+      writtenMessages.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    // The ring is empty; push the buffered output downstream before waiting.
+    out.flush();
+    flushed.store(true);
+
+    if (done.load())
+    {
+      // Drain anything that arrived between the last Pop() and the flag.
+      if (!Pop(message))
+        break;
+      flushed.store(false);
+      out << message;
+      writtenMessages.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(wakeMutex);
+    wakeSignal.wait_for(lock, std::chrono::milliseconds(1));
+  }
+}
+
+AsyncLogSink::LineBuffer::int_type AsyncLogSink::LineBuffer::overflow(
+    int_type c)
+{
+  if (c != traits_type::eof())
+  {
+    const char ch = (char) c;
+    Append(&ch, 1);
+  }
+  return c;
+}
+
+std::streamsize AsyncLogSink::LineBuffer::xsputn(const char* s,
+                                                 std::streamsize n)
+{
+  Append(s, n);
+  return n;
+}
+
+int AsyncLogSink::LineBuffer::sync()
+{
+  // An explicit flush enqueues the calling thread's partial line, if any.
+  std::string& line = PartialLine();
+  if (!line.empty())
+  {
+    sink.Push(std::move(line));
+    line.clear();
+  }
+  return 0;
+}
+
+void AsyncLogSink::LineBuffer::Append(const char* s, std::streamsize n)
+{
+  std::string& line = PartialLine();
+
+  for (std::streamsize i = 0; i < n; ++i)
+  {
+    line += s[i];
+    if (s[i] == '\n')
+    {
+      sink.Push(std::move(line));
+      line.clear();
+    }
+  }
+}
+
+std::string& AsyncLogSink::LineBuffer::PartialLine()
+{
+  // Each thread assembles its own lines (one per LineBuffer), so that
+  // messages produced concurrently by different threads cannot interleave
+  // mid-line.
+  static thread_local std::map<const void*, std::string> lines;
+  return lines[this];
+}
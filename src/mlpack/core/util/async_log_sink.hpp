@@ -0,0 +1,151 @@
+/**
+ * @file core/util/async_log_sink.hpp
+ * @author Ryan Curtin
+ *
+ * An asynchronous sink for log output.  Messages are staged in a fixed-size
+ * lock-free ring buffer and written to the downstream stream by a dedicated
+ * writer thread, so the threads that produce log output never block on
+ * iostream formatting locks or flushes.  See Log::EnableAsync().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_ASYNC_LOG_SINK_HPP
+#define MLPACK_CORE_UTIL_ASYNC_LOG_SINK_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * The AsyncLogSink class decouples log producers from the stream they log
+ * to.  It exposes a streambuf (Buffer()) that can be installed as the target
+ * of any ostream; characters written to it are assembled into lines (each
+ * thread assembles its own lines, so concurrent messages do not interleave
+ * mid-line) and enqueued on a bounded lock-free ring buffer.  A single
+ * writer thread drains the ring and writes the messages to the downstream
+ * streambuf in order.
+ *
+ * The ring has a fixed capacity: if producers outrun the writer, new
+ * messages are dropped rather than blocking the producer, and the number of
+ * dropped messages is counted (DroppedMessages()).
+ */
+class AsyncLogSink
+{
+ public:
+  /**
+   * Create the sink and start its writer thread.
+   *
+   * @param downstream The streambuf to which messages are written.
+   * @param capacity Capacity of the ring buffer, in messages (rounded up to
+   *     a power of two).
+   */
+  AsyncLogSink(std::streambuf* downstream, const size_t capacity = 4096);
+
+  /**
+   * Stop the writer thread, draining any queued messages first.
+   */
+  ~AsyncLogSink();
+
+  //! Get the streambuf that producers should write to.
+  std::streambuf* Buffer() { return &lineBuffer; }
+
+  //! Get the number of messages dropped because the ring was full.
+  size_t DroppedMessages() const { return droppedMessages.load(); }
+
+  /**
+   * Block until every message enqueued before this call has been written and
+   * the downstream stream has been flushed.
+   */
+  void Flush();
+
+ private:
+  //! A slot of the ring buffer.
+  struct Cell
+  {
+    std::atomic<size_t> sequence;
+    std::string message;
+  };
+
+  /**
+   * A streambuf that assembles the written characters into lines (one
+   * partial line per thread) and enqueues each completed line on the sink's
+   * ring buffer.
+   */
+  class LineBuffer : public std::streambuf
+  {
+   public:
+    LineBuffer(AsyncLogSink& sink) : sink(sink) { }
+
+   protected:
+    int_type overflow(int_type c);
+    std::streamsize xsputn(const char* s, std::streamsize n);
+    int sync();
+
+   private:
+    //! Append characters to the calling thread's partial line, enqueueing
+    //! every completed line.
+    void Append(const char* s, std::streamsize n);
+
+    //! Get the calling thread's partial line for this buffer.
+    std::string& PartialLine();
+
+    AsyncLogSink& sink;
+  };
+
+  //! Enqueue a message, or drop it (and count the drop) if the ring is full.
+  bool Push(std::string&& message);
+
+  //! Dequeue a message; returns false if the ring is empty.
+  bool Pop(std::string& message);
+
+  //! The writer thread's main loop.
+  void WriterLoop();
+
+  //! The streambuf exposed to producers.
+  LineBuffer lineBuffer;
+  //! Where the writer thread sends the messages.
+  std::streambuf* downstream;
+
+  //! The ring buffer cells (capacity is a power of two).
+  std::unique_ptr<Cell[]> cells;
+  //! capacity - 1; used to map positions to cells.
+  size_t mask;
+  //! The position of the next enqueue.
+  std::atomic<size_t> enqueuePos;
+  //! The position of the next dequeue (only the writer thread touches this).
+  std::atomic<size_t> dequeuePos;
+
+  //! Number of messages dropped because the ring was full.
+  std::atomic<size_t> droppedMessages;
+  //! Number of messages successfully enqueued.
+  std::atomic<size_t> pushedMessages;
+  //! Number of messages written downstream.
+  std::atomic<size_t> writtenMessages;
+  //! True when the writer has drained the ring and flushed downstream.
+  std::atomic<bool> flushed;
+  //! Set by the destructor to stop the writer thread.
+  std::atomic<bool> done;
+
+  //! Used to wake the writer thread when messages arrive.
+  std::condition_variable wakeSignal;
+  std::mutex wakeMutex;
+
+  //! The writer thread.
+  std::thread writer;
+};
+
+} // namespace util
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,241 @@
+/**
+ * @file core/util/huge_pages.hpp
+ * @author Ryan Curtin
+ *
+ * An aligned allocator for large buffers backed by huge pages.  Large matrix
+ * allocations through the default allocator are mapped in 4KB pages, and on
+ * memory-bound paths (GEMM, tree traversals over big datasets) the TLB misses
+ * of walking those pages are measurable.  HugePageBuffer tries to back an
+ * allocation with explicit huge pages (1GB, then 2MB), then with transparent
+ * huge pages, and finally falls back to an ordinary aligned heap allocation,
+ * so it can be used unconditionally.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_HUGE_PAGES_HPP
+#define MLPACK_CORE_UTIL_HUGE_PAGES_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/memory_budget.hpp>
+
+#if defined(__linux__)
+  #include <sys/mman.h>
+#endif
+
+namespace mlpack {
+
+/**
+ * An owning buffer of memory that is backed by huge pages when the system
+ * provides them.  Allocation tries, in order:
+ *
+ *  1. an explicit 1GB huge page mapping (for allocations of at least 1GB),
+ *  2. an explicit 2MB huge page mapping (for allocations of at least 2MB),
+ *  3. an anonymous mapping with transparent huge pages advised, and
+ *  4. an ordinary heap allocation.
+ *
+ * Explicit huge page mappings require the system to have huge pages reserved
+ * (e.g. via /proc/sys/vm/nr_hugepages); when none are available the fallback
+ * is silent.  The returned memory is always at least 64-byte aligned, so it
+ * is suitable for vectorized kernels, and it is zero-initialized in the
+ * mapped cases (the heap fallback is not).
+ *
+ * The buffer cannot be copied, but it can be moved.
+ */
+class HugePageBuffer
+{
+ public:
+  //! Construct an empty buffer.
+  HugePageBuffer() :
+      memory(NULL), heap(NULL), size(0), mappedSize(0), hugePages(false) { }
+
+  //! Construct a buffer of the given number of bytes.
+  explicit HugePageBuffer(const size_t bytes) :
+      memory(NULL), heap(NULL), size(0), mappedSize(0), hugePages(false)
+  {
+    Allocate(bytes);
+  }
+
+  //! Release the buffer.
+  ~HugePageBuffer() { Free(); }
+
+  //! A buffer cannot be copied.
+  HugePageBuffer(const HugePageBuffer&) = delete;
+  HugePageBuffer& operator=(const HugePageBuffer&) = delete;
+
+  //! Take ownership of another buffer's memory.
+  HugePageBuffer(HugePageBuffer&& other) :
+      memory(other.memory),
+      heap(other.heap),
+      size(other.size),
+      mappedSize(other.mappedSize),
+      hugePages(other.hugePages),
+      registration(std::move(other.registration))
+  {
+    other.memory = NULL;
+    other.heap = NULL;
+    other.size = 0;
+    other.mappedSize = 0;
+    other.hugePages = false;
+  }
+
+  //! Take ownership of another buffer's memory.
+  HugePageBuffer& operator=(HugePageBuffer&& other)
+  {
+    if (this != &other)
+    {
+      Free();
+      memory = other.memory;
+      heap = other.heap;
+      size = other.size;
+      mappedSize = other.mappedSize;
+      hugePages = other.hugePages;
+      registration = std::move(other.registration);
+      other.memory = NULL;
+      other.heap = NULL;
+      other.size = 0;
+      other.mappedSize = 0;
+      other.hugePages = false;
+    }
+    return *this;
+  }
+
+  /**
+   * Allocate a buffer of the given number of bytes, releasing any buffer that
+   * is currently held.
+   *
+   * @param bytes Number of bytes to allocate.
+   * @return true on success (an allocation of 0 bytes trivially succeeds).
+   */
+  bool Allocate(const size_t bytes)
+  {
+    // Account the buffer against the process memory budget; the mapping may
+    // be rounded up, but the requested size is what the budget tracks.
+    const bool success = AllocateMemory(bytes);
+    registration.Reset(success ? size : 0);
+    return success;
+  }
+
+ private:
+  //! Perform the actual allocation; Allocate() wraps this with the budget
+  //! accounting.
+  bool AllocateMemory(const size_t bytes)
+  {
+    Free();
+    if (bytes == 0)
+      return true;
+
+    size = bytes;
+
+    #if defined(__linux__)
+    const int prot = PROT_READ | PROT_WRITE;
+    const int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    #if defined(MAP_HUGETLB) && defined(MAP_HUGE_1GB)
+    if (bytes >= ((size_t) 1 << 30))
+    {
+      mappedSize = RoundUp(bytes, (size_t) 1 << 30);
+      void* mapping = mmap(NULL, mappedSize, prot,
+          flags | MAP_HUGETLB | MAP_HUGE_1GB, -1, 0);
+      if (mapping != MAP_FAILED)
+      {
+        memory = mapping;
+        hugePages = true;
+        return true;
+      }
+    }
+    #endif
+
+    #if defined(MAP_HUGETLB)
+    if (bytes >= ((size_t) 1 << 21))
+    {
+      // The default explicit huge page size (2MB on x86-64).
+      mappedSize = RoundUp(bytes, (size_t) 1 << 21);
+      void* mapping = mmap(NULL, mappedSize, prot, flags | MAP_HUGETLB, -1, 0);
+      if (mapping != MAP_FAILED)
+      {
+        memory = mapping;
+        hugePages = true;
+        return true;
+      }
+    }
+    #endif
+
+    // No explicit huge pages; map ordinary anonymous memory and ask the
+    // kernel to back it with transparent huge pages if it can.
+    mappedSize = RoundUp(bytes, (size_t) 1 << 21);
+    void* mapping = mmap(NULL, mappedSize, prot, flags, -1, 0);
+    if (mapping != MAP_FAILED)
+    {
+      #if defined(MADV_HUGEPAGE)
+      madvise(mapping, mappedSize, MADV_HUGEPAGE); // Best effort.
+      #endif
+      memory = mapping;
+      return true;
+    }
+    #endif
+
+    // Heap fallback: over-allocate and align to 64 bytes by hand.
+    mappedSize = 0;
+    heap = new (std::nothrow) char[bytes + 63];
+    if (heap == NULL)
+    {
+      size = 0;
+      return false;
+    }
+    memory = (void*) (((uintptr_t) heap + 63) & ~((uintptr_t) 63));
+    return true;
+  }
+
+ public:
+  //! Release the buffer, if any.
+  void Free()
+  {
+    registration.Reset(0);
+
+    #if defined(__linux__)
+    if (memory != NULL && heap == NULL)
+      munmap(memory, mappedSize);
+    #endif
+    delete[] heap;
+
+    memory = NULL;
+    heap = NULL;
+    size = 0;
+    mappedSize = 0;
+    hugePages = false;
+  }
+
+  //! Get the buffer's memory (64-byte aligned), or NULL if empty.
+  void* Memory() const { return memory; }
+  //! Get the size of the buffer in bytes, as requested at allocation.
+  size_t Size() const { return size; }
+  //! Return true if the buffer is backed by explicit huge pages.
+  bool OnHugePages() const { return hugePages; }
+
+ private:
+  //! Round `bytes` up to a multiple of `multiple` (a power of two).
+  static size_t RoundUp(const size_t bytes, const size_t multiple)
+  {
+    return (bytes + multiple - 1) & ~(multiple - 1);
+  }
+
+  //! The usable (aligned) memory.
+  void* memory;
+  //! The raw heap allocation, when the heap fallback was used.
+  char* heap;
+  //! Requested size in bytes.
+  size_t size;
+  //! Size of the mapping in bytes (0 for the heap fallback).
+  size_t mappedSize;
+  //! True if explicit huge pages back the buffer.
+  bool hugePages;
+  //! The buffer's registration against the process memory budget.
+  MemoryRegistration registration;
+};
+
+} // namespace mlpack
+
+#endif
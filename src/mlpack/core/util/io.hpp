@@ -317,6 +317,13 @@ class IO
   //! So that Timer::Start() and Timer::Stop() can access the timer variable.
   friend class Timer;
 
+  //! Holds the counter objects.
+  Counters counter;
+
+  //! So that Counter::Increment() and friends can access the counter
+  //! variable.
+  friend class Counter;
+
   //! Holds the bindingDetails objects.
   util::BindingDetails doc;
  private:
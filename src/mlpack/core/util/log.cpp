@@ -10,6 +10,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include "log.hpp"
+#include "async_log_sink.hpp"
 
 #ifdef HAS_BFD_DL
   #include "backtrace.hpp"
@@ -18,6 +19,43 @@
 using namespace mlpack;
 using namespace mlpack::util;
 
+namespace {
+
+// The installed asynchronous sink, if any, and the streambuf it replaced.
+AsyncLogSink* asyncSink = NULL;
+std::streambuf* oldBuffer = NULL;
+
+} // namespace
+
+void Log::EnableAsync(const size_t capacity)
+{
+  if (asyncSink)
+    return; // Already enabled.
+
+  // Log::Debug, Log::Info, and Log::Warn all share this destination stream;
+  // swapping its buffer routes all three through the sink.  Log::Fatal
+  // (which writes to the error stream) is deliberately left synchronous.
+  std::ostream& destination = Log::Info.destination;
+  asyncSink = new AsyncLogSink(destination.rdbuf(), capacity);
+  oldBuffer = destination.rdbuf(asyncSink->Buffer());
+}
+
+void Log::DisableAsync()
+{
+  if (!asyncSink)
+    return;
+
+  Log::Info.destination.rdbuf(oldBuffer);
+  delete asyncSink; // The destructor drains any queued messages.
+  asyncSink = NULL;
+  oldBuffer = NULL;
+}
+
+size_t Log::AsyncDroppedMessages()
+{
+  return asyncSink ? asyncSink->DroppedMessages() : 0;
+}
+
 // Only do anything for Assert() if in debugging mode.
 #ifdef DEBUG
 void Log::Assert(bool condition, const std::string& message)
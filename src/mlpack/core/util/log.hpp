@@ -64,6 +64,31 @@ class Log
   static void Assert(bool condition,
                      const std::string& message = "Assert Failed.");
 
+  /**
+   * Route the output of Log::Debug, Log::Info, and Log::Warn through an
+   * asynchronous backend: messages are staged in a fixed-size lock-free ring
+   * buffer and written by a dedicated writer thread, so logging no longer
+   * blocks the calling thread on formatting locks or flushes.  If messages
+   * are produced faster than they can be written, they are dropped rather
+   * than ever blocking the producer; AsyncDroppedMessages() reports how many
+   * were lost.  Log::Fatal always stays synchronous, so that fatal output
+   * cannot be lost.
+   *
+   * @param capacity Capacity of the ring buffer, in messages.
+   */
+  static void EnableAsync(const size_t capacity = 4096);
+
+  /**
+   * Restore synchronous logging, draining any queued messages first.
+   */
+  static void DisableAsync();
+
+  /**
+   * Get the number of messages dropped by the asynchronous backend because
+   * the ring buffer was full (0 when the backend is not enabled).
+   */
+  static size_t AsyncDroppedMessages();
+
   /**
    * MLPACK_EXPORT is required for global variables, so that they are properly
    * exported by the Windows compiler.
@@ -0,0 +1,296 @@
+/**
+ * @file core/util/memory_budget.hpp
+ * @author Ryan Curtin
+ *
+ * A process-wide memory budget with threshold callbacks.  Large allocations
+ * can be registered against a configurable budget, so schedulers and
+ * long-running services can see how much memory mlpack's big buffers hold,
+ * ask whether a planned allocation would exceed the budget, and get a
+ * callback when usage crosses a threshold — in time to switch to streaming
+ * modes or shrink batch sizes instead of being killed by the OS.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_MEMORY_BUDGET_HPP
+#define MLPACK_CORE_UTIL_MEMORY_BUDGET_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace mlpack {
+
+/**
+ * Static utility class implementing the process-wide memory budget.  The
+ * accounting is opt-in and voluntary: code that owns a large buffer calls
+ * Register() when the buffer is allocated and Deregister() when it is freed
+ * (or holds a MemoryRegistration, which does both), and the budget tracks
+ * the sum of the registered sizes.  mlpack registers its own large internal
+ * buffers (dataset load buffers, huge-page allocations); applications can
+ * register anything else they want counted.
+ *
+ * By default the budget is 0, which means unlimited: usage is still tracked,
+ * but WouldExceed() always returns false and no callbacks fire.  Setting a
+ * budget enables the threshold machinery.  Callbacks are one-shot per
+ * crossing: a callback registered at fraction 0.9 fires when usage rises
+ * across 90% of the budget, and is re-armed when usage falls back below the
+ * threshold.  Callbacks are invoked on the thread whose Register() call
+ * crossed the threshold, without any internal lock held, so they may
+ * register or release memory themselves.
+ *
+ * All methods are thread-safe.
+ */
+class MemoryBudget
+{
+ public:
+  //! Get the budget in bytes (0 means unlimited).
+  static size_t Budget()
+  {
+    std::lock_guard<std::mutex> lock(Mutex());
+    return State().budget;
+  }
+
+  //! Set the budget in bytes (0 means unlimited).
+  static void Budget(const size_t bytes)
+  {
+    std::lock_guard<std::mutex> lock(Mutex());
+    State().budget = bytes;
+    // Re-arm every callback against the new budget.
+    for (size_t i = 0; i < State().callbacks.size(); ++i)
+    {
+      State().callbacks[i].fired = (bytes > 0) &&
+          (State().used >= (size_t) (State().callbacks[i].fraction * bytes));
+    }
+  }
+
+  //! Get the total number of registered bytes.
+  static size_t Used()
+  {
+    std::lock_guard<std::mutex> lock(Mutex());
+    return State().used;
+  }
+
+  /**
+   * Return true if registering the given number of additional bytes would
+   * push usage past the budget.  Always false when the budget is unlimited.
+   * Callers planning a large allocation can use this to pick a smaller batch
+   * size or an out-of-core code path up front.
+   *
+   * @param bytes Size of the planned allocation.
+   */
+  static bool WouldExceed(const size_t bytes)
+  {
+    std::lock_guard<std::mutex> lock(Mutex());
+    return (State().budget > 0) && (State().used + bytes > State().budget);
+  }
+
+  /**
+   * Register an allocation of the given size against the budget.  Any
+   * threshold callbacks whose thresholds this crossing rises past are
+   * invoked before the call returns.
+   *
+   * @param bytes Size of the allocation.
+   */
+  static void Register(const size_t bytes)
+  {
+    std::vector<std::function<void(size_t, size_t)>> toInvoke;
+    size_t used, budget;
+    {
+      std::lock_guard<std::mutex> lock(Mutex());
+      State().used += bytes;
+      used = State().used;
+      budget = State().budget;
+      if (budget > 0)
+      {
+        for (size_t i = 0; i < State().callbacks.size(); ++i)
+        {
+          Callback& c = State().callbacks[i];
+          if (!c.fired && used >= (size_t) (c.fraction * budget))
+          {
+            c.fired = true;
+            toInvoke.push_back(c.function);
+          }
+        }
+      }
+    }
+
+    // Invoke the callbacks without the lock held.
+    for (size_t i = 0; i < toInvoke.size(); ++i)
+      toInvoke[i](used, budget);
+  }
+
+  /**
+   * Deregister a previously registered allocation.  Callbacks whose
+   * thresholds usage falls back below are re-armed.
+   *
+   * @param bytes Size of the allocation being released.
+   */
+  static void Deregister(const size_t bytes)
+  {
+    std::lock_guard<std::mutex> lock(Mutex());
+    State().used -= std::min(bytes, State().used);
+    if (State().budget > 0)
+    {
+      for (size_t i = 0; i < State().callbacks.size(); ++i)
+      {
+        Callback& c = State().callbacks[i];
+        if (c.fired &&
+            State().used < (size_t) (c.fraction * State().budget))
+          c.fired = false;
+      }
+    }
+  }
+
+  /**
+   * Add a callback that fires when usage rises across the given fraction of
+   * the budget.  Returns an identifier that can be passed to
+   * RemoveCallback().  The callback receives the usage and the budget (both
+   * in bytes) at the time of the crossing.
+   *
+   * @param fraction Fraction of the budget (e.g. 0.9) to watch.
+   * @param function Function to call on a crossing.
+   */
+  static size_t AddCallback(const double fraction,
+                            std::function<void(size_t, size_t)> function)
+  {
+    std::lock_guard<std::mutex> lock(Mutex());
+    Callback c;
+    c.id = State().nextCallbackId++;
+    c.fraction = fraction;
+    c.function = std::move(function);
+    c.fired = (State().budget > 0) &&
+        (State().used >= (size_t) (fraction * State().budget));
+    State().callbacks.push_back(std::move(c));
+    return State().callbacks.back().id;
+  }
+
+  /**
+   * Remove the callback with the given identifier.
+   *
+   * @param id Identifier returned by AddCallback().
+   */
+  static void RemoveCallback(const size_t id)
+  {
+    std::lock_guard<std::mutex> lock(Mutex());
+    for (size_t i = 0; i < State().callbacks.size(); ++i)
+    {
+      if (State().callbacks[i].id == id)
+      {
+        State().callbacks.erase(State().callbacks.begin() + i);
+        return;
+      }
+    }
+  }
+
+ private:
+  //! One registered threshold callback.
+  struct Callback
+  {
+    size_t id;
+    double fraction;
+    std::function<void(size_t, size_t)> function;
+    //! Whether the threshold has been crossed (and not yet re-armed).
+    bool fired;
+  };
+
+  //! The shared accounting state.
+  struct BudgetState
+  {
+    size_t budget = 0;
+    size_t used = 0;
+    size_t nextCallbackId = 0;
+    std::vector<Callback> callbacks;
+  };
+
+  //! Get the process-wide state.
+  static BudgetState& State()
+  {
+    static BudgetState state;
+    return state;
+  }
+
+  //! Get the mutex protecting the state.
+  static std::mutex& Mutex()
+  {
+    static std::mutex mutex;
+    return mutex;
+  }
+};
+
+/**
+ * RAII handle for a registration against the memory budget: registers the
+ * given number of bytes at construction and deregisters them at destruction.
+ * Use one of these as a member of any object that owns a large buffer:
+ *
+ * @code
+ * MemoryRegistration registration(matrix.n_elem * sizeof(double));
+ * // ... the bytes are counted until `registration` is destroyed.
+ * @endcode
+ */
+class MemoryRegistration
+{
+ public:
+  //! Create an empty registration.
+  MemoryRegistration() : bytes(0) { }
+
+  //! Register the given number of bytes.
+  explicit MemoryRegistration(const size_t bytes) : bytes(bytes)
+  {
+    MemoryBudget::Register(bytes);
+  }
+
+  //! Deregister.
+  ~MemoryRegistration()
+  {
+    MemoryBudget::Deregister(bytes);
+  }
+
+  //! A registration cannot be copied, but it can be moved.
+  MemoryRegistration(const MemoryRegistration&) = delete;
+  MemoryRegistration& operator=(const MemoryRegistration&) = delete;
+
+  MemoryRegistration(MemoryRegistration&& other) : bytes(other.bytes)
+  {
+    other.bytes = 0;
+  }
+
+  MemoryRegistration& operator=(MemoryRegistration&& other)
+  {
+    if (this != &other)
+    {
+      MemoryBudget::Deregister(bytes);
+      bytes = other.bytes;
+      other.bytes = 0;
+    }
+    return *this;
+  }
+
+  /**
+   * Replace this registration with one of a new size (for buffers that are
+   * reallocated).
+   *
+   * @param newBytes New size of the owned buffer.
+   */
+  void Reset(const size_t newBytes)
+  {
+    MemoryBudget::Deregister(bytes);
+    bytes = newBytes;
+    MemoryBudget::Register(bytes);
+  }
+
+  //! Get the registered size.
+  size_t Bytes() const { return bytes; }
+
+ private:
+  //! The number of registered bytes.
+  size_t bytes;
+};
+
+} // namespace mlpack
+
+#endif
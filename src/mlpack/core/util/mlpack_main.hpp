@@ -91,13 +91,28 @@ static const std::string testName = "";
 #include <mlpack/core/util/param.hpp>
 #include <mlpack/bindings/cli/parse_command_line.hpp>
 #include <mlpack/bindings/cli/end_program.hpp>
+#include <mlpack/bindings/cli/daemon_mode.hpp>
 
 static void mlpackMain(); // This is typically defined after this include.
 
 int main(int argc, char** argv)
 {
+  // Save the default parameter values before any parsing happens, so that
+  // daemon mode can restore them between successive commands.
+  const std::map<std::string, mlpack::util::ParamData> parameterDefaults =
+      mlpack::IO::Parameters();
+
   // Parse the command-line options; put them into CLI.
   mlpack::bindings::cli::ParseCommandLine(argc, argv);
+
+  if (mlpack::IO::HasParam("daemon"))
+  {
+    // Serve successive commands from stdin in this process instead of running
+    // once; input models are cached between commands.
+    mlpack::bindings::cli::RunDaemon(&mlpackMain, parameterDefaults, argv[0]);
+    return 0;
+  }
+
   // Enable timing.
   mlpack::Timer::EnableTiming();
 
@@ -0,0 +1,195 @@
+/**
+ * @file core/util/numa.hpp
+ * @author Ryan Curtin
+ *
+ * NUMA-aware placement utilities.  On multi-socket machines, memory pages are
+ * physically placed on the NUMA node of the thread that first writes them
+ * (first-touch policy), so a large matrix that one thread allocates and fills
+ * ends up entirely on one node, and parallel loops over it from the other
+ * sockets bottleneck on cross-socket traffic.  These helpers let parallel
+ * code spread a dataset's pages across the nodes and then iterate with the
+ * same iteration-to-thread mapping, so each thread mostly reads the memory
+ * that is local to its socket.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_NUMA_HPP
+#define MLPACK_CORE_UTIL_NUMA_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/parallel.hpp>
+
+#include <thread>
+
+#if defined(__linux__)
+  #include <sched.h>
+  #include <sys/stat.h>
+#endif
+
+namespace mlpack {
+
+/**
+ * Static utility class for NUMA-aware dataset placement.  The intended
+ * pattern for a kmeans-style workload over a large column-major matrix is:
+ *
+ * @code
+ * Numa::PinThreads();              // Keep threads from migrating off-node.
+ *
+ * arma::mat dataset(dims, n);      // Allocation maps no pages yet.
+ * Numa::FirstTouch(dataset);       // Pages land on the touching threads'
+ *                                  // nodes, spread by column range.
+ * FillDataset(dataset);            // ...then fill it (in the same order).
+ *
+ * Numa::StaticFor(0, n, [&](const size_t i)
+ * {
+ *   // Iteration i runs on the same thread that first touched column i, so
+ *   // the column is on this thread's local node.
+ * });
+ * @endcode
+ *
+ * All of these helpers are safe to call on machines with one NUMA node (or
+ * without OpenMP); they simply have no placement effect there.
+ */
+class Numa
+{
+ public:
+  /**
+   * Get the number of NUMA nodes of the machine.  On Linux this is read from
+   * sysfs; on other platforms it is reported as 1.
+   */
+  static size_t NumNodes()
+  {
+    static const size_t numNodes = CountNodes();
+    return numNodes;
+  }
+
+  /**
+   * Compute the contiguous range of columns that the given node should hold:
+   * [begin, end).  The ranges of all nodes partition [0, cols) in order and
+   * are balanced to within one column.  This is the same partition that
+   * FirstTouch() and StaticFor() produce when the thread budget is a
+   * multiple of the node count, so it can also be used to place explicit
+   * per-node copies or shards.
+   *
+   * @param cols Total number of columns.
+   * @param node Index of the node, in [0, numNodes).
+   * @param numNodes Number of nodes to partition across.
+   * @param begin Variable to store the first column of the range in.
+   * @param end Variable to store one past the last column of the range in.
+   */
+  static void PartitionColumns(const size_t cols,
+                               const size_t node,
+                               const size_t numNodes,
+                               size_t& begin,
+                               size_t& end)
+  {
+    const size_t nodes = std::max(numNodes, (size_t) 1);
+    begin = (node * cols) / nodes;
+    end = ((node + 1) * cols) / nodes;
+  }
+
+  /**
+   * Touch the memory of the given matrix from all threads, zeroing it column
+   * by column with the same static schedule that StaticFor() uses.  Under the
+   * first-touch policy each page is placed on the node of the thread that
+   * writes it, so after this call the matrix's columns are spread across the
+   * nodes in contiguous ranges.  Call this on a freshly sized matrix, before
+   * filling it: the contents are overwritten with zeros.
+   *
+   * @param matrix Matrix whose memory should be touched.
+   */
+  template<typename eT>
+  static void FirstTouch(arma::Mat<eT>& matrix)
+  {
+    const size_t rows = matrix.n_rows;
+    eT* memory = matrix.memptr();
+
+    #pragma omp parallel for schedule(static) if (!omp_in_parallel())
+    for (omp_size_t col = 0; col < (omp_size_t) matrix.n_cols; ++col)
+    {
+      eT* column = memory + (size_t) col * rows;
+      std::fill(column, column + rows, eT(0));
+    }
+  }
+
+  /**
+   * Pin each OpenMP thread to one core, round robin over the machine's
+   * cores, so that threads do not migrate between sockets and the
+   * first-touch placement stays local to them.  Linux only; on other
+   * platforms (or without OpenMP) this is a no-op.
+   *
+   * @return true if all threads were pinned successfully.
+   */
+  static bool PinThreads()
+  {
+    #if defined(HAS_OPENMP) && defined(__linux__)
+    const size_t numCpus = std::max(
+        (size_t) std::thread::hardware_concurrency(), (size_t) 1);
+
+    bool success = true;
+    #pragma omp parallel reduction(&& : success)
+    {
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET((int) ((size_t) omp_get_thread_num() % numCpus), &cpus);
+      success = (sched_setaffinity(0, sizeof(cpu_set_t), &cpus) == 0);
+    }
+
+    return success;
+    #else
+    return false;
+    #endif
+  }
+
+  /**
+   * NUMA-aware variant of Parallel::For(): call f(i) for each i in
+   * [begin, end), in parallel when called from serial code, with a static
+   * schedule.  The static schedule gives every loop over the same range the
+   * same iteration-to-thread mapping, so a loop over the columns of a matrix
+   * placed with FirstTouch() has each thread working on its node-local
+   * columns.  Iterations must be independent.
+   *
+   * @param begin First index of the loop.
+   * @param end One past the last index of the loop.
+   * @param f Function to call for each index.
+   */
+  template<typename FuncType>
+  static void StaticFor(const size_t begin, const size_t end, FuncType f)
+  {
+    #pragma omp parallel for schedule(static) if (!omp_in_parallel())
+    for (omp_size_t i = (omp_size_t) begin; i < (omp_size_t) end; ++i)
+      f((size_t) i);
+  }
+
+ private:
+  //! Count the NUMA nodes of the machine (called once).
+  static size_t CountNodes()
+  {
+    #if defined(__linux__)
+    size_t count = 0;
+    while (true)
+    {
+      std::ostringstream oss;
+      oss << "/sys/devices/system/node/node" << count;
+
+      struct stat nodeStat;
+      if (stat(oss.str().c_str(), &nodeStat) != 0 ||
+          !S_ISDIR(nodeStat.st_mode))
+        break;
+
+      ++count;
+    }
+
+    return std::max(count, (size_t) 1);
+    #else
+    return 1;
+    #endif
+  }
+};
+
+} // namespace mlpack
+
+#endif
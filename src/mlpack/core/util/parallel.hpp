@@ -0,0 +1,254 @@
+/**
+ * @file core/util/parallel.hpp
+ * @author Ryan Curtin
+ *
+ * Shared helpers for parallel execution.  These wrap the OpenMP runtime that
+ * mlpack's parallel code is already built on, providing a process-wide thread
+ * budget plus simple parallel-for and task-spawning primitives that degrade
+ * gracefully to serial execution when OpenMP is not available, and that avoid
+ * oversubscribing cores when parallel methods nest.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PARALLEL_HPP
+#define MLPACK_CORE_UTIL_PARALLEL_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <algorithm>
+
+#ifdef HAS_OPENMP
+  #include <omp.h>
+#endif
+
+namespace mlpack {
+
+/**
+ * Static utility class for parallel execution.  All parallelism in mlpack is
+ * scheduled by OpenMP, so these helpers deliberately do not introduce a
+ * second scheduler; instead they give one place to set the thread budget and
+ * express common parallel patterns, with the important property that a
+ * parallel loop or task group started from inside an already-parallel region
+ * runs serially on the calling thread, so nested parallel methods use the
+ * machine's cores once instead of multiplying them.
+ *
+ * When mlpack is built without OpenMP, every helper runs its work serially
+ * and the thread budget is fixed at 1.
+ */
+class Parallel
+{
+ public:
+  /**
+   * Get the process-wide thread budget: the number of threads that a parallel
+   * region started from serial code may use.
+   */
+  static size_t NumThreads()
+  {
+    #ifdef HAS_OPENMP
+    return (size_t) omp_get_max_threads();
+    #else
+    return 1;
+    #endif
+  }
+
+  /**
+   * Set the process-wide thread budget.  This applies to all subsequent
+   * parallel regions in the process, including the ad-hoc OpenMP loops inside
+   * individual methods.  A budget of 0 is treated as 1.
+   *
+   * @param numThreads Maximum number of threads to use.
+   */
+  static void NumThreads(const size_t numThreads)
+  {
+    #ifdef HAS_OPENMP
+    omp_set_num_threads((int) std::max(numThreads, (size_t) 1));
+    #else
+    // Without OpenMP there is only ever one thread.
+    (void) numThreads;
+    #endif
+  }
+
+  /**
+   * Whether deterministic parallel reductions are requested.  Parallel
+   * reductions add floating-point partial results in an order that normally
+   * depends on run-time scheduling, so repeated runs of the same computation
+   * can differ in the last bits.  With this flag set, ReduceFor() assigns the
+   * loop blocks to threads statically and combines the partials in a fixed
+   * tree order, making results bitwise reproducible from run to run for a
+   * fixed thread budget (results still differ between different budgets).
+   * The flag is off by default, since static scheduling can balance load
+   * worse than dynamic scheduling.
+   */
+  static bool& Deterministic()
+  {
+    static bool deterministic = false;
+    return deterministic;
+  }
+
+  /**
+   * Parallel reduction over the blocks [0, numBlocks): call body(partial,
+   * block) for every block, where each thread accumulates into its own
+   * partial result (initialized by copying the given identity), then combine
+   * the partials with join(to, from) and return the combined result.  The
+   * partials are always combined in a fixed pairwise tree order; with
+   * Deterministic() set the blocks are also assigned to threads statically,
+   * so the returned value is bitwise reproducible for a fixed thread budget.
+   *
+   * @param numBlocks Number of blocks of the loop.
+   * @param identity Initial value of each partial result.
+   * @param body Function called as body(partial, block) for each block.
+   * @param join Function called as join(to, from) to combine two partials.
+   * @return The combination of all partial results.
+   */
+  template<typename PartialType, typename BodyType, typename JoinType>
+  static PartialType ReduceFor(const size_t numBlocks,
+                               const PartialType& identity,
+                               BodyType body,
+                               JoinType join)
+  {
+    const size_t numPartials = InParallelRegion() ? 1 : NumThreads();
+    std::vector<PartialType> partials(numPartials, identity);
+
+    if (Deterministic())
+    {
+      // The static schedule fixes which blocks each partial accumulates.
+      #pragma omp parallel for schedule(static) if (!omp_in_parallel())
+      for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+        body(partials[PartialIndex(numPartials)], (size_t) block);
+    }
+    else
+    {
+      #pragma omp parallel for schedule(dynamic) if (!omp_in_parallel())
+      for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+        body(partials[PartialIndex(numPartials)], (size_t) block);
+    }
+
+    // Combine the partials pairwise in a tree order that depends only on
+    // their number.
+    for (size_t stride = 1; stride < numPartials; stride *= 2)
+      for (size_t i = 0; i + stride < numPartials; i += 2 * stride)
+        join(partials[i], partials[i + stride]);
+
+    return std::move(partials[0]);
+  }
+
+  /**
+   * Return true if the calling thread is already inside a parallel region.
+   * Parallel helpers use this to fall back to serial execution instead of
+   * oversubscribing the machine.
+   */
+  static bool InParallelRegion()
+  {
+    #ifdef HAS_OPENMP
+    return (omp_in_parallel() != 0);
+    #else
+    return false;
+    #endif
+  }
+
+  /**
+   * Call f(i) for each i in [begin, end), in parallel when called from serial
+   * code.  Iterations must be independent; no ordering is guaranteed.
+   *
+   * @param begin First index of the loop.
+   * @param end One past the last index of the loop.
+   * @param f Function to call for each index.
+   */
+  template<typename FuncType>
+  static void For(const size_t begin, const size_t end, FuncType f)
+  {
+    // The if clause makes the loop serial when we are already inside a
+    // parallel region, so nested parallel loops do not oversubscribe cores.
+    #pragma omp parallel for if (!omp_in_parallel())
+    for (omp_size_t i = (omp_size_t) begin; i < (omp_size_t) end; ++i)
+      f((size_t) i);
+  }
+
+  /**
+   * Call f(blockBegin, blockEnd) for each block of at most blockSize
+   * consecutive indices covering [begin, end), in parallel when called from
+   * serial code.  Blocking amortizes per-iteration overhead and lets the
+   * function use batch (matrix-matrix) kernels on each block; see
+   * NaiveKMeans::Iterate() for the pattern this captures.
+   *
+   * @param begin First index of the loop.
+   * @param end One past the last index of the loop.
+   * @param blockSize Maximum number of indices in one block.
+   * @param f Function to call with each [blockBegin, blockEnd) range.
+   */
+  template<typename FuncType>
+  static void For(const size_t begin,
+                  const size_t end,
+                  const size_t blockSize,
+                  FuncType f)
+  {
+    const size_t numBlocks = (end - begin + blockSize - 1) / blockSize;
+
+    #pragma omp parallel for if (!omp_in_parallel())
+    for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+    {
+      const size_t blockBegin = begin + (size_t) block * blockSize;
+      const size_t blockEnd = std::min(blockBegin + blockSize, end);
+      f(blockBegin, blockEnd);
+    }
+  }
+
+  /**
+   * Run each of the given nullary functions, possibly concurrently, and
+   * return when all of them have finished.  When called from inside a
+   * parallel region the tasks are run by the existing thread team, so nested
+   * use does not create extra threads.
+   *
+   * @param tasks Functions to run.
+   */
+  template<typename... TaskTypes>
+  static void Invoke(TaskTypes&&... tasks)
+  {
+    if (!InParallelRegion())
+    {
+      // One thread spawns all of the tasks; the rest of the team picks them
+      // up.  The implicit barrier at the end of the region waits for them.
+      #pragma omp parallel
+      #pragma omp single
+      SpawnTasks(std::forward<TaskTypes>(tasks)...);
+    }
+    else
+    {
+      SpawnTasks(std::forward<TaskTypes>(tasks)...);
+      #pragma omp taskwait
+    }
+  }
+
+ private:
+  //! Index of the calling thread's partial result in ReduceFor().
+  static size_t PartialIndex(const size_t numPartials)
+  {
+    #ifdef HAS_OPENMP
+    return (numPartials == 1) ? 0 : (size_t) omp_get_thread_num();
+    #else
+    (void) numPartials;
+    return 0;
+    #endif
+  }
+
+  //! Base case of task spawning: nothing left to spawn.
+  static void SpawnTasks() { }
+
+  //! Spawn the first task, then the rest.  Without OpenMP the pragma is
+  //! ignored and the tasks simply run one after another.
+  template<typename TaskType, typename... RestTypes>
+  static void SpawnTasks(TaskType&& task, RestTypes&&... rest)
+  {
+    #pragma omp task
+    task();
+
+    SpawnTasks(std::forward<RestTypes>(rest)...);
+  }
+};
+
+} // namespace mlpack
+
+#endif
@@ -16,6 +16,7 @@
 #include "log.hpp"
 
 #include <map>
+#include <memory>
 #include <string>
 
 using namespace mlpack;
@@ -38,6 +39,22 @@ void Timer::Stop(const string& name)
   IO::GetSingleton().timer.StopTimer(name, this_thread::get_id());
 }
 
+/**
+ * Start a possibly-nested scope of the given timer.
+ */
+void Timer::Push(const string& name)
+{
+  IO::GetSingleton().timer.PushTimer(name);
+}
+
+/**
+ * End the innermost running scope of the given timer.
+ */
+void Timer::Pop(const string& name)
+{
+  IO::GetSingleton().timer.PopTimer(name);
+}
+
 /**
  * Get the given timer, summing over all threads.
  */
@@ -64,19 +81,157 @@ void Timer::ResetAll()
   IO::GetSingleton().timer.Reset();
 }
 
+namespace {
+
+// The current time in microseconds since the clock epoch, in the form stored
+// by LocalTimer::startTime.
+int64_t NowUs()
+{
+  return duration_cast<microseconds>(
+      high_resolution_clock::now().time_since_epoch()).count();
+}
+
+// Escape a string for inclusion in JSON output.  Timer and counter names are
+// simple identifiers, so escaping the quote and backslash is sufficient.
+string JsonEscape(const string& input)
+{
+  string output;
+  for (const char c : input)
+  {
+    if (c == '"' || c == '\\')
+      output += '\\';
+    output += c;
+  }
+  return output;
+}
+
+} // namespace
+
+// Dump all timers and counters as JSON.
+void Timer::DumpJSON(ostream& stream)
+{
+  stream << "{\"timers\": ";
+  IO::GetSingleton().timer.PrintJSON(stream);
+  stream << ", \"counters\": ";
+  IO::GetSingleton().counter.PrintJSON(stream);
+  stream << "}";
+}
+
+/**
+ * Add the given amount to the named counter.
+ */
+void Counter::Increment(const string& name, const uint64_t amount)
+{
+  IO::GetSingleton().counter.Increment(name, amount);
+}
+
+/**
+ * Get the value of the given counter.
+ */
+uint64_t Counter::Get(const string& name)
+{
+  return IO::GetSingleton().counter.Get(name);
+}
+
+// Enable counting.
+void Counter::EnableCounting()
+{
+  IO::GetSingleton().counter.Enabled() = true;
+}
+
+// Disable counting.
+void Counter::DisableCounting()
+{
+  IO::GetSingleton().counter.Enabled() = false;
+}
+
+// Reset all counters.
+void Counter::ResetAll()
+{
+  IO::GetSingleton().counter.Reset();
+}
+
+Timers::ThreadState& Timers::LocalState()
+{
+  // Each thread registers one state per Timers object on first use, and
+  // retires it (folding its totals into retiredTimers) when the thread
+  // exits.
+  struct Registration
+  {
+    Timers& owner;
+    ThreadState state;
+
+    Registration(Timers& owner) : owner(owner)
+    {
+      state.threadId = this_thread::get_id();
+      lock_guard<mutex> lock(owner.timersMutex);
+      owner.threadStates.push_back(&state);
+    }
+
+    ~Registration() { owner.RetireThread(&state); }
+  };
+
+  static thread_local map<const Timers*, unique_ptr<Registration>> states;
+  unique_ptr<Registration>& registration = states[this];
+  if (!registration)
+    registration.reset(new Registration(*this));
+  return registration->state;
+}
+
+Timers::LocalTimer& Timers::GetLocalTimer(const string& timerName)
+{
+  ThreadState& state = LocalState();
+  const auto it = state.localTimers.find(timerName);
+  if (it != state.localTimers.end())
+    return it->second;
+
+  // First use of this name in this thread.  Insertions are locked so that
+  // merged reporting can safely walk the map from other threads; map
+  // references stay valid afterwards, so the hot path above stays lock-free.
+  lock_guard<mutex> lock(state.mapMutex);
+  return state.localTimers[timerName];
+}
+
+void Timers::RetireThread(ThreadState* state)
+{
+  lock_guard<mutex> lock(timersMutex);
+  const int64_t currTime = NowUs();
+  for (const auto& it : state->localTimers)
+  {
+    int64_t total = it.second.accumulated;
+    // Credit any still-running timer up to the thread's exit.
+    if (it.second.depth > 0)
+      total += currTime - it.second.startTime;
+    retiredTimers[it.first] += microseconds(total);
+  }
+  threadStates.remove(state);
+}
+
 // Reset a Timers object.
 void Timers::Reset()
 {
   lock_guard<mutex> lock(timersMutex);
-  timers.clear();
-  timerStartTime.clear();
+  retiredTimers.clear();
+  for (ThreadState* state : threadStates)
+  {
+    lock_guard<mutex> mapLock(state->mapMutex);
+    state->localTimers.clear();
+  }
 }
 
 map<string, microseconds> Timers::GetAllTimers()
 {
-  // Make a copy of the timer.
+  // Merge the totals of exited threads with each live thread's accumulated
+  // values.  Running timers are not included until they are stopped.
   lock_guard<mutex> lock(timersMutex);
-  return timers;
+  map<string, microseconds> result = retiredTimers;
+  for (ThreadState* state : threadStates)
+  {
+    lock_guard<mutex> mapLock(state->mapMutex);
+    for (const auto& it : state->localTimers)
+      result[it.first] += microseconds(it.second.accumulated.load());
+  }
+  return result;
 }
 
 microseconds Timers::GetTimer(const string& timerName)
@@ -85,16 +240,37 @@ microseconds Timers::GetTimer(const string& timerName)
     return microseconds(0);
 
   lock_guard<mutex> lock(timersMutex);
-  return timers[timerName];
+  microseconds total(0);
+  const auto retired = retiredTimers.find(timerName);
+  if (retired != retiredTimers.end())
+    total += retired->second;
+  for (ThreadState* state : threadStates)
+  {
+    lock_guard<mutex> mapLock(state->mapMutex);
+    const auto it = state->localTimers.find(timerName);
+    if (it != state->localTimers.end())
+      total += microseconds(it->second.accumulated.load());
+  }
+  return total;
 }
 
 bool Timers::GetState(const string& timerName,
                       const thread::id& threadId)
 {
+  const thread::id id = (threadId == thread::id()) ?
+      this_thread::get_id() : threadId;
+
   lock_guard<mutex> lock(timersMutex);
-  if (timerStartTime.count(threadId) == 0)
-    return 0;
-  return (timerStartTime[threadId].count(timerName) > 0);
+  for (ThreadState* state : threadStates)
+  {
+    if (state->threadId != id)
+      continue;
+
+    lock_guard<mutex> mapLock(state->mapMutex);
+    const auto it = state->localTimers.find(timerName);
+    return (it != state->localTimers.end()) && (it->second.depth > 0);
+  }
+  return false;
 }
 
 void Timers::PrintTimer(const string& timerName)
@@ -157,32 +333,98 @@ void Timers::PrintTimer(const string& timerName)
   Log::Info << endl;
 }
 
+void Timers::PrintJSON(ostream& stream)
+{
+  // Values are reported in microseconds, matching GetAllTimers().
+  map<string, microseconds> timersCopy = GetAllTimers();
+
+  stream << "{";
+  bool first = true;
+  for (const auto& it : timersCopy)
+  {
+    if (!first)
+      stream << ", ";
+    stream << "\"" << JsonEscape(it.first) << "\": " << it.second.count();
+    first = false;
+  }
+  stream << "}";
+}
+
+void Counters::Increment(const string& name, const uint64_t amount)
+{
+  // Don't do anything if we aren't counting.
+  if (!enabled)
+    return;
+
+  lock_guard<mutex> lock(countersMutex);
+  counters[name] += amount;
+}
+
+uint64_t Counters::Get(const string& name)
+{
+  lock_guard<mutex> lock(countersMutex);
+  const map<string, uint64_t>::const_iterator it = counters.find(name);
+  return (it == counters.end()) ? 0 : it->second;
+}
+
+map<string, uint64_t> Counters::GetAllCounters()
+{
+  // Make a copy of the counters.
+  lock_guard<mutex> lock(countersMutex);
+  return counters;
+}
+
+void Counters::Reset()
+{
+  lock_guard<mutex> lock(countersMutex);
+  counters.clear();
+}
+
+void Counters::PrintJSON(ostream& stream)
+{
+  map<string, uint64_t> countersCopy = GetAllCounters();
+
+  stream << "{";
+  bool first = true;
+  for (const auto& it : countersCopy)
+  {
+    if (!first)
+      stream << ", ";
+    stream << "\"" << JsonEscape(it.first) << "\": " << it.second;
+    first = false;
+  }
+  stream << "}";
+}
+
 void Timers::StopAllTimers()
 {
-  // Terminate the program timers.  Don't use StopTimer() since that modifies
-  // the map and would invalidate our iterators.
+  // Terminate any timers that are still running.  Worker threads are assumed
+  // to be done timing by now, so reading their running-timer state is safe.
   lock_guard<mutex> lock(timersMutex);
 
-  high_resolution_clock::time_point currTime = high_resolution_clock::now();
-  for (auto it : timerStartTime)
-    for (auto it2 : it.second)
-      timers[it2.first] += duration_cast<microseconds>(currTime - it2.second);
-
-  // If all timers are stopped, we can clear the maps.
-  timerStartTime.clear();
+  const int64_t currTime = NowUs();
+  for (ThreadState* state : threadStates)
+  {
+    lock_guard<mutex> mapLock(state->mapMutex);
+    for (auto& it : state->localTimers)
+    {
+      LocalTimer& timer = it.second;
+      if (timer.depth.exchange(0) > 0)
+        timer.accumulated += currTime - timer.startTime;
+    }
+  }
 }
 
 void Timers::StartTimer(const string& timerName,
-                        const thread::id& threadId)
+                        const thread::id& /* threadId */)
 {
   // Don't do anything if we aren't timing.
   if (!enabled)
     return;
 
-  lock_guard<mutex> lock(timersMutex);
+  LocalTimer& timer = GetLocalTimer(timerName);
 
-  if ((timerStartTime.count(threadId) > 0) &&
-      (timerStartTime[threadId].count(timerName)))
+  if (timer.depth > 0)
   {
     ostringstream error;
     error << "Timer::Start(): timer '" << timerName
@@ -190,28 +432,42 @@ void Timers::StartTimer(const string& timerName,
     throw runtime_error(error.str());
   }
 
-  high_resolution_clock::time_point currTime = high_resolution_clock::now();
-
-  // If the timer is added for the first time.
-  if (timers.count(timerName) == 0)
-  {
-    timers[timerName] = (microseconds) 0;
-  }
-
-  timerStartTime[threadId][timerName] = currTime;
+  // Only the owning thread writes these fields, so this does not race with a
+  // nested Start().
+  timer.startTime = NowUs();
+  timer.depth = 1;
 }
 
 void Timers::StopTimer(const string& timerName,
-                       const thread::id& threadId)
+                       const thread::id& /* threadId */)
+{
+  PopTimer(timerName);
+}
+
+void Timers::PushTimer(const string& timerName)
 {
   // Don't do anything if we aren't timing.
   if (!enabled)
     return;
 
-  lock_guard<mutex> lock(timersMutex);
+  LocalTimer& timer = GetLocalTimer(timerName);
+
+  // Only start the clock for the outermost scope; inner scopes just deepen
+  // the nesting, so the elapsed time is counted exactly once.
+  if (timer.depth == 0)
+    timer.startTime = NowUs();
+  ++timer.depth;
+}
 
-  if ((timerStartTime.count(threadId) == 0) ||
-      (timerStartTime[threadId].count(timerName) == 0))
+void Timers::PopTimer(const string& timerName)
+{
+  // Don't do anything if we aren't timing.
+  if (!enabled)
+    return;
+
+  ThreadState& state = LocalState();
+  const auto it = state.localTimers.find(timerName);
+  if (it == state.localTimers.end() || it->second.depth == 0)
   {
     ostringstream error;
     error << "Timer::Stop(): no timer with name '" << timerName
@@ -219,14 +475,8 @@ void Timers::StopTimer(const string& timerName,
     throw runtime_error(error.str());
   }
 
-  high_resolution_clock::time_point currTime = high_resolution_clock::now();
-
-  // Calculate the delta time.
-  timers[timerName] += duration_cast<microseconds>(currTime -
-      timerStartTime[threadId][timerName]);
-
-  // Remove the entries.
-  timerStartTime[threadId].erase(timerName);
-  if (timerStartTime[threadId].empty())
-    timerStartTime.erase(threadId);
+  // Calculate the delta time once the outermost scope ends.
+  LocalTimer& timer = it->second;
+  if (--timer.depth == 0)
+    timer.accumulated += NowUs() - timer.startTime;
 }
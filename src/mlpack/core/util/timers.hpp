@@ -21,6 +21,8 @@
 #include <mutex>
 #include <list>
 #include <atomic>
+#include <cstdint>
+#include <ostream>
 
 #if defined(_WIN32)
   // uint64_t isn't defined on every windows.
@@ -41,6 +43,11 @@ namespace mlpack {
  * stopped, and its value to be obtained.  A named timer is specific to the
  * thread it is running on, so if you start a timer in one thread, it cannot be
  * stopped from a different thread.
+ *
+ * Each thread accumulates its timers in thread-local storage and the totals
+ * are merged when a timer is read, so Start() and Stop() do not contend on a
+ * lock and may be used inside parallel regions without serializing the worker
+ * threads (or perturbing what they measure).
  */
 class Timer
 {
@@ -68,6 +75,28 @@ class Timer
    */
   static void Stop(const std::string& name);
 
+  /**
+   * Start the given timer, allowing nested scopes: if the timer is already
+   * running on the calling thread, the nesting depth is increased instead of
+   * throwing, and time is accumulated only when the outermost Pop() happens.
+   * This is what ScopedTimer uses, so that scoped timers with the same name
+   * can nest (for example, a timed function called from a timed loop).
+   *
+   * @param name Name of timer to be started.
+   */
+  static void Push(const std::string& name);
+
+  /**
+   * End the innermost running scope of the given timer.  If this ends the
+   * outermost scope, the elapsed time is added to the timer's total.
+   *
+   * @note A std::runtime_error exception will be thrown if the timer is not
+   * running.
+   *
+   * @param name Name of timer to be stopped.
+   */
+  static void Pop(const std::string& name);
+
   /**
    * Get the value of the given timer.
    *
@@ -92,6 +121,54 @@ class Timer
    * existing timers.
    */
   static void ResetAll();
+
+  /**
+   * Write a machine-readable JSON dump of all timers and counters to the
+   * given stream, as an object of the form
+   * { "timers": { "name": microseconds, ... },
+   *   "counters": { "name": count, ... } }.
+   *
+   * @param stream Stream to write the dump to.
+   */
+  static void DumpJSON(std::ostream& stream);
+};
+
+/**
+ * The Counter class provides named event counters for instrumenting hot paths
+ * (distance evaluations, node visits, allocations, and so forth).  Like
+ * timers, counters are additive, process-wide, and disabled by default; when
+ * counting is disabled, Increment() returns after one atomic flag check.  For
+ * code that must have literally zero overhead in release builds, use the
+ * MLPACK_COUNTER_ADD() macro, which compiles to nothing when
+ * MLPACK_NO_INSTRUMENTATION is defined.
+ */
+class Counter
+{
+ public:
+  /**
+   * Add the given amount to the named counter, creating it (at zero) if it
+   * does not exist yet.
+   *
+   * @param name Name of counter to increment.
+   * @param amount Amount to add to the counter.
+   */
+  static void Increment(const std::string& name, const uint64_t amount = 1);
+
+  /**
+   * Get the value of the given counter (0 if it has never been incremented).
+   *
+   * @param name Name of counter to return value of.
+   */
+  static uint64_t Get(const std::string& name);
+
+  //! Enable counting of mlpack events.
+  static void EnableCounting();
+
+  //! Disable counting of mlpack events.
+  static void DisableCounting();
+
+  //! Reset all counters to zero and remove them.
+  static void ResetAll();
 };
 
 class Timers
@@ -101,19 +178,21 @@ class Timers
   Timers() : enabled(false) { }
 
   /**
-   * Returns a copy of all the timers used via this interface.
+   * Returns a copy of all the timers used via this interface, with each
+   * timer's value summed over all threads.
    */
   std::map<std::string, std::chrono::microseconds> GetAllTimers();
 
   /**
    * Reset the timers.  This stops all running timers and removes them.  Whether
-   * or not timing is enabled will not be changed.
+   * or not timing is enabled will not be changed.  This must not be called
+   * while other threads are starting or stopping timers.
    */
   void Reset();
 
   /**
    * Returns a copy of the timer specified.  This contains the sum of the timing
-   * results for timers that have been stopped with this name.
+   * results for timers that have been stopped with this name, over all threads.
    *
    * @param timerName The name of the timer in question.
    */
@@ -132,7 +211,11 @@ class Timers
    * the command line.  Timers are of type timeval.  If a timer is started, then
    * stopped, then re-started, then stopped, the final timer value will be the
    * length of both runs of the timer.
-   *
+   *
+   * The timer's state is kept in thread-local storage for the calling
+   * thread, so no lock is taken; the threadId parameter is retained for
+   * compatibility but is not used.
+   *
    * @param timerName The name of the timer in question.
    * @param threadId Id of the thread accessing the timer.
    */
@@ -149,7 +232,28 @@ class Timers
                  const std::thread::id& threadId = std::thread::id());
 
   /**
-   * Returns state of the given timer.
+   * Start a (possibly nested) scope of the given timer on the calling thread.
+   * Unlike StartTimer(), re-entrant starts are allowed: the nesting depth is
+   * increased, and time accumulates only once the outermost scope ends.
+   *
+   * @param timerName The name of the timer in question.
+   */
+  void PushTimer(const std::string& timerName);
+
+  /**
+   * End the innermost running scope of the given timer on the calling thread,
+   * accumulating the elapsed time if this ends the outermost scope.
+   *
+   * @note A std::runtime_error exception will be thrown if the timer is not
+   * running on the calling thread.
+   *
+   * @param timerName The name of the timer in question.
+   */
+  void PopTimer(const std::string& timerName);
+
+  /**
+   * Returns state of the given timer: whether it is currently running on the
+   * given thread (or on the calling thread, if no thread id is given).
    *
    * @param timerName The name of the timer in question.
    * @param threadId Id of the thread accessing the timer.
@@ -158,28 +262,190 @@ class Timers
                 const std::thread::id& threadId = std::thread::id());
 
   /**
-   * Stop all timers.
+   * Stop all timers, folding any still-running intervals into the totals.
+   * This is meant for the end of the program; it must not be called while
+   * other threads are starting or stopping timers.
    */
   void StopAllTimers();
 
+  /**
+   * Write all timers to the given stream as a JSON object mapping timer names
+   * to their values in microseconds.
+   *
+   * @param stream Stream to write to.
+   */
+  void PrintJSON(std::ostream& stream);
+
   //! Modify whether or not timing is enabled.
   std::atomic<bool>& Enabled() { return enabled; }
   //! Get whether or not timing is enabled.
   bool Enabled() const { return enabled; }
 
  private:
-  //! A map of all the timers that are being tracked.
-  std::map<std::string, std::chrono::microseconds> timers;
-  //! A mutex for modifying the timers.
+  //! Per-thread state of a single named timer.  Only the owning thread
+  //! modifies these fields; they are atomic so that merged reporting from
+  //! other threads can read them without stopping the owner.
+  struct LocalTimer
+  {
+    //! Time accumulated by completed runs, in microseconds.
+    std::atomic<int64_t> accumulated;
+    //! Start time of the current outermost run, in microseconds since the
+    //! clock epoch (only meaningful while depth > 0).
+    std::atomic<int64_t> startTime;
+    //! Nesting depth of the current run (0 if the timer is not running).
+    std::atomic<size_t> depth;
+
+    LocalTimer() : accumulated(0), startTime(0), depth(0) { }
+  };
+
+  //! All of the timers owned by a single thread.
+  struct ThreadState
+  {
+    //! The id of the owning thread.
+    std::thread::id threadId;
+    //! Guards insertions into localTimers, so that merged reporting can walk
+    //! the map from other threads; the owner's hot path (looking up a timer
+    //! that already exists) takes no lock.
+    std::mutex mapMutex;
+    //! The timers of the owning thread; only the owner inserts entries.
+    std::map<std::string, LocalTimer> localTimers;
+  };
+
+  //! Get the calling thread's state, registering it on first use.
+  ThreadState& LocalState();
+
+  //! Get the calling thread's timer with the given name, creating it if it
+  //! does not exist yet.
+  LocalTimer& GetLocalTimer(const std::string& timerName);
+
+  //! Fold a departing thread's totals into retiredTimers and deregister it;
+  //! called when a thread that used this object exits.
+  void RetireThread(ThreadState* state);
+
+  //! Totals folded in from threads that have exited.
+  std::map<std::string, std::chrono::microseconds> retiredTimers;
+  //! The states of all live threads that have used this object.
+  std::list<ThreadState*> threadStates;
+  //! A mutex guarding retiredTimers and threadStates (but not the per-thread
+  //! timer maps, which have their own locks).
   std::mutex timersMutex;
-  //! A map for the starting values of the timers.
-  std::map<std::thread::id, std::map<std::string,
-      std::chrono::high_resolution_clock::time_point>> timerStartTime;
 
   //! Whether or not timing is enabled.
   std::atomic<bool> enabled;
 };
 
+/**
+ * Holds the named counters, in the same way that Timers holds the named
+ * timers; accessed through the static Counter interface.
+ */
+class Counters
+{
+ public:
+  //! Default to disabled.
+  Counters() : enabled(false) { }
+
+  /**
+   * Add the given amount to the named counter.  Does nothing if counting is
+   * disabled.
+   *
+   * @param name Name of counter to increment.
+   * @param amount Amount to add to the counter.
+   */
+  void Increment(const std::string& name, const uint64_t amount);
+
+  /**
+   * Get the value of the given counter (0 if it has never been incremented).
+   *
+   * @param name Name of counter to return value of.
+   */
+  uint64_t Get(const std::string& name);
+
+  /**
+   * Returns a copy of all the counters.
+   */
+  std::map<std::string, uint64_t> GetAllCounters();
+
+  /**
+   * Reset all counters to zero and remove them.  Whether or not counting is
+   * enabled will not be changed.
+   */
+  void Reset();
+
+  /**
+   * Write all counters to the given stream as a JSON object mapping counter
+   * names to their values.
+   *
+   * @param stream Stream to write to.
+   */
+  void PrintJSON(std::ostream& stream);
+
+  //! Modify whether or not counting is enabled.
+  std::atomic<bool>& Enabled() { return enabled; }
+  //! Get whether or not counting is enabled.
+  bool Enabled() const { return enabled; }
+
+ private:
+  //! A map of all the counters that are being tracked.
+  std::map<std::string, uint64_t> counters;
+  //! A mutex for modifying the counters.
+  std::mutex countersMutex;
+
+  //! Whether or not counting is enabled.
+  std::atomic<bool> enabled;
+};
+
+/**
+ * A scoped timer: starts the given timer on construction and stops it on
+ * destruction, so that a block or function can be timed by declaring one of
+ * these at its top.  Scoped timers with the same name may nest (a timed
+ * function called from a timed loop, say); only the outermost scope
+ * accumulates time, so nothing is counted twice.  For hot paths that must
+ * compile to nothing in release builds, use the MLPACK_SCOPED_TIMER() macro
+ * instead of instantiating this class directly.
+ */
+class ScopedTimer
+{
+ public:
+  //! Start (or nest) the given timer.
+  explicit ScopedTimer(const std::string& name) : name(name)
+  {
+    Timer::Push(name);
+  }
+
+  //! Stop the timer.
+  ~ScopedTimer()
+  {
+    // Timer::Pop() throws if the timer has already been stopped (e.g. by
+    // StopAllTimers() at program exit), and destructors must not throw.
+    try
+    {
+      Timer::Pop(name);
+    }
+    catch (std::exception&) { }
+  }
+
+ private:
+  //! The name of the timer to be stopped at the end of the scope.
+  std::string name;
+};
+
 } // namespace mlpack
 
+// Paste two tokens together, expanding macros (like __LINE__) first.
+#define MLPACK_TOKEN_PASTE_IMPL(x, y) x ## y
+#define MLPACK_TOKEN_PASTE(x, y) MLPACK_TOKEN_PASTE_IMPL(x, y)
+
+// Instrumentation macros for hot paths: these compile to nothing when
+// MLPACK_NO_INSTRUMENTATION is defined, so heavily-instrumented code can be
+// built with literally zero overhead.
+#ifdef MLPACK_NO_INSTRUMENTATION
+  #define MLPACK_SCOPED_TIMER(name) ((void) 0)
+  #define MLPACK_COUNTER_ADD(name, amount) ((void) 0)
+#else
+  #define MLPACK_SCOPED_TIMER(name) \
+      mlpack::ScopedTimer MLPACK_TOKEN_PASTE(scopedTimer, __LINE__)(name)
+  #define MLPACK_COUNTER_ADD(name, amount) \
+      mlpack::Counter::Increment(name, amount)
+#endif
+
 #endif // MLPACK_CORE_UTILITIES_TIMERS_HPP
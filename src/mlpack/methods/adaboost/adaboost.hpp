@@ -29,12 +29,34 @@
 #define MLPACK_METHODS_ADABOOST_ADABOOST_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/sfinae_utility.hpp>
 #include <mlpack/methods/perceptron/perceptron.hpp>
 #include <mlpack/methods/decision_tree/decision_tree.hpp>
 
 namespace mlpack {
 namespace adaboost {
 
+//! Detect whether the weak learner exposes its linear parameters.
+HAS_MEM_FUNC(Weights, HasWeightsCheck);
+HAS_MEM_FUNC(Biases, HasBiasesCheck);
+
+/**
+ * 'value' is true if the weak learner is a linear classifier that exposes its
+ * weight matrix and bias vector (e.g. Perceptron).  For such learners the
+ * whole ensemble can be collapsed into one stacked weight matrix, so that
+ * classification of a block of points is a single matrix product followed by
+ * a weighted argmax instead of one pass over the input per weak learner.
+ */
+template<typename WeakLearnerType>
+struct HasLinearForm
+{
+  static const bool value =
+      HasWeightsCheck<WeakLearnerType,
+          const arma::mat&(WeakLearnerType::*)() const>::value &&
+      HasBiasesCheck<WeakLearnerType,
+          const arma::vec&(WeakLearnerType::*)() const>::value;
+};
+
 /**
  * The AdaBoost class.  AdaBoost is a boosting algorithm, meaning that it
  * combines an ensemble of weak learners to produce a strong learner.  For more
@@ -180,6 +202,30 @@ class AdaBoost
   void serialize(Archive& ar, const unsigned int /* version */);
 
  private:
+  /**
+   * Accumulate the weighted votes of all weak learners into the given
+   * probabilities matrix.  This overload is used when the weak learner is a
+   * linear classifier (see HasLinearForm): the per-learner weight matrices
+   * are collapsed into one stacked matrix, so the scores of every learner for
+   * every point are produced by a single matrix product, and the weighted
+   * argmax over each learner's stripe of rows is taken in one pass over that
+   * score matrix.  The stacked matrix is built lazily and kept until the next
+   * call to Train().
+   */
+  template<typename T = WeakLearnerType>
+  typename std::enable_if<HasLinearForm<T>::value, void>::type
+  AccumulateVotes(const MatType& test, arma::mat& probabilities);
+
+  /**
+   * Accumulate the weighted votes of all weak learners into the given
+   * probabilities matrix, calling Classify() on each weak learner in turn.
+   * This overload is used for weak learners without an exposed linear form
+   * (e.g. decision stumps).
+   */
+  template<typename T = WeakLearnerType>
+  typename std::enable_if<!HasLinearForm<T>::value, void>::type
+  AccumulateVotes(const MatType& test, arma::mat& probabilities);
+
   //! The number of classes in the model.
   size_t numClasses;
   // The tolerance for change in rt and when to stop.
@@ -189,6 +235,14 @@ class AdaBoost
   std::vector<WeakLearnerType> wl;
   //! The weights corresponding to each weak learner.
   std::vector<double> alpha;
+
+  //! The weight matrices of all linear weak learners, stacked side by side
+  //! (learner i occupies columns [i * numClasses, (i + 1) * numClasses)).
+  //! Only used when HasLinearForm<WeakLearnerType>::value; rebuilt lazily
+  //! after training, and not serialized.
+  arma::mat compiledWeights;
+  //! The bias vectors of all linear weak learners, stacked the same way.
+  arma::vec compiledBiases;
 }; // class AdaBoost
 
 } // namespace adaboost
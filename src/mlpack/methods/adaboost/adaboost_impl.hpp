@@ -75,6 +75,11 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
   wl.clear();
   alpha.clear();
 
+  // The stacked weight matrix of the previous ensemble (if any) is stale now;
+  // it will be rebuilt on the next call to Classify().
+  compiledWeights.clear();
+  compiledBiases.clear();
+
   this->tolerance = tolerance;
   this->numClasses = numClasses;
 
@@ -82,6 +87,10 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
   // changing by less than the tolerance.
   double rt, crt = 0.0, alphat = 0.0, zt;
 
+  // The previous round's normalization constant, used to detect a plateaued
+  // zt and stop boosting early.
+  double lastZt = 0.0;
+
   double ztProduct = 1.0;
 
   // To be used for prediction by the weak learner.
@@ -126,8 +135,10 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     // Now from predictedLabels, build ht, the weak hypothesis
     // buildClassificationMatrix(ht, predictedLabels);
 
-    // Now, calculate alpha(t) using ht.
-    for (size_t j = 0; j < D.n_cols; ++j) // instead of D, ht
+    // Now, calculate alpha(t) using ht.  The per-point contributions to the
+    // weighted error are independent, so accumulate them in parallel.
+    #pragma omp parallel for schedule(static) reduction(+:rt)
+    for (omp_size_t j = 0; j < (omp_size_t) D.n_cols; ++j) // instead of D, ht
     {
       if (predictedLabels(j) == labels(j))
         rt += arma::accu(D.col(j));
@@ -156,10 +167,13 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
     alpha.push_back(alphat);
     wl.push_back(w);
 
-    // Now start modifying the weights.
-    for (size_t j = 0; j < D.n_cols; ++j)
+    // Now start modifying the weights.  Every point updates its own column
+    // of D and sumFinalH, so the columns are processed in parallel with the
+    // normalization constant accumulated by reduction.
+    const double expo = exp(alphat);
+    #pragma omp parallel for schedule(static) reduction(+:zt)
+    for (omp_size_t j = 0; j < (omp_size_t) D.n_cols; ++j)
     {
-      const double expo = exp(alphat);
       if (predictedLabels(j) == labels(j))
       {
         for (size_t k = 0; k < D.n_rows; ++k)
@@ -198,6 +212,13 @@ double AdaBoost<WeakLearnerType, MatType>::Train(
 
     // Accumulate the value of zt for the Hamming loss bound.
     ztProduct *= zt;
+
+    // Terminate early once the normalization constant has plateaued: further
+    // rounds then barely change the weight distribution, so the ensemble has
+    // stopped improving.  The weak learner of this round is already stored.
+    if ((i > 0) && (std::abs(zt - lastZt) < tolerance))
+      break;
+    lastZt = zt;
   }
   return ztProduct;
 }
@@ -225,18 +246,10 @@ void AdaBoost<WeakLearnerType, MatType>::Classify(
     arma::Row<size_t>& predictedLabels,
     arma::mat& probabilities)
 {
-  arma::Row<size_t> tempPredictedLabels(test.n_cols);
-
   probabilities.zeros(numClasses, test.n_cols);
   predictedLabels.set_size(test.n_cols);
 
-  for (size_t i = 0; i < wl.size(); ++i)
-  {
-    wl[i].Classify(test, tempPredictedLabels);
-
-    for (size_t j = 0; j < tempPredictedLabels.n_cols; ++j)
-      probabilities(tempPredictedLabels(j), j) += alpha[i];
-  }
+  AccumulateVotes(test, probabilities);
 
   arma::colvec pRow;
   arma::uword maxIndex = 0;
@@ -250,6 +263,77 @@ void AdaBoost<WeakLearnerType, MatType>::Classify(
   }
 }
 
+// Accumulate weighted votes with the stacked linear predictor.
+template<typename WeakLearnerType, typename MatType>
+template<typename T>
+typename std::enable_if<HasLinearForm<T>::value, void>::type
+AdaBoost<WeakLearnerType, MatType>::AccumulateVotes(
+    const MatType& test,
+    arma::mat& probabilities)
+{
+  // Rebuild the stacked weight matrix if it does not match the ensemble; it
+  // is cleared by Train() and left empty by serialization.
+  if (compiledWeights.n_cols != wl.size() * numClasses)
+  {
+    compiledWeights.set_size(test.n_rows, wl.size() * numClasses);
+    compiledBiases.set_size(wl.size() * numClasses);
+    for (size_t i = 0; i < wl.size(); ++i)
+    {
+      compiledWeights.cols(i * numClasses, (i + 1) * numClasses - 1) =
+          wl[i].Weights();
+      compiledBiases.subvec(i * numClasses, (i + 1) * numClasses - 1) =
+          wl[i].Biases();
+    }
+  }
+
+  // One matrix product gives the scores of every learner for every point:
+  // row (i * numClasses + k) of 'scores' holds learner i's score for class k.
+  arma::mat scores = compiledWeights.t() * test;
+  scores.each_col() += compiledBiases;
+
+  // Each point accumulates into its own column of the probabilities matrix,
+  // so the points are processed in parallel.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t j = 0; j < (omp_size_t) scores.n_cols; ++j)
+  {
+    for (size_t i = 0; i < wl.size(); ++i)
+    {
+      // Take the argmax over learner i's stripe of rows, keeping the first
+      // maximum on ties to match the weak learner's own Classify().
+      size_t bestClass = 0;
+      double bestScore = scores(i * numClasses, j);
+      for (size_t k = 1; k < numClasses; ++k)
+      {
+        if (scores(i * numClasses + k, j) > bestScore)
+        {
+          bestScore = scores(i * numClasses + k, j);
+          bestClass = k;
+        }
+      }
+
+      probabilities(bestClass, j) += alpha[i];
+    }
+  }
+}
+
+// Accumulate weighted votes by classifying with each weak learner in turn.
+template<typename WeakLearnerType, typename MatType>
+template<typename T>
+typename std::enable_if<!HasLinearForm<T>::value, void>::type
+AdaBoost<WeakLearnerType, MatType>::AccumulateVotes(
+    const MatType& test,
+    arma::mat& probabilities)
+{
+  arma::Row<size_t> tempPredictedLabels(test.n_cols);
+  for (size_t i = 0; i < wl.size(); ++i)
+  {
+    wl[i].Classify(test, tempPredictedLabels);
+
+    for (size_t j = 0; j < tempPredictedLabels.n_cols; ++j)
+      probabilities(tempPredictedLabels(j), j) += alpha[i];
+  }
+}
+
 /**
  * Serialize the AdaBoost model.
  */
@@ -273,6 +357,11 @@ void AdaBoost<WeakLearnerType, MatType>::serialize(Archive& ar,
   {
     wl.clear();
     wl.resize(alpha.size());
+
+    // The stacked weight matrix is not serialized; any cached one belongs to
+    // the previous ensemble.
+    compiledWeights.clear();
+    compiledBiases.clear();
   }
   ar & BOOST_SERIALIZATION_NVP(wl);
 }
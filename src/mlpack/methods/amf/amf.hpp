@@ -112,6 +112,31 @@ class AMF
                arma::mat& W,
                arma::mat& H);
 
+  /**
+   * Apply Alternating Matrix Factorization to the provided matrix several
+   * times, from different initializations, and keep the factorization with
+   * the lowest final residue.  Because the factorization problem is
+   * nonconvex, different initializations can converge to local minima of
+   * different quality; running restarts is the standard remedy.  The restarts
+   * run concurrently when OpenMP is enabled; each restart uses its own copy
+   * of the update rule and termination policy.  All initializations are
+   * performed up front, before any restart runs, so initialization rules that
+   * draw from the global random number generator are safe to use.
+   *
+   * @param V Input matrix to be factorized.
+   * @param r Rank r of the factorization.
+   * @param W Basis matrix of the best factorization, to be output.
+   * @param H Encoding matrix of the best factorization, to be output.
+   * @param restarts Number of factorizations to run (must be at least 1).
+   * @return The residue of the best factorization.
+   */
+  template<typename MatType>
+  double Apply(const MatType& V,
+               const size_t r,
+               arma::mat& W,
+               arma::mat& H,
+               const size_t restarts);
+
   //! Access the termination policy.
   const TerminationPolicyType& TerminationPolicy() const
   { return terminationPolicy; }
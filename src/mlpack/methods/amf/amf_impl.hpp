@@ -75,5 +75,80 @@ Apply(const MatType& V,
   return residue;
 }
 
+/**
+ * Apply Alternating Matrix Factorization several times and keep the best
+ * factorization.
+ *
+ * @param V Input matrix to be factorized
+ * @param r Rank r of the factorization
+ * @param W Basis matrix of the best factorization, to be output
+ * @param H Encoding matrix of the best factorization, to be output
+ * @param restarts Number of factorizations to run
+ */
+template<typename TerminationPolicyType,
+         typename InitializationRuleType,
+         typename UpdateRuleType>
+template<typename MatType>
+double AMF<TerminationPolicyType, InitializationRuleType, UpdateRuleType>::
+Apply(const MatType& V,
+      const size_t r,
+      arma::mat& W,
+      arma::mat& H,
+      const size_t restarts)
+{
+  if (restarts == 0)
+  {
+    throw std::invalid_argument("AMF::Apply(): number of restarts must be at "
+        "least 1");
+  }
+
+  // Perform all initializations up front: initialization rules commonly draw
+  // from the global random number generator, which cannot be used from
+  // several threads at once.
+  std::vector<arma::mat> Ws(restarts);
+  std::vector<arma::mat> Hs(restarts);
+  std::vector<double> residues(restarts);
+  for (size_t i = 0; i < restarts; ++i)
+    initializationRule.Initialize(V, r, Ws[i], Hs[i]);
+
+  Log::Info << "Initialized W and H for " << restarts << " restarts."
+      << std::endl;
+
+  // Run the restarts concurrently.  Each one gets its own copy of the update
+  // rule and the termination policy, since both may hold per-factorization
+  // state.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) restarts; ++i)
+  {
+    UpdateRuleType localUpdate(update);
+    TerminationPolicyType localPolicy(terminationPolicy);
+
+    localUpdate.Initialize(V, r);
+    localPolicy.Initialize(V);
+
+    while (!localPolicy.IsConverged(Ws[i], Hs[i]))
+    {
+      localUpdate.WUpdate(V, Ws[i], Hs[i]);
+      localUpdate.HUpdate(V, Ws[i], Hs[i]);
+    }
+
+    residues[i] = localPolicy.Index();
+  }
+
+  // Keep the factorization with the lowest residue.
+  size_t best = 0;
+  for (size_t i = 1; i < restarts; ++i)
+    if (residues[i] < residues[best])
+      best = i;
+
+  Log::Info << "Best of " << restarts << " restarts converged to residue "
+      << residues[best] << "." << std::endl;
+
+  W = std::move(Ws[best]);
+  H = std::move(Hs[best]);
+
+  return residues[best];
+}
+
 } // namespace amf
 } // namespace mlpack
@@ -71,7 +71,24 @@ class NMFMultiplicativeDistanceUpdate
                              arma::mat& W,
                              const arma::mat& H)
   {
-    W = (W % (V * H.t())) / (W * H * H.t());
+    // Compute the small r x r Gram matrix H H^T first, so the denominator
+    // W (H H^T) never materializes the full n x m reconstruction W H; every
+    // intermediate is no larger than W itself.
+    const arma::mat HHt = H * H.t();
+    const arma::mat VHt = V * H.t();
+
+    // The rows of W update independently, so process them a block at a time,
+    // in parallel.
+    const size_t blockSize = 1024;
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t begin = 0; begin < W.n_rows; begin += blockSize)
+    {
+      const size_t blockEnd = std::min((size_t) W.n_rows,
+          begin + blockSize) - 1;
+      const arma::mat block = (W.rows(begin, blockEnd) %
+          VHt.rows(begin, blockEnd)) / (W.rows(begin, blockEnd) * HHt);
+      W.rows(begin, blockEnd) = block;
+    }
   }
 
   /**
@@ -93,7 +110,23 @@ class NMFMultiplicativeDistanceUpdate
                              const arma::mat& W,
                              arma::mat& H)
   {
-    H = (H % (W.t() * V)) / (W.t() * W * H);
+    // As in WUpdate(), compute the r x r Gram matrix W^T W first so that no
+    // intermediate is larger than H itself.
+    const arma::mat WtW = W.t() * W;
+    const arma::mat WtV = W.t() * V;
+
+    // The columns of H update independently, so process them a block at a
+    // time, in parallel.
+    const size_t blockSize = 1024;
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t begin = 0; begin < H.n_cols; begin += blockSize)
+    {
+      const size_t blockEnd = std::min((size_t) H.n_cols,
+          begin + blockSize) - 1;
+      const arma::mat block = (H.cols(begin, blockEnd) %
+          WtV.cols(begin, blockEnd)) / (WtW * H.cols(begin, blockEnd));
+      H.cols(begin, blockEnd) = block;
+    }
   }
 
   //! Serialize the object (in this case, there is nothing to serialize).
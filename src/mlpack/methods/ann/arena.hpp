@@ -0,0 +1,147 @@
+/**
+ * @file methods/ann/arena.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the Arena class, a per-thread stack allocator for layer
+ * temporaries on the inference and training hot paths.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_ARENA_HPP
+#define MLPACK_METHODS_ANN_ARENA_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * A per-thread stack allocator for short-lived layer temporaries.  Layer
+ * implementations that need a scratch matrix inside a single Forward() or
+ * Backward() call can draw it from the arena instead of the heap, so the hot
+ * path performs no allocator traffic once the arena has grown to its
+ * high-water mark.  Each thread owns its own arena, so concurrent inference
+ * never contends on the allocator.
+ *
+ * Allocation is bump-pointer within a list of blocks; blocks are never moved,
+ * so outstanding matrices stay valid while the arena grows.  A Scope object
+ * records the allocation mark at construction and rewinds to it at
+ * destruction, which makes nested use safe:
+ *
+ * @code
+ * typename Arena<double>::Scope scope;
+ * arma::mat derivative = Arena<double>::Get().Matrix(rows, cols);
+ * // ... use derivative; the memory is recycled when scope dies.
+ * @endcode
+ *
+ * Matrices returned by Matrix() are aliases into arena memory and must not
+ * outlive the enclosing Scope.
+ *
+ * @tparam eT The matrix element type (e.g. double).
+ */
+template<typename eT>
+class Arena
+{
+ public:
+  //! Get the arena of the calling thread.
+  static Arena& Get()
+  {
+    static thread_local Arena arena;
+    return arena;
+  }
+
+  /**
+   * An RAII marker: records the allocation position at construction and
+   * rewinds the calling thread's arena to it at destruction.
+   */
+  class Scope
+  {
+   public:
+    Scope() :
+        arena(Arena::Get()),
+        savedBlock(arena.currentBlock),
+        savedOffset(arena.currentOffset)
+    {
+      // Nothing else to do.
+    }
+
+    ~Scope()
+    {
+      arena.currentBlock = savedBlock;
+      arena.currentOffset = savedOffset;
+    }
+
+   private:
+    //! The arena this scope rewinds.
+    Arena& arena;
+    //! Block index at construction.
+    size_t savedBlock;
+    //! Offset within the block at construction.
+    size_t savedOffset;
+  };
+
+  /**
+   * Return a matrix of the given shape backed by arena memory.  The matrix is
+   * a non-owning alias; it must not outlive the enclosing Scope, and anything
+   * that should survive must be copied out.
+   *
+   * @param rows Number of rows.
+   * @param cols Number of columns.
+   */
+  arma::Mat<eT> Matrix(const size_t rows, const size_t cols)
+  {
+    return arma::Mat<eT>(Allocate(rows * cols), rows, cols, false, false);
+  }
+
+ private:
+  //! Default number of elements per block.
+  static const size_t defaultBlockSize = 1 << 16;
+
+  Arena() : currentBlock(0), currentOffset(0)
+  {
+    // Start with one default-sized block.
+    blocks.push_back(std::unique_ptr<eT[]>(new eT[defaultBlockSize]));
+    blockSizes.push_back((size_t) defaultBlockSize);
+  }
+
+  //! Bump-allocate the given number of elements.
+  eT* Allocate(const size_t elements)
+  {
+    if (elements > blockSizes[currentBlock] - currentOffset)
+    {
+      // Move to the next block that fits the request, appending a new one if
+      // necessary.  Existing blocks are never moved or freed here, so
+      // outstanding matrices stay valid.
+      ++currentBlock;
+      if (currentBlock == blocks.size() || blockSizes[currentBlock] < elements)
+      {
+        const size_t size = std::max(elements, (size_t) defaultBlockSize);
+        blocks.insert(blocks.begin() + currentBlock,
+            std::unique_ptr<eT[]>(new eT[size]));
+        blockSizes.insert(blockSizes.begin() + currentBlock, size);
+      }
+      currentOffset = 0;
+    }
+
+    eT* result = blocks[currentBlock].get() + currentOffset;
+    currentOffset += elements;
+    return result;
+  }
+
+  //! The memory blocks of this arena.
+  std::vector<std::unique_ptr<eT[]>> blocks;
+  //! The size (in elements) of each block.
+  std::vector<size_t> blockSizes;
+  //! Index of the block currently allocated from.
+  size_t currentBlock;
+  //! Offset of the next free element in the current block.
+  size_t currentOffset;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,149 @@
+/**
+ * @file methods/ann/batch_provider.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the BatchProvider class, a double-buffered mini-batch
+ * pipeline that shuffles and materializes the next batch on a background
+ * thread while the current gradient step computes.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_BATCH_PROVIDER_HPP
+#define MLPACK_METHODS_ANN_BATCH_PROVIDER_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <functional>
+#include <future>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * BatchProvider streams shuffled mini-batches from an in-memory dataset,
+ * overlapping data movement with computation.  While the caller trains on the
+ * current batch, a background task gathers the columns of the next batch
+ * (and applies the optional augmentation hook) into a second buffer; Next()
+ * then only waits for that task and swaps buffers, so the main thread spends
+ * no time on shuffling or submatrix copies between gradient steps.
+ *
+ * The indices are reshuffled at every epoch boundary.  A typical training
+ * loop looks like:
+ *
+ * @code
+ * BatchProvider<> provider(predictors, responses, 128);
+ * arma::mat batchPredictors, batchResponses;
+ * for (size_t epoch = 0; epoch < maxEpochs; ++epoch)
+ * {
+ *   while (provider.Next(batchPredictors, batchResponses))
+ *   {
+ *     // One gradient step on (batchPredictors, batchResponses); the next
+ *     // batch is being materialized in the background meanwhile.
+ *   }
+ * }
+ * @endcode
+ *
+ * The provider keeps references to the dataset, so the dataset must outlive
+ * the provider and must not be modified while batches are being produced.
+ *
+ * @tparam MatType Type of the predictors matrix (arma::mat or arma::fmat).
+ * @tparam ResponsesType Type of the responses matrix.
+ */
+template<typename MatType = arma::mat, typename ResponsesType = arma::mat>
+class BatchProvider
+{
+ public:
+  //! Type of the augmentation hook, applied to each materialized batch.
+  typedef std::function<void(MatType&, ResponsesType&)> AugmentationType;
+
+  /**
+   * Create the BatchProvider.  Set the augmentation hook (if any) before the
+   * first call to Next(); prefetching starts with that call.
+   *
+   * @param predictors Matrix of data points, one per column.
+   * @param responses Matrix of responses, one per column.
+   * @param batchSize Number of points per batch (the last batch of an epoch
+   *      may be smaller).
+   * @param shuffle Whether to reshuffle the point ordering at every epoch.
+   */
+  BatchProvider(const MatType& predictors,
+                const ResponsesType& responses,
+                const size_t batchSize,
+                const bool shuffle = true);
+
+  //! Wait for any outstanding prefetch before destruction.
+  ~BatchProvider();
+
+  /**
+   * Get the next mini-batch of the current epoch.  Returns false (without
+   * touching the output matrices) when the epoch is exhausted; the next call
+   * then starts a freshly shuffled epoch.
+   *
+   * @param batchPredictors Matrix to store the batch predictors into.
+   * @param batchResponses Matrix to store the batch responses into.
+   */
+  bool Next(MatType& batchPredictors, ResponsesType& batchResponses);
+
+  //! Get the batch size.
+  size_t BatchSize() const { return batchSize; }
+
+  //! Get the number of batches per epoch.
+  size_t BatchesPerEpoch() const
+  {
+    return (predictors.n_cols + batchSize - 1) / batchSize;
+  }
+
+  //! Get the augmentation hook.
+  const AugmentationType& Augmentation() const { return augmentation; }
+  //! Modify the augmentation hook (applied on the background thread to each
+  //! batch after it is gathered).
+  AugmentationType& Augmentation() { return augmentation; }
+
+ private:
+  //! Shuffle the ordering (if enabled) and rewind to the start of an epoch.
+  void StartEpoch();
+
+  //! Launch the background task that materializes the batch starting at the
+  //! given point offset into the back buffers.
+  void Prefetch(const size_t begin);
+
+  //! Reference to the dataset points.
+  const MatType& predictors;
+  //! Reference to the dataset responses.
+  const ResponsesType& responses;
+
+  //! Number of points per batch.
+  size_t batchSize;
+  //! Whether to reshuffle at each epoch.
+  bool shuffle;
+  //! Current point ordering.
+  arma::uvec ordering;
+  //! Offset of the next batch to hand out.
+  size_t cursor;
+
+  //! Back buffers the background task fills.
+  MatType pendingPredictors;
+  ResponsesType pendingResponses;
+  //! Outstanding prefetch task.
+  std::future<void> pending;
+  //! Whether a prefetch for the batch at the cursor is outstanding.
+  bool prefetched;
+
+  //! Optional augmentation hook.
+  AugmentationType augmentation;
+
+  //! No copies: the provider owns an outstanding asynchronous task.
+  BatchProvider(const BatchProvider&) = delete;
+  BatchProvider& operator=(const BatchProvider&) = delete;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "batch_provider_impl.hpp"
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * @file methods/ann/batch_provider_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the BatchProvider class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_BATCH_PROVIDER_IMPL_HPP
+#define MLPACK_METHODS_ANN_BATCH_PROVIDER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "batch_provider.hpp"
+
+namespace mlpack {
+namespace ann {
+
+template<typename MatType, typename ResponsesType>
+BatchProvider<MatType, ResponsesType>::BatchProvider(
+    const MatType& predictors,
+    const ResponsesType& responses,
+    const size_t batchSize,
+    const bool shuffle) :
+    predictors(predictors),
+    responses(responses),
+    batchSize(std::max(batchSize, (size_t) 1)),
+    shuffle(shuffle),
+    cursor(0),
+    prefetched(false)
+{
+  if (predictors.n_cols != responses.n_cols)
+  {
+    throw std::invalid_argument("BatchProvider: predictors and responses "
+        "must have the same number of columns!");
+  }
+
+  ordering = arma::linspace<arma::uvec>(0, predictors.n_cols - 1,
+      predictors.n_cols);
+  StartEpoch();
+}
+
+template<typename MatType, typename ResponsesType>
+BatchProvider<MatType, ResponsesType>::~BatchProvider()
+{
+  if (pending.valid())
+    pending.wait();
+}
+
+template<typename MatType, typename ResponsesType>
+void BatchProvider<MatType, ResponsesType>::StartEpoch()
+{
+  if (shuffle)
+    ordering = arma::shuffle(ordering);
+
+  cursor = 0;
+}
+
+template<typename MatType, typename ResponsesType>
+void BatchProvider<MatType, ResponsesType>::Prefetch(const size_t begin)
+{
+  const size_t count = std::min(batchSize, (size_t) predictors.n_cols - begin);
+
+  // Gather (and optionally augment) the batch on a background thread; Next()
+  // waits on the future before touching the back buffers.
+  pending = std::async(std::launch::async, [this, begin, count]()
+  {
+    const arma::uvec batchIndices = ordering.subvec(begin, begin + count - 1);
+    pendingPredictors = predictors.cols(batchIndices);
+    pendingResponses = responses.cols(batchIndices);
+
+    if (augmentation)
+      augmentation(pendingPredictors, pendingResponses);
+  });
+  prefetched = true;
+}
+
+template<typename MatType, typename ResponsesType>
+bool BatchProvider<MatType, ResponsesType>::Next(
+    MatType& batchPredictors,
+    ResponsesType& batchResponses)
+{
+  if (cursor >= predictors.n_cols)
+  {
+    // Epoch exhausted; reshuffle for the next one.
+    StartEpoch();
+    return false;
+  }
+
+  // Cold start (first batch of the run, or right after an epoch boundary).
+  if (!prefetched)
+    Prefetch(cursor);
+
+  pending.wait();
+  prefetched = false;
+
+  // Hand the prefetched batch to the caller and reuse its old storage as the
+  // next back buffer.
+  batchPredictors.swap(pendingPredictors);
+  batchResponses.swap(pendingResponses);
+
+  cursor += std::min(batchSize, (size_t) predictors.n_cols - cursor);
+  if (cursor < predictors.n_cols)
+    Prefetch(cursor);
+
+  return true;
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
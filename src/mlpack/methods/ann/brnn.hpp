@@ -138,6 +138,32 @@ class BRNN
                arma::cube responses,
                OptimizerType& optimizer);
 
+  /**
+   * Train the bidirectional recurrent neural network on variable-length
+   * sequences using length-bucketed mini-batching.  The sequences are grouped
+   * into buckets of similar length (each bucket spans at most a factor of two
+   * in length), each bucket is unrolled only to its longest sequence instead
+   * of the full rho, and all sequences of a bucket are batched into each
+   * time-step computation.  The optimizer is run once per bucket, from
+   * shortest to longest.
+   *
+   * The data format matches the other Train() overloads: sequences shorter
+   * than the cube depth are expected to be padded at the end, and
+   * sequenceLengths[i] gives the number of valid time steps of point i.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param sequenceLengths Number of valid time steps of each data point.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @return The final objective on the last (longest) bucket.
+   */
+  template<typename OptimizerType>
+  double Train(arma::cube predictors,
+               arma::cube responses,
+               const arma::urowvec& sequenceLengths,
+               OptimizerType& optimizer);
+
   /**
    * Train the bidirectional recurrent neural network on the given input data.
    * By default, the SGD optimization algorithm is used, but others can be specified
@@ -184,6 +184,71 @@ double BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
   return out;
 }
 
+template<typename OutputLayerType, typename MergeLayerType,
+         typename MergeOutputType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename OptimizerType>
+double BRNN<OutputLayerType, MergeLayerType, MergeOutputType,
+    InitializationRuleType, CustomLayers...>::Train(
+    arma::cube predictors,
+    arma::cube responses,
+    const arma::urowvec& sequenceLengths,
+    OptimizerType& optimizer)
+{
+  if (sequenceLengths.n_elem != predictors.n_cols)
+  {
+    Log::Fatal << "BRNN::Train(): sequenceLengths must contain one length "
+        << "per data point (" << predictors.n_cols << "), but "
+        << sequenceLengths.n_elem << " were given!" << std::endl;
+  }
+
+  const arma::uvec order = arma::sort_index(sequenceLengths);
+  const size_t originalRho = rho;
+
+  double out = 0;
+  size_t begin = 0;
+  while (begin < order.n_elem)
+  {
+    // A bucket spans at most a factor of two in sequence length, so no
+    // sequence in a bucket is padded to more than twice its own length.
+    size_t end = begin + 1;
+    while (end < order.n_elem &&
+        sequenceLengths[order[end]] <= 2 * sequenceLengths[order[begin]])
+    {
+      ++end;
+    }
+
+    const arma::uvec bucket = order.subvec(begin, end - 1);
+    const size_t bucketLength = std::max(size_t(1), std::min(
+        size_t(sequenceLengths[order[end - 1]]),
+        size_t(predictors.n_slices)));
+
+    // Gather the bucket's sequences, unrolled only to the bucket length, so
+    // every time-step computation batches the whole bucket.
+    arma::cube bucketPredictors(predictors.n_rows, bucket.n_elem,
+        bucketLength);
+    for (size_t s = 0; s < bucketLength; ++s)
+      bucketPredictors.slice(s) = predictors.slice(s).cols(bucket);
+
+    arma::cube bucketResponses(responses.n_rows, bucket.n_elem,
+        std::min(bucketLength, size_t(responses.n_slices)));
+    for (size_t s = 0; s < bucketResponses.n_slices; ++s)
+      bucketResponses.slice(s) = responses.slice(s).cols(bucket);
+
+    // Both the forward and the backward pass only ever need to unroll to the
+    // bucket length; Evaluate() propagates rho to the two wrapped RNNs.  The
+    // original rho is restored once all buckets are processed.
+    rho = std::min(originalRho, bucketLength);
+    out = Train(std::move(bucketPredictors), std::move(bucketResponses),
+        optimizer);
+
+    begin = end;
+  }
+
+  rho = originalRho;
+  return out;
+}
+
 template<typename OutputLayerType, typename MergeLayerType,
          typename MergeOutputType, typename InitializationRuleType,
          typename... CustomLayers>
@@ -0,0 +1,355 @@
+/**
+ * @file methods/ann/convolution_rules/im2col_convolution.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the convolution through im2col lowering and matrix
+ * multiplication.  The input patches are gathered into a column matrix once
+ * and the convolution becomes a GEMM, which is typically much faster than the
+ * naive triple loop for realistic filter counts because it runs through the
+ * optimized BLAS kernels.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_CONVOLUTION_HPP
+#define MLPACK_METHODS_ANN_CONVOLUTION_RULES_IM2COL_CONVOLUTION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/gemm_backend.hpp>
+#include "border_modes.hpp"
+#include "naive_convolution.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Computes the two-dimensional convolution by lowering the input into an
+ * im2col patch matrix and multiplying with the vectorized filter(s).  The
+ * patch matrix is kept in a persistent thread-local buffer, so repeated calls
+ * with the same geometry (the common case inside a convolutional layer) do
+ * not allocate.
+ *
+ * The element indexing matches NaiveConvolution exactly, so this rule is a
+ * drop-in replacement wherever NaiveConvolution<ValidConvolution> or
+ * NaiveConvolution<FullConvolution> is used.  The Convolution layer
+ * additionally recognizes Im2ColConvolution<ValidConvolution> as its
+ * ForwardConvolutionRule and then lowers each input image once per batch,
+ * computing all output maps with a single GEMM.
+ *
+ * @tparam BorderMode Type of the border mode (FullConvolution or
+ * ValidConvolution).
+ */
+template<typename BorderMode = FullConvolution>
+class Im2ColConvolution
+{
+ public:
+  /*
+   * Lower the input into patch columns.  Column p of the output buffer holds
+   * the input elements that the filter touches when producing output element
+   * p (in column-major output order), using the same stride and dilation
+   * indexing as NaiveConvolution.
+   *
+   * @param input Input used to perform the convolution.
+   * @param buffer Matrix to store the patch columns into; it is only resized
+   *      when it is too small, so it can be reused across calls.
+   * @param filterRows Number of rows of the filter.
+   * @param filterCols Number of columns of the filter.
+   * @param outputRows Number of rows of the convolution output.
+   * @param outputCols Number of columns of the convolution output.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Im2Col(const arma::Mat<eT>& input,
+                     arma::Mat<eT>& buffer,
+                     const size_t filterRows,
+                     const size_t filterCols,
+                     const size_t outputRows,
+                     const size_t outputCols,
+                     const size_t dW = 1,
+                     const size_t dH = 1,
+                     const size_t dilationW = 1,
+                     const size_t dilationH = 1)
+  {
+    const size_t patchSize = filterRows * filterCols;
+    buffer.set_size(patchSize, outputRows * outputCols);
+
+    eT* bufferPtr = buffer.memptr();
+    for (size_t j = 0; j < outputCols; ++j)
+    {
+      for (size_t i = 0; i < outputRows; ++i)
+      {
+        for (size_t kj = 0; kj < filterCols; ++kj)
+        {
+          const eT* inputPtr = input.colptr(kj * dilationW + j * dW) + i * dH;
+          for (size_t ki = 0; ki < filterRows; ++ki, ++bufferPtr,
+              inputPtr += dilationH)
+            *bufferPtr = *inputPtr;
+        }
+      }
+    }
+  }
+
+  /*
+   * Perform a convolution (valid mode) as an im2col lowering followed by a
+   * matrix multiplication.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    const size_t outputRows =
+        (input.n_rows - (filter.n_rows - 1) * dilationW - 1) / dW + 1;
+    const size_t outputCols =
+        (input.n_cols - (filter.n_cols - 1) * dilationH - 1) / dH + 1;
+
+    // The patch buffer persists between calls; successive convolutions with
+    // the same geometry reuse the allocation.
+    thread_local arma::Mat<eT> buffer;
+    Im2Col(input, buffer, filter.n_rows, filter.n_cols, outputRows, outputCols,
+        dW, dH, dilationW, dilationH);
+
+    const arma::Mat<eT> filterVector(
+        const_cast<arma::Mat<eT>&>(filter).memptr(), filter.n_elem, 1, false,
+        true);
+    arma::Mat<eT> outputVector;
+    Gemm(filterVector, buffer, outputVector, true);
+    output = arma::reshape(outputVector, outputRows, outputCols);
+  }
+
+  /*
+   * Perform a convolution (full mode).
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Mat<eT>& filter,
+              arma::Mat<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    // Reuse the padding arithmetic of the naive rule, then run the lowered
+    // valid-mode convolution on the padded input.
+    size_t outputRows = (input.n_rows - 1) * dW + 2 * (filter.n_rows - 1)
+        * dilationW + 1;
+    size_t outputCols = (input.n_cols - 1) * dH + 2 * (filter.n_cols - 1)
+        * dilationH + 1;
+
+    for (size_t i = 0; i < dW; ++i)
+    {
+      if (((((i + outputRows - 2 * (filter.n_rows - 1) * dilationW - 1) % dW)
+          + dW) % dW) == i)
+      {
+        outputRows += i;
+        break;
+      }
+    }
+    for (size_t i = 0; i < dH; ++i)
+    {
+      if (((((i + outputCols - 2 * (filter.n_cols - 1) * dilationH - 1) % dH)
+          + dH) % dH) == i)
+      {
+        outputCols += i;
+        break;
+      }
+    }
+
+    arma::Mat<eT> inputPadded = arma::zeros<arma::Mat<eT> >(outputRows,
+        outputCols);
+    inputPadded.submat((filter.n_rows - 1) * dilationW, (filter.n_cols - 1)
+        * dilationH, (filter.n_rows - 1) * dilationW + input.n_rows - 1,
+        (filter.n_cols - 1) * dilationH + input.n_cols - 1) = input;
+
+    Im2ColConvolution<ValidConvolution>::Convolution(inputPadded, filter,
+        output, 1, 1, dilationW, dilationH);
+  }
+
+  /*
+   * Perform a convolution using 3rd order tensors.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Cube<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input.slice(0), filter.slice(0),
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input.slice(i),
+          filter.slice(i), output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using dense matrix as input and a 3rd order tensors
+   * as filter and output.  The input is lowered only once; all filter slices
+   * are applied with a single matrix multiplication.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, ValidConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Cube<eT>& filter,
+              arma::Cube<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    const size_t outputRows =
+        (input.n_rows - (filter.n_rows - 1) * dilationW - 1) / dW + 1;
+    const size_t outputCols =
+        (input.n_cols - (filter.n_cols - 1) * dilationH - 1) / dH + 1;
+
+    thread_local arma::Mat<eT> buffer;
+    Im2Col(input, buffer, filter.n_rows, filter.n_cols, outputRows, outputCols,
+        dW, dH, dilationW, dilationH);
+
+    // One GEMM for all filter slices: each column of the filter matrix is one
+    // vectorized filter.
+    const arma::Mat<eT> filterMatrix(
+        const_cast<arma::Cube<eT>&>(filter).memptr(),
+        filter.n_rows * filter.n_cols, filter.n_slices, false, true);
+
+    output.set_size(outputRows, outputCols, filter.n_slices);
+    arma::Mat<eT> outputAlias(output.memptr(), outputRows * outputCols,
+        filter.n_slices, false, true);
+    Gemm(buffer, filterMatrix, outputAlias, true);
+  }
+
+  /*
+   * Perform a full-mode convolution using a dense matrix as input and a 3rd
+   * order tensor as filter and output.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT, typename Border = BorderMode>
+  static typename std::enable_if<
+      std::is_same<Border, FullConvolution>::value, void>::type
+  Convolution(const arma::Mat<eT>& input,
+              const arma::Cube<eT>& filter,
+              arma::Cube<eT>& output,
+              const size_t dW = 1,
+              const size_t dH = 1,
+              const size_t dilationW = 1,
+              const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input, filter.slice(0),
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        filter.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < filter.n_slices; ++i)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input, filter.slice(i),
+          output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+
+  /*
+   * Perform a convolution using a 3rd order tensors as input and output and a
+   * dense matrix as filter.
+   *
+   * @param input Input used to perform the convolution.
+   * @param filter Filter used to perform the convolution.
+   * @param output Output data that contains the results of the convolution.
+   * @param dW Stride of filter application in the x direction.
+   * @param dH Stride of filter application in the y direction.
+   * @param dilationW The dilation factor in x direction.
+   * @param dilationH The dilation factor in y direction.
+   */
+  template<typename eT>
+  static void Convolution(const arma::Cube<eT>& input,
+                          const arma::Mat<eT>& filter,
+                          arma::Cube<eT>& output,
+                          const size_t dW = 1,
+                          const size_t dH = 1,
+                          const size_t dilationW = 1,
+                          const size_t dilationH = 1)
+  {
+    arma::Mat<eT> convOutput;
+    Im2ColConvolution<BorderMode>::Convolution(input.slice(0), filter,
+        convOutput, dW, dH, dilationW, dilationH);
+
+    output = arma::Cube<eT>(convOutput.n_rows, convOutput.n_cols,
+        input.n_slices);
+    output.slice(0) = convOutput;
+
+    for (size_t i = 1; i < input.n_slices; ++i)
+    {
+      Im2ColConvolution<BorderMode>::Convolution(input.slice(i), filter,
+          output.slice(i), dW, dH, dilationW, dilationH);
+    }
+  }
+};  // class Im2ColConvolution
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
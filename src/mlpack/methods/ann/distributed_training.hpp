@@ -0,0 +1,198 @@
+/**
+ * @file methods/ann/distributed_training.hpp
+ * @author Ryan Curtin
+ *
+ * Hooks for data-parallel distributed training of mlpack networks.  These are
+ * ensmallen callbacks that expose the synchronization points of a training
+ * step---the flattened gradient after each evaluation, and the parameters at
+ * the end of each epoch---to a user-supplied allreduce, plus a deterministic
+ * sharding helper for splitting a dataset across nodes.  mlpack itself does
+ * not provide a transport; the allreduce is any callable (MPI, NCCL, a
+ * gloo-style rendezvous, or a test stub), so multi-node training needs no
+ * changes to the training path itself.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_DISTRIBUTED_TRAINING_HPP
+#define MLPACK_METHODS_ANN_DISTRIBUTED_TRAINING_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * An ensmallen callback that passes the flattened gradient of every optimizer
+ * step to a user-supplied allreduce.  The allreduce is any callable taking
+ * the gradient matrix by non-const reference; for data-parallel training it
+ * should replace each node's local gradient with the average of all nodes'
+ * gradients, after which every node takes the same optimizer step.
+ *
+ * An example with an MPI-style transport:
+ *
+ * @code
+ * GradientAllreduce<> sync([](arma::mat& gradient)
+ * {
+ *   // Average the gradient across all ranks (transport-specific).
+ *   MyAllreduce(gradient.memptr(), gradient.n_elem);
+ *   gradient /= (double) worldSize;
+ * });
+ *
+ * model.Train(shardData, shardLabels, optimizer, sync);
+ * @endcode
+ *
+ * @tparam AllreduceType Type of the allreduce callable.
+ */
+template<typename AllreduceType = std::function<void(arma::mat&)>>
+class GradientAllreduce
+{
+ public:
+  /**
+   * Construct the callback with the given allreduce.
+   *
+   * @param allreduce Callable invoked on the gradient of every step.
+   */
+  GradientAllreduce(AllreduceType allreduce) :
+      allreduce(std::move(allreduce)),
+      steps(0)
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Callback for ensmallen optimizers, called with the gradient of each
+   * evaluation before the optimizer applies it.
+   */
+  template<typename OptimizerType,
+           typename FunctionType,
+           typename MatType,
+           typename GradType>
+  bool Gradient(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                const MatType& /* coordinates */,
+                GradType& gradient)
+  {
+    allreduce(gradient);
+    ++steps;
+
+    return false;
+  }
+
+  //! Get the number of gradient synchronizations performed so far.
+  size_t Steps() const { return steps; }
+
+ private:
+  //! The user-supplied allreduce.
+  AllreduceType allreduce;
+  //! Number of synchronizations performed.
+  size_t steps;
+};
+
+/**
+ * An ensmallen callback that passes the model parameters to a user-supplied
+ * allreduce at the end of every `interval`th epoch.  For data-parallel
+ * training the allreduce should replace each node's parameters with the
+ * average of all nodes' parameters; this is cheaper than per-step gradient
+ * synchronization (one exchange per epoch instead of one per step) at the
+ * cost of the shards drifting apart between synchronizations.
+ *
+ * @tparam AllreduceType Type of the allreduce callable.
+ */
+template<typename AllreduceType = std::function<void(arma::mat&)>>
+class EpochParameterAverage
+{
+ public:
+  /**
+   * Construct the callback with the given allreduce.
+   *
+   * @param allreduce Callable invoked on the parameters.
+   * @param interval Number of epochs between synchronizations.
+   */
+  EpochParameterAverage(AllreduceType allreduce, const size_t interval = 1) :
+      allreduce(std::move(allreduce)),
+      interval(std::max(interval, (size_t) 1))
+  {
+    // Nothing to do.
+  }
+
+  /**
+   * Callback for ensmallen optimizers, called at the end of each epoch;
+   * synchronizes the parameters every `interval` epochs.
+   */
+  template<typename OptimizerType, typename FunctionType, typename MatType>
+  bool EndEpoch(OptimizerType& /* optimizer */,
+                FunctionType& /* function */,
+                MatType& coordinates,
+                const size_t epoch,
+                const double /* objective */)
+  {
+    if (epoch % interval == 0)
+      allreduce(coordinates);
+
+    return false;
+  }
+
+  //! Get the number of epochs between synchronizations.
+  size_t Interval() const { return interval; }
+  //! Modify the number of epochs between synchronizations.
+  size_t& Interval() { return interval; }
+
+ private:
+  //! The user-supplied allreduce.
+  AllreduceType allreduce;
+  //! Number of epochs between synchronizations.
+  size_t interval;
+};
+
+/**
+ * Deterministically extract one node's shard of a dataset for data-parallel
+ * training.  Columns are assigned round robin---node `rank` receives columns
+ * rank, rank + worldSize, rank + 2 * worldSize, and so on---so every node
+ * computes the same partition without communication, the shards are balanced
+ * to within one point, and interleaving keeps any ordering of the original
+ * dataset (such as sorted labels) evenly spread across the nodes.
+ *
+ * The labels (or responses) matrix must have one column per point, like the
+ * data matrix.
+ *
+ * @param data Full data matrix (one point per column).
+ * @param labels Full labels or responses matrix (one column per point).
+ * @param rank This node's rank, in [0, worldSize).
+ * @param worldSize Total number of nodes.
+ * @param shardData Matrix to store this node's share of the data in.
+ * @param shardLabels Matrix to store this node's share of the labels in.
+ */
+template<typename MatType, typename LabelsType>
+void ShardTrainingData(const MatType& data,
+                       const LabelsType& labels,
+                       const size_t rank,
+                       const size_t worldSize,
+                       MatType& shardData,
+                       LabelsType& shardLabels)
+{
+  if (worldSize == 0 || rank >= worldSize)
+    throw std::invalid_argument("ShardTrainingData(): rank must be less than "
+        "worldSize, and worldSize must be positive");
+  if (data.n_cols != labels.n_cols)
+    throw std::invalid_argument("ShardTrainingData(): data and labels must "
+        "have the same number of columns");
+
+  const size_t shardSize = (data.n_cols > rank) ?
+      (data.n_cols - rank + worldSize - 1) / worldSize : 0;
+
+  shardData.set_size(data.n_rows, shardSize);
+  shardLabels.set_size(labels.n_rows, shardSize);
+  for (size_t i = 0; i < shardSize; ++i)
+  {
+    shardData.col(i) = data.col(rank + i * worldSize);
+    shardLabels.col(i) = labels.col(rank + i * worldSize);
+  }
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
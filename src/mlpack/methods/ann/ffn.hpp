@@ -23,6 +23,7 @@
 #include "visitor/reset_visitor.hpp"
 #include "visitor/weight_size_visitor.hpp"
 #include "visitor/copy_visitor.hpp"
+#include "visitor/forward_function_visitor.hpp"
 #include "visitor/loss_visitor.hpp"
 
 #include "init_rules/network_init.hpp"
@@ -176,6 +177,88 @@ class FFN
    */
   void Predict(arma::mat predictors, arma::mat& results);
 
+  /**
+   * Freeze the network for inference.  This flattens the layer list into a
+   * plan of directly callable forward functions (the boost::variant dispatch
+   * is resolved once, here, instead of on every call) and switches Predict()
+   * to a batched path that feeds each layer from preallocated activation
+   * buffers.  After the first frozen Predict() call has warmed the buffers,
+   * subsequent calls with batches of up to maxBatchSize points perform no
+   * per-call allocations, which keeps tail latencies stable for serving
+   * workloads.
+   *
+   * The network must not be modified while frozen: call Unfreeze() before
+   * Add()ing layers or calling Train().  Freeze() implies deterministic
+   * (inference) mode.
+   *
+   * @param maxBatchSize Largest number of points Predict() will be given at
+   *      once; larger inputs are processed in chunks of this size.
+   */
+  void Freeze(const size_t maxBatchSize = 256);
+
+  /**
+   * Drop the frozen inference plan built by Freeze() and return to the
+   * ordinary layer-list execution, e.g. for further training.
+   */
+  void Unfreeze();
+
+  //! Return whether the network is currently frozen for inference.
+  bool Frozen() const { return frozen; }
+
+  /**
+   * Create a lightweight inference replica that shares this network's
+   * weights.  The replica gets its own layer objects -- and with them its
+   * own activation buffers, deltas and any other per-call state -- but its
+   * parameter matrix is a non-owning alias of this network's, so N serving
+   * threads need one copy of the weights plus N small replicas instead of N
+   * full model copies.
+   *
+   * Each replica may be used from one thread at a time; concurrent serving
+   * threads should each hold their own replica.  Replicas are created in
+   * deterministic (inference) mode and must not be trained: training would
+   * write through the shared weights under the parent's feet.  The parent
+   * network must outlive its replicas, and retraining the parent is visible
+   * to them (the weights are shared), so replicas should be recreated if the
+   * parent's parameter matrix is resized.
+   *
+   * @return A replica suitable for Predict() and Forward() calls.
+   */
+  FFN InferenceReplica() const;
+
+  /**
+   * Enable activation checkpointing for training.  During
+   * EvaluateWithGradient(), the network is split into segments and only the
+   * activations entering each segment are kept alive; intra-segment
+   * activations are freed as the forward pass moves on and recomputed
+   * segment by segment during the backward pass.  With the default segment
+   * count of ceil(sqrt(L)) for an L-layer network this reduces the
+   * activation memory footprint from O(L) to O(sqrt(L)) at the cost of one
+   * extra forward pass, which allows much larger batch sizes on deep
+   * networks.
+   *
+   * Note that layers with a stochastic forward pass (e.g. Dropout) are
+   * recomputed with fresh noise, so their gradients become approximate in
+   * this mode.
+   *
+   * @param segments Number of segments to split the network into; 0 means
+   *      ceil(sqrt(number of layers)).
+   */
+  void EnableCheckpointing(const size_t segments = 0)
+  {
+    checkpointing = true;
+    checkpointSegments = segments;
+  }
+
+  //! Return to the ordinary training path that keeps all activations alive.
+  void DisableCheckpointing()
+  {
+    checkpointing = false;
+    checkpointInputs.clear();
+  }
+
+  //! Return whether activation checkpointing is enabled.
+  bool Checkpointing() const { return checkpointing; }
+
   /**
    * Evaluate the feedforward network with the given predictors and responses.
    * This functions is usually used to monitor progress while training.
@@ -408,6 +491,22 @@ class FFN
    */
   void Backward();
 
+  /**
+   * Objective and gradient computation with activation checkpointing (see
+   * EnableCheckpointing()).  The forward pass keeps only segment-boundary
+   * activations; the backward pass recomputes, backpropagates and frees one
+   * segment at a time.
+   *
+   * @param begin Index of the starting point to use for objective function
+   *        gradient evaluation.
+   * @param gradient Matrix to output gradient into.
+   * @param batchSize Number of points to be processed as a batch.
+   */
+  template<typename GradType>
+  double EvaluateWithGradientCheckpointed(const size_t begin,
+                                          GradType& gradient,
+                                          const size_t batchSize);
+
   /**
    * Iterate through all layer modules and update the the gradient using the
    * layer defined optimizer.
@@ -494,6 +593,28 @@ class FFN
   //! The current evaluation mode (training or testing).
   bool deterministic;
 
+  //! Whether the network is frozen for inference (see Freeze()).
+  bool frozen;
+
+  //! The maximum batch size the frozen plan was built for.
+  size_t frozenBatchSize;
+
+  //! Directly callable forward functions of the frozen plan, one per layer.
+  std::vector<std::function<void(const arma::mat&, arma::mat&)> >
+      frozenForward;
+
+  //! Preallocated activation buffers of the frozen plan, one per layer.
+  std::vector<arma::mat> frozenActivations;
+
+  //! Whether activation checkpointing is enabled for training.
+  bool checkpointing;
+
+  //! The configured number of checkpoint segments (0 = ceil(sqrt(L))).
+  size_t checkpointSegments;
+
+  //! Checkpointed activations entering each segment.
+  std::vector<arma::mat> checkpointInputs;
+
   //! Locally-stored delta object.
   arma::mat delta;
 
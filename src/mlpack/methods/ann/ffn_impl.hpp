@@ -22,6 +22,7 @@
 #include "visitor/gradient_visitor.hpp"
 #include "visitor/set_input_height_visitor.hpp"
 #include "visitor/set_input_width_visitor.hpp"
+#include "visitor/weight_set_visitor.hpp"
 
 #include <boost/serialization/variant.hpp>
 
@@ -39,7 +40,11 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     height(0),
     reset(false),
     numFunctions(0),
-    deterministic(false)
+    deterministic(false),
+    frozen(false),
+    frozenBatchSize(0),
+    checkpointing(false),
+    checkpointSegments(0)
 {
   /* Nothing to do here. */
 }
@@ -63,6 +68,10 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::ResetData(
   this->deterministic = false;
   ResetDeterministic();
 
+  // Training invalidates any frozen inference plan.
+  if (frozen)
+    Unfreeze();
+
   if (!reset)
     ResetParameters();
 }
@@ -228,6 +237,41 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
     ResetDeterministic();
   }
 
+  if (frozen)
+  {
+    // If the layer input dimensions have never been propagated (the network
+    // has not yet done a forward pass), run one ordinary pass first.
+    if (!reset)
+    {
+      Forward(arma::mat(predictors.colptr(0), predictors.n_rows, 1, false,
+          true));
+    }
+
+    // Process the input in chunks of the planned batch size; after the first
+    // call the activation buffers are warm and no allocations happen.
+    for (size_t begin = 0; begin < predictors.n_cols;
+        begin += frozenBatchSize)
+    {
+      const size_t cols = std::min(frozenBatchSize,
+          (size_t) predictors.n_cols - begin);
+      const arma::mat chunk(predictors.colptr(begin), predictors.n_rows,
+          cols, false, true);
+
+      frozenForward.front()(chunk, frozenActivations.front());
+      for (size_t i = 1; i < frozenForward.size(); ++i)
+        frozenForward[i](frozenActivations[i - 1], frozenActivations[i]);
+
+      if (begin == 0)
+      {
+        results.set_size(frozenActivations.back().n_rows, predictors.n_cols);
+      }
+
+      results.cols(begin, begin + cols - 1) = frozenActivations.back();
+    }
+
+    return;
+  }
+
   arma::mat resultsTemp;
   Forward(arma::mat(predictors.colptr(0), predictors.n_rows, 1, false, true));
   resultsTemp = boost::apply_visitor(outputParameterVisitor,
@@ -246,6 +290,87 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Predict(
   }
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Freeze(
+    const size_t maxBatchSize)
+{
+  if (parameter.is_empty())
+    ResetParameters();
+
+  deterministic = true;
+  ResetDeterministic();
+
+  frozenBatchSize = std::max(maxBatchSize, (size_t) 1);
+
+  // Resolve the variant dispatch once per layer; the stored functions call
+  // the concrete layers directly.
+  frozenForward.clear();
+  frozenForward.reserve(network.size());
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    frozenForward.push_back(boost::apply_visitor(ForwardFunctionVisitor(),
+        network[i]));
+  }
+
+  // The activation buffers are sized by the first frozen Predict() call and
+  // then reused.
+  frozenActivations.clear();
+  frozenActivations.resize(network.size());
+
+  frozen = true;
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Unfreeze()
+{
+  frozen = false;
+  frozenForward.clear();
+  frozenActivations.clear();
+}
+
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+FFN<OutputLayerType, InitializationRuleType, CustomLayers...>
+FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::
+InferenceReplica() const
+{
+  FFN replica(outputLayer, initializeRule);
+
+  replica.width = width;
+  replica.height = height;
+
+  // Give the replica its own layer objects; all per-call mutable state
+  // (activation buffers, deltas) lives in these.
+  for (size_t i = 0; i < network.size(); ++i)
+  {
+    replica.network.push_back(boost::apply_visitor(replica.copyVisitor,
+        network[i]));
+  }
+
+  // Alias the shared weights instead of copying them, then rebind every
+  // replica layer into the shared memory.  The layer copies above briefly
+  // hold their own weight copies; WeightSetVisitor replaces those with
+  // aliases into the parent's parameter matrix.
+  replica.parameter = arma::mat(const_cast<double*>(parameter.memptr()),
+      parameter.n_rows, parameter.n_cols, false, false);
+
+  size_t offset = 0;
+  for (size_t i = 0; i < replica.network.size(); ++i)
+  {
+    offset += boost::apply_visitor(
+        WeightSetVisitor(replica.parameter, offset), replica.network[i]);
+    boost::apply_visitor(replica.resetVisitor, replica.network[i]);
+  }
+
+  replica.reset = reset;
+  replica.deterministic = true;
+  replica.ResetDeterministic();
+
+  return replica;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 template<typename PredictorsType, typename ResponsesType>
@@ -364,6 +489,9 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
     ResetDeterministic();
   }
 
+  if (checkpointing)
+    return EvaluateWithGradientCheckpointed(begin, gradient, batchSize);
+
   Forward(predictors.cols(begin, begin + batchSize - 1));
   double res = outputLayer.Forward(
       boost::apply_visitor(outputParameterVisitor, network.back()),
@@ -386,6 +514,171 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   return res;
 }
 
+template<typename OutputLayerType, typename InitializationRuleType,
+         typename... CustomLayers>
+template<typename GradType>
+double FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::
+EvaluateWithGradientCheckpointed(const size_t begin,
+                                 GradType& gradient,
+                                 const size_t batchSize)
+{
+  const size_t numLayers = network.size();
+  const arma::mat input = predictors.cols(begin, begin + batchSize - 1);
+
+  // Split the network into roughly sqrt(L) segments (or the configured
+  // number); only the activations entering each segment stay alive across
+  // the whole pass.
+  size_t segments = (checkpointSegments == 0) ?
+      (size_t) std::ceil(std::sqrt((double) numLayers)) : checkpointSegments;
+  segments = std::min(std::max(segments, (size_t) 1), numLayers);
+  const size_t segmentLength = (numLayers + segments - 1) / segments;
+
+  std::vector<size_t> segmentStarts;
+  for (size_t i = 0; i < numLayers; i += segmentLength)
+    segmentStarts.push_back(i);
+  checkpointInputs.resize(segmentStarts.size());
+
+  // Forward pass, as in Forward(): activations behind the pass are freed as
+  // soon as the next layer has consumed them, except at segment boundaries,
+  // where a copy is checkpointed, and in the last segment, whose backward
+  // pass runs first and needs no recomputation.
+  boost::apply_visitor(ForwardVisitor(input,
+      boost::apply_visitor(outputParameterVisitor, network.front())),
+      network.front());
+
+  if (!reset)
+  {
+    if (boost::apply_visitor(outputWidthVisitor, network.front()) != 0)
+      width = boost::apply_visitor(outputWidthVisitor, network.front());
+
+    if (boost::apply_visitor(outputHeightVisitor, network.front()) != 0)
+      height = boost::apply_visitor(outputHeightVisitor, network.front());
+  }
+
+  size_t segment = 0;
+  for (size_t i = 1; i < numLayers; ++i)
+  {
+    if (!reset)
+    {
+      boost::apply_visitor(SetInputWidthVisitor(width), network[i]);
+      boost::apply_visitor(SetInputHeightVisitor(height), network[i]);
+    }
+
+    if (segment + 1 < segmentStarts.size() && i == segmentStarts[segment + 1])
+    {
+      checkpointInputs[++segment] = boost::apply_visitor(
+          outputParameterVisitor, network[i - 1]);
+    }
+
+    boost::apply_visitor(ForwardVisitor(boost::apply_visitor(
+        outputParameterVisitor, network[i - 1]),
+        boost::apply_visitor(outputParameterVisitor, network[i])), network[i]);
+
+    if (i - 1 < segmentStarts.back())
+      boost::apply_visitor(outputParameterVisitor, network[i - 1]).reset();
+
+    if (!reset)
+    {
+      if (boost::apply_visitor(outputWidthVisitor, network[i]) != 0)
+        width = boost::apply_visitor(outputWidthVisitor, network[i]);
+
+      if (boost::apply_visitor(outputHeightVisitor, network[i]) != 0)
+        height = boost::apply_visitor(outputHeightVisitor, network[i]);
+    }
+  }
+
+  if (!reset)
+    reset = true;
+
+  double res = outputLayer.Forward(
+      boost::apply_visitor(outputParameterVisitor, network.back()),
+      responses.cols(begin, begin + batchSize - 1));
+
+  for (size_t i = 0; i < numLayers; ++i)
+  {
+    res += boost::apply_visitor(lossVisitor, network[i]);
+  }
+
+  outputLayer.Backward(
+      boost::apply_visitor(outputParameterVisitor, network.back()),
+      responses.cols(begin, begin + batchSize - 1),
+      error);
+
+  ResetGradients(gradient);
+
+  // Backward pass, one segment at a time: recompute the segment's
+  // activations from its checkpoint, backpropagate through it, accumulate
+  // the gradients of its layers, and free the segment again.
+  arma::mat boundaryDelta;
+  for (size_t k = segmentStarts.size(); k > 0; --k)
+  {
+    const size_t b = segmentStarts[k - 1];
+    const size_t e = (k == segmentStarts.size()) ? numLayers - 1 :
+        segmentStarts[k] - 1;
+    const arma::mat& segmentInput = (k == 1) ? input : checkpointInputs[k - 1];
+
+    if (k != segmentStarts.size())
+    {
+      boost::apply_visitor(ForwardVisitor(segmentInput,
+          boost::apply_visitor(outputParameterVisitor, network[b])),
+          network[b]);
+
+      for (size_t i = b + 1; i <= e; ++i)
+      {
+        boost::apply_visitor(ForwardVisitor(boost::apply_visitor(
+            outputParameterVisitor, network[i - 1]),
+            boost::apply_visitor(outputParameterVisitor, network[i])),
+            network[i]);
+      }
+    }
+
+    // The delta entering the segment from above is the output layer error
+    // for the last network layer and the saved boundary delta otherwise.
+    // As in Backward(), no delta is computed for the first network layer.
+    for (size_t i = e + 1; i > b; --i)
+    {
+      const size_t layer = i - 1;
+      if (layer == 0 && numLayers > 1)
+        break;
+
+      const arma::mat& gy = (layer == numLayers - 1) ? error :
+          ((layer == e) ? boundaryDelta :
+          boost::apply_visitor(deltaVisitor, network[layer + 1]));
+
+      boost::apply_visitor(BackwardVisitor(boost::apply_visitor(
+          outputParameterVisitor, network[layer]), gy,
+          boost::apply_visitor(deltaVisitor, network[layer])),
+          network[layer]);
+    }
+
+    // Accumulate the gradients of the segment's layers while its
+    // activations are alive, mirroring Gradient().
+    for (size_t layer = b; layer <= e; ++layer)
+    {
+      const arma::mat& layerInput = (layer == b) ? segmentInput :
+          boost::apply_visitor(outputParameterVisitor, network[layer - 1]);
+      const arma::mat& layerDelta = (layer == numLayers - 1) ? error :
+          ((layer == e) ? boundaryDelta :
+          boost::apply_visitor(deltaVisitor, network[layer + 1]));
+
+      boost::apply_visitor(GradientVisitor(layerInput, layerDelta),
+          network[layer]);
+    }
+
+    // Save the delta entering the segment below, then free this segment.
+    if (b > 0)
+      boundaryDelta = boost::apply_visitor(deltaVisitor, network[b]);
+
+    for (size_t layer = b; layer <= e; ++layer)
+    {
+      boost::apply_visitor(outputParameterVisitor, network[layer]).reset();
+      boost::apply_visitor(deltaVisitor, network[layer]).reset();
+    }
+  }
+
+  return res;
+}
+
 template<typename OutputLayerType, typename InitializationRuleType,
          typename... CustomLayers>
 void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::Gradient(
@@ -567,6 +860,11 @@ void FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::serialize(
     std::for_each(network.begin(), network.end(),
         boost::apply_visitor(deleteVisitor));
     network.clear();
+
+    // Any frozen inference plan refers to the old layers.
+    frozen = false;
+    frozenForward.clear();
+    frozenActivations.clear();
   }
 
   ar & BOOST_SERIALIZATION_NVP(network);
@@ -610,6 +908,13 @@ void FFN<OutputLayerType, InitializationRuleType,
   std::swap(numFunctions, network.numFunctions);
   std::swap(error, network.error);
   std::swap(deterministic, network.deterministic);
+  std::swap(frozen, network.frozen);
+  std::swap(frozenBatchSize, network.frozenBatchSize);
+  std::swap(frozenForward, network.frozenForward);
+  std::swap(frozenActivations, network.frozenActivations);
+  std::swap(checkpointing, network.checkpointing);
+  std::swap(checkpointSegments, network.checkpointSegments);
+  std::swap(checkpointInputs, network.checkpointInputs);
   std::swap(delta, network.delta);
   std::swap(inputParameter, network.inputParameter);
   std::swap(outputParameter, network.outputParameter);
@@ -631,6 +936,10 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     numFunctions(network.numFunctions),
     error(network.error),
     deterministic(network.deterministic),
+    frozen(false),
+    frozenBatchSize(0),
+    checkpointing(network.checkpointing),
+    checkpointSegments(network.checkpointSegments),
     delta(network.delta),
     inputParameter(network.inputParameter),
     outputParameter(network.outputParameter),
@@ -660,6 +969,10 @@ FFN<OutputLayerType, InitializationRuleType, CustomLayers...>::FFN(
     numFunctions(network.numFunctions),
     error(std::move(network.error)),
     deterministic(network.deterministic),
+    frozen(false),
+    frozenBatchSize(0),
+    checkpointing(network.checkpointing),
+    checkpointSegments(network.checkpointSegments),
     delta(std::move(network.delta)),
     inputParameter(std::move(network.inputParameter)),
     outputParameter(std::move(network.outputParameter)),
@@ -0,0 +1,183 @@
+/**
+ * @file methods/ann/fold_batch_norm.hpp
+ * @author Marcus Edel
+ *
+ * Folding of trained BatchNorm layers into the preceding Linear or
+ * Convolution layer.  At inference time a BatchNorm layer is just a
+ * per-channel affine transform, so its scale and shift can be absorbed into
+ * the weights and biases of the layer before it, removing the BatchNorm
+ * layer (and its pass over the activations) from Predict() entirely.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_FOLD_BATCH_NORM_HPP
+#define MLPACK_METHODS_ANN_FOLD_BATCH_NORM_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <mlpack/methods/ann/ffn.hpp>
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+#include <mlpack/methods/ann/visitor/delete_visitor.hpp>
+#include <mlpack/methods/ann/visitor/reset_visitor.hpp>
+#include <mlpack/methods/ann/visitor/weight_size_visitor.hpp>
+#include <mlpack/methods/ann/visitor/weight_set_visitor.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Fold every BatchNorm layer that directly follows a Linear or Convolution
+ * layer into that layer's weights and biases, and remove the folded BatchNorm
+ * layers from the network.  With running mean m, running variance v, scale
+ * gamma and shift beta, the folded layer computes
+ *
+ *   s = gamma / sqrt(v + eps),
+ *   W' = diag(s) * W,  b' = s % (b - m) + beta,
+ *
+ * which is exactly what the Linear/Convolution + BatchNorm pair computes in
+ * deterministic mode, so Predict() results are unchanged (up to floating
+ * point rounding).
+ *
+ * The transformation uses the running (training) statistics, so it should
+ * only be applied to a trained network that will be used for inference; the
+ * folded network can no longer be trained with batch normalization.
+ * BatchNorm layers that do not directly follow a Linear or Convolution layer
+ * (or whose size does not match the preceding layer's output size) are left
+ * in place.
+ *
+ * @param network The network to transform.
+ */
+template<typename OutputLayerType,
+         typename InitializationRuleType,
+         typename... CustomLayers>
+void FoldBatchNorm(
+    FFN<OutputLayerType, InitializationRuleType, CustomLayers...>& network)
+{
+  typedef Convolution<NaiveConvolution<ValidConvolution>,
+                      NaiveConvolution<FullConvolution>,
+                      NaiveConvolution<ValidConvolution>,
+                      arma::mat, arma::mat> ConvolutionType;
+
+  std::vector<LayerTypes<CustomLayers...> >& layers = network.Model();
+
+  // Nothing to fold if the network has not been initialized yet.
+  if (network.Parameters().is_empty())
+    return;
+
+  // Compute the offset of each layer in the flat parameter vector.
+  WeightSizeVisitor weightSizeVisitor;
+  std::vector<size_t> offsets(layers.size() + 1, 0);
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    offsets[i + 1] = offsets[i] + boost::apply_visitor(weightSizeVisitor,
+        layers[i]);
+  }
+
+  // Fold each BatchNorm layer into the layer before it, where possible.  The
+  // layer weights alias the flat parameter vector, so the modifications below
+  // write straight into it.
+  std::vector<bool> folded(layers.size(), false);
+  size_t removedWeights = 0;
+  for (size_t i = 1; i < layers.size(); ++i)
+  {
+    BatchNorm<>* const* batchNorm = boost::get<BatchNorm<>*>(&layers[i]);
+    if (!batchNorm)
+      continue;
+
+    const size_t size = (*batchNorm)->InputSize();
+    const arma::mat& batchNormWeights = (*batchNorm)->Parameters();
+    const arma::vec scale = batchNormWeights.rows(0, size - 1) /
+        arma::sqrt((*batchNorm)->TrainingVariance() + (*batchNorm)->Epsilon());
+    const arma::vec shift = batchNormWeights.rows(size, 2 * size - 1) -
+        scale % (*batchNorm)->TrainingMean();
+
+    Linear<>* const* linear = boost::get<Linear<>*>(&layers[i - 1]);
+    ConvolutionType* const* convolution =
+        boost::get<ConvolutionType*>(&layers[i - 1]);
+
+    if (linear && (*linear)->OutputSize() == size)
+    {
+      // Scale row j of the weight matrix and bias element j by scale(j).
+      (*linear)->Weight().each_col() %= scale;
+      (*linear)->Bias() = scale % (*linear)->Bias() + shift;
+    }
+    else if (convolution && (*convolution)->OutputSize() == size)
+    {
+      // Slices [o * inSize, (o + 1) * inSize) of the weight cube produce
+      // output map o, so all of them are scaled by scale(o).
+      const size_t inSize = (*convolution)->InputSize();
+      for (size_t o = 0; o < size; ++o)
+      {
+        for (size_t in = 0; in < inSize; ++in)
+          (*convolution)->Weight().slice(o * inSize + in) *= scale(o);
+      }
+      (*convolution)->Bias() = scale % (*convolution)->Bias() + shift;
+    }
+    else
+    {
+      continue;
+    }
+
+    folded[i] = true;
+    removedWeights += offsets[i + 1] - offsets[i];
+  }
+
+  if (removedWeights == 0)
+    return;
+
+  // Rebuild the flat parameter vector without the folded layers' segments.
+  arma::mat& parameter = network.Parameters();
+  arma::mat newParameter(offsets.back() - removedWeights, 1);
+  size_t offset = 0;
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    if (folded[i])
+      continue;
+
+    const size_t weights = offsets[i + 1] - offsets[i];
+    if (weights > 0)
+    {
+      newParameter.rows(offset, offset + weights - 1) =
+          parameter.rows(offsets[i], offsets[i + 1] - 1);
+      offset += weights;
+    }
+  }
+
+  // Remove (and free) the folded layers.
+  DeleteVisitor deleteVisitor;
+  std::vector<LayerTypes<CustomLayers...> > keptLayers;
+  keptLayers.reserve(layers.size());
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    if (folded[i])
+      boost::apply_visitor(deleteVisitor, layers[i]);
+    else
+      keptLayers.push_back(layers[i]);
+  }
+  layers = std::move(keptLayers);
+
+  // Re-alias the remaining layers into the new parameter vector.  Reset()
+  // re-initializes the weights of some layers (e.g. a BatchNorm layer that
+  // was left in place), so the trained values are restored afterwards; the
+  // assignment reuses the parameter memory since the size is unchanged, which
+  // keeps the layer aliases valid.
+  const arma::mat savedParameter = newParameter;
+  parameter = std::move(newParameter);
+  ResetVisitor resetVisitor;
+  offset = 0;
+  for (size_t i = 0; i < layers.size(); ++i)
+  {
+    offset += boost::apply_visitor(WeightSetVisitor(parameter, offset),
+        layers[i]);
+    boost::apply_visitor(resetVisitor, layers[i]);
+  }
+  parameter = savedParameter;
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
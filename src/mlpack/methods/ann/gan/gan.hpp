@@ -326,6 +326,19 @@ class GAN
   //! Modify the matrix of data points (predictors).
   arma::mat& Predictors() { return predictors; }
 
+  //! Return whether pipelined training is enabled.
+  bool Pipeline() const { return pipeline; }
+  /**
+   * Enable or disable pipelined training.  In pipelined mode, the fake batch
+   * for a training step (a noise draw and a generator forward pass) is
+   * produced on a worker thread while the discriminator computes its gradient
+   * on the real batch; the two touch disjoint state, so the result of every
+   * step is unchanged.  The noise function and any stochastic layers share
+   * the global random generator, so pipelined mode should only be enabled
+   * when the discriminator contains no stochastic layers (such as dropout).
+   */
+  bool& Pipeline() { return pipeline; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const unsigned int /* version */);
@@ -397,6 +410,8 @@ class GAN
   arma::mat gradientGenerator;
   //! The current evaluation mode (training or testing).
   bool deterministic;
+  //! Whether fake-batch generation overlaps the discriminator update.
+  bool pipeline;
   //! To keep track of number of generator weights in total weights.
   size_t genWeights;
   //! To keep track of number of discriminator weights in total weights.
@@ -19,6 +19,7 @@
 #include <mlpack/methods/ann/init_rules/network_init.hpp>
 #include <mlpack/methods/ann/visitor/output_parameter_visitor.hpp>
 #include <mlpack/methods/ann/activation_functions/softplus_function.hpp>
+#include <mlpack/core/util/parallel.hpp>
 #include <boost/serialization/variant.hpp>
 
 namespace mlpack {
@@ -56,6 +57,7 @@ GAN<Model, InitializationRuleType, Noise, PolicyType>::GAN(
     lambda(lambda),
     reset(false),
     deterministic(false),
+    pipeline(false),
     genWeights(0),
     discWeights(0)
 {
@@ -92,6 +94,7 @@ GAN<Model, InitializationRuleType, Noise, PolicyType>::GAN(
     numFunctions(network.numFunctions),
     noise(network.noise),
     deterministic(network.deterministic),
+    pipeline(network.pipeline),
     genWeights(network.genWeights),
     discWeights(network.discWeights)
 {
@@ -125,6 +128,7 @@ GAN<Model, InitializationRuleType, Noise, PolicyType>::GAN(
     numFunctions(network.numFunctions),
     noise(std::move(network.noise)),
     deterministic(network.deterministic),
+    pipeline(network.pipeline),
     genWeights(network.genWeights),
     discWeights(network.discWeights)
 {
@@ -271,8 +275,7 @@ GAN<Model, InitializationRuleType, Noise, PolicyType>::Evaluate(
       boost::apply_visitor(outputParameterVisitor, generator.network.back());
   discriminator.Forward(predictors.cols(numFunctions,
       numFunctions + batchSize - 1));
-  responses.cols(numFunctions, numFunctions + batchSize - 1) =
-      arma::zeros(1, batchSize);
+  responses.cols(numFunctions, numFunctions + batchSize - 1).zeros();
 
   currentTarget = arma::mat(responses.memptr() + numFunctions,
       1, batchSize, false, false);
@@ -335,16 +338,35 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
       gradientGenerator.n_elem,
       discriminator.Parameters().n_elem, 1, false, false);
 
-  // Get the gradients of the Discriminator.
-  double res = discriminator.EvaluateWithGradient(discriminator.parameter,
-      i, gradientDiscriminator, batchSize);
-
-  noise.imbue( [&]() { return noiseFunction();} );
-  generator.Forward(noise);
-  predictors.cols(numFunctions, numFunctions + batchSize - 1) =
-      boost::apply_visitor(outputParameterVisitor, generator.network.back());
-  responses.cols(numFunctions, numFunctions + batchSize - 1) =
-      arma::zeros(1, batchSize);
+  // Get the gradients of the Discriminator on the real batch, and produce the
+  // fake batch for this step.  The two touch disjoint state -- the
+  // discriminator reads the real columns of the predictor matrix while the
+  // generator writes the noise columns -- so in pipelined mode the fake batch
+  // is produced on a worker thread while the discriminator update runs.
+  double res = 0.0;
+  auto realGradientTask = [&]()
+  {
+    res = discriminator.EvaluateWithGradient(discriminator.parameter,
+        i, gradientDiscriminator, batchSize);
+  };
+  auto fakeBatchTask = [&]()
+  {
+    noise.imbue( [&]() { return noiseFunction();} );
+    generator.Forward(noise);
+    predictors.cols(numFunctions, numFunctions + batchSize - 1) =
+        boost::apply_visitor(outputParameterVisitor, generator.network.back());
+    responses.cols(numFunctions, numFunctions + batchSize - 1).zeros();
+  };
+
+  if (pipeline)
+  {
+    Parallel::Invoke(realGradientTask, fakeBatchTask);
+  }
+  else
+  {
+    realGradientTask();
+    fakeBatchTask();
+  }
 
   // Get the gradients of the Generator.
   res += discriminator.EvaluateWithGradient(discriminator.parameter,
@@ -355,8 +377,7 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
   {
     // Minimize -log(D(G(noise))).
     // Pass the error from Discriminator to Generator.
-    responses.cols(numFunctions, numFunctions + batchSize - 1) =
-        arma::ones(1, batchSize);
+    responses.cols(numFunctions, numFunctions + batchSize - 1).ones();
 
     discriminator.outputLayer.Backward(
         boost::apply_visitor(outputParameterVisitor,
@@ -18,6 +18,7 @@
 #include <mlpack/methods/ann/init_rules/network_init.hpp>
 #include <mlpack/methods/ann/visitor/output_parameter_visitor.hpp>
 #include <mlpack/methods/ann/activation_functions/softplus_function.hpp>
+#include <mlpack/core/util/parallel.hpp>
 
 namespace mlpack {
 namespace ann /** Artifical Neural Network.  */ {
@@ -127,16 +128,34 @@ EvaluateWithGradient(const arma::mat& /* parameters */,
       gradientGenerator.n_elem,
       discriminator.Parameters().n_elem, 1, false, false);
 
-  // Get the gradients of the Discriminator.
-  double res = discriminator.EvaluateWithGradient(discriminator.parameter,
-      i, gradientDiscriminator, batchSize);
-
-  noise.imbue( [&]() { return noiseFunction();} );
-  generator.Forward(noise);
-  predictors.cols(numFunctions, numFunctions + batchSize - 1) =
-      boost::apply_visitor(outputParameterVisitor, generator.network.back());
-  responses.cols(numFunctions, numFunctions + batchSize - 1) =
-      -arma::ones(1, batchSize);
+  // Get the gradients of the Discriminator on the real batch, and produce the
+  // fake batch for this step.  As in the standard GAN, the two touch disjoint
+  // state, so in pipelined mode the fake batch is produced on a worker thread
+  // while the discriminator update runs.
+  double res = 0.0;
+  auto realGradientTask = [&]()
+  {
+    res = discriminator.EvaluateWithGradient(discriminator.parameter,
+        i, gradientDiscriminator, batchSize);
+  };
+  auto fakeBatchTask = [&]()
+  {
+    noise.imbue( [&]() { return noiseFunction();} );
+    generator.Forward(noise);
+    predictors.cols(numFunctions, numFunctions + batchSize - 1) =
+        boost::apply_visitor(outputParameterVisitor, generator.network.back());
+    responses.cols(numFunctions, numFunctions + batchSize - 1).fill(-1.0);
+  };
+
+  if (pipeline)
+  {
+    Parallel::Invoke(realGradientTask, fakeBatchTask);
+  }
+  else
+  {
+    realGradientTask();
+    fakeBatchTask();
+  }
 
   // Get the gradients of the Generator.
   res += discriminator.EvaluateWithGradient(discriminator.parameter,
@@ -0,0 +1,67 @@
+/**
+ * @file methods/ann/gemm_backend.hpp
+ * @author Marcus Edel
+ *
+ * A single dispatch point for the heavy matrix products of the ann module.
+ *
+ * The fully-connected layers and the im2col convolution rule spend nearly all
+ * of their time in a handful of GEMM calls; routing those calls through the
+ * Gemm() function below gives one place to plug in an accelerator backend
+ * without touching the layer implementations.  Two offload paths are
+ * supported:
+ *
+ *  - Link-time: configure with USE_NVBLAS=ON to link NVBLAS in front of the
+ *    CPU BLAS.  NVBLAS intercepts the underlying BLAS GEMM calls and runs the
+ *    large ones on the GPU, falling back to the CPU BLAS for small products;
+ *    the default implementation below then offloads transparently.
+ *
+ *  - Compile-time: a framework whose matrix types mimic the Armadillo API
+ *    (e.g. Bandicoot's coot::Mat) can provide an overload of Gemm() for its
+ *    own types, which will be preferred over the generic template by ordinary
+ *    overload resolution.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_GEMM_BACKEND_HPP
+#define MLPACK_METHODS_ANN_GEMM_BACKEND_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Compute the matrix product c = op(a) * op(b), where op() optionally
+ * transposes an operand.  The default implementation evaluates the product
+ * with Armadillo, so it runs on whatever BLAS mlpack was linked against.
+ *
+ * @param a Left operand of the product.
+ * @param b Right operand of the product.
+ * @param c Matrix to store the result in; it may be a non-owning alias.
+ * @param transA If true, use a's transpose.
+ * @param transB If true, use b's transpose.
+ */
+template<typename MatAType, typename MatBType, typename MatCType>
+inline void Gemm(const MatAType& a,
+                 const MatBType& b,
+                 MatCType& c,
+                 const bool transA = false,
+                 const bool transB = false)
+{
+  if (!transA && !transB)
+    c = a * b;
+  else if (transA && !transB)
+    c = a.t() * b;
+  else if (!transA && transB)
+    c = a * b.t();
+  else
+    c = a.t() * b.t();
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
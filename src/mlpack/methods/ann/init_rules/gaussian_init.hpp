@@ -55,7 +55,10 @@ class GaussianInitialization
     if (W.is_empty())
       W.set_size(rows, cols);
 
-    W.imbue( [&]() { return arma::as_scalar(RandNormal(mean, variance)); } );
+    // The parallel fill is deterministic for a given random seed regardless
+    // of the number of threads, so large parameter matrices initialize
+    // quickly without breaking reproducibility.
+    RandomFillGaussian(W, mean, variance);
   }
 
   /**
@@ -69,7 +72,7 @@ class GaussianInitialization
     if (W.is_empty())
       Log::Fatal << "Cannot initialize an empty matrix." << std::endl;
 
-    W.imbue( [&]() { return arma::as_scalar(RandNormal(mean, variance)); } );
+    RandomFillGaussian(W, mean, variance);
   }
 
   /**
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_ANN_INIT_RULES_RANDOM_INIT_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
 
 namespace mlpack {
 namespace ann /** Artificial Neural Network. */ {
@@ -58,9 +59,10 @@ class RandomInitialization
     if (W.is_empty())
       W.set_size(rows, cols);
 
-    W.randu();
-    W *= (upperBound - lowerBound);
-    W += lowerBound;
+    // The parallel fill is deterministic for a given random seed regardless
+    // of the number of threads, so large parameter matrices initialize
+    // quickly without breaking reproducibility.
+    math::RandomFill(W, lowerBound, upperBound);
   }
 
   /**
@@ -74,9 +76,7 @@ class RandomInitialization
     if (W.is_empty())
       Log::Fatal << "Cannot initialize an empty matrix." << std::endl;
 
-    W.randu();
-    W *= (upperBound - lowerBound);
-    W += lowerBound;
+    math::RandomFill(W, lowerBound, upperBound);
   }
 
   /**
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_ANN_LAYER_BASE_LAYER_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/arena.hpp>
 #include <mlpack/methods/ann/activation_functions/logistic_function.hpp>
 #include <mlpack/methods/ann/activation_functions/identity_function.hpp>
 #include <mlpack/methods/ann/activation_functions/rectifier_function.hpp>
@@ -100,7 +101,12 @@ class BaseLayer
                 const arma::Mat<eT>& gy,
                 arma::Mat<eT>& g)
   {
-    arma::Mat<eT> derivative;
+    // The derivative is only needed within this call, so draw it from the
+    // per-thread arena instead of the heap; the scope recycles the memory on
+    // return.
+    typename Arena<eT>::Scope scope;
+    arma::Mat<eT> derivative = Arena<eT>::Get().Matrix(input.n_rows,
+        input.n_cols);
     ActivationFunction::Deriv(input, derivative);
     g = gy % derivative;
   }
@@ -16,8 +16,10 @@
 
 #include <mlpack/methods/ann/convolution_rules/border_modes.hpp>
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/svd_convolution.hpp>
+#include <mlpack/methods/ann/quantization.hpp>
 #include <mlpack/core/util/to_lower.hpp>
 
 #include "layer_types.hpp"
@@ -116,6 +118,17 @@ class Convolution
    */
   void Reset();
 
+  /**
+   * Quantize the trained filters to int8 for inference.  One symmetric scale
+   * is computed per output map; subsequent Forward() calls lower the input
+   * through the im2col buffer, dynamically quantize each patch row, multiply
+   * in int8 with 32-bit accumulation, and rescale back to floating point
+   * before the bias is added.  Backward() and Gradient() keep using the
+   * floating-point filters, and the quantization state is not serialized, so
+   * call Quantize() again after loading a model or retraining.
+   */
+  void Quantize();
+
   /**
    * Ordinary feed forward pass of a neural network, evaluating the function
    * f(x) by propagating the activity forward through f.
@@ -253,6 +266,9 @@ class Convolution
   //! Modify the right padding width.
   size_t& PadWRight() { return padWRight; }
 
+  //! Get whether the quantized inference path is active.
+  bool Quantized() const { return quantized; }
+
   /**
    * Serialize the layer.
    */
@@ -313,6 +329,65 @@ class Convolution
     output = arma::fliplr(arma::flipud(input));
   }
 
+  /*
+   * Build the vectorized filter matrix used by the GEMM paths; column o holds
+   * the concatenated vectorized filters that produce output map o.
+   *
+   * @param filterMatrix Matrix to store the vectorized filters into.
+   */
+  void VectorizeFilters(arma::mat& filterMatrix)
+  {
+    const size_t patchSize = kernelWidth * kernelHeight;
+    filterMatrix.set_size(inSize * patchSize, outSize);
+    for (size_t outMap = 0; outMap < outSize; ++outMap)
+    {
+      for (size_t inMap = 0; inMap < inSize; ++inMap)
+      {
+        filterMatrix.col(outMap).subvec(inMap * patchSize,
+            (inMap + 1) * patchSize - 1) = arma::vectorise(
+            weight.slice(outMap * inSize + inMap));
+      }
+    }
+  }
+
+  /*
+   * Lower all input maps of one batch item into the im2col patch buffer.
+   * Column (inMap * patchSize + f) of the buffer holds, for every output
+   * position, the input value that filter element f sees; this matches the
+   * vectorized filter ordering of VectorizeFilters(), and successive calls
+   * with the same geometry reuse the allocation.
+   */
+  template<typename eT>
+  void Im2Col(const arma::Cube<eT>& inputTemp,
+              const bool usingPadding,
+              const size_t batchCount,
+              const size_t wConv,
+              const size_t hConv)
+  {
+    const size_t patchSize = kernelWidth * kernelHeight;
+    im2colBuffer.set_size(wConv * hConv, inSize * patchSize);
+    for (size_t inMap = 0; inMap < inSize; ++inMap)
+    {
+      const arma::Mat<eT>& curInput = usingPadding ?
+          inputPaddedTemp.slice(inMap + batchCount * inSize) :
+          inputTemp.slice(inMap + batchCount * inSize);
+
+      double* bufferPtr = im2colBuffer.colptr(inMap * patchSize);
+      for (size_t kj = 0; kj < kernelHeight; ++kj)
+      {
+        for (size_t ki = 0; ki < kernelWidth; ++ki)
+        {
+          for (size_t j = 0; j < hConv; ++j)
+          {
+            const eT* inputPtr = curInput.colptr(j * strideWidth + kj) + ki;
+            for (size_t i = 0; i < wConv; ++i, ++bufferPtr)
+              *bufferPtr = inputPtr[i * strideHeight];
+          }
+        }
+      }
+    }
+  }
+
   //! Locally-stored number of input channels.
   size_t inSize;
 
@@ -373,6 +448,22 @@ class Convolution
   //! Locally-stored transformed padded input parameter.
   arma::cube inputPaddedTemp;
 
+  //! Persistent im2col patch buffer, reused across Forward() calls when the
+  //! im2col GEMM path is active.
+  arma::mat im2colBuffer;
+
+  //! Persistent vectorized filter matrix for the im2col GEMM path.
+  arma::mat weightMatrix;
+
+  //! Whether the quantized inference path is active.
+  bool quantized;
+
+  //! Int8 vectorized filter matrix used by the quantized forward pass.
+  arma::Mat<arma::s8> quantizedWeightMatrix;
+
+  //! Per-output-map scales of the quantized filters.
+  arma::rowvec weightScales;
+
   //! Locally-stored transformed error parameter.
   arma::cube gTemp;
 
@@ -31,7 +31,7 @@ Convolution<
     GradientConvolutionRule,
     InputDataType,
     OutputDataType
->::Convolution()
+>::Convolution() : quantized(false)
 {
   // Nothing to do here.
 }
@@ -115,7 +115,8 @@ Convolution<
     inputWidth(inputWidth),
     inputHeight(inputHeight),
     outputWidth(0),
-    outputHeight(0)
+    outputHeight(0),
+    quantized(false)
 {
   weights.set_size((outSize * inSize * kernelWidth * kernelHeight) + outSize,
       1);
@@ -160,6 +161,32 @@ void Convolution<
         outSize, 1, false, false);
 }
 
+template<
+    typename ForwardConvolutionRule,
+    typename BackwardConvolutionRule,
+    typename GradientConvolutionRule,
+    typename InputDataType,
+    typename OutputDataType
+>
+void Convolution<
+    ForwardConvolutionRule,
+    BackwardConvolutionRule,
+    GradientConvolutionRule,
+    InputDataType,
+    OutputDataType
+>::Quantize()
+{
+  if (weight.is_empty())
+    Reset();
+
+  // Column o of the vectorized filter matrix holds the filters that produce
+  // output map o, so the per-column scales are per-output-map scales.
+  arma::mat filterMatrix;
+  VectorizeFilters(filterMatrix);
+  QuantizeSymmetricColumns(filterMatrix, quantizedWeightMatrix, weightScales);
+  quantized = true;
+}
+
 template<
     typename ForwardConvolutionRule,
     typename BackwardConvolutionRule,
@@ -201,6 +228,67 @@ void Convolution<
       outSize * batchSize, false, false);
   outputTemp.zeros();
 
+  const bool usingPadding =
+      (padWLeft != 0 || padWRight != 0 || padHTop != 0 || padHBottom != 0);
+
+  if (quantized)
+  {
+    // Quantized inference path: lower each batch item into the im2col patch
+    // buffer, quantize its rows dynamically, and compute all output maps
+    // with one int8 GEMM.
+    for (size_t batchCount = 0; batchCount < batchSize; ++batchCount)
+    {
+      Im2Col(inputTemp, usingPadding, batchCount, wConv, hConv);
+
+      arma::Mat<arma::s8> quantizedBuffer;
+      arma::vec positionScales;
+      QuantizeSymmetricRows(im2colBuffer, quantizedBuffer, positionScales);
+
+      arma::Mat<arma::s32> accumulator;
+      QuantizedGemm(quantizedBuffer, quantizedWeightMatrix, accumulator);
+
+      // Element (p, o) of the accumulator is scaled back by the dynamic
+      // scale of output position p and the filter scale of output map o.
+      arma::mat outputAlias(outputTemp.slice_memptr(batchCount * outSize),
+          wConv * hConv, outSize, false, true);
+      outputAlias = arma::conv_to<arma::mat>::from(accumulator);
+      outputAlias.each_col() %= positionScales;
+      outputAlias.each_row() %= weightScales;
+      for (size_t outMap = 0; outMap < outSize; ++outMap)
+        outputAlias.col(outMap) += bias(outMap);
+    }
+
+    outputWidth = outputTemp.n_rows;
+    outputHeight = outputTemp.n_cols;
+    return;
+  }
+
+  if (std::is_same<ForwardConvolutionRule,
+      Im2ColConvolution<ValidConvolution> >::value)
+  {
+    // GEMM path: lower each input image once per batch into the persistent
+    // im2col buffer and compute all output maps with a single matrix
+    // multiplication.
+    VectorizeFilters(weightMatrix);
+
+    for (size_t batchCount = 0; batchCount < batchSize; ++batchCount)
+    {
+      Im2Col(inputTemp, usingPadding, batchCount, wConv, hConv);
+
+      // All output maps of this batch item in one GEMM, written directly into
+      // the output memory.
+      arma::mat outputAlias(outputTemp.slice_memptr(batchCount * outSize),
+          wConv * hConv, outSize, false, true);
+      outputAlias = im2colBuffer * weightMatrix;
+      for (size_t outMap = 0; outMap < outSize; ++outMap)
+        outputAlias.col(outMap) += bias(outMap);
+    }
+
+    outputWidth = outputTemp.n_rows;
+    outputHeight = outputTemp.n_cols;
+    return;
+  }
+
   for (size_t outMap = 0, outMapIdx = 0, batchCount = 0; outMap <
       outSize * batchSize; outMap++)
   {
@@ -123,50 +123,50 @@ void FastLSTM<InputDataType, OutputDataType>::Forward(
     ResetCell(rhoSize);
   }
 
+  // All four gate pre-activations in one GEMM against the concatenated
+  // weight matrix.
   gate.cols(forwardStep, forwardStep + batchStep) = input2GateWeight * input +
       output2GateWeight * outParameter.cols(
       forwardStep, forwardStep + batchStep);
   gate.cols(forwardStep, forwardStep + batchStep).each_col() += input2GateBias;
 
-  arma::subview<double> sigmoidOut = gateActivation.cols(forwardStep,
-      forwardStep + batchStep);
-  FastSigmoid(
-      gate.submat(0, forwardStep, 3 * outSize - 1, forwardStep + batchStep),
-      sigmoidOut);
-
-  stateActivation.cols(forwardStep, forwardStep + batchStep) = arma::tanh(
-      gate.submat(3 * outSize, forwardStep, 4 * outSize - 1,
-      forwardStep + batchStep));
-
-  // Update the cell: cmul1 + cmul2
-  // where cmul1 is input gate * hidden state and
-  // cmul2 is forget gate * cell (prevCell).
-  if (forwardStep == 0)
-  {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        gateActivation.submat(0, forwardStep, outSize - 1,
-        forwardStep + batchStep) %
-        stateActivation.cols(forwardStep, forwardStep + batchStep);
-  }
-  else
+  // Fused elementwise pass: the gate activations, the cell update
+  // c = i % z + f % c_prev, the cell activation and the output
+  // h = o % tanh(c) are computed in a single sweep over each column,
+  // instead of five separate expressions with intermediate temporaries.
+  // The stored activations are identical to the unfused computation, so
+  // Backward() and Gradient() are unaffected.
+  for (size_t col = 0; col < batchSize; ++col)
   {
-    cell.cols(forwardStep, forwardStep + batchStep) =
-        gateActivation.submat(0, forwardStep, outSize - 1,
-        forwardStep + batchStep) %
-        stateActivation.cols(forwardStep, forwardStep + batchStep) +
-        gateActivation.submat(2 * outSize, forwardStep, 3 * outSize - 1,
-        forwardStep + batchStep) %
-        cell.cols(forwardStep - batchSize, forwardStep - batchSize + batchStep);
+    const size_t t = forwardStep + col;
+    const ElemType* gatePtr = gate.colptr(t);
+    ElemType* gateActivationPtr = gateActivation.colptr(t);
+    ElemType* statePtr = stateActivation.colptr(t);
+    ElemType* cellPtr = cell.colptr(t);
+    const ElemType* prevCellPtr = (forwardStep > 0) ?
+        cell.colptr(t - batchSize) : nullptr;
+    ElemType* cellActivationPtr = cellActivation.colptr(t);
+    ElemType* outPtr = outParameter.colptr(t + batchSize);
+
+    for (size_t j = 0; j < outSize; ++j)
+    {
+      const ElemType inGate = FastSigmoid(gatePtr[j]);
+      const ElemType outGate = FastSigmoid(gatePtr[outSize + j]);
+      const ElemType forgetGate = FastSigmoid(gatePtr[2 * outSize + j]);
+      const ElemType state = std::tanh(gatePtr[3 * outSize + j]);
+
+      gateActivationPtr[j] = inGate;
+      gateActivationPtr[outSize + j] = outGate;
+      gateActivationPtr[2 * outSize + j] = forgetGate;
+      statePtr[j] = state;
+
+      cellPtr[j] = (prevCellPtr == nullptr) ? inGate * state :
+          inGate * state + forgetGate * prevCellPtr[j];
+      cellActivationPtr[j] = std::tanh(cellPtr[j]);
+      outPtr[j] = outGate * cellActivationPtr[j];
+    }
   }
 
-  cellActivation.cols(forwardStep, forwardStep + batchStep) =
-      arma::tanh(cell.cols(forwardStep, forwardStep + batchStep));
-
-  outParameter.cols(forwardStep + batchSize,
-      forwardStep + batchSize + batchStep) = cellActivation.cols(
-      forwardStep, forwardStep + batchStep) % gateActivation.submat(
-      outSize, forwardStep, 2 * outSize - 1, forwardStep + batchStep);
-
   output = OutputType(outParameter.memptr() +
       (forwardStep + batchSize) * outSize, outSize, batchSize, false, false);
 
@@ -0,0 +1,187 @@
+/**
+ * @file methods/ann/layer/fused_activation.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the FusedActivation layer, which merges a run of elementwise
+ * activation functions into a single layer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LAYER_FUSED_ACTIVATION_HPP
+#define MLPACK_METHODS_ANN_LAYER_FUSED_ACTIVATION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/arena.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Implementation of the FusedActivation layer.  A run of adjacent elementwise
+ * activation layers can be replaced by one FusedActivation layer that applies
+ * the composed functions at network construction time:
+ *
+ * @code
+ * // Instead of two adjacent layers,
+ * //   model.Add<ReLULayer<>>();
+ * //   model.Add<TanHLayer<>>();
+ * // add one fused layer:
+ * model.Add<FusedActivation<RectifierFunction, TanhFunction>>();
+ * @endcode
+ *
+ * The stages run back-to-back on hot data inside one layer, so the network
+ * pays for a single layer dispatch, one delta and one output buffer for the
+ * whole run instead of one of each per merged layer.  The backward pass
+ * multiplies the stage derivatives into the propagated error in place, using
+ * the cached stage outputs (the chain rule evaluates each derivative at the
+ * output of its own stage).
+ *
+ * Only stateless elementwise functions from ann/activation_functions can be
+ * fused; layers with state of their own (e.g. Dropout) cannot be expressed as
+ * a composed functor.
+ *
+ * @tparam ActivationFunctions The activation functions to apply, in order.
+ */
+template <
+    typename... ActivationFunctions
+>
+class FusedActivation
+{
+ public:
+  static_assert(sizeof...(ActivationFunctions) > 0,
+      "FusedActivation requires at least one activation function.");
+
+  /**
+   * Create the FusedActivation object.
+   */
+  FusedActivation()
+  {
+    // Nothing to do here.
+  }
+
+  /**
+   * Ordinary feed forward pass of a neural network, applying each activation
+   * function in order.  The outputs of all but the last stage are cached for
+   * the backward pass.
+   *
+   * @param input Input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  template<typename InputType, typename OutputType>
+  void Forward(const InputType& input, OutputType& output)
+  {
+    stageOutputs.resize(sizeof...(ActivationFunctions) - 1);
+    Run<0, ActivationFunctions...>::Forward(stageOutputs, input, output);
+  }
+
+  /**
+   * Ordinary feed backward pass of a neural network, multiplying the
+   * derivative of every stage into the backpropagated error.
+   *
+   * @param input The propagated input activation (the output of the last
+   *     stage).
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  template<typename eT>
+  void Backward(const arma::Mat<eT>& input,
+                const arma::Mat<eT>& gy,
+                arma::Mat<eT>& g)
+  {
+    g = gy;
+    Run<0, ActivationFunctions...>::Backward(stageOutputs, input, g);
+  }
+
+  //! Get the output parameter.
+  arma::mat const& OutputParameter() const { return outputParameter; }
+  //! Modify the output parameter.
+  arma::mat& OutputParameter() { return outputParameter; }
+
+  //! Get the delta.
+  arma::mat const& Delta() const { return delta; }
+  //! Modify the delta.
+  arma::mat& Delta() { return delta; }
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& /* ar */, const unsigned int /* version */)
+  {
+    /* Nothing to do here */
+  }
+
+ private:
+  /**
+   * Compile-time recursion over the activation function pack: each step
+   * applies one stage and recurses on the rest.  The final stage writes the
+   * layer output directly and, on the backward pass, evaluates its derivative
+   * at the layer output instead of a cached intermediate.
+   */
+  template<size_t Stage, typename Function, typename... Rest>
+  struct Run
+  {
+    template<typename InputType, typename OutputType>
+    static void Forward(std::vector<arma::mat>& stages,
+                        const InputType& input,
+                        OutputType& output)
+    {
+      Function::Fn(input, stages[Stage]);
+      Run<Stage + 1, Rest...>::Forward(stages, stages[Stage], output);
+    }
+
+    template<typename eT>
+    static void Backward(const std::vector<arma::mat>& stages,
+                         const arma::Mat<eT>& layerOutput,
+                         arma::Mat<eT>& g)
+    {
+      typename Arena<eT>::Scope scope;
+      arma::Mat<eT> derivative = Arena<eT>::Get().Matrix(
+          stages[Stage].n_rows, stages[Stage].n_cols);
+      Function::Deriv(stages[Stage], derivative);
+      g %= derivative;
+      Run<Stage + 1, Rest...>::Backward(stages, layerOutput, g);
+    }
+  };
+
+  template<size_t Stage, typename Function>
+  struct Run<Stage, Function>
+  {
+    template<typename InputType, typename OutputType>
+    static void Forward(std::vector<arma::mat>& /* stages */,
+                        const InputType& input,
+                        OutputType& output)
+    {
+      Function::Fn(input, output);
+    }
+
+    template<typename eT>
+    static void Backward(const std::vector<arma::mat>& /* stages */,
+                         const arma::Mat<eT>& layerOutput,
+                         arma::Mat<eT>& g)
+    {
+      typename Arena<eT>::Scope scope;
+      arma::Mat<eT> derivative = Arena<eT>::Get().Matrix(
+          layerOutput.n_rows, layerOutput.n_cols);
+      Function::Deriv(layerOutput, derivative);
+      g %= derivative;
+    }
+  };
+
+  //! Cached outputs of every stage except the last.
+  std::vector<arma::mat> stageOutputs;
+
+  //! Locally-stored delta object.
+  arma::mat delta;
+
+  //! Locally-stored output parameter object.
+  arma::mat outputParameter;
+}; // class FusedActivation
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
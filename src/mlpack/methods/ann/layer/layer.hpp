@@ -33,6 +33,7 @@
 #include "elu.hpp"
 #include "fast_lstm.hpp"
 #include "flexible_relu.hpp"
+#include "fused_activation.hpp"
 #include "glimpse.hpp"
 #include "gru.hpp"
 #include "hard_tanh.hpp"
@@ -14,6 +14,8 @@
 #define MLPACK_METHODS_ANN_LAYER_LINEAR_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/gemm_backend.hpp>
+#include <mlpack/methods/ann/quantization.hpp>
 #include <mlpack/methods/ann/regularizer/no_regularizer.hpp>
 
 #include "layer_types.hpp"
@@ -69,6 +71,17 @@ class Linear
    */
   void Reset();
 
+  /**
+   * Quantize the trained weights to int8 for inference.  One symmetric scale
+   * is computed per output unit (per row of the weight matrix); subsequent
+   * Forward() calls dynamically quantize the input per point, multiply in
+   * int8 with 32-bit accumulation, and rescale back to floating point before
+   * the bias is added.  Backward() and Gradient() keep using the
+   * floating-point weights, and the quantization state is not serialized, so
+   * call Quantize() again after loading a model or retraining.
+   */
+  void Quantize();
+
   /**
    * Ordinary feed forward pass of a neural network, evaluating the function
    * f(x) by propagating the activity forward through f.
@@ -79,6 +92,19 @@ class Linear
   template<typename eT>
   void Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output);
 
+  /**
+   * Feed forward pass for sparse input.  The affine transformation costs time
+   * proportional to the number of nonzero input entries, so very sparse
+   * inputs (e.g. multi-hot categorical vectors) need not be densified.  This
+   * overload always uses the floating-point weights, even after Quantize():
+   * quantizing the input would densify it and forfeit the sparsity win.
+   *
+   * @param input Sparse input data used for evaluating the specified function.
+   * @param output Resulting output activation.
+   */
+  template<typename eT>
+  void Forward(const arma::SpMat<eT>& input, arma::Mat<eT>& output);
+
   /**
    * Ordinary feed backward pass of a neural network, calculating the function
    * f(x) by propagating x backwards trough f. Using the results from the feed
@@ -93,6 +119,20 @@ class Linear
                 const arma::Mat<eT>& gy,
                 arma::Mat<eT>& g);
 
+  /**
+   * Feed backward pass for sparse input.  The backpropagated error does not
+   * depend on the input, so this matches the dense overload; it exists so
+   * that callers feeding sparse activations can propagate without densifying.
+   *
+   * @param * (input) The propagated sparse input activation.
+   * @param gy The backpropagated error.
+   * @param g The calculated gradient.
+   */
+  template<typename eT>
+  void Backward(const arma::SpMat<eT>& /* input */,
+                const arma::Mat<eT>& gy,
+                arma::Mat<eT>& g);
+
   /*
    * Calculate the gradient using the output delta and the input activation.
    *
@@ -105,6 +145,19 @@ class Linear
                 const arma::Mat<eT>& error,
                 arma::Mat<eT>& gradient);
 
+  /*
+   * Calculate the gradient for sparse input; the outer product with the error
+   * costs time proportional to the number of nonzero input entries.
+   *
+   * @param input The sparse input parameter used for calculating the gradient.
+   * @param error The calculated error.
+   * @param gradient The calculated gradient.
+   */
+  template<typename eT>
+  void Gradient(const arma::SpMat<eT>& input,
+                const arma::Mat<eT>& error,
+                arma::Mat<eT>& gradient);
+
   //! Get the parameters.
   OutputDataType const& Parameters() const { return weights; }
   //! Modify the parameters.
@@ -152,6 +205,9 @@ class Linear
     return (inSize * outSize) + outSize;
   }
 
+  //! Get whether the quantized inference path is active.
+  bool Quantized() const { return quantized; }
+
   /**
    * Serialize the layer
    */
@@ -188,6 +244,15 @@ class Linear
 
   //! Locally-stored regularizer object.
   RegularizerType regularizer;
+
+  //! Whether the quantized inference path is active.
+  bool quantized;
+
+  //! Int8 weights used by the quantized forward pass.
+  arma::Mat<arma::s8> quantizedWeight;
+
+  //! Per-output-unit scales of the quantized weights.
+  arma::vec weightScales;
 }; // class Linear
 
 } // namespace ann
@@ -57,7 +57,6 @@ void Linear3D<InputDataType, OutputDataType, RegularizerType>::Forward(
     const arma::Mat<eT>& input, arma::Mat<eT>& output)
 {
   typedef typename arma::Mat<eT> MatType;
-  typedef typename arma::Cube<eT> CubeType;
 
   if (input.n_rows % inSize != 0)
   {
@@ -70,17 +69,17 @@ void Linear3D<InputDataType, OutputDataType, RegularizerType>::Forward(
 
   output.set_size(outSize * nPoints, batchSize);
 
-  const CubeType inputTemp(const_cast<MatType&>(input).memptr(), inSize,
-      nPoints, batchSize, false, false);
-
-  for (size_t i = 0; i < batchSize; ++i)
-  {
-    // Shape of weight : (outSize, inSize).
-    // Shape of inputTemp : (inSize, nPoints, batchSize).
-    MatType z = weight * inputTemp.slice(i);
-    z.each_col() += bias;
-    output.col(i) = arma::vectorise(z);
-  }
+  // All points of all batch items are transformed by the same weight matrix,
+  // so the whole batch collapses into a single GEMM over the flattened
+  // (inSize x nPoints * batchSize) input.  The flattened result has exactly
+  // the memory layout of the output.
+  const MatType inputFlat(const_cast<MatType&>(input).memptr(), inSize,
+      nPoints * batchSize, false, false);
+  MatType outputFlat(output.memptr(), outSize, nPoints * batchSize,
+      false, false);
+
+  outputFlat = weight * inputFlat;
+  outputFlat.each_col() += bias;
 }
 
 template<typename InputDataType, typename OutputDataType,
@@ -92,7 +91,6 @@ void Linear3D<InputDataType, OutputDataType, RegularizerType>::Backward(
     arma::Mat<eT>& g)
 {
   typedef typename arma::Mat<eT> MatType;
-  typedef typename arma::Cube<eT> CubeType;
 
   if (gy.n_rows % outSize != 0)
   {
@@ -103,17 +101,15 @@ void Linear3D<InputDataType, OutputDataType, RegularizerType>::Backward(
   const size_t nPoints = gy.n_rows / outSize;
   const size_t batchSize = gy.n_cols;
 
-  const CubeType gyTemp(const_cast<MatType&>(gy).memptr(), outSize,
-      nPoints, batchSize, false, false);
-
   g.set_size(inSize * nPoints, batchSize);
 
-  for (size_t i = 0; i < gyTemp.n_slices; ++i)
-  {
-    // Shape of weight : (outSize, inSize).
-    // Shape of gyTemp : (outSize, nPoints, batchSize).
-    g.col(i) = arma::vectorise(weight.t() * gyTemp.slice(i));
-  }
+  // As in Forward(), the per-slice products share the weight matrix, so they
+  // are computed as one GEMM over the flattened propagated error.
+  const MatType gyFlat(const_cast<MatType&>(gy).memptr(), outSize,
+      nPoints * batchSize, false, false);
+  MatType gFlat(g.memptr(), inSize, nPoints * batchSize, false, false);
+
+  gFlat = weight.t() * gyFlat;
 }
 
 template<typename InputDataType, typename OutputDataType,
@@ -125,7 +121,6 @@ void Linear3D<InputDataType, OutputDataType, RegularizerType>::Gradient(
     arma::Mat<eT>& gradient)
 {
   typedef typename arma::Mat<eT> MatType;
-  typedef typename arma::Cube<eT> CubeType;
 
   if (error.n_rows % outSize != 0)
     Log::Fatal << "Propagated error matrix has invalid dimension!" << std::endl;
@@ -133,26 +128,21 @@ void Linear3D<InputDataType, OutputDataType, RegularizerType>::Gradient(
   const size_t nPoints = input.n_rows / inSize;
   const size_t batchSize = input.n_cols;
 
-  const CubeType inputTemp(const_cast<MatType&>(input).memptr(), inSize,
-      nPoints, batchSize, false, false);
-  const CubeType errorTemp(const_cast<MatType&>(error).memptr(), outSize,
-      nPoints, batchSize, false, false);
-
-  CubeType dW(outSize, inSize, batchSize);
-  for (size_t i = 0; i < batchSize; ++i)
-  {
-    // Shape of errorTemp : (outSize, nPoints, batchSize).
-    // Shape of inputTemp : (inSize, nPoints, batchSize).
-    dW.slice(i) = errorTemp.slice(i) * inputTemp.slice(i).t();
-  }
+  // The weight gradient is the sum over all slices of
+  // errorTemp.slice(i) * inputTemp.slice(i).t(), which is exactly the single
+  // GEMM of the flattened error with the transposed flattened input.
+  const MatType inputFlat(const_cast<MatType&>(input).memptr(), inSize,
+      nPoints * batchSize, false, false);
+  const MatType errorFlat(const_cast<MatType&>(error).memptr(), outSize,
+      nPoints * batchSize, false, false);
 
   gradient.set_size(arma::size(weights));
 
   gradient.submat(0, 0, weight.n_elem - 1, 0)
-      = arma::vectorise(arma::sum(dW, 2));
+      = arma::vectorise(errorFlat * inputFlat.t());
 
   gradient.submat(weight.n_elem, 0, weights.n_elem - 1, 0)
-      = arma::vectorise(arma::sum(arma::sum(errorTemp, 2), 1));
+      = arma::sum(errorFlat, 1);
 
   regularizer.Evaluate(weights, gradient);
 }
@@ -23,7 +23,8 @@ template<typename InputDataType, typename OutputDataType,
     typename RegularizerType>
 Linear<InputDataType, OutputDataType, RegularizerType>::Linear() :
     inSize(0),
-    outSize(0)
+    outSize(0),
+    quantized(false)
 {
   // Nothing to do here.
 }
@@ -36,7 +37,8 @@ Linear<InputDataType, OutputDataType, RegularizerType>::Linear(
     RegularizerType regularizer) :
     inSize(inSize),
     outSize(outSize),
-    regularizer(regularizer)
+    regularizer(regularizer),
+    quantized(false)
 {
   weights.set_size(outSize * inSize + outSize, 1);
 }
@@ -48,9 +50,11 @@ Linear<InputDataType, OutputDataType, RegularizerType>::Linear(
     inSize(layer.inSize),
     outSize(layer.outSize),
     weights(layer.weights),
-    regularizer(layer.regularizer)
+    regularizer(layer.regularizer),
+    quantized(false)
 {
-  // Nothing to do here.
+  // The quantized state is not copied; the new layer's weight aliases are
+  // only established by Reset(), so Quantize() must be called again.
 }
 
 template<typename InputDataType, typename OutputDataType,
@@ -60,7 +64,8 @@ Linear<InputDataType, OutputDataType, RegularizerType>::Linear(
     inSize(0),
     outSize(0),
     weights(std::move(layer.weights)),
-    regularizer(std::move(layer.regularizer))
+    regularizer(std::move(layer.regularizer)),
+    quantized(false)
 {
   // Nothing to do here.
 }
@@ -77,6 +82,7 @@ operator=(const Linear& layer)
     outSize = layer.outSize;
     weights = layer.weights;
     regularizer = layer.regularizer;
+    quantized = false;
   }
   return *this;
 }
@@ -93,6 +99,7 @@ operator=(Linear&& layer)
     outSize = layer.outSize;
     weights = std::move(layer.weights);
     regularizer = std::move(layer.regularizer);
+    quantized = false;
   }
   return *this;
 }
@@ -106,13 +113,55 @@ void Linear<InputDataType, OutputDataType, RegularizerType>::Reset()
       outSize, 1, false, false);
 }
 
+template<typename InputDataType, typename OutputDataType,
+    typename RegularizerType>
+void Linear<InputDataType, OutputDataType, RegularizerType>::Quantize()
+{
+  if (weight.is_empty())
+    Reset();
+
+  QuantizeSymmetricRows(weight, quantizedWeight, weightScales);
+  quantized = true;
+}
+
 template<typename InputDataType, typename OutputDataType,
     typename RegularizerType>
 template<typename eT>
 void Linear<InputDataType, OutputDataType, RegularizerType>::Forward(
     const arma::Mat<eT>& input, arma::Mat<eT>& output)
 {
-  output = weight * input;
+  if (quantized)
+  {
+    arma::Mat<arma::s8> quantizedInput;
+    arma::Row<eT> inputScales;
+    QuantizeSymmetricColumns(input, quantizedInput, inputScales);
+
+    arma::Mat<arma::s32> accumulator;
+    QuantizedGemm(quantizedWeight, quantizedInput, accumulator);
+
+    // Element (i, j) of the accumulator is scaled back by the weight scale of
+    // output unit i and the dynamic input scale of point j.
+    output = arma::conv_to<arma::Mat<eT> >::from(accumulator);
+    output.each_col() %= arma::conv_to<arma::Col<eT> >::from(weightScales);
+    output.each_row() %= inputScales;
+    output.each_col() += bias;
+    return;
+  }
+
+  Gemm(weight, input, output);
+  output.each_col() += bias;
+}
+
+template<typename InputDataType, typename OutputDataType,
+    typename RegularizerType>
+template<typename eT>
+void Linear<InputDataType, OutputDataType, RegularizerType>::Forward(
+    const arma::SpMat<eT>& input, arma::Mat<eT>& output)
+{
+  // The dense-times-sparse product only touches the nonzero input entries.
+  // The quantized path is not taken here: dynamically quantizing the input
+  // would densify it, which is exactly what this overload avoids.
+  Gemm(weight, input, output);
   output.each_col() += bias;
 }
 
@@ -122,7 +171,18 @@ template<typename eT>
 void Linear<InputDataType, OutputDataType, RegularizerType>::Backward(
     const arma::Mat<eT>& /* input */, const arma::Mat<eT>& gy, arma::Mat<eT>& g)
 {
-  g = weight.t() * gy;
+  Gemm(weight, gy, g, true);
+}
+
+template<typename InputDataType, typename OutputDataType,
+    typename RegularizerType>
+template<typename eT>
+void Linear<InputDataType, OutputDataType, RegularizerType>::Backward(
+    const arma::SpMat<eT>& /* input */,
+    const arma::Mat<eT>& gy,
+    arma::Mat<eT>& g)
+{
+  Gemm(weight, gy, g, true);
 }
 
 template<typename InputDataType, typename OutputDataType,
@@ -133,8 +193,29 @@ void Linear<InputDataType, OutputDataType, RegularizerType>::Gradient(
     const arma::Mat<eT>& error,
     arma::Mat<eT>& gradient)
 {
-  gradient.submat(0, 0, weight.n_elem - 1, 0) = arma::vectorise(
-      error * input.t());
+  // Write the weight gradient directly into its slot of the gradient vector;
+  // the gradient is preallocated, so the product needs no extra temporary.
+  arma::Mat<eT> weightGradient(gradient.memptr(), weight.n_rows, weight.n_cols,
+      false, true);
+  Gemm(error, input, weightGradient, false, true);
+  gradient.submat(weight.n_elem, 0, gradient.n_elem - 1, 0) =
+      arma::sum(error, 1);
+  regularizer.Evaluate(weights, gradient);
+}
+
+template<typename InputDataType, typename OutputDataType,
+    typename RegularizerType>
+template<typename eT>
+void Linear<InputDataType, OutputDataType, RegularizerType>::Gradient(
+    const arma::SpMat<eT>& input,
+    const arma::Mat<eT>& error,
+    arma::Mat<eT>& gradient)
+{
+  // The outer product with a sparse input only touches the columns of the
+  // error that correspond to nonzero input entries.
+  arma::Mat<eT> weightGradient(gradient.memptr(), weight.n_rows, weight.n_cols,
+      false, true);
+  Gemm(error, input, weightGradient, false, true);
   gradient.submat(weight.n_elem, 0, gradient.n_elem - 1, 0) =
       arma::sum(error, 1);
   regularizer.Evaluate(weights, gradient);
@@ -14,6 +14,8 @@
 #define MLPACK_METHODS_ANN_LAYER_LINEAR_NO_BIAS_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/methods/ann/gemm_backend.hpp>
+#include <mlpack/methods/ann/quantization.hpp>
 #include <mlpack/methods/ann/regularizer/no_regularizer.hpp>
 
 #include "layer_types.hpp"
@@ -56,6 +58,17 @@ class LinearNoBias
    */
   void Reset();
 
+  /**
+   * Quantize the trained weights to int8 for inference.  One symmetric scale
+   * is computed per output unit (per row of the weight matrix); subsequent
+   * Forward() calls dynamically quantize the input per point, multiply in
+   * int8 with 32-bit accumulation, and rescale the result back to floating
+   * point.  Backward() and Gradient() keep using the floating-point weights,
+   * and the quantization state is not serialized, so call Quantize() again
+   * after loading a model or retraining.
+   */
+  void Quantize();
+
   /**
    * Ordinary feed forward pass of a neural network, evaluating the function
    * f(x) by propagating the activity forward through f.
@@ -123,6 +136,9 @@ class LinearNoBias
   //! Modify the gradient.
   OutputDataType& Gradient() { return gradient; }
 
+  //! Get whether the quantized inference path is active.
+  bool Quantized() const { return quantized; }
+
   /**
    * Serialize the layer
    */
@@ -156,6 +172,15 @@ class LinearNoBias
 
   //! Locally-stored regularizer object.
   RegularizerType regularizer;
+
+  //! Whether the quantized inference path is active.
+  bool quantized;
+
+  //! Int8 weights used by the quantized forward pass.
+  arma::Mat<arma::s8> quantizedWeight;
+
+  //! Per-output-unit scales of the quantized weights.
+  arma::vec weightScales;
 }; // class LinearNoBias
 
 } // namespace ann
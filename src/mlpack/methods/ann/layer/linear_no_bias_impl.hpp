@@ -23,7 +23,8 @@ template<typename InputDataType, typename OutputDataType,
     typename RegularizerType>
 LinearNoBias<InputDataType, OutputDataType, RegularizerType>::LinearNoBias() :
     inSize(0),
-    outSize(0)
+    outSize(0),
+    quantized(false)
 {
   // Nothing to do here.
 }
@@ -36,7 +37,8 @@ LinearNoBias<InputDataType, OutputDataType, RegularizerType>::LinearNoBias(
     RegularizerType regularizer) :
     inSize(inSize),
     outSize(outSize),
-    regularizer(regularizer)
+    regularizer(regularizer),
+    quantized(false)
 {
   weights.set_size(outSize * inSize, 1);
 }
@@ -48,13 +50,41 @@ void LinearNoBias<InputDataType, OutputDataType, RegularizerType>::Reset()
   weight = arma::mat(weights.memptr(), outSize, inSize, false, false);
 }
 
+template<typename InputDataType, typename OutputDataType,
+    typename RegularizerType>
+void LinearNoBias<InputDataType, OutputDataType, RegularizerType>::Quantize()
+{
+  if (weight.is_empty())
+    Reset();
+
+  QuantizeSymmetricRows(weight, quantizedWeight, weightScales);
+  quantized = true;
+}
+
 template<typename InputDataType, typename OutputDataType,
     typename RegularizerType>
 template<typename eT>
 void LinearNoBias<InputDataType, OutputDataType, RegularizerType>::Forward(
     const arma::Mat<eT>& input, arma::Mat<eT>& output)
 {
-  output = weight * input;
+  if (quantized)
+  {
+    arma::Mat<arma::s8> quantizedInput;
+    arma::Row<eT> inputScales;
+    QuantizeSymmetricColumns(input, quantizedInput, inputScales);
+
+    arma::Mat<arma::s32> accumulator;
+    QuantizedGemm(quantizedWeight, quantizedInput, accumulator);
+
+    // Element (i, j) of the accumulator is scaled back by the weight scale of
+    // output unit i and the dynamic input scale of point j.
+    output = arma::conv_to<arma::Mat<eT> >::from(accumulator);
+    output.each_col() %= arma::conv_to<arma::Col<eT> >::from(weightScales);
+    output.each_row() %= inputScales;
+    return;
+  }
+
+  Gemm(weight, input, output);
 }
 
 template<typename InputDataType, typename OutputDataType,
@@ -63,7 +93,7 @@ template<typename eT>
 void LinearNoBias<InputDataType, OutputDataType, RegularizerType>::Backward(
     const arma::Mat<eT>& /* input */, const arma::Mat<eT>& gy, arma::Mat<eT>& g)
 {
-  g = weight.t() * gy;
+  Gemm(weight, gy, g, true);
 }
 
 template<typename InputDataType, typename OutputDataType,
@@ -74,8 +104,11 @@ void LinearNoBias<InputDataType, OutputDataType, RegularizerType>::Gradient(
     const arma::Mat<eT>& error,
     arma::Mat<eT>& gradient)
 {
-  gradient.submat(0, 0, weight.n_elem - 1, 0) = arma::vectorise(
-      error * input.t());
+  // Write the weight gradient directly into its slot of the gradient vector;
+  // the gradient is preallocated, so the product needs no extra temporary.
+  arma::Mat<eT> weightGradient(gradient.memptr(), weight.n_rows, weight.n_cols,
+      false, true);
+  Gemm(error, input, weightGradient, false, true);
   regularizer.Evaluate(weights, gradient);
 }
 
@@ -37,16 +37,16 @@ void Lookup<InputDataType, OutputDataType>::Forward(
   const size_t seqLength = input.n_rows;
   const size_t batchSize = input.n_cols;
 
-  output.set_size(embeddingSize * seqLength, batchSize);
-
-  for (size_t i = 0; i < batchSize; ++i)
-  {
-    // ith column of output is a vectorized form of a matrix of shape
-    // (embeddingSize, seqLength) selected as a combination of columns from the
-    // weights.
-    output.col(i) = arma::vectorise(weights.cols(
-        arma::conv_to<arma::uvec>::from(input.col(i)) - 1));
-  }
+  // Gather the embeddings of the whole batch with a single multi-index
+  // lookup.  Vectorising the input concatenates the tokens of each point in
+  // column-major order, so the gathered matrix holds the embeddings of point
+  // i in columns [i * seqLength, (i + 1) * seqLength); reshaping stacks each
+  // point's embeddings into one output column, matching the per-column
+  // vectorise of the old one-point-at-a-time loop.
+  const arma::uvec indices =
+      arma::conv_to<arma::uvec>::from(arma::vectorise(input)) - 1;
+  output = arma::reshape(arma::Mat<eT>(weights.cols(indices)),
+      embeddingSize * seqLength, batchSize);
 }
 
 template<typename InputDataType, typename OutputDataType>
@@ -69,17 +69,19 @@ void Lookup<InputDataType, OutputDataType>::Gradient(
   const size_t seqLength = input.n_rows;
   const size_t batchSize = input.n_cols;
 
-  arma::Cube<eT> errorTemp(const_cast<arma::Mat<eT>&>(error).memptr(),
-      embeddingSize, seqLength, batchSize, false, false);
+  // View the error as one embedding-sized column per token of the batch; the
+  // column order matches the vectorised input, so a single scatter-add loop
+  // accumulates the whole batch (repeated tokens accumulate correctly).
+  const arma::Mat<eT> errorTemp(const_cast<arma::Mat<eT>&>(error).memptr(),
+      embeddingSize, seqLength * batchSize, false, false);
+  const arma::uvec indices =
+      arma::conv_to<arma::uvec>::from(arma::vectorise(input)) - 1;
 
   gradient.set_size(arma::size(weights));
   gradient.zeros();
 
-  for (size_t i = 0; i < batchSize; ++i)
-  {
-    gradient.cols(arma::conv_to<arma::uvec>::from(input.col(i)) - 1)
-        += errorTemp.slice(i);
-  }
+  for (size_t i = 0; i < indices.n_elem; ++i)
+    gradient.col(indices[i]) += errorTemp.col(i);
 }
 
 template<typename InputDataType, typename OutputDataType>
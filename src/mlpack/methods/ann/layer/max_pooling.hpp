@@ -179,27 +179,40 @@ class MaxPooling
                         arma::Mat<eT>& output,
                         arma::Mat<eT>& poolingIndices)
   {
+    // Each window is scanned directly through column pointers, so no
+    // submatrix copies or temporary index matrices are created.  The
+    // column-major scan with a strict comparison keeps the first occurrence
+    // of the maximum, matching the previous behavior.
+    const size_t windowRows = kernelWidth - offset;
+    const size_t windowCols = kernelHeight - offset;
+
     for (size_t j = 0, colidx = 0; j < output.n_cols;
         ++j, colidx += strideHeight)
     {
       for (size_t i = 0, rowidx = 0; i < output.n_rows;
           ++i, rowidx += strideWidth)
       {
-        arma::mat subInput = input(
-            arma::span(rowidx, rowidx + kernelWidth - 1 - offset),
-            arma::span(colidx, colidx + kernelHeight - 1 - offset));
+        eT max = input(rowidx, colidx);
+        size_t maxRow = rowidx;
+        size_t maxCol = colidx;
+        for (size_t c = 0; c < windowCols; ++c)
+        {
+          const eT* colPtr = input.colptr(colidx + c) + rowidx;
+          for (size_t r = 0; r < windowRows; ++r)
+          {
+            if (colPtr[r] > max)
+            {
+              max = colPtr[r];
+              maxRow = rowidx + r;
+              maxCol = colidx + c;
+            }
+          }
+        }
 
-        const size_t idx = pooling.Pooling(subInput);
-        output(i, j) = subInput(idx);
+        output(i, j) = max;
 
         if (!deterministic)
-        {
-          arma::Mat<size_t> subIndices = indices(arma::span(rowidx,
-              rowidx + kernelWidth - 1 - offset),
-              arma::span(colidx, colidx + kernelHeight - 1 - offset));
-
-          poolingIndices(i, j) = subIndices(idx);
-        }
+          poolingIndices(i, j) = maxCol * input.n_rows + maxRow;
       }
     }
   }
@@ -288,12 +301,6 @@ class MaxPooling
   //! Locally-stored output parameter object.
   OutputDataType outputParameter;
 
-  //! Locally-stored indices matrix parameter.
-  arma::Mat<size_t> indices;
-
-  //! Locally-stored indices column parameter.
-  arma::Col<size_t> indicesCol;
-
   //! Locally-stored pooling indicies.
   std::vector<arma::cube> poolingIndices;
 }; // class MaxPooling
@@ -86,17 +86,6 @@ void MaxPooling<InputDataType, OutputDataType>::Forward(
     poolingIndices.push_back(outputTemp);
   }
 
-  if (!reset)
-  {
-    size_t elements = inputWidth * inputHeight;
-    indicesCol = arma::linspace<arma::Col<size_t> >(0, (elements - 1),
-        elements);
-
-    indices = arma::Mat<size_t>(indicesCol.memptr(), inputWidth, inputHeight);
-
-    reset = true;
-  }
-
   for (size_t s = 0; s < inputTemp.n_slices; s++)
   {
     if (!deterministic)
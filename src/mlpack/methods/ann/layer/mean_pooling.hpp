@@ -157,17 +157,27 @@ class MeanPooling
   template<typename eT>
   void Pooling(const arma::Mat<eT>& input, arma::Mat<eT>& output)
   {
+    // Each window is accumulated directly through column pointers, so no
+    // submatrix copies are created.
+    const size_t windowRows = kernelWidth - offset;
+    const size_t windowCols = kernelHeight - offset;
+    const eT norm = 1.0 / (windowRows * windowCols);
+
     for (size_t j = 0, colidx = 0; j < output.n_cols;
          ++j, colidx += strideHeight)
     {
       for (size_t i = 0, rowidx = 0; i < output.n_rows;
            ++i, rowidx += strideWidth)
       {
-        arma::mat subInput = input(
-            arma::span(rowidx, rowidx + kernelWidth - 1 - offset),
-            arma::span(colidx, colidx + kernelHeight - 1 - offset));
-
-        output(i, j) = arma::mean(arma::mean(subInput));
+        eT sum = 0;
+        for (size_t c = 0; c < windowCols; ++c)
+        {
+          const eT* colPtr = input.colptr(colidx + c) + rowidx;
+          for (size_t r = 0; r < windowRows; ++r)
+            sum += colPtr[r];
+        }
+
+        output(i, j) = sum * norm;
       }
     }
   }
@@ -156,6 +156,18 @@ class MultiheadAttention
   //! Modify the Key Padding Mask.
   OutputDataType& KeyPaddingMask() { return keyPaddingMask; }
 
+  //! Get whether the fused (streaming-softmax) forward path is active.
+  bool FusedForward() const { return fusedForward; }
+  /**
+   * Modify whether the fused forward path is active.  When enabled, Forward()
+   * computes the attention scores in fixed-size source blocks with a running
+   * softmax, so only O(tgtSeqLen) score memory exists per head at any time
+   * instead of the full (tgtSeqLen x srcSeqLen) matrix.  The fused path does
+   * not materialize the state the backward pass needs, so it is for inference
+   * only; Backward() and Gradient() will refuse to run while it is enabled.
+   */
+  bool& FusedForward() { return fusedForward; }
+
   //! Get the output parameter.
   OutputDataType const& OutputParameter() const { return outputParameter; }
   //! Modify the output parameter.
@@ -201,6 +213,10 @@ class MultiheadAttention
   //! Key Padding Mask.
   OutputDataType keyPaddingMask;
 
+  //! Whether the fused (streaming-softmax, inference-only) forward path is
+  //! active.
+  bool fusedForward;
+
   //! Locally-stored weight matrix associated with query.
   OutputDataType queryWt;
 
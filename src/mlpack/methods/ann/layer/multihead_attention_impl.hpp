@@ -29,7 +29,8 @@ MultiheadAttention() :
     srcSeqLen(0),
     embedDim(0),
     numHeads(0),
-    headDim(0)
+    headDim(0),
+    fusedForward(false)
 {
   // Nothing to do here.
 }
@@ -45,7 +46,8 @@ MultiheadAttention(
     tgtSeqLen(tgtSeqLen),
     srcSeqLen(srcSeqLen),
     embedDim(embedDim),
-    numHeads(numHeads)
+    numHeads(numHeads),
+    fusedForward(false)
 {
   if (embedDim % numHeads != 0)
   {
@@ -139,6 +141,93 @@ Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output)
   kProj.reshape(srcSeqLen, headDim, numHeads * batchSize);
   vProj.reshape(srcSeqLen, headDim, numHeads * batchSize);
 
+  if (!attnMask.is_empty() &&
+      (attnMask.n_rows != tgtSeqLen || attnMask.n_cols != srcSeqLen))
+  {
+    Log::Fatal << "The size of the 'attn_mask' is not correct.\n";
+  }
+
+  if (!keyPaddingMask.is_empty() &&
+      (keyPaddingMask.n_rows != 1 || keyPaddingMask.n_cols != srcSeqLen))
+  {
+    Log::Fatal << "The size of the 'keyPaddingMask' is not correct.\n";
+  }
+
+  if (fusedForward)
+  {
+    // Streaming-softmax attention (inference only): the scores are computed
+    // in fixed-size source blocks while a running row maximum, normalizer and
+    // output accumulator are maintained, so only (tgtSeqLen x blockSize)
+    // score entries exist per head at any time instead of the full
+    // (tgtSeqLen x srcSeqLen) matrix.
+    const size_t blockSize = std::min(size_t(256), srcSeqLen);
+    const eT negInf = -std::numeric_limits<eT>::infinity();
+
+    attnOut.set_size(tgtSeqLen, headDim, numHeads * batchSize);
+
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) (numHeads * batchSize); ++i)
+    {
+      arma::Col<eT> rowMax(tgtSeqLen);
+      rowMax.fill(negInf);
+      arma::Col<eT> normalizer(tgtSeqLen, arma::fill::zeros);
+      arma::Mat<eT> accumulator(tgtSeqLen, headDim, arma::fill::zeros);
+
+      for (size_t begin = 0; begin < srcSeqLen; begin += blockSize)
+      {
+        const size_t end = std::min(begin + blockSize, srcSeqLen);
+
+        arma::Mat<eT> block = qProj.slice(i) *
+            arma::trans(kProj.slice(i).rows(begin, end - 1));
+
+        if (!attnMask.is_empty())
+          block += attnMask.cols(begin, end - 1);
+
+        if (!keyPaddingMask.is_empty())
+          block.each_row() += keyPaddingMask.cols(begin, end - 1);
+
+        // Fold the block into the running softmax: rescale the accumulated
+        // state by exp(oldMax - newMax), then add the block's contribution.
+        const arma::Col<eT> newMax = arma::max(rowMax, arma::max(block, 1));
+
+        arma::Col<eT> correction(tgtSeqLen);
+        for (size_t t = 0; t < tgtSeqLen; ++t)
+        {
+          correction[t] = (newMax[t] == negInf) ? eT(1) :
+              std::exp(rowMax[t] - newMax[t]);
+        }
+
+        block.each_col() -= newMax;
+        block = arma::exp(block);
+
+        // Rows that are fully masked so far have a maximum of -inf; their
+        // exponentials are not finite, so zero them out explicitly (their
+        // normalizer stays zero, matching the unfused path's behavior).
+        const arma::uvec masked = arma::find(newMax == negInf);
+        for (size_t t = 0; t < masked.n_elem; ++t)
+          block.row(masked[t]).zeros();
+
+        normalizer = normalizer % correction + arma::sum(block, 1);
+        accumulator.each_col() %= correction;
+        accumulator += block * vProj.slice(i).rows(begin, end - 1);
+        rowMax = newMax;
+      }
+
+      accumulator.each_col() /= normalizer;
+      attnOut.slice(i) = accumulator;
+    }
+
+    attnOut.reshape(tgtSeqLen, embedDim, batchSize);
+
+    for (size_t i = 0; i < batchSize; ++i)
+    {
+      output.col(i) = arma::vectorise(arma::trans(attnOut.slice(i) * outWt
+          + arma::repmat(outBias, tgtSeqLen, 1)));
+    }
+
+    return;
+  }
+
   // Calculate the scores i.e. perform the matrix multiplication operation
   // on qProj and kProj. Here score = qProj . kProj'
   scores = math::MultiplyCube2Cube(qProj, kProj, false, true);
@@ -148,22 +237,14 @@ Forward(const arma::Mat<eT>& input, arma::Mat<eT>& output)
   // The attention mask has elements 0 or -infinity.
   // The shape of the attention mask : (tgtSeqLen, srcSeqLen).
   if (!attnMask.is_empty())
-  {
-    if (attnMask.n_rows != tgtSeqLen || attnMask.n_cols != srcSeqLen)
-      Log::Fatal << "The size of the 'attn_mask' is not correct.\n";
     scores.each_slice() += attnMask;
-  }
 
   // Apply the key padding mask when provided. It blacks-out any particular
   // word in the sequence.
   // The key padding mask has elements 0 or -infinity.
   // The shape of keyPaddingMask : (1, srcSeqLen).
   if (!keyPaddingMask.is_empty())
-  {
-    if (keyPaddingMask.n_rows != 1 || keyPaddingMask.n_cols != srcSeqLen)
-        Log::Fatal << "The size of the 'keyPaddingMask' is not correct.\n";
     scores.each_slice() += arma::repmat(keyPaddingMask, tgtSeqLen, 1);
-  }
 
   for (size_t i = 0; i < numHeads * batchSize; ++i)
   {
@@ -198,6 +279,13 @@ Backward(const arma::Mat<eT>& /* input */,
 {
   typedef typename arma::Cube<eT> CubeType;
 
+  if (fusedForward)
+  {
+    Log::Fatal << "MultiheadAttention::Backward(): the fused forward path "
+        << "does not store the attention scores; disable FusedForward() for "
+        << "training." << std::endl;
+  }
+
   if (gy.n_rows != tgtSeqLen * embedDim)
   {
     Log::Fatal << "Backpropagated error has incorrect dimensions!" << std::endl;
@@ -291,6 +379,13 @@ Gradient(const arma::Mat<eT>& input,
   typedef typename arma::Cube<eT> CubeType;
   typedef typename arma::Mat<eT> MatType;
 
+  if (fusedForward)
+  {
+    Log::Fatal << "MultiheadAttention::Gradient(): the fused forward path "
+        << "does not store the attention scores; disable FusedForward() for "
+        << "training." << std::endl;
+  }
+
   if (input.n_rows != embedDim * (tgtSeqLen + 2 * srcSeqLen))
   {
     Log::Fatal << "Incorrect input dimensions!" << std::endl;
@@ -0,0 +1,94 @@
+/**
+ * @file methods/ann/loss_functions/softmax_cross_entropy.hpp
+ * @author Marcus Edel
+ *
+ * Definition of the fused softmax cross-entropy performance function.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LOSS_FUNCTIONS_SOFTMAX_CROSS_ENTROPY_HPP
+#define MLPACK_METHODS_ANN_LOSS_FUNCTIONS_SOFTMAX_CROSS_ENTROPY_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * The softmax cross-entropy performance function computes the multi-class
+ * cross-entropy directly on unnormalized logits.  It fuses the softmax, the
+ * loss reduction, and the analytically simplified backward delta (p - y)
+ * into single passes over the logits, so a network using it as the output
+ * layer of an FFN does not need a LogSoftMax layer followed by
+ * NegativeLogLikelihood -- the last (e.g. Linear) layer feeds the logits in
+ * directly.
+ *
+ * As with NegativeLogLikelihood, the targets should be class labels,
+ * starting from 1 (not 0).
+ *
+ * @tparam InputDataType Type of the input data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ * @tparam OutputDataType Type of the output data (arma::colvec, arma::mat,
+ *         arma::sp_mat or arma::cube).
+ */
+template <
+    typename InputDataType = arma::mat,
+    typename OutputDataType = arma::mat
+>
+class SoftmaxCrossEntropy
+{
+ public:
+  /**
+   * Create the SoftmaxCrossEntropy object.
+   */
+  SoftmaxCrossEntropy();
+
+  /**
+   * Computes the softmax cross-entropy of the given logits.
+   *
+   * @param input The unnormalized logits.
+   * @param target The target vector of class labels, starting from 1.
+   */
+  template<typename InputType, typename TargetType>
+  typename InputType::elem_type Forward(const InputType& input,
+                                        const TargetType& target);
+
+  /**
+   * Ordinary feed backward pass of a neural network.  The delta with respect
+   * to the logits simplifies to softmax(input) - y.
+   *
+   * @param input The unnormalized logits.
+   * @param target The target vector of class labels, starting from 1.
+   * @param output The calculated error.
+   */
+  template<typename InputType, typename TargetType, typename OutputType>
+  void Backward(const InputType& input,
+                const TargetType& target,
+                OutputType& output);
+
+  //! Get the output parameter.
+  OutputDataType& OutputParameter() const { return outputParameter; }
+  //! Modify the output parameter.
+  OutputDataType& OutputParameter() { return outputParameter; }
+
+  /**
+   * Serialize the layer.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! Locally-stored output parameter object.
+  OutputDataType outputParameter;
+}; // class SoftmaxCrossEntropy
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "softmax_cross_entropy_impl.hpp"
+
+#endif
@@ -0,0 +1,90 @@
+/**
+ * @file methods/ann/loss_functions/softmax_cross_entropy_impl.hpp
+ * @author Marcus Edel
+ *
+ * Implementation of the fused softmax cross-entropy performance function.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_LOSS_FUNCTIONS_SOFTMAX_CROSS_ENTROPY_IMPL_HPP
+#define MLPACK_METHODS_ANN_LOSS_FUNCTIONS_SOFTMAX_CROSS_ENTROPY_IMPL_HPP
+
+// In case it hasn't yet been included.
+#include "softmax_cross_entropy.hpp"
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+template<typename InputDataType, typename OutputDataType>
+SoftmaxCrossEntropy<InputDataType, OutputDataType>::SoftmaxCrossEntropy()
+{
+  // Nothing to do here.
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename InputType, typename TargetType>
+typename InputType::elem_type
+SoftmaxCrossEntropy<InputDataType, OutputDataType>::Forward(
+    const InputType& input,
+    const TargetType& target)
+{
+  typedef typename InputType::elem_type ElemType;
+
+  // For each column the loss is log(sum(exp(logits))) - logits(target); the
+  // log-sum-exp is computed against the column maximum for numerical
+  // stability.
+  ElemType output = 0;
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    const size_t currentTarget = target(i) - 1;
+    Log::Assert(currentTarget < input.n_rows,
+        "Target class out of range.");
+
+    const ElemType maxLogit = input.col(i).max();
+    const ElemType logSumExp = maxLogit +
+        std::log(arma::accu(arma::exp(input.col(i) - maxLogit)));
+    output += logSumExp - input(currentTarget, i);
+  }
+
+  return output;
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename InputType, typename TargetType, typename OutputType>
+void SoftmaxCrossEntropy<InputDataType, OutputDataType>::Backward(
+    const InputType& input,
+    const TargetType& target,
+    OutputType& output)
+{
+  typedef typename InputType::elem_type ElemType;
+
+  // The delta with respect to the logits is softmax(input) - y.
+  output.set_size(arma::size(input));
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    const size_t currentTarget = target(i) - 1;
+    Log::Assert(currentTarget < input.n_rows,
+        "Target class out of range.");
+
+    output.col(i) = arma::exp(input.col(i) - input.col(i).max());
+    output.col(i) /= (ElemType) arma::accu(output.col(i));
+    output(currentTarget, i) -= 1;
+  }
+}
+
+template<typename InputDataType, typename OutputDataType>
+template<typename Archive>
+void SoftmaxCrossEntropy<InputDataType, OutputDataType>::serialize(
+    Archive& /* ar */,
+    const unsigned int /* version */)
+{
+  // Nothing to do here.
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
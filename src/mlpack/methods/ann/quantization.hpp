@@ -0,0 +1,126 @@
+/**
+ * @file methods/ann/quantization.hpp
+ * @author Marcus Edel
+ *
+ * Utilities for post-training int8 quantization of network weights and
+ * activations: symmetric quantizers with per-channel scales and an int8
+ * matrix multiplication with 32-bit accumulation.  These are used by the
+ * Quantize() members of the Linear, LinearNoBias, and Convolution layers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_QUANTIZATION_HPP
+#define MLPACK_METHODS_ANN_QUANTIZATION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ann /** Artificial Neural Network. */ {
+
+/**
+ * Symmetrically quantize each row of the given matrix to int8 with a
+ * per-row scale, so that w(i, j) is approximately scales(i) * quantized(i, j).
+ * Rows correspond to output channels in the Linear layer's weight layout, so
+ * this yields per-channel scales.
+ *
+ * @param w Matrix to quantize.
+ * @param quantized Matrix to store the int8 values into.
+ * @param scales Vector to store the per-row scales into.
+ */
+template<typename eT>
+inline void QuantizeSymmetricRows(const arma::Mat<eT>& w,
+                                  arma::Mat<arma::s8>& quantized,
+                                  arma::Col<eT>& scales)
+{
+  quantized.set_size(w.n_rows, w.n_cols);
+  scales.set_size(w.n_rows);
+
+  for (size_t i = 0; i < w.n_rows; ++i)
+  {
+    const eT maxAbs = arma::abs(w.row(i)).max();
+    const eT scale = (maxAbs > 0) ? maxAbs / 127 : 1;
+    scales(i) = scale;
+
+    for (size_t j = 0; j < w.n_cols; ++j)
+    {
+      quantized(i, j) = (arma::s8) std::lround(double(w(i, j) / scale));
+    }
+  }
+}
+
+/**
+ * Symmetrically quantize each column of the given matrix to int8 with a
+ * per-column scale, so that x(i, j) is approximately
+ * scales(j) * quantized(i, j).  Columns correspond to points of a batch, so
+ * this performs dynamic per-point activation quantization.
+ *
+ * @param x Matrix to quantize.
+ * @param quantized Matrix to store the int8 values into.
+ * @param scales Vector to store the per-column scales into.
+ */
+template<typename eT>
+inline void QuantizeSymmetricColumns(const arma::Mat<eT>& x,
+                                     arma::Mat<arma::s8>& quantized,
+                                     arma::Row<eT>& scales)
+{
+  quantized.set_size(x.n_rows, x.n_cols);
+  scales.set_size(x.n_cols);
+
+  for (size_t j = 0; j < x.n_cols; ++j)
+  {
+    const eT maxAbs = x.n_rows > 0 ? (eT) arma::abs(x.col(j)).max() : (eT) 0;
+    const eT scale = (maxAbs > 0) ? maxAbs / 127 : 1;
+    scales(j) = scale;
+
+    const eT* xPtr = x.colptr(j);
+    arma::s8* qPtr = quantized.colptr(j);
+    for (size_t i = 0; i < x.n_rows; ++i)
+      qPtr[i] = (arma::s8) std::lround(double(xPtr[i] / scale));
+  }
+}
+
+/**
+ * Compute c = a * b where a and b hold int8 values, accumulating in 32-bit
+ * integers.  The loops are arranged so the inner products run over contiguous
+ * memory (a is traversed by columns), the compiler can vectorize the int8
+ * widening multiplies, and the columns of b are processed in parallel.
+ *
+ * @param a Left operand (int8).
+ * @param b Right operand (int8).
+ * @param c Matrix to store the int32 result into.
+ */
+inline void QuantizedGemm(const arma::Mat<arma::s8>& a,
+                          const arma::Mat<arma::s8>& b,
+                          arma::Mat<arma::s32>& c)
+{
+  c.zeros(a.n_rows, b.n_cols);
+
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) b.n_cols; ++j)
+  {
+    const arma::s8* bPtr = b.colptr(j);
+    arma::s32* cPtr = c.colptr(j);
+
+    // c.col(j) += b(k, j) * a.col(k): the unit-stride access over a's columns
+    // vectorizes well and keeps the int8 weight data streaming through the
+    // cache, which is the point on bandwidth-limited machines.
+    for (size_t k = 0; k < a.n_cols; ++k)
+    {
+      const arma::s32 bkj = (arma::s32) bPtr[k];
+      if (bkj == 0)
+        continue;
+
+      const arma::s8* aPtr = a.colptr(k);
+      for (size_t i = 0; i < a.n_rows; ++i)
+        cPtr[i] += bkj * (arma::s32) aPtr[i];
+    }
+  }
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -442,6 +442,8 @@ class RBM
   arma::Mat<ElemType> positiveGradient;
   //! Locally-stored temporary output of Gibbs chain.
   arma::Mat<ElemType> gibbsTemporary;
+  //! Locally-stored hidden means of a mini-batch, used by Phase().
+  arma::Mat<ElemType> phaseHiddenMean;
   //! Locally-stored persistent CD-k boolean flag.
   bool persistence;
   //! Locally-stored reset variable.
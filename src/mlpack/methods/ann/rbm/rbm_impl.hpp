@@ -136,8 +136,13 @@ RBM<InitializationRuleType, DataType, PolicyType>::Phase(
   DataType hiddenBiasGrad = DataType(gradient.memptr() + weightGrad.n_elem,
       hiddenSize, 1, false, false);
 
-  HiddenMean(input, hiddenBiasGrad);
-  weightGrad.slice(0) = hiddenBiasGrad * input.t();
+  // Compute the hidden means of the whole mini-batch at once, so that the
+  // phase costs one GEMM regardless of the batch size.  The means go through
+  // a separate buffer: assigning a matrix of a different size to the alias
+  // above would detach it from the gradient memory.
+  HiddenMean(input, phaseHiddenMean);
+  weightGrad.slice(0) = phaseHiddenMean * input.t();
+  hiddenBiasGrad = arma::sum(phaseHiddenMean, 1);
 }
 
 template<
@@ -277,7 +282,9 @@ void RBM<InitializationRuleType, DataType, PolicyType>::Gradient(
   Phase(predictors.cols(i, i + batchSize - 1),
       positiveGradient);
 
-  for (size_t i = 0; i < negSteps; ++i)
+  // Note that the loop index must not shadow the function index i: every
+  // chain restart has to use the mini-batch this gradient was asked for.
+  for (size_t n = 0; n < negSteps; ++n)
   {
     Gibbs(predictors.cols(i, i + batchSize - 1),
         negativeSamples);
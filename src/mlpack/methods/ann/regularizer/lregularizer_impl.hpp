@@ -25,12 +25,19 @@ LRegularizer<Power>::LRegularizer(double factor) :
   // Nothing to do here
 }
 
+// The penalty gradients below are expressed as a single fused
+// accumulate-into-gradient pass over a no-copy column alias of the weights,
+// instead of materializing a vectorised copy of the weight matrix and adding
+// it in a second sweep.
+
 // Unspecialized implementation. This should almost never be used...
 template<int Power>
 template<typename MatType>
 void LRegularizer<Power>::Evaluate(const MatType& weight, MatType& gradient)
 {
-  gradient += arma::vectorise(arma::pow(weight, Power - 1) * Power * factor);
+  const MatType weightVec(const_cast<MatType&>(weight).memptr(),
+      weight.n_elem, 1, false, false);
+  gradient += (Power * factor) * arma::pow(weightVec, Power - 1);
 }
 
 // L1-Regularizer specializations.
@@ -38,7 +45,9 @@ template<>
 template<typename MatType>
 void LRegularizer<1>::Evaluate(const MatType& weight, MatType& gradient)
 {
-  gradient += arma::vectorise(factor * weight / arma::abs(weight));
+  const MatType weightVec(const_cast<MatType&>(weight).memptr(),
+      weight.n_elem, 1, false, false);
+  gradient += factor * (weightVec / arma::abs(weightVec));
 }
 
 // L2-Regularizer specializations.
@@ -46,7 +55,9 @@ template<>
 template<typename MatType>
 void LRegularizer<2>::Evaluate(const MatType& weight, MatType& gradient)
 {
-  gradient += arma::vectorise(2 * factor * weight);
+  const MatType weightVec(const_cast<MatType&>(weight).memptr(),
+      weight.n_elem, 1, false, false);
+  gradient += (2 * factor) * weightVec;
 }
 
 template<int Power>
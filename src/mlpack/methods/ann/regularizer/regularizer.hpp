@@ -15,5 +15,6 @@
 #include "lregularizer.hpp"
 #include "orthogonal_regularizer.hpp"
 #include "no_regularizer.hpp"
+#include "weight_decay.hpp"
 
 #endif
@@ -0,0 +1,73 @@
+/**
+ * @file methods/ann/regularizer/weight_decay.hpp
+ * @author Saksham Bansal
+ *
+ * Definition of the WeightDecay class, a decoupled weight decay regularizer.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_WEIGHT_DECAY_HPP
+#define MLPACK_METHODS_ANN_WEIGHT_DECAY_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * Implementation of decoupled weight decay. Instead of adding an L2 penalty
+ * to the gradient -- which adaptive optimizers then rescale together with the
+ * loss gradient -- the weights are shrunk directly by the decay factor each
+ * time the layer gradient is computed, as proposed for AdamW in:
+ *
+ * @code
+ * @article{Loshchilov2019,
+ *   author  = {Ilya Loshchilov and Frank Hutter},
+ *   title   = {Decoupled Weight Decay Regularization},
+ *   journal = {International Conference on Learning Representations},
+ *   year    = {2019}
+ * }
+ * @endcode
+ *
+ * The decay is a single in-place scale of the weight matrix; the gradient is
+ * left untouched.
+ */
+class WeightDecay
+{
+ public:
+  /**
+   * Create the regularizer object.
+   *
+   * @param factor The decay factor applied to the weights at each gradient
+   *     evaluation.
+   */
+  WeightDecay(double factor = 1e-4);
+
+  /**
+   * Shrink the given weights in place by the decay factor.
+   *
+   * @tparam MatType Type of weight matrix.
+   * @param weight The weight matrix to be decayed.
+   * @param * (gradient) The calculated gradient; left unchanged.
+   */
+  template<typename MatType>
+  void Evaluate(MatType& weight, MatType& /* gradient */);
+
+  //! Serialize the regularizer.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+  //! The decay factor.
+  double factor;
+}; // class WeightDecay
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "weight_decay_impl.hpp"
+
+#endif
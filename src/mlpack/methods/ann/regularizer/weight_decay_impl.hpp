@@ -0,0 +1,43 @@
+/**
+ * @file methods/ann/regularizer/weight_decay_impl.hpp
+ * @author Saksham Bansal
+ *
+ * Implementation of the WeightDecay class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_WEIGHT_DECAY_IMPL_HPP
+#define MLPACK_METHODS_ANN_WEIGHT_DECAY_IMPL_HPP
+
+// In case it hasn't been included.
+#include "weight_decay.hpp"
+
+namespace mlpack {
+namespace ann {
+
+inline WeightDecay::WeightDecay(double factor) :
+    factor(factor)
+{
+  // Nothing to do here.
+}
+
+template<typename MatType>
+void WeightDecay::Evaluate(MatType& weight, MatType& /* gradient */)
+{
+  weight *= (1.0 - factor);
+}
+
+template<typename Archive>
+void WeightDecay::serialize(
+    Archive& ar, const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(factor);
+}
+
+} // namespace ann
+} // namespace mlpack
+
+#endif
@@ -167,6 +167,37 @@ class RNN
                arma::cube responses,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Train the recurrent neural network on variable-length sequences using
+   * length-bucketed mini-batching.  The sequences are grouped into buckets of
+   * similar length (each bucket spans at most a factor of two in length, so
+   * padding waste within a bucket is bounded); each bucket is unrolled only
+   * to its longest sequence instead of the full rho, and all sequences of a
+   * bucket are batched into each time-step computation.  The optimizer is run
+   * once per bucket, from shortest to longest.
+   *
+   * The data format matches the other Train() overloads: sequences shorter
+   * than the cube depth are expected to be padded at the end, and
+   * sequenceLengths[i] gives the number of valid time steps of point i.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param sequenceLengths Number of valid time steps of each data point.
+   * @param optimizer Instantiated optimizer used to train the model.
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective on the last (longest) bucket (NaN or Inf on
+   *      error).
+   */
+  template<typename OptimizerType, typename... CallbackTypes>
+  double Train(arma::cube predictors,
+               arma::cube responses,
+               const arma::urowvec& sequenceLengths,
+               OptimizerType& optimizer,
+               CallbackTypes&&... callbacks);
+
   /**
    * Predict the responses to a given set of predictors. The responses will
    * reflect the output of the given output layer as returned by the
@@ -190,6 +221,34 @@ class RNN
                arma::cube& results,
                const size_t batchSize = 256);
 
+  /**
+   * Begin an online prediction session: switch the network to deterministic
+   * mode and reset the recurrent state of every layer.  Call this once before
+   * the first PredictStep() of each independent input stream; after that,
+   * every PredictStep() advances the retained state by one time step, so a
+   * live stream can be scored tick by tick without replaying its history.
+   */
+  void StartPrediction();
+
+  /**
+   * Advance an online prediction session by a single time step.  The input
+   * holds the observation of one time step, with one column per parallel
+   * stream (the batch size must stay the same for the whole session), and the
+   * output of the network for this step is stored in results.  This does the
+   * same per-step work as one slice of Predict(), reusing the hidden state
+   * retained in the recurrent layers from the previous call.
+   *
+   * Note that the recurrent layers keep at most rho steps of context, exactly
+   * as during training with BPTT: after every rho steps of a session their
+   * internal buffers wrap around and the hidden state restarts.  Choose rho
+   * at construction time to cover the context window the application needs.
+   *
+   * @param input Input observations for one time step (one stream per
+   *     column).
+   * @param results Matrix to store the one-step output predictions in.
+   */
+  void PredictStep(const arma::mat& input, arma::mat& results);
+
   /**
    * Evaluate the recurrent neural network with the given parameters. This
    * function is usually called by the optimizer to train the model.
@@ -0,0 +1,52 @@
+/**
+ * @file methods/ann/visitor/forward_function_visitor.hpp
+ * @author Marcus Edel
+ *
+ * This file provides an abstraction that resolves a layer's Forward() function
+ * to a directly callable function object, so the variant dispatch can be paid
+ * once instead of on every forward pass.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_ANN_VISITOR_FORWARD_FUNCTION_VISITOR_HPP
+#define MLPACK_METHODS_ANN_VISITOR_FORWARD_FUNCTION_VISITOR_HPP
+
+#include <mlpack/methods/ann/layer/layer_traits.hpp>
+#include <mlpack/methods/ann/layer/layer_types.hpp>
+
+#include <boost/variant.hpp>
+
+#include <functional>
+
+namespace mlpack {
+namespace ann {
+
+/**
+ * ForwardFunctionVisitor resolves the concrete layer held by a variant and
+ * returns a function object that calls that layer's Forward() function
+ * directly.  The returned function can be stored and invoked repeatedly
+ * without any further variant dispatch (see FFN::Freeze()).
+ */
+class ForwardFunctionVisitor : public boost::static_visitor<
+    std::function<void(const arma::mat&, arma::mat&)> >
+{
+ public:
+  //! Return a direct-call wrapper around the layer's Forward() function.
+  template<typename LayerType>
+  std::function<void(const arma::mat&, arma::mat&)> operator()(
+      LayerType* layer) const;
+
+  std::function<void(const arma::mat&, arma::mat&)> operator()(
+      MoreTypes layer) const;
+};
+
+} // namespace ann
+} // namespace mlpack
+
+// Include implementation.
+#include "forward_function_visitor_impl.hpp"
+
+#endif
@@ -16,9 +16,6 @@
 #include "drusilla_select.hpp"
 
 #include <queue>
-#include <mlpack/methods/neighbor_search/neighbor_search_rules.hpp>
-#include <mlpack/methods/neighbor_search/sort_policies/furthest_neighbor_sort.hpp>
-#include <mlpack/core/tree/binary_space_tree.hpp>
 #include <algorithm>
 
 namespace mlpack {
@@ -179,23 +176,67 @@ void DrusillaSelect<MatType>::Search(const MatType& querySet,
     throw std::invalid_argument("DrusillaSelect::Search(): requested k is "
         "greater than number of points in candidate set!  Increase l or m.");
 
-  // We'll use the NeighborSearchRules class to perform our brute-force search.
-  // Note that we aren't using trees for our search, so we can use 'int' as a
-  // TreeType.
-  metric::EuclideanDistance metric;
-  NeighborSearchRules<FurthestNeighborSort, metric::EuclideanDistance,
-      tree::KDTree<metric::EuclideanDistance, tree::EmptyStatistic, MatType>>
-      rules(candidateSet, querySet, k, metric, 0, false);
+  // All candidate-set distances are assembled from inner products, so that
+  // one GEMM per block of queries does the bulk of the work:
+  //   d^2(q, c) = ||q||^2 + ||c||^2 - 2 q^T c.
+  arma::vec candidateNorms(candidateSet.n_cols);
+  for (size_t i = 0; i < candidateSet.n_cols; ++i)
+    candidateNorms[i] = arma::dot(candidateSet.col(i), candidateSet.col(i));
 
-  for (size_t q = 0; q < querySet.n_cols; ++q)
-    for (size_t r = 0; r < candidateSet.n_cols; ++r)
-      rules.BaseCase(q, r);
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
 
-  rules.GetResults(neighbors, distances);
+  const size_t blockSize = 256;
+  const size_t numBlocks = (querySet.n_cols + blockSize - 1) / blockSize;
 
-  // Map the neighbors back to their original indices in the reference set.
-  for (size_t i = 0; i < neighbors.n_elem; ++i)
-    neighbors[i] = candidateIndices[neighbors[i]];
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t begin = b * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) querySet.n_cols);
+
+    // Inner products of every query in the block with every candidate.
+    const arma::mat cross(arma::trans(candidateSet) *
+        querySet.cols(begin, end - 1));
+
+    for (size_t q = begin; q < end; ++q)
+    {
+      const double queryNorm = arma::dot(querySet.col(q), querySet.col(q));
+
+      // Heap-free top-k selection: keep the k largest squared distances in a
+      // descending sorted array and insert with a linear shift.  k is small,
+      // so this beats maintaining a priority queue.
+      arma::vec topDist(k);
+      topDist.fill(-DBL_MAX);
+      arma::Col<size_t> topIndices(k);
+
+      for (size_t r = 0; r < candidateSet.n_cols; ++r)
+      {
+        const double distSquared = queryNorm + candidateNorms[r] -
+            2.0 * cross(r, q - begin);
+        if (distSquared > topDist[k - 1])
+        {
+          size_t pos = k - 1;
+          while (pos > 0 && distSquared > topDist[pos - 1])
+          {
+            topDist[pos] = topDist[pos - 1];
+            topIndices[pos] = topIndices[pos - 1];
+            --pos;
+          }
+          topDist[pos] = distSquared;
+          topIndices[pos] = r;
+        }
+      }
+
+      // Emit results furthest-first, mapped back to their original indices in
+      // the reference set.
+      for (size_t j = 0; j < k; ++j)
+      {
+        neighbors(j, q) = candidateIndices[topIndices[j]];
+        distances(j, q) = std::sqrt(std::max(topDist[j], 0.0));
+      }
+    }
+  }
 }
 
 //! Serialize the model.
@@ -104,8 +104,14 @@ void QDAFN<MatType>::Search(const MatType& querySet,
   neighbors.fill(size_t() - 1);
   distances.zeros(k, querySet.n_cols);
 
-  // Search for each point.
-  for (size_t q = 0; q < querySet.n_cols; ++q)
+  // Project every query onto every line with a single GEMM, instead of l dot
+  // products per query inside the search loop.
+  const arma::mat queryProjections = arma::trans(lines) * querySet;
+
+  // Search for each point.  Queries are fully independent, so they are
+  // distributed over threads.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t q = 0; q < (omp_size_t) querySet.n_cols; ++q)
   {
     // Initialize a priority queue.
     // The size_t represents the index of the table, and the double represents
@@ -113,8 +119,7 @@ void QDAFN<MatType>::Search(const MatType& querySet,
     std::priority_queue<std::pair<double, size_t>> queue;
     for (size_t i = 0; i < l; ++i)
     {
-      const double val = sValues(0, i) - arma::dot(querySet.col(q),
-          lines.col(i));
+      const double val = sValues(0, i) - queryProjections(i, q);
       queue.push(std::make_pair(val, i));
     }
 
@@ -122,14 +127,17 @@ void QDAFN<MatType>::Search(const MatType& querySet,
     // in each table (they start at 0).
     arma::Col<size_t> tableLocations = arma::zeros<arma::Col<size_t>>(l);
 
+    // Heap-free top-k selection: the k largest distances seen so far are kept
+    // in a descending sorted array, with duplicates skipped at insertion time.
+    arma::vec topDist(k);
+    topDist.fill(-1.0);
+    arma::Col<size_t> topIndices(k);
+    topIndices.fill(size_t() - 1);
+
     // Now that the queue is initialized, iterate over m elements.
-    std::vector<std::pair<double, size_t>> v(k, std::make_pair(-1.0,
-        size_t(-1)));
-    std::priority_queue<std::pair<double, size_t>>
-        resultsQueue(std::less<std::pair<double, size_t>>(), std::move(v));
     for (size_t i = 0; i < m; ++i)
     {
-      std::pair<size_t, double> p = queue.top();
+      const std::pair<double, size_t> p = queue.top();
       queue.pop();
 
       // Get index of reference point to look at.
@@ -138,8 +146,34 @@ void QDAFN<MatType>::Search(const MatType& querySet,
       // Calculate distance from query point.
       const double dist = mlpack::metric::EuclideanDistance::Evaluate(
           querySet.col(q), candidateSet[p.second].col(tableIndex));
+      const size_t index = sIndices(tableIndex, p.second);
 
-      resultsQueue.push(std::make_pair(dist, sIndices(tableIndex, p.second)));
+      if (dist > topDist[k - 1])
+      {
+        // Avoid inserting any duplicates.
+        bool duplicate = false;
+        for (size_t j = 0; j < k && topIndices[j] != (size_t() - 1); ++j)
+        {
+          if (topIndices[j] == index)
+          {
+            duplicate = true;
+            break;
+          }
+        }
+
+        if (!duplicate)
+        {
+          size_t pos = k - 1;
+          while (pos > 0 && dist > topDist[pos - 1])
+          {
+            topDist[pos] = topDist[pos - 1];
+            topIndices[pos] = topIndices[pos - 1];
+            --pos;
+          }
+          topDist[pos] = dist;
+          topIndices[pos] = index;
+        }
+      }
 
       // Now (line 14) get the next element and insert into the queue.  Do this
       // by adjusting the previous value.  Don't insert anything if we are at
@@ -154,27 +188,11 @@ void QDAFN<MatType>::Search(const MatType& querySet,
       }
     }
 
-    // Extract the results and deduplicate them.
-    size_t extracted = 1;
-    neighbors(0, q) = resultsQueue.top().second;
-    distances(0, q) = resultsQueue.top().first;
-    resultsQueue.pop();
-
-    while (!resultsQueue.empty())
+    // Emit the results furthest-first; unfilled slots keep their sentinels.
+    for (size_t j = 0; j < k && topIndices[j] != (size_t() - 1); ++j)
     {
-      if (extracted == k)
-        break;
-
-      std::pair<double, size_t> result = resultsQueue.top();
-      resultsQueue.pop();
-
-      // Avoid inserting any duplicates.
-      if (neighbors(extracted - 1, q) != result.second)
-      {
-        neighbors(extracted, q) = resultsQueue.top().second;
-        distances(extracted, q) = resultsQueue.top().first;
-        ++extracted;
-      }
+      neighbors(j, q) = topIndices[j];
+      distances(j, q) = topDist[j];
     }
   }
 }
@@ -27,7 +27,10 @@ BayesianLinearRegression::BayesianLinearRegression(const bool centerData,
   responsesOffset(0.0),
   alpha(0.0),
   beta(0.0),
-  gamma(0.0)
+  gamma(0.0),
+  sy(0.0),
+  syy(0.0),
+  nPoints(0)
 {/* Nothing to do */}
 
 double BayesianLinearRegression::Train(const arma::mat& data,
@@ -35,15 +38,101 @@ double BayesianLinearRegression::Train(const arma::mat& data,
 {
   Timer::Start("bayesian_linear_regression");
 
-  arma::mat phi;
-  arma::rowvec t;
-  arma::colvec eigVal;
-  arma::mat eigVec;
+  // Training from scratch discards any previously accumulated statistics.
+  nPoints = 0;
+  AccumulateStatistics(data, responses);
+  OptimizeFromStatistics(false /* no warm start */);
+
+  Timer::Stop("bayesian_linear_regression");
+
+  return RMSE(data, responses);
+}
+
+double BayesianLinearRegression::Update(const arma::mat& data,
+                                        const arma::rowvec& responses)
+{
+  // Without any accumulated data this is just a training run.
+  if (nPoints == 0)
+    return Train(data, responses);
+
+  Timer::Start("bayesian_linear_regression");
+
+  // Fold the new chunk into the sufficient statistics (a rank-k update), then
+  // re-optimize the hyperparameters starting from the current fit; with only
+  // a few new points this typically converges in very few iterations.
+  AccumulateStatistics(data, responses);
+  OptimizeFromStatistics(true /* warm start */);
+
+  Timer::Stop("bayesian_linear_regression");
+
+  return RMSE(data, responses);
+}
 
-  // Preprocess the data. Center and scale.
-  responsesOffset = CenterScaleData(data, responses, phi, t);
+void BayesianLinearRegression::AccumulateStatistics(
+    const arma::mat& data,
+    const arma::rowvec& responses)
+{
+  if (nPoints == 0)
+  {
+    sxx.zeros(data.n_rows, data.n_rows);
+    sx.zeros(data.n_rows);
+    sxy.zeros(data.n_rows);
+    sy = 0.0;
+    syy = 0.0;
+  }
+  else if (data.n_rows != sxx.n_rows)
+  {
+    std::ostringstream oss;
+    oss << "BayesianLinearRegression::Update(): chunk dimensionality ("
+        << data.n_rows << ") does not match the accumulated statistics' ("
+        << sxx.n_rows << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Rank-k update of the raw second moments.
+  sxx += data * data.t();
+  sx += sum(data, 1);
+  sxy += data * responses.t();
+  sy += accu(responses);
+  syy += dot(responses, responses);
+  nPoints += data.n_cols;
+}
+
+void BayesianLinearRegression::OptimizeFromStatistics(const bool warmStart)
+{
+  const double n = (double) nPoints;
+
+  // Reconstruct the second moments of the centered and scaled data from the
+  // raw sufficient statistics; the data itself is no longer needed.
+  arma::mat phiPhiT = sxx;
+  arma::colvec phiTt = sxy;
+  double tDotT = syy;
+
+  if (centerData)
+  {
+    dataOffset = sx / n;
+    responsesOffset = sy / n;
+    phiPhiT -= sx * sx.t() / n;
+    phiTt -= sx * (sy / n);
+    tDotT -= sy * sy / n;
+  }
+  else
+  {
+    responsesOffset = 0.0;
+  }
 
-  if (!arma::eig_sym(eigVal, eigVec, arma::symmatu(phi * phi.t())))
+  if (scaleData)
+  {
+    // This matches the default (N - 1) normalization of arma::stddev().
+    dataScale = arma::sqrt((sxx.diag() - arma::square(sx) / n) / (n - 1));
+    phiPhiT.each_col() /= dataScale;
+    phiPhiT.each_row() /= dataScale.t();
+    phiTt /= dataScale;
+  }
+
+  arma::colvec eigVal;
+  arma::mat eigVec;
+  if (!arma::eig_sym(eigVal, eigVec, arma::symmatu(phiPhiT)))
   {
     Log::Fatal << "BayesianLinearRegression::Train(): Eigendecomposition "
                << "of covariance failed!" << std::endl;
@@ -51,11 +140,15 @@ double BayesianLinearRegression::Train(const arma::mat& data,
 
   // Compute this quantities once and for all.
   const arma::mat eigVecInv = inv(eigVec);
-  const arma::colvec eigVecInvPhitT = eigVecInv * phi * t.t();
+  const arma::colvec eigVecInvPhitT = eigVecInv * phiTt;
 
-  // Initialize the hyperparameters and begin with an infinitely broad prior.
-  alpha = 1e-6;
-  beta =  1 / (var(t, 1) * 0.1);
+  if (!warmStart)
+  {
+    // Initialize the hyperparameters and begin with an infinitely broad
+    // prior.  var(t, 1) expands into the accumulated statistics.
+    alpha = 1e-6;
+    beta = 1 / (((syy - sy * sy / n) / n) * 0.1);
+  }
 
   unsigned short i = 0;
   double deltaAlpha = 1.0, deltaBeta = 1.0, crit = 1.0;
@@ -72,9 +165,11 @@ double BayesianLinearRegression::Train(const arma::mat& data,
     gamma = sum(eigVal / (alpha / beta + eigVal));
     alpha = gamma / dot(omega, omega);
 
-    // Update beta.
-    const arma::rowvec temp = t - omega.t() * phi;
-    beta = (data.n_cols - gamma) / dot(temp, temp);
+    // Update beta.  || t - omega^T phi ||^2 also expands into the
+    // accumulated statistics.
+    const double residual = tDotT - 2 * dot(omega, phiTt) +
+        dot(omega, phiPhiT * omega);
+    beta = (n - gamma) / residual;
 
     // Compute the stopping criterion.
     deltaAlpha += alpha;
@@ -84,10 +179,6 @@ double BayesianLinearRegression::Train(const arma::mat& data,
   }
   // Compute the covariance matrix for the uncertainties later.
   matCovariance = eigVec * diagmat(1 / (beta * eigVal + alpha)) * eigVecInv;
-
-  Timer::Stop("bayesian_linear_regression");
-
-  return RMSE(data, responses);
 }
 
 void BayesianLinearRegression::Predict(const arma::mat& points,
@@ -119,48 +210,6 @@ double BayesianLinearRegression::RMSE(const arma::mat& data,
   return sqrt(mean(square(responses - predictions)));
 }
 
-double BayesianLinearRegression::CenterScaleData(const arma::mat& data,
-                                                 const arma::rowvec& responses,
-                                                 arma::mat& dataProc,
-                                                 arma::rowvec& responsesProc)
-{
-  if (!centerData && !scaleData)
-  {
-    dataProc = arma::mat(const_cast<double*>(data.memptr()), data.n_rows,
-                                             data.n_cols, false, true);
-    responsesProc = arma::rowvec(const_cast<double*>(responses.memptr()),
-                                                     responses.n_elem, false,
-                                                     true);
-  }
-
-  else if (centerData && !scaleData)
-  {
-    dataOffset = mean(data, 1);
-    responsesOffset = mean(responses);
-    dataProc = data.each_col() - dataOffset;
-    responsesProc = responses - responsesOffset;
-  }
-
-  else if (!centerData && scaleData)
-  {
-    dataScale = stddev(data, 0, 1);
-    dataProc = data.each_col() / dataScale;
-    responsesProc = arma::rowvec(const_cast<double*>(responses.memptr()),
-                                                     responses.n_elem, false,
-                                                     true);
-  }
-
-  else
-  {
-    dataOffset = mean(data, 1);
-    dataScale = stddev(data, 0, 1);
-    responsesOffset = mean(responses);
-    dataProc = (data.each_col() - dataOffset).each_col() / dataScale;
-    responsesProc = responses - responsesOffset;
-  }
-  return responsesOffset;
-}
-
 void BayesianLinearRegression::CenterScaleDataPred(
     const arma::mat& data,
     arma::mat& dataProc) const
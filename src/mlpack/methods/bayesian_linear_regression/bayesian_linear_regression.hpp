@@ -127,6 +127,29 @@ class BayesianLinearRegression
   double Train(const arma::mat& data,
                const arma::rowvec& responses);
 
+  /**
+   * Incrementally update the model with a new chunk of points.  The sufficient
+   * statistics of the posterior are updated with a rank-k contribution from
+   * the new chunk -- a cost proportional to the number of new points -- and
+   * the hyperparameters \f$ \alpha \f$ and \f$ \beta \f$ are then re-optimized
+   * from the updated statistics, warm-started at their current values, at a
+   * cost that depends only on the dimensionality.  Unlike Train(), the cost of
+   * a refresh therefore does not grow with the amount of data already seen,
+   * and the resulting posterior is the one Train() would have produced on the
+   * concatenation of all of the chunks (up to floating point roundoff and the
+   * warm start).
+   *
+   * If the model holds no accumulated data yet (or was loaded from an archive
+   * written before incremental updates existed), this is equivalent to
+   * Train() on the given chunk.
+   *
+   * @param data Column-major matrix of new data points, dim(P, K).
+   * @param responses A vector of targets for the new points, dim(K).
+   * @return Root mean squared error on the new chunk.
+   */
+  double Update(const arma::mat& data,
+                const arma::rowvec& responses);
+
   /**
    * Predict \f$y_{i}\f$ for each data point in the given data matrix using the
    * currently-trained Bayesian Ridge model.
@@ -257,20 +280,49 @@ class BayesianLinearRegression
   //! Covariance matrix of the solution vector omega.
   arma::mat matCovariance;
 
+  //! Accumulated second moment of the raw points (\f$ \sum_i x_i x_i^T \f$),
+  //! from which the centered and scaled covariance is reconstructed.
+  arma::mat sxx;
+
+  //! Accumulated sum of the raw points.
+  arma::colvec sx;
+
+  //! Accumulated cross moment of the raw points and responses
+  //! (\f$ \sum_i x_i y_i \f$).
+  arma::colvec sxy;
+
+  //! Accumulated sum of the responses.
+  double sy;
+
+  //! Accumulated squared norm of the responses.
+  double syy;
+
+  //! Number of points accumulated into the statistics above.
+  size_t nPoints;
+
   /**
-   * Center and scale the data accordind to centerData and scaleData.
-   * Allows future modifications of new points.
+   * Add a chunk of points to the accumulated sufficient statistics (a rank-k
+   * update of the raw second moments).
    *
-   * @param data Design matrix in column-major format, dim(P, N).
-   * @param responses A vector of targets.
-   * @param dataProc Data processed, dim(P, N).
-   * @param responsesProc Responses processed, dim(N).
-   * @return reponsesOffset Mean of responses.
+   * @note A std::invalid_argument exception will be thrown if the chunk does
+   * not match the dimensionality of the accumulated statistics.
+   *
+   * @param data Design matrix in column-major format, dim(P, K).
+   * @param responses A vector of targets, dim(K).
    */
-  double CenterScaleData(const arma::mat& data,
-                         const arma::rowvec& responses,
-                         arma::mat& dataProc,
-                         arma::rowvec& responsesProc);
+  void AccumulateStatistics(const arma::mat& data,
+                            const arma::rowvec& responses);
+
+  /**
+   * Run the evidence maximization loop over the accumulated sufficient
+   * statistics, filling omega, alpha, beta, gamma, matCovariance and the
+   * centering/scaling parameters.  The cost depends only on the
+   * dimensionality, not on the number of points accumulated.
+   *
+   * @param warmStart If true, continue from the current values of alpha and
+   *     beta instead of restarting from an infinitely broad prior.
+   */
+  void OptimizeFromStatistics(const bool warmStart);
 
   /**
    * Center and scale the points before prediction.
@@ -284,6 +336,9 @@ class BayesianLinearRegression
 } // namespace regression
 } // namespace mlpack
 
+// Version 1 adds the sufficient statistics that support Update().
+BOOST_CLASS_VERSION(mlpack::regression::BayesianLinearRegression, 1);
+
 // Include implementation of serialize.
 #include "bayesian_linear_regression_impl.hpp"
 
@@ -22,7 +22,7 @@ namespace regression {
  */
 template<typename Archive>
 void BayesianLinearRegression::serialize(Archive& ar,
-                                         const unsigned int /* version */)
+                                         const unsigned int version)
 {
   ar & BOOST_SERIALIZATION_NVP(centerData);
   ar & BOOST_SERIALIZATION_NVP(scaleData);
@@ -36,6 +36,28 @@ void BayesianLinearRegression::serialize(Archive& ar,
   ar & BOOST_SERIALIZATION_NVP(gamma);
   ar & BOOST_SERIALIZATION_NVP(omega);
   ar & BOOST_SERIALIZATION_NVP(matCovariance);
+
+  // The sufficient statistics that support Update() were added in version 1.
+  if (version > 0)
+  {
+    ar & BOOST_SERIALIZATION_NVP(sxx);
+    ar & BOOST_SERIALIZATION_NVP(sx);
+    ar & BOOST_SERIALIZATION_NVP(sxy);
+    ar & BOOST_SERIALIZATION_NVP(sy);
+    ar & BOOST_SERIALIZATION_NVP(syy);
+    ar & BOOST_SERIALIZATION_NVP(nPoints);
+  }
+  else if (Archive::is_loading::value)
+  {
+    // This model was saved before incremental updates existed, so the first
+    // Update() after loading will behave like Train() on the new chunk.
+    sxx.clear();
+    sx.clear();
+    sxy.clear();
+    sy = 0.0;
+    syy = 0.0;
+    nPoints = 0;
+  }
 }
 
 } // namespace regression
@@ -63,6 +63,54 @@ void BiasSVD<OptimizerType>::Apply(const arma::mat& data,
   q = parameters.row(rank).subvec(0, numUsers - 1).t();
 }
 
+// When parallel SGD is selected, use the lock-free (HOGWILD!-style) Optimize()
+// specialization for BiasSVDFunction.  Each thread gets an equal share of the
+// ratings in every epoch and applies its updates without locking; this is safe
+// for matrix factorization because each rating only touches one user column
+// and one item column of the parameters.
+template<>
+inline void BiasSVD<ens::ParallelSGD<ens::ExponentialBackoff>>::Apply(
+    const arma::mat& data,
+    const size_t rank,
+    arma::mat& u,
+    arma::mat& v,
+    arma::vec& p,
+    arma::vec& q)
+{
+  // Make the optimizer object using a BiasSVDFunction object.
+  BiasSVDFunction<arma::mat> biasSVDFunc(data, rank, lambda);
+
+  size_t threads = 1;
+  #ifdef HAS_OPENMP
+  threads = (size_t) omp_get_max_threads();
+  #endif
+  const size_t threadShareSize = (size_t)
+      std::ceil((double) biasSVDFunc.NumFunctions() / threads);
+
+  // Back off only after the last epoch, so that the step size stays constant
+  // at alpha, matching the behavior of the serial SGD optimizer.
+  ens::ExponentialBackoff decayPolicy(iterations + 1, alpha, 0.5);
+  // The epoch counter runs from 1 to maxIterations exclusive, so add one to
+  // perform the same number of update epochs as the serial optimizer.
+  ens::ParallelSGD<ens::ExponentialBackoff> optimizer(iterations + 1,
+      threadShareSize, 1e-5, true, decayPolicy);
+
+  // Get optimized parameters.
+  arma::mat parameters = biasSVDFunc.GetInitialPoint();
+  optimizer.Optimize(biasSVDFunc, parameters);
+
+  // Constants for extracting user and item matrices.
+  const size_t numUsers = max(data.row(0)) + 1;
+  const size_t numItems = max(data.row(1)) + 1;
+
+  // Extract user and item matrices, user and item bias from the optimized
+  // parameters.
+  u = parameters.submat(0, numUsers, rank - 1, numUsers + numItems - 1).t();
+  v = parameters.submat(0, 0, rank - 1, numUsers - 1);
+  p = parameters.row(rank).subvec(numUsers, numUsers + numItems - 1).t();
+  q = parameters.row(rank).subvec(0, numUsers - 1).t();
+}
+
 } // namespace svd
 } // namespace mlpack
 
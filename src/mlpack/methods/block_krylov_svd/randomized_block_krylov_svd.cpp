@@ -12,6 +12,8 @@
 
 #include "randomized_block_krylov_svd.hpp"
 
+#include <mlpack/core/util/parallel.hpp>
+
 namespace mlpack {
 namespace svd {
 
@@ -64,8 +66,10 @@ void RandomizedBlockKrylovSVD::Apply(const arma::mat& data,
 
   // Create a working matrix using data from writable auxiliary memory
   // (K matrix). Doing so avoids an uncessary copy in upcoming step.
+  arma::mat product;
   block = arma::mat(K.memptr(), data.n_rows, blockSize, false, false);
-  arma::qr_econ(block, R, data * G);
+  TiledProduct(data, G, product);
+  TallSkinnyQR(product, block, R);
 
   for (size_t blockOffset = block.n_elem; blockOffset < K.n_elem;
       blockOffset += block.n_elem)
@@ -74,14 +78,15 @@ void RandomizedBlockKrylovSVD::Apply(const arma::mat& data,
     blockIteration = arma::mat(K.memptr() + blockOffset, block.n_rows,
         block.n_cols, false, false);
 
-    arma::qr_econ(blockIteration, R, data * (data.t() * block));
+    TiledGramProduct(data, block, product);
+    TallSkinnyQR(product, blockIteration, R);
 
     // Update working matrix for the next iteration.
     block = arma::mat(K.memptr() + blockOffset, block.n_rows, block.n_cols,
         false, false);
   }
 
-  arma::qr_econ(Q, R, K);
+  TallSkinnyQR(K, Q, R);
 
   // Approximate eigenvalues and eigenvectors using Rayleigh–Ritz method.
   arma::svd_econ(u, s, v, Q.t() * data);
@@ -92,5 +97,112 @@ void RandomizedBlockKrylovSVD::Apply(const arma::mat& data,
   u = Q * u;
 }
 
+void RandomizedBlockKrylovSVD::TiledProduct(const arma::mat& data,
+                                            const arma::mat& other,
+                                            arma::mat& out) const
+{
+  // Width of a column tile; each tile contributes a rank-tileCols update to
+  // the output, so the per-tile products can run across threads.
+  const size_t tileCols = 512;
+  const size_t numTiles = (data.n_cols + tileCols - 1) / tileCols;
+
+  out.zeros(data.n_rows, other.n_cols);
+
+  #pragma omp parallel
+  {
+    arma::mat localOut(data.n_rows, other.n_cols, arma::fill::zeros);
+
+    #pragma omp for schedule(static) nowait
+    for (omp_size_t t = 0; t < (omp_size_t) numTiles; ++t)
+    {
+      const size_t begin = t * tileCols;
+      const size_t end = std::min(begin + tileCols, (size_t) data.n_cols);
+
+      localOut += data.cols(begin, end - 1) * other.rows(begin, end - 1);
+    }
+
+    #pragma omp critical (BlockKrylovTiledProduct)
+    {
+      out += localOut;
+    }
+  }
+}
+
+void RandomizedBlockKrylovSVD::TiledGramProduct(const arma::mat& data,
+                                                const arma::mat& other,
+                                                arma::mat& out) const
+{
+  const size_t tileCols = 512;
+  const size_t numTiles = (data.n_cols + tileCols - 1) / tileCols;
+
+  // Each tile writes a disjoint set of rows, so no merge step is needed.
+  arma::mat temp(data.n_cols, other.n_cols);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t t = 0; t < (omp_size_t) numTiles; ++t)
+  {
+    const size_t begin = t * tileCols;
+    const size_t end = std::min(begin + tileCols, (size_t) data.n_cols);
+
+    temp.rows(begin, end - 1) = data.cols(begin, end - 1).t() * other;
+  }
+
+  TiledProduct(data, temp, out);
+}
+
+void RandomizedBlockKrylovSVD::TallSkinnyQR(const arma::mat& A,
+                                            arma::mat& Q,
+                                            arma::mat& R) const
+{
+  // Each row block must have at least as many rows as columns, so that its
+  // R factor is square; more blocks than threads gain nothing.
+  const size_t numBlocks = (A.n_cols == 0) ? 1 :
+      std::min(Parallel::NumThreads(), (size_t) (A.n_rows / A.n_cols));
+
+  if (numBlocks < 2)
+  {
+    arma::qr_econ(Q, R, A);
+    return;
+  }
+
+  const size_t cols = A.n_cols;
+  const size_t blockRows = A.n_rows / numBlocks;
+
+  Q.set_size(A.n_rows, cols);
+  arma::mat stackedR(numBlocks * cols, cols);
+
+  // Factorize each row block independently.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t begin = b * blockRows;
+    const size_t end = ((size_t) b == numBlocks - 1) ? (size_t) A.n_rows :
+        begin + blockRows;
+
+    arma::mat blockQ, blockR;
+    arma::qr_econ(blockQ, blockR, A.rows(begin, end - 1));
+
+    Q.rows(begin, end - 1) = blockQ;
+    stackedR.rows(b * cols, (b + 1) * cols - 1) = blockR;
+  }
+
+  // Couple the row blocks by factorizing the stacked R factors.
+  arma::mat innerQ;
+  arma::qr_econ(innerQ, R, stackedR);
+
+  // Update the per-block orthonormal factors.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t b = 0; b < (omp_size_t) numBlocks; ++b)
+  {
+    const size_t begin = b * blockRows;
+    const size_t end = ((size_t) b == numBlocks - 1) ? (size_t) A.n_rows :
+        begin + blockRows;
+
+    const arma::mat blockQ = Q.rows(begin, end - 1) *
+        innerQ.rows(b * cols, (b + 1) * cols - 1);
+    Q.rows(begin, end - 1) = blockQ;
+  }
+}
+
 } // namespace svd
 } // namespace mlpack
@@ -115,6 +115,35 @@ class RandomizedBlockKrylovSVD
   size_t& BlockSize() { return blockSize; }
 
  private:
+  /**
+   * Compute out = data * other with the product tiled over column blocks of
+   * the data, so the per-tile GEMMs run across threads.
+   */
+  void TiledProduct(const arma::mat& data,
+                    const arma::mat& other,
+                    arma::mat& out) const;
+
+  /**
+   * Compute out = data * (data.t() * other), the Krylov iteration step, with
+   * both products tiled over column blocks of the data.
+   */
+  void TiledGramProduct(const arma::mat& data,
+                        const arma::mat& other,
+                        arma::mat& out) const;
+
+  /**
+   * Economical QR decomposition of a tall and skinny matrix, computed as a
+   * communication-avoiding TSQR: independent QR factorizations of row blocks
+   * run in parallel, the stacked R factors are factorized once, and the block
+   * orthonormal factors are updated accordingly.  Falls back to a plain
+   * qr_econ() when the matrix is not tall enough to split.
+   *
+   * @param A Matrix to decompose (many more rows than columns).
+   * @param Q Orthonormal factor (same size as A).
+   * @param R Upper triangular factor (A.n_cols x A.n_cols).
+   */
+  void TallSkinnyQR(const arma::mat& A, arma::mat& Q, arma::mat& R) const;
+
   //! Locally stored number of iterations for the power method.
   size_t maxIterations;
 
@@ -153,6 +153,8 @@ class CFType
       return;
     }
     this->numUsersForSimilarity = num;
+    // Any cached neighborhoods have the wrong size now.
+    neighborhoodCached = false;
   }
 
   //! Gets number of users for calculating similarity.
@@ -182,6 +184,29 @@ class CFType
   //! Get the normalization object.
   const NormalizationType& Normalization() const { return normalization; }
 
+  /**
+   * Batch-compute and cache the neighborhood (and corresponding similarities)
+   * of every user in one neighbor search.  After this call,
+   * GetRecommendations() looks the queried users up in the cache instead of
+   * running a tree traversal per call, which greatly reduces the latency of
+   * online recommendation queries.  Note that the cached neighborhoods are
+   * computed with the NeighborSearchPolicy given here, and will be used by
+   * GetRecommendations() regardless of the policy it is called with.
+   *
+   * The cache is invalidated whenever Train() is called again or the
+   * neighborhood size is changed, so there is no need to manage it manually;
+   * simply call this method again after retraining if cached lookups are
+   * still desired.
+   *
+   * @tparam NeighborSearchPolicy The policy used to search neighbors of
+   *     query set in referece set.
+   */
+  template<typename NeighborSearchPolicy = EuclideanSearch>
+  void PrecomputeNeighborhoods();
+
+  //! Get whether precomputed neighborhoods are cached and valid.
+  bool NeighborhoodCached() const { return neighborhoodCached; }
+
   /**
    * Generates the given number of recommendations for all users.
    *
@@ -273,6 +298,13 @@ class CFType
   arma::sp_mat cleanedData;
   //! Data normalization object.
   NormalizationType normalization;
+  //! Cached neighborhood of every user (one column per user); only valid if
+  //! neighborhoodCached is true.
+  arma::Mat<size_t> cachedNeighborhood;
+  //! Similarities corresponding to cachedNeighborhood.
+  arma::mat cachedSimilarities;
+  //! Whether cachedNeighborhood matches the current factorization.
+  bool neighborhoodCached;
 
   //! Candidate represents a possible recommendation (value, item).
   typedef std::pair<double, size_t> Candidate;
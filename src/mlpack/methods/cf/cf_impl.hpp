@@ -30,7 +30,8 @@ CFType<DecompositionPolicy,
 CFType(const size_t numUsersForSimilarity,
        const size_t rank) :
     numUsersForSimilarity(numUsersForSimilarity),
-    rank(rank)
+    rank(rank),
+    neighborhoodCached(false)
 {
   // Validate neighbourhood size.
   if (numUsersForSimilarity < 1)
@@ -58,7 +59,8 @@ CFType(const MatType& data,
        const double minResidue,
        const bool mit) :
     numUsersForSimilarity(numUsersForSimilarity),
-    rank(rank)
+    rank(rank),
+    neighborhoodCached(false)
 {
   // Validate neighbourhood size.
   if (numUsersForSimilarity < 1)
@@ -111,6 +113,9 @@ Train(const arma::mat& data,
   this->decomposition.Apply(
       normalizedData, cleanedData, rank, maxIterations, minResidue, mit);
   Timer::Stop("cf_factorization");
+
+  // Any precomputed neighborhoods refer to the old factorization.
+  neighborhoodCached = false;
 }
 
 // Train when data is given as sparse matrix of user item table.
@@ -152,6 +157,29 @@ Train(const arma::sp_mat& data,
   this->decomposition.Apply(
       data, cleanedData, rank, maxIterations, minResidue, mit);
   Timer::Stop("cf_factorization");
+
+  // Any precomputed neighborhoods refer to the old factorization.
+  neighborhoodCached = false;
+}
+
+template<typename DecompositionPolicy,
+         typename NormalizationType>
+template<typename NeighborSearchPolicy>
+void CFType<DecompositionPolicy,
+            NormalizationType>::
+PrecomputeNeighborhoods()
+{
+  // Compute the neighborhood of every user in one batch search; this is far
+  // cheaper than one search per GetRecommendations() call.
+  arma::Col<size_t> users = arma::linspace<arma::Col<size_t> >(0,
+      cleanedData.n_cols - 1, cleanedData.n_cols);
+
+  Timer::Start("cf_precompute_neighborhoods");
+  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
+      users, numUsersForSimilarity, cachedNeighborhood, cachedSimilarities);
+  Timer::Stop("cf_precompute_neighborhoods");
+
+  neighborhoodCached = true;
 }
 
 template<typename DecompositionPolicy,
@@ -194,9 +222,23 @@ GetRecommendations(const size_t numRecs,
   // is part of the neighborhood---this is intentional.  We want to use the
   // weighted sum of both the query user and the local neighborhood of the
   // query user.
-  // Calculate the neighborhood of the queried users.
-  decomposition.template GetNeighborhood<NeighborSearchPolicy>(
-      users, numUsersForSimilarity, neighborhood, similarities);
+  if (neighborhoodCached)
+  {
+    // Look the queried users up in the precomputed cache instead of running a
+    // fresh neighbor search.
+    neighborhood.set_size(cachedNeighborhood.n_rows, users.n_elem);
+    similarities.set_size(cachedSimilarities.n_rows, users.n_elem);
+    for (size_t i = 0; i < users.n_elem; ++i)
+    {
+      neighborhood.col(i) = cachedNeighborhood.col(users(i));
+      similarities.col(i) = cachedSimilarities.col(users(i));
+    }
+  }
+  else
+  {
+    decomposition.template GetNeighborhood<NeighborSearchPolicy>(
+        users, numUsersForSimilarity, neighborhood, similarities);
+  }
 
   // Generate recommendations for each query user by finding the maximum numRecs
   // elements in the ratings vector.
@@ -436,6 +478,11 @@ serialize(Archive& ar, const unsigned int /* version */)
   ar & BOOST_SERIALIZATION_NVP(decomposition);
   ar & BOOST_SERIALIZATION_NVP(cleanedData);
   ar & BOOST_SERIALIZATION_NVP(normalization);
+
+  // The neighborhood cache is cheap to recompute, so it is not serialized;
+  // make sure a stale cache is never used with a freshly loaded model.
+  if (Archive::is_loading::value)
+    neighborhoodCached = false;
 }
 
 } // namespace cf
@@ -19,6 +19,7 @@
 
 #include <mlpack/methods/cf/decomposition_policies/batch_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/randomized_svd_method.hpp>
+#include <mlpack/methods/cf/decomposition_policies/sparse_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/regularized_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/svd_complete_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/svd_incomplete_method.hpp>
@@ -90,6 +91,8 @@ BINDING_LONG_DESC(
     " - 'SVDCompleteIncremental' -- SVD complete incremental learning\n"
     " - 'BiasSVD' -- Bias SVD using a SGD optimizer\n"
     " - 'SVDPP' -- SVD++ using a SGD optimizer\n"
+    " - 'SparseSVD' -- sparse truncated SVD computed directly on the sparse "
+    "rating matrix\n"
     "\n\n"
     "The following neighbor search algorithms can be specified via" +
     " the " + PRINT_PARAM_STRING("neighbor_search") + " parameter:"
@@ -465,6 +468,14 @@ void AssembleFactorizerType(const std::string& algorithm,
         "when max_iterations is reached");
     PerformAction<SVDPlusPlusPolicy>(dataset, rank, maxIterations, minResidue);
   }
+  else if (algorithm == "SparseSVD")
+  {
+    ReportIgnoredParam("min_residue", "The sparse truncated SVD is a direct "
+        "decomposition");
+    ReportIgnoredParam("max_iterations", "The sparse truncated SVD is a "
+        "direct decomposition");
+    PerformAction<SparseSVDPolicy>(dataset, rank, maxIterations, minResidue);
+  }
 }
 
 static void mlpackMain()
@@ -488,7 +499,7 @@ static void mlpackMain()
 
   RequireParamInSet<string>("algorithm", { "NMF", "BatchSVD",
       "SVDIncompleteIncremental", "SVDCompleteIncremental", "RegSVD",
-      "RandSVD", "BiasSVD", "SVDPP" }, true, "unknown algorithm");
+      "RandSVD", "BiasSVD", "SVDPP", "SparseSVD" }, true, "unknown algorithm");
 
   ReportIgnoredParam({{ "iteration_only_termination", true }}, "min_residue");
 
@@ -24,6 +24,7 @@
 #include <mlpack/methods/cf/decomposition_policies/svd_incomplete_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/bias_svd_method.hpp>
 #include <mlpack/methods/cf/decomposition_policies/svdplusplus_method.hpp>
+#include <mlpack/methods/cf/decomposition_policies/sparse_svd_method.hpp>
 
 #include <mlpack/methods/cf/normalization/no_normalization.hpp>
 #include <mlpack/methods/cf/normalization/overall_mean_normalization.hpp>
@@ -170,7 +171,16 @@ class CFModel
                  CFType<SVDCompletePolicy, ZScoreNormalization>*,
                  CFType<SVDIncompletePolicy, ZScoreNormalization>*,
                  CFType<BiasSVDPolicy, ZScoreNormalization>*,
-                 CFType<SVDPlusPlusPolicy, ZScoreNormalization>*> cf;
+                 CFType<SVDPlusPlusPolicy, ZScoreNormalization>*,
+
+                 // The sparse SVD types are appended after the others so that
+                 // the variant indices of previously serialized models do not
+                 // change.
+                 CFType<SparseSVDPolicy, NoNormalization>*,
+                 CFType<SparseSVDPolicy, ItemMeanNormalization>*,
+                 CFType<SparseSVDPolicy, UserMeanNormalization>*,
+                 CFType<SparseSVDPolicy, OverallMeanNormalization>*,
+                 CFType<SparseSVDPolicy, ZScoreNormalization>*> cf;
 
  public:
   //! Create an empty CF model.
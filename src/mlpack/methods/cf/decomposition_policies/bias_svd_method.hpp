@@ -47,13 +47,19 @@ class BiasSVDPolicy
    * @param maxIterations Number of iterations.
    * @param alpha Learning rate for optimization.
    * @param lambda Regularization parameter for optimization.
+   * @param useParallelSGD If true, the factorization is trained with the
+   *        lock-free (HOGWILD!-style) parallel SGD optimizer, which scales
+   *        with the number of OpenMP threads at the cost of a
+   *        nondeterministic update order.
    */
   BiasSVDPolicy(const size_t maxIterations = 10,
                 const double alpha = 0.02,
-                const double lambda = 0.05) :
+                const double lambda = 0.05,
+                const bool useParallelSGD = false) :
       maxIterations(maxIterations),
       alpha(alpha),
-      lambda(lambda)
+      lambda(lambda),
+      useParallelSGD(useParallelSGD)
   {
     /* Nothing to do here */
   }
@@ -78,8 +84,17 @@ class BiasSVDPolicy
              const bool /* mit */)
   {
     // Perform decomposition using the bias SVD algorithm.
-    svd::BiasSVD<> biassvd(maxIterations, alpha, lambda);
-    biassvd.Apply(data, rank, w, h, p, q);
+    if (useParallelSGD)
+    {
+      svd::BiasSVD<ens::ParallelSGD<ens::ExponentialBackoff>>
+          biassvd(maxIterations, alpha, lambda);
+      biassvd.Apply(data, rank, w, h, p, q);
+    }
+    else
+    {
+      svd::BiasSVD<> biassvd(maxIterations, alpha, lambda);
+      biassvd.Apply(data, rank, w, h, p, q);
+    }
   }
 
   /**
@@ -160,6 +175,11 @@ class BiasSVDPolicy
   //! Modify regularization parameter.
   double& Lambda() { return lambda; }
 
+  //! Get whether parallel SGD is used for training.
+  bool UseParallelSGD() const { return useParallelSGD; }
+  //! Modify whether parallel SGD is used for training.
+  bool& UseParallelSGD() { return useParallelSGD; }
+
   /**
    * Serialization.
    */
@@ -169,6 +189,7 @@ class BiasSVDPolicy
     ar & BOOST_SERIALIZATION_NVP(maxIterations);
     ar & BOOST_SERIALIZATION_NVP(alpha);
     ar & BOOST_SERIALIZATION_NVP(lambda);
+    ar & BOOST_SERIALIZATION_NVP(useParallelSGD);
     ar & BOOST_SERIALIZATION_NVP(w);
     ar & BOOST_SERIALIZATION_NVP(h);
     ar & BOOST_SERIALIZATION_NVP(p);
@@ -182,6 +203,8 @@ class BiasSVDPolicy
   double alpha;
   //! Regularization parameter for optimization.
   double lambda;
+  //! Whether to train with the lock-free parallel SGD optimizer.
+  bool useParallelSGD;
   //! Item matrix.
   arma::mat w;
   //! User matrix.
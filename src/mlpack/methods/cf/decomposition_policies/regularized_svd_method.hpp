@@ -46,9 +46,15 @@ class RegSVDPolicy
    *
    * @param maxIterations Number of iterations for the power method
    *        (Default: 2).
+   * @param useParallelSGD If true, the factorization is trained with the
+   *        lock-free (HOGWILD!-style) parallel SGD optimizer, which scales
+   *        with the number of OpenMP threads at the cost of a
+   *        nondeterministic update order.
    */
-  RegSVDPolicy(const size_t maxIterations = 10) :
-      maxIterations(maxIterations)
+  RegSVDPolicy(const size_t maxIterations = 10,
+               const bool useParallelSGD = false) :
+      maxIterations(maxIterations),
+      useParallelSGD(useParallelSGD)
   {
     /* Nothing to do here */
   }
@@ -73,8 +79,17 @@ class RegSVDPolicy
              const bool /* mit */)
   {
     // Do singular value decomposition using the regularized SVD algorithm.
-    svd::RegularizedSVD<> regsvd(maxIterations);
-    regsvd.Apply(data, rank, w, h);
+    if (useParallelSGD)
+    {
+      svd::RegularizedSVD<ens::ParallelSGD<ens::ExponentialBackoff>>
+          regsvd(maxIterations);
+      regsvd.Apply(data, rank, w, h);
+    }
+    else
+    {
+      svd::RegularizedSVD<> regsvd(maxIterations);
+      regsvd.Apply(data, rank, w, h);
+    }
   }
 
   /**
@@ -149,6 +164,11 @@ class RegSVDPolicy
   //! Modify the number of iterations.
   size_t& MaxIterations() { return maxIterations; }
 
+  //! Get whether parallel SGD is used for training.
+  bool UseParallelSGD() const { return useParallelSGD; }
+  //! Modify whether parallel SGD is used for training.
+  bool& UseParallelSGD() { return useParallelSGD; }
+
   /**
    * Serialization.
    */
@@ -162,6 +182,8 @@ class RegSVDPolicy
  private:
   //! Locally stored number of iterations.
   size_t maxIterations;
+  //! Whether to train with the lock-free parallel SGD optimizer.
+  bool useParallelSGD;
   //! Item matrix.
   arma::mat w;
   //! User matrix.
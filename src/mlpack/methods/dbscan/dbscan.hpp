@@ -65,12 +65,15 @@ class DBSCAN
    * @param batchMode If true, all points are searched in batch.
    * @param rangeSearch Optional instantiated RangeSearch object.
    * @param pointSelector OptionL instantiated PointSelectionPolicy object.
+   * @param blockSize Number of points to search per block when batchMode is
+   *      false; only one block's neighbor lists are held in memory at a time.
    */
   DBSCAN(const double epsilon,
          const size_t minPoints,
          const bool batchMode = true,
          RangeSearchType rangeSearch = RangeSearchType(),
-         PointSelectionPolicy pointSelector = PointSelectionPolicy());
+         PointSelectionPolicy pointSelector = PointSelectionPolicy(),
+         const size_t blockSize = 1024);
 
   /**
    * Performs DBSCAN clustering on the data, returning number of clusters
@@ -112,6 +115,11 @@ class DBSCAN
                  arma::Row<size_t>& assignments,
                  arma::mat& centroids);
 
+  //! Get the number of points searched per block (when batchMode is false).
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of points searched per block (when batchMode is false).
+  size_t& BlockSize() { return blockSize; }
+
  private:
   //! Maximum distance between two points to be part of same cluster.
   double epsilon;
@@ -129,11 +137,15 @@ class DBSCAN
   //! Instantiated point selection policy.
   PointSelectionPolicy pointSelector;
 
+  //! Number of points to search per block when batchMode is false.
+  size_t blockSize;
+
   /**
-   * Performs DBSCAN clustering on the data, returning the number of clusters and
-   * also the list of cluster assignments.  This searches each point iteratively,
-   * and can save on RAM usage.  It may be slower than the batch search with a
-   * dual-tree algorithm.
+   * Performs DBSCAN clustering on the data, returning the number of clusters
+   * and also the list of cluster assignments.  This streams the range searches
+   * one block of query points at a time, so only one block's neighbor lists
+   * are ever held in memory; each block is searched with a single dual-tree
+   * search against the full dataset.
    *
    * @param data Dataset to cluster.
    * @param assignments Assignments for each point.
@@ -26,12 +26,14 @@ DBSCAN<RangeSearchType, PointSelectionPolicy>::DBSCAN(
     const size_t minPoints,
     const bool batchMode,
     RangeSearchType rangeSearch,
-    PointSelectionPolicy pointSelector) :
+    PointSelectionPolicy pointSelector,
+    const size_t blockSize) :
     epsilon(epsilon),
     minPoints(minPoints),
     batchMode(batchMode),
     rangeSearch(rangeSearch),
-    pointSelector(pointSelector)
+    pointSelector(pointSelector),
+    blockSize(std::max(blockSize, (size_t) 1))
 {
   // Nothing to do.
 }
@@ -142,9 +144,9 @@ size_t DBSCAN<RangeSearchType, PointSelectionPolicy>::Cluster(
 
 /**
  * Performs DBSCAN clustering on the data, returning the number of clusters and
- * also the list of cluster assignments.  This searches each point iteratively,
- * and can save on RAM usage.  It may be slower than the batch search with a
- * dual-tree algorithm.
+ * also the list of cluster assignments.  This streams the range searches one
+ * block of query points at a time, so only one block's neighbor lists are
+ * ever held in memory.
  */
 template<typename RangeSearchType, typename PointSelectionPolicy>
 template<typename MatType>
@@ -155,18 +157,26 @@ void DBSCAN<RangeSearchType, PointSelectionPolicy>::PointwiseCluster(
   std::vector<std::vector<size_t>> neighbors;
   std::vector<std::vector<double>> distances;
 
-  for (size_t i = 0; i < data.n_cols; ++i)
+  for (size_t begin = 0; begin < data.n_cols; begin += blockSize)
   {
-    if (i % 10000 == 0 && i > 0)
-      Log::Info << "DBSCAN clustering on point " << i << "..." << std::endl;
-
-    // Do the range search for only this point.
-    rangeSearch.Search(data.col(i), math::Range(0.0, epsilon), neighbors,
-        distances);
-
-    // Union to all neighbors.
-    for (size_t j = 0; j < neighbors[0].size(); ++j)
-      uf.Union(i, neighbors[0][j]);
+    if (begin > 0)
+      Log::Info << "DBSCAN clustering on point " << begin << "..." << std::endl;
+
+    const size_t blockEnd = std::min(data.n_cols, begin + blockSize) - 1;
+
+    // Search this block of query points against the full dataset with a
+    // single dual-tree search; this amortizes far better than one search per
+    // point, but the neighbor lists of previous blocks do not accumulate in
+    // memory like they do with a batch search over all points.
+    rangeSearch.Search(data.cols(begin, blockEnd), math::Range(0.0, epsilon),
+        neighbors, distances);
+
+    // Union each point in the block to all of its neighbors.  The union-find
+    // operations are near-constant-time, so this pass is insignificant next
+    // to the search.
+    for (size_t q = 0; q < neighbors.size(); ++q)
+      for (size_t j = 0; j < neighbors[q].size(); ++j)
+        uf.Union(begin + q, neighbors[q][j]);
   }
 }
 
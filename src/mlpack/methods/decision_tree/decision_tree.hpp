@@ -17,6 +17,7 @@
 #include "gini_gain.hpp"
 #include "information_gain.hpp"
 #include "best_binary_numeric_split.hpp"
+#include "histogram_numeric_split.hpp"
 #include "all_categorical_split.hpp"
 #include "all_dimension_select.hpp"
 #include <type_traits>
@@ -465,6 +466,12 @@ class DecisionTree :
   //! trained tree).
   size_t SplitDimension() const { return splitDimension; }
 
+  //! Get the class probabilities vector of this node.  For a leaf, this holds
+  //! the class probabilities of the training points that fell into the leaf;
+  //! for an internal node, it is used arbitrarily by the split type (a binary
+  //! numeric split stores the split threshold in its only element).
+  const arma::vec& ClassProbabilities() const { return classProbabilities; }
+
   /**
    * Given a point and that this node is not a leaf, calculate the index of the
    * child node this point would go towards.  This method is primarily used by
@@ -0,0 +1,247 @@
+/**
+ * @file methods/decision_tree/histogram_numeric_split_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the histogram-based binary numeric split strategy.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_HISTOGRAM_NUMERIC_SPLIT_IMPL_HPP
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction>
+template<bool UseWeights, typename VecType, typename WeightVecType>
+double HistogramNumericSplit<FitnessFunction>::SplitIfBetter(
+    const double bestGain,
+    const VecType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const WeightVecType& weights,
+    const size_t minimumLeafSize,
+    const double minimumGainSplit,
+    arma::Col<typename VecType::elem_type>& classProbabilities,
+    AuxiliarySplitInfo<typename VecType::elem_type>& /* aux */)
+{
+  typedef typename VecType::elem_type ElemType;
+
+  // First sanity check: if we don't have enough points, we can't split.
+  if (data.n_elem < (minimumLeafSize * 2))
+    return DBL_MAX;
+  if (bestGain == 0.0)
+    return DBL_MAX; // It can't be outperformed.
+
+  // Find the range of the dimension in a single pass.
+  ElemType minValue = data[0];
+  ElemType maxValue = data[0];
+  for (size_t i = 1; i < data.n_elem; ++i)
+  {
+    if (data[i] < minValue)
+      minValue = data[i];
+    if (data[i] > maxValue)
+      maxValue = data[i];
+  }
+
+  // Sanity check: if all values are the same, we can't split in this
+  // dimension.
+  if (minValue == maxValue)
+    return DBL_MAX;
+
+  // More bins than points would leave most bins empty; cap the bin count.
+  const size_t bins = std::min((size_t) NumBins, (size_t) data.n_elem);
+  const double binWidth = ((double) maxValue - (double) minValue) / bins;
+
+  // Build per-bin class statistics in one pass over the dimension.  We track
+  // the number of points in every bin even in the weighted case, since the
+  // minimum leaf size is expressed in points, and we track the smallest and
+  // largest value that actually falls in each bin so that the chosen split
+  // threshold can be placed halfway between observed values, as
+  // BestBinaryNumericSplit does.
+  arma::Mat<size_t> binCounts;
+  arma::mat binWeightSums;
+  arma::Col<size_t> binTotals(bins, arma::fill::zeros);
+  arma::vec binWeightTotals;
+  arma::Col<ElemType> binMins(bins);
+  arma::Col<ElemType> binMaxs(bins);
+  if (UseWeights)
+  {
+    binWeightSums.zeros(numClasses, bins);
+    binWeightTotals.zeros(bins);
+  }
+  else
+  {
+    binCounts.zeros(numClasses, bins);
+  }
+
+  for (size_t i = 0; i < data.n_elem; ++i)
+  {
+    size_t bin = (size_t) (((double) data[i] - (double) minValue) / binWidth);
+    if (bin >= bins)
+      bin = bins - 1; // The maximum value lands exactly on the upper edge.
+
+    if (binTotals[bin] == 0)
+    {
+      binMins[bin] = data[i];
+      binMaxs[bin] = data[i];
+    }
+    else
+    {
+      if (data[i] < binMins[bin])
+        binMins[bin] = data[i];
+      if (data[i] > binMaxs[bin])
+        binMaxs[bin] = data[i];
+    }
+    ++binTotals[bin];
+
+    if (UseWeights)
+    {
+      binWeightSums(labels[i], bin) += weights[i];
+      binWeightTotals[bin] += weights[i];
+    }
+    else
+    {
+      ++binCounts(labels[i], bin);
+    }
+  }
+
+  // Loop through all bin boundaries, choosing the best one.  Also, force a
+  // minimum leaf size of 1 (empty children don't make sense).
+  double bestFoundGain = std::min(bestGain + minimumGainSplit, 0.0);
+  bool improved = false;
+  const size_t minimum = std::max(minimumLeafSize, (size_t) 1);
+
+  // The left side starts empty and the right side starts with everything; as
+  // the boundary sweeps right, each bin's statistics are added to the left
+  // side and subtracted from the right side.
+  arma::Col<size_t> leftCounts, rightCounts;
+  arma::vec leftWeightSums, rightWeightSums;
+  double totalWeight = 0.0;
+  double totalLeftWeight = 0.0;
+  double totalRightWeight = 0.0;
+  if (UseWeights)
+  {
+    leftWeightSums.zeros(numClasses);
+    rightWeightSums = arma::sum(binWeightSums, 1);
+    totalWeight = arma::accu(binWeightTotals);
+    totalRightWeight = totalWeight;
+    bestFoundGain *= totalWeight;
+  }
+  else
+  {
+    leftCounts.zeros(numClasses);
+    rightCounts = arma::sum(binCounts, 1);
+    bestFoundGain *= data.n_elem;
+  }
+
+  size_t leftCount = 0;
+  ElemType leftMax = minValue;
+  for (size_t bin = 0; bin + 1 < bins; ++bin)
+  {
+    // An empty bin leaves the class distribution unchanged, so the gain is
+    // identical to the previous boundary.
+    if (binTotals[bin] == 0)
+      continue;
+
+    // Move this bin's statistics from the right side to the left side.
+    if (UseWeights)
+    {
+      leftWeightSums += binWeightSums.col(bin);
+      rightWeightSums -= binWeightSums.col(bin);
+      totalLeftWeight += binWeightTotals[bin];
+      totalRightWeight -= binWeightTotals[bin];
+    }
+    else
+    {
+      leftCounts += binCounts.col(bin);
+      rightCounts -= binCounts.col(bin);
+    }
+    leftCount += binTotals[bin];
+    leftMax = binMaxs[bin];
+
+    const size_t rightCount = data.n_elem - leftCount;
+    if (leftCount < minimum)
+      continue;
+    if (rightCount < minimum)
+      break; // The right side only shrinks from here.
+
+    // Calculate the gain for the left and right child.  Only use weights if
+    // needed.
+    const double leftGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(leftWeightSums.memptr(),
+            numClasses, totalLeftWeight) :
+        FitnessFunction::template EvaluatePtr<false>(leftCounts.memptr(),
+            numClasses, leftCount);
+    const double rightGain = UseWeights ?
+        FitnessFunction::template EvaluatePtr<true>(rightWeightSums.memptr(),
+            numClasses, totalRightWeight) :
+        FitnessFunction::template EvaluatePtr<false>(rightCounts.memptr(),
+            numClasses, rightCount);
+
+    double gain;
+    if (UseWeights)
+    {
+      gain = totalLeftWeight * leftGain + totalRightWeight * rightGain;
+    }
+    else
+    {
+      // Calculate the gain at this boundary.
+      gain = double(leftCount) * leftGain + double(rightCount) * rightGain;
+    }
+
+    if (gain >= 0.0 || gain > bestFoundGain)
+    {
+      // The split threshold goes halfway between the largest value on the
+      // left and the smallest value in the next occupied bin, so that every
+      // observed value is classified consistently with the histogram.
+      size_t next = bin + 1;
+      while (binTotals[next] == 0)
+        ++next; // Guaranteed to terminate, since the right side is nonempty.
+
+      classProbabilities.set_size(1);
+      classProbabilities[0] = (leftMax + binMins[next]) / 2.0;
+
+      // Corner case: is this the best possible split?  If so, no split can be
+      // better, so just take this one.
+      if (gain >= 0.0)
+        return gain;
+
+      bestFoundGain = gain;
+      improved = true;
+    }
+  }
+
+  // If we didn't improve, return the original gain exactly as we got it
+  // (without introducing floating point errors).
+  if (!improved)
+    return DBL_MAX;
+
+  if (UseWeights)
+    bestFoundGain /= totalWeight;
+  else
+    bestFoundGain /= data.n_elem;
+
+  return bestFoundGain;
+}
+
+template<typename FitnessFunction>
+template<typename ElemType>
+size_t HistogramNumericSplit<FitnessFunction>::CalculateDirection(
+    const ElemType& point,
+    const arma::Col<ElemType>& classProbabilities,
+    const AuxiliarySplitInfo<ElemType>& /* aux */)
+{
+  if (point <= classProbabilities[0])
+    return 0; // Go left.
+  else
+    return 1; // Go right.
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
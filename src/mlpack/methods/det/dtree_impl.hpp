@@ -12,6 +12,7 @@
  * http://www.opensource.org/licenses/BSD-3-Clause for more information.
  */
 #include "dtree.hpp"
+#include <mlpack/core/util/parallel.hpp>
 #include <stack>
 #include <vector>
 
@@ -637,10 +638,34 @@ double DTree<MatType, TagType>::Grow(MatType& data,
       left = new DTree(maxValsL, minValsL, start, splitIndex, leftError);
       right = new DTree(maxValsR, minValsR, splitIndex, end, rightError);
 
-      leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize,
-                         minLeafSize);
-      rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize,
+      // After the split, the children cover disjoint contiguous column ranges
+      // of the shared dataset, and all of their work (including the column
+      // swaps of further splits) stays inside those ranges, so the two
+      // subtrees can be grown concurrently.  Sparse matrices share internal
+      // structure between columns and must be grown serially, as must nodes
+      // small enough that the task overhead would dominate.
+      if (!arma::is_arma_sparse_type<MatType>::value &&
+          (end - start) > 4 * maxLeafSize)
+      {
+        Parallel::Invoke(
+            [&]()
+            {
+              leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize,
+                                 minLeafSize);
+            },
+            [&]()
+            {
+              rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize,
+                                   minLeafSize);
+            });
+      }
+      else
+      {
+        leftG = left->Grow(data, oldFromNew, useVolReg, maxLeafSize,
                            minLeafSize);
+        rightG = right->Grow(data, oldFromNew, useVolReg, maxLeafSize,
+                             minLeafSize);
+      }
 
       // Store values of R(T~) and |T~|.
       subtreeLeaves = left->SubtreeLeaves() + right->SubtreeLeaves();
@@ -126,6 +126,40 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
   typedef DTBRules<MetricType, Tree> RuleType;
   RuleType rules(data, connections, neighborsDistances, neighborsInComponent,
                  neighborsOutComponent, metric);
+
+  #ifdef _OPENMP
+  // If more than one thread is available, each Boruvka round is run as
+  // concurrent traversals over disjoint query subtrees.  The tree structure
+  // does not change between rounds, so the subtree frontier is expanded only
+  // once, to several subtrees per thread for dynamic load balancing.
+  std::vector<Tree*> querySubtrees;
+  if (!naive && omp_get_max_threads() > 1)
+  {
+    querySubtrees.push_back(tree);
+    const size_t targetSubtrees = 8 * omp_get_max_threads();
+    bool expanded = true;
+    while (querySubtrees.size() < targetSubtrees && expanded)
+    {
+      expanded = false;
+      std::vector<Tree*> nextFrontier;
+      for (size_t i = 0; i < querySubtrees.size(); ++i)
+      {
+        if (querySubtrees[i]->NumChildren() > 0)
+        {
+          for (size_t c = 0; c < querySubtrees[i]->NumChildren(); ++c)
+            nextFrontier.push_back(&querySubtrees[i]->Child(c));
+          expanded = true;
+        }
+        else
+        {
+          nextFrontier.push_back(querySubtrees[i]);
+        }
+      }
+      querySubtrees = std::move(nextFrontier);
+    }
+  }
+  #endif
+
   while (edges.size() < (data.n_cols - 1))
   {
     if (naive)
@@ -135,6 +169,54 @@ void DualTreeBoruvka<MetricType, MatType, TreeType>::ComputeMST(
         for (size_t j = 0; j < data.n_cols; ++j)
           rules.BaseCase(i, j);
     }
+    #ifdef _OPENMP
+    else if (querySubtrees.size() > 1)
+    {
+      // Components do not change during a round, so flatten the union-find
+      // structure once; each thread then works on its own copy and candidate
+      // edge lists, which makes the traversals fully independent (the query
+      // subtree statistics written by CalculateBound() are disjoint as well).
+      for (size_t i = 0; i < data.n_cols; ++i)
+        connections.Find(i);
+
+      #pragma omp parallel
+      {
+        UnionFind threadConnections(connections);
+        arma::vec threadDistances(data.n_cols);
+        threadDistances.fill(DBL_MAX);
+        arma::Col<size_t> threadInComponent(data.n_cols);
+        arma::Col<size_t> threadOutComponent(data.n_cols);
+
+        RuleType threadRules(data, threadConnections, threadDistances,
+            threadInComponent, threadOutComponent, metric);
+        typename Tree::template DualTreeTraverser<RuleType>
+            threadTraverser(threadRules);
+
+        #pragma omp for schedule(dynamic)
+        for (omp_size_t i = 0; i < (omp_size_t) querySubtrees.size(); ++i)
+          threadTraverser.Traverse(*querySubtrees[i], *tree);
+
+        // Merge this thread's candidate edges into the shared per-component
+        // lists; a component's points may be spread over several subtrees,
+        // so the best candidate is the minimum over all threads.
+        #pragma omp critical (emstCandidates)
+        {
+          for (size_t c = 0; c < data.n_cols; ++c)
+          {
+            if (threadDistances[c] < neighborsDistances[c])
+            {
+              neighborsDistances[c] = threadDistances[c];
+              neighborsInComponent[c] = threadInComponent[c];
+              neighborsOutComponent[c] = threadOutComponent[c];
+            }
+          }
+
+          rules.BaseCases() += threadRules.BaseCases();
+          rules.Scores() += threadRules.Scores();
+        }
+      }
+    }
+    #endif
     else
     {
       typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
@@ -334,6 +334,26 @@ class FastMKS
   //! Use a priority queue to represent the list of candidate points.
   typedef std::priority_queue<Candidate, std::vector<Candidate>,
       CandidateCmp> CandidateList;
+
+  /**
+   * Perform brute-force max-kernel search of the query set against the
+   * reference set.  For kernels that are simple functions of the inner product
+   * (LinearKernel and CosineDistance), this evaluates whole blocks of queries
+   * at once with a single matrix multiplication instead of pair-by-pair
+   * kernel evaluations; for other kernels, the simple double loop is used.
+   *
+   * @param querySet Set of query points.
+   * @param k The number of maximum kernels to find.
+   * @param indices Matrix to store resulting indices of max-kernel search in.
+   * @param kernels Matrix to store resulting max-kernel values in.
+   * @param sameSet If true, the query set is the reference set, and a point
+   *      will not be returned as its own candidate.
+   */
+  void NaiveSearch(const MatType& querySet,
+                   const size_t k,
+                   arma::Mat<size_t>& indices,
+                   arma::mat& kernels,
+                   const bool sameSet);
 };
 
 } // namespace fastmks
@@ -18,10 +18,85 @@
 #include "fastmks_rules.hpp"
 
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
+#include <mlpack/core/kernels/linear_kernel.hpp>
+#include <mlpack/core/kernels/cosine_distance.hpp>
 
 namespace mlpack {
 namespace fastmks {
 
+/**
+ * The BlockKernelEvaluator is a helper used by naive-mode search to compute
+ * whole tiles of kernel values at once.  The generic version is not usable;
+ * specializations exist for kernels that are simple functions of the inner
+ * product, where a tile of evaluations reduces to a single matrix
+ * multiplication (handled by BLAS instead of one dot product per pair).
+ */
+template<typename KernelType>
+struct BlockKernelEvaluator
+{
+  //! In general, kernel values cannot be computed a tile at a time.
+  static const bool Usable = false;
+
+  //! This is never called; it only exists so the blocked code path compiles
+  //! for kernels without a specialization.
+  template<typename MatTypeA, typename MatTypeB>
+  static void Evaluate(const MatTypeA& /* referenceSet */,
+                       const MatTypeB& /* queryBlock */,
+                       arma::mat& /* values */)
+  { }
+};
+
+//! For the linear kernel, a tile of kernel values is just a matrix product.
+template<>
+struct BlockKernelEvaluator<kernel::LinearKernel>
+{
+  static const bool Usable = true;
+
+  template<typename MatTypeA, typename MatTypeB>
+  static void Evaluate(const MatTypeA& referenceSet,
+                       const MatTypeB& queryBlock,
+                       arma::mat& values)
+  {
+    values = arma::mat(arma::trans(referenceSet) * queryBlock);
+  }
+};
+
+//! The cosine distance is the linear kernel with normalized arguments, so a
+//! tile is a matrix product followed by a row and a column scaling.
+template<>
+struct BlockKernelEvaluator<kernel::CosineDistance>
+{
+  static const bool Usable = true;
+
+  template<typename MatTypeA, typename MatTypeB>
+  static void Evaluate(const MatTypeA& referenceSet,
+                       const MatTypeB& queryBlock,
+                       arma::mat& values)
+  {
+    values = arma::mat(arma::trans(referenceSet) * queryBlock);
+
+    // Guard against zero norms the same way CosineDistance::Evaluate() does:
+    // if either norm is zero, the dot product is zero too, so dividing by 1
+    // leaves the correct value of 0.
+    arma::vec referenceNorms(referenceSet.n_cols);
+    for (size_t r = 0; r < referenceSet.n_cols; ++r)
+    {
+      const double norm = arma::norm(referenceSet.col(r), 2);
+      referenceNorms[r] = (norm == 0.0) ? 1.0 : norm;
+    }
+
+    arma::rowvec queryNorms(queryBlock.n_cols);
+    for (size_t q = 0; q < queryBlock.n_cols; ++q)
+    {
+      const double norm = arma::norm(queryBlock.col(q), 2);
+      queryNorms[q] = (norm == 0.0) ? 1.0 : norm;
+    }
+
+    values.each_col() /= referenceNorms;
+    values.each_row() /= queryNorms;
+  }
+};
+
 // No data; create a model on an empty dataset.
 template<typename KernelType,
          typename MatType,
@@ -426,33 +501,7 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < querySet.n_cols; ++q)
-    {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
-
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
-      {
-        const double eval = metric.Kernel().Evaluate(querySet.col(q),
-                                                     referenceSet->col(r));
-
-        if (eval > pqueue.top().first)
-        {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
-        }
-      }
-
-      for (size_t j = 1; j <= k; ++j)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
-      }
-    }
+    NaiveSearch(querySet, k, indices, kernels, false);
 
     Timer::Stop("computing_products");
 
@@ -563,36 +612,7 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   // Naive implementation.
   if (naive)
   {
-    // Simple double loop.  Stupid, slow, but a good benchmark.
-    for (size_t q = 0; q < referenceSet->n_cols; ++q)
-    {
-      const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
-      std::vector<Candidate> cList(k, def);
-      CandidateList pqueue(CandidateCmp(), std::move(cList));
-
-      for (size_t r = 0; r < referenceSet->n_cols; ++r)
-      {
-        if (q == r)
-          continue; // Don't return the point as its own candidate.
-
-        const double eval = metric.Kernel().Evaluate(referenceSet->col(q),
-                                                     referenceSet->col(r));
-
-        if (eval > pqueue.top().first)
-        {
-          Candidate c = std::make_pair(eval, r);
-          pqueue.pop();
-          pqueue.push(c);
-        }
-      }
-
-      for (size_t j = 1; j <= k; ++j)
-      {
-        indices(k - j, q) = pqueue.top().second;
-        kernels(k - j, q) = pqueue.top().first;
-        pqueue.pop();
-      }
-    }
+    NaiveSearch(*referenceSet, k, indices, kernels, true);
 
     Timer::Stop("computing_products");
 
@@ -632,6 +652,101 @@ void FastMKS<KernelType, MatType, TreeType>::Search(
   Search(referenceTree, k, indices, kernels);
 }
 
+template<typename KernelType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void FastMKS<KernelType, MatType, TreeType>::NaiveSearch(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& indices,
+    arma::mat& kernels,
+    const bool sameSet)
+{
+  if (BlockKernelEvaluator<KernelType>::Usable)
+  {
+    // Tile the query set, evaluating each tile of kernel values with a single
+    // matrix multiplication and then scanning every column for its k largest
+    // values.  Cap the block size so that a tile of kernel values stays around
+    // 8 MB no matter how large the reference set is.
+    const size_t blockSize = std::max((size_t) 1,
+        (size_t) (1 << 20) / referenceSet->n_cols);
+
+    arma::mat values;
+    for (size_t begin = 0; begin < querySet.n_cols; begin += blockSize)
+    {
+      const size_t blockEnd = std::min(querySet.n_cols, begin + blockSize) - 1;
+      const MatType queryBlock(querySet.cols(begin, blockEnd));
+
+      BlockKernelEvaluator<KernelType>::Evaluate(*referenceSet, queryBlock,
+          values);
+
+      for (size_t q = begin; q <= blockEnd; ++q)
+      {
+        const double* evals = values.colptr(q - begin);
+
+        const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+        std::vector<Candidate> cList(k, def);
+        CandidateList pqueue(CandidateCmp(), std::move(cList));
+
+        for (size_t r = 0; r < referenceSet->n_cols; ++r)
+        {
+          if (sameSet && q == r)
+            continue; // Don't return the point as its own candidate.
+
+          if (evals[r] > pqueue.top().first)
+          {
+            Candidate c = std::make_pair(evals[r], r);
+            pqueue.pop();
+            pqueue.push(c);
+          }
+        }
+
+        for (size_t j = 1; j <= k; ++j)
+        {
+          indices(k - j, q) = pqueue.top().second;
+          kernels(k - j, q) = pqueue.top().first;
+          pqueue.pop();
+        }
+      }
+    }
+
+    return;
+  }
+
+  // Simple double loop.  Stupid, slow, but a good benchmark.
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    const Candidate def = std::make_pair(-DBL_MAX, size_t() - 1);
+    std::vector<Candidate> cList(k, def);
+    CandidateList pqueue(CandidateCmp(), std::move(cList));
+
+    for (size_t r = 0; r < referenceSet->n_cols; ++r)
+    {
+      if (sameSet && q == r)
+        continue; // Don't return the point as its own candidate.
+
+      const double eval = metric.Kernel().Evaluate(querySet.col(q),
+                                                   referenceSet->col(r));
+
+      if (eval > pqueue.top().first)
+      {
+        Candidate c = std::make_pair(eval, r);
+        pqueue.pop();
+        pqueue.push(c);
+      }
+    }
+
+    for (size_t j = 1; j <= k; ++j)
+    {
+      indices(k - j, q) = pqueue.top().second;
+      kernels(k - j, q) = pqueue.top().first;
+      pqueue.pop();
+    }
+  }
+}
+
 //! Serialize the model.
 template<typename KernelType,
          typename MatType,
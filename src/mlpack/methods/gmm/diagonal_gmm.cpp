@@ -12,6 +12,7 @@
 
 #include "diagonal_gmm.hpp"
 #include <mlpack/core/math/log_add.hpp>
+#include <mlpack/core/util/parallel.hpp>
 
 namespace mlpack {
 namespace gmm {
@@ -75,6 +76,25 @@ double DiagonalGMM::Probability(const arma::vec& observation) const
   return exp(LogProbability(observation));
 }
 
+/**
+ * Return the log probability of every given observation being from this GMM.
+ */
+void DiagonalGMM::LogProbability(const arma::mat& observation,
+                                 arma::vec& logProbs) const
+{
+  BlockLogProbability(observation, dists, weights, logProbs);
+}
+
+/**
+ * Return the probability of every given observation being from this GMM.
+ */
+void DiagonalGMM::Probability(const arma::mat& observation,
+                              arma::vec& probs) const
+{
+  LogProbability(observation, probs);
+  probs = arma::exp(probs);
+}
+
 /**
  * Return the log probability of the given observation being from the given
  * component in the mixture.
@@ -159,27 +179,101 @@ double DiagonalGMM::LogLikelihood(
     const std::vector<distribution::DiagonalGaussianDistribution>& dists,
     const arma::vec& weights) const
 {
-  double logLikelihood = 0;
-  arma::vec phis;
-  arma::mat likelihoods(gaussians, observations.n_cols);
+  arma::vec logProbs;
+  BlockLogProbability(observations, dists, weights, logProbs);
 
-  for (size_t i = 0; i < gaussians; ++i)
-  {
-    dists[i].Probability(observations, phis);
-    likelihoods.row(i) = weights(i) * trans(phis);
-  }
-
-  // Now sum over every point.
+  double logLikelihood = 0;
   for (size_t j = 0; j < observations.n_cols; ++j)
   {
-    if (accu(likelihoods.col(j)) == 0)
+    if (logProbs[j] == -std::numeric_limits<double>::infinity())
       Log::Info << "Likelihood of point " << j << " is 0!  It is probably an "
           << "outlier." << std::endl;
-    logLikelihood += log(accu(likelihoods.col(j)));
+    logLikelihood += logProbs[j];
   }
 
   return logLikelihood;
 }
 
+/**
+ * Compute the mixture log probability of every observation against the given
+ * components.
+ */
+void DiagonalGMM::BlockLogProbability(
+    const arma::mat& observations,
+    const std::vector<distribution::DiagonalGaussianDistribution>& dists,
+    const arma::vec& weights,
+    arma::vec& logProbs)
+{
+  const size_t gaussians = dists.size();
+  const size_t dims = observations.n_rows;
+
+  // Gather the component parameters into contiguous matrices so the scoring
+  // loops below walk straight down columns.  The per-component constant folds
+  // the mixture weight, the normalization term, and the log-determinant, so
+  // the inner loop is left with nothing but the quadratic form.
+  arma::mat means(dims, gaussians);
+  arma::mat invCovs(dims, gaussians);
+  arma::vec constants(gaussians);
+  const double log2pi = std::log(2.0 * M_PI);
+  for (size_t i = 0; i < gaussians; ++i)
+  {
+    means.col(i) = dists[i].Mean();
+    invCovs.col(i) = dists[i].InvCov();
+    constants[i] = std::log(weights[i]) -
+        0.5 * dims * log2pi - 0.5 * dists[i].LogDetCov();
+  }
+
+  logProbs.set_size(observations.n_cols);
+
+  // Score the points in blocks distributed across threads.  Each point's
+  // component densities are folded into the mixture total with a streaming
+  // log-sum-exp, so no components-by-points matrix is ever materialized.
+  const size_t blockSize = 256;
+  Parallel::For(0, observations.n_cols, blockSize,
+      [&](const size_t blockBegin, const size_t blockEnd)
+      {
+        for (size_t j = blockBegin; j < blockEnd; ++j)
+        {
+          const double* x = observations.colptr(j);
+
+          double maxLogProb = -std::numeric_limits<double>::infinity();
+          double sumExp = 0.0;
+          for (size_t i = 0; i < gaussians; ++i)
+          {
+            const double* mu = means.colptr(i);
+            const double* ic = invCovs.colptr(i);
+
+            // The quadratic form is a fused multiply-add over the precomputed
+            // inverse variances; this loop is the hot spot and vectorizes.
+            double quadForm = 0.0;
+            for (size_t d = 0; d < dims; ++d)
+            {
+              const double diff = x[d] - mu[d];
+              quadForm += diff * diff * ic[d];
+            }
+
+            const double logProb = constants[i] - 0.5 * quadForm;
+
+            // Streaming log-sum-exp: rescale the running sum when a new
+            // maximum appears instead of making a second pass.
+            if (logProb == -std::numeric_limits<double>::infinity())
+              continue;
+            else if (logProb > maxLogProb)
+            {
+              sumExp = sumExp * std::exp(maxLogProb - logProb) + 1.0;
+              maxLogProb = logProb;
+            }
+            else
+            {
+              sumExp += std::exp(logProb - maxLogProb);
+            }
+          }
+
+          logProbs[j] = (sumExp > 0.0) ? maxLogProb + std::log(sumExp) :
+              -std::numeric_limits<double>::infinity();
+        }
+      });
+}
+
 } // namespace gmm
 } // namespace mlpack
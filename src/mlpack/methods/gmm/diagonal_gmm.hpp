@@ -174,6 +174,29 @@ class DiagonalGMM
    */
   double LogProbability(const arma::vec& observation) const;
 
+  /**
+   * Return the probability that each of the given observations (one per
+   * column) came from this distribution.  This is far faster than calling the
+   * single-observation overload once per point: the points are scored in
+   * blocks with a fused kernel over the components' precomputed inverse
+   * variances, and the blocks are distributed across threads.
+   *
+   * @param observation Matrix of observations.
+   * @param probs Output vector of probabilities, one per observation.
+   */
+  void Probability(const arma::mat& observation, arma::vec& probs) const;
+
+  /**
+   * Return the log probability that each of the given observations (one per
+   * column) came from this distribution.  This is far faster than calling the
+   * single-observation overload once per point; see Probability().
+   *
+   * @param observation Matrix of observations.
+   * @param logProbs Output vector of log probabilities, one per observation.
+   */
+  void LogProbability(const arma::mat& observation,
+                      arma::vec& logProbs) const;
+
   /**
    * Return the probability that the given observation came from the given
    * Gaussian component in this distribution.
@@ -303,6 +326,25 @@ class DiagonalGMM
       const arma::mat& observations,
       const std::vector<distribution::DiagonalGaussianDistribution>& dists,
       const arma::vec& weights) const;
+
+  /**
+   * Compute the mixture log probability of every observation (column) against
+   * the given components.  This is the batch scoring kernel backing
+   * LogProbability() and LogLikelihood(): the per-component densities of a
+   * block of points are evaluated with fused multiply-add loops over the
+   * precomputed inverse variances, folded into the mixture total with a
+   * streaming log-sum-exp, and the blocks are distributed across threads.
+   *
+   * @param observations Matrix of observations.
+   * @param dists Components of the given mixture model.
+   * @param weights Weights of the given mixture model.
+   * @param logProbs Output vector of log probabilities, one per observation.
+   */
+  static void BlockLogProbability(
+      const arma::mat& observations,
+      const std::vector<distribution::DiagonalGaussianDistribution>& dists,
+      const arma::vec& weights,
+      arma::vec& logProbs);
 };
 
 } // namespace gmm
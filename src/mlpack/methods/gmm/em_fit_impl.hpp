@@ -87,8 +87,11 @@ Estimate(const arma::mat& observations,
         << "log-likelihood " << l << "." << std::endl;
 
     // Calculate the conditional probabilities of choosing a particular
-    // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
+    // Gaussian given the observations and the present theta value.  Each
+    // component writes its own column, so the components are evaluated
+    // concurrently.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Store conditional log probabilities into condLogProb vector for each
       // Gaussian.  First we make an alias of the condLogProb vector.
@@ -115,8 +118,10 @@ Estimate(const arma::mat& observations,
     }
 
     // Calculate the new value of the means using the updated conditional
-    // probabilities.
-    for (size_t i = 0; i < dists.size(); ++i)
+    // probabilities.  The components touch disjoint state, so they are all
+    // fit concurrently.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Don't update if there's no probability of the Gaussian having points.
       if (probRowSums[i] != -std::numeric_limits<double>::infinity())
@@ -193,7 +198,8 @@ Estimate(const arma::mat& observations,
   {
     // Calculate the conditional probabilities of choosing a particular
     // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Store conditional log probabilities into condLogProb vector for each
       // Gaussian.  First we make an alias of the condLogProb vector.
@@ -219,7 +225,10 @@ Estimate(const arma::mat& observations,
     // Calculate the new value of the means using the updated conditional
     // probabilities.
     arma::vec logProbabilities = arma::log(probabilities);
-    for (size_t i = 0; i < dists.size(); ++i)
+
+    // The components touch disjoint state, so they are all fit concurrently.
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
     {
       // Calculate the sum of probabilities of points, which is the
       // conditional probability of each point being from Gaussian i
@@ -74,6 +74,39 @@ double GMM::Probability(const arma::vec& observation) const
   return exp(LogProbability(observation));
 }
 
+/**
+ * Return the log probability of each observation (column) of the given matrix
+ * being from this GMM.
+ */
+void GMM::LogProbability(const arma::mat& observation,
+                         arma::vec& logProbs) const
+{
+  // Compute the log probability of every observation under each component
+  // with one batched call per component, then combine the components in
+  // log-space.  This is far faster than one virtual call per observation.
+  arma::mat componentLogProbs(gaussians, observation.n_cols);
+  arma::vec tmp;
+  for (size_t i = 0; i < gaussians; ++i)
+  {
+    dists[i].LogProbability(observation, tmp);
+    componentLogProbs.row(i) = tmp.t() + std::log(weights[i]);
+  }
+
+  logProbs.set_size(observation.n_cols);
+  for (size_t j = 0; j < observation.n_cols; ++j)
+    logProbs[j] = math::AccuLog(componentLogProbs.unsafe_col(j));
+}
+
+/**
+ * Return the probability of each observation (column) of the given matrix
+ * being from this GMM.
+ */
+void GMM::Probability(const arma::mat& observation, arma::vec& probs) const
+{
+  LogProbability(observation, probs);
+  probs = exp(probs);
+}
+
 /**
  * Return the log probability of the given observation being from the given
  * component in the mixture.
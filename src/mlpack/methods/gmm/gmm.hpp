@@ -172,6 +172,26 @@ class GMM
    */
   double LogProbability(const arma::vec& observation) const;
 
+  /**
+   * Return the probability that each observation (column) of the given matrix
+   * came from this distribution.  This is significantly faster than one
+   * Probability() call per observation.
+   *
+   * @param observation List of observations.
+   * @param probs Output probabilities for each observation.
+   */
+  void Probability(const arma::mat& observation, arma::vec& probs) const;
+
+  /**
+   * Return the log probability that each observation (column) of the given
+   * matrix came from this distribution.  This is significantly faster than
+   * one LogProbability() call per observation.
+   *
+   * @param observation List of observations.
+   * @param logProbs Output log-probabilities for each observation.
+   */
+  void LogProbability(const arma::mat& observation, arma::vec& logProbs) const;
+
   /**
    * Return the probability that the given observation came from the given
    * Gaussian component in this distribution.
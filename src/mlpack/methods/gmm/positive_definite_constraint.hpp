@@ -39,9 +39,27 @@ class PositiveDefiniteConstraint
     // that the condition number isn't too large.  We also need to ensure that
     // the covariance matrix is not too close to zero (hence, we ensure that all
     // eigenvalues are at least 1e-50).
+    covariance = arma::symmatu(covariance);
+
+    // Fast path: inside an EM loop this is called on every iteration, and a
+    // healthy covariance matrix can be certified with a single Cholesky
+    // factorization, which is far cheaper than the eigendecomposition below.
+    // The induced 1-norm bounds the largest eigenvalue from above for a
+    // symmetric matrix, so if the matrix stays positive definite after
+    // shifting the diagonal down by norm / 1e5 (at least 1e-50), then the
+    // smallest eigenvalue exceeds the shift and every constraint checked
+    // below already holds: the repair would not change the matrix.
+    const double largestEigvalBound = arma::norm(covariance, 1);
+    const double testShift = std::max(largestEigvalBound / 1e5, 1e-50);
+    arma::mat shifted(covariance);
+    shifted.diag() -= testShift;
+
+    arma::mat cholFactor;
+    if (arma::chol(cholFactor, shifted))
+      return;
+
     arma::vec eigval;
     arma::mat eigvec;
-    covariance = arma::symmatu(covariance);
     if (!arma::eig_sym(eigval, eigvec, covariance))
     {
       Log::Fatal << "applying to constraint could not be accomplished."
@@ -0,0 +1,143 @@
+/**
+ * @file methods/gmm/streaming_em.hpp
+ * @author Ryan Curtin
+ *
+ * Utility class to fit a GMM incrementally from a stream of mini-batches
+ * using stepwise (online) EM.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_STREAMING_EM_HPP
+#define MLPACK_METHODS_GMM_STREAMING_EM_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "gmm.hpp"
+// Default covariance matrix constraint.
+#include "positive_definite_constraint.hpp"
+
+namespace mlpack {
+namespace gmm {
+
+/**
+ * This class incrementally fits a GMM to a stream of observation mini-batches
+ * using the stepwise EM algorithm of Cappé and Moulines.  Unlike
+ * EMFit::Estimate(), it never needs the full observation history in memory:
+ * it maintains decaying sufficient statistics (per-component responsibility
+ * mass, weighted observation sums, and weighted second moments), blends each
+ * mini-batch's statistics in with a decaying step size, and re-derives the
+ * model parameters after every batch.  Each call to Step() costs one E-step
+ * over the batch plus one closed-form M-step, so the model stays current as
+ * data arrives.
+ *
+ * @code
+ * @article{cappe2009line,
+ *     title={{On-line Expectation-Maximization Algorithm for Latent Data
+ *         Models}},
+ *     author={Capp{\'e}, O. and Moulines, E.},
+ *     year={2009},
+ *     journal={Journal of the Royal Statistical Society: Series B}
+ * }
+ * @endcode
+ *
+ * The step size of the t-th batch is (t + delay)^(-stepExponent), with
+ * stepExponent in (0.5, 1]; smaller exponents adapt faster, larger exponents
+ * average longer.  The first batch initializes the statistics outright, so
+ * the GMM passed to Step() only needs reasonable initial parameters (for
+ * instance from a conventional GMM::Train() on the first chunk of data, or a
+ * hand-built initialization).
+ *
+ * @tparam CovarianceConstraintPolicy Policy for constraining covariance
+ *     matrices (by default, ensure positive definiteness).
+ */
+template<typename CovarianceConstraintPolicy = PositiveDefiniteConstraint>
+class StreamingEM
+{
+ public:
+  /**
+   * Construct the StreamingEM object, optionally setting the decay schedule
+   * and the covariance constraint policy.
+   *
+   * @param stepExponent Exponent of the decaying step size; must be in
+   *     (0.5, 1] for the stepwise EM estimates to converge.
+   * @param delay Additive delay of the step size schedule; larger values
+   *     downweight the earliest batches less aggressively.
+   * @param constraint Covariance constraint policy object.
+   */
+  StreamingEM(const double stepExponent = 0.7,
+              const double delay = 2.0,
+              const CovarianceConstraintPolicy& constraint =
+                  CovarianceConstraintPolicy());
+
+  /**
+   * Consume one mini-batch of observations and update the given GMM.  On the
+   * first call the sufficient statistics are initialized from the batch,
+   * using the GMM's current parameters for the responsibilities; later calls
+   * blend the batch's statistics in with the decaying step size and refit the
+   * GMM's weights, means, and covariances from the blended statistics.
+   *
+   * The GMM must have at least one component and its dimensionality must
+   * match the batch; otherwise a std::invalid_argument exception is thrown.
+   *
+   * @param batch Mini-batch of observations (one column per observation).
+   * @param gmm Model to update in place.
+   * @return The log-likelihood of the batch under the model as it was before
+   *     the update.
+   */
+  double Step(const arma::mat& batch, GMM& gmm);
+
+  /**
+   * Discard the accumulated sufficient statistics, so that the next call to
+   * Step() starts a fresh stream.
+   */
+  void Reset();
+
+  //! Get the step size exponent.
+  double StepExponent() const { return stepExponent; }
+  //! Modify the step size exponent.
+  double& StepExponent() { return stepExponent; }
+
+  //! Get the step size delay.
+  double Delay() const { return delay; }
+  //! Modify the step size delay.
+  double& Delay() { return delay; }
+
+  //! Get the covariance constraint policy.
+  const CovarianceConstraintPolicy& Constraint() const { return constraint; }
+  //! Modify the covariance constraint policy.
+  CovarianceConstraintPolicy& Constraint() { return constraint; }
+
+  //! Get the number of mini-batches consumed so far.
+  size_t NumSteps() const { return numSteps; }
+
+  //! Serialize the stepwise EM state.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! Exponent of the decaying step size.
+  double stepExponent;
+  //! Additive delay of the step size schedule.
+  double delay;
+  //! Covariance constraint policy.
+  CovarianceConstraintPolicy constraint;
+
+  //! The number of mini-batches consumed so far.
+  size_t numSteps;
+  //! Decayed responsibility mass of each component.
+  arma::vec weightStats;
+  //! Decayed weighted observation sums (one column per component).
+  arma::mat meanStats;
+  //! Decayed weighted second moments (one slice per component).
+  arma::cube covStats;
+};
+
+} // namespace gmm
+} // namespace mlpack
+
+// Include implementation.
+#include "streaming_em_impl.hpp"
+
+#endif
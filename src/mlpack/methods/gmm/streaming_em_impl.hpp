@@ -0,0 +1,163 @@
+/**
+ * @file methods/gmm/streaming_em_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of stepwise (online) EM for incremental GMM fitting.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_GMM_STREAMING_EM_IMPL_HPP
+#define MLPACK_METHODS_GMM_STREAMING_EM_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "streaming_em.hpp"
+#include <mlpack/core/math/log_add.hpp>
+
+namespace mlpack {
+namespace gmm {
+
+//! Constructor.
+template<typename CovarianceConstraintPolicy>
+StreamingEM<CovarianceConstraintPolicy>::StreamingEM(
+    const double stepExponent,
+    const double delay,
+    const CovarianceConstraintPolicy& constraint) :
+    stepExponent(stepExponent),
+    delay(delay),
+    constraint(constraint),
+    numSteps(0)
+{ /* Nothing to do. */ }
+
+template<typename CovarianceConstraintPolicy>
+double StreamingEM<CovarianceConstraintPolicy>::Step(const arma::mat& batch,
+                                                     GMM& gmm)
+{
+  if (gmm.Gaussians() == 0)
+  {
+    throw std::invalid_argument("StreamingEM::Step(): GMM has no "
+        "components!");
+  }
+  if (batch.n_rows != gmm.Dimensionality())
+  {
+    throw std::invalid_argument("StreamingEM::Step(): batch dimensionality "
+        "does not match the GMM!");
+  }
+  if (batch.n_cols == 0)
+    return 0.0;
+
+  const size_t gaussians = gmm.Gaussians();
+  const size_t dims = gmm.Dimensionality();
+
+  // E-step: calculate the conditional log probabilities of choosing a
+  // particular Gaussian given the observations and the current parameters,
+  // exactly as EMFit::Estimate() does.
+  arma::mat condLogProb(batch.n_cols, gaussians);
+  for (size_t i = 0; i < gaussians; ++i)
+  {
+    arma::vec condLogProbAlias = condLogProb.unsafe_col(i);
+    gmm.Component(i).LogProbability(batch, condLogProbAlias);
+    condLogProbAlias += log(gmm.Weights()[i]);
+  }
+
+  // Normalize row-wise, accumulating the batch log-likelihood from the
+  // normalizers.
+  double logLikelihood = 0.0;
+  for (size_t i = 0; i < condLogProb.n_rows; ++i)
+  {
+    // Avoid dividing by zero; if the probability for everything is 0, we
+    // don't want to make it NaN.
+    const double probSum = mlpack::math::AccuLog(condLogProb.row(i));
+    if (probSum != -std::numeric_limits<double>::infinity())
+    {
+      logLikelihood += probSum;
+      condLogProb.row(i) -= probSum;
+    }
+  }
+
+  // Compute the batch's sufficient statistics, normalized by the batch size:
+  // the responsibility mass, the responsibility-weighted observation sums,
+  // and the responsibility-weighted second moments of each component.  Raw
+  // second moments are stored instead of centered covariances so that
+  // statistics from different batches can be blended linearly.
+  arma::vec batchWeights(gaussians);
+  arma::mat batchMeans(dims, gaussians);
+  arma::cube batchCovs(dims, dims, gaussians);
+  for (size_t i = 0; i < gaussians; ++i)
+  {
+    const arma::vec prob = arma::exp(condLogProb.col(i));
+    batchWeights[i] = arma::accu(prob) / batch.n_cols;
+    batchMeans.col(i) = batch * prob / batch.n_cols;
+
+    const arma::mat tmp = batch.each_row() % trans(prob);
+    batchCovs.slice(i) = batch * trans(tmp) / batch.n_cols;
+  }
+
+  // Blend the batch statistics into the decayed running statistics.  The
+  // first batch initializes the statistics outright.
+  if (numSteps == 0)
+  {
+    weightStats = batchWeights;
+    meanStats = batchMeans;
+    covStats = batchCovs;
+  }
+  else
+  {
+    const double stepSize = std::pow((double) numSteps + delay, -stepExponent);
+    weightStats = (1.0 - stepSize) * weightStats + stepSize * batchWeights;
+    meanStats = (1.0 - stepSize) * meanStats + stepSize * batchMeans;
+    covStats = (1.0 - stepSize) * covStats + stepSize * batchCovs;
+  }
+  ++numSteps;
+
+  // M-step: re-derive the model parameters from the blended statistics.
+  for (size_t i = 0; i < gaussians; ++i)
+  {
+    // Don't update a component with no responsibility mass.
+    if (weightStats[i] <= 0.0)
+      continue;
+
+    gmm.Component(i).Mean() = meanStats.col(i) / weightStats[i];
+
+    arma::mat covariance = covStats.slice(i) / weightStats[i] -
+        gmm.Component(i).Mean() * trans(gmm.Component(i).Mean());
+
+    // Apply covariance constraint.
+    constraint.ApplyConstraint(covariance);
+    gmm.Component(i).Covariance(std::move(covariance));
+  }
+
+  gmm.Weights() = weightStats / arma::accu(weightStats);
+
+  return logLikelihood;
+}
+
+template<typename CovarianceConstraintPolicy>
+void StreamingEM<CovarianceConstraintPolicy>::Reset()
+{
+  numSteps = 0;
+  weightStats.reset();
+  meanStats.reset();
+  covStats.reset();
+}
+
+template<typename CovarianceConstraintPolicy>
+template<typename Archive>
+void StreamingEM<CovarianceConstraintPolicy>::serialize(
+    Archive& ar, const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(stepExponent);
+  ar & BOOST_SERIALIZATION_NVP(delay);
+  ar & BOOST_SERIALIZATION_NVP(constraint);
+  ar & BOOST_SERIALIZATION_NVP(numSteps);
+  ar & BOOST_SERIALIZATION_NVP(weightStats);
+  ar & BOOST_SERIALIZATION_NVP(meanStats);
+  ar & BOOST_SERIALIZATION_NVP(covStats);
+}
+
+} // namespace gmm
+} // namespace mlpack
+
+#endif
@@ -282,6 +282,24 @@ class HMM
   double Predict(const arma::mat& dataSeq,
                  arma::Row<size_t>& stateSeq) const;
 
+  /**
+   * Compute the most probable hidden state sequence for each of the given
+   * data sequences, using the Viterbi algorithm.  This is equivalent to (but
+   * faster than) calling Predict() on each sequence in turn: independent
+   * sequences are decoded across threads, and each thread reuses its dynamic
+   * programming workspaces between sequences instead of reallocating them for
+   * every call.
+   *
+   * @param dataSeq Vector of observation sequences.
+   * @param stateSeq Vector in which the most probable state sequence for each
+   *    observation sequence will be stored.
+   * @param logLikelihood Vector in which the log-likelihood of the most
+   *    probable state sequence of each observation sequence will be stored.
+   */
+  void Predict(const std::vector<arma::mat>& dataSeq,
+               std::vector<arma::Row<size_t>>& stateSeq,
+               arma::vec& logLikelihood) const;
+
   /**
    * Compute the log-likelihood of the given data sequence.
    *
@@ -306,6 +324,21 @@ class HMM
               arma::mat& filterSeq,
               size_t ahead = 0) const;
 
+  /**
+   * HMM filtering of a batch of sequences.  This is equivalent to calling
+   * Filter() on each sequence in turn, but independent sequences are
+   * processed across threads and each thread reuses its forward-algorithm
+   * workspaces between sequences.
+   *
+   * @param dataSeq Vector of observation sequences.
+   * @param filterSeq Vector in which the expected emission sequence for each
+   *    observation sequence will be stored.
+   * @param ahead Number of steps ahead (k) for expectations.
+   */
+  void Filter(const std::vector<arma::mat>& dataSeq,
+              std::vector<arma::mat>& filterSeq,
+              size_t ahead = 0) const;
+
   /**
    * HMM smoothing. Computes expected emission at each time conditioned on all
    * observations. That is
@@ -399,6 +432,83 @@ class HMM
                 const arma::vec& logScales,
                 arma::mat& backwardLogProb) const;
 
+  /**
+   * Compute the matrix of emission log-probabilities for the given data
+   * sequence: emissionLogProb(state, t) is the log-probability of the t'th
+   * observation under the emission distribution of the given state.  Each row
+   * is filled with one batched call into the emission distribution, so the
+   * forward-backward recursions can index this matrix instead of making one
+   * distribution call per state per time step.
+   *
+   * @param dataSeq Data sequence to compute emission probabilities for.
+   * @param emissionLogProb Matrix in which emission log-probabilities will be
+   *    saved.
+   */
+  void EmissionLogProbability(const arma::mat& dataSeq,
+                              arma::mat& emissionLogProb) const;
+
+  /**
+   * The forward recursion, operating on a precomputed emission
+   * log-probability matrix (as computed by EmissionLogProbability()).
+   *
+   * @param emissionLogProb Emission log-probabilities of the data sequence.
+   * @param logScales Vector in which scaling factors will be saved.
+   * @param forwardLogProb Matrix in which forward probabilities will be saved.
+   */
+  void ForwardFromEmissions(const arma::mat& emissionLogProb,
+                            arma::vec& logScales,
+                            arma::mat& forwardLogProb) const;
+
+  /**
+   * The backward recursion, operating on a precomputed emission
+   * log-probability matrix (as computed by EmissionLogProbability()).
+   *
+   * @param emissionLogProb Emission log-probabilities of the data sequence.
+   * @param logScales Vector of scaling factors.
+   * @param backwardLogProb Matrix in which backward probabilities will be
+   *    saved.
+   */
+  void BackwardFromEmissions(const arma::mat& emissionLogProb,
+                             const arma::vec& logScales,
+                             arma::mat& backwardLogProb) const;
+
+  /**
+   * Viterbi decoding of a single sequence, using caller-provided workspace
+   * matrices so that batched decoding can reuse them across sequences.  The
+   * caller is responsible for calling ConvertToLogSpace() beforehand.
+   *
+   * @param dataSeq Sequence of observations.
+   * @param stateSeq Vector in which the most probable state sequence will be
+   *    stored.
+   * @param logStateProb Workspace for the state log-probability matrix.
+   * @param stateSeqBack Workspace for the backpointer matrix.
+   * @param scores Workspace for the per-step max-plus scores.
+   * @return Log-likelihood of most probable state sequence.
+   */
+  double PredictViterbi(const arma::mat& dataSeq,
+                        arma::Row<size_t>& stateSeq,
+                        arma::mat& logStateProb,
+                        arma::mat& stateSeqBack,
+                        arma::mat& scores) const;
+
+  /**
+   * Filtering of a single sequence, using caller-provided workspaces for the
+   * forward algorithm so that batched filtering can reuse them across
+   * sequences.
+   *
+   * @param dataSeq Sequence of observations.
+   * @param filterSeq Matrix in which the expected emission sequence will be
+   *    stored.
+   * @param ahead Number of steps ahead (k) for expectations.
+   * @param logScales Workspace for the scaling factors.
+   * @param forwardLogProb Workspace for the forward log-probability matrix.
+   */
+  void FilterSequence(const arma::mat& dataSeq,
+                      arma::mat& filterSeq,
+                      const size_t ahead,
+                      arma::vec& logScales,
+                      arma::mat& forwardLogProb) const;
+
   //! Set of emission probability distributions; one for each state.
   std::vector<Distribution> emission;
 
@@ -101,10 +101,15 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
   // Maximum iterations?
   size_t iterations = 1000;
 
-  // Find length of all sequences and ensure they are the correct size.
+  // Find length of all sequences and ensure they are the correct size.  The
+  // offset of each sequence in the emission list is also recorded, so that the
+  // parallel E-step below can write each sequence's results into a disjoint
+  // column range.
+  std::vector<size_t> seqOffsets(dataSeq.size());
   size_t totalLength = 0;
   for (size_t seq = 0; seq < dataSeq.size(); seq++)
   {
+    seqOffsets[seq] = totalLength;
     totalLength += dataSeq[seq].n_cols;
 
     if (dataSeq[seq].n_rows != dimensionality)
@@ -133,53 +138,85 @@ double HMM<Distribution>::Train(const std::vector<arma::mat>& dataSeq)
     // Reset log likelihood.
     loglik = 0;
 
-    // Sum over time.
-    size_t sumTime = 0;
-
-    // Loop over each sequence.
-    for (size_t seq = 0; seq < dataSeq.size(); seq++)
+    // The sequences are independent, so the E-step is distributed across an
+    // OpenMP team: each thread accumulates into its own log-space initial and
+    // transition accumulators, which are merged once all sequences have been
+    // processed.  Each sequence's emission observations and probabilities are
+    // written into the disjoint column range given by its offset.
+    #pragma omp parallel
     {
-      arma::mat stateLogProb;
-      arma::mat forwardLog;
-      arma::mat backwardLog;
-      arma::vec logScales;
-
-      // Add the log-likelihood of this sequence.  This is the E-step.
-      loglik += LogEstimate(dataSeq[seq], stateLogProb, forwardLog,
-          backwardLog, logScales);
-
-      // Add to estimate of initial probability for state j.
-      for (size_t j = 0; j < logTransition.n_cols; ++j)
-        newLogInitial[j] = math::LogAdd(newLogInitial[j], stateLogProb(j, 0));
-
-      // Now re-estimate the parameters.  This is the M-step.
-      //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
-      //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t]) b(i,
-      //           t + 1)))
-      //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t) b(i, t)
-      // We store the new estimates in a different matrix.
-      for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
+      arma::vec threadLogInitial(logTransition.n_rows);
+      threadLogInitial.fill(-std::numeric_limits<double>::infinity());
+      arma::mat threadLogTransition(logTransition.n_rows,
+          logTransition.n_cols);
+      threadLogTransition.fill(-std::numeric_limits<double>::infinity());
+      double threadLoglik = 0.0;
+
+      // Loop over each sequence.
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t seq = 0; seq < dataSeq.size(); seq++)
       {
+        arma::mat emissionLogProb;
+        arma::mat stateLogProb;
+        arma::mat forwardLog;
+        arma::mat backwardLog;
+        arma::vec logScales;
+
+        // Add the log-likelihood of this sequence.  This is the E-step.  The
+        // emission log-probabilities are computed once and shared by the
+        // forward-backward recursions and the transition update below.
+        EmissionLogProbability(dataSeq[seq], emissionLogProb);
+        ForwardFromEmissions(emissionLogProb, logScales, forwardLog);
+        BackwardFromEmissions(emissionLogProb, logScales, backwardLog);
+        stateLogProb = forwardLog + backwardLog;
+        threadLoglik += accu(logScales);
+
+        // Add to estimate of initial probability for state j.
         for (size_t j = 0; j < logTransition.n_cols; ++j)
+        {
+          threadLogInitial[j] = math::LogAdd(threadLogInitial[j],
+              stateLogProb(j, 0));
+        }
+
+        // Now re-estimate the parameters.  This is the M-step.
+        //   pi_i = sum_d ((1 / P(seq[d])) sum_t (f(i, 0) b(i, 0))
+        //   T_ij = sum_d ((1 / P(seq[d])) sum_t (f(i, t) T_ij E_i(seq[d][t])
+        //           b(i, t + 1)))
+        //   E_ij = sum_d ((1 / P(seq[d])) sum_{t | seq[d][t] = j} f(i, t)
+        //           b(i, t)
+        // We store the new estimates in a different matrix.
+        size_t sumTime = seqOffsets[seq];
+        arma::mat contribution(logTransition.n_rows, logTransition.n_cols);
+        for (size_t t = 0; t < dataSeq[seq].n_cols; ++t)
         {
           if (t < dataSeq[seq].n_cols - 1)
           {
-            // Estimate of T_ij (probability of transition from state j to state
-            // i).  We postpone multiplication of the old T_ij until later.
-            for (size_t i = 0; i < logTransition.n_rows; ++i)
-            {
-              newLogTransition(i, j) = math::LogAdd(newLogTransition(i, j),
-                  forwardLog(j, t) + backwardLog(i, t + 1) +
-                  emission[i].LogProbability(dataSeq[seq].unsafe_col(t + 1)) -
-                  logScales[t + 1]);
-            }
+            // Estimate of T_ij (probability of transition from state j to
+            // state i).  We postpone multiplication of the old T_ij until
+            // later.  The emission log-probabilities of the next observation
+            // come from the precomputed matrix, and all states' contributions
+            // are then log-added in one batch.
+            const arma::vec stateTerms = emissionLogProb.col(t + 1) +
+                backwardLog.col(t + 1) - logScales[t + 1];
+            contribution = arma::repmat(stateTerms, 1, logTransition.n_cols);
+            contribution.each_row() += forwardLog.col(t).t();
+            math::LogAddBatch(threadLogTransition, contribution);
           }
 
           // Add to list of emission observations, for Distribution::Train().
           emissionList.col(sumTime) = dataSeq[seq].col(t);
-          emissionProb[j][sumTime] = exp(stateLogProb(j, t));
+          for (size_t j = 0; j < logTransition.n_cols; ++j)
+            emissionProb[j][sumTime] = exp(stateLogProb(j, t));
+          sumTime++;
         }
-        sumTime++;
+      }
+
+      // Merge this thread's accumulators into the shared estimates.
+      #pragma omp critical (hmmTrainEStep)
+      {
+        loglik += threadLoglik;
+        math::LogAddBatch(newLogInitial, threadLogInitial);
+        math::LogAddBatch(newLogTransition, threadLogTransition);
       }
     }
 
@@ -337,9 +374,13 @@ double HMM<Distribution>::LogEstimate(const arma::mat& dataSeq,
                                       arma::mat& backwardLogProb,
                                       arma::vec& logScales) const
 {
-  // First run the forward-backward algorithm.
-  Forward(dataSeq, logScales, forwardLogProb);
-  Backward(dataSeq, logScales, backwardLogProb);
+  // First run the forward-backward algorithm.  The emission
+  // log-probabilities are computed once up front and shared by both
+  // recursions.
+  arma::mat emissionLogProb;
+  EmissionLogProbability(dataSeq, emissionLogProb);
+  ForwardFromEmissions(emissionLogProb, logScales, forwardLogProb);
+  BackwardFromEmissions(emissionLogProb, logScales, backwardLogProb);
 
   // Now assemble the state probability matrix based on the forward and backward
   // probabilities.
@@ -457,27 +498,82 @@ void HMM<Distribution>::Generate(const size_t length,
 template<typename Distribution>
 double HMM<Distribution>::Predict(const arma::mat& dataSeq,
                                   arma::Row<size_t>& stateSeq) const
+{
+  arma::mat logStateProb;
+  arma::mat stateSeqBack;
+  arma::mat scores;
+
+  ConvertToLogSpace();
+
+  return PredictViterbi(dataSeq, stateSeq, logStateProb, stateSeqBack, scores);
+}
+
+/**
+ * Compute the most probable hidden state sequence for each of the given
+ * observation sequences.
+ */
+template<typename Distribution>
+void HMM<Distribution>::Predict(const std::vector<arma::mat>& dataSeq,
+                                std::vector<arma::Row<size_t>>& stateSeq,
+                                arma::vec& logLikelihood) const
+{
+  stateSeq.resize(dataSeq.size());
+  logLikelihood.set_size(dataSeq.size());
+
+  // Make sure the lazily-updated log-space parameters are in sync before the
+  // parallel region, so the threads only read them.
+  ConvertToLogSpace();
+
+  // Each sequence is independent, so decode them across threads.  Each thread
+  // keeps its own dynamic programming workspaces, which are reused across the
+  // sequences it decodes (no reallocation happens when consecutive sequences
+  // have the same length).
+  #pragma omp parallel
+  {
+    arma::mat logStateProb;
+    arma::mat stateSeqBack;
+    arma::mat scores;
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) dataSeq.size(); ++i)
+    {
+      logLikelihood[i] = PredictViterbi(dataSeq[i], stateSeq[i], logStateProb,
+          stateSeqBack, scores);
+    }
+  }
+}
+
+/**
+ * Viterbi decoding of a single sequence with caller-provided workspaces.
+ */
+template<typename Distribution>
+double HMM<Distribution>::PredictViterbi(const arma::mat& dataSeq,
+                                         arma::Row<size_t>& stateSeq,
+                                         arma::mat& logStateProb,
+                                         arma::mat& stateSeqBack,
+                                         arma::mat& scores) const
 {
   // This is an implementation of the Viterbi algorithm for finding the most
   // probable sequence of states to produce the observed data sequence.  We
   // don't use log-likelihoods to save that little bit of time, but we'll
   // calculate the log-likelihood at the end of it all.
+  const size_t states = logTransition.n_rows;
   stateSeq.set_size(dataSeq.n_cols);
-  arma::mat logStateProb(logTransition.n_rows, dataSeq.n_cols);
-  arma::mat stateSeqBack(logTransition.n_rows, dataSeq.n_cols);
+  logStateProb.set_size(states, dataSeq.n_cols);
+  stateSeqBack.set_size(states, dataSeq.n_cols);
+  scores.set_size(states, states);
 
-  ConvertToLogSpace();
+  // Compute all emission log-probabilities up front, so the recursion below
+  // is pure matrix work.
+  arma::mat emissionLogProb;
+  EmissionLogProbability(dataSeq, emissionLogProb);
 
   // The calculation of the first state is slightly different; the probability
   // of the first state being state j is the maximum probability that the state
   // came to be j from another state.
-  logStateProb.col(0).zeros();
-  for (size_t state = 0; state < logTransition.n_rows; state++)
-  {
-    logStateProb(state, 0) = logInitial[state] +
-        emission[state].LogProbability(dataSeq.unsafe_col(0));
+  logStateProb.col(0) = logInitial + emissionLogProb.col(0);
+  for (size_t state = 0; state < states; state++)
     stateSeqBack(state, 0) = state;
-  }
 
   // Store the best first state.
   arma::uword index;
@@ -485,13 +581,16 @@ double HMM<Distribution>::Predict(const arma::mat& dataSeq,
   {
     // Assemble the state probability for this element.
     // Given that we are in state j, we use state with the highest probability
-    // of being the previous state.
-    for (size_t j = 0; j < logTransition.n_rows; ++j)
+    // of being the previous state.  The max-plus product over previous states
+    // is computed for all states at once: scores(j, i) is the log-probability
+    // of arriving in state j from state i.
+    scores = logTransition;
+    scores.each_row() += logStateProb.col(t - 1).t();
+    const arma::uvec best = arma::index_max(scores, 1);
+    for (size_t j = 0; j < states; ++j)
     {
-      arma::vec prob = logStateProb.col(t - 1) + logTransition.row(j).t();
-      logStateProb(j, t) = prob.max(index) +
-          emission[j].LogProbability(dataSeq.unsafe_col(t));
-      stateSeqBack(j, t) = index;
+      logStateProb(j, t) = scores(j, best[j]) + emissionLogProb(j, t);
+      stateSeqBack(j, t) = best[j];
     }
   }
 
@@ -530,9 +629,51 @@ void HMM<Distribution>::Filter(const arma::mat& dataSeq,
                                arma::mat& filterSeq,
                                size_t ahead) const
 {
-  // First run the forward algorithm.
-  arma::mat forwardLogProb;
   arma::vec logScales;
+  arma::mat forwardLogProb;
+
+  FilterSequence(dataSeq, filterSeq, ahead, logScales, forwardLogProb);
+}
+
+/**
+ * HMM filtering of a batch of sequences.
+ */
+template<typename Distribution>
+void HMM<Distribution>::Filter(const std::vector<arma::mat>& dataSeq,
+                               std::vector<arma::mat>& filterSeq,
+                               size_t ahead) const
+{
+  filterSeq.resize(dataSeq.size());
+
+  // Make sure the lazily-updated log-space parameters are in sync before the
+  // parallel region, so the threads only read them.
+  ConvertToLogSpace();
+
+  // Each sequence is independent, so filter them across threads; each thread
+  // reuses its forward-algorithm workspaces across the sequences it handles.
+  #pragma omp parallel
+  {
+    arma::vec logScales;
+    arma::mat forwardLogProb;
+
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t i = 0; i < (omp_size_t) dataSeq.size(); ++i)
+      FilterSequence(dataSeq[i], filterSeq[i], ahead, logScales,
+          forwardLogProb);
+  }
+}
+
+/**
+ * Filtering of a single sequence with caller-provided workspaces.
+ */
+template<typename Distribution>
+void HMM<Distribution>::FilterSequence(const arma::mat& dataSeq,
+                                       arma::mat& filterSeq,
+                                       const size_t ahead,
+                                       arma::vec& logScales,
+                                       arma::mat& forwardLogProb) const
+{
+  // First run the forward algorithm.
   Forward(dataSeq, logScales, forwardLogProb);
 
   // Propagate state ahead.
@@ -577,12 +718,64 @@ template<typename Distribution>
 void HMM<Distribution>::Forward(const arma::mat& dataSeq,
                                 arma::vec& logScales,
                                 arma::mat& forwardLogProb) const
+{
+  arma::mat emissionLogProb;
+  EmissionLogProbability(dataSeq, emissionLogProb);
+  ForwardFromEmissions(emissionLogProb, logScales, forwardLogProb);
+}
+
+template<typename Distribution>
+void HMM<Distribution>::Backward(const arma::mat& dataSeq,
+                                 const arma::vec& logScales,
+                                 arma::mat& backwardLogProb) const
+{
+  arma::mat emissionLogProb;
+  EmissionLogProbability(dataSeq, emissionLogProb);
+  BackwardFromEmissions(emissionLogProb, logScales, backwardLogProb);
+}
+
+/**
+ * Compute the emission log-probability matrix for the given data sequence.
+ */
+template<typename Distribution>
+void HMM<Distribution>::EmissionLogProbability(const arma::mat& dataSeq,
+                                               arma::mat& emissionLogProb)
+    const
+{
+  // One batched call per state; the emission distribution can evaluate all
+  // observations at once far faster than one call per observation.
+  emissionLogProb.set_size(logTransition.n_rows, dataSeq.n_cols);
+  arma::vec stateLogProb;
+  for (size_t state = 0; state < logTransition.n_rows; state++)
+  {
+    emission[state].LogProbability(dataSeq, stateLogProb);
+    emissionLogProb.row(state) = stateLogProb.t();
+  }
+}
+
+/**
+ * For discrete emissions the whole emission log-probability matrix can be
+ * filled in a single gathering pass over the observation sequence.
+ */
+template<>
+inline void HMM<distribution::DiscreteDistribution>::EmissionLogProbability(
+    const arma::mat& dataSeq,
+    arma::mat& emissionLogProb) const
+{
+  distribution::DiscreteDistribution::LogProbability(dataSeq, emission,
+      emissionLogProb);
+}
+
+template<typename Distribution>
+void HMM<Distribution>::ForwardFromEmissions(const arma::mat& emissionLogProb,
+                                             arma::vec& logScales,
+                                             arma::mat& forwardLogProb) const
 {
   // Our goal is to calculate the forward probabilities:
   //  P(X_k | o_{1:k}) for all possible states X_k, for each time point k.
-  forwardLogProb.resize(logTransition.n_rows, dataSeq.n_cols);
+  forwardLogProb.resize(logTransition.n_rows, emissionLogProb.n_cols);
   forwardLogProb.fill(-std::numeric_limits<double>::infinity());
-  logScales.resize(dataSeq.n_cols);
+  logScales.resize(emissionLogProb.n_cols);
   logScales.fill(-std::numeric_limits<double>::infinity());
 
   ConvertToLogSpace();
@@ -592,11 +785,7 @@ void HMM<Distribution>::Forward(const arma::mat& dataSeq,
   // t = -1) is state 0; this is not our assumption here.  To force that
   // behavior, you could append a single starting state to every single data
   // sequence and that should produce results in line with MATLAB.
-  for (size_t state = 0; state < logTransition.n_rows; state++)
-  {
-    forwardLogProb(state, 0) = logInitial(state) +
-        emission[state].LogProbability(dataSeq.unsafe_col(0));
-  }
+  forwardLogProb.col(0) = logInitial + emissionLogProb.col(0);
 
   // Then normalize the column.
   logScales[0] = math::AccuLog(forwardLogProb.col(0));
@@ -604,7 +793,7 @@ void HMM<Distribution>::Forward(const arma::mat& dataSeq,
     forwardLogProb.col(0) -= logScales[0];
 
   // Now compute the probabilities for each successive observation.
-  for (size_t t = 1; t < dataSeq.n_cols; t++)
+  for (size_t t = 1; t < emissionLogProb.n_cols; t++)
   {
     for (size_t j = 0; j < logTransition.n_rows; ++j)
     {
@@ -612,8 +801,7 @@ void HMM<Distribution>::Forward(const arma::mat& dataSeq,
       // of the probability of the previous state transitioning to the current
       // state and emitting the given observation.
       arma::vec tmp = forwardLogProb.col(t - 1) + logTransition.row(j).t();
-      forwardLogProb(j, t) = math::AccuLog(tmp) +
-          emission[j].LogProbability(dataSeq.unsafe_col(t));
+      forwardLogProb(j, t) = math::AccuLog(tmp) + emissionLogProb(j, t);
     }
 
     // Normalize probability.
@@ -624,20 +812,21 @@ void HMM<Distribution>::Forward(const arma::mat& dataSeq,
 }
 
 template<typename Distribution>
-void HMM<Distribution>::Backward(const arma::mat& dataSeq,
-                                 const arma::vec& logScales,
-                                 arma::mat& backwardLogProb) const
+void HMM<Distribution>::BackwardFromEmissions(
+    const arma::mat& emissionLogProb,
+    const arma::vec& logScales,
+    arma::mat& backwardLogProb) const
 {
   // Our goal is to calculate the backward probabilities:
   //  P(X_k | o_{k + 1:T}) for all possible states X_k, for each time point k.
-  backwardLogProb.resize(logTransition.n_rows, dataSeq.n_cols);
+  backwardLogProb.resize(logTransition.n_rows, emissionLogProb.n_cols);
   backwardLogProb.fill(-std::numeric_limits<double>::infinity());
 
   // The last element probability is 1.
-  backwardLogProb.col(dataSeq.n_cols - 1).fill(0);
+  backwardLogProb.col(emissionLogProb.n_cols - 1).fill(0);
 
   // Now step backwards through all other observations.
-  for (size_t t = dataSeq.n_cols - 2; t + 1 > 0; t--)
+  for (size_t t = emissionLogProb.n_cols - 2; t + 1 > 0; t--)
   {
     for (size_t j = 0; j < logTransition.n_rows; ++j)
     {
@@ -649,7 +838,7 @@ void HMM<Distribution>::Backward(const arma::mat& dataSeq,
       {
         backwardLogProb(j, t) = math::LogAdd(backwardLogProb(j, t),
             logTransition(state, j) + backwardLogProb(state, t + 1)
-            + emission[state].LogProbability(dataSeq.unsafe_col(t + 1)));
+            + emissionLogProb(state, t + 1));
       }
 
       // Normalize by the weights from the forward algorithm.
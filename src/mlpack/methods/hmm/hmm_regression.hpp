@@ -19,6 +19,21 @@
 namespace mlpack {
 namespace hmm /** Hidden Markov Models. */ {
 
+/**
+ * For regression emissions the whole emission log-probability matrix can be
+ * computed at once: the coefficients of all states are stacked so that one
+ * matrix product yields every state's fitted values over the whole sequence,
+ * and the Gaussian densities of the residuals are evaluated vectorized.
+ */
+template<>
+inline void HMM<distribution::RegressionDistribution>::EmissionLogProbability(
+    const arma::mat& dataSeq,
+    arma::mat& emissionLogProb) const
+{
+  distribution::RegressionDistribution::LogProbability(dataSeq, emission,
+      emissionLogProb);
+}
+
 /**
  * A class that represents a Hidden Markov Model Regression (HMMR). HMMR is an
  * extension of Hidden Markov Models to regression analysis. The method is
@@ -0,0 +1,191 @@
+/**
+ * @file methods/hoeffding_trees/hoeffding_forest.hpp
+ * @author Ryan Curtin
+ *
+ * A bagged ensemble of Hoeffding trees that can be trained in a streaming
+ * setting, point by point, with the individual trees trained concurrently.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_FOREST_HPP
+#define MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_FOREST_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+#include <mlpack/core/util/parallel.hpp>
+#include "hoeffding_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The HoeffdingForest class maintains a bagged ensemble of Hoeffding trees
+ * for streaming classification.  Since the stream cannot be resampled with
+ * replacement the way a batch random forest resamples its training set, each
+ * incoming point is instead presented to each tree a Poisson(1)-distributed
+ * number of times (online bagging), which converges to bootstrap sampling as
+ * the stream grows:
+ *
+ * @code
+ * @inproceedings{oza2001online,
+ *     title={{Online Bagging and Boosting}},
+ *     author={Oza, N. and Russell, S.},
+ *     year={2001},
+ *     booktitle={Proceedings of the Eighth International Workshop on
+ *         Artificial Intelligence and Statistics (AISTATS '01)},
+ *     pages={105--112}
+ * }
+ * @endcode
+ *
+ * The trees are independent, so they train concurrently across threads; the
+ * per-tree Poisson draws come from counter-based streams keyed by the tree
+ * index, so the ensemble a given random seed produces does not depend on the
+ * number of threads.  Classification is by majority vote over the trees.
+ *
+ * @tparam FitnessFunction Fitness function to use for the trees.
+ * @tparam NumericSplitType Technique for splitting numeric features.
+ * @tparam CategoricalSplitType Technique for splitting categorical features.
+ */
+template<typename FitnessFunction = GiniImpurity,
+         template<typename> class NumericSplitType =
+             HoeffdingDoubleNumericSplit,
+         template<typename> class CategoricalSplitType =
+             HoeffdingCategoricalSplit
+>
+class HoeffdingForest
+{
+ public:
+  //! The type of the trees in the forest.
+  typedef HoeffdingTree<FitnessFunction, NumericSplitType,
+      CategoricalSplitType> HoeffdingTreeType;
+
+  /**
+   * Construct a Hoeffding forest of the given size, training on no data.
+   * The tree parameters are forwarded to each tree in the forest.
+   *
+   * @param numTrees Number of trees in the forest.
+   * @param datasetInfo Information on the dataset (types of each feature).
+   * @param numClasses Number of classes in the dataset.
+   * @param successProbability Probability of success required in Hoeffding
+   *      bound before a split can happen.
+   * @param maxSamples Maximum number of samples before a split is forced (0
+   *      never forces a split).
+   * @param checkInterval Number of samples required before each split check.
+   * @param minSamples If a node has seen this many points or fewer, no split
+   *      will be allowed.
+   */
+  HoeffdingForest(const size_t numTrees,
+                  const data::DatasetInfo& datasetInfo,
+                  const size_t numClasses,
+                  const double successProbability = 0.95,
+                  const size_t maxSamples = 0,
+                  const size_t checkInterval = 100,
+                  const size_t minSamples = 100);
+
+  /**
+   * Construct a Hoeffding forest with no trees and no information.  Be sure
+   * to use the move or serialize functions to give this object a valid forest
+   * before using it.
+   */
+  HoeffdingForest();
+
+  /**
+   * Train all trees on a single point in streaming mode, with the given
+   * label.  Each tree sees the point a Poisson(1)-distributed number of
+   * times; the trees are trained concurrently.
+   *
+   * @param point Point to train on.
+   * @param label Label of the point to train on.
+   */
+  template<typename VecType>
+  void Train(const VecType& point, const size_t label);
+
+  /**
+   * Train all trees on a set of points in streaming mode, with the given
+   * labels.  Each tree traverses the whole sequence with its own bagging
+   * stream; the trees are trained concurrently.
+   *
+   * @param data Dataset to train on (one point per column).
+   * @param labels Labels of each point in the dataset.
+   */
+  template<typename MatType>
+  void Train(const MatType& data, const arma::Row<size_t>& labels);
+
+  /**
+   * Classify the given point by majority vote of the trees.
+   *
+   * @param point Point to classify.
+   * @return Predicted label of the point.
+   */
+  template<typename VecType>
+  size_t Classify(const VecType& point) const;
+
+  /**
+   * Classify the given point by majority vote of the trees, and also return
+   * the fraction of trees that voted for the winning class.
+   *
+   * @param point Point to classify.
+   * @param prediction Predicted label of the point.
+   * @param probability Fraction of trees that voted for the predicted label.
+   */
+  template<typename VecType>
+  void Classify(const VecType& point,
+                size_t& prediction,
+                double& probability) const;
+
+  /**
+   * Classify the given points by majority vote of the trees.
+   *
+   * @param data Points to classify (one point per column).
+   * @param predictions Predicted labels for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data, arma::Row<size_t>& predictions) const;
+
+  /**
+   * Classify the given points by majority vote of the trees, and also return
+   * the fraction of trees that voted for each winning class.
+   *
+   * @param data Points to classify (one point per column).
+   * @param predictions Predicted labels for each point.
+   * @param probabilities Fraction of trees that voted for each predicted
+   *      label.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::rowvec& probabilities) const;
+
+  //! Get the number of trees in the forest.
+  size_t NumTrees() const { return trees.size(); }
+
+  //! Get the given tree.
+  const HoeffdingTreeType& Tree(const size_t i) const { return trees[i]; }
+  //! Modify the given tree.
+  HoeffdingTreeType& Tree(const size_t i) { return trees[i]; }
+
+  //! Get the number of classes the forest is trained on.
+  size_t NumClasses() const { return numClasses; }
+
+  //! Serialize the forest.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */);
+
+ private:
+  //! The trees in the forest.
+  std::vector<HoeffdingTreeType> trees;
+
+  //! The number of classes in the dataset.
+  size_t numClasses;
+}; // class HoeffdingForest
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "hoeffding_forest_impl.hpp"
+
+#endif
@@ -0,0 +1,209 @@
+/**
+ * @file methods/hoeffding_trees/hoeffding_forest_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the HoeffdingForest class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_FOREST_IMPL_HPP
+#define MLPACK_METHODS_HOEFFDING_TREES_HOEFFDING_FOREST_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "hoeffding_forest.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+HoeffdingForest<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::HoeffdingForest(const size_t numTrees,
+                   const data::DatasetInfo& datasetInfo,
+                   const size_t numClasses,
+                   const double successProbability,
+                   const size_t maxSamples,
+                   const size_t checkInterval,
+                   const size_t minSamples) :
+    numClasses(numClasses)
+{
+  trees.reserve(numTrees);
+  for (size_t i = 0; i < numTrees; ++i)
+  {
+    trees.push_back(HoeffdingTreeType(datasetInfo, numClasses,
+        successProbability, maxSamples, checkInterval, minSamples));
+  }
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+HoeffdingForest<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::HoeffdingForest() : numClasses(0)
+{
+  // Nothing to do.
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename VecType>
+void HoeffdingForest<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::Train(const VecType& point, const size_t label)
+{
+  // Each tree sees the point a Poisson(1)-distributed number of times
+  // (online bagging).  One draw from the calling thread's generator keys the
+  // per-tree counter-based streams, so the counts do not depend on how many
+  // threads train the trees.
+  const uint64_t baggingSeed = math::RandGen()();
+  Parallel::For((size_t) 0, trees.size(), [&](const size_t i)
+  {
+    math::RandomStream stream(baggingSeed, i);
+    std::poisson_distribution<size_t> poisson(1.0);
+
+    const size_t count = poisson(stream);
+    for (size_t c = 0; c < count; ++c)
+      trees[i].Train(point, label);
+  });
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingForest<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::Train(const MatType& data, const arma::Row<size_t>& labels)
+{
+  // As in the single-point overload, but each tree traverses the whole
+  // sequence with one bagging stream, so the trees only synchronize once per
+  // batch instead of once per point.
+  const uint64_t baggingSeed = math::RandGen()();
+  Parallel::For((size_t) 0, trees.size(), [&](const size_t i)
+  {
+    math::RandomStream stream(baggingSeed, i);
+    std::poisson_distribution<size_t> poisson(1.0);
+
+    for (size_t j = 0; j < data.n_cols; ++j)
+    {
+      const size_t count = poisson(stream);
+      for (size_t c = 0; c < count; ++c)
+        trees[i].Train(data.col(j), labels[j]);
+    }
+  });
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename VecType>
+size_t HoeffdingForest<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::Classify(const VecType& point) const
+{
+  size_t prediction;
+  double probability;
+  Classify(point, prediction, probability);
+  return prediction;
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename VecType>
+void HoeffdingForest<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::Classify(const VecType& point,
+            size_t& prediction,
+            double& probability) const
+{
+  arma::vec votes(numClasses, arma::fill::zeros);
+  for (size_t i = 0; i < trees.size(); ++i)
+    votes(trees[i].Classify(point))++;
+
+  prediction = (size_t) votes.index_max();
+  probability = (trees.empty()) ? 0.0 :
+      votes(prediction) / (double) trees.size();
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingForest<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::Classify(const MatType& data, arma::Row<size_t>& predictions) const
+{
+  predictions.set_size(data.n_cols);
+
+  // The points are independent, so they are voted on concurrently.
+  Parallel::For((size_t) 0, (size_t) data.n_cols, [&](const size_t j)
+  {
+    predictions[j] = Classify(data.col(j));
+  });
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingForest<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::Classify(const MatType& data,
+            arma::Row<size_t>& predictions,
+            arma::rowvec& probabilities) const
+{
+  predictions.set_size(data.n_cols);
+  probabilities.set_size(data.n_cols);
+
+  Parallel::For((size_t) 0, (size_t) data.n_cols, [&](const size_t j)
+  {
+    size_t prediction;
+    double probability;
+    Classify(data.col(j), prediction, probability);
+    predictions[j] = prediction;
+    probabilities[j] = probability;
+  });
+}
+
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename Archive>
+void HoeffdingForest<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::serialize(Archive& ar, const unsigned int /* version */)
+{
+  ar & BOOST_SERIALIZATION_NVP(trees);
+  ar & BOOST_SERIALIZATION_NVP(numClasses);
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
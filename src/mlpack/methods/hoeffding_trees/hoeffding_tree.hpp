@@ -192,6 +192,22 @@ class HoeffdingTree
   template<typename VecType>
   void Train(const VecType& point, const size_t label);
 
+  /**
+   * Train on a chunk (column block) of points in streaming mode, with the
+   * given labels.  This is meant for consuming a stream in blocks: the chunk's
+   * points are accumulated into the split statistics one dimension at a time,
+   * which streams over each dimension's values contiguously instead of
+   * touching every split object once per point, and a split check is
+   * performed only when the chunk crosses a check interval boundary.  The
+   * resulting tree may therefore differ slightly from one trained
+   * point-at-a-time, since splits can only happen at chunk boundaries.
+   *
+   * @param data Chunk of data points to train on.
+   * @param labels Labels of data points.
+   */
+  template<typename MatType>
+  void TrainChunk(const MatType& data, const arma::Row<size_t>& labels);
+
   /**
    * Check if a split would satisfy the conditions of the Hoeffding bound with
    * the node's specified success probability.  If so, the number of children
@@ -429,6 +429,103 @@ void HoeffdingTree<
   }
 }
 
+//! Train on a chunk of points in streaming mode.
+template<typename FitnessFunction,
+         template<typename> class NumericSplitType,
+         template<typename> class CategoricalSplitType>
+template<typename MatType>
+void HoeffdingTree<
+    FitnessFunction,
+    NumericSplitType,
+    CategoricalSplitType
+>::TrainChunk(const MatType& data, const arma::Row<size_t>& labels)
+{
+  if (data.n_cols == 0)
+    return;
+
+  if (splitDimension == size_t(-1))
+  {
+    // Accumulate the chunk's statistics one dimension at a time, so that each
+    // split object's state stays hot in cache while its values are streamed
+    // over contiguously.
+    size_t numericIndex = 0;
+    size_t categoricalIndex = 0;
+    for (size_t i = 0; i < data.n_rows; ++i)
+    {
+      // Extract the dimension's values into a dense buffer; a row of a
+      // column-major matrix is strided, and the split objects will touch each
+      // value once.
+      const arma::Row<typename MatType::elem_type> dimValues = data.row(i);
+      if (datasetInfo->Type(i) == data::Datatype::categorical)
+      {
+        CategoricalSplitType<FitnessFunction>& split =
+            categoricalSplits[categoricalIndex++];
+        for (size_t j = 0; j < dimValues.n_elem; ++j)
+          split.Train(dimValues[j], labels[j]);
+      }
+      else if (datasetInfo->Type(i) == data::Datatype::numeric)
+      {
+        NumericSplitType<FitnessFunction>& split =
+            numericSplits[numericIndex++];
+        for (size_t j = 0; j < dimValues.n_elem; ++j)
+          split.Train(dimValues[j], labels[j]);
+      }
+    }
+
+    const size_t oldNumSamples = numSamples;
+    numSamples += data.n_cols;
+
+    // Grab majority class from splits.
+    if (categoricalSplits.size() > 0)
+    {
+      majorityClass = categoricalSplits[0].MajorityClass();
+      majorityProbability = categoricalSplits[0].MajorityProbability();
+    }
+    else
+    {
+      majorityClass = numericSplits[0].MajorityClass();
+      majorityProbability = numericSplits[0].MajorityProbability();
+    }
+
+    // Check for a split if the chunk crossed a check interval boundary.
+    if ((numSamples / checkInterval) != (oldNumSamples / checkInterval))
+    {
+      const size_t numChildren = SplitCheck();
+      if (numChildren > 0)
+      {
+        // We need to add a bunch of children.
+        // Delete children, if we have them.
+        children.clear();
+        CreateChildren();
+      }
+    }
+  }
+  else
+  {
+    // Already split.  Partition the chunk among the children, the same way
+    // batch-mode training does, and pass each sub-chunk on.
+    std::vector<arma::uvec> indices(children.size(), arma::uvec(data.n_cols));
+    arma::Col<size_t> counts = arma::zeros<arma::Col<size_t>>(children.size());
+
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      const size_t direction = CalculateDirection(data.col(i));
+      indices[direction][counts[direction]++] = i;
+    }
+
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+      if (counts[i] == 0)
+        continue;
+
+      const arma::uvec childPoints = indices[i].subvec(0, counts[i] - 1);
+      const MatType childData = data.cols(childPoints);
+      const arma::Row<size_t> childLabels = labels.cols(childPoints);
+      children[i]->TrainChunk(childData, childLabels);
+    }
+  }
+}
+
 template<typename FitnessFunction,
          template<typename> class NumericSplitType,
          template<typename> class CategoricalSplitType>
@@ -454,11 +551,14 @@ size_t HoeffdingTree<
   const double epsilon = std::sqrt(rSquared *
       std::log(1.0 / (1.0 - successProbability)) / (2 * numSamples));
 
-  // Find the best and second best possible splits.
-  double largest = -DBL_MAX;
-  size_t largestIndex = 0;
-  double secondLargest = -DBL_MAX;
-  for (size_t i = 0; i < categoricalSplits.size() + numericSplits.size(); ++i)
+  // Evaluate the gains of all dimensions in parallel.  Each dimension's split
+  // object is touched by exactly one iteration, so no synchronization is
+  // needed.
+  const size_t numDimensions = categoricalSplits.size() + numericSplits.size();
+  arma::vec bestGains(numDimensions);
+  arma::vec secondBestGains(numDimensions);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < numDimensions; ++i)
   {
     size_t type = dimensionMappings->at(i).first;
     size_t index = dimensionMappings->at(i).second;
@@ -473,21 +573,31 @@ size_t HoeffdingTree<
     else if (type == data::Datatype::numeric)
       numericSplits[index].EvaluateFitnessFunction(bestGain, secondBestGain);
 
+    bestGains[i] = bestGain;
+    secondBestGains[i] = secondBestGain;
+  }
+
+  // Find the best and second best possible splits.
+  double largest = -DBL_MAX;
+  size_t largestIndex = 0;
+  double secondLargest = -DBL_MAX;
+  for (size_t i = 0; i < numDimensions; ++i)
+  {
     // See if these gains are better than the previous.
-    if (bestGain > largest)
+    if (bestGains[i] > largest)
     {
       secondLargest = largest;
-      largest = bestGain;
+      largest = bestGains[i];
       largestIndex = i;
     }
-    else if (bestGain > secondLargest)
+    else if (bestGains[i] > secondLargest)
     {
-      secondLargest = bestGain;
+      secondLargest = bestGains[i];
     }
 
-    if (secondBestGain > secondLargest)
+    if (secondBestGains[i] > secondLargest)
     {
-      secondLargest = secondBestGain;
+      secondLargest = secondBestGains[i];
     }
   }
 
@@ -208,6 +208,31 @@ class KDE
                 const std::vector<size_t>& oldFromNewQueries,
                 arma::vec& estimations);
 
+  /**
+   * Estimate density of each point in the query set at several bandwidths at
+   * once, sharing a single traversal of the trees.  Row i of the estimations
+   * matrix holds the densities for kernels[i]; column j corresponds to query
+   * point j.  Estimations might not be normalized.
+   *
+   * Distance bounds for each node combination are computed once and shared by
+   * all bandwidths, and each bandwidth is pruned independently, so evaluating
+   * k bandwidths this way is much cheaper than k separate Evaluate() calls.
+   * Monte Carlo estimations are not used by this mode, even if enabled, so
+   * results are always within the exact error tolerance for every bandwidth.
+   *
+   * - Dimension of each point in the query set must match the dimension of
+   *   each point in the reference set.
+   *
+   * @pre The model has to be previously trained.
+   * @param querySet Set of query points to get the density of.
+   * @param kernels Instantiated kernels, one per bandwidth to evaluate.
+   * @param estimations Matrix which will hold the density of each query point
+   *                    (one row per kernel).
+   */
+  void Evaluate(MatType querySet,
+                std::vector<KernelType> kernels,
+                arma::mat& estimations);
+
   /**
    * Estimate density of each point in the reference set given the data of the
    * reference set. It does not compute the estimation of a point with itself.
@@ -347,6 +372,10 @@ class KDE
   //! Rearrange estimations vector if required.
   static void RearrangeEstimations(const std::vector<size_t>& oldFromNew,
                                    arma::vec& estimations);
+
+  //! Rearrange columns of a multi-bandwidth estimations matrix if required.
+  static void RearrangeEstimations(const std::vector<size_t>& oldFromNew,
+                                   arma::mat& estimations);
 };
 
 } // namespace kde
@@ -390,4 +419,17 @@ struct version<mlpack::kde::KDE<KernelType,
 // Include implementation.
 #include "kde_impl.hpp"
 
+namespace mlpack {
+namespace kde {
+
+// The most common configurations are compiled once into the mlpack library
+// (see kde_instantiations.cpp); these declarations keep other translation
+// units from instantiating them again.
+extern template class KDE<kernel::GaussianKernel, metric::EuclideanDistance>;
+extern template class KDE<kernel::GaussianKernel, metric::EuclideanDistance,
+    arma::mat, tree::BallTree>;
+
+} // namespace kde
+} // namespace mlpack
+
 #endif // MLPACK_METHODS_KDE_KDE_HPP
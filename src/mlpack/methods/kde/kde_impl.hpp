@@ -38,6 +38,23 @@ TreeType* BuildTree(
   return new TreeType(std::forward<MatType>(dataset));
 }
 
+//! Precompute the Monte Carlo alpha value of every node of the tree.  The
+//! values match what KDERules would lazily compute during a traversal, so
+//! that concurrent traversals only ever read the tree statistics.
+template<typename TreeType>
+void PrecomputeMCAlpha(TreeType* node, const double mcBeta)
+{
+  if (node->Parent() == NULL)
+    node->Stat().MCAlpha() = mcBeta;
+  else
+    node->Stat().MCAlpha() =
+        node->Parent()->Stat().MCAlpha() / node->Parent()->NumChildren();
+  node->Stat().MCBeta() = mcBeta;
+
+  for (size_t i = 0; i < node->NumChildren(); ++i)
+    PrecomputeMCAlpha(&node->Child(i), mcBeta);
+}
+
 template<typename KernelType,
          typename MetricType,
          typename MatType,
@@ -379,35 +396,54 @@ Evaluate(MatType querySet, arma::vec& estimations)
 
     Timer::Start("computing_kde");
 
-    // Evaluate.
+    // Precompute the Monte Carlo alpha value of every reference node, so the
+    // parallel traversals below only read the reference tree statistics.
+    if (monteCarlo && std::is_same<KernelType, kernel::GaussianKernel>::value)
+      PrecomputeMCAlpha(referenceTree, 1 - mcProb);
+
     typedef KDERules<MetricType, KernelType, Tree> RuleType;
-    RuleType rules = RuleType(referenceTree->Dataset(),
-                              querySet,
-                              estimations,
-                              relError,
-                              absError,
-                              mcProb,
-                              initialSampleSize,
-                              mcEntryCoef,
-                              mcBreakCoef,
-                              metric,
-                              kernel,
-                              monteCarlo,
-                              false);
+    size_t totalScores = 0;
+    size_t totalBaseCases = 0;
 
-    // Create traverser.
-    SingleTreeTraversalType<RuleType> traverser(rules);
+    // Partition the query points across an OpenMP team.  Each thread keeps
+    // its own rules object, and each query point only ever touches its own
+    // entry of the estimations vector, so the traversals are independent.
+    #pragma omp parallel
+    {
+      RuleType rules = RuleType(referenceTree->Dataset(),
+                                querySet,
+                                estimations,
+                                relError,
+                                absError,
+                                mcProb,
+                                initialSampleSize,
+                                mcEntryCoef,
+                                mcBreakCoef,
+                                metric,
+                                kernel,
+                                monteCarlo,
+                                false);
 
-    // Traverse for each point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+      // Create traverser.
+      SingleTreeTraversalType<RuleType> traverser(rules);
+
+      // Traverse for each point.
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      #pragma omp atomic
+      totalScores += rules.Scores();
+      #pragma omp atomic
+      totalBaseCases += rules.BaseCases();
+    }
 
     estimations /= referenceTree->Dataset().n_cols;
     Timer::Stop("computing_kde");
 
-    Log::Info << rules.Scores() << " node combinations were scored."
+    Log::Info << totalScores << " node combinations were scored."
               << std::endl;
-    Log::Info << rules.BaseCases() << " base cases were calculated."
+    Log::Info << totalBaseCases << " base cases were calculated."
               << std::endl;
   }
 }
@@ -477,8 +513,95 @@ Evaluate(Tree* queryTree,
 
   Timer::Start("computing_kde");
 
-  // Evaluate.
   typedef KDERules<MetricType, KernelType, Tree> RuleType;
+
+  #ifdef _OPENMP
+  // If more than one thread is available, split the query tree into
+  // independent subtrees and traverse each of them against the reference
+  // tree on an OpenMP team.  Each thread keeps its own rules object, and
+  // every query point belongs to exactly one subtree, so each thread writes
+  // a disjoint set of estimations entries.  The Monte Carlo alpha values of
+  // the reference tree are precomputed beforehand, so the traversals only
+  // read the reference tree statistics.
+  if (omp_get_max_threads() > 1)
+  {
+    if (monteCarlo && std::is_same<KernelType, kernel::GaussianKernel>::value)
+      PrecomputeMCAlpha(referenceTree, 1 - mcProb);
+
+    // Expand the frontier level by level until there are enough subtrees to
+    // keep the team busy with dynamic scheduling.
+    std::vector<Tree*> querySubtrees;
+    querySubtrees.push_back(queryTree);
+    const size_t targetSubtrees = 8 * omp_get_max_threads();
+    bool expanded = true;
+    while (querySubtrees.size() < targetSubtrees && expanded)
+    {
+      expanded = false;
+      std::vector<Tree*> nextFrontier;
+      for (size_t i = 0; i < querySubtrees.size(); ++i)
+      {
+        if (querySubtrees[i]->NumChildren() > 0)
+        {
+          for (size_t c = 0; c < querySubtrees[i]->NumChildren(); ++c)
+            nextFrontier.push_back(&querySubtrees[i]->Child(c));
+          expanded = true;
+        }
+        else
+        {
+          nextFrontier.push_back(querySubtrees[i]);
+        }
+      }
+      querySubtrees = std::move(nextFrontier);
+    }
+
+    if (querySubtrees.size() > 1)
+    {
+      size_t totalScores = 0;
+      size_t totalBaseCases = 0;
+
+      #pragma omp parallel
+      {
+        RuleType rules = RuleType(referenceTree->Dataset(),
+                                  queryTree->Dataset(),
+                                  estimations,
+                                  relError,
+                                  absError,
+                                  mcProb,
+                                  initialSampleSize,
+                                  mcEntryCoef,
+                                  mcBreakCoef,
+                                  metric,
+                                  kernel,
+                                  monteCarlo,
+                                  false);
+        DualTreeTraversalType<RuleType> traverser(rules);
+
+        #pragma omp for schedule(dynamic)
+        for (omp_size_t i = 0; i < (omp_size_t) querySubtrees.size(); ++i)
+          traverser.Traverse(*querySubtrees[i], *referenceTree);
+
+        #pragma omp atomic
+        totalScores += rules.Scores();
+        #pragma omp atomic
+        totalBaseCases += rules.BaseCases();
+      }
+
+      estimations /= referenceTree->Dataset().n_cols;
+      Timer::Stop("computing_kde");
+
+      // Rearrange if necessary.
+      RearrangeEstimations(oldFromNewQueries, estimations);
+
+      Log::Info << totalScores << " node combinations were scored."
+                << std::endl;
+      Log::Info << totalBaseCases << " base cases were calculated."
+                << std::endl;
+      return;
+    }
+  }
+  #endif
+
+  // Evaluate.
   RuleType rules = RuleType(referenceTree->Dataset(),
                             queryTree->Dataset(),
                             estimations,
@@ -506,6 +629,150 @@ Evaluate(Tree* queryTree,
   Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
 }
 
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+Evaluate(MatType querySet,
+         std::vector<KernelType> kernels,
+         arma::mat& estimations)
+{
+  // Check whether has already been trained.
+  if (!trained)
+  {
+    throw std::runtime_error("cannot evaluate KDE model: model needs to be "
+                             "trained before evaluation");
+  }
+
+  // Check there is at least one kernel to evaluate.
+  if (kernels.empty())
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: at least one "
+                                "kernel is required");
+  }
+
+  // Get estimations matrix ready.
+  estimations.zeros(kernels.size(), querySet.n_cols);
+
+  // Check querySet has at least 1 element to evaluate.
+  if (querySet.n_cols == 0)
+  {
+    Log::Warn << "KDE::Evaluate(): querySet is empty, no predictions will "
+              << "be returned" << std::endl;
+    return;
+  }
+
+  // Check whether dimensions match.
+  if (querySet.n_rows != referenceTree->Dataset().n_rows)
+  {
+    throw std::invalid_argument("cannot evaluate KDE model: querySet and "
+                                "referenceSet dimensions don't match");
+  }
+
+  typedef KDEMultiBandwidthRules<MetricType, KernelType, Tree> RuleType;
+
+  if (mode == DUAL_TREE_MODE)
+  {
+    Timer::Start("building_query_tree");
+    std::vector<size_t> oldFromNewQueries;
+    Tree* queryTree = BuildTree<Tree>(std::move(querySet), oldFromNewQueries);
+    Timer::Stop("building_query_tree");
+
+    try
+    {
+      // Reset the per-bandwidth accumulated error tolerances of the query
+      // tree statistics.
+      Timer::Start("cleaning_query_tree");
+      KDECleanRules<Tree> cleanRules(kernels.size());
+      SingleTreeTraversalType<KDECleanRules<Tree>> cleanTraverser(cleanRules);
+      cleanTraverser.Traverse(0, *queryTree);
+      Timer::Stop("cleaning_query_tree");
+
+      Timer::Start("computing_kde");
+      RuleType rules(referenceTree->Dataset(),
+                     queryTree->Dataset(),
+                     estimations,
+                     relError,
+                     absError,
+                     metric,
+                     kernels,
+                     false);
+      DualTreeTraversalType<RuleType> traverser(rules);
+      traverser.Traverse(*queryTree, *referenceTree);
+      estimations /= referenceTree->Dataset().n_cols;
+      Timer::Stop("computing_kde");
+
+      // Rearrange if necessary.
+      RearrangeEstimations(oldFromNewQueries, estimations);
+
+      Log::Info << rules.Scores() << " node combinations were scored."
+                << std::endl;
+      Log::Info << rules.BaseCases() << " base cases were calculated."
+                << std::endl;
+    }
+    catch (std::exception& e)
+    {
+      // Make sure we delete the query tree.
+      delete queryTree;
+      throw;
+    }
+    delete queryTree;
+  }
+  else if (mode == SINGLE_TREE_MODE)
+  {
+    Timer::Start("computing_kde");
+
+    size_t totalScores = 0;
+    size_t totalBaseCases = 0;
+
+    // Partition the query points across an OpenMP team, just like the
+    // single-bandwidth case; each query point only ever touches its own
+    // column of the estimations matrix.
+    #pragma omp parallel
+    {
+      RuleType rules(referenceTree->Dataset(),
+                     querySet,
+                     estimations,
+                     relError,
+                     absError,
+                     metric,
+                     kernels,
+                     false);
+
+      // Create traverser.
+      SingleTreeTraversalType<RuleType> traverser(rules);
+
+      // Traverse for each point.
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
+
+      #pragma omp atomic
+      totalScores += rules.Scores();
+      #pragma omp atomic
+      totalBaseCases += rules.BaseCases();
+    }
+
+    estimations /= referenceTree->Dataset().n_cols;
+    Timer::Stop("computing_kde");
+
+    Log::Info << totalScores << " node combinations were scored."
+              << std::endl;
+    Log::Info << totalBaseCases << " base cases were calculated."
+              << std::endl;
+  }
+}
+
 template<typename KernelType,
          typename MetricType,
          typename MatType,
@@ -816,5 +1083,35 @@ RearrangeEstimations(const std::vector<size_t>& oldFromNew,
   }
 }
 
+template<typename KernelType,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void KDE<KernelType,
+         MetricType,
+         MatType,
+         TreeType,
+         DualTreeTraversalType,
+         SingleTreeTraversalType>::
+RearrangeEstimations(const std::vector<size_t>& oldFromNew,
+                     arma::mat& estimations)
+{
+  if (tree::TreeTraits<Tree>::RearrangesDataset)
+  {
+    const size_t nQueries = oldFromNew.size();
+    arma::mat rearrangedEstimations(estimations.n_rows, nQueries);
+
+    // Remap columns.
+    for (size_t i = 0; i < nQueries; ++i)
+      rearrangedEstimations.col(oldFromNew.at(i)) = estimations.col(i);
+
+    estimations = std::move(rearrangedEstimations);
+  }
+}
+
 } // namespace kde
 } // namespace mlpack
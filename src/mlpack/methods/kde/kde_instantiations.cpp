@@ -0,0 +1,27 @@
+/**
+ * @file methods/kde/kde_instantiations.cpp
+ * @author Ryan Curtin
+ *
+ * Explicit instantiations of KDE for the most common configurations.  These
+ * are compiled once into the mlpack library, and matching extern template
+ * declarations in kde.hpp keep downstream translation units from
+ * re-instantiating (and re-compiling) the same code.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "kde.hpp"
+
+namespace mlpack {
+namespace kde {
+
+// Gaussian-kernel KDE with the L2 metric on dense data, using kd-trees and
+// ball trees.
+template class KDE<kernel::GaussianKernel, metric::EuclideanDistance>;
+template class KDE<kernel::GaussianKernel, metric::EuclideanDistance,
+    arma::mat, tree::BallTree>;
+
+} // namespace kde
+} // namespace mlpack
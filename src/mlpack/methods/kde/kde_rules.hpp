@@ -181,6 +181,136 @@ class KDERules
   size_t scores;
 };
 
+/**
+ * A traversal Rules class for simultaneous kernel density estimation at
+ * several bandwidths.  One traversal carries a vector of kernels; the
+ * distance bounds of each node combination are computed once and shared by
+ * every kernel, while each kernel is checked for pruning independently
+ * against its own accumulated error tolerance.  A node combination is
+ * recursed into only when at least one bandwidth still needs it, so
+ * evaluating k bandwidths is much cheaper than k separate traversals.
+ *
+ * Monte Carlo estimations are not used by these rules, so results are always
+ * within the exact error tolerance for every bandwidth.
+ */
+template<typename MetricType, typename KernelType, typename TreeType>
+class KDEMultiBandwidthRules
+{
+ public:
+  /**
+   * Construct KDEMultiBandwidthRules.
+   *
+   * @param referenceSet Reference set data.
+   * @param querySet Query set data.
+   * @param densities Matrix where estimations will be written; row i holds
+   *                  the densities for kernels[i].
+   * @param relError Relative error tolerance.
+   * @param absError Absolute error tolerance.
+   * @param metric Instantiated metric.
+   * @param kernels Instantiated kernels, one per bandwidth.
+   * @param sameSet True if query and reference sets are the same
+   *                (monochromatic evaluation).
+   */
+  KDEMultiBandwidthRules(const arma::mat& referenceSet,
+                         const arma::mat& querySet,
+                         arma::mat& densities,
+                         const double relError,
+                         const double absError,
+                         MetricType& metric,
+                         std::vector<KernelType>& kernels,
+                         const bool sameSet);
+
+  //! Base Case.
+  double BaseCase(const size_t queryIndex, const size_t referenceIndex);
+
+  //! SingleTree Score.
+  double Score(const size_t queryIndex, TreeType& referenceNode);
+
+  //! SingleTree Rescore.
+  double Rescore(const size_t queryIndex,
+                 TreeType& referenceNode,
+                 const double oldScore) const;
+
+  //! Dual-Tree Score.
+  double Score(TreeType& queryNode, TreeType& referenceNode);
+
+  //! Dual-Tree Rescore.
+  double Rescore(TreeType& queryNode,
+                 TreeType& referenceNode,
+                 const double oldScore) const;
+
+  typedef typename tree::TraversalInfo<TreeType> TraversalInfoType;
+
+  //! Get traversal information.
+  const TraversalInfoType& TraversalInfo() const { return traversalInfo; }
+
+  //! Modify traversal information.
+  TraversalInfoType& TraversalInfo() { return traversalInfo; }
+
+  //! Get the number of base cases.
+  size_t BaseCases() const { return baseCases; }
+
+  //! Get the number of scores.
+  size_t Scores() const { return scores; }
+
+  //! Get the minimum number of base cases we need to perform to have acceptable
+  //! results.
+  size_t MinimumBaseCases() const { return 0; }
+
+ private:
+  //! The reference set.
+  const arma::mat& referenceSet;
+
+  //! The query set.
+  const arma::mat& querySet;
+
+  //! Density values; one row per kernel.
+  arma::mat& densities;
+
+  //! Absolute error tolerance.
+  const double absError;
+
+  //! Relatve error tolerance.
+  const double relError;
+
+  //! Instantiated metric.
+  MetricType& metric;
+
+  //! Instantiated kernels, one per bandwidth.
+  std::vector<KernelType>& kernels;
+
+  //! Accumulated not used error tolerance for each kernel and query point,
+  //! used for single-tree pruning; one row per kernel.
+  arma::mat accumError;
+
+  //! Whether reference and query sets are the same.
+  const bool sameSet;
+
+  //! Absolute error tolerance available for each reference point.
+  const double absErrorTol;
+
+  //! The last query index.
+  size_t lastQueryIndex;
+
+  //! The last reference index.
+  size_t lastReferenceIndex;
+
+  //! Per-kernel maximum kernel value bound of the last scored combination.
+  arma::vec maxKernels;
+
+  //! Per-kernel minimum kernel value bound of the last scored combination.
+  arma::vec minKernels;
+
+  //! Traversal information.
+  TraversalInfoType traversalInfo;
+
+  //! The number of base cases.
+  size_t baseCases;
+
+  //! The number of scores.
+  size_t scores;
+};
+
 /**
  * A dual-tree traversal Rules class for cleaning used trees before performing
  * kernel density estimation.
@@ -189,8 +319,14 @@ template<typename TreeType>
 class KDECleanRules
 {
  public:
-  //! Construct KDECleanRules.
-  KDECleanRules() { /* Nothing to do. */ }
+  /**
+   * Construct KDECleanRules.
+   *
+   * @param numKernels Number of kernels of the following multi-bandwidth
+   *                   evaluation, or 0 if a single-bandwidth evaluation
+   *                   follows.
+   */
+  KDECleanRules(const size_t numKernels = 0) : numKernels(numKernels) { }
 
   //! Base Case.
   double BaseCase(const size_t /* queryIndex */, const size_t /* refIndex */);
@@ -220,6 +356,9 @@ class KDECleanRules
   TraversalInfoType& TraversalInfo() { return traversalInfo; }
 
  private:
+  //! Number of kernels of the following multi-bandwidth evaluation.
+  const size_t numKernels;
+
   //! Traversal information.
   TraversalInfoType traversalInfo;
 };
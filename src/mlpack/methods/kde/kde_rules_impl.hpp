@@ -573,6 +573,307 @@ CalculateAlpha(TreeType* node)
   return stat.MCAlpha();
 }
 
+template<typename MetricType, typename KernelType, typename TreeType>
+KDEMultiBandwidthRules<MetricType, KernelType, TreeType>::
+KDEMultiBandwidthRules(const arma::mat& referenceSet,
+                       const arma::mat& querySet,
+                       arma::mat& densities,
+                       const double relError,
+                       const double absError,
+                       MetricType& metric,
+                       std::vector<KernelType>& kernels,
+                       const bool sameSet) :
+    referenceSet(referenceSet),
+    querySet(querySet),
+    densities(densities),
+    absError(absError),
+    relError(relError),
+    metric(metric),
+    kernels(kernels),
+    sameSet(sameSet),
+    absErrorTol(absError / referenceSet.n_cols),
+    lastQueryIndex(querySet.n_cols),
+    lastReferenceIndex(referenceSet.n_cols),
+    baseCases(0),
+    scores(0)
+{
+  // Initialize accumError and per-kernel bound workspaces.
+  accumError = arma::mat(kernels.size(), querySet.n_cols, arma::fill::zeros);
+  maxKernels.set_size(kernels.size());
+  minKernels.set_size(kernels.size());
+}
+
+//! The multi-bandwidth base case.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline
+double KDEMultiBandwidthRules<MetricType, KernelType, TreeType>::BaseCase(
+    const size_t queryIndex,
+    const size_t referenceIndex)
+{
+  // If reference and query sets are the same we don't want to compute the
+  // estimation of a point with itself.
+  if (sameSet && (queryIndex == referenceIndex))
+    return 0.0;
+
+  // Avoid duplicated calculations.
+  if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
+    return 0.0;
+
+  // The distance is computed once and shared by every kernel.
+  const double distance = metric.Evaluate(querySet.col(queryIndex),
+                                          referenceSet.col(referenceIndex));
+  for (size_t b = 0; b < kernels.size(); ++b)
+  {
+    const double kernelValue = kernels[b].Evaluate(distance);
+    densities(b, queryIndex) += kernelValue;
+
+    // Update accumulated relative error tolerance for single-tree pruning.
+    accumError(b, queryIndex) += 2 * relError * kernelValue;
+  }
+
+  ++baseCases;
+  lastQueryIndex = queryIndex;
+  lastReferenceIndex = referenceIndex;
+  traversalInfo.LastBaseCase() = distance;
+  return distance;
+}
+
+//! Multi-bandwidth single-tree scoring function.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline double KDEMultiBandwidthRules<MetricType, KernelType, TreeType>::
+Score(const size_t queryIndex, TreeType& referenceNode)
+{
+  // Auxiliary variables.
+  const arma::vec& queryPoint = querySet.unsafe_col(queryIndex);
+  const size_t refNumDesc = referenceNode.NumDescendants();
+  double score, minDistance, maxDistance;
+  // Calculations are not duplicated.
+  bool alreadyDidRefPoint0 = false;
+
+  if (tree::TreeTraits<TreeType>::FirstPointIsCentroid &&
+      lastQueryIndex == queryIndex &&
+      traversalInfo.LastReferenceNode() != NULL &&
+      lastReferenceIndex == referenceNode.Point(0))
+  {
+    // Don't duplicate calculations.
+    alreadyDidRefPoint0 = true;
+    const double furthestDescDist = referenceNode.FurthestDescendantDistance();
+    minDistance = std::max(traversalInfo.LastBaseCase() - furthestDescDist,
+        0.0);
+    maxDistance = traversalInfo.LastBaseCase() + furthestDescDist;
+  }
+  else
+  {
+    // All Calculations are new.
+    const math::Range r = referenceNode.RangeDistance(queryPoint);
+    minDistance = r.Lo();
+    maxDistance = r.Hi();
+
+    // Check if we are a self-child.
+    if (tree::TreeTraits<TreeType>::HasSelfChildren &&
+        referenceNode.Parent() != NULL &&
+        referenceNode.Parent()->Point(0) == referenceNode.Point(0))
+    {
+      alreadyDidRefPoint0 = true;
+    }
+  }
+
+  const size_t refContributions =
+      alreadyDidRefPoint0 ? (refNumDesc - 1) : refNumDesc;
+
+  // Check each kernel for pruning independently; the node can only be pruned
+  // if every kernel satisfies its own bound.
+  bool canPrune = true;
+  for (size_t b = 0; b < kernels.size(); ++b)
+  {
+    maxKernels(b) = kernels[b].Evaluate(minDistance);
+    minKernels(b) = kernels[b].Evaluate(maxDistance);
+    const double bound = maxKernels(b) - minKernels(b);
+
+    // Error tolerance of the current combination of query point and reference
+    // node, relaxed by any leftover tolerance from the rest of the traversal.
+    const double errorTolerance = absErrorTol + relError * minKernels(b);
+    const double pointAccumErrorTol =
+        accumError(b, queryIndex) / refContributions;
+
+    if (bound > 2 * errorTolerance + pointAccumErrorTol)
+    {
+      canPrune = false;
+      break;
+    }
+  }
+
+  if (canPrune)
+  {
+    for (size_t b = 0; b < kernels.size(); ++b)
+    {
+      // Estimate kernel value.
+      const double kernelValue = (maxKernels(b) + minKernels(b)) / 2.0;
+      densities(b, queryIndex) += refContributions * kernelValue;
+
+      // Subtract used error tolerance or add extra available tolerance from
+      // this prune.
+      const double bound = maxKernels(b) - minKernels(b);
+      const double errorTolerance = absErrorTol + relError * minKernels(b);
+      accumError(b, queryIndex) -=
+          refContributions * (bound - 2 * errorTolerance);
+    }
+
+    // Don't explore this tree branch.
+    score = DBL_MAX;
+  }
+  else
+  {
+    // Recurse.
+    score = minDistance;
+
+    // Add accumulated unused absolute error tolerance.
+    if (referenceNode.IsLeaf())
+      for (size_t b = 0; b < kernels.size(); ++b)
+        accumError(b, queryIndex) += refContributions * 2 * absErrorTol;
+  }
+
+  ++scores;
+  traversalInfo.LastReferenceNode() = &referenceNode;
+  traversalInfo.LastScore() = score;
+  return score;
+}
+
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline double
+KDEMultiBandwidthRules<MetricType, KernelType, TreeType>::
+Rescore(const size_t /* queryIndex */,
+        TreeType& /* referenceNode */,
+        const double oldScore) const
+{
+  // If it's pruned it continues to be pruned.
+  return oldScore;
+}
+
+//! Multi-bandwidth dual-tree scoring function.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline double KDEMultiBandwidthRules<MetricType, KernelType, TreeType>::
+Score(TreeType& queryNode, TreeType& referenceNode)
+{
+  kde::KDEStat& queryStat = queryNode.Stat();
+  const size_t refNumDesc = referenceNode.NumDescendants();
+  double score, minDistance, maxDistance;
+  // Calculations are not duplicated.
+  bool alreadyDidRefPoint0 = false;
+
+  if (tree::TreeTraits<TreeType>::FirstPointIsCentroid &&
+      (traversalInfo.LastQueryNode() != NULL) &&
+      (traversalInfo.LastReferenceNode() != NULL) &&
+      (traversalInfo.LastQueryNode()->Point(0) == queryNode.Point(0)) &&
+      (traversalInfo.LastReferenceNode()->Point(0) == referenceNode.Point(0)))
+  {
+    // Don't duplicate calculations.
+    alreadyDidRefPoint0 = true;
+    lastQueryIndex = queryNode.Point(0);
+    lastReferenceIndex = referenceNode.Point(0);
+
+    // Calculate min and max distance.
+    const double refFurtDescDist = referenceNode.FurthestDescendantDistance();
+    const double queryFurtDescDist = queryNode.FurthestDescendantDistance();
+    const double sumFurtDescDist = refFurtDescDist + queryFurtDescDist;
+    minDistance = std::max(traversalInfo.LastBaseCase() - sumFurtDescDist, 0.0);
+    maxDistance = traversalInfo.LastBaseCase() + sumFurtDescDist;
+  }
+  else
+  {
+    // All calculations are new.
+    const math::Range r = queryNode.RangeDistance(referenceNode);
+    minDistance = r.Lo();
+    maxDistance = r.Hi();
+  }
+
+  // Check each kernel for pruning independently; the node combination can
+  // only be pruned if every kernel satisfies its own bound.
+  bool canPrune = true;
+  for (size_t b = 0; b < kernels.size(); ++b)
+  {
+    maxKernels(b) = kernels[b].Evaluate(minDistance);
+    minKernels(b) = kernels[b].Evaluate(maxDistance);
+    const double bound = maxKernels(b) - minKernels(b);
+
+    // Error tolerance of the current combination of query node and reference
+    // node, relaxed by any leftover tolerance from the rest of the traversal.
+    const double errorTolerance = absErrorTol + relError * minKernels(b);
+    const double pointAccumErrorTol =
+        queryStat.MultiAccumError()(b) / refNumDesc;
+
+    if (bound > 2 * errorTolerance + pointAccumErrorTol)
+    {
+      canPrune = false;
+      break;
+    }
+  }
+
+  // If possible, avoid some calculations because of the error tolerance.
+  if (canPrune)
+  {
+    for (size_t b = 0; b < kernels.size(); ++b)
+    {
+      // Estimate kernel value.
+      const double kernelValue = (maxKernels(b) + minKernels(b)) / 2.0;
+
+      // Sum up estimations.
+      for (size_t i = 0; i < queryNode.NumDescendants(); ++i)
+      {
+        if (alreadyDidRefPoint0 && i == 0)
+          densities(b, queryNode.Descendant(i)) +=
+              (refNumDesc - 1) * kernelValue;
+        else
+          densities(b, queryNode.Descendant(i)) += refNumDesc * kernelValue;
+      }
+
+      // Subtract used error tolerance or add extra available tolerance from
+      // this prune.
+      const double bound = maxKernels(b) - minKernels(b);
+      const double errorTolerance = absErrorTol + relError * minKernels(b);
+      queryStat.MultiAccumError()(b) -=
+          refNumDesc * (bound - 2 * errorTolerance);
+    }
+
+    // Prune.
+    score = DBL_MAX;
+  }
+  else
+  {
+    // Recurse.
+    score = minDistance;
+
+    // Add accumulated unused error tolerance.
+    if (referenceNode.IsLeaf() && queryNode.IsLeaf())
+    {
+      for (size_t b = 0; b < kernels.size(); ++b)
+      {
+        const double errorTolerance =
+            absErrorTol + relError * kernels[b].Evaluate(maxDistance);
+        queryStat.MultiAccumError()(b) += refNumDesc * 2 * errorTolerance;
+      }
+    }
+  }
+
+  ++scores;
+  traversalInfo.LastQueryNode() = &queryNode;
+  traversalInfo.LastReferenceNode() = &referenceNode;
+  traversalInfo.LastScore() = score;
+  return score;
+}
+
+//! Multi-bandwidth dual-tree rescore.
+template<typename MetricType, typename KernelType, typename TreeType>
+inline force_inline double
+KDEMultiBandwidthRules<MetricType, KernelType, TreeType>::
+Rescore(TreeType& /* queryNode */,
+        TreeType& /* referenceNode */,
+        const double oldScore) const
+{
+  // If a branch is pruned then it continues to be pruned.
+  return oldScore;
+}
+
 //! Clean rules base case.
 template<typename TreeType>
 inline force_inline
@@ -590,6 +891,7 @@ double KDECleanRules<TreeType>::Score(const size_t /* queryIndex */,
 {
   referenceNode.Stat().AccumAlpha() = 0;
   referenceNode.Stat().AccumError() = 0;
+  referenceNode.Stat().MultiAccumError().zeros(numKernels);
   return 0;
 }
 
@@ -605,6 +907,9 @@ double KDECleanRules<TreeType>::Score(TreeType& queryNode,
   queryNode.Stat().AccumError() = 0;
   referenceNode.Stat().AccumError() = 0;
 
+  queryNode.Stat().MultiAccumError().zeros(numKernels);
+  referenceNode.Stat().MultiAccumError().zeros(numKernels);
+
   return 0;
 }
 
@@ -65,6 +65,14 @@ class KDEStat
   //! Modify Monte Carlo alpha of the node.
   inline double& MCAlpha() { return mcAlpha; }
 
+  //! Get per-bandwidth accumulated error tolerance of the node, used by
+  //! multi-bandwidth evaluation.
+  inline const arma::vec& MultiAccumError() const { return multiAccumError; }
+
+  //! Modify per-bandwidth accumulated error tolerance of the node, used by
+  //! multi-bandwidth evaluation.
+  inline arma::vec& MultiAccumError() { return multiAccumError; }
+
   //! Serialize the statistic to/from an archive.
   template<typename Archive>
   void serialize(Archive& ar, const unsigned int version)
@@ -111,6 +119,11 @@ class KDEStat
 
   //! Accumulated not used error tolerance in the current node.
   double accumError;
+
+  //! Per-bandwidth accumulated not used error tolerance in the current node.
+  //! Only used during multi-bandwidth evaluation, and reset before every such
+  //! traversal, so it is not serialized.
+  arma::vec multiAccumError;
 };
 
 } // namespace kde
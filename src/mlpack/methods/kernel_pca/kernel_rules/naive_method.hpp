@@ -46,8 +46,10 @@ class NaiveKernelRule
 
   // Note that we only need to calculate the upper triangular part of the
   // kernel matrix, since it is symmetric. This helps minimize the number of
-  // kernel evaluations.
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // kernel evaluations.  The rows are independent, so the evaluations can run
+  // in parallel; dynamic scheduling accounts for the uneven row lengths.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < data.n_cols; ++i)
   {
     for (size_t j = i; j < data.n_cols; ++j)
     {
@@ -30,6 +30,14 @@ namespace kmeans {
  * dataset.  The conditions under which this will perform best are probably
  * limited to the case where k is close to the number of points in the dataset,
  * and the number of iterations of the k-means algorithm will be few.
+ *
+ * An approximate mode is also available: if Epsilon() is set to a nonzero
+ * value, each point may be assigned to any centroid whose distance is within
+ * a relative factor of (1 + epsilon) of the true closest centroid, and the
+ * tree built on the centroids is reused across iterations while the total
+ * centroid movement since it was built remains small relative to the
+ * inter-centroid separation.  This trades a small amount of objective slack
+ * for significantly cheaper iterations when k is large.
  */
 template<
     typename MetricType,
@@ -52,9 +60,12 @@ class DualTreeKMeans
 
   /**
    * Construct the DualTreeKMeans object, which will construct a tree on the
-   * points.
+   * points.  If epsilon is nonzero, the iterations are epsilon-approximate
+   * (see the class documentation).
    */
-  DualTreeKMeans(const MatType& dataset, MetricType& metric);
+  DualTreeKMeans(const MatType& dataset,
+                 MetricType& metric,
+                 const double epsilon = 0.0);
 
   /**
    * Delete the tree constructed by the DualTreeKMeans object.
@@ -78,6 +89,11 @@ class DualTreeKMeans
   //! Modify the number of distance calculations.
   size_t& DistanceCalculations() { return distanceCalculations; }
 
+  //! Return the relative approximation slack (0 means exact search).
+  double Epsilon() const { return epsilon; }
+  //! Modify the relative approximation slack (0 means exact search).
+  double& Epsilon() { return epsilon; }
+
  private:
   //! The original dataset reference.
   const MatType& datasetOrig; // Maybe not necessary.
@@ -93,6 +109,16 @@ class DualTreeKMeans
   //! Track iteration number.
   size_t iteration;
 
+  //! Relative approximation slack for pruning (0 means exact search).
+  double epsilon;
+  //! The tree built on the centroids, kept across iterations so that it can
+  //! be reused in approximate mode.
+  Tree* centroidTree;
+  //! Mappings from new centroid indices to old ones, for the centroid tree.
+  std::vector<size_t> oldFromNewCentroids;
+  //! Total centroid movement since the centroid tree was last rebuilt.
+  double movementSinceRebuild;
+
   //! Upper bounds on nearest centroid.
   arma::vec upperBounds;
   //! Lower bounds on second closest cluster distance for each point.
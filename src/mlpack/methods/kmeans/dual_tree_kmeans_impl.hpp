@@ -54,13 +54,17 @@ template<typename MetricType,
                   typename TreeMatType> class TreeType>
 DualTreeKMeans<MetricType, MatType, TreeType>::DualTreeKMeans(
     const MatType& dataset,
-    MetricType& metric) :
+    MetricType& metric,
+    const double epsilon) :
     datasetOrig(dataset),
     tree(new Tree(const_cast<MatType&>(dataset))),
     dataset(tree->Dataset()),
     metric(metric),
     distanceCalculations(0),
     iteration(0),
+    epsilon(epsilon),
+    centroidTree(NULL),
+    movementSinceRebuild(0.0),
     upperBounds(dataset.n_cols),
     lowerBounds(dataset.n_cols),
     prunedPoints(dataset.n_cols, false), // Fill with false.
@@ -86,6 +90,8 @@ DualTreeKMeans<MetricType, MatType, TreeType>::~DualTreeKMeans()
 {
   if (tree)
     delete tree;
+  if (centroidTree)
+    delete centroidTree;
 }
 
 // Run a single iteration.
@@ -99,43 +105,99 @@ double DualTreeKMeans<MetricType, MatType, TreeType>::Iterate(
     arma::mat& newCentroids,
     arma::Col<size_t>& counts)
 {
-  // Build a tree on the centroids.  This will make a copy if necessary, which
-  // is unfortunate, but I don't see a reasonable way around it.
-  std::vector<size_t> oldFromNewCentroids;
-  Tree* centroidTree = BuildTree<Tree>(centroids, oldFromNewCentroids);
+  // Keep track of how far the centroids have moved since the centroid tree
+  // was built; in approximate mode this decides whether the tree can be
+  // reused.
+  if (iteration > 0)
+    movementSinceRebuild += clusterDistances[centroids.n_cols];
+
+  // In approximate mode, reuse the centroid tree from earlier iterations
+  // while the accumulated movement remains small relative to the separation
+  // between the centroids (the inter-cluster distances have only been
+  // computed after the first iteration, so we cannot reuse before then).
+  const bool reuseTree = (epsilon > 0.0) && (centroidTree != NULL) &&
+      (iteration > 1) &&
+      (2.0 * movementSinceRebuild <= epsilon * interclusterDistances.min());
 
-  // Find the nearest neighbors of each of the clusters.  We have to make our
-  // own TreeType, which is a little bit abuse, but we know for sure the
-  // TreeStatType we have will work.
-  neighbor::NeighborSearch<neighbor::NearestNeighborSort, MetricType, MatType,
-      NNSTreeType> nns(std::move(*centroidTree));
+  if (!reuseTree)
+  {
+    // Build a tree on the centroids.  This will make a copy if necessary,
+    // which is unfortunate, but I don't see a reasonable way around it.
+    if (centroidTree)
+      delete centroidTree;
+    oldFromNewCentroids.clear();
+    centroidTree = BuildTree<Tree>(centroids, oldFromNewCentroids);
+    movementSinceRebuild = 0.0;
+  }
+  else
+  {
+    // Refresh the centroid positions stored in the cached tree, so that base
+    // cases are still computed against the current centroids.  The node
+    // bounds are left stale; the rules compensate by loosening every prune
+    // by the accumulated movement, which stays within the allowed slack.
+    typename Tree::Mat& treeCentroids =
+        const_cast<typename Tree::Mat&>(centroidTree->Dataset());
+    if (tree::TreeTraits<Tree>::RearrangesDataset)
+    {
+      for (size_t i = 0; i < centroids.n_cols; ++i)
+        treeCentroids.col(i) = centroids.col(oldFromNewCentroids[i]);
+    }
+    else
+    {
+      treeCentroids = centroids;
+    }
+  }
 
   // Reset information in the tree, if we need to.
   if (iteration > 0)
   {
-    Timer::Start("knn");
+    if (!reuseTree)
+    {
+      // Find the nearest neighbors of each of the clusters.  We have to make
+      // our own TreeType, which is a little bit abuse, but we know for sure
+      // the TreeStatType we have will work.
+      neighbor::NeighborSearch<neighbor::NearestNeighborSort, MetricType,
+          MatType, NNSTreeType> nns(std::move(*centroidTree));
 
-    // If the tree maps points, we need an intermediate result matrix.
-    arma::mat* interclusterDistancesTemp =
-        (tree::TreeTraits<Tree>::RearrangesDataset) ?
-        new arma::mat(1, centroids.n_elem) : &interclusterDistances;
+      Timer::Start("knn");
 
-    arma::Mat<size_t> closestClusters; // We don't actually care about these.
-    nns.Search(1, closestClusters, *interclusterDistancesTemp);
-    distanceCalculations += nns.BaseCases() + nns.Scores();
+      // If the tree maps points, we need an intermediate result matrix.
+      arma::mat* interclusterDistancesTemp =
+          (tree::TreeTraits<Tree>::RearrangesDataset) ?
+          new arma::mat(1, centroids.n_elem) : &interclusterDistances;
 
-    // We need to do the unmapping ourselves, if the tree does mapping.
-    if (tree::TreeTraits<Tree>::RearrangesDataset)
+      arma::Mat<size_t> closestClusters; // We don't actually care about these.
+      nns.Search(1, closestClusters, *interclusterDistancesTemp);
+      distanceCalculations += nns.BaseCases() + nns.Scores();
+
+      // We need to do the unmapping ourselves, if the tree does mapping.
+      if (tree::TreeTraits<Tree>::RearrangesDataset)
+      {
+        for (size_t i = 0; i < interclusterDistances.n_elem; ++i)
+          interclusterDistances[oldFromNewCentroids[i]] =
+              (*interclusterDistancesTemp)[i];
+
+        delete interclusterDistancesTemp;
+      }
+
+      Timer::Stop("knn");
+
+      // Take the tree back from the NeighborSearch object, so that it can be
+      // reused by later iterations.
+      *centroidTree = std::move(nns.ReferenceTree());
+    }
+    else
     {
+      // The cached inter-cluster distances are stale; age them
+      // conservatively (each pair of centroids has moved by at most the last
+      // iteration's maximum movement, so each gap has shrunk by at most
+      // twice that).
+      const double lastMovement = clusterDistances[centroids.n_cols];
       for (size_t i = 0; i < interclusterDistances.n_elem; ++i)
-        interclusterDistances[oldFromNewCentroids[i]] =
-            (*interclusterDistancesTemp)[i];
-
-      delete interclusterDistancesTemp;
+        interclusterDistances[i] = std::max(0.0,
+            interclusterDistances[i] - 2.0 * lastMovement);
     }
 
-    Timer::Stop("knn");
-
     UpdateTree(*tree, centroids);
 
     for (size_t i = 0; i < dataset.n_cols; ++i)
@@ -151,9 +213,9 @@ double DualTreeKMeans<MetricType, MatType, TreeType>::Iterate(
   // We won't use the KNN class here because we have our own set of rules.
   lastIterationCentroids = centroids;
   typedef DualTreeKMeansRules<MetricType, Tree> RuleType;
-  RuleType rules(nns.ReferenceTree().Dataset(), dataset, assignments,
+  RuleType rules(centroidTree->Dataset(), dataset, assignments,
       upperBounds, lowerBounds, metric, prunedPoints, oldFromNewCentroids,
-      visited);
+      visited, epsilon, reuseTree ? movementSinceRebuild : 0.0);
 
   typename Tree::template BreadthFirstDualTreeTraverser<RuleType>
       traverser(rules);
@@ -164,7 +226,7 @@ double DualTreeKMeans<MetricType, MatType, TreeType>::Iterate(
 
   // Set the number of pruned centroids in the root to 0.
   tree->Stat().Pruned() = 0;
-  traverser.Traverse(*tree, nns.ReferenceTree());
+  traverser.Traverse(*tree, *centroidTree);
   distanceCalculations += rules.BaseCases() + rules.Scores();
 
   Timer::Start("tree_mod");
@@ -199,8 +261,8 @@ double DualTreeKMeans<MetricType, MatType, TreeType>::Iterate(
   }
   distanceCalculations += centroids.n_cols;
 
-  delete centroidTree;
-
+  // The centroid tree is kept, so that approximate mode can reuse it on the
+  // next iteration; it is freed by the destructor (or the next rebuild).
   ++iteration;
 
   return std::sqrt(residual);
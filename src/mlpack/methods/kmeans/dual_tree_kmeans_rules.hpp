@@ -23,6 +23,14 @@ template<typename MetricType, typename TreeType>
 class DualTreeKMeansRules
 {
  public:
+  /**
+   * Construct the rules.  If epsilon is nonzero, every prune is allowed a
+   * relative slack of (1 + epsilon), giving epsilon-approximate nearest
+   * centroid assignments.  If staleness is nonzero, the bounds of the
+   * reference (centroid) tree are assumed to be stale by up to that amount
+   * (because the centroids have moved since the tree was built), and every
+   * node-to-node bound is loosened accordingly.
+   */
   DualTreeKMeansRules(const arma::mat& centroids,
                       const arma::mat& dataset,
                       arma::Row<size_t>& assignments,
@@ -31,7 +39,9 @@ class DualTreeKMeansRules
                       MetricType& metric,
                       const std::vector<bool>& prunedPoints,
                       const std::vector<size_t>& oldFromNewCentroids,
-                      std::vector<bool>& visited);
+                      std::vector<bool>& visited,
+                      const double epsilon = 0.0,
+                      const double staleness = 0.0);
 
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
@@ -73,6 +83,11 @@ class DualTreeKMeansRules
 
   std::vector<bool>& visited;
 
+  //! Relative slack allowed on each prune (0 means exact pruning).
+  const double epsilon;
+  //! Amount by which the reference tree bounds may be stale.
+  const double staleness;
+
   size_t baseCases;
   size_t scores;
 
@@ -81,6 +96,21 @@ class DualTreeKMeansRules
   size_t lastQueryIndex;
   size_t lastReferenceIndex;
   size_t lastBaseCase;
+
+  //! Turn a lower bound on a node-to-node distance into the relaxed value
+  //! used for pruning: the bound is first reduced by the staleness of the
+  //! reference tree, and then inflated by the approximation slack.
+  double Relax(const double bound) const
+  {
+    return std::max(bound - staleness, 0.0) * (1.0 + epsilon);
+  }
+
+  //! Reduce a lower bound by the staleness of the reference tree, so that it
+  //! remains a valid lower bound on the true distance when it is cached.
+  double Destale(const double bound) const
+  {
+    return std::max(bound - staleness, 0.0);
+  }
 };
 
 } // namespace kmeans
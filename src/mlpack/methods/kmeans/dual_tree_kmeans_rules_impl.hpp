@@ -27,7 +27,9 @@ DualTreeKMeansRules<MetricType, TreeType>::DualTreeKMeansRules(
     MetricType& metric,
     const std::vector<bool>& prunedPoints,
     const std::vector<size_t>& oldFromNewCentroids,
-    std::vector<bool>& visited) :
+    std::vector<bool>& visited,
+    const double epsilon,
+    const double staleness) :
     centroids(centroids),
     dataset(dataset),
     assignments(assignments),
@@ -37,6 +39,8 @@ DualTreeKMeansRules<MetricType, TreeType>::DualTreeKMeansRules(
     prunedPoints(prunedPoints),
     oldFromNewCentroids(oldFromNewCentroids),
     visited(visited),
+    epsilon(epsilon),
+    staleness(staleness),
     baseCases(0),
     scores(0),
     lastQueryIndex(dataset.n_cols),
@@ -210,7 +214,7 @@ inline double DualTreeKMeansRules<MetricType, TreeType>::Score(
   }
 
   // Now, check if we can prune.
-  if (adjustedScore > queryNode.Stat().UpperBound())
+  if (Relax(adjustedScore) > queryNode.Stat().UpperBound())
   {
     if (!(tree::TreeTraits<TreeType>::FirstPointIsCentroid && score == 0.0))
     {
@@ -221,7 +225,7 @@ inline double DualTreeKMeansRules<MetricType, TreeType>::Score(
       {
         // If this might affect the lower bound, make it more exact.
         queryNode.Stat().LowerBound() = std::min(queryNode.Stat().LowerBound(),
-            queryNode.MinDistance(referenceNode));
+            Destale(queryNode.MinDistance(referenceNode)));
         ++scores;
       }
 
@@ -237,12 +241,12 @@ inline double DualTreeKMeansRules<MetricType, TreeType>::Score(
 
     score = distances.Lo();
     ++scores;
-    if (distances.Lo() > queryNode.Stat().UpperBound())
+    if (Relax(distances.Lo()) > queryNode.Stat().UpperBound())
     {
       // The reference node can own no points in this query node.  We may
       // improve the lower bound on pruned nodes, though.
-      if (distances.Lo() < queryNode.Stat().LowerBound())
-        queryNode.Stat().LowerBound() = distances.Lo();
+      if (Destale(distances.Lo()) < queryNode.Stat().LowerBound())
+        queryNode.Stat().LowerBound() = Destale(distances.Lo());
 
       // This assumes that reference clusters don't appear elsewhere in the
       // tree.
@@ -312,11 +316,11 @@ inline double DualTreeKMeansRules<MetricType, TreeType>::Rescore(
   // oldScore contains the minimum distance between queryNode and referenceNode.
   // In the time since Score() has been called, the upper bound *may* have
   // tightened.  If it has tightened enough, we may prune this node now.
-  if (oldScore > queryNode.Stat().UpperBound())
+  if (Relax(oldScore) > queryNode.Stat().UpperBound())
   {
     // We may still be able to improve the lower bound on pruned nodes.
-    if (oldScore < queryNode.Stat().LowerBound())
-      queryNode.Stat().LowerBound() = oldScore;
+    if (Destale(oldScore) < queryNode.Stat().LowerBound())
+      queryNode.Stat().LowerBound() = Destale(oldScore);
 
     // This assumes that reference clusters don't appear elsewhere in the tree.
     queryNode.Stat().Pruned() += referenceNode.NumDescendants();
@@ -0,0 +1,115 @@
+/**
+ * @file methods/kmeans/kmeans_parallel_initialization.hpp
+ * @author Ryan Curtin
+ *
+ * An implementation of the k-means|| ("k-means parallel") initialization
+ * strategy of Bahmani et al.  This chooses initial centroids of similar
+ * quality to k-means++, but in O(log k) passes over the data instead of k
+ * sequential ones, with each pass parallelized over the points.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * An initial centroid selection strategy implementing the k-means|| algorithm
+ * from the following paper:
+ *
+ * @code
+ * @article{bahmani2012scalable,
+ *   title={Scalable k-means++},
+ *   author={Bahmani, Bahman and Moseley, Benjamin and Vattani, Andrea and
+ *       Kumar, Ravi and Vassilvitskii, Sergei},
+ *   journal={Proceedings of the VLDB Endowment},
+ *   volume={5},
+ *   number={7},
+ *   pages={622--633},
+ *   year={2012}
+ * }
+ * @endcode
+ *
+ * Instead of choosing k centroids one at a time with D^2-weighting (as
+ * k-means++ does), k-means|| runs a small number of rounds; in each round,
+ * every point is independently sampled with probability proportional to its
+ * squared distance from the candidate set, oversampling by a factor of l per
+ * round.  The resulting O(l log k) candidates are then weighted by the number
+ * of points they attract and reduced to k centroids with a (cheap, since the
+ * candidate set is tiny) weighted k-means++ pass.  Each round is a single
+ * parallel sweep over the dataset, so this scales to large datasets and large
+ * k where sequential k-means++ seeding is a bottleneck.
+ *
+ * Distances are measured with the squared Euclidean metric, matching the
+ * k-means objective.  This class can be used as the InitialPartitionPolicy
+ * template parameter of the KMeans class.
+ */
+class KMeansParallelInitialization
+{
+ public:
+  /**
+   * Create the KMeansParallelInitialization object, optionally specifying the
+   * number of sampling rounds and the per-round oversampling factor (the
+   * expected number of candidates chosen per round is oversampling * clusters;
+   * the paper suggests an oversampling factor between 0.5 and 2).
+   *
+   * @param rounds Number of sampling rounds to perform.
+   * @param oversampling Oversampling factor l, as a multiple of the number of
+   *      clusters.
+   */
+  KMeansParallelInitialization(const size_t rounds = 5,
+                               const double oversampling = 2.0) :
+      rounds(rounds), oversampling(oversampling) { }
+
+  /**
+   * Initialize the centroids matrix using the k-means|| sampling scheme.
+   *
+   * @tparam MatType Type of data (arma::mat or arma::sp_mat).
+   * @param data Dataset.
+   * @param clusters Number of clusters.
+   * @param centroids Matrix to put initial centroids into.
+   */
+  template<typename MatType>
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::mat& centroids) const;
+
+  //! Get the number of sampling rounds.
+  size_t Rounds() const { return rounds; }
+  //! Modify the number of sampling rounds.
+  size_t& Rounds() { return rounds; }
+
+  //! Get the oversampling factor.
+  double Oversampling() const { return oversampling; }
+  //! Modify the oversampling factor.
+  double& Oversampling() { return oversampling; }
+
+  //! Serialize the object.
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(rounds);
+    ar & BOOST_SERIALIZATION_NVP(oversampling);
+  }
+
+ private:
+  //! The number of sampling rounds to perform.
+  size_t rounds;
+  //! The oversampling factor (multiple of the number of clusters).
+  double oversampling;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "kmeans_parallel_initialization_impl.hpp"
+
+#endif
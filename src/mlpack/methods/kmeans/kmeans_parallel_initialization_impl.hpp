@@ -0,0 +1,191 @@
+/**
+ * @file methods/kmeans/kmeans_parallel_initialization_impl.hpp
+ * @author Ryan Curtin
+ *
+ * An implementation of the k-means|| ("k-means parallel") initialization
+ * strategy of Bahmani et al.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kmeans_parallel_initialization.hpp"
+
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/math/random.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MatType>
+void KMeansParallelInitialization::Cluster(const MatType& data,
+                                           const size_t clusters,
+                                           arma::mat& centroids) const
+{
+  // Candidate centers; we expect about (1 + rounds * oversampling * clusters)
+  // of them.
+  std::vector<size_t> candidates;
+  candidates.reserve(1 + (size_t) (rounds * oversampling * clusters));
+
+  // Squared distance from each point to the nearest candidate so far.
+  arma::vec minDistances(data.n_cols);
+  minDistances.fill(DBL_MAX);
+
+  // Sample the first candidate uniformly at random.
+  candidates.push_back(math::RandInt(0, (int) data.n_cols));
+
+  // The expected number of candidates drawn in each round.
+  const double l = oversampling * clusters;
+
+  size_t firstNew = 0; // Candidates before this index already have their
+                       // distances folded into minDistances.
+  for (size_t round = 0; round < rounds + 1; ++round)
+  {
+    // Fold the candidates added in the last round into the per-point nearest
+    // squared distances, and compute the current cost.  This is the parallel
+    // sweep; each point is independent.
+    double cost = 0.0;
+    #pragma omp parallel for reduction(+:cost)
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      for (size_t j = firstNew; j < candidates.size(); ++j)
+      {
+        const double distance = metric::SquaredEuclideanDistance::Evaluate(
+            data.col(i), data.col(candidates[j]));
+        if (distance < minDistances(i))
+          minDistances(i) = distance;
+      }
+      cost += minDistances(i);
+    }
+    firstNew = candidates.size();
+
+    // The last pass only needed to update the distances for the weighting
+    // step below; and if the cost has hit zero, further sampling is useless.
+    if (round == rounds || cost == 0.0)
+      break;
+
+    // Sample each point independently with probability min(1, l * d^2 / cost).
+    #pragma omp parallel
+    {
+      std::vector<size_t> localCandidates;
+
+      #pragma omp for
+      for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+      {
+        if (math::Random() < l * minDistances(i) / cost)
+          localCandidates.push_back((size_t) i);
+      }
+
+      #pragma omp critical
+      {
+        candidates.insert(candidates.end(), localCandidates.begin(),
+            localCandidates.end());
+      }
+    }
+  }
+
+  // If we somehow gathered fewer candidates than clusters, pad with uniform
+  // random points (matching SampleInitialization's behavior).
+  while (candidates.size() < clusters)
+    candidates.push_back(math::RandInt(0, (int) data.n_cols));
+
+  // Weight each candidate by the number of points closest to it.
+  arma::vec weights(candidates.size(), arma::fill::zeros);
+  #pragma omp parallel
+  {
+    arma::vec localWeights(candidates.size(), arma::fill::zeros);
+
+    #pragma omp for
+    for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+    {
+      double best = DBL_MAX;
+      size_t closest = 0;
+      for (size_t j = 0; j < candidates.size(); ++j)
+      {
+        const double distance = metric::SquaredEuclideanDistance::Evaluate(
+            data.col(i), data.col(candidates[j]));
+        if (distance < best)
+        {
+          best = distance;
+          closest = j;
+        }
+      }
+      localWeights(closest) += 1.0;
+    }
+
+    #pragma omp critical
+    {
+      weights += localWeights;
+    }
+  }
+
+  // Now reduce the candidate set to k centroids with a weighted k-means++
+  // pass.  The candidate set is O(l log k) points, so this sequential step is
+  // cheap.
+  centroids.set_size(data.n_rows, clusters);
+
+  // First centroid: sampled with probability proportional to weight.
+  arma::vec candidateDistances(candidates.size());
+  candidateDistances.fill(DBL_MAX);
+  double target = math::Random() * arma::accu(weights);
+  size_t chosen = 0;
+  for (size_t j = 0; j < candidates.size(); ++j)
+  {
+    target -= weights(j);
+    if (target <= 0.0)
+    {
+      chosen = j;
+      break;
+    }
+  }
+  centroids.col(0) = arma::vec(data.col(candidates[chosen]));
+
+  for (size_t c = 1; c < clusters; ++c)
+  {
+    // Update candidate distances against the last chosen centroid, and
+    // compute the total weighted cost.
+    double totalCost = 0.0;
+    for (size_t j = 0; j < candidates.size(); ++j)
+    {
+      const double distance = metric::SquaredEuclideanDistance::Evaluate(
+          arma::vec(data.col(candidates[j])), centroids.col(c - 1));
+      if (distance < candidateDistances(j))
+        candidateDistances(j) = distance;
+      totalCost += weights(j) * candidateDistances(j);
+    }
+
+    if (totalCost == 0.0)
+    {
+      // All remaining candidates coincide with chosen centroids; fall back to
+      // uniform random points.
+      centroids.col(c) = arma::vec(data.col(math::RandInt(0,
+          (int) data.n_cols)));
+      continue;
+    }
+
+    // Sample the next centroid with probability proportional to
+    // weight * d^2.
+    target = math::Random() * totalCost;
+    chosen = candidates.size() - 1;
+    for (size_t j = 0; j < candidates.size(); ++j)
+    {
+      target -= weights(j) * candidateDistances(j);
+      if (target <= 0.0)
+      {
+        chosen = j;
+        break;
+      }
+    }
+    centroids.col(c) = arma::vec(data.col(candidates[chosen]));
+  }
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
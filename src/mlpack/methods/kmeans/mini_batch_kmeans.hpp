@@ -0,0 +1,113 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans.hpp
+ * @author Ryan Curtin
+ *
+ * An implementation of mini-batch k-means (Sculley, 2010) as a Lloyd step
+ * policy.  Each call to Iterate() samples a small batch of points instead of
+ * scanning the entire dataset, so very large datasets can be clustered in a
+ * small fraction of the time a full Lloyd iteration would take.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * This is an implementation of a single mini-batch iteration of k-means, as
+ * described in the following paper:
+ *
+ * @code
+ * @inproceedings{sculley2010web,
+ *   title={Web-scale k-means clustering},
+ *   author={Sculley, David},
+ *   booktitle={Proceedings of the 19th International Conference on the World
+ *       Wide Web (WWW 2010)},
+ *   pages={1177--1178},
+ *   year={2010}
+ * }
+ * @endcode
+ *
+ * Each iteration samples a batch of points uniformly at random (with
+ * replacement), assigns each sampled point to its closest centroid, and moves
+ * each centroid towards the points assigned to it with a per-centroid learning
+ * rate of 1 / (number of points ever assigned to that centroid).  The result
+ * is an approximation of the full Lloyd iteration whose cost is proportional
+ * to the batch size instead of the dataset size.
+ *
+ * This class can be used as the LloydStepType template parameter of the KMeans
+ * class.  Because the centroids only move a little in each iteration, the
+ * residual returned by Iterate() shrinks as the per-centroid learning rates
+ * decay, and the usual KMeans convergence check applies unchanged.
+ *
+ * The counts reported to the caller are cumulative over all iterations, since
+ * a single small batch may legitimately miss a cluster that is not empty.
+ *
+ * @tparam MetricType Type of metric used with this implementation.
+ * @tparam MatType Matrix type (arma::mat or arma::sp_mat).
+ */
+template<typename MetricType, typename MatType>
+class MiniBatchKMeans
+{
+ public:
+  /**
+   * Construct the MiniBatchKMeans object with the given dataset and metric.
+   * The batch size defaults to 1000 points (or the dataset size, if smaller);
+   * use BatchSize() to change it before the first call to Iterate().
+   *
+   * @param dataset Dataset.
+   * @param metric Instantiated metric.
+   */
+  MiniBatchKMeans(const MatType& dataset, MetricType& metric);
+
+  /**
+   * Run a single mini-batch iteration, updating the given centroids into the
+   * newCentroids matrix.  Centroids that are not sampled in this batch are
+   * copied unchanged.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Cumulative number of points assigned to each cluster over
+   *      all iterations so far.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+  //! Get the batch size.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the batch size.
+  size_t& BatchSize() { return batchSize; }
+
+ private:
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated metric.
+  MetricType& metric;
+
+  //! Number of points sampled in each iteration.
+  size_t batchSize;
+  //! Cumulative per-centroid assignment counts (the learning rate for centroid
+  //! j is 1 / centerCounts(j)).
+  arma::Col<size_t> centerCounts;
+
+  //! Number of distance calculations.
+  size_t distanceCalculations;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "mini_batch_kmeans_impl.hpp"
+
+#endif
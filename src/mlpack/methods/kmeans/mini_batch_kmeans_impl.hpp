@@ -0,0 +1,105 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans_impl.hpp
+ * @author Ryan Curtin
+ *
+ * An implementation of mini-batch k-means (Sculley, 2010) as a Lloyd step
+ * policy.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mini_batch_kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename MatType>
+MiniBatchKMeans<MetricType, MatType>::MiniBatchKMeans(const MatType& dataset,
+                                                      MetricType& metric) :
+    dataset(dataset),
+    metric(metric),
+    batchSize(std::min((size_t) 1000, (size_t) dataset.n_cols)),
+    distanceCalculations(0)
+{ /* Nothing to do. */ }
+
+// Run a single mini-batch iteration.
+template<typename MetricType, typename MatType>
+double MiniBatchKMeans<MetricType, MatType>::Iterate(
+    const arma::mat& centroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  // On the first iteration, the cumulative counts must be initialized.
+  if (centerCounts.n_elem != centroids.n_cols)
+    centerCounts.zeros(centroids.n_cols);
+
+  // Centroids that receive no points in this batch keep their position.
+  newCentroids = centroids;
+
+  // Sample the batch uniformly at random, with replacement, and assign each
+  // sampled point to its closest centroid.  The assignments are computed in
+  // parallel; the learning-rate updates below are sequential, since their
+  // order matters to the per-centroid rates.
+  arma::uvec batch(batchSize);
+  for (size_t i = 0; i < batchSize; ++i)
+    batch[i] = math::RandInt(0, (int) dataset.n_cols);
+
+  arma::Row<size_t> assignments(batchSize);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) batchSize; ++i)
+  {
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroids.n_cols; // Invalid value.
+
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+    {
+      const double distance = metric.Evaluate(dataset.col(batch[i]),
+          centroids.unsafe_col(j));
+      if (distance < minDistance)
+      {
+        minDistance = distance;
+        closestCluster = j;
+      }
+    }
+
+    Log::Assert(closestCluster != centroids.n_cols);
+    assignments[i] = closestCluster;
+  }
+
+  // Apply the gradient step for each sampled point: move the centroid towards
+  // the point with a learning rate that decays with the number of points the
+  // centroid has ever been assigned.
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    const size_t cluster = assignments[i];
+    centerCounts(cluster)++;
+    const double eta = 1.0 / (double) centerCounts(cluster);
+    newCentroids.col(cluster) = (1.0 - eta) * newCentroids.col(cluster) +
+        eta * arma::vec(dataset.col(batch[i]));
+  }
+
+  counts = centerCounts;
+  distanceCalculations += centroids.n_cols * batchSize;
+
+  // Calculate centroid movement for this iteration.
+  double cNorm = 0.0;
+  for (size_t i = 0; i < centroids.n_cols; ++i)
+  {
+    cNorm += std::pow(metric.Evaluate(centroids.col(i), newCentroids.col(i)),
+        2.0);
+  }
+  distanceCalculations += centroids.n_cols;
+
+  return std::sqrt(cNorm);
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -15,6 +15,8 @@
 #ifndef MLPACK_METHODS_KMEANS_NAIVE_KMEANS_HPP
 #define MLPACK_METHODS_KMEANS_NAIVE_KMEANS_HPP
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/metrics/pairwise_distances.hpp>
+#include <mlpack/core/util/parallel.hpp>
 
 namespace mlpack {
 namespace kmeans {
@@ -36,49 +36,57 @@ double NaiveKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
                                                  arma::mat& newCentroids,
                                                  arma::Col<size_t>& counts)
 {
-  newCentroids.zeros(centroids.n_rows, centroids.n_cols);
-  counts.zeros(centroids.n_cols);
-
   // Find the closest centroid to each point and update the new centroids.
-  // Computed in parallel over the complete dataset
-  #pragma omp parallel
-  {
-    // The current state of the K-means is private for each thread
-    arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
-        arma::fill::zeros);
-    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
-
-    #pragma omp for
-    for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
-    {
-      // Find the closest centroid to this point.
-      double minDistance = std::numeric_limits<double>::infinity();
-      size_t closestCluster = centroids.n_cols; // Invalid value.
-
-      for (size_t j = 0; j < centroids.n_cols; ++j)
+  // The points are processed in blocks of columns, so that all centroid-point
+  // distances of a block can be computed at once with PairwiseDistances() --
+  // a single matrix multiplication for the L2 metrics -- while the block of
+  // distances stays small enough to be cache-friendly.  Blocks are computed
+  // in parallel over the complete dataset, each thread accumulating into its
+  // own partial centroid state; Parallel::ReduceFor() combines the partials
+  // (in a fixed order, so the result is reproducible when deterministic
+  // reductions are requested).
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (dataset.n_cols + blockSize - 1) / blockSize;
+
+  // The current state of the K-means is private for each thread.
+  typedef std::pair<arma::mat, arma::Col<size_t>> PartialType;
+  const PartialType identity(
+      arma::mat(centroids.n_rows, centroids.n_cols, arma::fill::zeros),
+      arma::Col<size_t>(centroids.n_cols, arma::fill::zeros));
+
+  PartialType result = Parallel::ReduceFor(numBlocks, identity,
+      [&](PartialType& partial, const size_t block)
       {
-        const double distance = metric.Evaluate(dataset.col(i),
-            centroids.unsafe_col(j));
-        if (distance < minDistance)
+        const size_t begin = block * blockSize;
+        const size_t end = std::min(begin + blockSize,
+            (size_t) dataset.n_cols);
+
+        // Materializing the block keeps the batch kernel applicable to sparse
+        // datasets, whose subviews do not support all of its operations.
+        const MatType blockPoints(dataset.cols(begin, end - 1));
+        arma::mat distances;
+        metric::PairwiseDistances(centroids, blockPoints, distances, metric);
+
+        for (size_t j = 0; j < distances.n_cols; ++j)
         {
-          minDistance = distance;
-          closestCluster = j;
+          // Find the closest centroid to this point.
+          arma::uword closestCluster;
+          distances.unsafe_col(j).min(closestCluster);
+
+          // We now have the minimum distance centroid index.  Update that
+          // centroid.
+          partial.first.unsafe_col(closestCluster) += blockPoints.col(j);
+          partial.second(closestCluster)++;
         }
-      }
-
-      Log::Assert(closestCluster != centroids.n_cols);
-
-      // We now have the minimum distance centroid index.  Update that centroid.
-      localCentroids.unsafe_col(closestCluster) += dataset.col(i);
-      localCounts(closestCluster)++;
-    }
-    // Combine calculated state from each thread
-    #pragma omp critical
-    {
-      newCentroids += localCentroids;
-      counts += localCounts;
-    }
-  }
+      },
+      [](PartialType& to, PartialType& from)
+      {
+        to.first += from.first;
+        to.second += from.second;
+      });
+
+  newCentroids = std::move(result.first);
+  counts = std::move(result.second);
 
   // Now normalize the centroid.
   for (size_t i = 0; i < centroids.n_cols; ++i)
@@ -360,8 +360,10 @@ double LARS::Train(const arma::mat& matX,
     // If not all variables are active.
     if ((activeSet.size() + ignoreSet.size()) < dataRef.n_cols)
     {
-      // Compute correlations with direction.
-      for (size_t ind = 0; ind < dataRef.n_cols; ind++)
+      // Compute correlations with direction.  Each inactive dimension is
+      // independent, so the search for the step size can run in parallel.
+      #pragma omp parallel for schedule(static) reduction(min:gamma)
+      for (omp_size_t ind = 0; ind < (omp_size_t) dataRef.n_cols; ind++)
       {
         if (isActive[ind] || isIgnored[ind])
           continue;
@@ -428,7 +430,12 @@ double LARS::Train(const arma::mat& matX,
       Deactivate(changeInd);
     }
 
-    corr = vecXTy - trans(dataRef) * yHat;
+    // Update the correlation vector.  The X^T * (y - yHat) product is the
+    // dominant per-iteration cost when the number of dimensions is large, and
+    // each column's correlation is independent, so compute it in parallel.
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t i = 0; i < (omp_size_t) dataRef.n_cols; ++i)
+      corr(i) = vecXTy(i) - dot(dataRef.col(i), yHat);
     if (elasticNet)
       corr -= lambda2 * beta;
 
@@ -466,6 +473,18 @@ double LARS::Train(const arma::mat& data,
   return Train(data, responses, beta, transposeData);
 }
 
+void LARS::ComputeGram(const arma::mat& data,
+                       arma::mat& gramMatrix,
+                       const bool transposeData)
+{
+  // Train() works with a row-major matrix internally, so build the Gram
+  // matrix the same way it would.
+  if (transposeData)
+    gramMatrix = data * trans(data);
+  else
+    gramMatrix = trans(data) * data;
+}
+
 void LARS::Predict(const arma::mat& points,
                    arma::rowvec& predictions,
                    const bool rowMajor) const
@@ -266,6 +266,37 @@ class LARS
   //! Access the upper triangular cholesky factor.
   const arma::mat& MatUtriCholFactor() const { return matUtriCholFactor; }
 
+  //! Access the Gram matrix being used (may be precalculated or internal).
+  const arma::mat& MatGram() const { return *matGram; }
+
+  /**
+   * Compute the Gram matrix of the given data, in the form expected by the
+   * Gram-matrix constructors.  When many LARS or LASSO models are to be
+   * trained on the same design matrix, computing the Gram matrix once with
+   * this function and passing it to each model avoids recomputing it for
+   * every solve:
+   *
+   * @code
+   * arma::mat gram;
+   * LARS::ComputeGram(data, gram);
+   * LARS lars1(false, gram, lambda1a);
+   * LARS lars2(false, gram, lambda1b);
+   * @endcode
+   *
+   * Note that for the elastic net problem without the Cholesky decomposition,
+   * Train() adds lambda2 * I to an internally-computed Gram matrix; a Gram
+   * matrix computed here is shared as-is, so in that situation pass
+   * useCholesky = true (or add the lambda2 * I term yourself).
+   *
+   * @param data Input data.
+   * @param gramMatrix Matrix to store the Gram matrix in.
+   * @param transposeData Should be true if the input data is column-major and
+   *     false otherwise.
+   */
+  static void ComputeGram(const arma::mat& data,
+                          arma::mat& gramMatrix,
+                          const bool transposeData = true);
+
   /**
    * Serialize the LARS model.
    */
@@ -135,6 +135,8 @@ class LinearRegression
 
   //! Return whether or not an intercept term is used in the model.
   bool Intercept() const { return intercept; }
+  //! Modify whether or not an intercept term is used in the model.
+  bool& Intercept() { return intercept; }
 
   /**
    * Serialize the model.
@@ -0,0 +1,182 @@
+/**
+ * @file methods/linear_regression/linear_regression_accumulator.cpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the streaming normal-equations trainer for
+ * LinearRegression.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "linear_regression_accumulator.hpp"
+
+#include <mlpack/core/util/parallel.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+using namespace mlpack;
+using namespace mlpack::regression;
+
+LinearRegressionAccumulator::LinearRegressionAccumulator(
+    const size_t dimensionality,
+    const double lambda,
+    const bool intercept) :
+    dimensionality(dimensionality),
+    lambda(lambda),
+    intercept(intercept),
+    yty(0.0),
+    count(0)
+{
+  // When an intercept is fit, the points are augmented with a row of ones, as
+  // in LinearRegression::Train().
+  const size_t rows = dimensionality + (intercept ? 1 : 0);
+  xtx.zeros(rows, rows);
+  xty.zeros(rows);
+}
+
+void LinearRegressionAccumulator::Accumulate(const arma::mat& predictors,
+                                             const arma::rowvec& responses)
+{
+  Accumulate(predictors, responses, arma::rowvec());
+}
+
+void LinearRegressionAccumulator::Accumulate(const arma::mat& predictors,
+                                             const arma::rowvec& responses,
+                                             const arma::rowvec& weights)
+{
+  if (predictors.n_rows != dimensionality)
+  {
+    std::ostringstream oss;
+    oss << "LinearRegressionAccumulator::Accumulate(): chunk dimensionality ("
+        << predictors.n_rows << ") does not match the accumulator's ("
+        << dimensionality << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+  if (responses.n_elem != predictors.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "LinearRegressionAccumulator::Accumulate(): number of responses ("
+        << responses.n_elem << ") does not match number of points ("
+        << predictors.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+  if (weights.n_elem > 0 && weights.n_elem != predictors.n_cols)
+  {
+    std::ostringstream oss;
+    oss << "LinearRegressionAccumulator::Accumulate(): number of weights ("
+        << weights.n_elem << ") does not match number of points ("
+        << predictors.n_cols << ")!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Process the chunk in column blocks: each thread accumulates its own
+  // rank-k update of the normal equations, and the partials are combined
+  // pairwise at the end.
+  const size_t blockSize = 1024;
+  const size_t numBlocks = (predictors.n_cols + blockSize - 1) / blockSize;
+
+  typedef std::pair<arma::mat, arma::vec> PartialType;
+  const PartialType identity(arma::zeros<arma::mat>(xtx.n_rows, xtx.n_cols),
+                             arma::zeros<arma::vec>(xty.n_elem));
+
+  PartialType sums = Parallel::ReduceFor(numBlocks, identity,
+      [&](PartialType& partial, const size_t block)
+      {
+        const size_t begin = block * blockSize;
+        const size_t end = std::min(predictors.n_cols,
+            begin + blockSize) - 1;
+
+        // Materialize the block, augmented with the row of ones when an
+        // intercept is fit and scaled by the square roots of the weights
+        // when weights were given.
+        arma::mat points;
+        if (intercept)
+        {
+          points.set_size(dimensionality + 1, end - begin + 1);
+          points.row(0).ones();
+          points.rows(1, dimensionality) = predictors.cols(begin, end);
+        }
+        else
+        {
+          points = predictors.cols(begin, end);
+        }
+
+        arma::rowvec r = responses.subvec(begin, end);
+        if (weights.n_elem > 0)
+        {
+          const arma::rowvec sqrtWeights =
+              arma::sqrt(weights.subvec(begin, end));
+          points.each_row() %= sqrtWeights;
+          r %= sqrtWeights;
+        }
+
+        partial.first += points * points.t();
+        partial.second += points * r.t();
+      },
+      [](PartialType& to, const PartialType& from)
+      {
+        to.first += from.first;
+        to.second += from.second;
+      });
+
+  xtx += sums.first;
+  xty += sums.second;
+
+  if (weights.n_elem > 0)
+    yty += arma::dot(weights % responses, responses);
+  else
+    yty += arma::dot(responses, responses);
+  count += predictors.n_cols;
+}
+
+void LinearRegressionAccumulator::Merge(
+    const LinearRegressionAccumulator& other)
+{
+  // An empty accumulator takes the shape of the other, so that partials can
+  // be folded into a default-constructed target.
+  if (dimensionality == 0 && count == 0)
+  {
+    *this = other;
+    return;
+  }
+
+  if (other.dimensionality != dimensionality || other.intercept != intercept)
+  {
+    throw std::invalid_argument("LinearRegressionAccumulator::Merge(): "
+        "accumulators do not have matching shapes!");
+  }
+
+  xtx += other.xtx;
+  xty += other.xty;
+  yty += other.yty;
+  count += other.count;
+}
+
+double LinearRegressionAccumulator::Train(LinearRegression& model) const
+{
+  if (count == 0)
+  {
+    throw std::invalid_argument("LinearRegressionAccumulator::Train(): no "
+        "points have been accumulated!");
+  }
+
+  // This is the same system that LinearRegression::Train() solves:
+  // a * (X X^T + lambda I) = y X^T.
+  arma::mat cov = xtx +
+      lambda * arma::eye<arma::mat>(xtx.n_rows, xtx.n_cols);
+
+  model.Parameters() = arma::solve(cov, xty);
+  model.Lambda() = lambda;
+  model.Intercept() = intercept;
+
+  // The training error (1 / n) * || y - X^T b ||^2_2 expands into the
+  // accumulated statistics, so no second pass over the data is needed.
+  // Cancellation can leave a tiny negative value, so clamp at zero.
+  const arma::vec& b = model.Parameters();
+  const double squaredError = yty - 2.0 * arma::dot(b, xty) +
+      arma::dot(b, xtx * b);
+  return std::max(0.0, squaredError) / count;
+}
@@ -0,0 +1,179 @@
+/**
+ * @file methods/linear_regression/linear_regression_accumulator.hpp
+ * @author Ryan Curtin
+ *
+ * A streaming normal-equations trainer for LinearRegression.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_LINEAR_REGRESSION_LINEAR_REGRESSION_ACCUMULATOR_HPP
+#define MLPACK_METHODS_LINEAR_REGRESSION_LINEAR_REGRESSION_ACCUMULATOR_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include "linear_regression.hpp"
+
+namespace mlpack {
+namespace regression {
+
+/**
+ * A streaming trainer for LinearRegression.  Instead of forming the normal
+ * equations over one full in-memory matrix, the sufficient statistics
+ * \f$ X X^T \f$ and \f$ X y^T \f$ are accumulated chunk by chunk: each call to
+ * Accumulate() adds a chunk of columns with a blocked, parallel rank-k update,
+ * accumulators built from different parts of the data (by different threads,
+ * or from different files) can be combined with Merge(), and Train() solves
+ * the accumulated system.  The memory use is O(d^2) for dimensionality d,
+ * independent of the number of points seen, so a ridge regression can be fit
+ * to a dataset far too large to hold in memory in a single streaming pass:
+ *
+ * @code
+ * LinearRegressionAccumulator acc(dimensionality, 0.1);
+ * while (LoadNextChunk(predictors, responses))
+ *   acc.Accumulate(predictors, responses);
+ *
+ * LinearRegression lr;
+ * acc.Train(lr);
+ * @endcode
+ */
+class LinearRegressionAccumulator
+{
+ public:
+  /**
+   * Construct an empty accumulator for points of the given dimensionality.
+   *
+   * @param dimensionality Dimensionality of the points that will be seen.
+   * @param lambda Regularization constant for ridge regression.
+   * @param intercept Whether or not to fit an intercept term.
+   */
+  LinearRegressionAccumulator(const size_t dimensionality,
+                              const double lambda = 0,
+                              const bool intercept = true);
+
+  /**
+   * Empty constructor, useful only as a target for Merge() or
+   * deserialization.
+   */
+  LinearRegressionAccumulator() :
+      dimensionality(0), lambda(0.0), intercept(true), yty(0.0), count(0) { }
+
+  /**
+   * Add a chunk of points to the accumulated statistics.  The chunk is
+   * processed in column blocks, in parallel when OpenMP is available.
+   *
+   * @note A std::invalid_argument exception will be thrown if the chunk does
+   * not match the dimensionality of the accumulator.
+   *
+   * @param predictors X, a chunk of data points.
+   * @param responses y, the responses for each point in the chunk.
+   */
+  void Accumulate(const arma::mat& predictors, const arma::rowvec& responses);
+
+  /**
+   * Add a chunk of weighted points to the accumulated statistics.
+   *
+   * @note A std::invalid_argument exception will be thrown if the chunk does
+   * not match the dimensionality of the accumulator.
+   *
+   * @param predictors X, a chunk of data points.
+   * @param responses y, the responses for each point in the chunk.
+   * @param weights Observation weights (for boosting).
+   */
+  void Accumulate(const arma::mat& predictors,
+                  const arma::rowvec& responses,
+                  const arma::rowvec& weights);
+
+  /**
+   * Fold another accumulator, built from a different part of the data, into
+   * this one.  If this accumulator is empty (default-constructed), it takes
+   * the shape of the other.
+   *
+   * @note A std::invalid_argument exception will be thrown if the two
+   * accumulators do not have matching shapes.
+   *
+   * @param other Accumulator whose statistics will be added to this one.
+   */
+  void Merge(const LinearRegressionAccumulator& other);
+
+  /**
+   * Solve the accumulated normal equations and store the solution in the
+   * given model, overwriting any parameters it holds.  The accumulator is not
+   * modified, so more chunks may be added and the system re-solved later.
+   *
+   * @note A std::invalid_argument exception will be thrown if no points have
+   * been accumulated.
+   *
+   * @param model Model to store the solution in.
+   * @return The mean squared error over the accumulated points (weighted, if
+   *     weights were given).
+   */
+  double Train(LinearRegression& model) const;
+
+  //! Return the dimensionality of the points the accumulator expects.
+  size_t Dimensionality() const { return dimensionality; }
+
+  //! Return the number of points that have been accumulated.
+  size_t Count() const { return count; }
+
+  //! Return the Tikhonov regularization parameter for ridge regression.
+  double Lambda() const { return lambda; }
+  //! Modify the Tikhonov regularization parameter for ridge regression.
+  double& Lambda() { return lambda; }
+
+  //! Return whether or not an intercept term will be fit.
+  bool Intercept() const { return intercept; }
+
+  //! Return the accumulated X X^T matrix (augmented with the intercept row,
+  //! if an intercept is being fit).
+  const arma::mat& XtX() const { return xtx; }
+  //! Return the accumulated X y^T vector.
+  const arma::vec& Xty() const { return xty; }
+
+  /**
+   * Serialize the accumulator, so that partial results can be shipped between
+   * processes and merged.
+   */
+  template<typename Archive>
+  void serialize(Archive& ar, const unsigned int /* version */)
+  {
+    ar & BOOST_SERIALIZATION_NVP(dimensionality);
+    ar & BOOST_SERIALIZATION_NVP(lambda);
+    ar & BOOST_SERIALIZATION_NVP(intercept);
+    ar & BOOST_SERIALIZATION_NVP(xtx);
+    ar & BOOST_SERIALIZATION_NVP(xty);
+    ar & BOOST_SERIALIZATION_NVP(yty);
+    ar & BOOST_SERIALIZATION_NVP(count);
+  }
+
+ private:
+  //! The dimensionality of the points the accumulator expects.
+  size_t dimensionality;
+
+  //! The Tikhonov regularization parameter for ridge regression (0 for
+  //! linear regression).
+  double lambda;
+
+  //! Indicates whether an intercept term will be fit.
+  bool intercept;
+
+  //! The accumulated X X^T matrix, over the (possibly augmented) points.
+  arma::mat xtx;
+
+  //! The accumulated X y^T vector.
+  arma::vec xty;
+
+  //! The accumulated squared norm of the responses (used to compute the
+  //! training error without a second pass over the data).
+  double yty;
+
+  //! The number of points that have been accumulated.
+  size_t count;
+};
+
+} // namespace regression
+} // namespace mlpack
+
+#endif // MLPACK_METHODS_LINEAR_REGRESSION_LINEAR_REGRESSION_ACCUMULATOR_HPP
@@ -80,6 +80,12 @@ template <typename MatType = arma::mat>
 class LinearSVM
 {
  public:
+  //! The element type of the data.
+  typedef typename MatType::elem_type ElemType;
+  //! The type of dense matrix with the same element type as MatType.  The
+  //! parameters are always dense, even when the data is sparse.
+  typedef arma::Mat<ElemType> DenseMatType;
+
   /**
    * Construct the LinearSVM class with the provided data and labels.
    * This will train the model. Optionally, the parameter 'lambda' can be
@@ -188,7 +194,7 @@ class LinearSVM
    */
   void Classify(const MatType& data,
                 arma::Row<size_t>& labels,
-                arma::mat& scores) const;
+                DenseMatType& scores) const;
 
   /**
    * Classify the given points, returning class scores for each point.
@@ -197,7 +203,7 @@ class LinearSVM
    * @param scores Class scores for each point.
    */
   void Classify(const MatType& data,
-                arma::mat& scores) const;
+                DenseMatType& scores) const;
 
   /**
    * Classify the given point. The predicted class label is returned.
@@ -225,6 +231,11 @@ class LinearSVM
   /**
    * Train the Linear SVM with the given training data.
    *
+   * This will use the existing model parameters as a starting point for the
+   * optimization (warm start) if they match the shape of the problem.  If
+   * this is not what you want, access the parameters directly with
+   * Parameters() and modify them as desired.
+   *
    * @tparam OptimizerType Desired optimizer.
    * @tparam CallbackTypes Types of Callback Functions.
    * @param data Input training features. Each column associate with one sample.
@@ -245,6 +256,11 @@ class LinearSVM
   /**
    * Train the Linear SVM with the given training data.
    *
+   * This will use the existing model parameters as a starting point for the
+   * optimization (warm start) if they match the shape of the problem.  If
+   * this is not what you want, access the parameters directly with
+   * Parameters() and modify them as desired.
+   *
    * @tparam OptimizerType Desired optimizer.
    * @param data Input training features. Each column associate with one sample.
    * @param labels Labels associated with the feature data.
@@ -258,6 +274,34 @@ class LinearSVM
                const size_t numClasses = 2,
                OptimizerType optimizer = OptimizerType());
 
+  /**
+   * Train the Linear SVM along a path of regularization parameters.  Each
+   * solve is warm-started from the previous one: the solution for lambdas[i]
+   * is used as the starting iterate for lambdas[i + 1], which is far cheaper
+   * than solving each lambda from scratch when the grid is reasonably dense.
+   * Sweep from the most to the least regularized lambda for the best
+   * warm-start behavior.
+   *
+   * After this call the model holds the solution for the last element of
+   * lambdas, and Lambda() is set to that value.
+   *
+   * @tparam OptimizerType Desired optimizer.
+   * @param data Input training features. Each column associate with one sample.
+   * @param labels Labels associated with the feature data.
+   * @param numClasses Number of classes for classification.
+   * @param lambdas Regularization parameters to sweep over (at least one).
+   * @param pathParameters Cube to store the solutions in; slice i will hold
+   *      the parameters trained with lambdas[i].
+   * @param optimizer Desired optimizer.
+   * @return Objective value of the final point for each element of lambdas.
+   */
+  template <typename OptimizerType = ens::L_BFGS>
+  arma::vec TrainPath(const MatType& data,
+                      const arma::Row<size_t>& labels,
+                      const size_t numClasses,
+                      const arma::vec& lambdas,
+                      arma::Cube<ElemType>& pathParameters,
+                      OptimizerType optimizer = OptimizerType());
 
   //! Sets the number of classes.
   size_t& NumClasses() { return numClasses; }
@@ -278,9 +322,9 @@ class LinearSVM
   bool& FitIntercept() { return fitIntercept; }
 
   //! Set the model parameters.
-  arma::mat& Parameters() { return parameters; }
+  DenseMatType& Parameters() { return parameters; }
   //! Get the model parameters.
-  const arma::mat& Parameters() const { return parameters; }
+  const DenseMatType& Parameters() const { return parameters; }
 
   //! Gets the features size of the training data
   size_t FeatureSize() const
@@ -301,7 +345,7 @@ class LinearSVM
 
  private:
   //! Parameters after optimization.
-  arma::mat parameters;
+  DenseMatType parameters;
   //! Number of classes.
   size_t numClasses;
   //! L2-Regularization constant.
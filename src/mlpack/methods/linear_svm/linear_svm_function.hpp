@@ -28,6 +28,14 @@ template <typename MatType = arma::mat>
 class LinearSVMFunction
 {
  public:
+  //! The element type of the data.
+  typedef typename MatType::elem_type ElemType;
+  //! The type of dense matrix with the same element type as MatType.  The
+  //! parameters are always dense, even when the dataset is sparse.
+  typedef arma::Mat<ElemType> DenseMatType;
+  //! The type of dense row vector with the same element type as MatType.
+  typedef arma::Row<ElemType> DenseRowType;
+
   /**
    * Construct the Linear SVM objective function with given parameters.
    *
@@ -59,7 +67,7 @@ class LinearSVMFunction
    * @param numClasses Number of classes for classification.
    * @param fitIntercept If true, an intercept is fitted.
    */
-  static void InitializeWeights(arma::mat& weights,
+  static void InitializeWeights(DenseMatType& weights,
                                 const size_t featureSize,
                                 const size_t numClasses,
                                 const bool fitIntercept = false);
@@ -68,10 +76,10 @@ class LinearSVMFunction
    * Constructs the ground truth label matrix with the passed labels.
    *
    * @param labels Labels associated with the training data.
-   * @param groundTruth Pointer to arma::mat which stores the computed matrix.
+   * @param groundTruth Matrix which stores the computed ground truth.
    */
   void GetGroundTruthMatrix(const arma::Row<size_t>& labels,
-                            arma::sp_mat& groundTruth);
+                            arma::SpMat<ElemType>& groundTruth);
 
   /**
    * Evaluate the hinge loss function for all the datapoints
@@ -79,7 +87,7 @@ class LinearSVMFunction
    * @param parameters The parameters of the SVM.
    * @return The value of the loss function for the entire dataset.
    */
-  double Evaluate(const arma::mat& parameters);
+  double Evaluate(const DenseMatType& parameters);
 
   /**
    * Evaluate the hinge loss function on the specified datapoints.
@@ -90,7 +98,7 @@ class LinearSVMFunction
    * @param batchSize Size of batch to process.
    * @return The value of the loss function for the given parameters.
    */
-  double Evaluate(const arma::mat& parameters,
+  double Evaluate(const DenseMatType& parameters,
                   const size_t firstId,
                   const size_t batchSize = 1);
 
@@ -103,7 +111,7 @@ class LinearSVMFunction
    * @param gradient Linear matrix to output the gradient into.
    */
   template <typename GradType>
-  void Gradient(const arma::mat& parameters,
+  void Gradient(const DenseMatType& parameters,
                 GradType& gradient);
 
   /**
@@ -117,7 +125,7 @@ class LinearSVMFunction
    * @param batchSize Size of the batch to process.
    */
   template <typename GradType>
-  void Gradient(const arma::mat& parameters,
+  void Gradient(const DenseMatType& parameters,
                 const size_t firstId,
                 GradType& gradient,
                 const size_t batchSize = 1);
@@ -134,7 +142,7 @@ class LinearSVMFunction
    * @return The value of the loss function at the given parameters.
    */
   template <typename GradType>
-  double EvaluateWithGradient(const arma::mat& parameters,
+  double EvaluateWithGradient(const DenseMatType& parameters,
                               GradType& gradient) const;
 
   /**
@@ -152,20 +160,20 @@ class LinearSVMFunction
    * @return The value of the loss function at the given parameters.
    */
   template <typename GradType>
-  double EvaluateWithGradient(const arma::mat& parameters,
+  double EvaluateWithGradient(const DenseMatType& parameters,
                               const size_t firstId,
                               GradType& gradient,
                               const size_t batchSize = 1) const;
 
   //! Return the initial point for the optimization.
-  const arma::mat& InitialPoint() const { return initialPoint; }
+  const DenseMatType& InitialPoint() const { return initialPoint; }
   //! Modify the initial point for the optimization.
-  arma::mat& InitialPoint() { return initialPoint; }
+  DenseMatType& InitialPoint() { return initialPoint; }
 
   //! Get the dataset.
-  const arma::sp_mat& Dataset() const { return dataset; }
+  const MatType& Dataset() const { return dataset; }
   //! Modify the dataset.
-  arma::sp_mat& Dataset() { return dataset; }
+  MatType& Dataset() { return dataset; }
 
   //! Sets the regularization parameter.
   double& Lambda() { return lambda; }
@@ -179,11 +187,40 @@ class LinearSVMFunction
   size_t NumFunctions() const;
 
  private:
+  /**
+   * Reorder the columns of the dataset into the given ordering.  Overload for
+   * dense matrices: gather the columns directly.
+   *
+   * @param ordering The new ordering: column i of the output is column
+   *     ordering[i] of the dataset.
+   * @param reverseOrdering The inverse permutation of ordering.
+   * @param output Matrix to store the reordered dataset in.
+   */
+  template<typename eT>
+  void ShuffleDataset(const arma::uvec& ordering,
+                      const arma::uvec& reverseOrdering,
+                      arma::Mat<eT>& output) const;
+
+  /**
+   * Reorder the columns of the dataset into the given ordering.  Overload for
+   * sparse matrices: rebuild the matrix from its nonzero entries, so the
+   * dataset is never densified.
+   *
+   * @param ordering The new ordering: column i of the output is column
+   *     ordering[i] of the dataset.
+   * @param reverseOrdering The inverse permutation of ordering.
+   * @param output Matrix to store the reordered dataset in.
+   */
+  template<typename eT>
+  void ShuffleDataset(const arma::uvec& ordering,
+                      const arma::uvec& reverseOrdering,
+                      arma::SpMat<eT>& output) const;
+
   //! The initial point, from which to start the optimization.
-  arma::mat initialPoint;
+  DenseMatType initialPoint;
 
   //! Label matrix for provided data
-  arma::sp_mat groundTruth;
+  arma::SpMat<ElemType> groundTruth;
 
   //! The datapoints for training.
   MatType dataset;
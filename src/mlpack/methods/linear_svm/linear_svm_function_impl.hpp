@@ -14,6 +14,7 @@
 #ifndef MLPACK_METHODS_LINEAR_SVM_LINEAR_SVM_FUNCTION_IMPL_HPP
 #define MLPACK_METHODS_LINEAR_SVM_LINEAR_SVM_FUNCTION_IMPL_HPP
 
+#include <mlpack/core/math/accumulate.hpp>
 #include <mlpack/core/math/make_alias.hpp>
 #include <mlpack/core/math/shuffle_data.hpp>
 
@@ -51,7 +52,7 @@ LinearSVMFunction<MatType>::LinearSVMFunction(
  */
 template <typename MatType>
 void LinearSVMFunction<MatType>::InitializeWeights(
-    arma::mat &weights,
+    DenseMatType& weights,
     const size_t featureSize,
     const size_t numClasses,
     const bool fitIntercept)
@@ -73,7 +74,7 @@ void LinearSVMFunction<MatType>::InitializeWeights(
 template <typename MatType>
 void LinearSVMFunction<MatType>::GetGroundTruthMatrix(
     const arma::Row<size_t>& labels,
-    arma::sp_mat& groundTruth)
+    arma::SpMat<ElemType>& groundTruth)
 {
   // Calculate the ground truth matrix according to the labels passed. The
   // ground truth matrix is a matrix of dimensions 'numClasses * numExamples',
@@ -96,12 +97,12 @@ void LinearSVMFunction<MatType>::GetGroundTruthMatrix(
   }
 
   // All entries are '1'.
-  arma::vec values;
+  arma::Col<ElemType> values;
   values.ones(labels.n_elem);
 
   // Calculate the matrix.
-  groundTruth = arma::sp_mat(rowPointers, colPointers, values, numClasses,
-                             labels.n_elem);
+  groundTruth = arma::SpMat<ElemType>(rowPointers, colPointers, values,
+                                      numClasses, labels.n_elem);
 }
 
 /**
@@ -110,23 +111,24 @@ void LinearSVMFunction<MatType>::GetGroundTruthMatrix(
 template <typename MatType>
 void LinearSVMFunction<MatType>::Shuffle()
 {
-  // Determine new ordering.
+  // Determine new ordering and its inverse.
   arma::uvec ordering = arma::shuffle(arma::linspace<arma::uvec>(0,
       dataset.n_cols - 1, dataset.n_cols));
-
-  // Re-sort data.
-  arma::mat newData = dataset.cols(ordering);
-  math::ClearAlias(dataset);
-  dataset = std::move(newData);
-
-  // Assemble data for batch constructor.  We need reverse orderings though...
   arma::uvec reverseOrdering(ordering.n_elem);
   for (size_t i = 0; i < ordering.n_elem; ++i)
     reverseOrdering[ordering[i]] = i;
 
+  // Re-sort data.  The sparse overload of ShuffleDataset() rebuilds the
+  // matrix from its nonzero entries, so a sparse dataset stays sparse.
+  MatType newData;
+  ShuffleDataset(ordering, reverseOrdering, newData);
+  math::ClearAlias(dataset);
+  dataset = std::move(newData);
+
+  // Assemble ground truth data for the batch constructor.
   arma::umat newLocations(2, groundTruth.n_nonzero);
-  arma::vec values(groundTruth.n_nonzero);
-  arma::sp_mat::const_iterator it = groundTruth.begin();
+  arma::Col<ElemType> values(groundTruth.n_nonzero);
+  typename arma::SpMat<ElemType>::const_iterator it = groundTruth.begin();
   size_t loc = 0;
   while (it != groundTruth.end())
   {
@@ -138,13 +140,48 @@ void LinearSVMFunction<MatType>::Shuffle()
     ++loc;
   }
 
-  groundTruth = arma::sp_mat(newLocations, values, groundTruth.n_rows,
-                             groundTruth.n_cols);
+  groundTruth = arma::SpMat<ElemType>(newLocations, values,
+                                      groundTruth.n_rows, groundTruth.n_cols);
+}
+
+template <typename MatType>
+template <typename eT>
+void LinearSVMFunction<MatType>::ShuffleDataset(
+    const arma::uvec& ordering,
+    const arma::uvec& /* reverseOrdering */,
+    arma::Mat<eT>& output) const
+{
+  output = dataset.cols(ordering);
+}
+
+template <typename MatType>
+template <typename eT>
+void LinearSVMFunction<MatType>::ShuffleDataset(
+    const arma::uvec& /* ordering */,
+    const arma::uvec& reverseOrdering,
+    arma::SpMat<eT>& output) const
+{
+  // Rebuild the matrix from its nonzero entries with the batch constructor.
+  arma::umat locations(2, dataset.n_nonzero);
+  arma::Col<eT> values(dataset.n_nonzero);
+  typename arma::SpMat<eT>::const_iterator it = dataset.begin();
+  size_t loc = 0;
+  while (it != dataset.end())
+  {
+    locations(0, loc) = it.row();
+    locations(1, loc) = reverseOrdering[it.col()];
+    values(loc) = (*it);
+
+    ++it;
+    ++loc;
+  }
+
+  output = arma::SpMat<eT>(locations, values, dataset.n_rows, dataset.n_cols);
 }
 
 template <typename MatType>
 double LinearSVMFunction<MatType>::Evaluate(
-    const arma::mat& parameters)
+    const DenseMatType& parameters)
 {
   // The objective function is the hinge loss function and it is
   // calculated over all the training examples.
@@ -155,7 +192,7 @@ double LinearSVMFunction<MatType>::Evaluate(
   double loss, regularization;
 
   // Scores for each class are evaluated.
-  arma::mat scores;
+  DenseMatType scores;
 
   // Check intercept condition.
   if (!fitIntercept)
@@ -168,10 +205,10 @@ double LinearSVMFunction<MatType>::Evaluate(
     // The first `parameters.n_rows - 1` rows of parameters holds the value
     // of Weights `w_i`, and the last row holds `b_i`.
     // On calculating the score, we add `b_i` term to each element of
-    // `i_th` row of `scores`.
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
+    // `i_th` row of `scores`; broadcasting in place avoids a
+    // numClasses x numExamples temporary.
+    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset;
+    scores.each_col() += parameters.row(dataset.n_rows).t();
   }
 
   // Evaluate the margin by the following steps:
@@ -179,12 +216,12 @@ double LinearSVMFunction<MatType>::Evaluate(
   //  - Adding the margin parameter `delta`.
   //  - Removing the `delta` parameter from correct class label in each
   //    column.
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth), numClasses, 1)) + delta
-      - (delta * groundTruth);
+  DenseMatType margin = scores + delta - (delta * groundTruth);
+  margin.each_row() -= arma::ones<DenseRowType>(numClasses) * (scores % groundTruth);
 
   // The Hinge Loss Function
-  loss = arma::accu(arma::clamp(margin, 0.0, DBL_MAX)) / dataset.n_cols;
+  loss = math::AccuDouble(arma::clamp(margin, ElemType(0),
+      std::numeric_limits<ElemType>::max())) / dataset.n_cols;
 
   // Adding the regularization term.
   regularization = 0.5 * lambda * arma::dot(parameters, parameters);
@@ -194,7 +231,7 @@ double LinearSVMFunction<MatType>::Evaluate(
 
 template <typename MatType>
 double LinearSVMFunction<MatType>::Evaluate(
-    const arma::mat& parameters,
+    const DenseMatType& parameters,
     const size_t firstId,
     const size_t batchSize)
 {
@@ -204,7 +241,12 @@ double LinearSVMFunction<MatType>::Evaluate(
   double loss, regularization, cost;
 
   // Scores for each class are evaluated.
-  arma::mat scores;
+  DenseMatType scores;
+
+  // The batch of ground truth entries; materialized so the expressions below
+  // work uniformly for dense and sparse datasets.
+  const arma::SpMat<ElemType> batchGroundTruth(
+      groundTruth.cols(firstId, lastId));
 
   // Check intercept condition.
   if (!fitIntercept)
@@ -214,17 +256,17 @@ double LinearSVMFunction<MatType>::Evaluate(
   else
   {
     scores = parameters.rows(0, dataset.n_rows - 1).t()
-        * dataset.cols(firstId, lastId)
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
+        * dataset.cols(firstId, lastId);
+    scores.each_col() += parameters.row(dataset.n_rows).t();
   }
 
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth.cols(firstId, lastId)), numClasses, 1))
-      + delta - (delta * groundTruth.cols(firstId, lastId));
+  DenseMatType margin = scores + delta - (delta * batchGroundTruth);
+  margin.each_row() -= arma::ones<DenseRowType>(numClasses) * (scores %
+      batchGroundTruth);
 
   // The Hinge Loss Function
-  loss = arma::accu(arma::clamp(margin, 0.0, DBL_MAX));
+  loss = math::AccuDouble(arma::clamp(margin, ElemType(0),
+      std::numeric_limits<ElemType>::max()));
   loss /= batchSize;
 
   // Adding the regularization term.
@@ -237,7 +279,7 @@ double LinearSVMFunction<MatType>::Evaluate(
 template <typename MatType>
 template <typename GradType>
 void LinearSVMFunction<MatType>::Gradient(
-    const arma::mat& parameters,
+    const DenseMatType& parameters,
     GradType& gradient)
 {
   // The objective is to minimize the loss, which is evaluated as the sum
@@ -246,7 +288,7 @@ void LinearSVMFunction<MatType>::Gradient(
   // Also, we need to increase the score of the correct class.
 
   // Scores for each class are evaluated.
-  arma::mat scores;
+  DenseMatType scores;
 
   if (!fitIntercept)
   {
@@ -254,22 +296,27 @@ void LinearSVMFunction<MatType>::Gradient(
   }
   else
   {
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
+    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset;
+    scores.each_col() += parameters.row(dataset.n_rows).t();
   }
 
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth), numClasses, 1)) + delta
-      - (delta * groundTruth);
+  DenseMatType margin = scores + delta - (delta * groundTruth);
+  margin.each_row() -= arma::ones<DenseRowType>(numClasses) * (scores % groundTruth);
 
   // An element of `mask` matrix holds `1` corresponding to
   // each positive element of `margin` matrix.
-  arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
+  DenseMatType mask = margin.for_each([](ElemType& val)
       { val = (val > 0) ? 1: 0; });
 
-  arma::mat difference = groundTruth
-      % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
+  // For each point, subtract the number of violating classes from the row of
+  // its correct class.  Iterating the ground truth's nonzeros avoids another
+  // numClasses x numExamples temporary.
+  DenseMatType difference = mask;
+  const DenseRowType violations = arma::sum(mask);
+  for (typename arma::SpMat<ElemType>::const_iterator it =
+      groundTruth.begin();
+      it != groundTruth.end(); ++it)
+    difference(it.row(), it.col()) -= violations[it.col()];
 
   // The gradient is evaluated as follows:
   //  - Add `x_i` to `w_j` if `margin_i_m`is positive.
@@ -288,8 +335,7 @@ void LinearSVMFunction<MatType>::Gradient(
     gradient.set_size(arma::size(parameters));
     gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
         dataset * difference.t();
-    gradient.row(parameters.n_rows - 1) =
-        arma::ones<arma::rowvec>(dataset.n_cols) * difference.t();
+    gradient.row(parameters.n_rows - 1) = arma::sum(difference, 1).t();
   }
 
   gradient /= dataset.n_cols;
@@ -301,7 +347,7 @@ void LinearSVMFunction<MatType>::Gradient(
 template <typename MatType>
 template <typename GradType>
 void LinearSVMFunction<MatType>::Gradient(
-    const arma::mat& parameters,
+    const DenseMatType& parameters,
     const size_t firstId,
     GradType& gradient,
     const size_t batchSize)
@@ -309,7 +355,11 @@ void LinearSVMFunction<MatType>::Gradient(
   const size_t lastId = firstId + batchSize - 1;
 
   // Scores for each class are evaluated.
-  arma::mat scores;
+  DenseMatType scores;
+
+  // The batch of ground truth entries.
+  const arma::SpMat<ElemType> batchGroundTruth(
+      groundTruth.cols(firstId, lastId));
 
   // Check intercept condition.
   if (!fitIntercept)
@@ -319,21 +369,25 @@ void LinearSVMFunction<MatType>::Gradient(
   else
   {
     scores = parameters.rows(0, dataset.n_rows - 1).t()
-        * dataset.cols(firstId, lastId)
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1, batchSize);
+        * dataset.cols(firstId, lastId);
+    scores.each_col() += parameters.row(dataset.n_rows).t();
   }
 
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth.cols(firstId, lastId)), numClasses, 1))
-      + delta - (delta * groundTruth.cols(firstId, lastId));
+  DenseMatType margin = scores + delta - (delta * batchGroundTruth);
+  margin.each_row() -= arma::ones<DenseRowType>(numClasses) * (scores %
+      batchGroundTruth);
 
   // For each sample, find the total number of classes where
   // ( margin > 0 ).
-  arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
+  DenseMatType mask = margin.for_each([](ElemType& val)
       { val = (val > 0) ? 1: 0; });
 
-  arma::mat difference = groundTruth.cols(firstId, lastId)
-      % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
+  DenseMatType difference = mask;
+  const DenseRowType violations = arma::sum(mask);
+  for (typename arma::SpMat<ElemType>::const_iterator it =
+      batchGroundTruth.begin();
+      it != batchGroundTruth.end(); ++it)
+    difference(it.row(), it.col()) -= violations[it.col()];
 
   // Check intercept condition
   if (!fitIntercept)
@@ -345,8 +399,7 @@ void LinearSVMFunction<MatType>::Gradient(
     gradient.set_size(arma::size(parameters));
     gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
         dataset.cols(firstId, lastId) * difference.t();
-    gradient.row(parameters.n_rows - 1) =
-        arma::ones<arma::rowvec>(batchSize) * difference.t();
+    gradient.row(parameters.n_rows - 1) = arma::sum(difference, 1).t();
   }
 
   gradient /= batchSize;
@@ -358,13 +411,13 @@ void LinearSVMFunction<MatType>::Gradient(
 template <typename MatType>
 template <typename GradType>
 double LinearSVMFunction<MatType>::EvaluateWithGradient(
-    const arma::mat& parameters,
+    const DenseMatType& parameters,
     GradType& gradient) const
 {
   double loss, regularization, cost;
 
   // Scores for each class are evaluated.
-  arma::mat scores;
+  DenseMatType scores;
 
   if (!fitIntercept)
   {
@@ -372,22 +425,30 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
   }
   else
   {
-    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1,
-        dataset.n_cols);
+    scores = parameters.rows(0, dataset.n_rows - 1).t() * dataset;
+    scores.each_col() += parameters.row(dataset.n_rows).t();
   }
 
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth), numClasses, 1)) + delta
-      - (delta * groundTruth);
+  DenseMatType margin = scores + delta - (delta * groundTruth);
+  margin.each_row() -= arma::ones<DenseRowType>(numClasses) * (scores % groundTruth);
+
+  // The Hinge Loss Function.  This has to be computed before `margin` is
+  // turned into the violation mask below, which modifies it in place.
+  loss = math::AccuDouble(arma::clamp(margin, ElemType(0),
+      std::numeric_limits<ElemType>::max()));
+  loss /= dataset.n_cols;
 
   // For each sample, find the total number of classes where
   // ( margin > 0 ).
-  arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
+  DenseMatType mask = margin.for_each([](ElemType& val)
       { val = (val > 0) ? 1: 0; });
 
-  arma::mat difference = groundTruth
-      % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
+  DenseMatType difference = mask;
+  const DenseRowType violations = arma::sum(mask);
+  for (typename arma::SpMat<ElemType>::const_iterator it =
+      groundTruth.begin();
+      it != groundTruth.end(); ++it)
+    difference(it.row(), it.col()) -= violations[it.col()];
 
   // Check intercept condition
   if (!fitIntercept)
@@ -399,8 +460,7 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
     gradient.set_size(arma::size(parameters));
     gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
             dataset * difference.t();
-    gradient.row(parameters.n_rows - 1) =
-            arma::ones<arma::rowvec>(dataset.n_cols) * difference.t();
+    gradient.row(parameters.n_rows - 1) = arma::sum(difference, 1).t();
   }
 
   gradient /= dataset.n_cols;
@@ -408,10 +468,6 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
   // Adding the regularization contribution to the gradient.
   gradient += lambda * parameters;
 
-  // The Hinge Loss Function
-  loss = arma::accu(arma::clamp(margin, 0.0, DBL_MAX));
-  loss /= dataset.n_cols;
-
   // Adding the regularization term.
   regularization = 0.5 * lambda * arma::dot(parameters, parameters);
 
@@ -422,7 +478,7 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
 template <typename MatType>
 template <typename GradType>
 double LinearSVMFunction<MatType>::EvaluateWithGradient(
-    const arma::mat& parameters,
+    const DenseMatType& parameters,
     const size_t firstId,
     GradType& gradient,
     const size_t batchSize) const
@@ -433,7 +489,11 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
   double loss, regularization, cost;
 
   // Scores for each class are evaluated.
-  arma::mat scores;
+  DenseMatType scores;
+
+  // The batch of ground truth entries.
+  const arma::SpMat<ElemType> batchGroundTruth(
+      groundTruth.cols(firstId, lastId));
 
   // Check intercept condition.
   if (!fitIntercept)
@@ -443,21 +503,31 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
   else
   {
     scores = parameters.rows(0, dataset.n_rows - 1).t()
-        * dataset.cols(firstId, lastId)
-        + arma::repmat(parameters.row(dataset.n_rows).t(), 1, dataset.n_cols);
+        * dataset.cols(firstId, lastId);
+    scores.each_col() += parameters.row(dataset.n_rows).t();
   }
 
-  arma::mat margin = scores - (arma::repmat(arma::ones(numClasses).t()
-      * (scores % groundTruth.cols(firstId, lastId)), numClasses, 1))
-      + delta - (delta * groundTruth.cols(firstId, lastId));
+  DenseMatType margin = scores + delta - (delta * batchGroundTruth);
+  margin.each_row() -= arma::ones<DenseRowType>(numClasses) * (scores %
+      batchGroundTruth);
+
+  // The Hinge Loss Function.  This has to be computed before `margin` is
+  // turned into the violation mask below, which modifies it in place.
+  loss = math::AccuDouble(arma::clamp(margin, ElemType(0),
+      std::numeric_limits<ElemType>::max()));
+  loss /= batchSize;
 
   // For each sample, find the total number of classes where
   // ( margin > 0 ).
-  arma::mat mask = margin.for_each([](arma::mat::elem_type& val)
+  DenseMatType mask = margin.for_each([](ElemType& val)
       { val = (val > 0) ? 1: 0; });
 
-  arma::mat difference = groundTruth.cols(firstId, lastId)
-      % (-arma::repmat(arma::sum(mask), numClasses, 1)) + mask;
+  DenseMatType difference = mask;
+  const DenseRowType violations = arma::sum(mask);
+  for (typename arma::SpMat<ElemType>::const_iterator it =
+      batchGroundTruth.begin();
+      it != batchGroundTruth.end(); ++it)
+    difference(it.row(), it.col()) -= violations[it.col()];
 
   // Check intercept condition
   if (!fitIntercept)
@@ -469,20 +539,14 @@ double LinearSVMFunction<MatType>::EvaluateWithGradient(
     gradient.set_size(arma::size(parameters));
     gradient.submat(0, 0, parameters.n_rows - 2, parameters.n_cols - 1) =
         dataset.cols(firstId, lastId) * difference.t();
-    gradient.row(parameters.n_rows - 1) =
-        arma::ones<arma::rowvec>(batchSize) * difference.t();
+    gradient.row(parameters.n_rows - 1) = arma::sum(difference, 1).t();
   }
 
   gradient /= batchSize;
 
-
   // Adding the regularization contribution to the gradient.
   gradient += lambda * parameters;
 
-  // The Hinge Loss Function
-  loss = arma::accu(arma::clamp(margin.cols(firstId, lastId), 0.0, DBL_MAX));
-  loss /= batchSize;
-
   // Adding the regularization term.
   regularization = 0.5 * lambda * arma::dot(parameters, parameters);
 
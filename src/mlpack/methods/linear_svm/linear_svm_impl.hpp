@@ -101,7 +101,10 @@ double LinearSVM<MatType>::Train(
 
   LinearSVMFunction<MatType> svm(data, labels, numClasses, lambda, delta,
       fitIntercept);
-  if (parameters.is_empty())
+  // Reuse the existing parameters as the starting iterate (warm start) if
+  // they match the shape of this problem; reinitialize otherwise.
+  if (parameters.n_rows != data.n_rows + (fitIntercept ? 1 : 0) ||
+      parameters.n_cols != numClasses)
     parameters = svm.InitialPoint();
 
   // Train the model.
@@ -130,7 +133,10 @@ double LinearSVM<MatType>::Train(
 
   LinearSVMFunction<MatType> svm(data, labels, numClasses, lambda, delta,
       fitIntercept);
-  if (parameters.is_empty())
+  // Reuse the existing parameters as the starting iterate (warm start) if
+  // they match the shape of this problem; reinitialize otherwise.
+  if (parameters.n_rows != data.n_rows + (fitIntercept ? 1 : 0) ||
+      parameters.n_cols != numClasses)
     parameters = svm.InitialPoint();
 
   // Train the model.
@@ -144,12 +150,44 @@ double LinearSVM<MatType>::Train(
   return out;
 }
 
+template <typename MatType>
+template <typename OptimizerType>
+arma::vec LinearSVM<MatType>::TrainPath(
+    const MatType& data,
+    const arma::Row<size_t>& labels,
+    const size_t numClasses,
+    const arma::vec& lambdas,
+    arma::Cube<ElemType>& pathParameters,
+    OptimizerType optimizer)
+{
+  if (lambdas.n_elem == 0)
+  {
+    throw std::invalid_argument("LinearSVM::TrainPath(): at least one "
+        "regularization parameter must be given");
+  }
+
+  arma::vec objectives(lambdas.n_elem);
+  pathParameters.set_size(data.n_rows + (fitIntercept ? 1 : 0), numClasses,
+      lambdas.n_elem);
+
+  for (size_t i = 0; i < lambdas.n_elem; ++i)
+  {
+    lambda = lambdas[i];
+    // Train() keeps the existing parameters as the starting iterate, so each
+    // solve is warm-started from the previous lambda's solution.
+    objectives[i] = Train(data, labels, numClasses, optimizer);
+    pathParameters.slice(i) = parameters;
+  }
+
+  return objectives;
+}
+
 template <typename MatType>
 void LinearSVM<MatType>::Classify(
     const MatType& data,
     arma::Row<size_t>& labels) const
 {
-  arma::mat scores;
+  DenseMatType scores;
   Classify(data, labels, scores);
 }
 
@@ -157,7 +195,7 @@ template <typename MatType>
 void LinearSVM<MatType>::Classify(
     const MatType& data,
     arma::Row<size_t>& labels,
-    arma::mat& scores) const
+    DenseMatType& scores) const
 {
   Classify(data, scores);
 
@@ -171,7 +209,7 @@ void LinearSVM<MatType>::Classify(
 template <typename MatType>
 void LinearSVM<MatType>::Classify(
     const MatType& data,
-    arma::mat& scores) const
+    DenseMatType& scores) const
 {
   if (data.n_rows != FeatureSize())
   {
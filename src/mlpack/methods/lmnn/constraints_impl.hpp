@@ -87,14 +87,17 @@ void Constraints<MetricType>::TargetNeighbors(arma::Mat<size_t>& outputMatrix,
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
+  // Each class is searched independently and writes a disjoint set of output
+  // columns, so the per-class searches can run concurrently.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) uniqueLabels.n_cols; ++i)
+  {
+    // KNN instance.
+    KNN knn;
 
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
 
-  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
-  {
     // Perform KNN search with same class points as both reference
     // set and query set.
     knn.Train(dataset.cols(indexSame[i]));
@@ -129,19 +132,23 @@ void Constraints<MetricType>::TargetNeighbors(arma::Mat<size_t>& outputMatrix,
   arma::mat subDataset = dataset.cols(begin, begin + batchSize - 1);
   arma::Row<size_t> sublabels = labels.cols(begin, begin + batchSize - 1);
 
-  // KNN instance.
-  KNN knn;
+  // Each class is searched independently and writes a disjoint set of output
+  // columns, so the per-class searches can run concurrently.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) uniqueLabels.n_cols; ++i)
+  {
+    // Calculate Target Neighbors.
+    arma::uvec subIndexSame = arma::find(sublabels == uniqueLabels[i]);
 
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
+    // No query points of this class in the batch; do not build a tree.
+    if (subIndexSame.n_elem == 0)
+      continue;
 
-  // Vectors to store indices.
-  arma::uvec subIndexSame;
+    // KNN instance.
+    KNN knn;
 
-  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
-  {
-    // Calculate Target Neighbors.
-    subIndexSame = arma::find(sublabels == uniqueLabels[i]);
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
 
     // Perform KNN search with same class points as both reference
     // set and query set.
@@ -171,14 +178,17 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputMatrix,
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
+  // Each class is searched independently and writes a disjoint set of output
+  // columns, so the per-class searches can run concurrently.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) uniqueLabels.n_cols; ++i)
+  {
+    // KNN instance.
+    KNN knn;
 
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
 
-  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
-  {
     // Perform KNN search with differently labeled points as reference
     // set and  same class points as query set.
     knn.Train(dataset.cols(indexDiff[i]));
@@ -209,14 +219,17 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
+  // Each class is searched independently and writes a disjoint set of output
+  // columns, so the per-class searches can run concurrently.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) uniqueLabels.n_cols; ++i)
+  {
+    // KNN instance.
+    KNN knn;
 
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
 
-  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
-  {
     // Perform KNN search with differently labeled points as reference
     // set and  same class points as query set.
     knn.Train(dataset.cols(indexDiff[i]));
@@ -252,19 +265,23 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputMatrix,
   arma::mat subDataset = dataset.cols(begin, begin + batchSize - 1);
   arma::Row<size_t> sublabels = labels.cols(begin, begin + batchSize - 1);
 
-  // KNN instance.
-  KNN knn;
+  // Each class is searched independently and writes a disjoint set of output
+  // columns, so the per-class searches can run concurrently.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) uniqueLabels.n_cols; ++i)
+  {
+    // Calculate impostors.
+    arma::uvec subIndexSame = arma::find(sublabels == uniqueLabels[i]);
 
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
+    // No query points of this class in the batch; do not build a tree.
+    if (subIndexSame.n_elem == 0)
+      continue;
 
-  // Vectors to store indices.
-  arma::uvec subIndexSame;
+    // KNN instance.
+    KNN knn;
 
-  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
-  {
-    // Calculate impostors.
-    subIndexSame = arma::find(sublabels == uniqueLabels[i]);
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
 
     // Perform KNN search with differently labeled points as reference
     // set and same class points as query set.
@@ -301,19 +318,23 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
   arma::mat subDataset = dataset.cols(begin, begin + batchSize - 1);
   arma::Row<size_t> sublabels = labels.cols(begin, begin + batchSize - 1);
 
-  // KNN instance.
-  KNN knn;
+  // Each class is searched independently and writes a disjoint set of output
+  // columns, so the per-class searches can run concurrently.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) uniqueLabels.n_cols; ++i)
+  {
+    // Calculate impostors.
+    arma::uvec subIndexSame = arma::find(sublabels == uniqueLabels[i]);
 
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
+    // No query points of this class in the batch; do not build a tree.
+    if (subIndexSame.n_elem == 0)
+      continue;
 
-  // Vectors to store indices.
-  arma::uvec subIndexSame;
+    // KNN instance.
+    KNN knn;
 
-  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
-  {
-    // Calculate impostors.
-    subIndexSame = arma::find(sublabels == uniqueLabels[i]);
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
 
     // Perform KNN search with differently labeled points as reference
     // set and same class points as query set.
@@ -348,21 +369,26 @@ void Constraints<MetricType>::Impostors(arma::Mat<size_t>& outputNeighbors,
   // Perform pre-calculation. If neccesary.
   Precalculate(labels);
 
-  // KNN instance.
-  KNN knn;
-
-  arma::Mat<size_t> neighbors;
-  arma::mat distances;
-
-  // Vectors to store indices.
-  arma::uvec subIndexSame;
-
-  for (size_t i = 0; i < uniqueLabels.n_cols; ++i)
+  // Each class is searched independently and writes a disjoint set of output
+  // columns, so the refresh searches can run concurrently.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) uniqueLabels.n_cols; ++i)
   {
     // Calculate impostors.
-    subIndexSame = arma::find(labels.cols(points.head(numPoints)) ==
+    arma::uvec subIndexSame = arma::find(labels.cols(points.head(numPoints)) ==
         uniqueLabels[i]);
 
+    // No query points of this class moved beyond the bound; keep the cached
+    // impostors and do not build a tree for this class.
+    if (subIndexSame.n_elem == 0)
+      continue;
+
+    // KNN instance.
+    KNN knn;
+
+    arma::Mat<size_t> neighbors;
+    arma::mat distances;
+
     // Perform KNN search with differently labeled points as reference
     // set and same class points as query set.
     knn.Train(dataset.cols(indexDiff[i]));
@@ -11,6 +11,8 @@
  */
 #include "lcc.hpp"
 #include <mlpack/core/math/lin_alg.hpp>
+#include <mlpack/core/util/parallel.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
 namespace mlpack {
 namespace lcc {
@@ -19,26 +21,53 @@ LocalCoordinateCoding::LocalCoordinateCoding(
     const size_t atoms,
     const double lambda,
     const size_t maxIterations,
-    const double tolerance) :
+    const double tolerance,
+    const size_t nearestAtoms) :
     atoms(atoms),
     lambda(lambda),
     maxIterations(maxIterations),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    nearestAtoms(nearestAtoms)
 {
   // Nothing to do.
 }
 
 void LocalCoordinateCoding::Encode(const arma::mat& data, arma::mat& codes)
 {
-  arma::mat invSqDists = 1.0 / (repmat(trans(sum(square(dictionary))), 1,
-      data.n_cols) + repmat(sum(square(data)), atoms, 1) - 2 * trans(dictionary)
-      * data);
+  // When a nearest-atoms prescreen is requested, find the atoms that may
+  // receive nonzero weight up front.  The LCC penalty weights each
+  // coefficient by the squared point-to-atom distance, so far-away atoms are
+  // heavily penalized and rarely enter the solution; restricting each solve
+  // to the nearest atoms makes the per-point problem much smaller.
+  const bool prescreen = (nearestAtoms > 0 && nearestAtoms < atoms);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat neighborDists;
+  arma::mat invSqDists;
+  if (prescreen)
+  {
+    // The dictionary is the reference set, so the search tree is built over
+    // the atoms and each point is a query.
+    neighbor::KNN knn(dictionary);
+    knn.Search(data, nearestAtoms, neighbors, neighborDists);
+  }
+  else
+  {
+    invSqDists = 1.0 / (repmat(trans(sum(square(dictionary))), 1,
+        data.n_cols) + repmat(sum(square(data)), atoms, 1) -
+        2 * trans(dictionary) * data);
+  }
 
+  // The Gram matrix is shared (read-only) by every solve; each per-point
+  // problem rescales the relevant part of it by its own distance weights.
   arma::mat dictGram = trans(dictionary) * dictionary;
-  arma::mat dictGramTD(dictGram.n_rows, dictGram.n_cols);
 
-  codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
+  codes.zeros(atoms, data.n_cols);
+
+  // The per-point solves are independent, so distribute them across threads;
+  // each solve only reads the shared dictionary and Gram matrix and writes
+  // its own column of the codes.
+  Parallel::For(0, data.n_cols, [&](const size_t i)
   {
     // Report progress.
     if ((i % 100) == 0)
@@ -46,21 +75,47 @@ void LocalCoordinateCoding::Encode(const arma::mat& data, arma::mat& codes)
       Log::Debug << "Optimization at point " << i << "." << std::endl;
     }
 
-    arma::vec invW = invSqDists.unsafe_col(i);
-    arma::mat dictPrime = dictionary * diagmat(invW);
+    const bool useCholesky = false;
 
-    arma::mat dictGramTD = diagmat(invW) * dictGram * diagmat(invW);
+    if (prescreen)
+    {
+      const arma::uvec localAtoms =
+          arma::conv_to<arma::uvec>::from(neighbors.col(i));
+      const arma::vec invW = 1.0 / arma::square(neighborDists.col(i));
 
-    bool useCholesky = false;
-    regression::LARS lars(useCholesky, dictGramTD, 0.5 * lambda);
+      arma::mat dictPrime = dictionary.cols(localAtoms) * diagmat(invW);
+      arma::mat dictGramTD = diagmat(invW) *
+          dictGram.submat(localAtoms, localAtoms) * diagmat(invW);
 
-    // Run LARS for this point, by making an alias of the point and passing
-    // that.
-    arma::vec beta = codes.unsafe_col(i);
-    arma::rowvec responses = data.unsafe_col(i).t();
-    lars.Train(dictPrime, responses, beta, false);
-    beta %= invW; // Remember, beta is an alias of codes.col(i).
-  }
+      regression::LARS lars(useCholesky, dictGramTD, 0.5 * lambda);
+
+      arma::vec beta;
+      arma::rowvec responses = data.unsafe_col(i).t();
+      lars.Train(dictPrime, responses, beta, false);
+      beta %= invW;
+
+      // Scatter the local solution back into the full code vector; atoms that
+      // were screened out keep a weight of zero.
+      for (size_t j = 0; j < localAtoms.n_elem; ++j)
+        codes(localAtoms[j], i) = beta[j];
+    }
+    else
+    {
+      arma::vec invW = invSqDists.unsafe_col(i);
+      arma::mat dictPrime = dictionary * diagmat(invW);
+
+      arma::mat dictGramTD = diagmat(invW) * dictGram * diagmat(invW);
+
+      regression::LARS lars(useCholesky, dictGramTD, 0.5 * lambda);
+
+      // Run LARS for this point, by making an alias of the point and passing
+      // that.
+      arma::vec beta = codes.unsafe_col(i);
+      arma::rowvec responses = data.unsafe_col(i).t();
+      lars.Train(dictPrime, responses, beta, false);
+      beta %= invW; // Remember, beta is an alias of codes.col(i).
+    }
+  });
 }
 
 void LocalCoordinateCoding::OptimizeDictionary(const arma::mat& data,
@@ -98,6 +98,8 @@ class LocalCoordinateCoding
    * @param maxIterations Maximum number of iterations for training (0 runs
    *      until convergence).
    * @param tolerance Tolerance for the objective function.
+   * @param nearestAtoms Number of nearest atoms each point may be coded with
+   *      (0 uses all atoms; see NearestAtoms()).
    * @param initializer Intializer to use.
    */
   template<
@@ -109,6 +111,7 @@ class LocalCoordinateCoding
                         const double lambda,
                         const size_t maxIterations = 0,
                         const double tolerance = 0.01,
+                        const size_t nearestAtoms = 0,
                         const DictionaryInitializer& initializer =
                             DictionaryInitializer());
 
@@ -123,11 +126,14 @@ class LocalCoordinateCoding
    * @param maxIterations Maximum number of iterations for training (0 runs
    *      until convergence).
    * @param tolerance Tolerance for the objective function.
+   * @param nearestAtoms Number of nearest atoms each point may be coded with
+   *      (0 uses all atoms; see NearestAtoms()).
    */
   LocalCoordinateCoding(const size_t atoms = 0,
                         const double lambda = 0.0,
                         const size_t maxIterations = 0,
-                        const double tolerance = 0.01);
+                        const double tolerance = 0.01,
+                        const size_t nearestAtoms = 0);
 
   /**
    * Run local coordinate coding.
@@ -145,7 +151,12 @@ class LocalCoordinateCoding
                    DictionaryInitializer());
 
   /**
-   * Code each point via distance-weighted LARS.
+   * Code each point via distance-weighted LARS.  The solves for different
+   * points are independent and are distributed across threads.  If
+   * NearestAtoms() is nonzero, each point is coded using only its
+   * NearestAtoms() nearest dictionary atoms (found with a kNN search over the
+   * atoms), so each LARS solve is much smaller; see NearestAtoms() for the
+   * reasoning.
    *
    * @param data Matrix containing points to encode.
    * @param codes Output matrix to store codes in.
@@ -203,6 +214,20 @@ class LocalCoordinateCoding
   //! Modify the objective tolerance.
   double& Tolerance() { return tolerance; }
 
+  //! Get the number of nearest atoms considered when coding each point.
+  size_t NearestAtoms() const { return nearestAtoms; }
+  /**
+   * Modify the number of nearest atoms considered when coding each point.
+   * The LCC penalty weights each coefficient by the squared distance between
+   * the point and the atom, so atoms far from a point rarely receive nonzero
+   * weight; restricting each solve to the nearest atoms exploits this.  The
+   * default of 0 considers all atoms, which recovers the exact solution.  A
+   * nonzero value prescreens the dictionary with a kNN search and codes each
+   * point using only its nearest atoms, which is an approximation but is much
+   * faster for large dictionaries.
+   */
+  size_t& NearestAtoms() { return nearestAtoms; }
+
   //! Serialize the model.
   template<typename Archive>
   void serialize(Archive& ar, const unsigned int /* version */);
@@ -221,11 +246,16 @@ class LocalCoordinateCoding
   size_t maxIterations;
   //! Tolerance for main objective.
   double tolerance;
+  //! Number of nearest atoms considered when coding a point (0 for all).
+  size_t nearestAtoms;
 };
 
 } // namespace lcc
 } // namespace mlpack
 
+// Version 1 adds the nearest-atoms prescreen setting.
+BOOST_CLASS_VERSION(mlpack::lcc::LocalCoordinateCoding, 1);
+
 // Include implementation.
 #include "lcc_impl.hpp"
 
@@ -25,11 +25,13 @@ LocalCoordinateCoding::LocalCoordinateCoding(
     const double lambda,
     const size_t maxIterations,
     const double tolerance,
+    const size_t nearestAtoms,
     const DictionaryInitializer& initializer) :
     atoms(atoms),
     lambda(lambda),
     maxIterations(maxIterations),
-    tolerance(tolerance)
+    tolerance(tolerance),
+    nearestAtoms(nearestAtoms)
 {
   // Train the model.
   Train(data, initializer);
@@ -108,13 +110,19 @@ double LocalCoordinateCoding::Train(
 
 template<typename Archive>
 void LocalCoordinateCoding::serialize(Archive& ar,
-                                      const unsigned int /* version */)
+                                      const unsigned int version)
 {
   ar & BOOST_SERIALIZATION_NVP(atoms);
   ar & BOOST_SERIALIZATION_NVP(dictionary);
   ar & BOOST_SERIALIZATION_NVP(lambda);
   ar & BOOST_SERIALIZATION_NVP(maxIterations);
   ar & BOOST_SERIALIZATION_NVP(tolerance);
+
+  // The nearest-atoms prescreen setting was added in version 1.
+  if (version > 0)
+    ar & BOOST_SERIALIZATION_NVP(nearestAtoms);
+  else if (Archive::is_loading::value)
+    nearestAtoms = 0;
 }
 
 } // namespace lcc
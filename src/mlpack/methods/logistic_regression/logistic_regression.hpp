@@ -39,6 +39,14 @@ template<typename MatType = arma::mat>
 class LogisticRegression
 {
  public:
+  //! The element type of the data.
+  typedef typename MatType::elem_type ElemType;
+  //! The type used to store the model parameters; this is always dense, even
+  //! when the data are sparse.
+  typedef arma::Mat<ElemType> DenseMatType;
+  //! A dense row vector of the same element type as the data.
+  typedef arma::Row<ElemType> DenseRowType;
+
   /**
    * Construct the LogisticRegression class with the given labeled training
    * data.  This will train the model.  Optionally, specify lambda, which is the
@@ -76,7 +84,7 @@ class LogisticRegression
    */
   LogisticRegression(const MatType& predictors,
                      const arma::Row<size_t>& responses,
-                     const arma::rowvec& initialPoint,
+                     const DenseRowType& initialPoint,
                      const double lambda = 0);
 
   /**
@@ -159,10 +167,39 @@ class LogisticRegression
                OptimizerType& optimizer,
                CallbackTypes&&... callbacks);
 
+  /**
+   * Train the LogisticRegression model along a path of L2-regularization
+   * parameters.  Each solve is warm-started from the previous one: the
+   * solution for lambdas[i] is used as the starting iterate for
+   * lambdas[i + 1], which is far cheaper than solving each lambda from
+   * scratch when the grid is reasonably dense.  Sweep from the most to the
+   * least regularized lambda for the best warm-start behavior.
+   *
+   * After this call the model holds the solution for the last element of
+   * lambdas, and Lambda() is set to that value.
+   *
+   * @tparam OptimizerType Type of optimizer to use to train the model.
+   * @tparam CallbackTypes Types of Callback Functions.
+   * @param predictors Input training variables.
+   * @param responses Outputs results from input training variables.
+   * @param lambdas L2-regularization parameters to sweep over (at least one).
+   * @param pathParameters Matrix to store the solutions in; row i will hold
+   *      the parameters trained with lambdas[i].
+   * @param callbacks Callback function for ensmallen optimizer `OptimizerType`.
+   *      See https://www.ensmallen.org/docs.html#callback-documentation.
+   * @return The final objective for each element of lambdas.
+   */
+  template<typename OptimizerType = ens::L_BFGS, typename... CallbackTypes>
+  arma::vec TrainPath(const MatType& predictors,
+                      const arma::Row<size_t>& responses,
+                      const arma::vec& lambdas,
+                      DenseMatType& pathParameters,
+                      CallbackTypes&&... callbacks);
+
   //! Return the parameters (the b vector).
-  const arma::rowvec& Parameters() const { return parameters; }
+  const DenseRowType& Parameters() const { return parameters; }
   //! Modify the parameters (the b vector).
-  arma::rowvec& Parameters() { return parameters; }
+  DenseRowType& Parameters() { return parameters; }
 
   //! Return the lambda value for L2-regularization.
   const double& Lambda() const { return lambda; }
@@ -206,7 +243,7 @@ class LogisticRegression
    * @param probabilities Class probabilities for each point (output).
    */
   void Classify(const MatType& dataset,
-                arma::mat& probabilities) const;
+                DenseMatType& probabilities) const;
 
   /**
    * Compute the accuracy of the model on the given predictors and responses,
@@ -243,7 +280,7 @@ class LogisticRegression
 
  private:
   //! Vector of trained parameters (size: dimensionality plus one).
-  arma::rowvec parameters;
+  DenseRowType parameters;
   //! L2-regularization penalty parameter.
   double lambda;
 };
@@ -30,6 +30,14 @@ template<typename MatType = arma::mat>
 class LogisticRegressionFunction
 {
  public:
+  //! The element type of the predictors.
+  typedef typename MatType::elem_type ElemType;
+  //! The type used to store the model parameters; this is always dense, even
+  //! when the predictors are sparse.
+  typedef arma::Mat<ElemType> DenseMatType;
+  //! A dense row vector of the same element type as the predictors.
+  typedef arma::Row<ElemType> DenseRowType;
+
   /**
    * Creates the LogisticRegressionFunction.
    *
@@ -67,7 +75,7 @@ class LogisticRegressionFunction
    *
    * @param parameters Vector of logistic regression parameters.
    */
-  double Evaluate(const arma::mat& parameters) const;
+  double Evaluate(const DenseMatType& parameters) const;
 
   /**
    * Evaluate the logistic regression log-likelihood function with the given
@@ -86,7 +94,7 @@ class LogisticRegressionFunction
    * @param batchSize Number of points to be passed at a time to use for
    *     objective function evaluation.
    */
-  double Evaluate(const arma::mat& parameters,
+  double Evaluate(const DenseMatType& parameters,
                   const size_t begin,
                   const size_t batchSize = 1) const;
 
@@ -97,7 +105,8 @@ class LogisticRegressionFunction
    * @param parameters Vector of logistic regression parameters.
    * @param gradient Vector to output gradient into.
    */
-  void Gradient(const arma::mat& parameters, arma::mat& gradient) const;
+  void Gradient(const DenseMatType& parameters,
+                DenseMatType& gradient) const;
 
   /**
    * Evaluate the gradient of the logistic regression log-likelihood function
@@ -113,7 +122,7 @@ class LogisticRegressionFunction
    *     function gradient evaluation.
    */
   template<typename GradType>
-  void Gradient(const arma::mat& parameters,
+  void Gradient(const DenseMatType& parameters,
                 const size_t begin,
                 GradType& gradient,
                 const size_t batchSize = 1) const;
@@ -129,16 +138,16 @@ class LogisticRegressionFunction
    *    be computed.
    * @param gradient Sparse matrix to output gradient into.
    */
-  void PartialGradient(const arma::mat& parameters,
+  void PartialGradient(const DenseMatType& parameters,
                        const size_t j,
-                       arma::sp_mat& gradient) const;
+                       arma::SpMat<ElemType>& gradient) const;
 
   /**
    * Evaluate the objective function and gradient of the logistic regression
    * log-likelihood function simultaneously with the given parameters.
    */
   template<typename GradType>
-  double EvaluateWithGradient(const arma::mat& parameters,
+  double EvaluateWithGradient(const DenseMatType& parameters,
                               GradType& gradient) const;
 
   /**
@@ -147,7 +156,7 @@ class LogisticRegressionFunction
    * the given batch size from a given point in the dataset.
    */
   template<typename GradType>
-  double EvaluateWithGradient(const arma::mat& parameters,
+  double EvaluateWithGradient(const DenseMatType& parameters,
                               const size_t begin,
                               GradType& gradient,
                               const size_t batchSize = 1) const;
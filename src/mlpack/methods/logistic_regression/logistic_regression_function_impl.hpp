@@ -16,6 +16,7 @@
 #include "logistic_regression_function.hpp"
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/math/accumulate.hpp>
 
 namespace mlpack {
 namespace regression {
@@ -67,7 +68,7 @@ void LogisticRegressionFunction<MatType>::Shuffle()
  */
 template<typename MatType>
 double LogisticRegressionFunction<MatType>::Evaluate(
-    const arma::mat& parameters) const
+    const DenseMatType& parameters) const
 {
   // The objective function is the log-likelihood function (w is the parameters
   // vector for the model; y is the responses; x is the predictors; sig() is the
@@ -84,7 +85,7 @@ double LogisticRegressionFunction<MatType>::Evaluate(
 
   // Calculate vectors of sigmoids.  The intercept term is parameters(0, 0) and
   // does not need to be multiplied by any of the predictors.
-  const arma::rowvec sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
+  const DenseRowType sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
       parameters.tail_cols(parameters.n_elem - 1) * predictors)));
 
   // Assemble full objective function.  Often the objective function and the
@@ -93,9 +94,9 @@ double LogisticRegressionFunction<MatType>::Evaluate(
   // terms for computational efficiency.  Note that the conversion causes some
   // copy and slowdown, but this is so negligible compared to the rest of the
   // calculation it is not worth optimizing for.
-  const double result = arma::accu(arma::log(1.0 -
-      arma::conv_to<arma::rowvec>::from(responses) + sigmoid %
-      (2 * arma::conv_to<arma::rowvec>::from(responses) - 1.0)));
+  const double result = math::AccuDouble(arma::log(1.0 -
+      arma::conv_to<DenseRowType>::from(responses) + sigmoid %
+      (2 * arma::conv_to<DenseRowType>::from(responses) - 1.0)));
 
   // Invert the result, because it's a minimization.
   return regularization - result;
@@ -107,7 +108,7 @@ double LogisticRegressionFunction<MatType>::Evaluate(
  */
 template<typename MatType>
 double LogisticRegressionFunction<MatType>::Evaluate(
-                  const arma::mat& parameters,
+                  const DenseMatType& parameters,
                   const size_t begin,
                   const size_t batchSize) const
 {
@@ -118,14 +119,14 @@ double LogisticRegressionFunction<MatType>::Evaluate(
                 parameters.tail_cols(parameters.n_elem - 1));
 
   // Calculate the sigmoid function values.
-  const arma::rowvec sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
+  const DenseRowType sigmoid = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
       parameters.tail_cols(parameters.n_elem - 1) *
       predictors.cols(begin, begin + batchSize - 1))));
 
   // Compute the objective for the given batch size from a given point.
-  arma::rowvec respD = arma::conv_to<arma::rowvec>::from(responses.subvec(begin,
+  DenseRowType respD = arma::conv_to<DenseRowType>::from(responses.subvec(begin,
       begin + batchSize - 1));
-  const double result = arma::accu(arma::log(1.0 - respD + sigmoid %
+  const double result = math::AccuDouble(arma::log(1.0 - respD + sigmoid %
       (2 * respD - 1.0)));
 
   // Invert the result, because it's a minimization.
@@ -135,20 +136,24 @@ double LogisticRegressionFunction<MatType>::Evaluate(
 //! Evaluate the gradient of the logistic regression objective function.
 template<typename MatType>
 void LogisticRegressionFunction<MatType>::Gradient(
-    const arma::mat& parameters,
-    arma::mat& gradient) const
+    const DenseMatType& parameters,
+    DenseMatType& gradient) const
 {
   // Regularization term.
-  arma::mat regularization;
+  DenseMatType regularization;
   regularization = lambda * parameters.tail_cols(parameters.n_elem - 1);
 
-  const arma::rowvec sigmoids = (1 / (1 + arma::exp(-parameters(0, 0)
+  const DenseRowType sigmoids = (1 / (1 + arma::exp(-parameters(0, 0)
       - parameters.tail_cols(parameters.n_elem - 1) * predictors)));
 
   gradient.set_size(arma::size(parameters));
   gradient[0] = -arma::accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
+  // Multiply against the predictors directly instead of against
+  // predictors.t(); this avoids materializing a transposed copy, which for
+  // sparse predictors would rebuild the whole matrix on every call.
+  gradient.tail_cols(parameters.n_elem - 1) =
+      arma::trans(predictors * arma::trans(sigmoids - responses)) +
+      regularization;
 }
 
 //! Evaluate the gradient of the logistic regression objective function for a
@@ -156,28 +161,30 @@ void LogisticRegressionFunction<MatType>::Gradient(
 template<typename MatType>
 template<typename GradType>
 void LogisticRegressionFunction<MatType>::Gradient(
-                const arma::mat& parameters,
+                const DenseMatType& parameters,
                 const size_t begin,
                 GradType& gradient,
                 const size_t batchSize) const
 {
   // Regularization term.
-  arma::mat regularization;
+  DenseMatType regularization;
   regularization = lambda * parameters.tail_cols(parameters.n_elem - 1)
       / predictors.n_cols * batchSize;
 
-  const arma::rowvec exponents = parameters(0, 0) +
+  const DenseRowType exponents = parameters(0, 0) +
       parameters.tail_cols(parameters.n_elem - 1) *
       predictors.cols(begin, begin + batchSize - 1);
   // Calculating the sigmoid function values.
-  const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-exponents));
+  const DenseRowType sigmoids = 1.0 / (1.0 + arma::exp(-exponents));
 
   gradient.set_size(parameters.n_rows, parameters.n_cols);
   gradient[0] = -arma::accu(responses.subvec(begin, begin + batchSize - 1) -
       sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  // As in the full-dataset overload, avoid transposing the predictor batch.
+  gradient.tail_cols(parameters.n_elem - 1) =
+      arma::trans(predictors.cols(begin, begin + batchSize - 1) *
+      arma::trans(sigmoids - responses.subvec(begin, begin + batchSize - 1))) +
+      regularization;
 }
 
 /**
@@ -186,11 +193,11 @@ void LogisticRegressionFunction<MatType>::Gradient(
  */
 template <typename MatType>
 void LogisticRegressionFunction<MatType>::PartialGradient(
-    const arma::mat& parameters,
+    const DenseMatType& parameters,
     const size_t j,
-    arma::sp_mat& gradient) const
+    arma::SpMat<ElemType>& gradient) const
 {
-  const arma::rowvec diffs = responses - (1 / (1 + arma::exp(-parameters(0, 0)
+  const DenseRowType diffs = responses - (1 / (1 + arma::exp(-parameters(0, 0)
       - parameters.tail_cols(parameters.n_elem - 1) * predictors)));
 
   gradient.set_size(arma::size(parameters));
@@ -209,11 +216,11 @@ void LogisticRegressionFunction<MatType>::PartialGradient(
 template<typename MatType>
 template<typename GradType>
 double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
-    const arma::mat& parameters,
+    const DenseMatType& parameters,
     GradType& gradient) const
 {
   // Regularization term.
-  arma::mat regularization = lambda *
+  DenseMatType regularization = lambda *
       parameters.tail_cols(parameters.n_elem - 1);
 
   const double objectiveRegularization = lambda / 2.0 *
@@ -221,18 +228,20 @@ double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
                 parameters.tail_cols(parameters.n_elem - 1));
 
   // Calculate the sigmoid function values.
-  const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
+  const DenseRowType sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
       parameters.tail_cols(parameters.n_elem - 1) * predictors)));
 
   gradient.set_size(arma::size(parameters));
   gradient[0] = -arma::accu(responses - sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids - responses) *
-      predictors.t() + regularization;
+  // Avoid materializing a transposed copy of the predictors; see Gradient().
+  gradient.tail_cols(parameters.n_elem - 1) =
+      arma::trans(predictors * arma::trans(sigmoids - responses)) +
+      regularization;
 
   // Now compute the objective function using the sigmoids.
-  double result = arma::accu(arma::log(1.0 -
-      arma::conv_to<arma::rowvec>::from(responses) + sigmoids %
-      (2 * arma::conv_to<arma::rowvec>::from(responses) - 1.0)));
+  double result = math::AccuDouble(arma::log(1.0 -
+      arma::conv_to<DenseRowType>::from(responses) + sigmoids %
+      (2 * arma::conv_to<DenseRowType>::from(responses) - 1.0)));
 
   // Invert the result, because it's a minimization.
   return objectiveRegularization - result;
@@ -241,13 +250,13 @@ double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
 template<typename MatType>
 template<typename GradType>
 double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
-    const arma::mat& parameters,
+    const DenseMatType& parameters,
     const size_t begin,
     GradType& gradient,
     const size_t batchSize) const
 {
   // Regularization term.
-  arma::mat regularization =
+  DenseMatType regularization =
       lambda * parameters.tail_cols(parameters.n_elem - 1) / predictors.n_cols *
       batchSize;
 
@@ -257,21 +266,23 @@ double LogisticRegressionFunction<MatType>::EvaluateWithGradient(
                 parameters.tail_cols(parameters.n_elem - 1));
 
   // Calculate the sigmoid function values.
-  const arma::rowvec sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
+  const DenseRowType sigmoids = 1.0 / (1.0 + arma::exp(-(parameters(0, 0) +
       parameters.tail_cols(parameters.n_elem - 1) *
       predictors.cols(begin, begin + batchSize - 1))));
 
   gradient.set_size(parameters.n_rows, parameters.n_cols);
   gradient[0] = -arma::accu(responses.subvec(begin, begin + batchSize - 1) -
       sigmoids);
-  gradient.tail_cols(parameters.n_elem - 1) = (sigmoids -
-      responses.subvec(begin, begin + batchSize - 1)) *
-      predictors.cols(begin, begin + batchSize - 1).t() + regularization;
+  // Avoid transposing the predictor batch; see Gradient().
+  gradient.tail_cols(parameters.n_elem - 1) =
+      arma::trans(predictors.cols(begin, begin + batchSize - 1) *
+      arma::trans(sigmoids - responses.subvec(begin, begin + batchSize - 1))) +
+      regularization;
 
   // Now compute the objective function using the sigmoids.
-  arma::rowvec respD = arma::conv_to<arma::rowvec>::from(responses.subvec(begin,
+  DenseRowType respD = arma::conv_to<DenseRowType>::from(responses.subvec(begin,
       begin + batchSize - 1));
-  const double result = arma::accu(arma::log(1.0 - respD + sigmoids %
+  const double result = math::AccuDouble(arma::log(1.0 - respD + sigmoids %
       (2 * respD - 1.0)));
 
   // Invert the result, because it's a minimization.
@@ -34,7 +34,7 @@ template<typename MatType>
 LogisticRegression<MatType>::LogisticRegression(
     const MatType& predictors,
     const arma::Row<size_t>& responses,
-    const arma::rowvec& initialPoint,
+    const DenseRowType& initialPoint,
     const double lambda) :
     parameters(initialPoint),
     lambda(lambda)
@@ -46,7 +46,7 @@ template<typename MatType>
 LogisticRegression<MatType>::LogisticRegression(
     const size_t dimensionality,
     const double lambda) :
-    parameters(arma::rowvec(dimensionality + 1, arma::fill::zeros)),
+    parameters(DenseRowType(dimensionality + 1, arma::fill::zeros)),
     lambda(lambda)
 {
   // No training to do here.
@@ -88,7 +88,7 @@ double LogisticRegression<MatType>::Train(
 
   // Set size of parameters vector according to the input data received.
   if (parameters.n_elem != predictors.n_rows + 1)
-    parameters = arma::rowvec(predictors.n_rows + 1, arma::fill::zeros);
+    parameters = DenseRowType(predictors.n_rows + 1, arma::fill::zeros);
 
   Timer::Start("logistic_regression_optimization");
   const double out = optimizer.Optimize(errorFunction, parameters,
@@ -101,6 +101,37 @@ double LogisticRegression<MatType>::Train(
   return out;
 }
 
+template<typename MatType>
+template<typename OptimizerType, typename... CallbackTypes>
+arma::vec LogisticRegression<MatType>::TrainPath(
+    const MatType& predictors,
+    const arma::Row<size_t>& responses,
+    const arma::vec& lambdas,
+    DenseMatType& pathParameters,
+    CallbackTypes&&... callbacks)
+{
+  if (lambdas.n_elem == 0)
+  {
+    throw std::invalid_argument("LogisticRegression::TrainPath(): at least "
+        "one regularization parameter must be given");
+  }
+
+  arma::vec objectives(lambdas.n_elem);
+  pathParameters.set_size(lambdas.n_elem, predictors.n_rows + 1);
+
+  for (size_t i = 0; i < lambdas.n_elem; ++i)
+  {
+    lambda = lambdas[i];
+    // Train() keeps the existing parameters as the starting iterate, so each
+    // solve is warm-started from the previous lambda's solution.
+    OptimizerType optimizer;
+    objectives[i] = Train(predictors, responses, optimizer, callbacks...);
+    pathParameters.row(i) = parameters;
+  }
+
+  return objectives;
+}
+
 template<typename MatType>
 template<typename VecType>
 size_t LogisticRegression<MatType>::Classify(const VecType& point,
@@ -127,7 +158,7 @@ void LogisticRegression<MatType>::Classify(const MatType& dataset,
 
 template<typename MatType>
 void LogisticRegression<MatType>::Classify(const MatType& dataset,
-                                           arma::mat& probabilities) const
+                                           DenseMatType& probabilities) const
 {
   // Set correct size of output matrix.
   probabilities.set_size(2, dataset.n_cols);
@@ -143,7 +174,7 @@ double LogisticRegression<MatType>::ComputeError(
     const arma::Row<size_t>& responses) const
 {
   // Construct a new error function.
-  LogisticRegressionFunction<> newErrorFunction(predictors, responses,
+  LogisticRegressionFunction<MatType> newErrorFunction(predictors, responses,
       lambda);
 
   return newErrorFunction.Evaluate(parameters);
@@ -386,35 +386,6 @@ class LSHSearch
                                 const size_t T,
                                 arma::mat& additionalProbingBins) const;
 
-  /**
-   * Returns the score of a perturbation vector generated by perturbation set A.
-   * The score of a pertubation set (vector) is the sum of scores of the
-   * participating actions.
-   * @param A perturbation set to compute the score of.
-   * @param scores vector containing score of each perturbation.
-  */
-  double PerturbationScore(const std::vector<bool>& A,
-                           const arma::vec& scores) const;
-
-  /**
-   * Inline function used by GetAdditionalProbingBins. The vector shift
-   * operation replaces the largest element of a vector A with (largest element)
-   * + 1.  Returns true if resulting vector is valid, otherwise false.
-   *
-   * @param A perturbation set to shift.
-   */
-  bool PerturbationShift(std::vector<bool>& A) const;
-
-  /**
-   * Inline function used by GetAdditionalProbingBins. The vector expansion
-   * operation adds the element [1 + (largest_element)] to a vector A, where
-   * largest_element is the largest element of A. Returns true if resulting
-   * vector is valid, otherwise false.
-   *
-   * @param A perturbation set to expand.
-   */
-  bool PerturbationExpand(std::vector<bool>& A) const;
-
   /**
    * Return true if perturbation set A is valid. A perturbation set is invalid
    * if it contains two (or more) actions for the same dimension or dimensions
@@ -258,7 +258,11 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
   // size_t, otherwise negative numbers are cast to 0.
   arma::Mat<size_t> secondHashVectors(numTables, this->referenceSet.n_cols);
 
-  for (size_t i = 0; i < numTables; ++i)
+  // Each table depends only on its own projection slice and offset column and
+  // writes only its own row of secondHashVectors, so the tables can be hashed
+  // in parallel.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) numTables; ++i)
   {
     // Step IV: create the 'numProj'-dimensional key for each point in each
     // table.
@@ -271,10 +275,8 @@ void LSHSearch<SortPolicy, MatType>::Train(MatType referenceSet,
     // and the corresponding offset be 'offset_i'.  Then the key of a single
     // point is obtained as:
     // key = { floor((<proj_i, point> + offset_i) / 'hashWidth') forall i }
-    arma::mat offsetMat = arma::repmat(offsets.unsafe_col(i), 1,
-                                       this->referenceSet.n_cols);
     arma::mat hashMat = projections.slice(i).t() * (this->referenceSet);
-    hashMat += offsetMat;
+    hashMat.each_col() += offsets.unsafe_col(i);
     hashMat /= hashWidth;
 
     // Step V: Putting the points in the 'secondHashTable' by hashing the key.
@@ -439,57 +441,6 @@ void LSHSearch<SortPolicy, MatType>::BaseCase(
   }
 }
 
-template<typename SortPolicy, typename MatType>
-inline force_inline
-double LSHSearch<SortPolicy, MatType>::PerturbationScore(
-    const std::vector<bool>& A,
-    const arma::vec& scores) const
-{
-  double score = 0.0;
-  for (size_t i = 0; i < A.size(); ++i)
-    if (A[i])
-      score += scores(i); // add scores of non-zero indices
-  return score;
-}
-
-template<typename SortPolicy, typename MatType>
-inline force_inline
-bool LSHSearch<SortPolicy, MatType>::PerturbationShift(
-    std::vector<bool>& A) const
-{
-  size_t maxPos = 0;
-  for (size_t i = 0; i < A.size(); ++i)
-    if (A[i] == 1) // Marked true.
-      maxPos = i;
-
-  if (maxPos + 1 < A.size()) // Otherwise, this is an invalid vector.
-  {
-    A[maxPos] = 0;
-    A[maxPos + 1] = 1;
-    return true; // valid
-  }
-  return false; // invalid
-}
-
-template<typename SortPolicy, typename MatType>
-inline force_inline
-bool LSHSearch<SortPolicy, MatType>::PerturbationExpand(
-    std::vector<bool>& A) const
-{
-  // Find the last '1' in A.
-  size_t maxPos = 0;
-  for (size_t i = 0; i < A.size(); ++i)
-    if (A[i]) // Marked true.
-      maxPos = i;
-
-  if (maxPos + 1 < A.size()) // Otherwise, this is an invalid vector.
-  {
-    A[maxPos + 1] = 1;
-    return true;
-  }
-  return false;
-}
-
 template<typename SortPolicy, typename MatType>
 inline force_inline
 bool LSHSearch<SortPolicy, MatType>::PerturbationValid(
@@ -645,6 +596,16 @@ void LSHSearch<SortPolicy, MatType>::GetAdditionalProbingBins(
   std::vector< std::vector<bool> > perturbationSets;
   perturbationSets.push_back(Ao); // Storage of perturbation sets.
 
+  // Since the shift and expand operations only ever touch the largest marked
+  // position of a set, we cache each set's score and largest marked position
+  // alongside it.  That way a derived set's score is a constant-time update of
+  // its parent's score instead of a fresh O(numProj) summation, and we never
+  // have to rescan a set to find where to shift or expand it.
+  std::vector<double> setScores;
+  std::vector<size_t> setMaxPos;
+  setScores.push_back(scores[0]);
+  setMaxPos.push_back(0);
+
   std::priority_queue<
     std::pair<double, size_t>,        // contents: pairs of (score, index)
     std::vector<                      // container: vector of pairs
@@ -654,7 +615,7 @@ void LSHSearch<SortPolicy, MatType>::GetAdditionalProbingBins(
   > minHeap; // our minheap
 
   // Start by adding the lowest scoring set to the minheap.
-  minHeap.push(std::make_pair(PerturbationScore(Ao, scores), 0));
+  minHeap.push(std::make_pair(setScores[0], 0));
 
   // Loop invariable: after pvec iterations, additionalProbingBins contains pvec
   // valid codes of the lowest-scoring bins (bins most likely to contain
@@ -665,31 +626,42 @@ void LSHSearch<SortPolicy, MatType>::GetAdditionalProbingBins(
     do
     {
       // Get the perturbation set corresponding to the minimum score.
-      Ai = perturbationSets[ minHeap.top().second ];
+      const size_t setIndex = minHeap.top().second;
       minHeap.pop(); // .top() returns, .pop() removes
+      Ai = perturbationSets[setIndex];
+      const double AiScore = setScores[setIndex];
+      const size_t maxPos = setMaxPos[setIndex];
 
-      // Shift operation on Ai (replace max with max+1).
-      std::vector<bool> As = Ai;
-
-      // Don't add invalid sets.
-      if (PerturbationShift(As) && PerturbationValid(As))
+      if (maxPos + 1 < 2 * numProj) // Otherwise no derived set is valid.
       {
-        perturbationSets.push_back(As); // add shifted set to sets
-        minHeap.push(
-            std::make_pair(PerturbationScore(As, scores),
-            perturbationSets.size() - 1));
-      }
+        // Shift operation on Ai (replace max with max+1).
+        std::vector<bool> As = Ai;
+        As[maxPos] = 0;
+        As[maxPos + 1] = 1;
+
+        // Don't add invalid sets.
+        if (PerturbationValid(As))
+        {
+          perturbationSets.push_back(std::move(As)); // add shifted set to sets
+          setScores.push_back(AiScore - scores[maxPos] + scores[maxPos + 1]);
+          setMaxPos.push_back(maxPos + 1);
+          minHeap.push(
+              std::make_pair(setScores.back(), perturbationSets.size() - 1));
+        }
 
-      // Expand operation on Ai (add max+1 to set).
-      std::vector<bool> Ae = Ai;
+        // Expand operation on Ai (add max+1 to set).
+        std::vector<bool> Ae = Ai;
+        Ae[maxPos + 1] = 1;
 
-      // Don't add invalid sets.
-      if (PerturbationExpand(Ae) && PerturbationValid(Ae))
-      {
-        perturbationSets.push_back(Ae); // add expanded set to sets
-        minHeap.push(
-            std::make_pair(PerturbationScore(Ae, scores),
-            perturbationSets.size() - 1));
+        // Don't add invalid sets.
+        if (PerturbationValid(Ae))
+        {
+          perturbationSets.push_back(std::move(Ae)); // add expanded set to sets
+          setScores.push_back(AiScore + scores[maxPos + 1]);
+          setMaxPos.push_back(maxPos + 1);
+          minHeap.push(
+              std::make_pair(setScores.back(), perturbationSets.size() - 1));
+        }
       }
     } while (!PerturbationValid(Ai)); // Discard invalid perturbations
 
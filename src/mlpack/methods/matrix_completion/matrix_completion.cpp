@@ -20,7 +20,7 @@ MatrixCompletion::MatrixCompletion(const size_t m,
                                    const arma::umat& indices,
                                    const arma::vec& values,
                                    const size_t r) :
-    m(m), n(n), indices(indices), values(values),
+    m(m), n(n), indices(indices), values(values), maxRank(r),
     sdp(indices.n_cols, 0, arma::randu<arma::mat>(m + n, r))
 {
   CheckValues();
@@ -32,7 +32,7 @@ MatrixCompletion::MatrixCompletion(const size_t m,
                                    const arma::umat& indices,
                                    const arma::vec& values,
                                    const arma::mat& initialPoint) :
-    m(m), n(n), indices(indices), values(values),
+    m(m), n(n), indices(indices), values(values), maxRank(0),
     sdp(indices.n_cols, 0, initialPoint)
 {
   CheckValues();
@@ -43,7 +43,7 @@ MatrixCompletion::MatrixCompletion(const size_t m,
                                    const size_t n,
                                    const arma::umat& indices,
                                    const arma::vec& values) :
-    m(m), n(n), indices(indices), values(values),
+    m(m), n(n), indices(indices), values(values), maxRank(0),
     sdp(indices.n_cols, 0,
         arma::randu<arma::mat>(m + n, DefaultRank(m, n, indices.n_cols)))
 {
@@ -94,10 +94,52 @@ void MatrixCompletion::Recover(arma::mat& recovered)
 {
   recovered = sdp.Function().GetInitialPoint();
   sdp.Optimize(recovered);
+  // Keep the factorization around so that later solves, after new entries
+  // have been added, can warm-start from it.
+  factorization = recovered;
   recovered = recovered * trans(recovered);
   recovered = recovered(arma::span(0, m - 1), arma::span(m, m + n - 1));
 }
 
+void MatrixCompletion::AddEntries(const arma::umat& newIndices,
+                                  const arma::vec& newValues)
+{
+  indices = arma::join_rows(indices, newIndices);
+  values = arma::join_cols(values, arma::mat(newValues));
+  CheckValues();
+
+  // Pick the rank of the initial point: the cap if one was given, otherwise
+  // the usual O(sqrt(p)) bound for the enlarged constraint set.
+  const size_t r = (maxRank > 0) ? maxRank :
+      DefaultRank(m, n, indices.n_cols);
+
+  arma::mat initialPoint;
+  if (factorization.n_elem > 0)
+  {
+    // Warm-start from the previous solution; adjust its rank if the bound
+    // changed.  New columns get a small random perturbation so the optimizer
+    // can make use of them.
+    initialPoint = factorization;
+    if (initialPoint.n_cols > r)
+    {
+      initialPoint.shed_cols(r, initialPoint.n_cols - 1);
+    }
+    else if (initialPoint.n_cols < r)
+    {
+      initialPoint = arma::join_rows(initialPoint,
+          0.01 * arma::randu<arma::mat>(m + n, r - initialPoint.n_cols));
+    }
+  }
+  else
+  {
+    initialPoint = arma::randu<arma::mat>(m + n, r);
+  }
+
+  // Rebuild the SDP with one constraint per known entry.
+  sdp = ens::LRSDP<ens::SDP<arma::sp_mat>>(indices.n_cols, 0, initialPoint);
+  InitSDP();
+}
+
 size_t MatrixCompletion::DefaultRank(const size_t m,
                                      const size_t n,
                                      const size_t p)
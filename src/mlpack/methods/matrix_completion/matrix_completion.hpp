@@ -110,6 +110,26 @@ class MatrixCompletion
    */
   void Recover(arma::mat& recovered);
 
+  /**
+   * Add newly observed entries to the completion problem.  The underlying SDP
+   * is rebuilt with the enlarged constraint set, and---if Recover() has been
+   * called before---the optimization is warm-started from the factorization of
+   * the previous solution, so a refresh after a small batch of new entries is
+   * much cheaper than a solve from scratch.  The rank of the warm-started
+   * point is capped by MaxRank() when it is nonzero.
+   *
+   * @param newIndices Matrix containing the indices of the new entries (must
+   *    be [2 x q]).
+   * @param newValues Vector containing the values of the new entries (must be
+   *    length q).
+   */
+  void AddEntries(const arma::umat& newIndices, const arma::vec& newValues);
+
+  //! Get the maximum rank of the solution (0 means automatic selection).
+  size_t MaxRank() const { return maxRank; }
+  //! Modify the maximum rank of the solution (0 means automatic selection).
+  size_t& MaxRank() { return maxRank; }
+
   //! Return the underlying SDP.
   const ens::LRSDP<ens::SDP<arma::sp_mat>>& Sdp() const
   {
@@ -128,6 +148,13 @@ class MatrixCompletion
   //! Vector containing the values of the known entries.
   arma::mat values;
 
+  //! Maximum rank of the solution (0 means automatic selection).
+  size_t maxRank;
+
+  //! Factorization of the last recovered matrix, used to warm-start the
+  //! optimization after new entries are added (empty before the first solve).
+  arma::mat factorization;
+
   //! The underlying SDP to be solved.
   ens::LRSDP<ens::SDP<arma::sp_mat>> sdp;
 
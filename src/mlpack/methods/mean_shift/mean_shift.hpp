@@ -17,6 +17,7 @@
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
 #include <mlpack/core/kernels/kernel_traits.hpp>
 #include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/metrics/pairwise_distances.hpp>
 #include <boost/utility.hpp>
 
 namespace mlpack {
@@ -76,7 +77,10 @@ class MeanShift
 
   /**
    * Perform mean shift clustering on the data, returning a list of cluster
-   * assignments and centroids.
+   * assignments and centroids.  All seeds that have not yet converged are
+   * advanced together: each iteration performs a single batched dual-tree
+   * range search against a reference tree that is built only once, and
+   * converged seeds are frozen so they cost nothing in later iterations.
    *
    * @tparam MatType Type of matrix.
    * @param data Dataset to cluster.
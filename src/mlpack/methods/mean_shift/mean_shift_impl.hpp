@@ -207,58 +207,76 @@ inline void MeanShift<UseKernel, KernelType, MatType>::Cluster(
 
   assignments.set_size(data.n_cols);
 
+  // The reference tree is built once here and reused by every batched search
+  // in the loop below.
   range::RangeSearch<> rangeSearcher(data);
   math::Range validRadius(0, radius);
   std::vector<std::vector<size_t> > neighbors;
   std::vector<std::vector<double> > distances;
 
-  // For each seed, perform mean shift algorithm.
+  // All seeds start active.  Each iteration performs one dual-tree range
+  // search for every active centroid at once, instead of a separate
+  // single-tree search per seed per iteration; a seed is frozen (removed
+  // from the active set) as soon as it converges or its neighborhood turns
+  // out to be empty, so later iterations only pay for the seeds that are
+  // still moving.
+  arma::uvec activeSeeds(pSeeds->n_cols);
   for (size_t i = 0; i < pSeeds->n_cols; ++i)
   {
     // Initial centroid is the seed itself.
     allCentroids.col(i) = pSeeds->unsafe_col(i);
-    for (size_t completedIterations = 0; completedIterations < maxIterations
-        || forceConvergence; completedIterations++)
-    {
-      // Store new centroid in this.
-      arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
+    activeSeeds[i] = i;
+  }
+
+  for (size_t completedIterations = 0; activeSeeds.n_elem > 0 &&
+      (completedIterations < maxIterations || forceConvergence);
+      completedIterations++)
+  {
+    // Perform one batched search for all active centroids.
+    const arma::mat queries = allCentroids.cols(activeSeeds);
+    rangeSearcher.Search(queries, validRadius, neighbors, distances);
 
-      rangeSearcher.Search(allCentroids.unsafe_col(i), validRadius,
-          neighbors, distances);
-      if (neighbors[0].size() == 0) // There are no points in the cluster.
-        break;
+    arma::uvec stillActive(activeSeeds.n_elem);
+    size_t numStillActive = 0;
+    for (size_t j = 0; j < activeSeeds.n_elem; ++j)
+    {
+      const size_t i = activeSeeds[j];
+      if (neighbors[j].size() == 0) // There are no points in the cluster.
+        continue;
 
       // Calculate new centroid.
-      if (!CalculateCentroid(data, neighbors[0], distances[0], newCentroid))
+      arma::colvec newCentroid = arma::zeros<arma::colvec>(pSeeds->n_rows);
+      if (!CalculateCentroid(data, neighbors[j], distances[j], newCentroid))
         newCentroid = allCentroids.unsafe_col(i);
 
       // If the mean shift vector is small enough, it has converged.
       if (metric::EuclideanDistance::Evaluate(newCentroid,
           allCentroids.unsafe_col(i)) < 1e-3 * radius)
       {
-        // Determine if the new centroid is duplicate with old ones.
+        // Determine if the new centroid is duplicate with old ones; the
+        // distances to all existing centroids are computed in one batch.
         bool isDuplicated = false;
-        for (size_t k = 0; k < centroids.n_cols; ++k)
+        if (centroids.n_cols > 0)
         {
-          const double distance = metric::EuclideanDistance::Evaluate(
-              allCentroids.unsafe_col(i), centroids.unsafe_col(k));
-          if (distance < radius)
-          {
-            isDuplicated = true;
-            break;
-          }
+          arma::mat centroidDistances;
+          metric::PairwiseDistances(arma::mat(allCentroids.col(i)), centroids,
+              centroidDistances, metric::EuclideanDistance());
+          isDuplicated = (centroidDistances.min() < radius);
         }
 
         if (!isDuplicated)
           centroids.insert_cols(centroids.n_cols, allCentroids.unsafe_col(i));
 
-        // Get out of the loop.
-        break;
+        // The seed is frozen.
+        continue;
       }
 
-      // Update the centroid.
+      // Update the centroid; the seed stays active.
       allCentroids.col(i) = newCentroid;
+      stillActive[numStillActive++] = i;
     }
+
+    activeSeeds = stillActive.head(numStillActive);
   }
 
   // If no centroid has converged due to too little iterations and without
@@ -202,17 +202,17 @@ class NaiveBayesClassifier
   //! Get the sample means for each class.
   const ModelMatType& Means() const { return means; }
   //! Modify the sample means for each class.
-  ModelMatType& Means() { return means; }
+  ModelMatType& Means() { scoringCoefsValid = false; return means; }
 
   //! Get the sample variances for each class.
   const ModelMatType& Variances() const { return variances; }
   //! Modify the sample variances for each class.
-  ModelMatType& Variances() { return variances; }
+  ModelMatType& Variances() { scoringCoefsValid = false; return variances; }
 
   //! Get the prior probabilities for each class.
   const ModelMatType& Probabilities() const { return probabilities; }
   //! Modify the prior probabilities for each class.
-  ModelMatType& Probabilities() { return probabilities; }
+  ModelMatType& Probabilities() { scoringCoefsValid = false; return probabilities; }
 
   //! Serialize the classifier.
   template<typename Archive>
@@ -230,6 +230,26 @@ class NaiveBayesClassifier
   //! Small value to prevent log of zero.
   double epsilon;
 
+  /**
+   * Fused scoring coefficients, one row per class: the first `means.n_rows`
+   * columns hold mean/variance, the next `means.n_rows` columns hold
+   * -0.5/variance, and the last column holds the per-class constant term of
+   * the log likelihood.  This lets LogLikelihood() evaluate all classes for a
+   * whole block of points with two matrix products instead of per-class
+   * temporaries.  It is mutable (together with the validity flag) because it
+   * is lazily refreshed from const methods after the model has been modified
+   * through the non-const accessors.
+   */
+  mutable ModelMatType scoringCoefs;
+  //! Whether scoringCoefs matches the current model parameters.
+  mutable bool scoringCoefsValid;
+
+  /**
+   * Recompute the fused scoring coefficients from the current means,
+   * variances and class probabilities.
+   */
+  void UpdateScoringCoefs() const;
+
   /**
    * Compute the unnormalized posterior log probability of given points (log
    * likelihood). Results are returned as arma::mat, and each column represents
@@ -34,7 +34,8 @@ NaiveBayesClassifier<ModelMatType>::NaiveBayesClassifier(
     const bool incremental,
     const double epsilon) :
     trainingPoints(0), // Set when we call Train().
-    epsilon(epsilon)
+    epsilon(epsilon),
+    scoringCoefsValid(false)
 {
   static_assert(std::is_same<ElemType, typename MatType::elem_type>::value,
       "NaiveBayesClassifier: element type of given data must match the element "
@@ -65,7 +66,8 @@ NaiveBayesClassifier<ModelMatType>::NaiveBayesClassifier(
     const size_t numClasses,
     const double epsilon) :
     trainingPoints(0),
-    epsilon(epsilon)
+    epsilon(epsilon),
+    scoringCoefsValid(false)
 {
   // Initialize model to 0.
   probabilities.zeros(numClasses);
@@ -118,7 +120,7 @@ void NaiveBayesClassifier<ModelMatType>::Train(
       const size_t label = labels[j];
       ++probabilities[label];
 
-      arma::vec delta = data.col(j) - means.col(label);
+      arma::Col<ElemType> delta = data.col(j) - means.col(label);
       means.col(label) += delta / probabilities[label];
       variances.col(label) += delta % (data.col(j) - means.col(label));
     }
@@ -173,6 +175,10 @@ void NaiveBayesClassifier<ModelMatType>::Train(
 
   probabilities /= data.n_cols;
   trainingPoints += data.n_cols;
+
+  // Refresh the fused scoring coefficients eagerly, so that the model can be
+  // scored right away without a lazy update on the first Classify() call.
+  UpdateScoringCoefs();
 }
 
 template<typename ModelMatType>
@@ -188,7 +194,7 @@ void NaiveBayesClassifier<ModelMatType>::Train(const VecType& point,
   probabilities *= trainingPoints;
   probabilities[label]++;
 
-  arma::vec delta = point - means.col(label);
+  arma::Col<ElemType> delta = point - means.col(label);
   means.col(label) += delta / probabilities[label];
   if (probabilities[label] > 2)
     variances.col(label) *= (probabilities[label] - 2);
@@ -198,6 +204,32 @@ void NaiveBayesClassifier<ModelMatType>::Train(const VecType& point,
 
   trainingPoints++;
   probabilities /= trainingPoints;
+
+  // Invalidate the fused scoring coefficients instead of refreshing them;
+  // streaming training would otherwise pay the full refresh for every point.
+  scoringCoefsValid = false;
+}
+
+template<typename ModelMatType>
+void NaiveBayesClassifier<ModelMatType>::UpdateScoringCoefs() const
+{
+  const size_t dims = means.n_rows;
+
+  // The log likelihood of a point x for class i is
+  //   log(p_i) - dims / 2 * log(2 * pi) - 0.5 * sum(log(var_i))
+  //       - 0.5 * sum((x - mean_i)^2 / var_i),
+  // which, after expanding the square, is a linear function of x and x^2:
+  //   (mean_i / var_i)^T x - 0.5 * (1 / var_i)^T x^2 + constant_i.
+  // The coefficients of that form are precomputed here, one row per class.
+  scoringCoefs.set_size(means.n_cols, 2 * dims + 1);
+  scoringCoefs.cols(0, dims - 1) = (means / variances).t();
+  scoringCoefs.cols(dims, 2 * dims - 1) = (-0.5 / variances).t();
+  scoringCoefs.col(2 * dims) = arma::log(probabilities) -
+      dims / 2.0 * std::log(2 * M_PI) -
+      0.5 * arma::sum(arma::log(variances), 0).t() -
+      0.5 * arma::sum(arma::square(means) / variances, 0).t();
+
+  scoringCoefsValid = true;
 }
 
 template<typename ModelMatType>
@@ -210,24 +242,18 @@ void NaiveBayesClassifier<ModelMatType>::LogLikelihood(
       "NaiveBayesClassifier: element type of given data must match the element "
       "type of the model!");
 
-  logLikelihoods = arma::log(arma::repmat(probabilities, 1, data.n_cols));
-  ModelMatType invVar = 1.0 / variances;
+  // Refresh the fused coefficients if the model was modified through the
+  // non-const accessors or trained point by point.
+  if (!scoringCoefsValid)
+    UpdateScoringCoefs();
 
-  // Calculate the joint log likelihood of point for each of the
-  // means.n_cols.
+  const size_t dims = means.n_rows;
 
-  // Loop over every class.
-  for (size_t i = 0; i < means.n_cols; ++i)
-  {
-    // This is an adaptation of gmm::phi() for the case where the covariance is
-    // a diagonal matrix.
-    ModelMatType diffs = data - arma::repmat(means.col(i), 1, data.n_cols);
-    ModelMatType rhs = -0.5 * arma::diagmat(invVar.col(i)) * diffs;
-    arma::Mat<ElemType> exponents = arma::sum(diffs % rhs, 0);
-
-    logLikelihoods.row(i) += (data.n_rows / -2.0 * log(2 * M_PI) - 0.5 *
-        arma::accu(arma::log(variances.col(i))) + exponents);
-  }
+  // Evaluate all classes for the whole block with two matrix products and a
+  // broadcast of the per-class constants (see UpdateScoringCoefs()).
+  logLikelihoods = scoringCoefs.cols(0, dims - 1) * data +
+      scoringCoefs.cols(dims, 2 * dims - 1) * (data % data);
+  logLikelihoods.each_col() += scoringCoefs.col(2 * dims);
 }
 
 template<typename ModelMatType>
@@ -356,6 +382,11 @@ void NaiveBayesClassifier<ModelMatType>::serialize(
   ar & BOOST_SERIALIZATION_NVP(means);
   ar & BOOST_SERIALIZATION_NVP(variances);
   ar & BOOST_SERIALIZATION_NVP(probabilities);
+
+  // The fused scoring coefficients are not serialized; they are recomputed on
+  // the first scoring call after loading.
+  if (Archive::is_loading::value)
+    scoringCoefsValid = false;
 }
 
 } // namespace naive_bayes
@@ -86,6 +86,14 @@ class NCA
   const OptimizerType& Optimizer() const { return optimizer; }
   OptimizerType& Optimizer() { return optimizer; }
 
+  //! Get the number of neighbors each point's softmax sums are restricted to
+  //! (0 means the exact objective is computed).
+  size_t NumNeighbors() const { return errorFunction.NumNeighbors(); }
+  //! Modify the number of neighbors each point's softmax sums are restricted
+  //! to.  Setting a nonzero value makes LearnDistance() optimize the
+  //! approximate objective, which scales near-linearly in the dataset size.
+  size_t& NumNeighbors() { return errorFunction.NumNeighbors(); }
+
  private:
   //! Dataset reference.
   const arma::mat& dataset;
@@ -17,6 +17,7 @@
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/math/make_alias.hpp>
 #include <mlpack/core/math/shuffle_data.hpp>
+#include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 
 namespace mlpack {
 namespace nca {
@@ -40,6 +41,16 @@ namespace nca {
  * optimizers use, overloads of Evaluate() and Gradient() are given which only
  * operate on one point in the dataset.  This is useful for optimizers like
  * stochastic gradient descent (see mlpack::optimization::SGD).
+ *
+ * Because every p_i sums over the entire dataset, each separable evaluation
+ * costs O(n) and a full pass costs O(n^2).  If numNeighbors is set to a
+ * nonzero value, the separable Evaluate() and Gradient() instead restrict the
+ * sums of each point to its numNeighbors nearest neighbors in the stretched
+ * space, found with a kd-tree and refreshed every updateInterval calls.
+ * Those neighbors carry the largest exp(-d) terms, so they dominate the
+ * softmax sums and the objective scales near-linearly in n at the cost of a
+ * small approximation.  The non-separable overloads always compute the exact
+ * objective.
  */
 template<typename MetricType = metric::SquaredEuclideanDistance>
 class SoftmaxErrorFunction
@@ -54,10 +65,17 @@ class SoftmaxErrorFunction
    * @param dataset Matrix containing the dataset.
    * @param labels Vector of class labels for each point in the dataset.
    * @param metric Instantiated metric (optional).
+   * @param numNeighbors Number of neighbors each point's softmax sums are
+   *        restricted to in the separable objective, or 0 to compute the
+   *        exact objective (default).
+   * @param updateInterval Number of separable calls between refreshes of the
+   *        sampled neighbor sets.
    */
   SoftmaxErrorFunction(const arma::mat& dataset,
                        const arma::Row<size_t>& labels,
-                       MetricType metric = MetricType());
+                       MetricType metric = MetricType(),
+                       const size_t numNeighbors = 0,
+                       const size_t updateInterval = 100);
 
   /**
    * Shuffle the dataset.
@@ -131,7 +149,23 @@ class SoftmaxErrorFunction
    */
   size_t NumFunctions() const { return dataset.n_cols; }
 
+  //! Get the number of neighbors sampled per point (0 means the exact
+  //! objective is computed).
+  size_t NumNeighbors() const { return numNeighbors; }
+  //! Modify the number of neighbors sampled per point.
+  size_t& NumNeighbors() { return numNeighbors; }
+
+  //! Get the number of separable calls between neighbor set refreshes.
+  size_t UpdateInterval() const { return updateInterval; }
+  //! Modify the number of separable calls between neighbor set refreshes.
+  size_t& UpdateInterval() { return updateInterval; }
+
  private:
+  //! Convenience typedef for the neighbor search used to sample neighbor
+  //! sets.
+  typedef neighbor::NeighborSearch<neighbor::NearestNeighborSort, MetricType>
+      KNN;
+
   //! The dataset.  This is an alias until Shuffle() is called.
   arma::mat dataset;
   //! Labels for each point in the dataset.  This is an alias until Shuffle() is
@@ -154,6 +188,26 @@ class SoftmaxErrorFunction
   //! False if nothing has ever been precalculated (only at construction time).
   bool precalculated;
 
+  //! Number of neighbors each point's softmax sums are restricted to in the
+  //! separable objective; 0 means the exact objective is computed.
+  size_t numNeighbors;
+  //! Number of separable calls between refreshes of the neighbor sets.
+  size_t updateInterval;
+  //! Number of separable calls since the neighbor sets were last refreshed.
+  size_t steps;
+  //! Whether the sampled neighbor sets are usable.
+  bool neighborhoodsValid;
+  //! Sampled neighbor sets; column i holds the neighbors of point i.
+  arma::Mat<size_t> neighborhoods;
+
+  /**
+   * Refresh the sampled neighbor sets with a kd-tree search over the
+   * stretched dataset, if they are due for a refresh.  The stretched dataset
+   * must be up to date.  This is only called by the separable Evaluate() and
+   * Gradient() when numNeighbors is nonzero.
+   */
+  void UpdateNeighborhoods();
+
   /**
    * Precalculate the denominators and numerators that will make up the p_ij,
    * but only if the coordinates matrix is different than the last coordinates
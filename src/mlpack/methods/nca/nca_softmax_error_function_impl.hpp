@@ -25,11 +25,17 @@ template<typename MetricType>
 SoftmaxErrorFunction<MetricType>::SoftmaxErrorFunction(
     const arma::mat& dataset,
     const arma::Row<size_t>& labels,
-    MetricType metric) :
+    MetricType metric,
+    const size_t numNeighbors,
+    const size_t updateInterval) :
     dataset(math::MakeAlias(const_cast<arma::mat&>(dataset), false)),
     labels(math::MakeAlias(const_cast<arma::Row<size_t>&>(labels), false)),
     metric(metric),
-    precalculated(false)
+    precalculated(false),
+    numNeighbors(numNeighbors),
+    updateInterval(updateInterval),
+    steps(0),
+    neighborhoodsValid(false)
 { /* nothing to do */ }
 
 //! Shuffle the dataset.
@@ -46,6 +52,28 @@ void SoftmaxErrorFunction<MetricType>::Shuffle()
 
   dataset = std::move(newDataset);
   labels = std::move(newLabels);
+
+  // The sampled neighbor sets hold indices into the old ordering.
+  neighborhoodsValid = false;
+}
+
+//! Refresh the sampled neighbor sets, if they are due for a refresh.
+template<typename MetricType>
+void SoftmaxErrorFunction<MetricType>::UpdateNeighborhoods()
+{
+  // In between refreshes the transformation cannot have moved far enough to
+  // change which points dominate the softmax sums by much.
+  if (neighborhoodsValid && (steps++ % updateInterval != 0))
+    return;
+
+  // Search for the nearest neighbors of every point in the stretched space;
+  // these carry the largest exp(-d) terms of the softmax sums.
+  KNN knn(stretchedDataset);
+  arma::mat neighborDistances;
+  knn.Search(numNeighbors, neighborhoods, neighborDistances);
+
+  steps = 1;
+  neighborhoodsValid = true;
 }
 
 //! The non-separable implementation, which uses Precalculate() to save time.
@@ -74,10 +102,21 @@ double SoftmaxErrorFunction<MetricType>::Evaluate(const arma::mat& coordinates,
 
   // It's quicker to do this now than one point at a time later.
   stretchedDataset = coordinates * dataset;
+
+  // If the approximate objective is in use, restrict the softmax sums of
+  // each point to its sampled neighbor set.
+  const bool approximate = (numNeighbors > 0 &&
+      numNeighbors + 1 < dataset.n_cols);
+  if (approximate)
+    UpdateNeighborhoods();
+
   for (size_t i = begin; i < begin + batchSize; ++i)
   {
-    for (size_t k = 0; k < dataset.n_cols; ++k)
+    const size_t terms = approximate ? numNeighbors : dataset.n_cols;
+    for (size_t t = 0; t < terms; ++t)
     {
+      const size_t k = approximate ? neighborhoods(t, i) : t;
+
       // Don't consider the case where the points are the same.
       if (k == i)
         continue;
@@ -174,6 +213,14 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
 
   // Compute the stretched dataset.
   stretchedDataset = coordinates * dataset;
+
+  // If the approximate objective is in use, restrict the softmax sums of
+  // each point to its sampled neighbor set.
+  const bool approximate = (numNeighbors > 0 &&
+      numNeighbors + 1 < dataset.n_cols);
+  if (approximate)
+    UpdateNeighborhoods();
+
   for (size_t i = begin; i < begin + batchSize; ++i)
   {
     numerator = 0;
@@ -182,8 +229,11 @@ void SoftmaxErrorFunction<MetricType>::Gradient(const arma::mat& coordinates,
     firstTerm.zeros(coordinates.n_rows, coordinates.n_cols);
     secondTerm.zeros(coordinates.n_rows, coordinates.n_cols);
 
-    for (size_t k = 0; k < dataset.n_cols; ++k)
+    const size_t terms = approximate ? numNeighbors : dataset.n_cols;
+    for (size_t t = 0; t < terms; ++t)
     {
+      const size_t k = approximate ? neighborhoods(t, i) : t;
+
       // Don't consider the case where the points are the same.
       if (i == k)
         continue;
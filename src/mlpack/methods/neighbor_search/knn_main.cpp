@@ -23,6 +23,7 @@
 #include "neighbor_search.hpp"
 #include "unmap.hpp"
 #include "ns_model.hpp"
+#include "stream_search.hpp"
 
 using namespace std;
 using namespace mlpack;
@@ -123,6 +124,22 @@ PARAM_STRING_IN("algorithm", "Type of neighbor search: 'naive', 'single_tree', "
 PARAM_DOUBLE_IN("epsilon", "If specified, will do approximate nearest neighbor "
     "search with given relative error.", "e", 0);
 
+// Streamed output: process the query set in blocks, appending each block's
+// results to the output files as it completes, so peak memory stays flat for
+// very large query sets.
+PARAM_INT_IN("stream_block_size", "If positive, process the query set in "
+    "blocks of this many points, appending each block's results to the files "
+    "given with --streamed_neighbors_file and --streamed_distances_file as "
+    "each block completes (requires --query_file).", "B", 0);
+PARAM_STRING_IN("streamed_neighbors_file", "File to append streamed neighbor "
+    "results to when --stream_block_size is positive ('.csv' and '.txt' are "
+    "written as text; anything else as headerless raw binary).  (Do not use "
+    "in Python.)", "N", "");
+PARAM_STRING_IN("streamed_distances_file", "File to append streamed distance "
+    "results to when --stream_block_size is positive ('.csv' and '.txt' are "
+    "written as text; anything else as headerless raw binary).  (Do not use "
+    "in Python.)", "F", "");
+
 static void mlpackMain()
 {
   if (IO::GetParam<int>("seed") != 0)
@@ -148,8 +165,27 @@ static void mlpackMain()
   RequireAtLeastOnePassed({ "k", "output_model" }, false,
       "no results will be saved");
 
+  // Sanity checks on streamed output options.
+  RequireParamValue<int>("stream_block_size", [](int x) { return x >= 0; },
+      true, "stream block size must be non-negative");
+  const size_t streamBlockSize = (size_t) IO::GetParam<int>("stream_block_size");
+  if (streamBlockSize > 0)
+  {
+    // Streaming processes the query set in blocks, so a separate query set is
+    // required (all-kNN with self-neighbor exclusion cannot be streamed).
+    RequireAtLeastOnePassed({ "query" }, true,
+        "streamed output requires a separate query set");
+    RequireAtLeastOnePassed({ "streamed_neighbors_file",
+        "streamed_distances_file" }, false,
+        "streamed search results will not be saved");
+  }
+  ReportIgnoredParam({{ "stream_block_size", false }},
+      "streamed_neighbors_file");
+  ReportIgnoredParam({{ "stream_block_size", false }},
+      "streamed_distances_file");
+
   // If the user specifies k but no output files, they should be warned.
-  if (IO::HasParam("k"))
+  if (IO::HasParam("k") && streamBlockSize == 0)
   {
     RequireAtLeastOnePassed({ "neighbors", "distances" }, false,
         "nearest neighbor search results will not be saved");
@@ -334,6 +370,25 @@ static void mlpackMain()
           << "not been provided." << endl;
     }
 
+    // If streamed output was requested, process the query set in blocks and
+    // append each block's results to the output files as it completes,
+    // instead of buffering the full result matrices.
+    if (streamBlockSize > 0)
+    {
+      ReportIgnoredParam({{ "stream_block_size", true }}, "true_distances");
+      ReportIgnoredParam({{ "stream_block_size", true }}, "true_neighbors");
+      ReportIgnoredParam({{ "stream_block_size", true }}, "neighbors");
+      ReportIgnoredParam({{ "stream_block_size", true }}, "distances");
+
+      StreamSearch(*knn, std::move(queryData), k, streamBlockSize,
+          IO::GetParam<string>("streamed_neighbors_file"),
+          IO::GetParam<string>("streamed_distances_file"));
+      Log::Info << "Search complete." << endl;
+
+      IO::GetParam<KNNModel*>("output_model") = knn;
+      return;
+    }
+
     // Now run the search.
     arma::Mat<size_t> neighbors;
     arma::mat distances;
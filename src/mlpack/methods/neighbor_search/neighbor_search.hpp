@@ -19,8 +19,11 @@
 
 #include <mlpack/core/tree/binary_space_tree.hpp>
 #include <mlpack/core/tree/rectangle_tree.hpp>
+#include <future>
 #include <mlpack/core/tree/binary_space_tree/binary_space_tree.hpp>
 
+#include <mlpack/core/metrics/pairwise_distances.hpp>
+
 #include "neighbor_search_stat.hpp"
 #include "sort_policies/nearest_neighbor_sort.hpp"
 #include "neighbor_search_rules.hpp"
@@ -254,6 +257,30 @@ class NeighborSearch
               arma::mat& distances,
               bool sameSet = false);
 
+  /**
+   * Asynchronously compute the nearest neighbors of the given query block,
+   * returning a future that yields the (neighbors, distances) matrix pair.
+   * The reference tree is only read during bichromatic dual-tree search, so
+   * any number of outstanding SearchAsync() calls may run concurrently
+   * against the same NeighborSearch object, letting a serving tier submit a
+   * queue of small query blocks without serializing behind one Search()
+   * call.  Each call builds its own query tree and traversal state.
+   *
+   * The search always uses dual-tree traversal (the search mode and epsilon
+   * of this object are honored for pruning), and results are mapped back to
+   * original query and reference indices just like Search().  Do not call
+   * Train() or the mutating Search() overloads while asynchronous searches
+   * are outstanding.
+   *
+   * @param querySet Set of query points (taken by value so the block can
+   *     outlive the caller).
+   * @param k Number of neighbors to search for.
+   * @return Future yielding the pair (neighbors, distances).
+   */
+  std::future<std::pair<arma::Mat<size_t>, arma::mat>> SearchAsync(
+      MatType querySet,
+      const size_t k);
+
   /**
    * Search for the nearest neighbors of every point in the reference set.  This
    * is basically equivalent to calling any other overload of Search() with the
@@ -321,6 +348,23 @@ class NeighborSearch
   //! Modify the relative error to be considered in approximate search.
   double& Epsilon() { return epsilon; }
 
+  //! Access the per-query search time budget, in microseconds (0 means no
+  //! budget).
+  size_t SearchTimeBudget() const { return searchTimeBudget; }
+  //! Modify the per-query search time budget, in microseconds.  When nonzero
+  //! and the search mode is GREEDY_SINGLE_TREE_MODE, each query first runs a
+  //! greedy descent for instant candidates and then refines the pruned
+  //! branches in best-first order until the budget expires, so the results
+  //! are at least as good as pure greedy search and become exact if the
+  //! budget allows the refinement to finish.
+  size_t& SearchTimeBudget() { return searchTimeBudget; }
+
+  //! Get the per-query error bounds from the last time-budgeted search.  For
+  //! query i, no unexamined reference node can have a better score than
+  //! errorBounds[i]; the value is DBL_MAX if the search for that query ran to
+  //! completion (i.e. the result is exact).
+  const arma::vec& ErrorBounds() const { return errorBounds; }
+
   //! Access the reference dataset.
   const MatType& ReferenceSet() const { return *referenceSet; }
 
@@ -345,6 +389,10 @@ class NeighborSearch
   NeighborSearchMode searchMode;
   //! Indicates the relative error to be considered in approximate search.
   double epsilon;
+  //! Per-query search time budget in microseconds (0 means no budget).
+  size_t searchTimeBudget;
+  //! Per-query error bounds from the last time-budgeted search.
+  arma::vec errorBounds;
 
   //! Instantiation of metric.
   MetricType metric;
@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/tree/greedy_single_tree_traverser.hpp>
+#include <mlpack/core/tree/time_bounded_single_tree_traverser.hpp>
 #include "neighbor_search_rules.hpp"
 #include <mlpack/core/tree/spill_tree/is_spill_tree.hpp>
 
@@ -65,6 +66,7 @@ SingleTreeTraversalType>::NeighborSearch(MatType referenceSetIn,
         &referenceTree->Dataset()),
     searchMode(mode),
     epsilon(epsilon),
+    searchTimeBudget(0),
     metric(metric),
     baseCases(0),
     scores(0),
@@ -92,6 +94,7 @@ SingleTreeTraversalType>::NeighborSearch(Tree referenceTree,
     referenceSet(&this->referenceTree->Dataset()),
     searchMode(mode),
     epsilon(epsilon),
+    searchTimeBudget(0),
     metric(metric),
     baseCases(0),
     scores(0),
@@ -118,6 +121,7 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearchMode mode,
     referenceSet(mode == NAIVE_MODE ? new MatType() : NULL), // Empty matrix.
     searchMode(mode),
     epsilon(epsilon),
+    searchTimeBudget(0),
     metric(metric),
     baseCases(0),
     scores(0),
@@ -152,6 +156,8 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearch& other) :
         new MatType(*other.referenceSet)),
     searchMode(other.searchMode),
     epsilon(other.epsilon),
+    searchTimeBudget(other.searchTimeBudget),
+    errorBounds(other.errorBounds),
     metric(other.metric),
     baseCases(other.baseCases),
     scores(other.scores),
@@ -176,6 +182,8 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
     referenceSet(other.referenceSet),
     searchMode(other.searchMode),
     epsilon(other.epsilon),
+    searchTimeBudget(other.searchTimeBudget),
+    errorBounds(std::move(other.errorBounds)),
     metric(std::move(other.metric)),
     baseCases(other.baseCases),
     scores(other.scores),
@@ -187,6 +195,7 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
   other.epsilon = 0.0;
+  other.searchTimeBudget = 0;
   other.baseCases = 0;
   other.scores = 0;
   other.treeNeedsReset = false;
@@ -229,6 +238,8 @@ NeighborSearch<SortPolicy,
       new MatType(*other.referenceSet);
   searchMode = other.searchMode;
   epsilon = other.epsilon;
+  searchTimeBudget = other.searchTimeBudget;
+  errorBounds = other.errorBounds;
   metric = other.metric;
   baseCases = other.baseCases;
   scores = other.scores;
@@ -271,6 +282,8 @@ NeighborSearch<SortPolicy,
   referenceSet = other.referenceSet;
   searchMode = other.searchMode;
   epsilon = other.epsilon;
+  searchTimeBudget = other.searchTimeBudget;
+  errorBounds = std::move(other.errorBounds);
   metric = other.metric;
   baseCases = other.baseCases;
   scores = other.scores;
@@ -285,6 +298,7 @@ NeighborSearch<SortPolicy,
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
   other.epsilon = 0.0;
+  other.searchTimeBudget = 0;
   other.baseCases = 0;
   other.scores = 0;
   other.treeNeedsReset = false;
@@ -440,10 +454,30 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       // Create the helper object for the tree traversal.
       RuleType rules(*referenceSet, querySet, k, metric, epsilon);
 
-      // The naive brute-force traversal.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        for (size_t j = 0; j < referenceSet->n_cols; ++j)
-          rules.BaseCase(i, j);
+      // The naive brute-force traversal.  The query set is processed in
+      // blocks of columns, so that all query-reference distances of a block
+      // can be computed at once with PairwiseDistances() -- a single matrix
+      // multiplication for the L2 metrics -- while the block of distances
+      // stays a few megabytes at most.
+      const size_t blockSize = std::max<size_t>(1,
+          (1 << 20) / referenceSet->n_cols);
+      arma::mat blockDistances;
+      for (size_t begin = 0; begin < querySet.n_cols; begin += blockSize)
+      {
+        const size_t end = std::min(begin + blockSize,
+            (size_t) querySet.n_cols);
+
+        // Materializing the block keeps the batch kernel applicable to
+        // sparse datasets, whose subviews do not support all of its
+        // operations.
+        const MatType blockQueries(querySet.cols(begin, end - 1));
+        metric::PairwiseDistances(*referenceSet, blockQueries, blockDistances,
+            metric);
+
+        for (size_t i = 0; i < blockDistances.n_cols; ++i)
+          for (size_t j = 0; j < referenceSet->n_cols; ++j)
+            rules.BaseCase(begin + i, j, blockDistances(j, i));
+      }
 
       baseCases += querySet.n_cols * referenceSet->n_cols;
 
@@ -464,6 +498,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
+      Counter::Increment("neighbor_search/scores", rules.Scores());
+      Counter::Increment("neighbor_search/base_cases", rules.BaseCases());
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
@@ -482,6 +518,97 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       Timer::Stop("tree_building");
       Timer::Start("computing_neighbors");
 
+      #ifdef _OPENMP
+      // If more than one thread is available, split the query tree into
+      // independent subtrees and traverse them on an OpenMP team.  Each
+      // thread keeps its own rules object (and thus its own candidate sets);
+      // because every query point belongs to exactly one subtree, the
+      // per-thread results are merged with an elementwise minimum.
+      std::vector<Tree*> querySubtrees;
+      querySubtrees.push_back(queryTree);
+      if (omp_get_max_threads() > 1)
+      {
+        // Expand the frontier level by level until there are enough subtrees
+        // to keep the team busy with dynamic scheduling.
+        const size_t targetSubtrees = 8 * omp_get_max_threads();
+        bool expanded = true;
+        while (querySubtrees.size() < targetSubtrees && expanded)
+        {
+          expanded = false;
+          std::vector<Tree*> nextFrontier;
+          for (size_t i = 0; i < querySubtrees.size(); ++i)
+          {
+            if (querySubtrees[i]->NumChildren() > 0)
+            {
+              for (size_t c = 0; c < querySubtrees[i]->NumChildren(); ++c)
+                nextFrontier.push_back(&querySubtrees[i]->Child(c));
+              expanded = true;
+            }
+            else
+            {
+              nextFrontier.push_back(querySubtrees[i]);
+            }
+          }
+          querySubtrees = std::move(nextFrontier);
+        }
+      }
+
+      if (querySubtrees.size() > 1)
+      {
+        const size_t numThreads = (size_t) omp_get_max_threads();
+        std::vector<arma::Mat<size_t>> threadNeighbors(numThreads);
+        std::vector<arma::mat> threadDistances(numThreads);
+
+        #pragma omp parallel
+        {
+          const size_t threadId = (size_t) omp_get_thread_num();
+
+          RuleType threadRules(*referenceSet, queryTree->Dataset(), k, metric,
+              epsilon);
+          DualTreeTraversalType<RuleType> threadTraverser(threadRules);
+
+          #pragma omp for schedule(dynamic)
+          for (omp_size_t i = 0; i < (omp_size_t) querySubtrees.size(); ++i)
+            threadTraverser.Traverse(*querySubtrees[i], *referenceTree);
+
+          threadRules.GetResults(threadNeighbors[threadId],
+              threadDistances[threadId]);
+
+          #pragma omp atomic
+          scores += threadRules.Scores();
+          #pragma omp atomic
+          baseCases += threadRules.BaseCases();
+        }
+
+        // Merge: a query point was handled by exactly one thread; every other
+        // thread holds the worst-distance sentinel for it, so an elementwise
+        // minimum selects the right thread's candidates.
+        *neighborPtr = threadNeighbors[0];
+        *distancePtr = threadDistances[0];
+        for (size_t t = 1; t < numThreads; ++t)
+        {
+          if (threadDistances[t].n_elem != distancePtr->n_elem)
+            continue; // This thread ran no subtree tasks.
+
+          for (size_t col = 0; col < distancePtr->n_cols; ++col)
+          {
+            if (SortPolicy::IsBetter(threadDistances[t](0, col),
+                (*distancePtr)(0, col)))
+            {
+              distancePtr->col(col) = threadDistances[t].col(col);
+              neighborPtr->col(col) = threadNeighbors[t].col(col);
+            }
+          }
+        }
+
+        Log::Info << scores << " node combinations were scored." << std::endl;
+        Log::Info << baseCases << " base cases were calculated." << std::endl;
+
+        delete queryTree;
+        break;
+      }
+      #endif
+
       // Create the helper object for the tree traversal.
       RuleType rules(*referenceSet, queryTree->Dataset(), k, metric, epsilon);
 
@@ -492,6 +619,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
+      Counter::Increment("neighbor_search/scores", rules.Scores());
+      Counter::Increment("neighbor_search/base_cases", rules.BaseCases());
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
@@ -505,6 +634,36 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     }
     case GREEDY_SINGLE_TREE_MODE:
     {
+      if (searchTimeBudget > 0)
+      {
+        // Time-budgeted search: greedy descent for instant candidates, then
+        // best-first refinement of the pruned branches until the per-query
+        // deadline expires.
+        RuleType rules(*referenceSet, querySet, k, metric, epsilon);
+        tree::TimeBoundedSingleTreeTraverser<Tree, RuleType> traverser(rules,
+            searchTimeBudget);
+
+        errorBounds.set_size(querySet.n_cols);
+        for (size_t i = 0; i < querySet.n_cols; ++i)
+        {
+          traverser.Traverse(i, *referenceTree);
+          errorBounds[i] = traverser.ErrorBound();
+        }
+
+        scores += rules.Scores();
+        baseCases += rules.BaseCases();
+        Counter::Increment("neighbor_search/scores", rules.Scores());
+        Counter::Increment("neighbor_search/base_cases", rules.BaseCases());
+
+        Log::Info << rules.Scores() << " node combinations were scored."
+            << std::endl;
+        Log::Info << rules.BaseCases() << " base cases were calculated."
+            << std::endl;
+
+        rules.GetResults(*neighborPtr, *distancePtr);
+        break;
+      }
+
       // Create the helper object for the tree traversal.
       RuleType rules(*referenceSet, querySet, k, metric);
 
@@ -517,6 +676,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
+      Counter::Increment("neighbor_search/scores", rules.Scores());
+      Counter::Increment("neighbor_search/base_cases", rules.BaseCases());
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
@@ -590,6 +751,98 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   }
 } // Search()
 
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+std::future<std::pair<arma::Mat<size_t>, arma::mat>>
+NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::SearchAsync(
+    MatType querySet,
+    const size_t k)
+{
+  if (k > referenceSet->n_cols)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << referenceSet->n_cols << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  // The task only reads the reference tree and reference set, so concurrent
+  // tasks can share them; all mutable search state is local to the task.
+  return std::async(std::launch::async,
+      [this, k](MatType&& query) -> std::pair<arma::Mat<size_t>, arma::mat>
+      {
+        typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
+
+        std::pair<arma::Mat<size_t>, arma::mat> results;
+        arma::Mat<size_t>& neighbors = results.first;
+        arma::mat& distances = results.second;
+
+        // Build a query tree for this block.
+        std::vector<size_t> oldFromNewQueries;
+        Tree* queryTree = BuildTree<Tree>(query, oldFromNewQueries);
+
+        arma::Mat<size_t> unmappedNeighbors;
+        arma::mat unmappedDistances;
+
+        RuleType rules(*referenceSet, queryTree->Dataset(), k, metric,
+            epsilon);
+        DualTreeTraversalType<RuleType> traverser(rules);
+        traverser.Traverse(*queryTree, *referenceTree);
+        rules.GetResults(unmappedNeighbors, unmappedDistances);
+
+        delete queryTree;
+
+        // Map the results back to original query and reference indices, the
+        // same way Search() does.
+        if (tree::TreeTraits<Tree>::RearrangesDataset)
+        {
+          neighbors.set_size(k, query.n_cols);
+          distances.set_size(k, query.n_cols);
+
+          for (size_t i = 0; i < distances.n_cols; ++i)
+          {
+            const size_t queryMapping = oldFromNewQueries[i];
+            distances.col(queryMapping) = unmappedDistances.col(i);
+
+            if (!oldFromNewReferences.empty())
+            {
+              for (size_t j = 0; j < distances.n_rows; ++j)
+              {
+                neighbors(j, queryMapping) =
+                    oldFromNewReferences[unmappedNeighbors(j, i)];
+              }
+            }
+            else
+            {
+              neighbors.col(queryMapping) = unmappedNeighbors.col(i);
+            }
+          }
+        }
+        else if (!oldFromNewReferences.empty())
+        {
+          distances = std::move(unmappedDistances);
+          neighbors.set_size(k, query.n_cols);
+          for (size_t i = 0; i < neighbors.n_cols; ++i)
+            for (size_t j = 0; j < neighbors.n_rows; ++j)
+              neighbors(j, i) = oldFromNewReferences[unmappedNeighbors(j, i)];
+        }
+        else
+        {
+          neighbors = std::move(unmappedNeighbors);
+          distances = std::move(unmappedDistances);
+        }
+
+        return results;
+      }, std::move(querySet));
+}
+
 template<typename SortPolicy,
          typename MetricType,
          typename MatType,
@@ -734,10 +987,30 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
   {
     case NAIVE_MODE:
     {
-      // The naive brute-force solution.
-      for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        for (size_t j = 0; j < referenceSet->n_cols; ++j)
-          rules.BaseCase(i, j);
+      // The naive brute-force solution, with the monochromatic query set
+      // processed in blocks of columns; all query-reference distances of a
+      // block are computed at once with PairwiseDistances() -- a single
+      // matrix multiplication for the L2 metrics -- while the block of
+      // distances stays a few megabytes at most.
+      const size_t blockSize = std::max<size_t>(1,
+          (1 << 20) / referenceSet->n_cols);
+      arma::mat blockDistances;
+      for (size_t begin = 0; begin < referenceSet->n_cols; begin += blockSize)
+      {
+        const size_t end = std::min(begin + blockSize,
+            (size_t) referenceSet->n_cols);
+
+        // Materializing the block keeps the batch kernel applicable to
+        // sparse datasets, whose subviews do not support all of its
+        // operations.
+        const MatType blockQueries(referenceSet->cols(begin, end - 1));
+        metric::PairwiseDistances(*referenceSet, blockQueries, blockDistances,
+            metric);
+
+        for (size_t i = 0; i < blockDistances.n_cols; ++i)
+          for (size_t j = 0; j < referenceSet->n_cols; ++j)
+            rules.BaseCase(begin + i, j, blockDistances(j, i));
+      }
 
       baseCases += referenceSet->n_cols * referenceSet->n_cols;
       break;
@@ -753,6 +1026,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
+      Counter::Increment("neighbor_search/scores", rules.Scores());
+      Counter::Increment("neighbor_search/base_cases", rules.BaseCases());
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
@@ -801,6 +1076,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
+      Counter::Increment("neighbor_search/scores", rules.Scores());
+      Counter::Increment("neighbor_search/base_cases", rules.BaseCases());
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
@@ -813,6 +1090,33 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     }
     case GREEDY_SINGLE_TREE_MODE:
     {
+      if (searchTimeBudget > 0)
+      {
+        // Time-budgeted search: greedy descent for instant candidates, then
+        // best-first refinement of the pruned branches until the per-query
+        // deadline expires.
+        tree::TimeBoundedSingleTreeTraverser<Tree, RuleType> traverser(rules,
+            searchTimeBudget);
+
+        errorBounds.set_size(referenceSet->n_cols);
+        for (size_t i = 0; i < referenceSet->n_cols; ++i)
+        {
+          traverser.Traverse(i, *referenceTree);
+          errorBounds[i] = traverser.ErrorBound();
+        }
+
+        scores += rules.Scores();
+        baseCases += rules.BaseCases();
+        Counter::Increment("neighbor_search/scores", rules.Scores());
+        Counter::Increment("neighbor_search/base_cases", rules.BaseCases());
+
+        Log::Info << rules.Scores() << " node combinations were scored."
+            << std::endl;
+        Log::Info << rules.BaseCases() << " base cases were calculated."
+            << std::endl;
+        break;
+      }
+
       // Create the traverser.
       tree::GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
 
@@ -822,6 +1126,8 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
 
       scores += rules.Scores();
       baseCases += rules.BaseCases();
+      Counter::Increment("neighbor_search/scores", rules.Scores());
+      Counter::Increment("neighbor_search/base_cases", rules.BaseCases());
 
       Log::Info << rules.Scores() << " node combinations were scored."
           << std::endl;
@@ -0,0 +1,30 @@
+/**
+ * @file methods/neighbor_search/neighbor_search_instantiations.cpp
+ * @author Ryan Curtin
+ *
+ * Explicit instantiations of NeighborSearch for the most common
+ * configurations.  These are compiled once into the mlpack library, and
+ * matching extern template declarations in typedef.hpp keep downstream
+ * translation units from re-instantiating (and re-compiling) the same code.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+// k-nearest and k-furthest neighbor search with the L2 metric on dense data,
+// using kd-trees (the KNN and KFN typedefs) and ball trees.
+template class NeighborSearch<NearestNeighborSort, metric::EuclideanDistance>;
+template class NeighborSearch<FurthestNeighborSort, metric::EuclideanDistance>;
+template class NeighborSearch<NearestNeighborSort, metric::EuclideanDistance,
+    arma::mat, tree::BallTree>;
+template class NeighborSearch<FurthestNeighborSort, metric::EuclideanDistance,
+    arma::mat, tree::BallTree>;
+
+} // namespace neighbor
+} // namespace mlpack
@@ -73,6 +73,20 @@ class NeighborSearchRules
    */
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Process a base case whose distance has already been computed, for
+   * instance by a batch pairwise distance kernel.  This will update the list
+   * of candidates with the new point if appropriate, without evaluating the
+   * metric again.
+   *
+   * @param queryIndex Index of query point.
+   * @param referenceIndex Index of reference point.
+   * @param distance Precomputed distance between the two points.
+   */
+  void BaseCase(const size_t queryIndex,
+                const size_t referenceIndex,
+                const double distance);
+
   /**
    * Get the score for recursion order.  A low score indicates priority for
    * recursion, while DBL_MAX indicates that the node should not be recursed
@@ -107,6 +107,21 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   return distance;
 }
 
+template<typename SortPolicy, typename MetricType, typename TreeType>
+inline force_inline // Absolutely MUST be inline so optimizations can happen.
+void NeighborSearchRules<SortPolicy, MetricType, TreeType>::
+BaseCase(const size_t queryIndex,
+         const size_t referenceIndex,
+         const double distance)
+{
+  // If the datasets are the same, then this search is only using one dataset
+  // and we should not return identical points.
+  if (sameSet && (queryIndex == referenceIndex))
+    return;
+
+  InsertNeighbor(queryIndex, referenceIndex, distance);
+}
+
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
     const size_t queryIndex,
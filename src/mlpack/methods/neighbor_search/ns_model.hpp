@@ -234,6 +234,105 @@ class DeleteVisitor : public boost::static_visitor<void>
   void operator()(NSType *ns) const;
 };
 
+/**
+ * InsertPointVisitor inserts a point into the reference index of the given
+ * NSType in place.  Only the rectangle tree variants support dynamic
+ * insertion; for all other tree types an exception is thrown and the model
+ * must be rebuilt instead.
+ */
+template<typename SortPolicy>
+class InsertPointVisitor : public boost::static_visitor<void>
+{
+ private:
+  //! The point to insert.
+  const arma::vec& point;
+
+  //! Append the point to the tree's dataset and insert it into the tree.
+  template<typename NSType>
+  void InsertInto(NSType* ns) const;
+
+ public:
+  //! Alias template necessary for visual c++ compiler.
+  template<template<typename TreeMetricType,
+                    typename TreeStatType,
+                    typename TreeMatType> class TreeType>
+  using NSTypeT = NSType<SortPolicy, TreeType>;
+
+  //! Tree types without dynamic insertion support cannot be updated in place.
+  template<template<typename TreeMetricType,
+                    typename TreeStatType,
+                    typename TreeMatType> class TreeType>
+  void operator()(NSTypeT<TreeType>* ns) const;
+
+  //! Insert into an R tree index.
+  void operator()(NSTypeT<tree::RTree>* ns) const;
+  //! Insert into an R* tree index.
+  void operator()(NSTypeT<tree::RStarTree>* ns) const;
+  //! Insert into an X tree index.
+  void operator()(NSTypeT<tree::XTree>* ns) const;
+  //! Insert into a Hilbert R tree index.
+  void operator()(NSTypeT<tree::HilbertRTree>* ns) const;
+  //! Insert into an R+ tree index.
+  void operator()(NSTypeT<tree::RPlusTree>* ns) const;
+  //! Insert into an R++ tree index.
+  void operator()(NSTypeT<tree::RPlusPlusTree>* ns) const;
+  //! Spill trees do not support dynamic insertion.
+  void operator()(SpillKNN* ns) const;
+
+  //! Construct the InsertPointVisitor with the given point.
+  InsertPointVisitor(const arma::vec& point) : point(point) {}
+};
+
+/**
+ * DeletePointVisitor removes the point with the given dataset index from the
+ * reference index of the given NSType in place.  Only the rectangle tree
+ * variants support dynamic deletion; for all other tree types an exception is
+ * thrown.  The deleted point's column remains in the reference set (so
+ * existing indices stay valid), but it will never be returned as a neighbor.
+ */
+template<typename SortPolicy>
+class DeletePointVisitor : public boost::static_visitor<void>
+{
+ private:
+  //! Index of the point to delete.
+  const size_t index;
+
+  //! Delete the point from the tree.
+  template<typename NSType>
+  void DeleteFrom(NSType* ns) const;
+
+ public:
+  //! Alias template necessary for visual c++ compiler.
+  template<template<typename TreeMetricType,
+                    typename TreeStatType,
+                    typename TreeMatType> class TreeType>
+  using NSTypeT = NSType<SortPolicy, TreeType>;
+
+  //! Tree types without dynamic deletion support cannot be updated in place.
+  template<template<typename TreeMetricType,
+                    typename TreeStatType,
+                    typename TreeMatType> class TreeType>
+  void operator()(NSTypeT<TreeType>* ns) const;
+
+  //! Delete from an R tree index.
+  void operator()(NSTypeT<tree::RTree>* ns) const;
+  //! Delete from an R* tree index.
+  void operator()(NSTypeT<tree::RStarTree>* ns) const;
+  //! Delete from an X tree index.
+  void operator()(NSTypeT<tree::XTree>* ns) const;
+  //! Delete from a Hilbert R tree index.
+  void operator()(NSTypeT<tree::HilbertRTree>* ns) const;
+  //! Delete from an R+ tree index.
+  void operator()(NSTypeT<tree::RPlusTree>* ns) const;
+  //! Delete from an R++ tree index.
+  void operator()(NSTypeT<tree::RPlusPlusTree>* ns) const;
+  //! Spill trees do not support dynamic deletion.
+  void operator()(SpillKNN* ns) const;
+
+  //! Construct the DeletePointVisitor with the given point index.
+  DeletePointVisitor(const size_t index) : index(index) {}
+};
+
 /**
  * The NSModel class provides an easy way to serialize a model, abstracts away
  * the different types of trees, and also reflects the NeighborSearch API.  This
@@ -400,6 +499,30 @@ class NSModel
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
 
+  /**
+   * Incrementally insert the given point into the reference index, without
+   * rebuilding the tree.  This is only supported for the rectangle tree
+   * variants (R tree, R* tree, X tree, Hilbert R tree, R+ tree, R++ tree),
+   * which support dynamic insertion; a std::invalid_argument exception is
+   * thrown for other tree types.  If a random basis is in use, the point is
+   * projected into that basis before insertion.
+   *
+   * @param point Point to insert.
+   */
+  void InsertPoint(const arma::vec& point);
+
+  /**
+   * Incrementally delete the point with the given index from the reference
+   * index, without rebuilding the tree.  This is only supported for the
+   * rectangle tree variants; a std::invalid_argument exception is thrown for
+   * other tree types.  The point's column remains in the reference set so
+   * that neighbor indices are unchanged, but the point will never again be
+   * returned as a neighbor.
+   *
+   * @param index Index of the point to delete in the reference set.
+   */
+  void DeletePoint(const size_t index);
+
   //! Return a string representation of the current tree type.
   std::string TreeName() const;
 };
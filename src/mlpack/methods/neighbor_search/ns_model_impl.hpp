@@ -252,6 +252,168 @@ const arma::mat& ReferenceSetVisitor::operator()(NSType* ns) const
   throw std::runtime_error("no neighbor search model initialized");
 }
 
+//! Insert a point into a tree type with dynamic insertion support.
+template<typename SortPolicy>
+template<typename NSType>
+void InsertPointVisitor<SortPolicy>::InsertInto(NSType* ns) const
+{
+  if (!ns)
+    throw std::runtime_error("no neighbor search model initialized");
+
+  typename NSType::Tree& tree = ns->ReferenceTree();
+  if (point.n_elem != tree.Dataset().n_rows)
+  {
+    std::ostringstream oss;
+    oss << "NSModel::InsertPoint(): point has dimensionality "
+        << point.n_elem << ", but the reference set has dimensionality "
+        << tree.Dataset().n_rows << "!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  // Append the point to the tree's dataset, then insert it by index.
+  tree.Dataset().insert_cols(tree.Dataset().n_cols, point);
+  tree.InsertPoint(tree.Dataset().n_cols - 1);
+}
+
+template<typename SortPolicy>
+template<template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void InsertPointVisitor<SortPolicy>::operator()(NSTypeT<TreeType>* /* ns */)
+    const
+{
+  throw std::invalid_argument("NSModel::InsertPoint(): dynamic insertion is "
+      "only supported for rectangle tree variants (R tree, R* tree, X tree, "
+      "Hilbert R tree, R+ tree, R++ tree); rebuild the model instead.");
+}
+
+template<typename SortPolicy>
+void InsertPointVisitor<SortPolicy>::operator()(NSTypeT<tree::RTree>* ns) const
+{
+  InsertInto(ns);
+}
+
+template<typename SortPolicy>
+void InsertPointVisitor<SortPolicy>::operator()(
+    NSTypeT<tree::RStarTree>* ns) const
+{
+  InsertInto(ns);
+}
+
+template<typename SortPolicy>
+void InsertPointVisitor<SortPolicy>::operator()(NSTypeT<tree::XTree>* ns) const
+{
+  InsertInto(ns);
+}
+
+template<typename SortPolicy>
+void InsertPointVisitor<SortPolicy>::operator()(
+    NSTypeT<tree::HilbertRTree>* ns) const
+{
+  InsertInto(ns);
+}
+
+template<typename SortPolicy>
+void InsertPointVisitor<SortPolicy>::operator()(
+    NSTypeT<tree::RPlusTree>* ns) const
+{
+  InsertInto(ns);
+}
+
+template<typename SortPolicy>
+void InsertPointVisitor<SortPolicy>::operator()(
+    NSTypeT<tree::RPlusPlusTree>* ns) const
+{
+  InsertInto(ns);
+}
+
+template<typename SortPolicy>
+void InsertPointVisitor<SortPolicy>::operator()(SpillKNN* /* ns */) const
+{
+  throw std::invalid_argument("NSModel::InsertPoint(): dynamic insertion is "
+      "not supported for spill trees; rebuild the model instead.");
+}
+
+//! Delete a point from a tree type with dynamic deletion support.
+template<typename SortPolicy>
+template<typename NSType>
+void DeletePointVisitor<SortPolicy>::DeleteFrom(NSType* ns) const
+{
+  if (!ns)
+    throw std::runtime_error("no neighbor search model initialized");
+
+  typename NSType::Tree& tree = ns->ReferenceTree();
+  if (index >= tree.Dataset().n_cols)
+  {
+    std::ostringstream oss;
+    oss << "NSModel::DeletePoint(): point index " << index << " is out of "
+        << "bounds for a reference set with " << tree.Dataset().n_cols
+        << " points!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  tree.DeletePoint(index);
+}
+
+template<typename SortPolicy>
+template<template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void DeletePointVisitor<SortPolicy>::operator()(NSTypeT<TreeType>* /* ns */)
+    const
+{
+  throw std::invalid_argument("NSModel::DeletePoint(): dynamic deletion is "
+      "only supported for rectangle tree variants (R tree, R* tree, X tree, "
+      "Hilbert R tree, R+ tree, R++ tree); rebuild the model instead.");
+}
+
+template<typename SortPolicy>
+void DeletePointVisitor<SortPolicy>::operator()(NSTypeT<tree::RTree>* ns) const
+{
+  DeleteFrom(ns);
+}
+
+template<typename SortPolicy>
+void DeletePointVisitor<SortPolicy>::operator()(
+    NSTypeT<tree::RStarTree>* ns) const
+{
+  DeleteFrom(ns);
+}
+
+template<typename SortPolicy>
+void DeletePointVisitor<SortPolicy>::operator()(NSTypeT<tree::XTree>* ns) const
+{
+  DeleteFrom(ns);
+}
+
+template<typename SortPolicy>
+void DeletePointVisitor<SortPolicy>::operator()(
+    NSTypeT<tree::HilbertRTree>* ns) const
+{
+  DeleteFrom(ns);
+}
+
+template<typename SortPolicy>
+void DeletePointVisitor<SortPolicy>::operator()(
+    NSTypeT<tree::RPlusTree>* ns) const
+{
+  DeleteFrom(ns);
+}
+
+template<typename SortPolicy>
+void DeletePointVisitor<SortPolicy>::operator()(
+    NSTypeT<tree::RPlusPlusTree>* ns) const
+{
+  DeleteFrom(ns);
+}
+
+template<typename SortPolicy>
+void DeletePointVisitor<SortPolicy>::operator()(SpillKNN* /* ns */) const
+{
+  throw std::invalid_argument("NSModel::DeletePoint(): dynamic deletion is "
+      "not supported for spill trees; rebuild the model instead.");
+}
+
 //! Clean memory, if necessary.
 template<typename NSType>
 void DeleteVisitor::operator()(NSType* ns) const
@@ -594,6 +756,29 @@ void NSModel<SortPolicy>::Search(const size_t k,
   boost::apply_visitor(search, nSearch);
 }
 
+//! Incrementally insert a point into the reference index.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::InsertPoint(const arma::vec& point)
+{
+  if (randomBasis)
+  {
+    // Project the point into the same random basis as the reference set.
+    const arma::vec projected = q * point;
+    boost::apply_visitor(InsertPointVisitor<SortPolicy>(projected), nSearch);
+  }
+  else
+  {
+    boost::apply_visitor(InsertPointVisitor<SortPolicy>(point), nSearch);
+  }
+}
+
+//! Incrementally delete a point from the reference index.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::DeletePoint(const size_t index)
+{
+  boost::apply_visitor(DeletePointVisitor<SortPolicy>(index), nSearch);
+}
+
 //! Get the name of the tree type.
 template<typename SortPolicy>
 std::string NSModel<SortPolicy>::TreeName() const
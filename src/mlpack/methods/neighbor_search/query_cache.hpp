@@ -0,0 +1,154 @@
+/**
+ * @file methods/neighbor_search/query_cache.hpp
+ * @author Ryan Curtin
+ *
+ * Defines the QueryCache class, an optional sharded result cache that can be
+ * layered over NeighborSearch::Search() for repeat-heavy serving workloads.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_QUERY_CACHE_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_QUERY_CACHE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The QueryCache class wraps a neighbor search object and caches its results,
+ * keyed on the query coordinates quantized to a configurable tolerance.  Two
+ * queries that fall into the same quantization cell are served the same
+ * result, so the tolerance must be chosen small enough that this is acceptable
+ * for the application.
+ *
+ * The cache is split into shards selected by a hash of the quantized
+ * coordinates.  A batched Search() runs in three phases: all lookups first
+ * (read-only, distributed over threads), then a single tree search over the
+ * missed queries, then insertion of the new results (each shard is written by
+ * exactly one thread).  No locks are taken in any phase.  Eviction within a
+ * shard is least-recently-used at batch granularity.
+ *
+ * Note that results served from the cache come from a previous search; if the
+ * underlying reference set is retrained, call Clear().
+ *
+ * An example of how to use this class:
+ *
+ * @code
+ * arma::mat referenceSet, querySet;
+ *
+ * KNN knn(referenceSet);
+ * QueryCache<KNN> cache(knn, 1e-3);
+ *
+ * arma::Mat<size_t> neighbors;
+ * arma::mat distances;
+ *
+ * // Repeated calls with recurring queries are served from the cache.
+ * cache.Search(querySet, 3, neighbors, distances);
+ * @endcode
+ *
+ * @tparam SearchType The neighbor search type to wrap (e.g. KNN or KFN).
+ * @tparam MatType The type of data matrix.
+ */
+template<typename SearchType, typename MatType = arma::mat>
+class QueryCache
+{
+ public:
+  /**
+   * Construct a query cache on top of the given search object.  The search
+   * object must outlive the cache.
+   *
+   * @param search Search object used to answer cache misses.
+   * @param tolerance Quantization cell width; queries within the same cell
+   *     share a cache entry (must be positive).
+   * @param numShards Number of independent cache shards.
+   * @param shardCapacity Maximum number of entries held per shard.
+   */
+  QueryCache(SearchType& search,
+             const double tolerance = 1e-3,
+             const size_t numShards = 64,
+             const size_t shardCapacity = 32);
+
+  /**
+   * For each point in the query set, find the k neighbors, serving queries
+   * whose quantized coordinates were seen before from the cache and passing
+   * the rest to the underlying search object.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  //! Remove all cached results.
+  void Clear();
+
+  //! Get the quantization tolerance.
+  double Tolerance() const { return tolerance; }
+
+  //! Get the number of queries served from the cache so far.
+  size_t Hits() const { return hits; }
+  //! Get the number of queries passed to the underlying search so far.
+  size_t Misses() const { return misses; }
+
+ private:
+  //! A single cached result.
+  struct Entry
+  {
+    //! Quantized coordinates of the query.
+    arma::Col<arma::sword> cell;
+    //! Number of neighbors the cached result holds.
+    size_t k;
+    //! Cached neighbor indices.
+    arma::Col<size_t> neighbors;
+    //! Cached neighbor distances.
+    arma::vec distances;
+    //! Batch counter value of the last use, for LRU eviction.
+    size_t lastUsed;
+  };
+
+  //! Quantize a query point to its cell coordinates.
+  void Quantize(const MatType& querySet,
+                const size_t index,
+                arma::Col<arma::sword>& cell) const;
+
+  //! Compute the shard index for a cell.
+  size_t Shard(const arma::Col<arma::sword>& cell) const;
+
+  //! Find the entry for a cell in its shard, or return size_t(-1).
+  size_t Find(const size_t shard, const arma::Col<arma::sword>& cell) const;
+
+  //! The underlying search object.
+  SearchType& search;
+
+  //! Quantization cell width.
+  double tolerance;
+  //! Maximum number of entries per shard.
+  size_t shardCapacity;
+
+  //! The cache shards.
+  std::vector<std::vector<Entry>> shards;
+
+  //! Batch counter, incremented once per Search() call.
+  size_t batch;
+  //! Number of cache hits so far.
+  size_t hits;
+  //! Number of cache misses so far.
+  size_t misses;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "query_cache_impl.hpp"
+
+#endif
@@ -0,0 +1,196 @@
+/**
+ * @file methods/neighbor_search/query_cache_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the QueryCache class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_QUERY_CACHE_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_QUERY_CACHE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "query_cache.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SearchType, typename MatType>
+QueryCache<SearchType, MatType>::QueryCache(SearchType& search,
+                                            const double tolerance,
+                                            const size_t numShards,
+                                            const size_t shardCapacity) :
+    search(search),
+    tolerance(tolerance),
+    shardCapacity(shardCapacity),
+    shards(numShards),
+    batch(0),
+    hits(0),
+    misses(0)
+{
+  if (tolerance <= 0.0)
+    throw std::invalid_argument("QueryCache::QueryCache(): tolerance must be "
+        "positive!");
+  if (numShards == 0)
+    throw std::invalid_argument("QueryCache::QueryCache(): number of shards "
+        "must be greater than 0!");
+  if (shardCapacity == 0)
+    throw std::invalid_argument("QueryCache::QueryCache(): shard capacity "
+        "must be greater than 0!");
+}
+
+template<typename SearchType, typename MatType>
+void QueryCache<SearchType, MatType>::Quantize(
+    const MatType& querySet,
+    const size_t index,
+    arma::Col<arma::sword>& cell) const
+{
+  cell.set_size(querySet.n_rows);
+  for (size_t d = 0; d < querySet.n_rows; ++d)
+    cell[d] = (arma::sword) std::floor(querySet(d, index) / tolerance);
+}
+
+template<typename SearchType, typename MatType>
+size_t QueryCache<SearchType, MatType>::Shard(
+    const arma::Col<arma::sword>& cell) const
+{
+  size_t h = 0;
+  for (size_t d = 0; d < cell.n_elem; ++d)
+    h ^= std::hash<arma::sword>()(cell[d]) + 0x9e3779b9 + (h << 6) + (h >> 2);
+  return h % shards.size();
+}
+
+template<typename SearchType, typename MatType>
+size_t QueryCache<SearchType, MatType>::Find(
+    const size_t shard,
+    const arma::Col<arma::sword>& cell) const
+{
+  for (size_t i = 0; i < shards[shard].size(); ++i)
+  {
+    if (arma::all(shards[shard][i].cell == cell))
+      return i;
+  }
+  return size_t(-1);
+}
+
+template<typename SearchType, typename MatType>
+void QueryCache<SearchType, MatType>::Search(const MatType& querySet,
+                                             const size_t k,
+                                             arma::Mat<size_t>& neighbors,
+                                             arma::mat& distances)
+{
+  ++batch;
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  // Phase one: look every query up, read-only, distributed over threads.
+  // Cached results with at least k neighbors are served directly.
+  arma::Col<size_t> queryShards(querySet.n_cols);
+  std::vector<arma::Col<arma::sword>> cells(querySet.n_cols);
+  arma::uvec hit(querySet.n_cols);
+
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t q = 0; q < (omp_size_t) querySet.n_cols; ++q)
+  {
+    Quantize(querySet, q, cells[q]);
+    queryShards[q] = Shard(cells[q]);
+
+    const size_t entry = Find(queryShards[q], cells[q]);
+    if (entry != size_t(-1) && shards[queryShards[q]][entry].k >= k)
+    {
+      neighbors.col(q) =
+          shards[queryShards[q]][entry].neighbors.subvec(0, k - 1);
+      distances.col(q) =
+          shards[queryShards[q]][entry].distances.subvec(0, k - 1);
+      hit[q] = 1;
+    }
+    else
+    {
+      hit[q] = 0;
+    }
+  }
+
+  const arma::uvec missed = arma::find(hit == 0);
+  hits += (querySet.n_cols - missed.n_elem);
+  misses += missed.n_elem;
+
+  // Refresh the recency of the served entries (sequential; entries of one
+  // shard may be shared by several queries).
+  for (size_t q = 0; q < querySet.n_cols; ++q)
+  {
+    if (hit[q])
+      shards[queryShards[q]][Find(queryShards[q], cells[q])].lastUsed = batch;
+  }
+
+  if (missed.n_elem == 0)
+    return;
+
+  // Phase two: answer the missed queries with the underlying search.
+  MatType missSet(querySet.n_rows, missed.n_elem);
+  for (size_t i = 0; i < missed.n_elem; ++i)
+    missSet.col(i) = querySet.col(missed[i]);
+
+  arma::Mat<size_t> missNeighbors;
+  arma::mat missDistances;
+  search.Search(missSet, k, missNeighbors, missDistances);
+
+  for (size_t i = 0; i < missed.n_elem; ++i)
+  {
+    neighbors.col(missed[i]) = missNeighbors.col(i);
+    distances.col(missed[i]) = missDistances.col(i);
+  }
+
+  // Phase three: insert the new results.  Each shard is written by exactly
+  // one thread, so no synchronization is needed.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t s = 0; s < (omp_size_t) shards.size(); ++s)
+  {
+    for (size_t i = 0; i < missed.n_elem; ++i)
+    {
+      const size_t q = missed[i];
+      if (queryShards[q] != (size_t) s)
+        continue;
+
+      // A duplicate query in this batch may have inserted the cell already;
+      // keep the existing entry.
+      if (Find(s, cells[q]) != size_t(-1))
+        continue;
+
+      // Evict the least recently used entry if the shard is full.
+      if (shards[s].size() >= shardCapacity)
+      {
+        size_t oldest = 0;
+        for (size_t j = 1; j < shards[s].size(); ++j)
+        {
+          if (shards[s][j].lastUsed < shards[s][oldest].lastUsed)
+            oldest = j;
+        }
+        shards[s].erase(shards[s].begin() + oldest);
+      }
+
+      Entry entry;
+      entry.cell = cells[q];
+      entry.k = k;
+      entry.neighbors = neighbors.col(q);
+      entry.distances = distances.col(q);
+      entry.lastUsed = batch;
+      shards[s].push_back(std::move(entry));
+    }
+  }
+}
+
+template<typename SearchType, typename MatType>
+void QueryCache<SearchType, MatType>::Clear()
+{
+  for (size_t s = 0; s < shards.size(); ++s)
+    shards[s].clear();
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,134 @@
+/**
+ * @file methods/neighbor_search/sharded_neighbor_search.hpp
+ * @author Ryan Curtin
+ *
+ * A sharded search layer over NeighborSearch.  The reference set is split
+ * into shards, each with its own tree; queries are run against every shard
+ * and the per-shard results are merged by distance into the global top-k.
+ * Results are exact (the merge of exact per-shard results is the exact global
+ * result), and the capacity scales with the number of shards.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/parallel.hpp>
+
+#include "neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The ShardedNeighborSearch class performs exact neighbor search over a
+ * reference set that is split into shards.  Each shard is a contiguous slice
+ * of the reference set with its own NeighborSearch object (and thus its own
+ * tree); a query is broadcast to every shard, and the per-shard (neighbors,
+ * distances) results are merged by distance into the global top-k, with the
+ * shard-local neighbor indices mapped back to indices into the original
+ * reference set.
+ *
+ * Because each shard holds only a fraction of the reference set, the memory
+ * needed per shard shrinks as shards are added, and the shards are searched
+ * in parallel.  The same sharding and top-k merge applies unchanged when the
+ * shards are placed on different machines and the per-shard results are
+ * gathered over a transport; this class keeps all shards in-process.
+ *
+ * An example of use:
+ *
+ * @code
+ * extern arma::mat referenceSet, querySet;
+ * ShardedNeighborSearch<> sharded(std::move(referenceSet), 8);
+ *
+ * arma::Mat<size_t> neighbors;
+ * arma::mat distances;
+ * sharded.Search(querySet, 5, neighbors, distances);
+ * @endcode
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MetricType The metric to use for computation.
+ * @tparam MatType The type of data matrix.
+ * @tparam TreeType The tree type to use; must adhere to the TreeType API.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename MetricType = mlpack::metric::EuclideanDistance,
+         typename MatType = arma::mat,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType = tree::KDTree>
+class ShardedNeighborSearch
+{
+ public:
+  //! Convenience typedef for the per-shard search type.
+  typedef NeighborSearch<SortPolicy, MetricType, MatType, TreeType>
+      SearchType;
+
+  /**
+   * Initialize the sharded search with the given reference set, splitting it
+   * into the given number of shards (each a contiguous slice of columns) and
+   * building one tree per shard.  The mode, epsilon, and metric are passed
+   * through to each shard's NeighborSearch object.
+   *
+   * @param referenceSet Set of reference points.
+   * @param numShards Number of shards to split the reference set into; if 0,
+   *     one shard per thread is used.  The number of shards is capped at the
+   *     number of reference points.
+   * @param mode Neighbor search mode for every shard.
+   * @param epsilon Relative approximate error (non-negative).
+   * @param metric An optional instance of the MetricType class.
+   */
+  ShardedNeighborSearch(MatType referenceSet,
+                        const size_t numShards = 0,
+                        const NeighborSearchMode mode = DUAL_TREE_MODE,
+                        const double epsilon = 0,
+                        const MetricType metric = MetricType());
+
+  /**
+   * For each point in the query set, compute the k nearest neighbors over all
+   * shards and store the output in the given matrices, exactly as
+   * NeighborSearch::Search() would over the unsharded reference set.  The
+   * shards are searched in parallel, and the per-shard results are merged by
+   * distance.  Neighbor indices are indices into the original reference set.
+   *
+   * @param querySet Set of query points (can be just one point).
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix storing lists of neighbors for each query point.
+   * @param distances Matrix storing distances of neighbors for each query
+   *     point.
+   */
+  void Search(const MatType& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances);
+
+  //! Get the number of shards.
+  size_t NumShards() const { return shards.size(); }
+  //! Get a particular shard's search object.
+  const SearchType& Shard(const size_t i) const { return shards[i]; }
+  //! Get the index into the original reference set of the first point of a
+  //! particular shard.
+  size_t ShardOffset(const size_t i) const { return offsets[i]; }
+  //! Get the total number of reference points across all shards.
+  size_t ReferenceSetSize() const { return totalPoints; }
+
+ private:
+  //! The per-shard search objects.
+  std::vector<SearchType> shards;
+  //! Index of each shard's first point in the original reference set.
+  std::vector<size_t> offsets;
+  //! Total number of reference points.
+  size_t totalPoints;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "sharded_neighbor_search_impl.hpp"
+
+#endif
@@ -0,0 +1,136 @@
+/**
+ * @file methods/neighbor_search/sharded_neighbor_search_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the ShardedNeighborSearch class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SHARDED_NEIGHBOR_SEARCH_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "sharded_neighbor_search.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::
+ShardedNeighborSearch(MatType referenceSet,
+                      const size_t numShards,
+                      const NeighborSearchMode mode,
+                      const double epsilon,
+                      const MetricType metric) :
+    totalPoints(referenceSet.n_cols)
+{
+  // One shard per thread by default; never more shards than points.
+  size_t shardsToUse = (numShards == 0) ? Parallel::NumThreads() : numShards;
+  shardsToUse = std::max((size_t) 1,
+      std::min(shardsToUse, std::max(totalPoints, (size_t) 1)));
+
+  if (totalPoints == 0)
+  {
+    // Degenerate case: one empty shard.
+    offsets.push_back(0);
+    shards.emplace_back(std::move(referenceSet), mode, epsilon, metric);
+    return;
+  }
+
+  // Create the shard search objects first, then build the trees in parallel.
+  for (size_t i = 0; i < shardsToUse; ++i)
+  {
+    offsets.push_back((i * totalPoints) / shardsToUse);
+    shards.emplace_back(mode, epsilon, metric);
+  }
+
+  Parallel::For((size_t) 0, shards.size(), [&](const size_t i)
+  {
+    const size_t begin = offsets[i];
+    const size_t end = (i + 1 < shards.size()) ? offsets[i + 1] : totalPoints;
+    MatType shardSet(referenceSet.cols(begin, end - 1));
+    shards[i].Train(std::move(shardSet));
+  });
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void ShardedNeighborSearch<SortPolicy, MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const size_t k,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  if (k > totalPoints)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the reference set (" << totalPoints << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  // Broadcast the query set to every shard; each shard computes its own local
+  // top-k (capped at the shard's size), which is exact within the shard.
+  std::vector<arma::Mat<size_t>> shardNeighbors(shards.size());
+  std::vector<arma::mat> shardDistances(shards.size());
+
+  Parallel::For((size_t) 0, shards.size(), [&](const size_t i)
+  {
+    const size_t shardK = std::min(k, shards[i].ReferenceSet().n_cols);
+    if (shardK > 0)
+      shards[i].Search(querySet, shardK, shardNeighbors[i], shardDistances[i]);
+  });
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  // Merge the per-shard results by distance into the global top-k.  Each
+  // shard's result column is already sorted best-first by the sort policy, so
+  // this is a k-way merge; shard-local neighbor indices are mapped back to
+  // the original reference set with the shard offsets.
+  Parallel::For((size_t) 0, (size_t) querySet.n_cols, [&](const size_t q)
+  {
+    std::vector<size_t> heads(shards.size(), 0);
+    for (size_t j = 0; j < k; ++j)
+    {
+      size_t bestShard = shards.size();
+      double bestDistance = SortPolicy::WorstDistance();
+      for (size_t i = 0; i < shards.size(); ++i)
+      {
+        if (heads[i] >= shardDistances[i].n_rows)
+          continue;
+
+        const double d = shardDistances[i](heads[i], q);
+        if (bestShard == shards.size() || SortPolicy::IsBetter(d, bestDistance))
+        {
+          bestShard = i;
+          bestDistance = d;
+        }
+      }
+
+      // Since k is no more than the total number of points, some shard always
+      // has a candidate left.
+      neighbors(j, q) = offsets[bestShard] +
+          shardNeighbors[bestShard](heads[bestShard], q);
+      distances(j, q) = bestDistance;
+      ++heads[bestShard];
+    }
+  });
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * @file methods/neighbor_search/spill_search_tuner.hpp
+ * @author Ryan Curtin
+ *
+ * Defines the SpillSearchTuner class, which estimates the recall/latency
+ * tradeoff of defeatist spill tree search across overlap (tau) values using a
+ * single tree built at the maximum overlap, instead of rebuilding the index
+ * for every candidate setting.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SPILL_SEARCH_TUNER_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SPILL_SEARCH_TUNER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/spill_tree.hpp>
+
+#include "neighbor_search_stat.hpp"
+#include "sort_policies/nearest_neighbor_sort.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * The SpillSearchTuner class estimates how the defeatist spill tree search
+ * behaves across overlap (tau) values without rebuilding the tree for each
+ * attempt.  The key observation is that the defeatist descent path of a query
+ * does not depend on tau -- only the set of points spilled into each leaf
+ * does -- and a point spilled across a splitting hyperplane at overlap tau'
+ * would also have been spilled at any larger overlap.  So one tree built at
+ * the maximum overlap of interest can answer "what would defeatist search
+ * return at effective overlap tau <= maxTau?" for any query: descend as
+ * usual, then keep only the leaf points whose projections onto the spilled
+ * ancestors' hyperplanes are within tau.
+ *
+ * Estimate() samples queries from the reference set, computes their exact
+ * neighbors by brute force, and measures the recall, candidate count, and
+ * latency of the simulated defeatist search at each requested tau.
+ * Recommend() picks the smallest tau that reaches a target recall, since
+ * smaller overlaps mean fewer candidates and lower latency.
+ *
+ * The simulation keeps the tree structure fixed at the maxTau build, whereas
+ * a tree built directly at a smaller tau may make different overlap/no-spill
+ * decisions at some nodes; the estimate is therefore an approximation, but
+ * one obtained from a single build plus minutes of evaluation rather than a
+ * rebuild per setting.
+ *
+ * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
+ * @tparam MetricType The metric to use for computation.
+ * @tparam MatType The type of data matrix.
+ * @tparam HyperplaneType The splitting hyperplane class of the spill tree.
+ * @tparam SplitType The class that partitions the dataset at each node.
+ */
+template<typename SortPolicy = NearestNeighborSort,
+         typename MetricType = mlpack::metric::EuclideanDistance,
+         typename MatType = arma::mat,
+         template<typename HyperplaneMetricType>
+            class HyperplaneType = tree::AxisOrthogonalHyperplane,
+         template<typename SplitMetricType, typename SplitMatType>
+            class SplitType = tree::MidpointSpaceSplit>
+class SpillSearchTuner
+{
+ public:
+  //! Convenience typedef.
+  typedef tree::SpillTree<MetricType, NeighborSearchStat<SortPolicy>, MatType,
+      HyperplaneType, SplitType> Tree;
+
+  /**
+   * Build the tuner's spill tree once, at the maximum overlap of interest.
+   * The reference set is not copied and must outlive the tuner.
+   *
+   * @param referenceSet Set of reference points.
+   * @param maxTau Largest overlap value that will be evaluated.
+   * @param maxLeafSize Size of each leaf in the tree.
+   * @param rho Balance threshold.
+   * @param metric An optional instance of the MetricType class.
+   */
+  SpillSearchTuner(const MatType& referenceSet,
+                   const double maxTau,
+                   const size_t maxLeafSize = 20,
+                   const double rho = 0.7,
+                   const MetricType metric = MetricType());
+
+  /**
+   * Estimate the recall and latency of defeatist search at each of the given
+   * effective tau values, using a random sample of the reference points as
+   * queries and brute-force search for the exact ground truth.  Values of
+   * tau larger than maxTau cannot add candidates beyond those spilled at
+   * build time, so they report the same results as maxTau.
+   *
+   * The returned matrix has one row per tau value with four columns: the tau
+   * value, the average recall in [0, 1], the average number of candidate
+   * points examined per query, and the average search time per query in
+   * microseconds.
+   *
+   * @param tauValues Effective overlap values to evaluate.
+   * @param k Number of neighbors to search for.
+   * @param numQueries Number of reference points to sample as queries.
+   * @return Matrix of (tau, recall, candidates, microseconds) rows.
+   */
+  arma::mat Estimate(const arma::vec& tauValues,
+                     const size_t k,
+                     const size_t numQueries = 100);
+
+  /**
+   * Recommend the smallest tau value whose estimated recall reaches the
+   * given target; if no value reaches it, the tau with the best recall is
+   * returned instead.
+   *
+   * @param tauValues Effective overlap values to evaluate.
+   * @param k Number of neighbors to search for.
+   * @param minRecall Target recall in [0, 1].
+   * @param numQueries Number of reference points to sample as queries.
+   * @return Recommended tau value.
+   */
+  double Recommend(const arma::vec& tauValues,
+                   const size_t k,
+                   const double minRecall,
+                   const size_t numQueries = 100);
+
+  //! Access the spill tree built at the maximum overlap.
+  const Tree& ReferenceTree() const { return referenceTree; }
+
+  //! Get the overlap value the tree was built with.
+  double MaxTau() const { return maxTau; }
+
+ private:
+  /**
+   * Collect the candidate points that defeatist search at the given
+   * effective tau would examine for the given query point: descend to the
+   * query's leaf, then keep the leaf points whose projections onto the
+   * spilled ancestors' hyperplanes are within tau.  The query point itself
+   * is excluded.
+   *
+   * @param queryIndex Index of the query point in the reference set.
+   * @param tau Effective overlap value.
+   * @param candidates Vector to store the candidate indices in.
+   */
+  void Candidates(const size_t queryIndex,
+                  const double tau,
+                  std::vector<size_t>& candidates) const;
+
+  /**
+   * Return the (up to) k best candidates for the given query point, ordered
+   * best-first according to the sort policy.
+   *
+   * @param queryIndex Index of the query point in the reference set.
+   * @param candidates Candidate point indices.
+   * @param k Number of neighbors to return.
+   */
+  std::vector<size_t> TopK(const size_t queryIndex,
+                           const std::vector<size_t>& candidates,
+                           const size_t k);
+
+  //! Reference dataset (not owned).
+  const MatType& referenceSet;
+  //! The overlap value the tree was built with.
+  double maxTau;
+  //! Instantiation of metric.
+  MetricType metric;
+  //! The spill tree built at the maximum overlap.
+  Tree referenceTree;
+}; // class SpillSearchTuner
+
+} // namespace neighbor
+} // namespace mlpack
+
+// Include implementation.
+#include "spill_search_tuner_impl.hpp"
+
+#endif
@@ -0,0 +1,252 @@
+/**
+ * @file methods/neighbor_search/spill_search_tuner_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the SpillSearchTuner class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_SPILL_SEARCH_TUNER_IMPL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_SPILL_SEARCH_TUNER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "spill_search_tuner.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename> class HyperplaneType,
+         template<typename, typename> class SplitType>
+SpillSearchTuner<SortPolicy, MetricType, MatType, HyperplaneType, SplitType>::
+SpillSearchTuner(const MatType& referenceSet,
+                 const double maxTau,
+                 const size_t maxLeafSize,
+                 const double rho,
+                 const MetricType metric) :
+    referenceSet(referenceSet),
+    maxTau(maxTau),
+    metric(metric),
+    referenceTree(referenceSet, maxTau, maxLeafSize, rho)
+{
+  if (maxTau < 0)
+    throw std::invalid_argument("maxTau must be non-negative");
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename> class HyperplaneType,
+         template<typename, typename> class SplitType>
+arma::mat SpillSearchTuner<SortPolicy, MetricType, MatType, HyperplaneType,
+SplitType>::Estimate(const arma::vec& tauValues,
+                     const size_t k,
+                     const size_t numQueries)
+{
+  Timer::Start("spill_search_tuning");
+
+  // Sample query points from the reference set.
+  const size_t numSamples = std::min(numQueries,
+      (size_t) referenceSet.n_cols);
+  const arma::uvec sample = arma::shuffle(arma::regspace<arma::uvec>(0,
+      referenceSet.n_cols - 1)).head(numSamples);
+
+  // Compute the exact neighbors of each sampled query by brute force; this
+  // is the ground truth the simulated searches are scored against.
+  std::vector<size_t> allPoints(referenceSet.n_cols);
+  for (size_t i = 0; i < referenceSet.n_cols; ++i)
+    allPoints[i] = i;
+
+  std::vector<std::vector<size_t>> exactNeighbors(numSamples);
+  for (size_t q = 0; q < numSamples; ++q)
+    exactNeighbors[q] = TopK(sample[q], allPoints, k);
+
+  arma::mat results(tauValues.n_elem, 4);
+  std::vector<size_t> candidates;
+  for (size_t t = 0; t < tauValues.n_elem; ++t)
+  {
+    const double tau = tauValues[t];
+
+    double recall = 0;
+    double numCandidates = 0;
+    double micros = 0;
+    for (size_t q = 0; q < numSamples; ++q)
+    {
+      const std::chrono::steady_clock::time_point start =
+          std::chrono::steady_clock::now();
+
+      Candidates(sample[q], tau, candidates);
+      const std::vector<size_t> found = TopK(sample[q], candidates, k);
+
+      micros += std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start).count() / 1000.0;
+      numCandidates += candidates.size();
+
+      // Count how many of the exact neighbors the simulated search found.
+      for (size_t i = 0; i < found.size(); ++i)
+      {
+        if (std::find(exactNeighbors[q].begin(), exactNeighbors[q].end(),
+            found[i]) != exactNeighbors[q].end())
+          recall++;
+      }
+    }
+
+    results(t, 0) = tau;
+    results(t, 1) = recall / (numSamples * std::min(k,
+        (size_t) (referenceSet.n_cols - 1)));
+    results(t, 2) = numCandidates / numSamples;
+    results(t, 3) = micros / numSamples;
+  }
+
+  Timer::Stop("spill_search_tuning");
+
+  return results;
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename> class HyperplaneType,
+         template<typename, typename> class SplitType>
+double SpillSearchTuner<SortPolicy, MetricType, MatType, HyperplaneType,
+SplitType>::Recommend(const arma::vec& tauValues,
+                      const size_t k,
+                      const double minRecall,
+                      const size_t numQueries)
+{
+  const arma::mat results = Estimate(tauValues, k, numQueries);
+
+  // Candidate sets grow with tau, so among the values that reach the target
+  // recall the smallest tau has the lowest latency.
+  size_t best = 0;
+  bool found = false;
+  for (size_t t = 0; t < results.n_rows; ++t)
+  {
+    if (results(t, 1) >= minRecall &&
+        (!found || results(t, 0) < results(best, 0)))
+    {
+      best = t;
+      found = true;
+    }
+    else if (!found && results(t, 1) > results(best, 1))
+    {
+      best = t;
+    }
+  }
+
+  if (!found)
+  {
+    Log::Warn << "SpillSearchTuner::Recommend(): no tau value reaches recall "
+        << minRecall << "; returning tau = " << results(best, 0)
+        << " with estimated recall " << results(best, 1) << "." << std::endl;
+  }
+  else
+  {
+    Log::Info << "SpillSearchTuner::Recommend(): tau = " << results(best, 0)
+        << " gives estimated recall " << results(best, 1) << " at "
+        << results(best, 3) << " microseconds per query." << std::endl;
+  }
+
+  return results(best, 0);
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename> class HyperplaneType,
+         template<typename, typename> class SplitType>
+void SpillSearchTuner<SortPolicy, MetricType, MatType, HyperplaneType,
+SplitType>::Candidates(const size_t queryIndex,
+                       const double tau,
+                       std::vector<size_t>& candidates) const
+{
+  candidates.clear();
+
+  // Defeatist descent: the path only depends on which side of each splitting
+  // hyperplane the query falls, never on tau.  Remember the spilled ancestors
+  // so the leaf points can be filtered down to the effective overlap.
+  std::vector<std::pair<const Tree*, bool>> spilledAncestors;
+  const Tree* node = &referenceTree;
+  while (!node->IsLeaf())
+  {
+    const bool left = node->Hyperplane().Left(referenceSet.col(queryIndex));
+    if (node->Overlap())
+      spilledAncestors.push_back(std::make_pair(node, left));
+
+    node = left ? node->Left() : node->Right();
+  }
+
+  for (size_t i = 0; i < node->NumPoints(); ++i)
+  {
+    const size_t point = node->Point(i);
+    if (point == queryIndex)
+      continue;
+
+    // A point on the far side of a spilled ancestor's hyperplane is only
+    // present in this leaf because its projection is within the build-time
+    // overlap; at effective overlap tau it survives only if the projection
+    // is within tau.
+    bool keep = true;
+    for (size_t a = 0; a < spilledAncestors.size(); ++a)
+    {
+      const double projection = spilledAncestors[a].first->Hyperplane().
+          Project(referenceSet.col(point));
+      if (spilledAncestors[a].second ? (projection > tau) :
+          (projection < -tau))
+      {
+        keep = false;
+        break;
+      }
+    }
+
+    if (keep)
+      candidates.push_back(point);
+  }
+}
+
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename> class HyperplaneType,
+         template<typename, typename> class SplitType>
+std::vector<size_t> SpillSearchTuner<SortPolicy, MetricType, MatType,
+HyperplaneType, SplitType>::TopK(const size_t queryIndex,
+                                 const std::vector<size_t>& candidates,
+                                 const size_t k)
+{
+  std::vector<std::pair<double, size_t>> scored;
+  scored.reserve(candidates.size());
+  for (size_t i = 0; i < candidates.size(); ++i)
+  {
+    if (candidates[i] == queryIndex)
+      continue;
+
+    scored.push_back(std::make_pair(metric.Evaluate(
+        referenceSet.col(queryIndex), referenceSet.col(candidates[i])),
+        candidates[i]));
+  }
+
+  const size_t take = std::min(k, scored.size());
+  std::partial_sort(scored.begin(), scored.begin() + take, scored.end(),
+      [](const std::pair<double, size_t>& a, const std::pair<double, size_t>& b)
+      { return SortPolicy::IsBetter(a.first, b.first); });
+
+  std::vector<size_t> result(take);
+  for (size_t i = 0; i < take; ++i)
+    result[i] = scored[i].second;
+
+  return result;
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,137 @@
+/**
+ * @file methods/neighbor_search/stream_search.hpp
+ * @author Ryan Curtin
+ *
+ * Streamed block-wise search support for the kNN and kFN bindings.  Instead
+ * of buffering the complete neighbors and distances matrices in memory and
+ * writing them after every query has finished, StreamSearch() processes the
+ * query set in blocks and appends each block's results to the output files as
+ * the block completes, so peak memory stays flat regardless of the number of
+ * queries and downstream consumers can start reading results immediately.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_STREAM_SEARCH_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_STREAM_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/data/extension.hpp>
+
+#include "ns_model.hpp"
+
+#include <fstream>
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * Return true if the given streamed output filename should be written as
+ * text; '.csv' and '.txt' files are written as comma-separated text, and
+ * anything else is written as headerless raw binary (column-major, one set of
+ * k results per query point, in query order).
+ */
+inline bool StreamedOutputIsText(const std::string& filename)
+{
+  const std::string extension = data::Extension(filename);
+  return (extension == "csv" || extension == "txt");
+}
+
+/**
+ * Append one block of results to the given stream.  Text output follows the
+ * convention of data::Save(): one row per query point, with the k results for
+ * that query as the row's columns.  Binary output is raw little-endian
+ * elements with no header, in the same order.
+ *
+ * @param stream Stream to append to.
+ * @param block Block of results (k rows, one column per query point).
+ * @param text If true, write comma-separated text; otherwise raw binary.
+ */
+template<typename eT>
+void AppendStreamedBlock(std::ofstream& stream,
+                         const arma::Mat<eT>& block,
+                         const bool text)
+{
+  if (text)
+    arma::Mat<eT>(block.t()).save(stream, arma::csv_ascii);
+  else
+    block.save(stream, arma::raw_binary);
+}
+
+/**
+ * Search for the k best neighbors of each query point, processing the query
+ * set in blocks of blockSize points and appending each block's results to the
+ * given files as the block completes.  Results are identical to a single
+ * Search() call over the whole query set; only the output path differs.
+ * Either filename may be empty, in which case that output is not written.
+ *
+ * @param model Model to search with.
+ * @param querySet Set of query points.
+ * @param k Number of neighbors to search for.
+ * @param blockSize Number of query points to process at once.
+ * @param neighborsFile File to append neighbor indices to (may be empty).
+ * @param distancesFile File to append distances to (may be empty).
+ */
+template<typename SortPolicy>
+void StreamSearch(NSModel<SortPolicy>& model,
+                  arma::mat&& querySet,
+                  const size_t k,
+                  const size_t blockSize,
+                  const std::string& neighborsFile,
+                  const std::string& distancesFile)
+{
+  std::ofstream neighborsStream;
+  if (!neighborsFile.empty())
+  {
+    neighborsStream.open(neighborsFile, StreamedOutputIsText(neighborsFile) ?
+        std::ios::out : (std::ios::out | std::ios::binary));
+    if (!neighborsStream.is_open())
+      Log::Fatal << "Unable to open file '" << neighborsFile << "' to stream "
+          << "neighbor results into!" << std::endl;
+  }
+
+  std::ofstream distancesStream;
+  if (!distancesFile.empty())
+  {
+    distancesStream.open(distancesFile, StreamedOutputIsText(distancesFile) ?
+        std::ios::out : (std::ios::out | std::ios::binary));
+    if (!distancesStream.is_open())
+      Log::Fatal << "Unable to open file '" << distancesFile << "' to stream "
+          << "distance results into!" << std::endl;
+  }
+
+  const size_t numBlocks = (querySet.n_cols + blockSize - 1) / blockSize;
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  for (size_t block = 0; block < numBlocks; ++block)
+  {
+    const size_t begin = block * blockSize;
+    const size_t end = std::min(begin + blockSize, (size_t) querySet.n_cols);
+
+    arma::mat queryBlock = querySet.cols(begin, end - 1);
+    model.Search(std::move(queryBlock), k, neighbors, distances);
+
+    if (neighborsStream.is_open())
+    {
+      AppendStreamedBlock(neighborsStream, neighbors,
+          StreamedOutputIsText(neighborsFile));
+      neighborsStream.flush();
+    }
+    if (distancesStream.is_open())
+    {
+      AppendStreamedBlock(distancesStream, distances,
+          StreamedOutputIsText(distancesFile));
+      distancesStream.flush();
+    }
+
+    Log::Info << "Streamed results for queries [" << begin << ", " << end
+        << ")." << std::endl;
+  }
+}
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
@@ -66,6 +66,19 @@ using DefeatistKNN = NeighborSearch<
  */
 typedef DefeatistKNN<tree::SPTree> SpillKNN;
 
+// The most common configurations---the KNN and KFN typedefs above, and their
+// ball tree counterparts---are compiled once into the mlpack library (see
+// neighbor_search_instantiations.cpp); these declarations keep other
+// translation units from instantiating them again.
+extern template class NeighborSearch<NearestNeighborSort,
+    metric::EuclideanDistance>;
+extern template class NeighborSearch<FurthestNeighborSort,
+    metric::EuclideanDistance>;
+extern template class NeighborSearch<NearestNeighborSort,
+    metric::EuclideanDistance, arma::mat, tree::BallTree>;
+extern template class NeighborSearch<FurthestNeighborSort,
+    metric::EuclideanDistance, arma::mat, tree::BallTree>;
+
 } // namespace neighbor
 } // namespace mlpack
 
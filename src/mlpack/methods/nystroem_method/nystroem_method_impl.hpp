@@ -16,9 +16,66 @@
 // In case it hasn't been included yet.
 #include "nystroem_method.hpp"
 
+#include <mlpack/core/kernels/gaussian_kernel.hpp>
+
 namespace mlpack {
 namespace kernel {
 
+/**
+ * Utility struct for evaluating a whole block of kernel values as one matrix
+ * product, for kernels that are an elementwise function of the squared
+ * Euclidean distance.  The squared distances between two sets of points can
+ * be assembled as ||a_i||^2 + ||b_j||^2 - 2 a_i^T b_j, where the inner
+ * products are a single GEMM; that is far faster than one kernel.Evaluate()
+ * call per pair.  The generic implementation is not usable; specializations
+ * exist for the kernels whose value is such a function.
+ */
+template<typename KernelType>
+struct BlockDistanceKernelEvaluator
+{
+  //! Whether blocks of this kernel can be evaluated as a matrix product.
+  static const bool Usable = false;
+
+  //! Unused stub so that the dead branch compiles for other kernels.
+  static void Evaluate(KernelType& /* kernel */,
+                       const arma::mat& /* a */,
+                       const arma::mat& /* b */,
+                       arma::mat& /* values */) { }
+};
+
+//! For the Gaussian kernel, a block is exp(gamma * d^2) of the squared
+//! distances.
+template<>
+struct BlockDistanceKernelEvaluator<GaussianKernel>
+{
+  static const bool Usable = true;
+
+  /**
+   * Compute values(i, j) = K(a.col(i), b.col(j)) for the whole block.
+   */
+  static void Evaluate(GaussianKernel& kernel,
+                       const arma::mat& a,
+                       const arma::mat& b,
+                       arma::mat& values)
+  {
+    // Assemble the squared distances; the inner products are one GEMM.
+    values = -2.0 * (arma::trans(a) * b);
+    values.each_col() += arma::sum(arma::square(a), 0).t();
+    values.each_row() += arma::sum(arma::square(b), 0);
+
+    // Apply the kernel elementwise.  Rounding in the GEMM can push tiny
+    // squared distances below zero, so clamp them first; coincident points
+    // then get exactly K(x, x) = 1.
+    const double gamma = kernel.Gamma();
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t j = 0; j < (omp_size_t) values.n_cols; ++j)
+    {
+      values.col(j) = arma::exp(gamma *
+          arma::clamp(values.col(j), 0.0, arma::datum::inf));
+    }
+  }
+};
+
 template<typename KernelType, typename PointSelectionPolicy>
 NystroemMethod<KernelType, PointSelectionPolicy>::NystroemMethod(
     const arma::mat& data,
@@ -35,15 +92,38 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
     arma::mat& miniKernel,
     arma::mat& semiKernel)
 {
-  // Assemble mini-kernel matrix.
-  for (size_t i = 0; i < rank; ++i)
-    for (size_t j = 0; j < rank; ++j)
+  // If the kernel is an elementwise function of the squared distance, both
+  // matrices can be assembled as matrix products.
+  if (BlockDistanceKernelEvaluator<KernelType>::Usable)
+  {
+    BlockDistanceKernelEvaluator<KernelType>::Evaluate(kernel, *selectedData,
+        *selectedData, miniKernel);
+    BlockDistanceKernelEvaluator<KernelType>::Evaluate(kernel, data,
+        *selectedData, semiKernel);
+
+    // Clean the memory.
+    delete selectedData;
+    return;
+  }
+
+  // Assemble mini-kernel matrix.  Only the upper triangular part needs to be
+  // computed, since the kernel matrix is symmetric.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < rank; ++i)
+  {
+    for (size_t j = i; j < rank; ++j)
+    {
       miniKernel(i, j) = kernel.Evaluate(selectedData->col(i),
                                          selectedData->col(j));
+      miniKernel(j, i) = miniKernel(i, j);
+    }
+  }
 
   // Construct semi-kernel matrix with interactions between selected data and
-  // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // all points.  Each row is independent, so the kernel evaluations can run
+  // in parallel; this is the dominant cost for large datasets.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < data.n_cols; ++i)
     for (size_t j = 0; j < rank; ++j)
       semiKernel(i, j) = kernel.Evaluate(data.col(i),
                                          selectedData->col(j));
@@ -57,19 +137,37 @@ void NystroemMethod<KernelType, PointSelectionPolicy>::GetKernelMatrix(
     arma::mat& miniKernel,
     arma::mat& semiKernel)
 {
-  // Assemble mini-kernel matrix.
-  for (size_t i = 0; i < rank; ++i)
+  // If the kernel is an elementwise function of the squared distance, both
+  // matrices can be assembled as matrix products over the selected columns.
+  if (BlockDistanceKernelEvaluator<KernelType>::Usable)
   {
-    for (size_t j = 0; j < rank; ++j)
+    const arma::mat selectedData =
+        data.cols(arma::conv_to<arma::uvec>::from(selectedPoints));
+    BlockDistanceKernelEvaluator<KernelType>::Evaluate(kernel, selectedData,
+        selectedData, miniKernel);
+    BlockDistanceKernelEvaluator<KernelType>::Evaluate(kernel, data,
+        selectedData, semiKernel);
+    return;
+  }
+
+  // Assemble mini-kernel matrix.  Only the upper triangular part needs to be
+  // computed, since the kernel matrix is symmetric.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < rank; ++i)
+  {
+    for (size_t j = i; j < rank; ++j)
     {
       miniKernel(i, j) = kernel.Evaluate(data.col(selectedPoints(i)),
                                          data.col(selectedPoints(j)));
+      miniKernel(j, i) = miniKernel(i, j);
     }
   }
 
   // Construct semi-kernel matrix with interactions between selected points and
-  // all points.
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // all points.  Each row is independent, so the kernel evaluations can run
+  // in parallel; this is the dominant cost for large datasets.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < data.n_cols; ++i)
     for (size_t j = 0; j < rank; ++j)
       semiKernel(i, j) = kernel.Evaluate(data.col(i),
                                          data.col(selectedPoints(j)));
@@ -0,0 +1,208 @@
+/**
+ * @file methods/pca/decomposition_policies/blocked_randomized_svd_method.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of a blocked (streaming) randomized SVD method for use in
+ * the Principal Components Analysis method.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+#ifndef MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_BLOCKED_RANDOMIZED_SVD_HPP
+#define MLPACK_METHODS_PCA_DECOMPOSITION_POLICIES_BLOCKED_RANDOMIZED_SVD_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace pca {
+
+/**
+ * Implementation of the blocked randomized SVD policy.  This uses the
+ * randomized range finder of Halko, Martinsson and Tropp, but applies the
+ * covariance operator in sequential passes over fixed-size column blocks, so
+ * the covariance matrix is never formed and no second copy of the dataset is
+ * ever held in memory.  Each pass touches the columns of the data matrix once,
+ * in order; therefore the policy can be applied to matrices far larger than
+ * RAM when the data is memory-mapped (see data::MmapLoad()), with peak memory
+ * usage bounded by the block size and the subspace size instead of the size of
+ * the dataset.
+ *
+ * Note that, like RandomizedSVDPolicy, this policy operates on the raw data
+ * matrix (it centers each block internally), so it does not honor the
+ * scaleData option of the PCA class.
+ *
+ * @code
+ * @article{Halko2011,
+ *   author  = {Halko, N. and Martinsson, P. G. and Tropp, J. A.},
+ *   title   = {Finding Structure with Randomness: Probabilistic Algorithms
+ *              for Constructing Approximate Matrix Decompositions},
+ *   journal = {SIAM Review},
+ *   volume  = {53},
+ *   number  = {2},
+ *   year    = {2011},
+ * }
+ * @endcode
+ */
+class BlockedRandomizedSVDPolicy
+{
+ public:
+  /**
+   * Use the blocked randomized SVD method to perform the principal components
+   * analysis (PCA).
+   *
+   * @param maxIterations Number of power iterations of the range finder; each
+   *        additional iteration costs one more pass over the data
+   *        (Default: 2).
+   * @param oversampling Number of extra dimensions of the random subspace,
+   *        beyond the requested rank (Default: 5).
+   * @param blockSize Number of columns held in memory at once (Default:
+   *        1024).
+   */
+  BlockedRandomizedSVDPolicy(const size_t maxIterations = 2,
+                             const size_t oversampling = 5,
+                             const size_t blockSize = 1024) :
+      maxIterations(maxIterations),
+      oversampling(oversampling),
+      blockSize(blockSize)
+  {
+    /* Nothing to do here */
+  }
+
+  /**
+   * Apply Principal Component Analysis to the provided data set using the
+   * blocked randomized SVD.
+   *
+   * Like the other approximate policies, this returns all of the components
+   * of the random subspace (rank plus oversampling, at most the
+   * dimensionality), so that callers can trim to the requested rank
+   * themselves.
+   *
+   * @param data Data matrix.
+   * @param * (centeredData) Centered data matrix (ignored; blocks of the data
+   *        matrix are centered internally instead).
+   * @param transformedData Matrix to put results of PCA into.
+   * @param eigVal Vector to put eigenvalues into.
+   * @param eigvec Matrix to put eigenvectors (loadings) into.
+   * @param rank Rank of the decomposition.
+   */
+  void Apply(const arma::mat& data,
+             const arma::mat& /* centeredData */,
+             arma::mat& transformedData,
+             arma::vec& eigVal,
+             arma::mat& eigvec,
+             const size_t rank)
+  {
+    const size_t dim = data.n_rows;
+    const size_t numCols = data.n_cols;
+    // The size of the random subspace.
+    const size_t l = std::min(dim, rank + oversampling);
+    // The covariance matrix is X * X' / (N - 1).
+    const double denom = (numCols > 1) ? (double) (numCols - 1) : 1.0;
+
+    // First sequential pass: the mean of the columns.
+    arma::vec mean(dim, arma::fill::zeros);
+    for (size_t begin = 0; begin < numCols; begin += blockSize)
+    {
+      const size_t end = std::min(begin + blockSize, numCols) - 1;
+      mean += arma::sum(data.cols(begin, end), 1);
+    }
+    mean /= numCols;
+
+    // Range finder: apply the covariance operator to a Gaussian test matrix,
+    // orthonormalizing between applications (subspace iteration).  Each
+    // application is one sequential pass over the column blocks; the d x d
+    // covariance matrix is never formed.
+    arma::mat q = arma::randn<arma::mat>(dim, l);
+    arma::mat r;
+    for (size_t iteration = 0; iteration < maxIterations + 1; ++iteration)
+    {
+      arma::mat y(dim, l, arma::fill::zeros);
+      for (size_t begin = 0; begin < numCols; begin += blockSize)
+      {
+        const size_t end = std::min(begin + blockSize, numCols) - 1;
+        arma::mat block = data.cols(begin, end);
+        block.each_col() -= mean;
+        y += block * (block.t() * q);
+      }
+      y /= denom;
+      arma::qr_econ(q, r, y);
+    }
+
+    // One more pass to project the covariance into the subspace:
+    // b = q' * C * q.
+    arma::mat b(l, l, arma::fill::zeros);
+    for (size_t begin = 0; begin < numCols; begin += blockSize)
+    {
+      const size_t end = std::min(begin + blockSize, numCols) - 1;
+      arma::mat block = data.cols(begin, end);
+      block.each_col() -= mean;
+      const arma::mat projectedBlock = q.t() * block;
+      b += projectedBlock * projectedBlock.t();
+    }
+    b /= denom;
+
+    // The small eigenproblem gives the eigenvalues directly and rotates the
+    // basis onto the principal axes.
+    arma::vec smallEigVal;
+    arma::mat smallEigvec;
+    arma::eig_sym(smallEigVal, smallEigvec, arma::symmatu(b));
+
+    // eig_sym() returns ascending eigenvalues; flip to descending order.
+    const arma::mat rotated = q * smallEigvec;
+    eigVal.set_size(l);
+    eigvec.set_size(dim, l);
+    for (size_t i = 0; i < l; ++i)
+    {
+      // Round-off can make near-zero eigenvalues slightly negative.
+      eigVal[i] = std::max(smallEigVal[l - 1 - i], 0.0);
+      eigvec.col(i) = rotated.col(l - 1 - i);
+    }
+
+    // Last sequential pass: project the centered data onto the principal
+    // axes.  transformedData may alias data (the dimensionality reduction
+    // overload of PCA::Apply() passes it that way), so project into a
+    // temporary matrix first.
+    arma::mat projected(l, numCols);
+    for (size_t begin = 0; begin < numCols; begin += blockSize)
+    {
+      const size_t end = std::min(begin + blockSize, numCols) - 1;
+      arma::mat block = data.cols(begin, end);
+      block.each_col() -= mean;
+      projected.cols(begin, end) = eigvec.t() * block;
+    }
+    transformedData = std::move(projected);
+  }
+
+  //! Get the number of power iterations of the range finder.
+  size_t MaxIterations() const { return maxIterations; }
+  //! Modify the number of power iterations of the range finder.
+  size_t& MaxIterations() { return maxIterations; }
+
+  //! Get the number of extra dimensions of the random subspace.
+  size_t Oversampling() const { return oversampling; }
+  //! Modify the number of extra dimensions of the random subspace.
+  size_t& Oversampling() { return oversampling; }
+
+  //! Get the number of columns held in memory at once.
+  size_t BlockSize() const { return blockSize; }
+  //! Modify the number of columns held in memory at once.
+  size_t& BlockSize() { return blockSize; }
+
+ private:
+  //! Locally stored number of power iterations of the range finder.
+  size_t maxIterations;
+
+  //! Locally stored number of extra dimensions of the random subspace.
+  size_t oversampling;
+
+  //! Locally stored number of columns held in memory at once.
+  size_t blockSize;
+};
+
+} // namespace pca
+} // namespace mlpack
+
+#endif
@@ -15,6 +15,7 @@
 #include <mlpack/core/util/mlpack_main.hpp>
 
 #include "pca.hpp"
+#include <mlpack/methods/pca/decomposition_policies/blocked_randomized_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/exact_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/quic_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/randomized_svd_method.hpp>
@@ -54,7 +55,10 @@ BINDING_LONG_DESC(
     "Multiple different decomposition techniques can be used.  The method to "
     "use can be specified with the " +
     PRINT_PARAM_STRING("decomposition_method") + " parameter, and it may take "
-    "the values 'exact', 'randomized', or 'quic'.");
+    "the values 'exact', 'randomized', 'blocked-randomized', or 'quic'.  The "
+    "'blocked-randomized' method computes an approximate decomposition in "
+    "sequential passes over fixed-size column blocks, so it is suited to "
+    "datasets too large to process in one piece.");
 
 // Example.
 BINDING_EXAMPLE(
@@ -85,7 +89,7 @@ PARAM_FLAG("scale", "If set, the data will be scaled before running PCA, such "
 
 PARAM_STRING_IN("decomposition_method", "Method used for the principal "
     "components analysis: 'exact', 'randomized', 'randomized-block-krylov', "
-    "'quic'.", "c", "exact");
+    "'blocked-randomized', 'quic'.", "c", "exact");
 
 
 //! Run RunPCA on the specified dataset with the given decomposition method.
@@ -127,7 +131,7 @@ static void mlpackMain()
 
   // Check decomposition method validity.
   RequireParamInSet<string>("decomposition_method", { "exact", "randomized",
-      "randomized-block-krylov", "quic" }, true,
+      "randomized-block-krylov", "blocked-randomized", "quic" }, true,
       "unknown decomposition method");
 
   // Find out what dimension we want.
@@ -166,6 +170,11 @@ static void mlpackMain()
     RunPCA<RandomizedBlockKrylovSVDPolicy>(dataset, newDimension, scale,
         varToRetain);
   }
+  else if (decompositionMethod == "blocked-randomized")
+  {
+    RunPCA<BlockedRandomizedSVDPolicy>(dataset, newDimension, scale,
+        varToRetain);
+  }
   else if (decompositionMethod == "quic")
   {
     RunPCA<QUICSVDPolicy>(dataset, newDimension, scale, varToRetain);
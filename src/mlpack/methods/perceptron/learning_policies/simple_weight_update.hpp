@@ -60,6 +60,46 @@ class SimpleWeightUpdate
     weights.col(correctClass) += instanceWeight * trainingPoint;
     biases(correctClass) += instanceWeight;
   }
+
+  /**
+   * This function applies the updates for a whole block of points at once; it
+   * is used by the mini-batch training mode of the perceptron.  The individual
+   * +/- point updates are collected into a coefficient matrix so that the
+   * whole block can be applied with a single matrix product.  Points whose
+   * predicted class is already correct contribute cancelling coefficients, so
+   * no separate mistake mask is needed.
+   *
+   * @tparam MatType Type of matrix (should be an Armadillo matrix like
+   *      arma::mat or arma::sp_mat or something similar).
+   * @param trainingPoints Block of training points.
+   * @param weights Matrix of weights.
+   * @param biases Vector of biases.
+   * @param incorrectClasses Index of the predicted class of each point.
+   * @param correctClasses Index of the true class of each point.
+   * @param instanceWeights Weight to be given to each point during training
+   *      (this is useful for boosting); leave empty for uniform weights.
+   */
+  template<typename MatType>
+  void UpdateWeights(const MatType& trainingPoints,
+                     arma::mat& weights,
+                     arma::vec& biases,
+                     const arma::Row<size_t>& incorrectClasses,
+                     const arma::Row<size_t>& correctClasses,
+                     const arma::rowvec& instanceWeights = arma::rowvec())
+  {
+    arma::mat coefficients(trainingPoints.n_cols, weights.n_cols,
+        arma::fill::zeros);
+    for (size_t j = 0; j < trainingPoints.n_cols; ++j)
+    {
+      const double instanceWeight = (instanceWeights.n_elem > 0) ?
+          instanceWeights(j) : 1.0;
+      coefficients(j, incorrectClasses[j]) -= instanceWeight;
+      coefficients(j, correctClasses[j]) += instanceWeight;
+    }
+
+    weights += trainingPoints * coefficients;
+    biases += arma::sum(coefficients, 0).t();
+  }
 };
 
 } // namespace perceptron
@@ -45,10 +45,13 @@ class Perceptron
    * @param dimensionality Dimensionality of the dataset.
    * @param maxIterations Maximum number of iterations for the perceptron
    *      learning algorithm.
+   * @param batchSize Number of points to process per weight update (see
+   *      BatchSize()).
    */
   Perceptron(const size_t numClasses = 0,
              const size_t dimensionality = 0,
-             const size_t maxIterations = 1000);
+             const size_t maxIterations = 1000,
+             const size_t batchSize = 1);
 
   /**
    * Constructor: constructs the perceptron by building the weights matrix,
@@ -62,11 +65,14 @@ class Perceptron
    * @param numClasses Number of classes in the dataset.
    * @param maxIterations Maximum number of iterations for the perceptron
    *      learning algorithm.
+   * @param batchSize Number of points to process per weight update (see
+   *      BatchSize()).
    */
   Perceptron(const MatType& data,
              const arma::Row<size_t>& labels,
              const size_t numClasses,
-             const size_t maxIterations = 1000);
+             const size_t maxIterations = 1000,
+             const size_t batchSize = 1);
 
   /**
    * Alternate constructor which copies parameters from an already initiated
@@ -127,6 +133,22 @@ class Perceptron
   //! Modify the maximum number of iterations.
   size_t& MaxIterations() { return maxIterations; }
 
+  //! Get the number of points processed per weight update.
+  size_t BatchSize() const { return batchSize; }
+  /**
+   * Modify the number of points processed per weight update.  With the
+   * default of 1, each point is scored and the weights are updated
+   * immediately (the classical online perceptron).  With a larger value,
+   * training runs in mini-batch epochs: the scores for a whole block of
+   * points are computed with one matrix product against the current weights,
+   * and the updates for every mistake in the block are aggregated and
+   * applied at once.  This is far faster on large datasets, but updates
+   * within a block do not see each other, so the sequence of weight vectors
+   * (and possibly the number of epochs to convergence) can differ from the
+   * online algorithm.
+   */
+  size_t& BatchSize() { return batchSize; }
+
   //! Get the number of classes this perceptron has been trained for.
   size_t NumClasses() const { return weights.n_cols; }
 
@@ -144,6 +166,9 @@ class Perceptron
   //! The maximum number of iterations during training.
   size_t maxIterations;
 
+  //! The number of points to process per weight update during training.
+  size_t batchSize;
+
   /**
    * Stores the weights for each of the input class labels.  Each column
    * corresponds to the weights for one class label, and each row corresponds to
@@ -159,6 +184,14 @@ class Perceptron
 } // namespace perceptron
 } // namespace mlpack
 
+// Version 1 adds the batch size to the serialized model.
+BOOST_TEMPLATE_CLASS_VERSION(template<typename LearnPolicy,
+                                      typename WeightInitializationPolicy,
+                                      typename MatType>,
+    mlpack::perceptron::Perceptron<LearnPolicy,
+                                   WeightInitializationPolicy,
+                                   MatType>, 1);
+
 #include "perceptron_impl.hpp"
 
 #endif
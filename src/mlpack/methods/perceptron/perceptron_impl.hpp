@@ -29,8 +29,10 @@ template<
 Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Perceptron(
     const size_t numClasses,
     const size_t dimensionality,
-    const size_t maxIterations) :
-    maxIterations(maxIterations)
+    const size_t maxIterations,
+    const size_t batchSize) :
+    maxIterations(maxIterations),
+    batchSize(batchSize)
 {
   WeightInitializationPolicy wip;
   wip.Initialize(weights, biases, dimensionality, numClasses);
@@ -55,8 +57,10 @@ Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Perceptron(
     const MatType& data,
     const arma::Row<size_t>& labels,
     const size_t numClasses,
-    const size_t maxIterations) :
-    maxIterations(maxIterations)
+    const size_t maxIterations,
+    const size_t batchSize) :
+    maxIterations(maxIterations),
+    batchSize(batchSize)
 {
   // Start training.
   Train(data, labels, numClasses);
@@ -84,7 +88,8 @@ Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Perceptron(
     const arma::Row<size_t>& labels,
     const size_t numClasses,
     const arma::rowvec& instanceWeights) :
-    maxIterations(other.maxIterations)
+    maxIterations(other.maxIterations),
+    batchSize(other.batchSize)
 {
   Train(data, labels, numClasses, instanceWeights);
 }
@@ -155,6 +160,10 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Train(
 
   const bool hasWeights = (instanceWeights.n_elem > 0);
 
+  // Reused across blocks in the mini-batch path.
+  arma::mat scores;
+  arma::Row<size_t> predictions;
+
   while ((i < maxIterations) && (!converged))
   {
     // This outer loop is for each iteration, and we use the 'converged'
@@ -162,31 +171,75 @@ void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::Train(
     ++i;
     converged = true;
 
-    // Now this inner loop is for going through the dataset in each iteration.
-    for (j = 0; j < data.n_cols; ++j)
+    if (batchSize <= 1)
     {
-      // Multiply for each variable and check whether the current weight vector
-      // correctly classifies this.
-      tempLabelMat = weights.t() * data.col(j) + biases;
+      // The classical online perceptron: update the weights after every
+      // misclassified point, so each point is scored against weights that
+      // include all previous updates of the epoch.
+      for (j = 0; j < data.n_cols; ++j)
+      {
+        // Multiply for each variable and check whether the current weight
+        // vector correctly classifies this.
+        tempLabelMat = weights.t() * data.col(j) + biases;
+
+        tempLabelMat.max(maxIndexRow, maxIndexCol);
 
-      tempLabelMat.max(maxIndexRow, maxIndexCol);
+        // Check whether prediction is correct.
+        if (maxIndexRow != labels(0, j))
+        {
+          // Due to incorrect prediction, convergence set to false.
+          converged = false;
+          tempLabel = labels(0, j);
 
-      // Check whether prediction is correct.
-      if (maxIndexRow != labels(0, j))
+          // Send maxIndexRow for knowing which weight to update, send j to
+          // know the value of the vector to update it with.  Send tempLabel
+          // to know the correct class.
+          if (hasWeights)
+            LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow,
+                tempLabel, instanceWeights(j));
+          else
+            LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow,
+                tempLabel);
+        }
+      }
+    }
+    else
+    {
+      // The mini-batch perceptron: score a whole block of points with one
+      // matrix product, then let the learning policy apply the aggregated
+      // update for every mistake in the block at once.
+      for (j = 0; j < data.n_cols; j += batchSize)
       {
-        // Due to incorrect prediction, convergence set to false.
+        const size_t lastCol = std::min(j + batchSize, (size_t) data.n_cols)
+            - 1;
+
+        scores = weights.t() * data.cols(j, lastCol);
+        scores.each_col() += biases;
+
+        predictions.set_size(scores.n_cols);
+        bool anyMistake = false;
+        for (size_t k = 0; k < scores.n_cols; ++k)
+        {
+          scores.col(k).max(maxIndexRow, maxIndexCol);
+          predictions[k] = maxIndexRow;
+          anyMistake |= (maxIndexRow != labels(0, j + k));
+        }
+
+        if (!anyMistake)
+          continue;
         converged = false;
-        tempLabel = labels(0, j);
 
-        // Send maxIndexRow for knowing which weight to update, send j to know
-        // the value of the vector to update it with.  Send tempLabel to know
-        // the correct class.
         if (hasWeights)
-          LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow, tempLabel,
-              instanceWeights(j));
+        {
+          LP.UpdateWeights(data.cols(j, lastCol), weights, biases,
+              predictions, labels.subvec(j, lastCol),
+              instanceWeights.subvec(j, lastCol));
+        }
         else
-          LP.UpdateWeights(data.col(j), weights, biases, maxIndexRow,
-              tempLabel);
+        {
+          LP.UpdateWeights(data.cols(j, lastCol), weights, biases,
+              predictions, labels.subvec(j, lastCol));
+        }
       }
     }
   }
@@ -199,13 +252,19 @@ template<typename LearnPolicy,
 template<typename Archive>
 void Perceptron<LearnPolicy, WeightInitializationPolicy, MatType>::serialize(
     Archive& ar,
-    const unsigned int /* version */)
+    const unsigned int version)
 {
   // We just need to serialize the maximum number of iterations, the weights,
   // and the biases.
   ar & BOOST_SERIALIZATION_NVP(maxIterations);
   ar & BOOST_SERIALIZATION_NVP(weights);
   ar & BOOST_SERIALIZATION_NVP(biases);
+
+  // The batch size was added in version 1.
+  if (version > 0)
+    ar & BOOST_SERIALIZATION_NVP(batchSize);
+  else if (Archive::is_loading::value)
+    batchSize = 1;
 }
 
 } // namespace perceptron
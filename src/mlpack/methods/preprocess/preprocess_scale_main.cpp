@@ -180,18 +180,29 @@ static void mlpackMain()
     }
   }
 
-  if (!IO::HasParam("inverse_scaling"))
+  const bool inverseScaling = IO::HasParam("inverse_scaling");
+  if (inverseScaling && !IO::HasParam("input_model"))
   {
-    m->Transform(input, output);
+    delete m;
+    throw std::runtime_error("Please provide a saved model.");
   }
-  else
+
+  // Transform the data in chunks of columns.  Each point is scaled
+  // independently of the others, so this produces the same result as
+  // transforming the whole matrix at once, but the temporaries created by the
+  // scaler are bounded by the chunk size instead of the dataset size.
+  const size_t chunkSize = 10000;
+  output.set_size(input.n_rows, input.n_cols);
+  arma::mat chunk, scaledChunk;
+  for (size_t begin = 0; begin < input.n_cols; begin += chunkSize)
   {
-    if (!IO::HasParam("input_model"))
-    {
-      delete m;
-      throw std::runtime_error("Please provide a saved model.");
-    }
-    m->InverseTransform(input, output);
+    const size_t end = std::min(begin + chunkSize, (size_t) input.n_cols) - 1;
+    chunk = input.cols(begin, end);
+    if (!inverseScaling)
+      m->Transform(chunk, scaledChunk);
+    else
+      m->InverseTransform(chunk, scaledChunk);
+    output.cols(begin, end) = scaledChunk;
   }
 
   // Save the output.
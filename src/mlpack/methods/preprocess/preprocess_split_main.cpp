@@ -141,41 +141,35 @@ static void mlpackMain()
   // Load the data.
   arma::mat& data = IO::GetParam<arma::mat>("input");
 
+  // Compute the split as column indices only; the requested outputs are then
+  // materialized directly from the input, so no intermediate copies of the
+  // dataset are made and outputs that were not requested are never built.
+  arma::uvec trainIndices, testIndices;
+  data::SplitIndices(data.n_cols, trainIndices, testIndices, testRatio,
+      !shuffleData);
+
+  Log::Info << "Training data contains " << trainIndices.n_elem << " points."
+      << endl;
+  Log::Info << "Test data contains " << testIndices.n_elem << " points."
+      << endl;
+
+  if (IO::HasParam("training"))
+    IO::GetParam<arma::mat>("training") = data.cols(trainIndices);
+  if (IO::HasParam("test"))
+    IO::GetParam<arma::mat>("test") = data.cols(testIndices);
+
   // If parameters for labels exist, we must split the labels too.
   if (IO::HasParam("input_labels"))
   {
     arma::Mat<size_t>& labels =
         IO::GetParam<arma::Mat<size_t>>("input_labels");
-    arma::Row<size_t> labelsRow = labels.row(0);
-
-    const auto value = data::Split(data, labelsRow, testRatio, !shuffleData);
-    Log::Info << "Training data contains " << get<0>(value).n_cols << " points."
-        << endl;
-    Log::Info << "Test data contains " << get<1>(value).n_cols << " points."
-        << endl;
-
-    if (IO::HasParam("training"))
-      IO::GetParam<arma::mat>("training") = std::move(get<0>(value));
-    if (IO::HasParam("test"))
-      IO::GetParam<arma::mat>("test") = std::move(get<1>(value));
+    const arma::Row<size_t> labelsRow = labels.row(0);
+
     if (IO::HasParam("training_labels"))
       IO::GetParam<arma::Mat<size_t>>("training_labels") =
-          std::move(get<2>(value));
+          labelsRow.cols(trainIndices);
     if (IO::HasParam("test_labels"))
       IO::GetParam<arma::Mat<size_t>>("test_labels") =
-          std::move(get<3>(value));
-  }
-  else // We have no labels, so just split the dataset.
-  {
-    const auto value = data::Split(data, testRatio, !shuffleData);
-    Log::Info << "Training data contains " << get<0>(value).n_cols << " points."
-        << endl;
-    Log::Info << "Test data contains " << get<1>(value).n_cols << " points."
-        << endl;
-
-    if (IO::HasParam("training"))
-      IO::GetParam<arma::mat>("training") = std::move(get<0>(value));
-    if (IO::HasParam("test"))
-      IO::GetParam<arma::mat>("test") = std::move(get<1>(value));
+          labelsRow.cols(testIndices);
   }
 }
@@ -0,0 +1,104 @@
+/**
+ * @file methods/quic_svd/incremental_quic_svd.cpp
+ * @author Siddharth Agrawal
+ *
+ * An incremental, block-wise variant of QUIC-SVD.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+
+// In case it hasn't been included yet.
+#include "incremental_quic_svd.hpp"
+
+using namespace mlpack::tree;
+
+namespace mlpack {
+namespace svd {
+
+IncrementalQUICSVD::IncrementalQUICSVD(const double epsilon,
+                                       const double delta) :
+    epsilon(epsilon),
+    delta(delta)
+{
+  // Nothing to do.
+}
+
+void IncrementalQUICSVD::Update(const arma::mat& columns)
+{
+  Update(columns, epsilon, delta);
+}
+
+void IncrementalQUICSVD::Update(const arma::mat& columns,
+                                const double epsilon,
+                                const double delta)
+{
+  if (columns.n_cols == 0)
+    return;
+
+  // Compute the part of the block that the current basis cannot represent.
+  arma::mat residual;
+  if (basis.n_cols > 0)
+    residual = columns - basis * (basis.t() * columns);
+  else
+    residual = columns;
+
+  // Only extend the basis when the residual exceeds the error tolerance for
+  // this update; otherwise the block is already represented well enough.
+  const double columnsNorm = arma::norm(columns, "fro");
+  if (arma::norm(residual, "fro") > epsilon * columnsNorm)
+  {
+    // Build a cosine tree on the residual alone; its basis spans the part of
+    // the block that is new to the sketch.
+    CosineTree ctree(residual, epsilon, delta);
+    arma::mat newBasis;
+    ctree.GetFinalBasis(newBasis);
+
+    // The new vectors are orthonormal among themselves but not with respect
+    // to the current basis, so orthonormalize them against it (and against
+    // each other as they are accepted), dropping vectors that vanish.
+    for (size_t i = 0; i < newBasis.n_cols; ++i)
+    {
+      arma::vec newVector = newBasis.col(i);
+      if (basis.n_cols > 0)
+        newVector -= basis * (basis.t() * newVector);
+
+      const double norm = arma::norm(newVector, 2);
+      if (norm > 1e-10)
+      {
+        basis.insert_cols(basis.n_cols, newVector / norm);
+
+        // Past columns carry no stored component along the new vector; see
+        // the class documentation.
+        if (projections.n_cols > 0)
+          projections.insert_rows(projections.n_rows,
+              arma::zeros<arma::mat>(1, projections.n_cols));
+      }
+    }
+  }
+
+  // Store the projections of the new block onto the (possibly extended)
+  // basis.
+  projections.insert_cols(projections.n_cols, basis.t() * columns);
+}
+
+void IncrementalQUICSVD::ExtractSVD(arma::mat& u,
+                                    arma::mat& v,
+                                    arma::mat& sigma)
+{
+  // The sketch approximates A as basis * projections, and the basis is
+  // orthonormal, so the SVD of the small projection matrix gives the SVD of
+  // the sketch directly.
+  arma::mat uBar, vBar;
+  arma::vec sigmaBar;
+  arma::svd_econ(uBar, sigmaBar, vBar, projections);
+
+  u = basis * uBar;
+  sigma = arma::diagmat(sigmaBar);
+  v = vBar;
+}
+
+} // namespace svd
+} // namespace mlpack
@@ -0,0 +1,129 @@
+/**
+ * @file methods/quic_svd/incremental_quic_svd.hpp
+ * @author Siddharth Agrawal
+ *
+ * An incremental, block-wise variant of QUIC-SVD.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_QUIC_SVD_INCREMENTAL_QUIC_SVD_HPP
+#define MLPACK_METHODS_QUIC_SVD_INCREMENTAL_QUIC_SVD_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/cosine_tree/cosine_tree.hpp>
+
+namespace mlpack {
+namespace svd {
+
+/**
+ * An incremental variant of QUIC-SVD that maintains a running low-rank sketch
+ * of a matrix whose columns arrive in blocks.  The sketch consists of an
+ * orthonormal subspace basis and the projections of every ingested column
+ * onto that basis.
+ *
+ * When a block of columns arrives, the part of the block that the current
+ * basis cannot represent (its residual) is measured.  If the residual is
+ * larger than the error tolerance, a cosine tree is built on the residual
+ * alone -- not on all of the data seen so far -- and its basis vectors are
+ * orthonormalized against the current basis and appended to it; so the cost
+ * of an update scales with the block, never with the stream.  The epsilon and
+ * delta parameters of the cosine tree construction may be overridden per
+ * update to trade accuracy against update time for individual blocks.
+ *
+ * Because only projections of past columns are kept, components of old
+ * columns along basis vectors added later are not recovered; those components
+ * are below the error tolerance that was in effect when the columns were
+ * ingested, which is the usual approximation of a streaming sketch.
+ *
+ * An example of how to use the interface is shown below:
+ *
+ * @code
+ * IncrementalQUICSVD svd(0.03, 0.1);
+ *
+ * arma::mat block;
+ * while (GetNextBlock(block))  // Columns of the stream.
+ *   svd.Update(block);
+ *
+ * arma::mat u, v, sigma;
+ * svd.ExtractSVD(u, v, sigma);  // SVD of all ingested columns.
+ * @endcode
+ */
+class IncrementalQUICSVD
+{
+ public:
+  /**
+   * Construct an empty sketch.  No work is done until the first call to
+   * Update().
+   *
+   * @param epsilon Default error tolerance fraction for the subspace.
+   * @param delta Default cumulative probability for the Monte Carlo error
+   *    lower bound used during cosine tree construction.
+   */
+  IncrementalQUICSVD(const double epsilon = 0.03, const double delta = 0.1);
+
+  /**
+   * Ingest a block of columns using the default epsilon and delta.
+   *
+   * @param columns Block of new columns of the matrix.
+   */
+  void Update(const arma::mat& columns);
+
+  /**
+   * Ingest a block of columns, overriding the error parameters for this
+   * update only.  A looser epsilon makes the update cheaper and grows the
+   * basis more slowly; a tighter one does the opposite.
+   *
+   * @param columns Block of new columns of the matrix.
+   * @param epsilon Error tolerance fraction for this update.
+   * @param delta Cumulative probability for the Monte Carlo error lower bound
+   *    for this update.
+   */
+  void Update(const arma::mat& columns,
+              const double epsilon,
+              const double delta);
+
+  /**
+   * Calculate the approximate SVD of all ingested columns from the sketch.
+   * The factorization satisfies u * sigma * v.t() ~ A, where A holds the
+   * ingested columns in arrival order.
+   *
+   * @param u First unitary matrix.
+   * @param v Second unitary matrix.
+   * @param sigma Diagonal matrix of singular values.
+   */
+  void ExtractSVD(arma::mat& u, arma::mat& v, arma::mat& sigma);
+
+  //! Get the orthonormal basis of the sketch subspace.
+  const arma::mat& Basis() const { return basis; }
+
+  //! Get the projections of the ingested columns onto the basis.
+  const arma::mat& ProjectedColumns() const { return projections; }
+
+  //! Get the default error tolerance fraction.
+  double Epsilon() const { return epsilon; }
+  //! Modify the default error tolerance fraction.
+  double& Epsilon() { return epsilon; }
+
+  //! Get the default Monte Carlo probability parameter.
+  double Delta() const { return delta; }
+  //! Modify the default Monte Carlo probability parameter.
+  double& Delta() { return delta; }
+
+ private:
+  //! Default error tolerance fraction for the subspace.
+  double epsilon;
+  //! Default cumulative probability for the Monte Carlo error lower bound.
+  double delta;
+  //! Orthonormal basis of the sketch subspace (one column per basis vector).
+  arma::mat basis;
+  //! Projections of the ingested columns onto the basis.
+  arma::mat projections;
+};
+
+} // namespace svd
+} // namespace mlpack
+
+#endif
@@ -24,12 +24,14 @@ Radical::Radical(const double noiseStdDev,
                  const size_t replicates,
                  const size_t angles,
                  const size_t sweeps,
-                 const size_t m) :
+                 const size_t m,
+                 const size_t coarseSample) :
     noiseStdDev(noiseStdDev),
     replicates(replicates),
     angles(angles),
     sweeps(sweeps),
-    m(m)
+    m(m),
+    coarseSample(coarseSample)
 {
   // Nothing to do here.
 }
@@ -66,26 +68,29 @@ double Radical::Vasicek(vec& z) const
 }
 
 
-double Radical::DoRadical2D(const mat& matX)
+double Radical::ScanAngles(const mat& points,
+                           const double thetaLo,
+                           const double thetaHi) const
 {
-  CopyAndPerturb(perturbed, matX);
-
-  mat::fixed<2, 2> matJacobi;
-
   vec values(angles);
 
-  for (size_t i = 0; i < angles; ++i)
+  // Each angle is evaluated independently and writes only its own entry of
+  // values, so the evaluations run in parallel.  The candidate matrix has to
+  // be local to the iteration for that.
+  #pragma omp parallel for schedule(static)
+  for (omp_size_t i = 0; i < (omp_size_t) angles; ++i)
   {
-    const double theta = (i / (double) angles) * M_PI / 2.0;
+    const double theta = thetaLo + (i / (double) angles) * (thetaHi - thetaLo);
     const double cosTheta = cos(theta);
     const double sinTheta = sin(theta);
 
+    mat::fixed<2, 2> matJacobi;
     matJacobi(0, 0) = cosTheta;
     matJacobi(1, 0) = -sinTheta;
     matJacobi(0, 1) = sinTheta;
     matJacobi(1, 1) = cosTheta;
 
-    candidate = perturbed * matJacobi;
+    mat candidate = points * matJacobi;
     vec candidateY1 = candidate.unsafe_col(0);
     vec candidateY2 = candidate.unsafe_col(1);
 
@@ -94,7 +99,30 @@ double Radical::DoRadical2D(const mat& matX)
 
   uword indOpt = 0;
   values.min(indOpt); // we ignore the return value; we don't care about it
-  return (indOpt / (double) angles) * M_PI / 2.0;
+  return thetaLo + (indOpt / (double) angles) * (thetaHi - thetaLo);
+}
+
+
+double Radical::DoRadical2D(const mat& matX)
+{
+  CopyAndPerturb(perturbed, matX);
+
+  // Coarse-to-fine search: scan the whole quarter-turn on an evenly spaced
+  // subsample of the replicates first, then rescan the full replicates only
+  // on the interval around the coarse optimum (one coarse grid step to each
+  // side).  The sample must stay large enough for the m-spacing estimator.
+  if (coarseSample > m && coarseSample < perturbed.n_rows)
+  {
+    const uvec rows = linspace<uvec>(0, perturbed.n_rows - 1, coarseSample);
+    const mat sampled = perturbed.rows(rows);
+
+    const double step = (M_PI / 2.0) / angles;
+    const double thetaCoarse = ScanAngles(sampled, 0.0, M_PI / 2.0);
+
+    return ScanAngles(perturbed, thetaCoarse - step, thetaCoarse + step);
+  }
+
+  return ScanAngles(perturbed, 0.0, M_PI / 2.0);
 }
 
 
@@ -55,12 +55,17 @@ class Radical
    * @param sweeps Number of sweeps.  Each sweep calls Radical2D once for each
    *    pair of dimensions
    * @param m The variable m from Vasicek's m-spacing estimator of entropy.
+   * @param coarseSample Number of subsampled replicates to use for a coarse
+   *    angle scan in Radical2D; the full replicates are then rescanned only on
+   *    the interval around the coarse optimum.  If 0 (the default), every
+   *    angle is evaluated on the full replicates.
    */
   Radical(const double noiseStdDev = 0.175,
           const size_t replicates = 30,
           const size_t angles = 150,
           const size_t sweeps = 0,
-          const size_t m = 0);
+          const size_t m = 0,
+          const size_t coarseSample = 0);
 
   /**
    * Run RADICAL.
@@ -111,7 +116,28 @@ class Radical
   //! Modify the number of sweeps.
   size_t& Sweeps() { return sweeps; }
 
+  //! Get the number of subsampled replicates used for the coarse angle scan
+  //! (0 means every angle is evaluated on the full replicates).
+  size_t CoarseSample() const { return coarseSample; }
+  //! Modify the number of subsampled replicates used for the coarse angle
+  //! scan.
+  size_t& CoarseSample() { return coarseSample; }
+
  private:
+  /**
+   * Evaluate the two-dimensional entropy objective at equally spaced rotation
+   * angles in [thetaLo, thetaHi) and return the angle with the smallest
+   * objective value.  Each angle is evaluated independently, so the
+   * evaluations run in parallel.
+   *
+   * @param points Two-column matrix of (perturbed) points to rotate.
+   * @param thetaLo Lower end of the angle interval.
+   * @param thetaHi Upper end of the angle interval.
+   */
+  double ScanAngles(const arma::mat& points,
+                    const double thetaLo,
+                    const double thetaHi) const;
+
   //! Standard deviation of the Gaussian noise added to the replicates of
   //! the data points during Radical2D.
   double noiseStdDev;
@@ -129,10 +155,12 @@ class Radical
   //! Value of m to use for Vasicek's m-spacing estimator of entropy.
   size_t m;
 
+  //! Number of subsampled replicates used for the coarse angle scan (0 means
+  //! every angle is evaluated on the full replicates).
+  size_t coarseSample;
+
   //! Internal matrix, held as member variable to prevent memory reallocations.
   arma::mat perturbed;
-  //! Internal matrix, held as member variable to prevent memory reallocations.
-  arma::mat candidate;
 };
 
 void WhitenFeatureMajorMatrix(const arma::mat& matX,
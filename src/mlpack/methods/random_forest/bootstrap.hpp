@@ -16,6 +16,17 @@
 namespace mlpack {
 namespace tree {
 
+/**
+ * Sample the point indices of a bootstrap: `count` indices drawn uniformly at
+ * random with replacement.  Callers can gather the sampled columns directly
+ * from a shared dataset (e.g. with `dataset.cols(indices)`), so the only
+ * per-bootstrap allocation is the gathered sample itself.
+ */
+inline arma::uvec BootstrapIndices(const size_t count)
+{
+  return arma::randi<arma::uvec>(count, arma::distr_param(0, count - 1));
+}
+
 /**
  * Given a dataset, create another dataset via bootstrap sampling, with labels.
  */
@@ -30,21 +41,13 @@ void Bootstrap(const MatType& dataset,
                LabelsType& bootstrapLabels,
                WeightsType& bootstrapWeights)
 {
-  bootstrapDataset.set_size(dataset.n_rows, dataset.n_cols);
-  bootstrapLabels.set_size(labels.n_elem);
+  // Random sampling with replacement, done as one gather per object instead
+  // of a column-by-column copy loop.
+  const arma::uvec indices = BootstrapIndices(dataset.n_cols);
+  bootstrapDataset = dataset.cols(indices);
+  bootstrapLabels = labels.cols(indices);
   if (UseWeights)
-    bootstrapWeights.set_size(weights.n_elem);
-
-  // Random sampling with replacement.
-  arma::uvec indices = arma::randi<arma::uvec>(dataset.n_cols,
-      arma::distr_param(0, dataset.n_cols - 1));
-  for (size_t i = 0; i < dataset.n_cols; ++i)
-  {
-    bootstrapDataset.col(i) = dataset.col(indices[i]);
-    bootstrapLabels[i] = labels[indices[i]];
-    if (UseWeights)
-      bootstrapWeights[i] = weights[indices[i]];
-  }
+    bootstrapWeights = weights.cols(indices);
 }
 
 } // namespace tree
@@ -0,0 +1,133 @@
+/**
+ * @file methods/random_forest/flat_forest.hpp
+ * @author Ryan Curtin
+ *
+ * Definition of the FlatForest class, a flattened structure-of-arrays
+ * prediction engine for trained decision tree ensembles.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_FLAT_FOREST_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_FLAT_FOREST_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * The FlatForest is a read-only prediction engine compiled from a trained
+ * RandomForest (or any ensemble exposing NumTrees() and Tree()).  Compile()
+ * flattens every tree into contiguous arrays of split dimensions, thresholds,
+ * and child offsets, with sibling pairs stored adjacently.  Classify() then
+ * advances all query points through one tree level per sweep in a tight loop
+ * over these arrays, instead of recursively chasing heap-allocated child
+ * pointers per point, which makes batch scoring of large datasets cache- and
+ * branch-friendly.
+ *
+ * Only forests whose internal nodes are binary numeric splits (the default
+ * BestBinaryNumericSplit, or HistogramNumericSplit) can be compiled; forests
+ * trained with categorical dimensions via a data::DatasetInfo are not
+ * supported.  The compiled forest is a snapshot: if the source forest is
+ * retrained, Compile() must be called again.
+ *
+ * @tparam ForestType The type of the ensemble to compile (e.g.
+ *     RandomForest<>).
+ */
+template<typename ForestType>
+class FlatForest
+{
+ public:
+  //! Allow access to the underlying decision tree type.
+  typedef typename ForestType::DecisionTreeType DecisionTreeType;
+
+  /**
+   * Construct an empty FlatForest.  Classify() will throw an exception until
+   * Compile() is called.
+   */
+  FlatForest() : numClasses(0) { }
+
+  /**
+   * Construct a FlatForest by compiling the given trained forest.
+   *
+   * @param forest Trained forest to compile.
+   */
+  explicit FlatForest(const ForestType& forest);
+
+  /**
+   * Compile the given trained forest into flattened node arrays, replacing
+   * any previously compiled forest.  If the forest is not trained or contains
+   * a split that is not a binary numeric split, a std::invalid_argument
+   * exception is thrown.
+   *
+   * @param forest Trained forest to compile.
+   */
+  void Compile(const ForestType& forest);
+
+  /**
+   * Predict the classes of each point in the given dataset.  If no forest has
+   * been compiled, this will throw an exception.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions) const;
+
+  /**
+   * Predict the classes of each point in the given dataset, also returning
+   * the predicted class probabilities for each point.  The results are
+   * identical to those of the source forest's Classify().  If no forest has
+   * been compiled, this will throw an exception.
+   *
+   * @param data Dataset to be classified.
+   * @param predictions Output predictions for each point in the dataset.
+   * @param probabilities Output matrix of class probabilities for each point.
+   */
+  template<typename MatType>
+  void Classify(const MatType& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+  //! Get the number of trees in the compiled forest.
+  size_t NumTrees() const { return treeRoots.size(); }
+
+  //! Get the total number of nodes in the compiled forest.
+  size_t NumNodes() const { return leftChildren.n_elem; }
+
+  //! Get the number of classes in the compiled forest.
+  size_t NumClasses() const { return numClasses; }
+
+ private:
+  //! The number of classes in the compiled forest.
+  size_t numClasses;
+  //! The node index of each tree's root.
+  std::vector<size_t> treeRoots;
+
+  // Structure-of-arrays node storage, with all trees concatenated.  A node's
+  // children are stored adjacently, so the right child is always the left
+  // child plus one.  A left child index of zero marks a leaf (no node other
+  // than the first tree's root can ever be a child).
+  //! For an internal node, the dimension it splits on; for a leaf, the column
+  //! of its class probabilities in leafProbabilities.
+  arma::uvec splitDimensions;
+  //! For an internal node, the split threshold (points with a value less than
+  //! or equal to it go to the left child).
+  arma::vec thresholds;
+  //! The index of each node's left child, or zero for a leaf.
+  arma::uvec leftChildren;
+  //! The class probabilities of each leaf, one column per leaf.
+  arma::mat leafProbabilities;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "flat_forest_impl.hpp"
+
+#endif
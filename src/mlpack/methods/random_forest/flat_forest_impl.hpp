@@ -0,0 +1,185 @@
+/**
+ * @file methods/random_forest/flat_forest_impl.hpp
+ * @author Ryan Curtin
+ *
+ * Implementation of the FlatForest prediction engine.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RANDOM_FOREST_FLAT_FOREST_IMPL_HPP
+#define MLPACK_METHODS_RANDOM_FOREST_FLAT_FOREST_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "flat_forest.hpp"
+
+#include <queue>
+
+namespace mlpack {
+namespace tree {
+
+template<typename ForestType>
+FlatForest<ForestType>::FlatForest(const ForestType& forest)
+{
+  Compile(forest);
+}
+
+template<typename ForestType>
+void FlatForest<ForestType>::Compile(const ForestType& forest)
+{
+  if (forest.NumTrees() == 0)
+  {
+    throw std::invalid_argument("FlatForest::Compile(): no random forest "
+        "trained!");
+  }
+
+  numClasses = forest.Tree(0).NumClasses();
+  treeRoots.resize(forest.NumTrees());
+
+  // First pass: count nodes and leaves, so that the flattened arrays can be
+  // allocated exactly once.
+  size_t numNodes = 0;
+  size_t numLeaves = 0;
+  std::vector<const DecisionTreeType*> stack;
+  for (size_t t = 0; t < forest.NumTrees(); ++t)
+  {
+    stack.push_back(&forest.Tree(t));
+    while (!stack.empty())
+    {
+      const DecisionTreeType* node = stack.back();
+      stack.pop_back();
+
+      ++numNodes;
+      if (node->NumChildren() == 0)
+        ++numLeaves;
+      for (size_t c = 0; c < node->NumChildren(); ++c)
+        stack.push_back(&node->Child(c));
+    }
+  }
+
+  splitDimensions.set_size(numNodes);
+  thresholds.set_size(numNodes);
+  leftChildren.set_size(numNodes);
+  leafProbabilities.set_size(numClasses, numLeaves);
+
+  // Second pass: flatten each tree in breadth-first order, assigning sibling
+  // pairs adjacent indices so that the right child is always the left child
+  // plus one.
+  size_t nextNode = 0;
+  size_t nextLeaf = 0;
+  std::queue<std::pair<const DecisionTreeType*, size_t>> queue;
+  for (size_t t = 0; t < forest.NumTrees(); ++t)
+  {
+    treeRoots[t] = nextNode;
+    queue.emplace(&forest.Tree(t), nextNode++);
+    while (!queue.empty())
+    {
+      const DecisionTreeType* node = queue.front().first;
+      const size_t index = queue.front().second;
+      queue.pop();
+
+      if (node->NumChildren() == 0)
+      {
+        // For a leaf, the split dimension slot holds the index of the leaf's
+        // class probability column instead.
+        leftChildren[index] = 0;
+        splitDimensions[index] = nextLeaf;
+        thresholds[index] = 0.0;
+        leafProbabilities.col(nextLeaf) = node->ClassProbabilities();
+        ++nextLeaf;
+      }
+      else
+      {
+        if (node->NumChildren() != 2 || node->ClassProbabilities().n_elem != 1)
+        {
+          throw std::invalid_argument("FlatForest::Compile(): only binary "
+              "numeric splits are supported!");
+        }
+
+        splitDimensions[index] = node->SplitDimension();
+        thresholds[index] = node->ClassProbabilities()[0];
+        leftChildren[index] = nextNode;
+        queue.emplace(&node->Child(0), nextNode);
+        queue.emplace(&node->Child(1), nextNode + 1);
+        nextNode += 2;
+      }
+    }
+  }
+}
+
+template<typename ForestType>
+template<typename MatType>
+void FlatForest<ForestType>::Classify(const MatType& data,
+                                      arma::Row<size_t>& predictions) const
+{
+  arma::mat probabilities;
+  Classify(data, predictions, probabilities);
+}
+
+template<typename ForestType>
+template<typename MatType>
+void FlatForest<ForestType>::Classify(const MatType& data,
+                                      arma::Row<size_t>& predictions,
+                                      arma::mat& probabilities) const
+{
+  // Check edge case.
+  if (leftChildren.n_elem == 0)
+  {
+    predictions.clear();
+    probabilities.clear();
+
+    throw std::invalid_argument("FlatForest::Classify(): no compiled forest "
+        "available!");
+  }
+
+  probabilities.zeros(numClasses, data.n_cols);
+  arma::uvec positions(data.n_cols);
+  for (size_t t = 0; t < treeRoots.size(); ++t)
+  {
+    positions.fill(treeRoots[t]);
+
+    // Advance every point one tree level per sweep.  Each sweep is a tight
+    // loop over the flattened arrays with no pointer chasing, and points that
+    // have already reached a leaf are skipped.
+    bool anyInternal = true;
+    while (anyInternal)
+    {
+      anyInternal = false;
+      #pragma omp parallel for reduction(||: anyInternal)
+      for (omp_size_t i = 0; i < data.n_cols; ++i)
+      {
+        const size_t node = positions[i];
+        const size_t left = leftChildren[node];
+        if (left == 0)
+          continue; // This point is already at a leaf.
+
+        const size_t child = (data(splitDimensions[node], i) <=
+            thresholds[node]) ? left : left + 1;
+        positions[i] = child;
+        anyInternal = anyInternal || (leftChildren[child] != 0);
+      }
+    }
+
+    // Accumulate this tree's leaf probabilities for every point.
+    for (size_t i = 0; i < data.n_cols; ++i)
+      probabilities.col(i) += leafProbabilities.col(splitDimensions[positions[i]]);
+  }
+
+  // Renormalize the probabilities and take the maximum for each point, as
+  // RandomForest::Classify() does.
+  probabilities /= treeRoots.size();
+  predictions.set_size(data.n_cols);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    arma::uword maxIndex = 0;
+    probabilities.unsafe_col(i).max(maxIndex);
+    predictions[i] = (size_t) maxIndex;
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -471,42 +471,51 @@ double RandomForest<
   for (omp_size_t i = 0; i < numTrees; ++i)
   {
     Timer::Start("bootstrap");
-    MatType bootstrapDataset;
-    arma::Row<size_t> bootstrapLabels;
+    // Index-based bootstrap: sample point indices and gather the tree's
+    // training set directly from the shared dataset, which all threads read
+    // concurrently.
+    const arma::uvec bootstrapIndices = BootstrapIndices(dataset.n_cols);
+    MatType bootstrapDataset = dataset.cols(bootstrapIndices);
+    arma::Row<size_t> bootstrapLabels = labels.cols(bootstrapIndices);
     arma::rowvec bootstrapWeights;
-    Bootstrap<UseWeights>(dataset, labels, weights, bootstrapDataset,
-        bootstrapLabels, bootstrapWeights);
+    if (UseWeights)
+      bootstrapWeights = weights.cols(bootstrapIndices);
     Timer::Stop("bootstrap");
 
-    // Now build the decision tree.
+    // Now build the decision tree.  The gathered objects are moved into the
+    // trainer (which rearranges its copy of the data in place), so each tree
+    // allocates exactly one transient dataset.
     Timer::Start("train_tree");
     if (UseWeights)
     {
       if (UseDatasetInfo)
       {
-        avgGain += trees[i].Train(bootstrapDataset, datasetInfo,
-            bootstrapLabels, numClasses, bootstrapWeights, minimumLeafSize,
-            minimumGainSplit, maximumDepth, dimensionSelector);
+        avgGain += trees[i].Train(std::move(bootstrapDataset), datasetInfo,
+            std::move(bootstrapLabels), numClasses,
+            std::move(bootstrapWeights), minimumLeafSize, minimumGainSplit,
+            maximumDepth, dimensionSelector);
       }
       else
       {
-        avgGain += trees[i].Train(bootstrapDataset, bootstrapLabels, numClasses,
-            bootstrapWeights, minimumLeafSize, minimumGainSplit, maximumDepth,
-            dimensionSelector);
+        avgGain += trees[i].Train(std::move(bootstrapDataset),
+            std::move(bootstrapLabels), numClasses,
+            std::move(bootstrapWeights), minimumLeafSize, minimumGainSplit,
+            maximumDepth, dimensionSelector);
       }
     }
     else
     {
       if (UseDatasetInfo)
       {
-        avgGain += trees[i].Train(bootstrapDataset, datasetInfo,
-            bootstrapLabels, numClasses, minimumLeafSize, minimumGainSplit,
-            maximumDepth, dimensionSelector);
+        avgGain += trees[i].Train(std::move(bootstrapDataset), datasetInfo,
+            std::move(bootstrapLabels), numClasses, minimumLeafSize,
+            minimumGainSplit, maximumDepth, dimensionSelector);
       }
       else
       {
-        avgGain += trees[i].Train(bootstrapDataset, bootstrapLabels, numClasses,
-            minimumLeafSize, minimumGainSplit, maximumDepth, dimensionSelector);
+        avgGain += trees[i].Train(std::move(bootstrapDataset),
+            std::move(bootstrapLabels), numClasses, minimumLeafSize,
+            minimumGainSplit, maximumDepth, dimensionSelector);
       }
     }
     Timer::Stop("train_tree");
@@ -231,6 +231,88 @@ class RandomizedSVD
     }
   }
 
+  /**
+   * Apply the randomized SVD to a matrix that should only be read in bounded,
+   * sequential pieces -- typically an arma::mat constructed over a
+   * memory-mapped file with the advanced (no-copy) constructor.  Every
+   * product with the matrix is computed as one sequential sweep over blocks
+   * of blockCols columns, with the per-block GEMMs running in parallel, so
+   * only O(n_rows x blockCols) of the matrix has to be resident at a time.
+   * With maxIterations set to 0 the whole factorization reads the matrix
+   * exactly twice; every power iteration adds two more passes.
+   *
+   * No centering is applied; the matrix is factored as provided.
+   *
+   * @param data Data matrix; only read block-wise.
+   * @param u First unitary matrix.
+   * @param v Second unitary matrix.
+   * @param s Diagonal "Sigma" matrix of singular values.
+   * @param rank Rank of the approximation.
+   * @param blockCols Number of columns read per block.
+   */
+  template<typename MatType>
+  void ApplyBlocked(const MatType& data,
+                    arma::mat& u,
+                    arma::vec& s,
+                    arma::mat& v,
+                    const size_t rank,
+                    const size_t blockCols = 4096)
+  {
+    if (iteratedPower == 0)
+      iteratedPower = rank + 2;
+
+    arma::mat Q, lower;
+
+    // Apply the data matrix to a random matrix, obtaining Q; this is the
+    // first pass over the data.
+    {
+      const arma::mat R = arma::randn<arma::mat>(data.n_cols, iteratedPower);
+      BlockedProduct(data, R, Q, blockCols);
+    }
+
+    // Form a matrix Q whose columns constitute a well-conditioned basis for
+    // the columns of the earlier Q.
+    if (maxIterations == 0)
+    {
+      arma::qr_econ(Q, lower, Q);
+    }
+    else
+    {
+      arma::lu(Q, lower, Q);
+    }
+
+    // Perform normalized power iterations; each costs two passes.
+    for (size_t i = 0; i < maxIterations; ++i)
+    {
+      arma::mat Z;
+      BlockedTransProduct(data, Q, Z, blockCols);
+      arma::lu(Z, lower, Z);
+      BlockedProduct(data, Z, Q, blockCols);
+
+      // As in Apply(), the cheaper LU renormalization is used everywhere but
+      // the last iteration, where a QR decomposition makes Q orthonormal.
+      if (i < (maxIterations - 1))
+      {
+        arma::lu(Q, lower, Q);
+      }
+      else
+      {
+        arma::qr_econ(Q, lower, Q);
+      }
+    }
+
+    // Project the data onto Q in one last pass; the transposed projection
+    // (data^T * Q) is small in its second dimension, and its economical SVD
+    // yields the factors of the data:  with data^T Q = U1 S V1^T we have
+    // data ~ Q Q^T data = (Q V1) S U1^T.
+    arma::mat projection, U1, V1;
+    BlockedTransProduct(data, Q, projection, blockCols);
+
+    arma::svd_econ(U1, s, V1, projection);
+    u = Q * V1;
+    v = U1;
+  }
+
   //! Get the size of the normalized power iterations.
   size_t IteratedPower() const { return iteratedPower; }
   //! Modify the size of the normalized power iterations.
@@ -247,6 +329,62 @@ class RandomizedSVD
   double& Epsilon() { return eps; }
 
  private:
+  /**
+   * Compute out = data * other as one sequential sweep over column blocks of
+   * the data, so that only one block has to be resident at a time.  The
+   * per-block products are accumulated in parallel.
+   */
+  template<typename MatType>
+  void BlockedProduct(const MatType& data,
+                      const arma::mat& other,
+                      arma::mat& out,
+                      const size_t blockCols) const
+  {
+    const size_t numBlocks = (data.n_cols + blockCols - 1) / blockCols;
+
+    out.zeros(data.n_rows, other.n_cols);
+    #pragma omp parallel
+    {
+      arma::mat local(data.n_rows, other.n_cols, arma::fill::zeros);
+
+      #pragma omp for schedule(static) nowait
+      for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+      {
+        const size_t begin = (size_t) block * blockCols;
+        const size_t end = std::min(begin + blockCols, (size_t) data.n_cols);
+
+        local += data.cols(begin, end - 1) * other.rows(begin, end - 1);
+      }
+
+      #pragma omp critical (RandomizedSVDBlockedProduct)
+      out += local;
+    }
+  }
+
+  /**
+   * Compute out = data.t() * other as one sequential sweep over column blocks
+   * of the data.  Each block produces a disjoint set of output rows, so the
+   * blocks run in parallel without accumulation.
+   */
+  template<typename MatType>
+  void BlockedTransProduct(const MatType& data,
+                           const arma::mat& other,
+                           arma::mat& out,
+                           const size_t blockCols) const
+  {
+    const size_t numBlocks = (data.n_cols + blockCols - 1) / blockCols;
+
+    out.set_size(data.n_cols, other.n_cols);
+    #pragma omp parallel for schedule(static)
+    for (omp_size_t block = 0; block < (omp_size_t) numBlocks; ++block)
+    {
+      const size_t begin = (size_t) block * blockCols;
+      const size_t end = std::min(begin + blockCols, (size_t) data.n_cols);
+
+      out.rows(begin, end - 1) = data.cols(begin, end - 1).t() * other;
+    }
+  }
+
   //! Locally stored size of the normalized power iterations.
   size_t iteratedPower;
 
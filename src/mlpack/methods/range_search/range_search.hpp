@@ -185,6 +185,34 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
 
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, returning the results in a compact CSR-style layout instead of
+   * a vector of vectors: the neighbor indices and distances for query point i
+   * are stored at positions offsets[i] up to (but not including)
+   * offsets[i + 1] of the flat neighbors and distances arrays.  offsets has
+   * one element per query point plus one; its last element is the total
+   * number of results.
+   *
+   * This layout stores all results in three contiguous arrays, which is much
+   * friendlier to downstream consumers that iterate over many neighbor lists
+   * than the vector-of-vectors output.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param offsets Vector to store the per-query offsets into the flat result
+   *      arrays in.
+   * @param neighbors Flat vector to store the indices of all points which
+   *      fell into the given range, grouped by query point.
+   * @param distances Flat vector to store the distances corresponding to the
+   *      indices in neighbors.
+   */
+  void Search(const MatType& querySet,
+              const math::Range& range,
+              arma::uvec& offsets,
+              arma::uvec& neighbors,
+              arma::vec& distances);
+
   /**
    * Given a pre-built query tree, search for all reference points in the given
    * range for each point in the query set, returning the results in the
@@ -259,6 +287,25 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
 
+  /**
+   * Search for all points in the given range for each point in the reference
+   * set (so the query set and the reference set are the same), returning the
+   * results in the compact CSR-style layout described in the other
+   * offsets-based overload of Search().
+   *
+   * @param range Range of distances in which to search.
+   * @param offsets Vector to store the per-query offsets into the flat result
+   *      arrays in.
+   * @param neighbors Flat vector to store the indices of all points which
+   *      fell into the given range, grouped by query point.
+   * @param distances Flat vector to store the distances corresponding to the
+   *      indices in neighbors.
+   */
+  void Search(const math::Range& range,
+              arma::uvec& offsets,
+              arma::uvec& neighbors,
+              arma::vec& distances);
+
   //! Get whether single-tree search is being used.
   bool SingleMode() const { return singleMode; }
   //! Modify whether single-tree search is being used.
@@ -285,6 +332,23 @@ class RangeSearch
   Tree* ReferenceTree() { return referenceTree; }
 
  private:
+  /**
+   * Flatten vector-of-vectors search results into the CSR-style layout.  The
+   * per-query input vectors are released as they are copied, so the peak
+   * memory overhead of the conversion is one query's results.
+   *
+   * @param tempNeighbors Per-query neighbor lists; emptied by this call.
+   * @param tempDistances Per-query distance lists; emptied by this call.
+   * @param offsets Vector to store the per-query offsets in.
+   * @param neighbors Flat vector to store all neighbor indices in.
+   * @param distances Flat vector to store all distances in.
+   */
+  static void FlattenResults(std::vector<std::vector<size_t>>& tempNeighbors,
+                             std::vector<std::vector<double>>& tempDistances,
+                             arma::uvec& offsets,
+                             arma::uvec& neighbors,
+                             arma::vec& distances);
+
   //! Mappings to old reference indices (used when this object builds trees).
   std::vector<size_t> oldFromNewReferences;
   //! Reference tree.
@@ -319,4 +383,17 @@ class RangeSearch
 // Include implementation.
 #include "range_search_impl.hpp"
 
+namespace mlpack {
+namespace range {
+
+// The most common configurations are compiled once into the mlpack library
+// (see range_search_instantiations.cpp); these declarations keep other
+// translation units from instantiating them again.
+extern template class RangeSearch<metric::EuclideanDistance>;
+extern template class RangeSearch<metric::EuclideanDistance, arma::mat,
+    tree::BallTree>;
+
+} // namespace range
+} // namespace mlpack
+
 #endif
@@ -330,29 +330,45 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
   if (naive)
   {
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
-
-    // The naive brute-force solution.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
+    // Each query point writes only to its own result lists, so the queries
+    // can run in parallel.  Each thread needs its own rules object, because
+    // the rules cache the last base case computed.
+    #pragma omp parallel
+    {
+      RuleType rules(*referenceSet, querySet, range, *neighborPtr,
+          *distancePtr, metric);
+
+      // The naive brute-force solution.
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+        for (size_t j = 0; j < referenceSet->n_cols; ++j)
+          rules.BaseCase(i, j);
+    }
 
     baseCases += (querySet.n_cols * referenceSet->n_cols);
   }
   else if (singleMode)
   {
-    // Create the traverser.
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+    // As in the naive case, the per-query traversals are independent, so run
+    // them in parallel with per-thread rules and traversers; the reference
+    // tree is only read.
+    #pragma omp parallel
+    {
+      RuleType rules(*referenceSet, querySet, range, *neighborPtr,
+          *distancePtr, metric);
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+      // Now have it traverse for each point.
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
 
-    baseCases += rules.BaseCases();
-    scores += rules.Scores();
+      #pragma omp critical
+      {
+        baseCases += rules.BaseCases();
+        scores += rules.Scores();
+      }
+    }
   }
   else // Dual-tree recursion.
   {
@@ -552,33 +568,58 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
 
   // Create the helper object for the traversal.
   typedef RangeSearchRules<MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
-      *distancePtr, metric, true /* don't return the query in the results */);
+
+  baseCases = 0;
+  scores = 0;
 
   if (naive)
   {
-    // The naive brute-force solution.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
+    // Each query point writes only to its own result lists, so the queries
+    // can run in parallel with per-thread rules objects.
+    #pragma omp parallel
+    {
+      RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
+          *distancePtr, metric,
+          true /* don't return the query in the results */);
+
+      // The naive brute-force solution.
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) referenceSet->n_cols; ++i)
+        for (size_t j = 0; j < referenceSet->n_cols; ++j)
+          rules.BaseCase(i, j);
+    }
 
     baseCases = (referenceSet->n_cols * referenceSet->n_cols);
-    scores = 0;
   }
   else if (singleMode)
   {
-    // Create the traverser.
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+    // As in the naive case, the per-query traversals are independent, so run
+    // them in parallel with per-thread rules and traversers; the reference
+    // tree is only read.
+    #pragma omp parallel
+    {
+      RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
+          *distancePtr, metric,
+          true /* don't return the query in the results */);
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+      // Now have it traverse for each point.
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) referenceSet->n_cols; ++i)
+        traverser.Traverse(i, *referenceTree);
 
-    baseCases = rules.BaseCases();
-    scores = rules.Scores();
+      #pragma omp critical
+      {
+        baseCases += rules.BaseCases();
+        scores += rules.Scores();
+      }
+    }
   }
   else // Dual-tree recursion.
   {
+    RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
+        *distancePtr, metric, true /* don't return the query in the results */);
+
     // Create the traverser.
     typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
@@ -618,6 +659,79 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
   }
 }
 
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const math::Range& range,
+    arma::uvec& offsets,
+    arma::uvec& neighbors,
+    arma::vec& distances)
+{
+  std::vector<std::vector<size_t>> tempNeighbors;
+  std::vector<std::vector<double>> tempDistances;
+  Search(querySet, range, tempNeighbors, tempDistances);
+
+  FlattenResults(tempNeighbors, tempDistances, offsets, neighbors, distances);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const math::Range& range,
+    arma::uvec& offsets,
+    arma::uvec& neighbors,
+    arma::vec& distances)
+{
+  std::vector<std::vector<size_t>> tempNeighbors;
+  std::vector<std::vector<double>> tempDistances;
+  Search(range, tempNeighbors, tempDistances);
+
+  FlattenResults(tempNeighbors, tempDistances, offsets, neighbors, distances);
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::FlattenResults(
+    std::vector<std::vector<size_t>>& tempNeighbors,
+    std::vector<std::vector<double>>& tempDistances,
+    arma::uvec& offsets,
+    arma::uvec& neighbors,
+    arma::vec& distances)
+{
+  // Build the offsets array: the results for query i occupy positions
+  // [offsets[i], offsets[i + 1]) of the flat arrays.
+  offsets.set_size(tempNeighbors.size() + 1);
+  offsets[0] = 0;
+  for (size_t i = 0; i < tempNeighbors.size(); ++i)
+    offsets[i + 1] = offsets[i] + tempNeighbors[i].size();
+
+  neighbors.set_size(offsets[tempNeighbors.size()]);
+  distances.set_size(offsets[tempNeighbors.size()]);
+
+  for (size_t i = 0; i < tempNeighbors.size(); ++i)
+  {
+    std::copy(tempNeighbors[i].begin(), tempNeighbors[i].end(),
+        neighbors.begin() + offsets[i]);
+    std::copy(tempDistances[i].begin(), tempDistances[i].end(),
+        distances.begin() + offsets[i]);
+
+    // Release each per-query list as soon as it has been copied, so the peak
+    // memory overhead of the conversion is one query's results.
+    std::vector<size_t>().swap(tempNeighbors[i]);
+    std::vector<double>().swap(tempDistances[i]);
+  }
+}
+
 template<typename MetricType,
          typename MatType,
          template<typename TreeMetricType,
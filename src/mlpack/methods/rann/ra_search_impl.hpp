@@ -314,29 +314,65 @@ Search(const MatType& querySet,
   }
   else if (singleMode)
   {
-    RuleType rules(*referenceSet, querySet, k, metric, tau, alpha, naive,
-        sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
-
     // If the reference root node is a leaf, then the sampling has already been
     // done in the RASearchRules constructor.  This happens when naive = true.
     if (!referenceTree->IsLeaf())
     {
       Log::Info << "Performing single-tree traversal..." << std::endl;
 
-      // Create the traverser.
-      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+      size_t totalDistComputations = 0;
 
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+      // The queries are independent, so traverse them in parallel, with a
+      // rules object and traverser per thread: the rules hold the sampling
+      // and candidate state, so they cannot be shared.  Each query's RNG
+      // stream is seeded from its index before its traversal, so the sampled
+      // results do not depend on the number of threads or on the order in
+      // which the queries are executed.
+      #pragma omp parallel
+      {
+        RuleType rules(*referenceSet, querySet, k, metric, tau, alpha, naive,
+            sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
+        typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+
+        // Remember which queries this thread handled, so that only those
+        // columns are copied out of its results.
+        std::vector<size_t> ownQueries;
+
+        #pragma omp for schedule(dynamic)
+        for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+        {
+          rules.Rng().seed((uint32_t) i);
+          traverser.Traverse(i, *referenceTree);
+          ownQueries.push_back(i);
+        }
+
+        arma::Mat<size_t> threadNeighbors;
+        arma::mat threadDistances;
+        rules.GetResults(threadNeighbors, threadDistances);
+
+        // Each query was handled by exactly one thread, so these column
+        // writes are disjoint.
+        for (const size_t query : ownQueries)
+        {
+          neighborPtr->col(query) = threadNeighbors.col(query);
+          distancePtr->col(query) = threadDistances.col(query);
+        }
+
+        #pragma omp critical
+        totalDistComputations += rules.NumDistComputations();
+      }
 
       Log::Info << "Single-tree traversal complete." << std::endl;
       Log::Info << "Average number of distance calculations per query point: "
-          << (rules.NumDistComputations() / querySet.n_cols) << "."
+          << (totalDistComputations / querySet.n_cols) << "."
           << std::endl;
     }
-
-    rules.GetResults(*neighborPtr, *distancePtr);
+    else
+    {
+      RuleType rules(*referenceSet, querySet, k, metric, tau, alpha, naive,
+          sampleAtLeaves, firstLeafExact, singleSampleLimit, false);
+      rules.GetResults(*neighborPtr, *distancePtr);
+    }
   }
   else // Dual-tree recursion.
   {
@@ -519,42 +555,74 @@ void RASearch<SortPolicy, MetricType, MatType, TreeType>::Search(
 
   // Create the helper object for the tree traversal.
   typedef RASearchRules<SortPolicy, MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, *referenceSet, k, metric, tau, alpha, naive,
-      sampleAtLeaves, firstLeafExact, singleSampleLimit, true /* same sets */);
 
-  if (naive)
+  if (singleMode && !naive)
   {
-    // Find how many samples from the reference set we need and sample uniformly
-    // from the reference set without replacement.
-    const size_t numSamples = RAUtil::MinimumSamplesReqd(referenceSet->n_cols,
-        k, tau, alpha);
-    arma::uvec distinctSamples;
-    math::ObtainDistinctSamples(0, referenceSet->n_cols, numSamples,
-        distinctSamples);
+    // As in the separate-query-set overload, traverse the queries in
+    // parallel with per-thread rules, seeding each query's RNG stream from
+    // its index so the sampled results are reproducible regardless of the
+    // number of threads.
+    #pragma omp parallel
+    {
+      RuleType rules(*referenceSet, *referenceSet, k, metric, tau, alpha,
+          naive, sampleAtLeaves, firstLeafExact, singleSampleLimit,
+          true /* same sets */);
+      typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
 
-    // The naive brute-force solution.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
-  }
-  else if (singleMode)
-  {
-    // Create the traverser.
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+      std::vector<size_t> ownQueries;
+
+      #pragma omp for schedule(dynamic)
+      for (omp_size_t i = 0; i < (omp_size_t) referenceSet->n_cols; ++i)
+      {
+        rules.Rng().seed((uint32_t) i);
+        traverser.Traverse(i, *referenceTree);
+        ownQueries.push_back(i);
+      }
+
+      arma::Mat<size_t> threadNeighbors;
+      arma::mat threadDistances;
+      rules.GetResults(threadNeighbors, threadDistances);
 
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+      // Each query was handled by exactly one thread, so these column writes
+      // are disjoint.
+      for (const size_t query : ownQueries)
+      {
+        neighborPtr->col(query) = threadNeighbors.col(query);
+        distancePtr->col(query) = threadDistances.col(query);
+      }
+    }
   }
   else
   {
-    // Create the traverser.
-    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+    RuleType rules(*referenceSet, *referenceSet, k, metric, tau, alpha, naive,
+        sampleAtLeaves, firstLeafExact, singleSampleLimit,
+        true /* same sets */);
 
-    traverser.Traverse(*referenceTree, *referenceTree);
-  }
+    if (naive)
+    {
+      // Find how many samples from the reference set we need and sample
+      // uniformly from the reference set without replacement.
+      const size_t numSamples = RAUtil::MinimumSamplesReqd(
+          referenceSet->n_cols, k, tau, alpha);
+      arma::uvec distinctSamples;
+      math::ObtainDistinctSamples(0, referenceSet->n_cols, numSamples,
+          distinctSamples);
+
+      // The naive brute-force solution.
+      for (size_t i = 0; i < referenceSet->n_cols; ++i)
+        for (size_t j = 0; j < referenceSet->n_cols; ++j)
+          rules.BaseCase(i, j);
+    }
+    else
+    {
+      // Create the traverser.
+      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+
+      traverser.Traverse(*referenceTree, *referenceTree);
+    }
 
-  rules.GetResults(*neighborPtr, *distancePtr);
+    rules.GetResults(*neighborPtr, *distancePtr);
+  }
 
   Timer::Stop("computing_neighbors");
 
@@ -246,6 +246,12 @@ class RASearchRules
   //! mode.
   size_t MinimumBaseCases() const { return k; }
 
+  //! Get the random number generator used for sampling.  All sampling done by
+  //! this object draws from this generator, so reseeding it (for instance,
+  //! from the query index before each query's traversal) makes the sampling
+  //! deterministic.
+  std::mt19937& Rng() { return rng; }
+
  private:
   //! The reference set.
   const arma::mat& referenceSet;
@@ -301,6 +307,10 @@ class RASearchRules
   //! If the query and reference set are identical, this is true.
   bool sameSet;
 
+  //! The random number generator used for all sampling done by this object;
+  //! seeded from the global generator, but reseedable through Rng().
+  std::mt19937 rng;
+
   TraversalInfoType traversalInfo;
 
   /**
@@ -57,6 +57,49 @@ void RegularizedSVD<OptimizerType>::Apply(const arma::mat& data,
   v = parameters.submat(0, 0, rank - 1, numUsers - 1);
 }
 
+// When parallel SGD is selected, use the lock-free (HOGWILD!-style) Optimize()
+// specialization for RegularizedSVDFunction.  Each thread gets an equal share
+// of the ratings in every epoch and applies its updates without locking; this
+// is safe for matrix factorization because each rating only touches one user
+// column and one item column of the parameters.
+template<>
+inline void RegularizedSVD<ens::ParallelSGD<ens::ExponentialBackoff>>::Apply(
+    const arma::mat& data,
+    const size_t rank,
+    arma::mat& u,
+    arma::mat& v)
+{
+  // Make the optimizer object using a RegularizedSVDFunction object.
+  RegularizedSVDFunction<arma::mat> rSVDFunc(data, rank, lambda);
+
+  size_t threads = 1;
+  #ifdef HAS_OPENMP
+  threads = (size_t) omp_get_max_threads();
+  #endif
+  const size_t threadShareSize = (size_t)
+      std::ceil((double) rSVDFunc.NumFunctions() / threads);
+
+  // Back off only after the last epoch, so that the step size stays constant
+  // at alpha, matching the behavior of the serial SGD optimizer.
+  ens::ExponentialBackoff decayPolicy(iterations + 1, alpha, 0.5);
+  // The epoch counter runs from 1 to maxIterations exclusive, so add one to
+  // perform the same number of update epochs as the serial optimizer.
+  ens::ParallelSGD<ens::ExponentialBackoff> optimizer(iterations + 1,
+      threadShareSize, 1e-5, true, decayPolicy);
+
+  // Get optimized parameters.
+  arma::mat parameters = rSVDFunc.GetInitialPoint();
+  optimizer.Optimize(rSVDFunc, parameters);
+
+  // Constants for extracting user and item matrices.
+  const size_t numUsers = max(data.row(0)) + 1;
+  const size_t numItems = max(data.row(1)) + 1;
+
+  // Extract user and item matrices from the optimized parameters.
+  u = parameters.submat(0, numUsers, rank - 1, numUsers + numItems - 1).t();
+  v = parameters.submat(0, 0, rank - 1, numUsers - 1);
+}
+
 } // namespace svd
 } // namespace mlpack
 
@@ -0,0 +1,151 @@
+/**
+ * @file methods/reinforcement_learning/environment/vectorized_environment.hpp
+ * @author Shangtong Zhang
+ *
+ * This file is the implementation of VectorizedEnvironment class, which steps
+ * several copies of an environment together so that their states can be fed
+ * to the network as a single batch.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_ENVIRONMENT_VECTORIZED_ENVIRONMENT_HPP
+#define MLPACK_METHODS_RL_ENVIRONMENT_VECTORIZED_ENVIRONMENT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace rl {
+
+/**
+ * Implementation of a vectorized environment.  This maintains N independent
+ * copies of an environment and steps all of them with one call, keeping
+ * their encoded states packed into a single matrix with one column per copy.
+ * That matrix can be passed directly to the network, so one Forward()
+ * evaluates the policy for every copy at once instead of doing one network
+ * call per transition; for cheap simulations the network call dominates the
+ * cost of a step, so batching it raises the transition throughput by roughly
+ * the number of copies.
+ *
+ * Copies whose episode ends are reset automatically, so the state matrix
+ * always holds live states and stepping never has to stop for a single
+ * finished episode.
+ *
+ * A training loop can use it like this:
+ *
+ * @code
+ * VectorizedEnvironment<CartPole> envs(16);
+ * arma::mat actionValues;
+ * std::vector<CartPole::Action> actions(envs.NumEnvs());
+ * arma::rowvec rewards;
+ * arma::irowvec isTerminal;
+ * while (training)
+ * {
+ *   // One network call for all 16 copies.
+ *   network.Predict(envs.States(), actionValues);
+ *   for (size_t i = 0; i < envs.NumEnvs(); ++i)
+ *     actions[i] = policy.Sample(actionValues.col(i));
+ *   envs.Step(actions, rewards, isTerminal);
+ * }
+ * @endcode
+ *
+ * @tparam EnvironmentType The type of the reinforcement learning task.
+ */
+template<typename EnvironmentType>
+class VectorizedEnvironment
+{
+ public:
+  using StateType = typename EnvironmentType::State;
+  using ActionType = typename EnvironmentType::Action;
+
+  /**
+   * Construct a vectorized environment holding numEnvs copies of the given
+   * environment.  All copies start at an initial state.
+   *
+   * @param numEnvs Number of environment copies to maintain.
+   * @param environment The environment instance to copy.
+   */
+  VectorizedEnvironment(const size_t numEnvs,
+                        const EnvironmentType& environment = EnvironmentType())
+      : environments(numEnvs, environment),
+        states(numEnvs),
+        encodedStates(StateType::dimension, numEnvs)
+  {
+    Reset();
+  }
+
+  /**
+   * Reset every copy of the environment to an initial state.
+   */
+  void Reset()
+  {
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      states[i] = environments[i].InitialSample();
+      encodedStates.col(i) = states[i].Encode();
+    }
+  }
+
+  /**
+   * Step every copy of the environment with its corresponding action.  A
+   * copy whose episode terminates is reset to an initial state, so the state
+   * matrix returned by States() only ever contains live states.
+   *
+   * @param actions One action per environment copy.
+   * @param rewards Reward obtained by each copy for its transition.
+   * @param isTerminal Whether each copy's episode ended with this step (the
+   *        copy has already been reset if so).
+   */
+  void Step(const std::vector<ActionType>& actions,
+            arma::rowvec& rewards,
+            arma::irowvec& isTerminal)
+  {
+    rewards.set_size(environments.size());
+    isTerminal.set_size(environments.size());
+    for (size_t i = 0; i < environments.size(); ++i)
+    {
+      StateType nextState;
+      rewards(i) = environments[i].Sample(states[i], actions[i], nextState);
+      isTerminal(i) = environments[i].IsTerminal(nextState);
+      if (isTerminal(i))
+        states[i] = environments[i].InitialSample();
+      else
+        states[i] = nextState;
+      encodedStates.col(i) = states[i].Encode();
+    }
+  }
+
+  //! Get the encoded states of all copies, one column per copy.  This matrix
+  //! can be passed directly to the network for a batched prediction.
+  const arma::mat& States() const { return encodedStates; }
+
+  //! Get the current state of the given copy.
+  const StateType& State(const size_t i) const { return states[i]; }
+
+  //! Get the given environment copy.
+  const EnvironmentType& Environment(const size_t i) const
+  { return environments[i]; }
+
+  //! Modify the given environment copy.
+  EnvironmentType& Environment(const size_t i) { return environments[i]; }
+
+  //! Get the number of environment copies.
+  size_t NumEnvs() const { return environments.size(); }
+
+ private:
+  //! Locally-stored environment copies.
+  std::vector<EnvironmentType> environments;
+
+  //! Current state of each copy.
+  std::vector<StateType> states;
+
+  //! Encoded states of all copies, one column per copy.
+  arma::mat encodedStates;
+};
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
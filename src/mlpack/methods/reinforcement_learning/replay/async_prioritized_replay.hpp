@@ -0,0 +1,302 @@
+/**
+ * @file methods/reinforcement_learning/replay/async_prioritized_replay.hpp
+ * @author Xiaohong
+ *
+ * This file is an implementation of asynchronous prioritized experience
+ * replay, which prepares mini-batches on a background thread.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_RL_ASYNC_PRIORITIZED_REPLAY_HPP
+#define MLPACK_METHODS_RL_ASYNC_PRIORITIZED_REPLAY_HPP
+
+#include <mlpack/prereqs.hpp>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "prioritized_replay.hpp"
+
+namespace mlpack {
+namespace rl {
+
+/**
+ * Implementation of asynchronous prioritized experience replay.  This is a
+ * drop-in replacement for PrioritizedReplay that moves sampling and priority
+ * updates off the training thread: a background thread keeps a small queue of
+ * ready mini-batches ahead of the learner, so Sample() usually only has to
+ * pop a prepared batch and the sum-tree walk overlaps with environment
+ * stepping and the gradient step.  Priority updates are queued by Update()
+ * and applied by the background thread before it draws the next batch.
+ *
+ * Because batches are drawn ahead of time, a prefetched batch may have been
+ * sampled before the most recent transitions were stored or the most recent
+ * priorities were applied.  The queue is kept short (queueLength batches) so
+ * this staleness is bounded, and it is the usual trade-off made to overlap
+ * sampling with learning.
+ *
+ * @tparam EnvironmentType Desired task.
+ */
+template <typename EnvironmentType>
+class AsyncPrioritizedReplay
+{
+ public:
+  //! Convenient typedef for action.
+  using ActionType = typename EnvironmentType::Action;
+
+  //! Convenient typedef for state.
+  using StateType = typename EnvironmentType::State;
+
+  /**
+   * Default constructor.
+   */
+  AsyncPrioritizedReplay() :
+      queueLength(0),
+      started(false),
+      done(false)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Construct an instance of asynchronous prioritized experience replay
+   * class.
+   *
+   * @param batchSize Number of examples returned at each sample.
+   * @param capacity Total memory size in terms of number of examples.
+   * @param alpha How much prioritization is used.
+   * @param nSteps Number of steps to look in the future.
+   * @param queueLength Number of mini-batches the background thread keeps
+   *        prepared ahead of the learner.
+   * @param dimension The dimension of an encoded state.
+   */
+  AsyncPrioritizedReplay(const size_t batchSize,
+                         const size_t capacity,
+                         const double alpha,
+                         const size_t nSteps = 1,
+                         const size_t queueLength = 4,
+                         const size_t dimension = StateType::dimension) :
+      replay(batchSize, capacity, alpha, nSteps, dimension),
+      queueLength(queueLength),
+      started(false),
+      done(false)
+  { /* Nothing to do here. */ }
+
+  /**
+   * Clean up the background sampler thread.
+   */
+  ~AsyncPrioritizedReplay()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      done = true;
+    }
+    cv.notify_all();
+    if (samplerThread.joinable())
+      samplerThread.join();
+  }
+
+  /**
+   * Store the given experience and set the priorities for the given
+   * experience.
+   *
+   * @param state Given state.
+   * @param action Given action.
+   * @param reward Given reward.
+   * @param nextState Given next state.
+   * @param isEnd Whether next state is terminal state.
+   * @param discount The discount parameter.
+   */
+  void Store(StateType state,
+             ActionType action,
+             double reward,
+             StateType nextState,
+             bool isEnd,
+             const double& discount)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      replay.Store(state, action, reward, nextState, isEnd, discount);
+    }
+    cv.notify_all();
+  }
+
+  /**
+   * Get a mini-batch sampled according to the transition priorities.  The
+   * batch is taken from the queue prepared by the background thread; the
+   * thread is started on the first call.
+   *
+   * @param sampledStates Sampled encoded states.
+   * @param sampledActions Sampled actions.
+   * @param sampledRewards Sampled rewards.
+   * @param sampledNextStates Sampled encoded next states.
+   * @param isTerminal Indicate whether corresponding next state is terminal
+   *        state.
+   */
+  void Sample(arma::mat& sampledStates,
+              std::vector<ActionType>& sampledActions,
+              arma::rowvec& sampledRewards,
+              arma::mat& sampledNextStates,
+              arma::irowvec& isTerminal)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!started)
+    {
+      samplerThread = std::thread(&AsyncPrioritizedReplay::SamplerLoop, this);
+      started = true;
+    }
+
+    // Wait until the background thread has a batch ready.
+    cv.wait(lock, [this]() { return !readyBatches.empty(); });
+
+    Batch batch = std::move(readyBatches.front());
+    readyBatches.pop_front();
+
+    sampledStates = std::move(batch.states);
+    for (size_t t = 0; t < batch.actions.size(); t++)
+      sampledActions.push_back(batch.actions[t]);
+    sampledRewards = std::move(batch.rewards);
+    sampledNextStates = std::move(batch.nextStates);
+    isTerminal = std::move(batch.isTerminal);
+    lastIndices = std::move(batch.indices);
+    lastWeights = std::move(batch.weights);
+
+    lock.unlock();
+    cv.notify_all();
+  }
+
+  /**
+   * Get the number of transitions in the memory.
+   *
+   * @return Actual used memory size.
+   */
+  size_t Size()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return replay.Size();
+  }
+
+  /**
+   * Update the priorities of the transitions of the last sampled batch and
+   * update the gradients.  The new priorities are queued and applied to the
+   * sum-tree by the background thread, so the training thread does not pay
+   * for the tree update.
+   *
+   * @param target The learned value.
+   * @param sampledActions Agent's sampled action.
+   * @param nextActionValues Agent's next action.
+   * @param gradients The model's gradients.
+   */
+  void Update(arma::mat target,
+              std::vector<ActionType> sampledActions,
+              arma::mat nextActionValues,
+              arma::mat& gradients)
+  {
+    arma::colvec tdError(target.n_cols);
+    for (size_t i = 0; i < target.n_cols; i ++)
+    {
+      tdError(i) = nextActionValues(sampledActions[i].action, i) -
+          target(sampledActions[i].action, i);
+    }
+    tdError = arma::abs(tdError);
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      pendingUpdates.emplace_back(lastIndices, std::move(tdError));
+    }
+    cv.notify_all();
+
+    // Update the gradient.
+    gradients = arma::mean(lastWeights) * gradients;
+  }
+
+  //! Get the number of steps for n-step agent.
+  const size_t& NSteps() const { return replay.NSteps(); }
+
+ private:
+  //! A mini-batch prepared by the background thread, together with the
+  //! sampled indices and importance weights needed for the priority update.
+  struct Batch
+  {
+    arma::mat states;
+    std::vector<ActionType> actions;
+    arma::rowvec rewards;
+    arma::mat nextStates;
+    arma::irowvec isTerminal;
+    arma::ucolvec indices;
+    arma::rowvec weights;
+  };
+
+  /**
+   * Main loop of the background thread: apply queued priority updates, then
+   * keep the queue of ready mini-batches filled.
+   */
+  void SamplerLoop()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!done)
+    {
+      // Apply priority updates queued by the training thread.
+      while (!pendingUpdates.empty())
+      {
+        replay.UpdatePriorities(pendingUpdates.front().first,
+                                pendingUpdates.front().second);
+        pendingUpdates.pop_front();
+      }
+
+      if (readyBatches.size() >= queueLength)
+      {
+        cv.wait(lock);
+        continue;
+      }
+
+      Batch batch;
+      replay.Sample(batch.states, batch.actions, batch.rewards,
+          batch.nextStates, batch.isTerminal);
+      batch.indices = replay.SampledIndices();
+      batch.weights = replay.Weights();
+      readyBatches.push_back(std::move(batch));
+      cv.notify_all();
+    }
+  }
+
+  //! The underlying prioritized replay buffer.
+  PrioritizedReplay<EnvironmentType> replay;
+
+  //! Number of mini-batches kept prepared ahead of the learner.
+  size_t queueLength;
+
+  //! Whether the background thread has been started.
+  bool started;
+
+  //! Whether the background thread should stop.
+  bool done;
+
+  //! Mini-batches prepared by the background thread.
+  std::deque<Batch> readyBatches;
+
+  //! Priority updates waiting to be applied to the sum-tree.
+  std::deque<std::pair<arma::ucolvec, arma::colvec>> pendingUpdates;
+
+  //! Indices of the last batch returned by Sample().
+  arma::ucolvec lastIndices;
+
+  //! Importance weights of the last batch returned by Sample().
+  arma::rowvec lastWeights;
+
+  //! Mutex protecting the replay buffer and the queues.
+  std::mutex mutex;
+
+  //! Condition variable used between the learner and the background thread.
+  std::condition_variable cv;
+
+  //! The background sampler thread.
+  std::thread samplerThread;
+};
+
+} // namespace rl
+} // namespace mlpack
+
+#endif
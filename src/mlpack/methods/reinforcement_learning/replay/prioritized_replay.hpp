@@ -307,6 +307,13 @@ class PrioritizedReplay
   //! Get the number of steps for n-step agent.
   const size_t& NSteps() const { return nSteps; }
 
+  //! Get the indices of the transitions returned by the last Sample() call.
+  const arma::ucolvec& SampledIndices() const { return sampledIndices; }
+
+  //! Get the importance weights of the transitions returned by the last
+  //! Sample() call.
+  const arma::rowvec& Weights() const { return weights; }
+
  private:
   //! Locally-stored number of examples of each sample.
   size_t batchSize;
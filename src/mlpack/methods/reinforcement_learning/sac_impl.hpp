@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_RL_SAC_IMPL_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/parallel.hpp>
 
 #include "sac.hpp"
 
@@ -136,10 +137,13 @@ void SAC<
   ReplayType
 >::SoftUpdate(double rho)
 {
-  targetQ1Network.Parameters() = (1 - rho) * targetQ1Network.Parameters() +
-      rho * learningQ1Network.Parameters();
-  targetQ2Network.Parameters() = (1 - rho) * targetQ2Network.Parameters() +
-      rho * learningQ2Network.Parameters();
+  // The Polyak averaging is done in place -- scale the target parameters,
+  // then add the scaled learning parameters -- so no temporaries of parameter
+  // size are created.
+  targetQ1Network.Parameters() *= (1 - rho);
+  targetQ1Network.Parameters() += rho * learningQ1Network.Parameters();
+  targetQ2Network.Parameters() *= (1 - rho);
+  targetQ2Network.Parameters() += rho * learningQ2Network.Parameters();
 }
 
 template <
@@ -176,8 +180,9 @@ void SAC<
   arma::mat targetQInput = arma::join_vert(nextStateActions,
       sampledNextStates);
   arma::rowvec Q1, Q2;
-  targetQ1Network.Predict(targetQInput, Q1);
-  targetQ2Network.Predict(targetQInput, Q2);
+  Parallel::Invoke(
+      [&]() { targetQ1Network.Predict(targetQInput, Q1); },
+      [&]() { targetQ2Network.Predict(targetQInput, Q2); });
   arma::rowvec nextQ = sampledRewards + config.Discount() * ((1 - isTerminal)
       % arma::min(Q1, Q2));
 
@@ -187,16 +192,29 @@ void SAC<
                                  (sampledActions[i].action);
   arma::mat learningQInput = arma::join_vert(sampledActionValues,
       sampledStates);
-  learningQ1Network.Forward(learningQInput, Q1);
-  learningQ2Network.Forward(learningQInput, Q2);
 
-  arma::mat gradQ1Loss, gradQ2Loss;
-  lossFunction.Backward(Q1, nextQ, gradQ1Loss);
-  lossFunction.Backward(Q2, nextQ, gradQ2Loss);
+  // The two critic gradients are independent: each task touches only its own
+  // network and gradient matrices, and shares just the read-only sampled batch
+  // (learningQInput, nextQ), so both are computed concurrently.  The parameter
+  // steps below stay serial, since both critics share one updater.
+  arma::mat gradientQ1, gradientQ2;
+  Parallel::Invoke(
+      [&]()
+      {
+        arma::mat gradQ1Loss;
+        learningQ1Network.Forward(learningQInput, Q1);
+        lossFunction.Backward(Q1, nextQ, gradQ1Loss);
+        learningQ1Network.Backward(learningQInput, gradQ1Loss, gradientQ1);
+      },
+      [&]()
+      {
+        arma::mat gradQ2Loss;
+        learningQ2Network.Forward(learningQInput, Q2);
+        lossFunction.Backward(Q2, nextQ, gradQ2Loss);
+        learningQ2Network.Backward(learningQInput, gradQ2Loss, gradientQ2);
+      });
 
   // Update the critic networks.
-  arma::mat gradientQ1, gradientQ2;
-  learningQ1Network.Backward(learningQInput, gradQ1Loss, gradientQ1);
   #if ENS_VERSION_MAJOR == 1
   qNetworkUpdater.Update(learningQ1Network.Parameters(), config.StepSize(),
       gradientQ1);
@@ -204,7 +222,6 @@ void SAC<
   qNetworkUpdatePolicy->Update(learningQ1Network.Parameters(),
       config.StepSize(), gradientQ1);
   #endif
-  learningQ2Network.Backward(learningQInput, gradQ2Loss, gradientQ2);
   #if ENS_VERSION_MAJOR == 1
   qNetworkUpdater.Update(learningQ2Network.Parameters(), config.StepSize(),
       gradientQ2);
@@ -81,6 +81,7 @@ class NStepQLearningWorker
       pending(other.pending),
       pendingIndex(other.pendingIndex),
       network(other.network),
+      localTargetNetwork(other.localTargetNetwork),
       state(other.state)
   {
     #if ENS_VERSION_MAJOR >= 2
@@ -111,6 +112,7 @@ class NStepQLearningWorker
       pending(std::move(other.pending)),
       pendingIndex(std::move(other.pendingIndex)),
       network(std::move(other.network)),
+      localTargetNetwork(std::move(other.localTargetNetwork)),
       state(std::move(other.state))
   {
     #if ENS_VERSION_MAJOR >= 2
@@ -146,6 +148,7 @@ class NStepQLearningWorker
     pending = other.pending;
     pendingIndex = other.pendingIndex;
     network = other.network;
+    localTargetNetwork = other.localTargetNetwork;
     state = other.state;
 
     #if ENS_VERSION_MAJOR >= 2
@@ -183,6 +186,7 @@ class NStepQLearningWorker
     pending = std::move(other.pending);
     pendingIndex = std::move(other.pendingIndex);
     network = std::move(other.network);
+    localTargetNetwork = std::move(other.localTargetNetwork);
     state = std::move(other.state);
 
     #if ENS_VERSION_MAJOR >= 2
@@ -225,8 +229,9 @@ class NStepQLearningWorker
                                      learningNetwork.Parameters().n_cols);
     #endif
 
-    // Build local network.
+    // Build local network and local target network snapshot.
     network = learningNetwork;
+    localTargetNetwork = learningNetwork;
   }
 
   /**
@@ -265,7 +270,7 @@ class NStepQLearningWorker
         totalReward = episodeReturn;
         Reset();
         // Sync with latest learning network.
-        network = learningNetwork;
+        network.Parameters() = learningNetwork.Parameters();
         return true;
       }
       state = nextState;
@@ -284,13 +289,16 @@ class NStepQLearningWorker
       arma::mat totalGradients(learningNetwork.Parameters().n_rows,
           learningNetwork.Parameters().n_cols, arma::fill::zeros);
 
-      // Bootstrap from the value of next state.
+      // Bootstrap from the value of next state.  A snapshot of the target
+      // network parameters is taken under the lock, so the prediction itself
+      // can run lock-free.
       arma::colvec actionValue;
       double target = 0;
       if (!terminal)
       {
         #pragma omp critical
-        { targetNetwork.Predict(nextState.Encode(), actionValue); };
+        { localTargetNetwork.Parameters() = targetNetwork.Parameters(); }
+        localTargetNetwork.Predict(nextState.Encode(), actionValue);
         target = actionValue.max();
       }
 
@@ -328,17 +336,19 @@ class NStepQLearningWorker
           config.StepSize(), totalGradients);
       #endif
 
-      // Sync the local network with the global network.
-      network = learningNetwork;
+      // Sync the local network with the global network.  Hogwild-style: other
+      // workers may write the shared parameters while we read, which is fine.
+      network.Parameters() = learningNetwork.Parameters();
 
       pendingIndex = 0;
     }
 
-    // Update global target network.
+    // Update global target network.  Only the parameter matrix is copied, to
+    // keep the locked section short.
     if (totalSteps % config.TargetNetworkSyncInterval() == 0)
     {
       #pragma omp critical
-      { targetNetwork = learningNetwork; }
+      { targetNetwork.Parameters() = learningNetwork.Parameters(); }
     }
 
     policy.Anneal();
@@ -395,6 +405,9 @@ class NStepQLearningWorker
   //! Local network of the worker.
   NetworkType network;
 
+  //! Local snapshot of the shared target network.
+  NetworkType localTargetNetwork;
+
   //! Current state of the agent.
   StateType state;
 };
@@ -81,6 +81,7 @@ class OneStepQLearningWorker
       pending(other.pending),
       pendingIndex(other.pendingIndex),
       network(other.network),
+      localTargetNetwork(other.localTargetNetwork),
       state(other.state)
   {
     #if ENS_VERSION_MAJOR >= 2
@@ -111,6 +112,7 @@ class OneStepQLearningWorker
       pending(std::move(other.pending)),
       pendingIndex(std::move(other.pendingIndex)),
       network(std::move(other.network)),
+      localTargetNetwork(std::move(other.localTargetNetwork)),
       state(std::move(other.state))
   {
     #if ENS_VERSION_MAJOR >= 2
@@ -146,6 +148,7 @@ class OneStepQLearningWorker
     pending = other.pending;
     pendingIndex = other.pendingIndex;
     network = other.network;
+    localTargetNetwork = other.localTargetNetwork;
     state = other.state;
 
     #if ENS_VERSION_MAJOR >= 2
@@ -183,6 +186,7 @@ class OneStepQLearningWorker
     pending = std::move(other.pending);
     pendingIndex = std::move(other.pendingIndex);
     network = std::move(other.network);
+    localTargetNetwork = std::move(other.localTargetNetwork);
     state = std::move(other.state);
 
     #if ENS_VERSION_MAJOR >= 2
@@ -225,8 +229,9 @@ class OneStepQLearningWorker
                                      learningNetwork.Parameters().n_cols);
     #endif
 
-    // Build local network.
+    // Build local network and local target network snapshot.
     network = learningNetwork;
+    localTargetNetwork = learningNetwork;
   }
 
   /**
@@ -265,7 +270,7 @@ class OneStepQLearningWorker
         totalReward = episodeReturn;
         Reset();
         // Sync with latest learning network.
-        network = learningNetwork;
+        network.Parameters() = learningNetwork.Parameters();
         return true;
       }
       state = nextState;
@@ -283,17 +288,20 @@ class OneStepQLearningWorker
       // Initialize the gradient storage.
       arma::mat totalGradients(learningNetwork.Parameters().n_rows,
           learningNetwork.Parameters().n_cols, arma::fill::zeros);
+
+      // Take one consistent snapshot of the target network for this batch,
+      // so the predictions below don't need to lock per transition.
+      #pragma omp critical
+      { localTargetNetwork.Parameters() = targetNetwork.Parameters(); }
+
       for (size_t i = 0; i < pending.size(); ++i)
       {
         TransitionType &transition = pending[i];
 
         // Compute the target state-action value.
         arma::colvec actionValue;
-        #pragma omp critical
-        {
-          targetNetwork.Predict(
-              std::get<3>(transition).Encode(), actionValue);
-        };
+        localTargetNetwork.Predict(
+            std::get<3>(transition).Encode(), actionValue);
         double targetActionValue = actionValue.max();
         if (terminal && i == pending.size() - 1)
           targetActionValue = 0;
@@ -328,17 +336,19 @@ class OneStepQLearningWorker
           config.StepSize(), totalGradients);
       #endif
 
-      // Sync the local network with the global network.
-      network = learningNetwork;
+      // Sync the local network with the global network.  Hogwild-style: other
+      // workers may write the shared parameters while we read, which is fine.
+      network.Parameters() = learningNetwork.Parameters();
 
       pendingIndex = 0;
     }
 
-    // Update global target network.
+    // Update global target network.  Only the parameter matrix is copied, to
+    // keep the locked section short.
     if (totalSteps % config.TargetNetworkSyncInterval() == 0)
     {
       #pragma omp critical
-      { targetNetwork = learningNetwork; }
+      { targetNetwork.Parameters() = learningNetwork.Parameters(); }
     }
 
     policy.Anneal();
@@ -395,6 +405,9 @@ class OneStepQLearningWorker
   //! Local network of the worker.
   NetworkType network;
 
+  //! Local snapshot of the shared target network.
+  NetworkType localTargetNetwork;
+
   //! Current state of the agent.
   StateType state;
 };
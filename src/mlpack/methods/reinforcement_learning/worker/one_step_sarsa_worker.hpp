@@ -82,6 +82,7 @@ class OneStepSarsaWorker
       pending(other.pending),
       pendingIndex(other.pendingIndex),
       network(other.network),
+      localTargetNetwork(other.localTargetNetwork),
       state(other.state),
       action(other.action)
   {
@@ -113,6 +114,7 @@ class OneStepSarsaWorker
       pending(std::move(other.pending)),
       pendingIndex(std::move(other.pendingIndex)),
       network(std::move(other.network)),
+      localTargetNetwork(std::move(other.localTargetNetwork)),
       state(std::move(other.state)),
       action(std::move(other.action))
   {
@@ -149,6 +151,7 @@ class OneStepSarsaWorker
     pending = other.pending;
     pendingIndex = other.pendingIndex;
     network = other.network;
+    localTargetNetwork = other.localTargetNetwork;
     state = other.state;
     action = other.action;
 
@@ -187,6 +190,7 @@ class OneStepSarsaWorker
     pending = std::move(other.pending);
     pendingIndex = std::move(other.pendingIndex);
     network = std::move(other.network);
+    localTargetNetwork = std::move(other.localTargetNetwork);
     state = std::move(other.state);
     action = std::move(other.action);
 
@@ -230,8 +234,9 @@ class OneStepSarsaWorker
                                      learningNetwork.Parameters().n_cols);
     #endif
 
-    // Build local network.
+    // Build local network and local target network snapshot.
     network = learningNetwork;
+    localTargetNetwork = learningNetwork;
   }
 
   /**
@@ -277,7 +282,7 @@ class OneStepSarsaWorker
         totalReward = episodeReturn;
         Reset();
         // Sync with latest learning network.
-        network = learningNetwork;
+        network.Parameters() = learningNetwork.Parameters();
         return true;
       }
       state = nextState;
@@ -296,17 +301,20 @@ class OneStepSarsaWorker
       // Initialize the gradient storage.
       arma::mat totalGradients(learningNetwork.Parameters().n_rows,
           learningNetwork.Parameters().n_cols, arma::fill::zeros);
+
+      // Take one consistent snapshot of the target network for this batch,
+      // so the predictions below don't need to lock per transition.
+      #pragma omp critical
+      { localTargetNetwork.Parameters() = targetNetwork.Parameters(); }
+
       for (size_t i = 0; i < pending.size(); ++i)
       {
         TransitionType &transition = pending[i];
 
         // Compute the target state-action value.
         arma::colvec actionValue;
-        #pragma omp critical
-        {
-          targetNetwork.Predict(
-              std::get<3>(transition).Encode(), actionValue);
-        };
+        localTargetNetwork.Predict(
+            std::get<3>(transition).Encode(), actionValue);
         double targetActionValue = 0;
         if (!(terminal && i == pending.size() - 1))
           targetActionValue = actionValue[std::get<4>(transition).action];
@@ -341,17 +349,19 @@ class OneStepSarsaWorker
           config.StepSize(), totalGradients);
       #endif
 
-      // Sync the local network with the global network.
-      network = learningNetwork;
+      // Sync the local network with the global network.  Hogwild-style: other
+      // workers may write the shared parameters while we read, which is fine.
+      network.Parameters() = learningNetwork.Parameters();
 
       pendingIndex = 0;
     }
 
-    // Update global target network.
+    // Update global target network.  Only the parameter matrix is copied, to
+    // keep the locked section short.
     if (totalSteps % config.TargetNetworkSyncInterval() == 0)
     {
       #pragma omp critical
-      { targetNetwork = learningNetwork; }
+      { targetNetwork.Parameters() = learningNetwork.Parameters(); }
     }
 
     policy.Anneal();
@@ -411,6 +421,9 @@ class OneStepSarsaWorker
   //! Local network of the worker.
   NetworkType network;
 
+  //! Local snapshot of the shared target network.
+  NetworkType localTargetNetwork;
+
   //! Current state of the agent.
   StateType state;
 
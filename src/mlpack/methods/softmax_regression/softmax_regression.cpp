@@ -122,6 +122,118 @@ void SoftmaxRegression::Classify(const arma::mat& dataset,
                                             numClasses, 1);
 }
 
+void SoftmaxRegression::ClassifyTopK(const arma::mat& dataset,
+                                     const size_t k,
+                                     arma::Mat<size_t>& labels,
+                                     arma::mat& scores) const
+{
+  if (dataset.n_rows != FeatureSize())
+  {
+    std::ostringstream oss;
+    oss << "SoftmaxRegression::ClassifyTopK(): dataset has " << dataset.n_rows
+        << " dimensions, but model has " << FeatureSize() << " dimensions!";
+    throw std::invalid_argument(oss.str());
+  }
+
+  const size_t effK = std::min(k, numClasses);
+
+  // Split the parameters into intercepts and class weights.
+  arma::vec intercepts;
+  arma::mat weights;
+  if (fitIntercept)
+  {
+    intercepts = parameters.col(0);
+    weights = parameters.cols(1, parameters.n_cols - 1);
+  }
+  else
+  {
+    intercepts.zeros(numClasses);
+    weights = parameters;
+  }
+
+  // Order the classes by decreasing weight norm, and precompute, for every
+  // position in that order, the largest weight norm and intercept among the
+  // classes from that position on.  Then, for a point with norm ||x||, no
+  // class at or after position p can score above
+  // suffixNorm(p) * ||x|| + suffixIntercept(p).
+  const arma::vec norms = arma::sqrt(arma::sum(arma::square(weights), 1));
+  const arma::uvec order = arma::sort_index(norms, "descend");
+
+  const arma::mat sortedWeights = weights.rows(order);
+  const arma::vec sortedIntercepts = intercepts(order);
+
+  arma::vec suffixNorm(numClasses);
+  arma::vec suffixIntercept(numClasses);
+  double maxNorm = -arma::datum::inf;
+  double maxIntercept = -arma::datum::inf;
+  for (size_t j = numClasses; j > 0; --j)
+  {
+    maxNorm = std::max(maxNorm, norms(order(j - 1)));
+    maxIntercept = std::max(maxIntercept, sortedIntercepts(j - 1));
+    suffixNorm(j - 1) = maxNorm;
+    suffixIntercept(j - 1) = maxIntercept;
+  }
+
+  labels.set_size(effK, dataset.n_cols);
+  scores.set_size(effK, dataset.n_cols);
+
+  // Classes are scored in blocks; after each block the screening bound is
+  // rechecked, so a point typically touches only the first few blocks.
+  const size_t blockSize = 64;
+
+  // Each point is classified independently and writes its own output columns.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
+  {
+    const double pointNorm = arma::norm(dataset.col(i), 2);
+
+    // Running top-k, kept sorted ascending so that topScores(0) is the
+    // k-th best score seen so far.  The -inf fill keeps the screening bound
+    // inactive until k real scores have been collected.
+    arma::vec topScores(effK);
+    topScores.fill(-arma::datum::inf);
+    arma::Col<size_t> topLabels(effK, arma::fill::zeros);
+
+    for (size_t begin = 0; begin < numClasses; begin += blockSize)
+    {
+      // Stop as soon as no remaining class can beat the k-th best score.
+      if (suffixNorm(begin) * pointNorm + suffixIntercept(begin) <=
+          topScores(0))
+        break;
+
+      const size_t end = std::min(begin + blockSize, numClasses);
+      const arma::vec blockScores =
+          sortedWeights.rows(begin, end - 1) * dataset.col(i) +
+          sortedIntercepts.subvec(begin, end - 1);
+
+      for (size_t j = 0; j < blockScores.n_elem; ++j)
+      {
+        const double score = blockScores(j);
+        if (score <= topScores(0))
+          continue;
+
+        // Replace the current k-th best and restore the ascending order.
+        size_t pos = 0;
+        while (pos + 1 < effK && score > topScores(pos + 1))
+        {
+          topScores(pos) = topScores(pos + 1);
+          topLabels(pos) = topLabels(pos + 1);
+          ++pos;
+        }
+        topScores(pos) = score;
+        topLabels(pos) = order(begin + j);
+      }
+    }
+
+    // Emit the results in decreasing order of score.
+    for (size_t r = 0; r < effK; ++r)
+    {
+      labels(r, i) = topLabels(effK - 1 - r);
+      scores(r, i) = topScores(effK - 1 - r);
+    }
+  }
+}
+
 double SoftmaxRegression::ComputeAccuracy(
     const arma::mat& testData,
     const arma::Row<size_t>& labels) const
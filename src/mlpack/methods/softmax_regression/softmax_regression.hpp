@@ -160,6 +160,30 @@ class SoftmaxRegression
   void Classify(const arma::mat& dataset,
                 arma::mat& probabilities) const;
 
+  /**
+   * Find the k highest-scoring classes for each of the given points, without
+   * computing every class score.  Classes are screened with the
+   * Cauchy-Schwarz bound \f$ w_j^T x + b_j \le \|w_j\| \|x\| + b_j \f$: they
+   * are visited in blocks of decreasing weight norm, and once no remaining
+   * class can beat the current k-th best score for a point, the rest are
+   * skipped.  This is useful when the number of classes is large and only a
+   * few top predictions are needed.
+   *
+   * On output, labels(r, i) is the class with the (r + 1)-th highest score
+   * for point i, and scores(r, i) is its raw score (the unnormalized
+   * log-probability; softmax normalization does not change the ordering and
+   * would require every class score).
+   *
+   * @param dataset Matrix of data points to be classified.
+   * @param k Number of top classes to return for each point.
+   * @param labels k x n_cols matrix of predicted class labels.
+   * @param scores k x n_cols matrix of raw class scores.
+   */
+  void ClassifyTopK(const arma::mat& dataset,
+                    const size_t k,
+                    arma::Mat<size_t>& labels,
+                    arma::mat& scores) const;
+
   /**
    * Computes accuracy of the learned model given the feature data and the
    * labels associated with each data point. Predictions are made using the
@@ -11,6 +11,7 @@
  */
 #include "softmax_regression_function.hpp"
 #include <mlpack/core/math/make_alias.hpp>
+#include <mlpack/core/util/parallel.hpp>
 
 using namespace mlpack;
 using namespace mlpack::regression;
@@ -24,7 +25,8 @@ SoftmaxRegressionFunction::SoftmaxRegressionFunction(
     data(math::MakeAlias(const_cast<arma::mat&>(data), false)),
     numClasses(numClasses),
     lambda(lambda),
-    fitIntercept(fitIntercept)
+    fitIntercept(fitIntercept),
+    blockSize(0)
 {
   // Initialize the parameters to suitable values.
   initialPoint = InitializeWeights();
@@ -199,14 +201,41 @@ double SoftmaxRegressionFunction::Evaluate(const arma::mat& parameters) const
   // The sum is calculated over all the classes.
   // x_i is the input vector for a particular training example.
   // theta_j is the parameter vector associated with a particular class.
-  arma::mat probabilities;
-  GetProbabilitiesMatrix(parameters, probabilities, 0, data.n_cols);
 
   // Calculate the log likelihood and regularization terms.
   double logLikelihood, weightDecay, cost;
 
-  logLikelihood = arma::accu(groundTruth % arma::log(probabilities)) /
-                  data.n_cols;
+  if (blockSize > 0 && blockSize < data.n_cols)
+  {
+    // Stream over blocks of points so only a numClasses x blockSize
+    // probability block is ever materialized; each block is independent, so
+    // the blocks are processed in parallel, with the per-thread partial sums
+    // combined in a fixed order by Parallel::ReduceFor() (reproducible when
+    // deterministic reductions are requested).
+    const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+
+    logLikelihood = Parallel::ReduceFor(numBlocks, 0.0,
+        [&](double& partial, const size_t block)
+        {
+          const size_t begin = block * blockSize;
+          const size_t size = std::min(blockSize, data.n_cols - begin);
+
+          arma::mat probabilities;
+          GetProbabilitiesMatrix(parameters, probabilities, begin, size);
+          partial += arma::accu(groundTruth.cols(begin, begin + size - 1) %
+              arma::log(probabilities));
+        },
+        [](double& to, double& from) { to += from; });
+    logLikelihood /= data.n_cols;
+  }
+  else
+  {
+    arma::mat probabilities;
+    GetProbabilitiesMatrix(parameters, probabilities, 0, data.n_cols);
+
+    logLikelihood = arma::accu(groundTruth % arma::log(probabilities)) /
+                    data.n_cols;
+  }
   weightDecay = 0.5 * lambda * arma::accu(parameters % parameters);
 
   // The cost is the sum of the negative log likelihood and the regularization
@@ -248,6 +277,47 @@ void SoftmaxRegressionFunction::Gradient(const arma::mat& parameters,
   // The sum is calculated over all the classes.
   // x_i is the input vector for a particular training example.
   // theta_j is the parameter vector associated with a particular class.
+
+  if (blockSize > 0 && blockSize < data.n_cols)
+  {
+    // Stream over blocks of points, fusing the probability computation and
+    // the gradient GEMM per block so only a numClasses x blockSize block is
+    // ever materialized.  Each thread accumulates the contributions of its
+    // blocks locally and Parallel::ReduceFor() combines the partial
+    // gradients in a fixed order (reproducible when deterministic reductions
+    // are requested); the regularization term is added once at the end.
+    const size_t numBlocks = (data.n_cols + blockSize - 1) / blockSize;
+
+    gradient = Parallel::ReduceFor(numBlocks,
+        arma::mat(parameters.n_rows, parameters.n_cols, arma::fill::zeros),
+        [&](arma::mat& localGradient, const size_t block)
+        {
+          const size_t begin = block * blockSize;
+          const size_t size = std::min(blockSize, data.n_cols - begin);
+
+          arma::mat probabilities;
+          GetProbabilitiesMatrix(parameters, probabilities, begin, size);
+          const arma::mat inner = probabilities -
+              groundTruth.cols(begin, begin + size - 1);
+
+          if (fitIntercept)
+          {
+            localGradient.col(0) += arma::sum(inner, 1);
+            localGradient.cols(1, parameters.n_cols - 1) +=
+                inner * data.cols(begin, begin + size - 1).t();
+          }
+          else
+          {
+            localGradient += inner * data.cols(begin, begin + size - 1).t();
+          }
+        },
+        [](arma::mat& to, arma::mat& from) { to += from; });
+
+    gradient /= data.n_cols;
+    gradient += lambda * parameters;
+    return;
+  }
+
   arma::mat probabilities;
   GetProbabilitiesMatrix(parameters, probabilities, 0, data.n_cols);
 
@@ -187,6 +187,16 @@ class SoftmaxRegressionFunction
   //! Gets the intercept flag.
   bool FitIntercept() const { return fitIntercept; }
 
+  //! Gets the block size used by the full-dataset Evaluate() and Gradient()
+  //! (0 means the whole dataset is processed in one pass).
+  size_t BlockSize() const { return blockSize; }
+  //! Sets the block size used by the full-dataset Evaluate() and Gradient().
+  //! When nonzero, those stream over blocks of at most this many points, so
+  //! only a numClasses x blockSize probability block is ever materialized and
+  //! the blocks are processed in parallel.  Useful when the number of classes
+  //! is so large that the full probability matrix does not fit in memory.
+  size_t& BlockSize() { return blockSize; }
+
  private:
   //! Training data matrix.  This is an alias until the data is shuffled.
   arma::mat data;
@@ -200,6 +210,9 @@ class SoftmaxRegressionFunction
   double lambda;
   //! Intercept term flag.
   bool fitIntercept;
+  //! Block size for the full-dataset Evaluate() and Gradient() (0 means the
+  //! whole dataset is processed in one pass).
+  size_t blockSize;
 };
 
 } // namespace regression
@@ -11,6 +11,10 @@
  */
 #include "sparse_autoencoder_function.hpp"
 
+#include <mlpack/core/util/parallel.hpp>
+
+#include <algorithm>
+
 using namespace mlpack;
 using namespace mlpack::nn;
 using namespace std;
@@ -88,37 +92,58 @@ double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters) const
   const size_t l2 = visibleSize;
   const size_t l3 = 2 * hiddenSize;
 
-  // w1, w2, b1 and b2 are not extracted separately, 'parameters' is directly
-  // used in their place to avoid copying data. The following representations
-  // are used:
-  // w1 <- parameters.submat(0, 0, l1-1, l2-1)
-  // w2 <- parameters.submat(l1, 0, l3-1, l2-1).t()
-  // b1 <- parameters.submat(0, l2, l1-1, l2)
-  // b2 <- parameters.submat(l3, 0, l3, l2-1).t()
-
-  arma::mat hiddenLayer, outputLayer;
-
-  // Compute activations of the hidden and output layers.
-  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * data +
-      arma::repmat(parameters.submat(0, l2, l1 - 1, l2), 1, data.n_cols),
-      hiddenLayer);
-
-  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
-      arma::repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, data.n_cols),
-      outputLayer);
-
-  arma::mat rhoCap, diff;
+  // Extract the parameter blocks once; they are small next to the data, and
+  // this avoids repeated subview arithmetic inside the chunk loop below.
+  const arma::mat w1 = parameters.submat(0, 0, l1 - 1, l2 - 1);
+  const arma::mat w2 = parameters.submat(l1, 0, l3 - 1, l2 - 1);
+  const arma::colvec b1 = parameters.submat(0, l2, l1 - 1, l2);
+  const arma::colvec b2 = parameters.submat(l3, 0, l3, l2 - 1).t();
+
+  // Feed the data forward in column chunks: each thread accumulates the sum
+  // of the hidden activations of its chunks (for the KL divergence sparsity
+  // term) together with the squared reconstruction error, so the layer
+  // activations only ever exist for one chunk per thread at a time instead of
+  // for the whole dataset.
+  const size_t chunkSize = 512;
+  const size_t numChunks = (data.n_cols + chunkSize - 1) / chunkSize;
+
+  typedef std::pair<arma::colvec, double> PartialType;
+  const PartialType identity(arma::zeros<arma::colvec>(hiddenSize), 0.0);
+
+  PartialType sums = Parallel::ReduceFor(numChunks, identity,
+      [&](PartialType& partial, const size_t chunk)
+      {
+        const size_t begin = chunk * chunkSize;
+        const size_t end = std::min(data.n_cols, begin + chunkSize) - 1;
+
+        // Compute activations of the hidden and output layers for the chunk.
+        arma::mat hiddenLayer = w1 * data.cols(begin, end);
+        hiddenLayer.each_col() += b1;
+        Sigmoid(hiddenLayer, hiddenLayer);
+
+        arma::mat outputLayer = w2.t() * hiddenLayer;
+        outputLayer.each_col() += b2;
+        Sigmoid(outputLayer, outputLayer);
+
+        // Reuse the output activations for the reconstruction difference.
+        outputLayer -= data.cols(begin, end);
+
+        partial.first += arma::sum(hiddenLayer, 1);
+        partial.second += arma::accu(outputLayer % outputLayer);
+      },
+      [](PartialType& to, const PartialType& from)
+      {
+        to.first += from.first;
+        to.second += from.second;
+      });
 
   // Average activations of the hidden layer.
-  rhoCap = arma::sum(hiddenLayer, 1) / data.n_cols;
-  // Difference between the reconstructed data and the original data.
-  diff = outputLayer - data;
+  const arma::colvec rhoCap = sums.first / data.n_cols;
 
   double wL2SquaredNorm;
 
   // Calculate squared L2-norms of w1 and w2.
-  wL2SquaredNorm = arma::accu(parameters.submat(0, 0, l3 - 1, l2 - 1) %
-      parameters.submat(0, 0, l3 - 1, l2 - 1));
+  wL2SquaredNorm = arma::accu(w1 % w1) + arma::accu(w2 % w2);
 
   double sumOfSquaresError, weightDecay, klDivergence, cost;
 
@@ -128,7 +153,7 @@ double SparseAutoencoderFunction::Evaluate(const arma::mat& parameters) const
   // of the weights w1 and w2. 'klDivergence' is the cost of the hidden layer
   // activations not being low. It is given by the following formula:
   // KL = sum_over_hSize(rho*log(rho/rhoCaq) + (1-rho)*log((1-rho)/(1-rhoCap)))
-  sumOfSquaresError = 0.5 * arma::accu(diff % diff) / data.n_cols;
+  sumOfSquaresError = 0.5 * sums.second / data.n_cols;
   weightDecay = 0.5 * lambda * wL2SquaredNorm;
   klDivergence = beta * arma::accu(rho * arma::log(rho / rhoCap) + (1 - rho) *
       arma::log((1 - rho) / (1 - rhoCap)));
@@ -155,33 +180,33 @@ void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
   const size_t l2 = visibleSize;
   const size_t l3 = 2 * hiddenSize;
 
-  // w1, w2, b1 and b2 are not extracted separately, 'parameters' is directly
-  // used in their place to avoid copying data. The following representations
-  // are used:
-  // w1 <- parameters.submat(0, 0, l1-1, l2-1)
-  // w2 <- parameters.submat(l1, 0, l3-1, l2-1).t()
-  // b1 <- parameters.submat(0, l2, l1-1, l2)
-  // b2 <- parameters.submat(l3, 0, l3, l2-1).t()
-
-  arma::mat hiddenLayer, outputLayer;
-
-  // Compute activations of the hidden and output layers.
-  Sigmoid(parameters.submat(0, 0, l1 - 1, l2 - 1) * data +
-      arma::repmat(parameters.submat(0, l2, l1 - 1, l2), 1, data.n_cols),
-      hiddenLayer);
-
-  Sigmoid(parameters.submat(l1, 0, l3 - 1, l2 - 1).t() * hiddenLayer +
-      arma::repmat(parameters.submat(l3, 0, l3, l2 - 1).t(), 1, data.n_cols),
-      outputLayer);
-
-  arma::mat rhoCap, diff;
-
-  // Average activations of the hidden layer.
-  rhoCap = arma::sum(hiddenLayer, 1) / data.n_cols;
-  // Difference between the reconstructed data and the original data.
-  diff = outputLayer - data;
-
-  arma::mat klDivGrad, delOut, delHid;
+  // Extract the parameter blocks once, as in Evaluate().
+  const arma::mat w1 = parameters.submat(0, 0, l1 - 1, l2 - 1);
+  const arma::mat w2 = parameters.submat(l1, 0, l3 - 1, l2 - 1);
+  const arma::colvec b1 = parameters.submat(0, l2, l1 - 1, l2);
+  const arma::colvec b2 = parameters.submat(l3, 0, l3, l2 - 1).t();
+
+  const size_t chunkSize = 512;
+  const size_t numChunks = (data.n_cols + chunkSize - 1) / chunkSize;
+
+  // The KL divergence gradient couples every point through the average hidden
+  // activation, so a first chunked pass accumulates it before any delta can
+  // be computed.
+  arma::colvec rhoCap = Parallel::ReduceFor(numChunks,
+      arma::zeros<arma::colvec>(hiddenSize),
+      [&](arma::colvec& partial, const size_t chunk)
+      {
+        const size_t begin = chunk * chunkSize;
+        const size_t end = std::min(data.n_cols, begin + chunkSize) - 1;
+
+        arma::mat hiddenLayer = w1 * data.cols(begin, end);
+        hiddenLayer.each_col() += b1;
+        Sigmoid(hiddenLayer, hiddenLayer);
+
+        partial += arma::sum(hiddenLayer, 1);
+      },
+      [](arma::colvec& to, const arma::colvec& from) { to += from; });
+  rhoCap /= data.n_cols;
 
   // The delta vector for the output layer is given by diff * f'(z), where z is
   // the preactivation and f is the activation function. The derivative of the
@@ -189,22 +214,49 @@ void SparseAutoencoderFunction::Gradient(const arma::mat& parameters,
   // in the neural network which comes before the output layer, the delta values
   // are given del_n = w_n' * del_(n+1) * f'(z_n). Since our cost function also
   // includes the KL divergence term, we adjust for that in the formula below.
-  klDivGrad = beta * (-(rho / rhoCap) + (1 - rho) / (1 - rhoCap));
-  delOut = diff % outputLayer % (1 - outputLayer);
-  delHid = (parameters.submat(l1, 0, l3 - 1, l2 - 1) * delOut +
-      arma::repmat(klDivGrad, 1, data.n_cols)) % hiddenLayer %
-      (1 - hiddenLayer);
-
-  gradient.zeros(2 * hiddenSize + 1, visibleSize + 1);
-
-  // Compute the gradient values using the activations and the delta values. The
-  // formula also accounts for the regularization terms in the objective.
-  // function.
-  gradient.submat(0, 0, l1 - 1, l2 - 1) = delHid * data.t() / data.n_cols +
-      lambda * parameters.submat(0, 0, l1 - 1, l2 - 1);
-  gradient.submat(l1, 0, l3 - 1, l2 - 1) =
-      (delOut * hiddenLayer.t() / data.n_cols +
-      lambda * parameters.submat(l1, 0, l3 - 1, l2 - 1).t()).t();
-  gradient.submat(0, l2, l1 - 1, l2) = arma::sum(delHid, 1) / data.n_cols;
-  gradient.submat(l3, 0, l3, l2 - 1) = (arma::sum(delOut, 1) / data.n_cols).t();
+  const arma::colvec klDivGrad = beta * (-(rho / rhoCap) + (1 - rho) /
+      (1 - rhoCap));
+
+  // The second pass repeats the feedforward computation chunk by chunk,
+  // computes the deltas of the chunk, and accumulates their contributions to
+  // the gradient. Recomputing the hidden activations costs one extra matrix
+  // product per chunk but means no dataset-sized temporary is ever formed;
+  // each thread only holds the activations and deltas of a single chunk.
+  const arma::mat identity = arma::zeros<arma::mat>(2 * hiddenSize + 1,
+      visibleSize + 1);
+
+  gradient = Parallel::ReduceFor(numChunks, identity,
+      [&](arma::mat& partial, const size_t chunk)
+      {
+        const size_t begin = chunk * chunkSize;
+        const size_t end = std::min(data.n_cols, begin + chunkSize) - 1;
+
+        arma::mat hiddenLayer = w1 * data.cols(begin, end);
+        hiddenLayer.each_col() += b1;
+        Sigmoid(hiddenLayer, hiddenLayer);
+
+        arma::mat outputLayer = w2.t() * hiddenLayer;
+        outputLayer.each_col() += b2;
+        Sigmoid(outputLayer, outputLayer);
+
+        const arma::mat diff = outputLayer - data.cols(begin, end);
+
+        const arma::mat delOut = diff % outputLayer % (1 - outputLayer);
+        arma::mat delHid = w2 * delOut;
+        delHid.each_col() += klDivGrad;
+        delHid %= hiddenLayer % (1 - hiddenLayer);
+
+        partial.submat(0, 0, l1 - 1, l2 - 1) +=
+            delHid * data.cols(begin, end).t();
+        partial.submat(l1, 0, l3 - 1, l2 - 1) += hiddenLayer * delOut.t();
+        partial.submat(0, l2, l1 - 1, l2) += arma::sum(delHid, 1);
+        partial.submat(l3, 0, l3, l2 - 1) += arma::sum(delOut, 1).t();
+      },
+      [](arma::mat& to, const arma::mat& from) { to += from; });
+
+  // Average the accumulated contributions and add in the gradients of the
+  // regularization terms of the objective function.
+  gradient /= data.n_cols;
+  gradient.submat(0, 0, l1 - 1, l2 - 1) += lambda * w1;
+  gradient.submat(l1, 0, l3 - 1, l2 - 1) += lambda * w2;
 }
@@ -28,7 +28,8 @@ SparseCoding::SparseCoding(
     lambda2(lambda2),
     maxIterations(maxIterations),
     objTolerance(objTolerance),
-    newtonTolerance(newtonTolerance)
+    newtonTolerance(newtonTolerance),
+    batchSize(0)
 {
   // Nothing to do.
 }
@@ -40,7 +41,12 @@ void SparseCoding::Encode(const arma::mat& data, arma::mat& codes)
   arma::mat matGram = trans(dictionary) * dictionary;
 
   codes.set_size(atoms, data.n_cols);
-  for (size_t i = 0; i < data.n_cols; ++i)
+
+  // Each column is solved independently: every thread gets its own LARS
+  // instance, all of them sharing the precomputed Gram matrix, and writes its
+  // own column of the codes matrix.
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
   {
     // Report progress.
     if ((i % 100) == 0)
@@ -254,6 +254,15 @@ class SparseCoding
   //! Modify the tolerance for Newton's method (dictionary optimization step).
   double& NewtonTolerance() { return newtonTolerance; }
 
+  //! Get the mini-batch size used by Train() (0 means full-batch training).
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the mini-batch size used by Train().  When nonzero, each
+  //! iteration encodes a random mini-batch of points and takes the dictionary
+  //! step on that mini-batch alone; the full coding step happens once after
+  //! training.  Because the tracked objective is then noisy, a nonzero
+  //! maxIterations should be set in this mode.
+  size_t& BatchSize() { return batchSize; }
+
   //! Serialize the sparse coding model.
   template<typename Archive>
   void serialize(Archive& ar, const unsigned int /* version */);
@@ -276,6 +285,8 @@ class SparseCoding
   double objTolerance;
   //! Tolerance for Newton's method (dictionary training).
   double newtonTolerance;
+  //! Mini-batch size for training (0 means full-batch training).
+  size_t batchSize;
 };
 
 } // namespace sparse_coding
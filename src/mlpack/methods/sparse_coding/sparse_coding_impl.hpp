@@ -34,7 +34,8 @@ SparseCoding::SparseCoding(
     lambda2(lambda2),
     maxIterations(maxIterations),
     objTolerance(objTolerance),
-    newtonTolerance(newtonTolerance)
+    newtonTolerance(newtonTolerance),
+    batchSize(0)
 {
   Train(data, initializer);
 }
@@ -52,18 +53,26 @@ double SparseCoding::Train(
 
   double lastObjVal = DBL_MAX;
 
-  // Take the initial coding step, which has to happen before entering the main
-  // optimization loop.
-  Log::Info << "Initial coding step." << std::endl;
+  // Whether each dictionary step uses a random mini-batch of points only.
+  const bool miniBatch = (batchSize > 0 && batchSize < data.n_cols);
 
   arma::mat codes(atoms, data.n_cols);
-  Encode(data, codes);
-  arma::uvec adjacencies = find(codes);
+  arma::uvec adjacencies;
+  if (!miniBatch)
+  {
+    // Take the initial coding step, which has to happen before entering the
+    // main optimization loop.
+    Log::Info << "Initial coding step." << std::endl;
+
+    Encode(data, codes);
+    adjacencies = find(codes);
 
-  Log::Info << "  Sparsity level: " << 100.0 * ((double) (adjacencies.n_elem))
-      / ((double) (atoms * data.n_cols)) << "%." << std::endl;
-  Log::Info << "  Objective value: " << Objective(data, codes) << "."
-      << std::endl;
+    Log::Info << "  Sparsity level: " << 100.0 *
+        ((double) (adjacencies.n_elem)) / ((double) (atoms * data.n_cols))
+        << "%." << std::endl;
+    Log::Info << "  Objective value: " << Objective(data, codes) << "."
+        << std::endl;
+  }
 
   for (size_t t = 1; t != maxIterations; ++t)
   {
@@ -74,6 +83,47 @@ double SparseCoding::Train(
       Log::Info << " of " << maxIterations;
     Log::Info << "." << std::endl;
 
+    if (miniBatch)
+    {
+      // Encode a random mini-batch of points and take the dictionary step on
+      // that mini-batch alone; the full coding step is deferred until after
+      // the last iteration.
+      const arma::uvec points = arma::shuffle(arma::linspace<arma::uvec>(0,
+          data.n_cols - 1, data.n_cols)).head(batchSize);
+      const arma::mat batchData = data.cols(points);
+
+      Log::Info << "Performing mini-batch coding step..." << std::endl;
+      arma::mat batchCodes;
+      Encode(batchData, batchCodes);
+      const arma::uvec batchAdjacencies = find(batchCodes);
+      Log::Info << "  Sparsity level: " << 100.0 *
+          ((double) (batchAdjacencies.n_elem)) /
+          ((double) (atoms * batchSize)) << "%." << std::endl;
+
+      Log::Info << "Performing mini-batch dictionary step..." << std::endl;
+      OptimizeDictionary(batchData, batchCodes, batchAdjacencies);
+
+      // Track convergence on the mini-batch objective.  Because every
+      // iteration sees a different mini-batch this estimate is noisy, so a
+      // nonzero maxIterations should be set in this mode.
+      double curObjVal = Objective(batchData, batchCodes);
+      double improvement = lastObjVal - curObjVal;
+      Log::Info << "  Mini-batch objective value: " << curObjVal
+          << " (improvement " << std::scientific << improvement << ")."
+          << std::endl;
+
+      lastObjVal = curObjVal;
+
+      // Have we converged?
+      if (improvement < objTolerance)
+      {
+        Log::Info << "Converged within tolerance " << objTolerance << ".\n";
+        break;
+      }
+
+      continue;
+    }
+
     // First step: optimize the dictionary.
     Log::Info << "Performing dictionary step... " << std::endl;
     OptimizeDictionary(data, codes, adjacencies);
@@ -105,6 +155,16 @@ double SparseCoding::Train(
     }
   }
 
+  if (miniBatch)
+  {
+    // Take the full coding step once, so the final objective is computed on
+    // the whole dataset.
+    Log::Info << "Final coding step." << std::endl;
+    Encode(data, codes);
+    lastObjVal = Objective(data, codes);
+    Log::Info << "  Objective value: " << lastObjVal << "." << std::endl;
+  }
+
   Timer::Stop("sparse_coding");
   return lastObjVal;
 }
@@ -402,10 +402,6 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   double overallObjective = DBL_MAX;
   double lastObjective;
 
-  // The order in which the functions will be visited.
-  arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
-      (function.NumFunctions() - 1), function.NumFunctions());
-
   const arma::mat data = function.Dataset();
   const arma::sp_mat implicitData = function.ImplicitDataset();
   const size_t numUsers = function.NumUsers();
@@ -415,6 +411,17 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
   // Rank of decomposition.
   const size_t rank = function.Rank();
 
+  // Group the rating columns by user, so that each user shard is owned by
+  // exactly one thread per pass.  User parameters then never race, and the
+  // per-user implicit-feedback sum can be cached across the user's ratings.
+  std::vector<std::vector<size_t>> userRatings(numUsers);
+  for (size_t j = 0; j < data.n_cols; ++j)
+    userRatings[(size_t) data(0, j)].push_back(j);
+
+  // The order in which the user shards will be visited.
+  arma::Col<size_t> visitationOrder = arma::linspace<arma::Col<size_t>>(0,
+      numUsers - 1, numUsers);
+
   // Iterate till the objective is within tolerance or the maximum number of
   // allowed iterations is reached. If maxIterations is 0, this will iterate
   // till convergence.
@@ -456,45 +463,52 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
       std::shuffle(visitationOrder.begin(), visitationOrder.end(),
           mlpack::math::randGen);
 
-    #pragma omp parallel
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t uIndex = 0; uIndex < (omp_size_t) numUsers; ++uIndex)
     {
-      // Each processor gets a subset of the instances.
-      // Each subset is of size threadShareSize.
-      size_t threadId = 0;
-      #ifdef HAS_OPENMP
-        threadId = omp_get_thread_num();
-      #endif
-
-      for (size_t j = threadId * threadShareSize;
-          j < (threadId + 1) * threadShareSize && j < visitationOrder.n_elem;
-          ++j)
+      const size_t user = visitationOrder[uIndex];
+      if (userRatings[user].empty())
+        continue;
+
+      const size_t implicitStart = numUsers + numItems;
+
+      // Cache the user's implicit item set and the sum of its implicit
+      // vectors once; the sum is adjusted in place whenever the vectors are
+      // updated below, so it is never re-summed per rating.
+      size_t implicitCount = 0;
+      arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+      arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+      for (; it != it_end; ++it)
+        implicitCount += 1;
+
+      arma::Col<size_t> implicitItems(implicitCount);
+      arma::vec implicitSum(rank, arma::fill::zeros);
+      it = implicitData.begin_col(user);
+      size_t implicitIndex = 0;
+      for (; it != it_end; ++it, ++implicitIndex)
+      {
+        implicitItems(implicitIndex) = it.row();
+        implicitSum +=
+            iterate.col(implicitStart + it.row()).subvec(0, rank - 1);
+      }
+      const double implicitNorm =
+          (implicitCount == 0) ? 1.0 : std::sqrt((double) implicitCount);
+
+      for (const size_t j : userRatings[user])
       {
         // Indices for accessing the the correct parameter columns.
-        const size_t user = data(0, visitationOrder[j]);
-        const size_t item = data(1, visitationOrder[j]) + numUsers;
-        const size_t implicitStart = numUsers + numItems;
+        const size_t item = (size_t) data(1, j) + numUsers;
 
         // Prediction error for the example.
-        const double rating = data(2, visitationOrder[j]);
+        const double rating = data(2, j);
         const double userBias = iterate(rank, user);
         const double itemBias = iterate(rank, item);
-        // Iterate through each item which the user interacted with to calculate
-        // user vector.
-        arma::vec userVec(rank, arma::fill::zeros);
-        arma::sp_mat::const_iterator it = implicitData.begin_col(user);
-        arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
-        size_t implicitCount = 0;
-        for (; it != it_end; ++it)
-        {
-          userVec += iterate.col(implicitStart + it.row()).subvec(0, rank - 1);
-          implicitCount += 1;
-        }
-        if (implicitCount != 0)
-          userVec /= std::sqrt(implicitCount);
+
+        arma::vec userVec = implicitSum / implicitNorm;
         userVec += iterate.col(user).subvec(0, rank - 1);
 
         double ratingError = rating - userBias - itemBias -
-        arma::dot(userVec, iterate.col(item).subvec(0, rank - 1));
+            arma::dot(userVec, iterate.col(item).subvec(0, rank - 1));
 
         arma::mat userVecUpdate = stepSize * 2 * (
             lambda * iterate.col(user).subvec(0, rank - 1) -
@@ -509,41 +523,29 @@ inline double ParallelSGD<ExponentialBackoff>::Optimize(
 
         // Update of item implicit vectors.
         arma::mat itemImplicitUpdate(rank, implicitCount);
-        arma::Col<size_t> implicitItems(implicitCount);
-        it = implicitData.begin_col(user);
-        it_end = implicitData.end_col(user);
-        size_t implicitIndex = 0;
-        for (; it != it_end; ++it, ++implicitIndex)
+        for (size_t k = 0; k < implicitCount; ++k)
         {
-          itemImplicitUpdate.col(implicitIndex) =
+          itemImplicitUpdate.col(k) =
               stepSize * 2.0 * (lambda / implicitCount *
-              iterate.col(implicitStart + it.row()).subvec(0, rank - 1) -
-              ratingError / std::sqrt(implicitCount) *
+              iterate.col(implicitStart + implicitItems(k)).subvec(0,
+              rank - 1) -
+              ratingError / implicitNorm *
               iterate.col(item).subvec(0, rank - 1));
-          implicitItems(implicitIndex) = it.row();
         }
 
-        // Gradient is non-zero only for the parameter columns corresponding to
-        // the example.
-        for (size_t i = 0; i < rank; ++i)
-        {
-          #pragma omp atomic
-          iterate(i, user) -= userVecUpdate(i);
-          #pragma omp atomic
-          iterate(i, item) -= itemVecUpdate(i);
-        }
-        #pragma omp atomic
+        // This thread is the only writer of the user's columns; item and
+        // implicit columns are shared across shards and updated without
+        // synchronization, in Hogwild fashion.
+        iterate.col(user).subvec(0, rank - 1) -= userVecUpdate;
+        iterate.col(item).subvec(0, rank - 1) -= itemVecUpdate;
         iterate(rank, user) -= userBiasUpdate;
-        #pragma omp atomic
         iterate(rank, item) -= itemBiasUpdate;
         for (size_t k = 0; k < implicitCount; ++k)
         {
-          for (size_t i = 0; i < rank; ++i)
-          {
-            #pragma omp atomic
-            iterate(i, implicitStart + implicitItems(k)) -=
-                itemImplicitUpdate(i, k);
-          }
+          iterate.col(implicitStart + implicitItems(k)).subvec(0, rank - 1) -=
+              itemImplicitUpdate.col(k);
+          // Keep the cached sum consistent with the updated vectors.
+          implicitSum -= itemImplicitUpdate.col(k);
         }
       }
     }
@@ -64,6 +64,45 @@ TEST_CASE("HammingLossBoundIris", "[AdaBoostTest]")
   REQUIRE(hammingLoss <= ztProduct);
 }
 
+/**
+ * Training stops early once the normalization constant zt has plateaued; a
+ * looser tolerance must never produce a larger ensemble than a stricter one,
+ * and the early-stopped ensemble still has to classify reasonably.
+ */
+TEST_CASE("ZtPlateauEarlyStopIris", "[AdaBoostTest]")
+{
+  arma::mat inputData;
+
+  if (!data::Load("iris.csv", inputData))
+    FAIL("Cannot load test dataset iris.csv!");
+
+  arma::Mat<size_t> labels;
+  if (!data::Load("iris_labels.txt", labels))
+    FAIL("Cannot load labels for iris iris_labels.txt");
+
+  const size_t numClasses = max(labels.row(0)) + 1;
+
+  Perceptron<> p(inputData, labels.row(0), numClasses, 400);
+
+  const size_t iterations = 100;
+
+  AdaBoost<> strict(1e-10);
+  strict.Train(inputData, labels.row(0), numClasses, p, iterations, 1e-10);
+
+  AdaBoost<> loose(1e-3);
+  loose.Train(inputData, labels.row(0), numClasses, p, iterations, 1e-3);
+
+  REQUIRE(loose.WeakLearners() >= 1);
+  REQUIRE(loose.WeakLearners() <= strict.WeakLearners());
+
+  arma::Row<size_t> predictedLabels;
+  loose.Classify(inputData, predictedLabels);
+
+  size_t countError = arma::accu(labels != predictedLabels);
+  double hammingLoss = (double) countError / labels.n_cols;
+  REQUIRE(hammingLoss <= 0.3);
+}
+
 /**
  * This test case runs the AdaBoost.mh algorithm on the UCI Iris dataset.  It
  * checks if the error returned by running a single instance of the weak learner
@@ -891,3 +930,110 @@ TEST_CASE("ID3DecisionStumpSerializationTest", "[AdaBoostTest]")
             abBinary.WeakLearner(i).SplitDimension());
   }
 }
+
+/**
+ * With a perceptron weak learner, Classify() uses the stacked ensemble
+ * predictor; its votes must agree exactly with classifying through each weak
+ * learner individually.
+ */
+TEST_CASE("CompiledEnsemblePredictorTest", "[AdaBoostTest]")
+{
+  arma::mat inputData;
+
+  if (!data::Load("iris.csv", inputData))
+    FAIL("Cannot load test dataset iris.csv!");
+
+  arma::Mat<size_t> labels;
+  if (!data::Load("iris_labels.txt", labels))
+    FAIL("Cannot load labels for iris iris_labels.txt");
+
+  const size_t numClasses = max(labels.row(0)) + 1;
+
+  Perceptron<> p(inputData, labels.row(0), numClasses, 400);
+  AdaBoost<> a(inputData, labels.row(0), numClasses, p, 100, 1e-10);
+
+  arma::Row<size_t> predictedLabels;
+  arma::mat probabilities;
+  a.Classify(inputData, predictedLabels, probabilities);
+
+  // Build the reference votes by querying each weak learner on its own.
+  arma::mat refProbabilities(numClasses, inputData.n_cols, arma::fill::zeros);
+  arma::Row<size_t> tempLabels(inputData.n_cols);
+  for (size_t i = 0; i < a.WeakLearners(); ++i)
+  {
+    a.WeakLearner(i).Classify(inputData, tempLabels);
+    for (size_t j = 0; j < tempLabels.n_cols; ++j)
+      refProbabilities(tempLabels(j), j) += a.Alpha(i);
+  }
+
+  for (size_t j = 0; j < inputData.n_cols; ++j)
+  {
+    refProbabilities.col(j) /= arma::accu(refProbabilities.col(j));
+    arma::uword refLabel = 0;
+    arma::colvec(refProbabilities.col(j)).max(refLabel);
+
+    REQUIRE(predictedLabels(j) == refLabel);
+    for (size_t k = 0; k < numClasses; ++k)
+    {
+      REQUIRE(probabilities(k, j) ==
+          Approx(refProbabilities(k, j)).epsilon(1e-7));
+    }
+  }
+}
+
+/**
+ * Retraining must invalidate the stacked ensemble predictor: predictions
+ * after a second Train() call have to reflect the new weak learners, not the
+ * cached ones from the first ensemble.
+ */
+TEST_CASE("CompiledEnsemblePredictorRetrainTest", "[AdaBoostTest]")
+{
+  arma::mat inputData;
+
+  if (!data::Load("vc2.csv", inputData))
+    FAIL("Cannot load test dataset vc2.csv!");
+
+  arma::Mat<size_t> labels;
+  if (!data::Load("vc2_labels.txt", labels))
+    FAIL("Cannot load labels for vc2_labels.txt");
+
+  arma::mat irisData;
+  if (!data::Load("iris.csv", irisData))
+    FAIL("Cannot load test dataset iris.csv!");
+
+  arma::Mat<size_t> irisLabels;
+  if (!data::Load("iris_labels.txt", irisLabels))
+    FAIL("Cannot load labels for iris iris_labels.txt");
+
+  // Train, classify once to force the stacked predictor to be built, then
+  // retrain on a different dataset.
+  size_t numClasses = max(labels.row(0)) + 1;
+  Perceptron<> p(inputData, labels.row(0), numClasses, 400);
+  AdaBoost<> a(inputData, labels.row(0), numClasses, p, 50, 1e-10);
+
+  arma::Row<size_t> predictedLabels;
+  a.Classify(inputData, predictedLabels);
+
+  numClasses = max(irisLabels.row(0)) + 1;
+  Perceptron<> p2(irisData, irisLabels.row(0), numClasses, 400);
+  a.Train(irisData, irisLabels.row(0), numClasses, p2, 50, 1e-10);
+
+  a.Classify(irisData, predictedLabels);
+
+  // The predictions must match a per-learner evaluation of the new ensemble.
+  arma::mat refProbabilities(numClasses, irisData.n_cols, arma::fill::zeros);
+  arma::Row<size_t> tempLabels(irisData.n_cols);
+  for (size_t i = 0; i < a.WeakLearners(); ++i)
+  {
+    a.WeakLearner(i).Classify(irisData, tempLabels);
+    for (size_t j = 0; j < tempLabels.n_cols; ++j)
+      refProbabilities(tempLabels(j), j) += a.Alpha(i);
+  }
+
+  for (size_t j = 0; j < irisData.n_cols; ++j)
+  {
+    arma::uword refLabel = 0;
+    arma::colvec(refProbabilities.col(j)).max(refLabel);
+    REQUIRE(predictedLabels(j) == refLabel);
+  }
+}
@@ -12,6 +12,7 @@
  */
 #include <mlpack/core.hpp>
 
+#include <mlpack/methods/ann/arena.hpp>
 #include <mlpack/methods/ann/layer/layer.hpp>
 #include <mlpack/methods/ann/layer/layer_types.hpp>
 #include <mlpack/methods/ann/init_rules/random_init.hpp>
@@ -21,6 +22,7 @@
 #include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
 #include <mlpack/methods/ann/loss_functions/cross_entropy_error.hpp>
 #include <mlpack/methods/ann/ffn.hpp>
+#include <mlpack/methods/ann/fold_batch_norm.hpp>
 #include <mlpack/methods/ann/rnn.hpp>
 
 #include "test_catch_tools.hpp"
@@ -4590,6 +4592,45 @@ TEST_CASE("SimpleMultiheadAttentionTest", "[ANNLayerTest]")
   REQUIRE(gradient.n_cols == module.Parameters().n_cols);
 }
 
+/**
+ * The fused (streaming-softmax) MultiheadAttention forward path must match
+ * the standard path, including when the source sequence spans several
+ * streaming blocks and masks are applied.
+ */
+TEST_CASE("FusedMultiheadAttentionTest", "[ANNLayerTest]")
+{
+  const size_t tLen = 5;
+  const size_t sLen = 300;
+  const size_t embedDim = 4;
+  const size_t numHeads = 2;
+  const size_t bsz = 3;
+
+  const arma::mat query = 0.1 * arma::randu(embedDim * tLen, bsz);
+  const arma::mat keyValue = 0.1 * arma::randu(embedDim * sLen, bsz);
+  const arma::mat input = arma::join_cols(
+      arma::join_cols(query, keyValue), keyValue);
+
+  arma::mat attnMask = arma::zeros(tLen, sLen);
+  attnMask.col(0).fill(std::numeric_limits<double>::lowest());
+
+  arma::mat keyPaddingMask = arma::zeros(1, sLen);
+  keyPaddingMask(sLen - 1) = std::numeric_limits<double>::lowest();
+
+  MultiheadAttention<> module(tLen, sLen, embedDim, numHeads);
+  module.AttentionMask() = attnMask;
+  module.KeyPaddingMask() = keyPaddingMask;
+  module.Reset();
+  module.Parameters().randu();
+
+  arma::mat reference, fused;
+  module.Forward(input, reference);
+
+  module.FusedForward() = true;
+  module.Forward(input, fused);
+
+  CheckMatrices(reference, fused);
+}
+
 /**
  * Jacobian MultiheadAttention module test.
  */
@@ -4731,3 +4772,268 @@ TEST_CASE("GradientMultiheadAttentionTest", "[ANNLayerTest]")
 
   REQUIRE(CheckGradient(function) <= 3e-06);
 }
+
+/**
+ * Test that the quantized inference path of the Linear and LinearNoBias
+ * layers approximates the floating-point forward pass.
+ */
+TEST_CASE("QuantizedLinearLayerTest", "[ANNLayerTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(10, 16) - 0.5;
+
+  Linear<> linear(10, 6);
+  linear.Parameters().randu();
+  linear.Parameters() -= 0.5;
+  linear.Reset();
+
+  arma::mat referenceOutput, quantizedOutput;
+  linear.Forward(input, referenceOutput);
+  linear.Quantize();
+  REQUIRE(linear.Quantized());
+  linear.Forward(input, quantizedOutput);
+
+  // The int8 rounding error of a dot product over 10 terms is well below
+  // this tolerance.
+  REQUIRE(arma::abs(quantizedOutput - referenceOutput).max() < 0.05);
+
+  LinearNoBias<> linearNoBias(10, 6);
+  linearNoBias.Parameters().randu();
+  linearNoBias.Parameters() -= 0.5;
+  linearNoBias.Reset();
+
+  linearNoBias.Forward(input, referenceOutput);
+  linearNoBias.Quantize();
+  REQUIRE(linearNoBias.Quantized());
+  linearNoBias.Forward(input, quantizedOutput);
+
+  REQUIRE(arma::abs(quantizedOutput - referenceOutput).max() < 0.05);
+}
+
+/**
+ * Test that the quantized inference path of the Convolution layer
+ * approximates the floating-point forward pass.
+ */
+TEST_CASE("QuantizedConvolutionLayerTest", "[ANNLayerTest]")
+{
+  Convolution<> module(2, 3, 3, 3, 1, 1, 1, 1, 7, 7);
+  module.Parameters().randu();
+  module.Parameters() -= 0.5;
+  module.Reset();
+
+  arma::mat input = arma::randu<arma::mat>(7 * 7 * 2, 4) - 0.5;
+  arma::mat referenceOutput, quantizedOutput;
+  module.Forward(input, referenceOutput);
+  module.Quantize();
+  REQUIRE(module.Quantized());
+  module.Forward(input, quantizedOutput);
+
+  REQUIRE(quantizedOutput.n_rows == referenceOutput.n_rows);
+  REQUIRE(quantizedOutput.n_cols == referenceOutput.n_cols);
+
+  // The int8 rounding error of an 18-term patch dot product is well below
+  // this tolerance.
+  REQUIRE(arma::abs(quantizedOutput - referenceOutput).max() < 0.1);
+}
+
+/**
+ * Test that folding a BatchNorm layer into the preceding Linear layer leaves
+ * the Predict() output unchanged and removes the layer from the network.
+ */
+TEST_CASE("FoldBatchNormLinearTest", "[ANNLayerTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(5, 8);
+
+  FFN<MeanSquaredError<> > model;
+  model.Add<Linear<> >(5, 3);
+  model.Add<BatchNorm<> >(3);
+  model.Add<Linear<> >(3, 2);
+  model.ResetParameters();
+  model.Parameters().randu();
+
+  // Simulate trained running statistics.
+  BatchNorm<>* batchNorm = boost::get<BatchNorm<>*>(model.Model()[1]);
+  batchNorm->TrainingMean() = arma::randu<arma::mat>(3, 1);
+  batchNorm->TrainingVariance() = arma::randu<arma::mat>(3, 1) + 0.5;
+
+  arma::mat before, after;
+  model.Predict(input, before);
+
+  const size_t parameterSize = model.Parameters().n_elem;
+  FoldBatchNorm(model);
+
+  REQUIRE(model.Model().size() == 2);
+  REQUIRE(model.Parameters().n_elem == parameterSize - 6);
+
+  model.Predict(input, after);
+  CheckMatrices(before, after, 1e-5);
+}
+
+/**
+ * Test that folding a BatchNorm layer into the preceding Convolution layer
+ * leaves the Predict() output unchanged.
+ */
+TEST_CASE("FoldBatchNormConvolutionTest", "[ANNLayerTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(7 * 7 * 2, 4);
+
+  FFN<MeanSquaredError<> > model;
+  model.Add<Convolution<> >(2, 3, 3, 3, 1, 1, 0, 0, 7, 7);
+  model.Add<BatchNorm<> >(3);
+  model.Add<Linear<> >(5 * 5 * 3, 2);
+  model.ResetParameters();
+  model.Parameters().randu();
+
+  BatchNorm<>* batchNorm = boost::get<BatchNorm<>*>(model.Model()[1]);
+  batchNorm->TrainingMean() = arma::randu<arma::mat>(3, 1);
+  batchNorm->TrainingVariance() = arma::randu<arma::mat>(3, 1) + 0.5;
+
+  arma::mat before, after;
+  model.Predict(input, before);
+
+  FoldBatchNorm(model);
+  REQUIRE(model.Model().size() == 2);
+
+  model.Predict(input, after);
+  CheckMatrices(before, after, 1e-5);
+}
+
+/**
+ * FusedActivation layer test: a fused run of activation functions must match
+ * the equivalent stack of separate BaseLayer modules, forward and backward.
+ */
+TEST_CASE("FusedActivationLayerTest", "[ANNLayerTest]")
+{
+  arma::mat input = arma::randn(10, 16);
+
+  // Reference: two separate layers.
+  ReLULayer<> relu;
+  TanHLayer<> tanhLayer;
+
+  arma::mat reluOutput, expectedOutput;
+  relu.Forward(input, reluOutput);
+  tanhLayer.Forward(reluOutput, expectedOutput);
+
+  // Fused: one layer applying both functions.
+  FusedActivation<RectifierFunction, TanhFunction> fused;
+
+  arma::mat output;
+  fused.Forward(input, output);
+
+  CheckMatrices(output, expectedOutput);
+
+  // Backward: the fused derivative must equal the chained derivatives.
+  arma::mat gy = arma::randn(10, 16);
+
+  arma::mat tanhDelta, expectedDelta;
+  tanhLayer.Backward(expectedOutput, gy, tanhDelta);
+  relu.Backward(reluOutput, tanhDelta, expectedDelta);
+
+  arma::mat delta;
+  fused.Backward(output, gy, delta);
+
+  CheckMatrices(delta, expectedDelta);
+}
+
+/**
+ * Arena allocator test: scoped allocations must recycle memory on the same
+ * thread, and matrices drawn from the arena must behave like ordinary
+ * matrices while the scope is live.
+ */
+TEST_CASE("ANNArenaAllocatorTest", "[ANNLayerTest]")
+{
+  double* first = NULL;
+
+  {
+    Arena<double>::Scope scope;
+    arma::mat a = Arena<double>::Get().Matrix(10, 16);
+    first = a.memptr();
+
+    a.fill(3.0);
+    REQUIRE(arma::accu(a) == Approx(3.0 * 10 * 16));
+
+    // A second allocation in the same scope must not overlap the first.
+    arma::mat b = Arena<double>::Get().Matrix(10, 16);
+    REQUIRE(b.memptr() != first);
+  }
+
+  // After the scope has rewound, the same memory is handed out again.
+  Arena<double>::Scope scope;
+  arma::mat c = Arena<double>::Get().Matrix(4, 4);
+  REQUIRE(c.memptr() == first);
+
+  // Layers that draw temporaries from the arena must still be correct when
+  // their Backward() calls nest (the outer scope survives the inner one).
+  arma::mat input = arma::randn(10, 16);
+  ReLULayer<> relu;
+  arma::mat output;
+  relu.Forward(input, output);
+
+  arma::mat gy = arma::randn(10, 16);
+  arma::mat g1, g2;
+  relu.Backward(output, gy, g1);
+  relu.Backward(output, gy, g2);
+
+  CheckMatrices(g1, g2);
+  CheckMatrices(g1, gy % arma::conv_to<arma::mat>::from(output > 0));
+}
+
+/**
+ * Sparse-input Linear layer test: the sparse overloads of Forward(),
+ * Backward() and Gradient() must match the dense path exactly.
+ */
+TEST_CASE("SparseLinearLayerTest", "[ANNLayerTest]")
+{
+  Linear<> module(50, 10);
+  module.Parameters().randu();
+  module.Reset();
+
+  // A multi-hot input: 1% dense.
+  arma::sp_mat sparseInput = arma::sprandu<arma::sp_mat>(50, 8, 0.01);
+  arma::mat denseInput(sparseInput);
+
+  arma::mat denseOutput, sparseOutput;
+  module.Forward(denseInput, denseOutput);
+  module.Forward(sparseInput, sparseOutput);
+  CheckMatrices(denseOutput, sparseOutput);
+
+  arma::mat gy = arma::randn(10, 8);
+  arma::mat denseDelta, sparseDelta;
+  module.Backward(denseInput, gy, denseDelta);
+  module.Backward(sparseInput, gy, sparseDelta);
+  CheckMatrices(denseDelta, sparseDelta);
+
+  arma::mat denseGradient(module.Parameters().n_elem, 1);
+  arma::mat sparseGradient(module.Parameters().n_elem, 1);
+  module.Gradient(denseInput, gy, denseGradient);
+  module.Gradient(sparseInput, gy, sparseGradient);
+  CheckMatrices(denseGradient, sparseGradient);
+}
+
+/**
+ * Check that the default Gemm() backend matches plain Armadillo products for
+ * every combination of the transposition flags.
+ */
+TEST_CASE("GemmBackendTest", "[ANNLayerTest]")
+{
+  const arma::mat a = arma::randu<arma::mat>(10, 20);
+  const arma::mat b = arma::randu<arma::mat>(20, 15);
+
+  arma::mat c;
+  Gemm(a, b, c);
+  CheckMatrices(c, arma::mat(a * b));
+
+  Gemm(a.t().eval(), b, c, true);
+  CheckMatrices(c, arma::mat(a * b));
+
+  Gemm(a, b.t().eval(), c, false, true);
+  CheckMatrices(c, arma::mat(a * b));
+
+  Gemm(b, a, c, true, true);
+  CheckMatrices(c, arma::mat((a * b).t()));
+
+  // The result matrix may be a preallocated non-owning alias.
+  arma::mat storage(10, 15);
+  arma::mat alias(storage.memptr(), 10, 15, false, true);
+  Gemm(a, b, alias);
+  CheckMatrices(storage, arma::mat(a * b));
+}
@@ -111,3 +111,22 @@ TEST_CASE("GradientOrthogonalRegularizerTest", "[ANNRegularizerTest]")
 
   REQUIRE(CheckRegularizerGradient(function) <= 1e-4);
 }
+
+TEST_CASE("WeightDecayTest", "[ANNRegularizerTest]")
+{
+  const double factor = 0.01;
+  WeightDecay reg(factor);
+
+  arma::mat weight = arma::randu(10, 10);
+  arma::mat gradient = arma::randu(10 * 10, 1);
+
+  const arma::mat expectedWeight = (1.0 - factor) * weight;
+  const arma::mat expectedGradient = gradient;
+
+  // Decoupled weight decay shrinks the weights in place and leaves the
+  // gradient untouched.
+  reg.Evaluate(weight, gradient);
+
+  CheckMatrices(weight, expectedWeight, 1e-10);
+  CheckMatrices(gradient, expectedGradient, 1e-10);
+}
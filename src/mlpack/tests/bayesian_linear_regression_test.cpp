@@ -193,3 +193,61 @@ TEST_CASE("EqualtoRidge", "[BayesianLinearRegressionTest]")
 
   REQUIRE(trial <= 3);
 }
+
+// An incrementally-updated model should match a model trained on all of the
+// data at once.
+TEST_CASE("IncrementalUpdateMatchesBatch", "[BayesianLinearRegressionTest]")
+{
+  arma::mat matX;
+  arma::rowvec y;
+  GenerateProblem(matX, y, 300, 10, 0.5);
+
+  // Use a tight tolerance so both fits converge to the same fixed point.
+  BayesianLinearRegression batch(true, true, 200, 1e-12);
+  batch.Train(matX, y);
+
+  // Feed the same data as an initial fit plus two refreshes.
+  BayesianLinearRegression incremental(true, true, 200, 1e-12);
+  incremental.Train(matX.cols(0, 199), y.subvec(0, 199));
+  incremental.Update(matX.cols(200, 249), y.subvec(200, 249));
+  incremental.Update(matX.cols(250, 299), y.subvec(250, 299));
+
+  REQUIRE(incremental.Alpha() == Approx(batch.Alpha()).epsilon(1e-6));
+  REQUIRE(incremental.Beta() == Approx(batch.Beta()).epsilon(1e-6));
+  for (size_t i = 0; i < batch.Omega().n_elem; ++i)
+    REQUIRE(incremental.Omega()[i] == Approx(batch.Omega()[i]).margin(1e-8));
+
+  // The predictive uncertainties come from the posterior covariance, so they
+  // must match too.
+  arma::rowvec batchPred, batchStd, incrementalPred, incrementalStd;
+  batch.Predict(matX, batchPred, batchStd);
+  incremental.Predict(matX, incrementalPred, incrementalStd);
+  for (size_t i = 0; i < batchPred.n_elem; ++i)
+  {
+    REQUIRE(incrementalPred[i] == Approx(batchPred[i]).margin(1e-8));
+    REQUIRE(incrementalStd[i] == Approx(batchStd[i]).margin(1e-8));
+  }
+}
+
+// Update() on an untrained model is a training run, and mismatched chunks are
+// rejected.
+TEST_CASE("UpdateEdgeCases", "[BayesianLinearRegressionTest]")
+{
+  arma::mat matX;
+  arma::rowvec y;
+  GenerateProblem(matX, y, 100, 5, 0.5);
+
+  BayesianLinearRegression fresh(true, false, 200, 1e-12);
+  fresh.Update(matX, y);
+
+  BayesianLinearRegression trained(true, false, 200, 1e-12);
+  trained.Train(matX, y);
+
+  for (size_t i = 0; i < trained.Omega().n_elem; ++i)
+    REQUIRE(fresh.Omega()[i] == Approx(trained.Omega()[i]).margin(1e-10));
+
+  // A chunk with the wrong dimensionality must be rejected.
+  arma::mat wrongX(7, 10, arma::fill::randu);
+  arma::rowvec wrongY(10, arma::fill::randn);
+  REQUIRE_THROWS_AS(trained.Update(wrongX, wrongY), std::invalid_argument);
+}
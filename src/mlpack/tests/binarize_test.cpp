@@ -65,3 +65,55 @@ TEST_CASE("BinerizeAll", "[BinarizeTest]")
   REQUIRE(output(2, 1) == Approx(1.0).epsilon(1e-7)); // 8
   REQUIRE(output(2, 2) == Approx(1.0).epsilon(1e-7)); // 9
 }
+
+TEST_CASE("BinarizeInPlace", "[BinarizeTest]")
+{
+  mat input = randu<mat>(10, 20);
+
+  // The in-place overloads must give the same results as the out-of-place
+  // ones.
+  const double threshold = 0.5;
+
+  mat output;
+  Binarize<double>(input, output, threshold);
+
+  mat inPlace = input;
+  Binarize<double>(inPlace, threshold);
+
+  CheckMatrices(output, inPlace);
+
+  // And the same for the single-dimension overload.
+  const size_t dimension = 3;
+  Binarize<double>(input, output, threshold, dimension);
+
+  inPlace = input;
+  Binarize<double>(inPlace, threshold, dimension);
+
+  CheckMatrices(output, inPlace);
+}
+
+TEST_CASE("ElementwiseTransformTest", "[BinarizeTest]")
+{
+  mat input = randu<mat>(7, 13);
+
+  // Out-of-place and in-place elementwise transformations.
+  mat output;
+  ElementwiseTransform(input, output,
+      [](const double value) { return 2.0 * value + 1.0; });
+  CheckMatrices(output, mat(2.0 * input + 1.0));
+
+  mat inPlace = input;
+  ElementwiseTransform(inPlace,
+      [](const double value) { return 2.0 * value + 1.0; });
+  CheckMatrices(output, inPlace);
+
+  // Dimension-aware transformation: scale each dimension by its row index.
+  DimensionwiseTransform(input, output,
+      [](const double value, const size_t dimension)
+      { return value * (double) dimension; });
+
+  for (size_t i = 0; i < input.n_rows; ++i)
+  {
+    CheckMatrices(mat(output.row(i)), mat(input.row(i) * (double) i));
+  }
+}
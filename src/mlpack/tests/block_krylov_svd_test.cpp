@@ -86,6 +86,41 @@ TEST_CASE("RandomizedBlockKrylovSVDReconstructionError",
   REQUIRE(error == Approx(0.0).margin(1e-7));
 }
 
+/**
+ * A tall matrix splits the orthogonalization into several row blocks; the
+ * factorization must stay accurate through the tiled products and the TSQR
+ * step.
+ */
+TEST_CASE("RandomizedBlockKrylovSVDTallMatrixTest", "[BlockKrylovSVDTest]")
+{
+  arma::mat U = arma::randn<arma::mat>(800, 3);
+  arma::mat V = arma::randn<arma::mat>(40, 3);
+
+  arma::mat R;
+  arma::qr_econ(U, R, U);
+  arma::qr_econ(V, R, V);
+
+  arma::vec s("1 0.1 0.01");
+
+  arma::mat data = U * arma::diagmat(s) * V.t();
+
+  arma::mat U2, V2;
+  arma::vec s2;
+
+  svd::RandomizedBlockKrylovSVD rSVD(20, 10);
+  rSVD.Apply(data, U2, s2, V2, 3);
+
+  // The singular value error should be small.
+  double error = arma::norm(s2.head(3) - s, "frob") / arma::norm(s, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-5));
+
+  arma::mat reconstruct = U2 * arma::diagmat(s2) * V2.t();
+
+  // The relative reconstruction error should be small.
+  error = arma::norm(data - reconstruct, "frob") / arma::norm(data, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-7));
+}
+
 /*
  * Check if the method can handle noisy matrices.
  */
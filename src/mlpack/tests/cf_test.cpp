@@ -516,6 +516,15 @@ BOOST_AUTO_TEST_CASE(CFGetRecommendationsAllUsersRandSVDTest)
   GetRecommendationsAllUsers<RandomizedSVDPolicy>();
 }
 
+/**
+ * Make sure that correct number of recommendations are generated when query
+ * set for sparse truncated SVD.
+ */
+BOOST_AUTO_TEST_CASE(CFGetRecommendationsAllUsersSparseSVDTest)
+{
+  GetRecommendationsAllUsers<SparseSVDPolicy>();
+}
+
 /**
  * Make sure that correct number of recommendations are generated when query
  * set for regularized SVD.
@@ -652,6 +661,44 @@ BOOST_AUTO_TEST_CASE(CFGetRecommendationsQueriedUserSVDPPTest)
   GetRecommendationsQueriedUser<SVDPlusPlusPolicy>();
 }
 
+/**
+ * Make sure that cached neighborhood lookups give the same recommendations as
+ * a fresh neighbor search, and that the cache is invalidated by retraining.
+ */
+BOOST_AUTO_TEST_CASE(CFPrecomputedNeighborhoodsTest)
+{
+  NMFPolicy decomposition;
+  const size_t numRecs = 3;
+
+  // Load GroupLens data.
+  arma::mat dataset;
+  data::Load("GroupLensSmall.csv", dataset);
+
+  CFType<NMFPolicy> c(dataset, decomposition, 5, 5, 30);
+
+  // Generate recommendations with a fresh neighbor search.
+  arma::Mat<size_t> recommendations;
+  c.GetRecommendations(numRecs, recommendations);
+
+  // Now precompute the neighborhoods and generate recommendations again; the
+  // factorization has not changed, so the results must be identical.
+  BOOST_REQUIRE_EQUAL(c.NeighborhoodCached(), false);
+  c.PrecomputeNeighborhoods();
+  BOOST_REQUIRE_EQUAL(c.NeighborhoodCached(), true);
+
+  arma::Mat<size_t> cachedRecommendations;
+  c.GetRecommendations(numRecs, cachedRecommendations);
+
+  BOOST_REQUIRE_EQUAL(recommendations.n_rows, cachedRecommendations.n_rows);
+  BOOST_REQUIRE_EQUAL(recommendations.n_cols, cachedRecommendations.n_cols);
+  for (size_t i = 0; i < recommendations.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(recommendations[i], cachedRecommendations[i]);
+
+  // Retraining must invalidate the cache.
+  c.Train(dataset, decomposition, 30);
+  BOOST_REQUIRE_EQUAL(c.NeighborhoodCached(), false);
+}
+
 /**
  * Make sure recommendations that are generated are reasonably accurate
  * for randomized SVD.
@@ -734,6 +781,13 @@ BOOST_AUTO_TEST_CASE(CFPredictRandSVDTest)
   CFPredict<RandomizedSVDPolicy>();
 }
 
+// Make sure that Predict() is returning reasonable results for the sparse
+// truncated SVD.
+BOOST_AUTO_TEST_CASE(CFPredictSparseSVDTest)
+{
+  CFPredict<SparseSVDPolicy>();
+}
+
 // Make sure that Predict() is returning reasonable results for regularized SVD.
 BOOST_AUTO_TEST_CASE(CFPredictRegSVDTest)
 {
@@ -982,6 +1036,15 @@ BOOST_AUTO_TEST_CASE(SerializationRandSVDTest)
   Serialization<RandomizedSVDPolicy>();
 }
 
+/**
+ * Ensure we can load and save the CF model using the sparse truncated SVD
+ * policy.
+ */
+BOOST_AUTO_TEST_CASE(SerializationSparseSVDTest)
+{
+  Serialization<SparseSVDPolicy>();
+}
+
 /**
  * Ensure we can load and save the CF model using batch SVD policy.
  */
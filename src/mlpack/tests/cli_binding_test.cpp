@@ -11,6 +11,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/bindings/cli/cli_option.hpp>
+#include <mlpack/bindings/cli/end_program.hpp>
 #include <mlpack/core/kernels/gaussian_kernel.hpp>
 
 #include <boost/test/unit_test.hpp>
@@ -255,6 +256,37 @@ BOOST_AUTO_TEST_CASE(GetParamModelTest)
   delete *output;
 }
 
+/**
+ * Make sure CleanMemory() leaves addresses in the keep set alone; daemon mode
+ * relies on this to carry cached input models over to the next command.
+ */
+BOOST_AUTO_TEST_CASE(CleanMemoryKeepAddressesTest)
+{
+  IO::ClearSettings();
+
+  CLIOption<GaussianKernel*> co((GaussianKernel*) NULL, "kernel", "kernel",
+      "k", "kernel::GaussianKernel", false, true, false);
+
+  // Attach an allocated model to the parameter.
+  typedef tuple<GaussianKernel*, string> TupleType;
+  util::ParamData& d = IO::Parameters()["kernel"];
+  GaussianKernel* kernel = new GaussianKernel(3.0);
+  get<0>(*boost::any_cast<TupleType>(&d.value)) = kernel;
+  d.input = true;
+  d.loaded = true;
+
+  // With the address in the keep set, the model must survive the cleanup.
+  unordered_set<void*> keep;
+  keep.insert((void*) kernel);
+  CleanMemory(keep);
+  BOOST_REQUIRE_EQUAL(kernel->Bandwidth(), 3.0);
+
+  // Without the keep set, CleanMemory() deletes it.
+  CleanMemory();
+
+  IO::ClearSettings();
+}
+
 BOOST_AUTO_TEST_CASE(RawParamDoubleTest)
 {
   // This should function the same as GetParam for doubles.
@@ -16,6 +16,8 @@
 #include <mlpack/methods/ann/convolution_rules/naive_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/fft_convolution.hpp>
 #include <mlpack/methods/ann/convolution_rules/svd_convolution.hpp>
+#include <mlpack/methods/ann/convolution_rules/im2col_convolution.hpp>
+#include <mlpack/methods/ann/layer/layer.hpp>
 
 #include "serialization_catch.hpp"
 #include "catch.hpp"
@@ -148,6 +150,10 @@ TEST_CASE("ValidConvolution2DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<ValidConvolution> >(input, filter,
       output);
+
+  // Perform the convolution through im2col lowering and GEMM.
+  Convolution2DMethodTest<Im2ColConvolution<ValidConvolution> >(input, filter,
+      output);
 }
 
 /**
@@ -185,6 +191,10 @@ TEST_CASE("FullConvolution2DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution2DMethodTest<SVDConvolution<FullConvolution> >(input, filter,
       output);
+
+  // Perform the convolution through im2col lowering and GEMM.
+  Convolution2DMethodTest<Im2ColConvolution<FullConvolution> >(input, filter,
+      output);
 }
 
 /**
@@ -230,6 +240,10 @@ TEST_CASE("ValidConvolution3DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<ValidConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col lowering and GEMM.
+  Convolution3DMethodTest<Im2ColConvolution<ValidConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -279,6 +293,10 @@ TEST_CASE("FullConvolution3DTest", "[ConvolutionTest]")
   // speed up the computation.
   Convolution3DMethodTest<SVDConvolution<FullConvolution> >(inputCube,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col lowering and GEMM.
+  Convolution3DMethodTest<Im2ColConvolution<FullConvolution> >(inputCube,
+      filterCube, outputCube);
 }
 
 /**
@@ -321,6 +339,10 @@ TEST_CASE("ValidConvolutionBatchTest", "[ConvolutionTest]")
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<ValidConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col lowering and GEMM.
+  ConvolutionMethodBatchTest<Im2ColConvolution<ValidConvolution> >(input,
+      filterCube, outputCube);
 }
 
 /**
@@ -367,4 +389,35 @@ TEST_CASE("FullConvolutionBatchTest", "[ConvolutionTest]")
   // speed up the computation.
   ConvolutionMethodBatchTest<SVDConvolution<FullConvolution> >(input,
       filterCube, outputCube);
+
+  // Perform the convolution through im2col lowering and GEMM.
+  ConvolutionMethodBatchTest<Im2ColConvolution<FullConvolution> >(input,
+      filterCube, outputCube);
+}
+
+/**
+ * The im2col GEMM path of the Convolution layer must produce the same output
+ * as the naive per-map path for identical weights.
+ */
+TEST_CASE("ConvolutionLayerIm2ColForwardTest", "[ConvolutionTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(8 * 8 * 3, 4);
+
+  Convolution<> naiveLayer(3, 5, 3, 3, 1, 1, 1, 1, 8, 8);
+  naiveLayer.Parameters().randu();
+  naiveLayer.Reset();
+
+  Convolution<Im2ColConvolution<ValidConvolution> > im2colLayer(
+      3, 5, 3, 3, 1, 1, 1, 1, 8, 8);
+  im2colLayer.Parameters() = naiveLayer.Parameters();
+  im2colLayer.Reset();
+
+  arma::mat naiveOutput, im2colOutput;
+  naiveLayer.Forward(input, naiveOutput);
+  im2colLayer.Forward(input, im2colOutput);
+
+  REQUIRE(naiveOutput.n_rows == im2colOutput.n_rows);
+  REQUIRE(naiveOutput.n_cols == im2colOutput.n_cols);
+  for (size_t i = 0; i < naiveOutput.n_elem; ++i)
+    REQUIRE(naiveOutput[i] == Approx(im2colOutput[i]).epsilon(1e-10));
 }
@@ -15,6 +15,7 @@
 #include <mlpack/core/cv/metrics/accuracy.hpp>
 #include <mlpack/core/cv/metrics/f1.hpp>
 #include <mlpack/core/cv/metrics/mse.hpp>
+#include <mlpack/core/cv/metrics/multi_metric.hpp>
 #include <mlpack/core/cv/metrics/precision.hpp>
 #include <mlpack/core/cv/metrics/recall.hpp>
 #include <mlpack/core/cv/metrics/r2_score.hpp>
@@ -146,6 +147,62 @@ TEST_CASE("MulticlassClassificationMetricsTest", "[CVTest]")
           == Approx(macroaveragedF1).epsilon(1e-7));
 }
 
+/**
+ * Test that MultiMetric agrees with the single-metric classes while
+ * classifying the data only once.
+ */
+TEST_CASE("MultiMetricTest", "[CVTest]")
+{
+  // Using the same data for training and testing.
+  arma::mat data = arma::linspace<arma::rowvec>(1.0, 12.0, 12);
+
+  // Labels that will be considered as "ground truth".
+  arma::Row<size_t> labels("0 1  0 1  2 2 1 2  3 3 3 3");
+
+  // These labels should be predicted in response to the data since we use them
+  // for training.
+  arma::Row<size_t> predictedLabels("0 0  1 1  2 2 2 2  3 3 3 3");
+  size_t numClasses = 4;
+
+  NaiveBayesClassifier<> nb(data, predictedLabels, numClasses);
+
+  MultiMetric metrics(nb, data, labels);
+
+  // Every metric must match the value of the corresponding single-metric
+  // class.
+  REQUIRE(metrics.Accuracy() ==
+      Approx(Accuracy::Evaluate(nb, data, labels)).epsilon(1e-7));
+
+  REQUIRE(metrics.Precision<Micro>() ==
+      Approx(Precision<Micro>::Evaluate(nb, data, labels)).epsilon(1e-7));
+  REQUIRE(metrics.Recall<Micro>() ==
+      Approx(Recall<Micro>::Evaluate(nb, data, labels)).epsilon(1e-7));
+  REQUIRE(metrics.F1<Micro>() ==
+      Approx(F1<Micro>::Evaluate(nb, data, labels)).epsilon(1e-7));
+
+  REQUIRE(metrics.Precision<Macro>() ==
+      Approx(Precision<Macro>::Evaluate(nb, data, labels)).epsilon(1e-7));
+  REQUIRE(metrics.Recall<Macro>() ==
+      Approx(Recall<Macro>::Evaluate(nb, data, labels)).epsilon(1e-7));
+  REQUIRE(metrics.F1<Macro>() ==
+      Approx(F1<Macro>::Evaluate(nb, data, labels)).epsilon(1e-7));
+
+  // Binary metrics on a binary problem.
+  arma::mat binaryData = arma::linspace<arma::rowvec>(1.0, 10.0, 10);
+  arma::Row<size_t> binaryLabels("0 0 1 0 0  1 0 1 0 1");
+  arma::Row<size_t> binaryPredictedLabels("0 0 0 0 0  1 1 1 1 1");
+
+  LogisticRegression<> lr(binaryData, binaryPredictedLabels);
+
+  MultiMetric binaryMetrics(lr, binaryData, binaryLabels);
+
+  REQUIRE(binaryMetrics.Accuracy() == Approx(0.7).epsilon(1e-7));
+  REQUIRE(binaryMetrics.Precision<Binary>() == Approx(0.6).epsilon(1e-7));
+  REQUIRE(binaryMetrics.Recall<Binary>() == Approx(0.75).epsilon(1e-7));
+  double f1 = 2 * 0.6 * 0.75 / (0.6 + 0.75);
+  REQUIRE(binaryMetrics.F1<Binary>() == Approx(f1).epsilon(1e-7));
+}
+
 /**
  * Test the mean squared error.
  */
@@ -510,6 +567,29 @@ TEST_CASE("KFoldCVAccuracyTest", "[CVTest]")
   REQUIRE_NOTHROW(cv.Model());
 }
 
+/**
+ * Test that the concurrently-trained folds give the same score on repeated
+ * runs, and that Model() still returns the last fold's model.
+ */
+TEST_CASE("KFoldCVParallelFoldsTest", "[CVTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(5, 200);
+  arma::rowvec responses = 2.0 * data.row(0) - data.row(3) + 0.5;
+
+  // 10-fold cross-validation, no shuffling, so each run trains on exactly the
+  // same folds.
+  KFoldCV<LinearRegression, MSE> cv(10, data, responses, false);
+
+  const double firstScore = cv.Evaluate();
+  REQUIRE(cv.Evaluate() == Approx(firstScore).epsilon(1e-7));
+
+  // The responses are a noiseless linear function of the data, so every fold
+  // (including the retained last one) should fit it almost exactly.
+  REQUIRE(firstScore == Approx(0.0).margin(1e-7));
+  REQUIRE(MSE::Evaluate(cv.Model(), data, responses) ==
+      Approx(0.0).margin(1e-7));
+}
+
 /**
  * Test k-fold cross-validation with weighted linear regression.
  */
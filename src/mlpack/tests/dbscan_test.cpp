@@ -181,6 +181,54 @@ TEST_CASE("TinyEpsilonSingleModeTest", "[DBSCANTest]")
     REQUIRE(assignments[i] == SIZE_MAX);
 }
 
+/**
+ * The blocked streaming search must produce the same clustering as the batch
+ * search, whatever the block size (including blocks that don't evenly divide
+ * the dataset).  Cluster numbering may differ, so we compare the partitions.
+ */
+TEST_CASE("BlockedSingleModeEquivalenceTest", "[DBSCANTest]")
+{
+  arma::mat points(3, 300, arma::fill::randu);
+  // Spread three clumps apart so there is real cluster structure.
+  points.cols(100, 199) += 5.0;
+  points.cols(200, 299) -= 5.0;
+
+  DBSCAN<> batch(0.5, 3, true);
+  arma::Row<size_t> batchAssignments;
+  const size_t batchClusters = batch.Cluster(points, batchAssignments);
+
+  for (size_t blockSize : { 1, 7, 64, 1000 })
+  {
+    DBSCAN<> blocked(0.5, 3, false);
+    blocked.BlockSize() = blockSize;
+
+    arma::Row<size_t> assignments;
+    const size_t clusters = blocked.Cluster(points, assignments);
+
+    REQUIRE(clusters == batchClusters);
+
+    // Build the label mapping from the blocked clustering to the batch
+    // clustering, requiring it to be consistent in both directions.
+    std::map<size_t, size_t> toBatch, fromBatch;
+    for (size_t i = 0; i < points.n_cols; ++i)
+    {
+      if (batchAssignments[i] == SIZE_MAX || assignments[i] == SIZE_MAX)
+      {
+        REQUIRE(batchAssignments[i] == assignments[i]);
+        continue;
+      }
+
+      if (toBatch.count(assignments[i]) == 0)
+        toBatch[assignments[i]] = batchAssignments[i];
+      if (fromBatch.count(batchAssignments[i]) == 0)
+        fromBatch[batchAssignments[i]] = assignments[i];
+
+      REQUIRE(toBatch[assignments[i]] == batchAssignments[i]);
+      REQUIRE(fromBatch[batchAssignments[i]] == assignments[i]);
+    }
+  }
+}
+
 /**
  * Check that outliers are properly labeled as noise.
  */
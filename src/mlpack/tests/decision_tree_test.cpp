@@ -376,6 +376,99 @@ TEST_CASE("BestBinaryNumericSplitNoGainTest", "[DecisionTreeTest]")
   REQUIRE(classProbabilities.n_elem == 0);
 }
 
+/**
+ * Check that the HistogramNumericSplit will split on an obviously splittable
+ * dimension.
+ */
+TEST_CASE("HistogramNumericSplitSimpleSplitTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+  weights.ones();
+
+  arma::vec classProbabilities;
+  HistogramNumericSplit<GiniGain>::template AuxiliarySplitInfo<double> aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 3, 1e-7, classProbabilities,
+      aux);
+  const double weightedGain =
+      HistogramNumericSplit<GiniGain>::SplitIfBetter<true>(bestGain, values,
+      labels, 2, weights, 3, 1e-7, classProbabilities, aux);
+
+  // Make sure that a split was made.
+  REQUIRE(gain > bestGain);
+
+  // Make sure weight works and is not different than the unweighted one.
+  REQUIRE(gain == weightedGain);
+
+  // The split is perfect, so we should be able to accomplish a gain of 0.
+  REQUIRE(gain == Approx(0.0).margin(1e-7));
+
+  // The class probabilities, for this split, hold the splitting point, which
+  // should be between 4 and 5.
+  REQUIRE(classProbabilities.n_elem == 1);
+  REQUIRE(classProbabilities[0] > 0.4);
+  REQUIRE(classProbabilities[0] < 0.5);
+}
+
+/**
+ * Check that the HistogramNumericSplit won't split if not enough points are
+ * given.
+ */
+TEST_CASE("HistogramNumericSplitMinSamplesTest", "[DecisionTreeTest]")
+{
+  arma::vec values("0.0 0.1 0.2 0.3 0.4 0.5 0.6 0.7 0.8 0.9 1.0");
+  arma::Row<size_t> labels("0 0 0 0 0 1 1 1 1 1 1");
+  arma::rowvec weights(labels.n_elem);
+
+  arma::vec classProbabilities;
+  HistogramNumericSplit<GiniGain>::template AuxiliarySplitInfo<double> aux;
+
+  // Call the method to do the splitting.
+  const double bestGain = GiniGain::Evaluate<false>(labels, 2, weights);
+  const double gain = HistogramNumericSplit<GiniGain>::SplitIfBetter<false>(
+      bestGain, values, labels, 2, weights, 8, 1e-7, classProbabilities,
+      aux);
+
+  // Make sure that no split was made.
+  REQUIRE(gain == DBL_MAX);
+  REQUIRE(classProbabilities.n_elem == 0);
+}
+
+/**
+ * Check that a decision tree using the HistogramNumericSplit can learn a
+ * simple numeric dataset about as well as the exhaustive split.
+ */
+TEST_CASE("HistogramNumericSplitTreeTest", "[DecisionTreeTest]")
+{
+  // Two well-separated Gaussian classes in three dimensions.
+  arma::mat dataset(3, 1000, arma::fill::randn);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 500; i < 1000; ++i)
+  {
+    dataset.col(i) += 4.0;
+    labels[i] = 1;
+  }
+  labels.head(500).zeros();
+
+  DecisionTree<GiniGain, HistogramNumericSplit> tree(dataset, labels, 2, 5);
+
+  arma::Row<size_t> predictions;
+  tree.Classify(dataset, predictions);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < labels.n_elem; ++i)
+    if (predictions[i] == labels[i])
+      ++correct;
+
+  // The classes are far apart, so accuracy should be very high.
+  REQUIRE(correct > 950);
+}
+
 /**
  * Check that the AllCategoricalSplit will split when the split is obviously
  * better.
@@ -285,6 +285,55 @@ TEST_CASE("TestGrow", "[DETTest]")
   REQUIRE(alpha == Approx(min(rootAlpha, rAlpha)).epsilon(1e-12));
 }
 
+TEST_CASE("TestGrowLargeTree", "[DETTest]")
+{
+  // Large enough that independent subtrees are grown concurrently; the result
+  // must still be a valid tree built over a permutation of the input.
+  arma::mat testData(3, 400, arma::fill::randu);
+  const arma::mat origData(testData);
+
+  arma::Col<size_t> oTest =
+      arma::linspace<arma::Col<size_t>>(0, 399, 400);
+
+  DTree<arma::mat> tree(testData);
+  const double alpha = tree.Grow(testData, oTest, false, 10, 5);
+
+  REQUIRE(std::isfinite(alpha) == true);
+
+  // oTest must be a permutation of the point indices, and the reordered
+  // dataset must be the original columns in that order.
+  arma::Col<size_t> counts(400, arma::fill::zeros);
+  for (size_t i = 0; i < 400; ++i)
+  {
+    counts(oTest[i])++;
+    REQUIRE(arma::approx_equal(testData.col(i), origData.col(oTest[i]),
+        "absdiff", 1e-15) == true);
+  }
+  for (size_t i = 0; i < 400; ++i)
+    REQUIRE(counts(i) == 1);
+
+  // Count the leaves by traversal; this must agree with the stored subtree
+  // leaf count.
+  size_t leaves = 0;
+  std::vector<const DTree<arma::mat>*> toVisit;
+  toVisit.push_back(&tree);
+  while (!toVisit.empty())
+  {
+    const DTree<arma::mat>* node = toVisit.back();
+    toVisit.pop_back();
+    if (node->Left() == NULL && node->Right() == NULL)
+    {
+      ++leaves;
+    }
+    else
+    {
+      toVisit.push_back(node->Left());
+      toVisit.push_back(node->Right());
+    }
+  }
+  REQUIRE(leaves == tree.SubtreeLeaves());
+}
+
 TEST_CASE("TestPruneAndUpdate", "[DETTest]")
 {
   arma::mat testData(3, 5);
@@ -214,6 +214,44 @@ TEST_CASE("DiscreteLogProbabilityTest", "[DistributionTest]")
   REQUIRE(logProb(1) == Approx(-3.2188758248682).epsilon(1e-5));
 }
 
+/**
+ * Test the static LogProbability() overload, which computes the matrix of log
+ * probabilities of each observation under each of a set of distributions in
+ * one pass.
+ */
+TEST_CASE("DiscreteLogProbabilityMatrixTest", "[DistributionTest]")
+{
+  // Three distributions over the same two-dimensional observation space.
+  std::vector<DiscreteDistribution> distributions;
+  distributions.push_back(DiscreteDistribution("4 4"));
+  distributions.push_back(DiscreteDistribution("4 4"));
+  distributions.push_back(DiscreteDistribution("4 4"));
+
+  arma::mat obs("0 1 2 3 0;"
+                "1 2 3 0 0");
+  distributions[1].Train(obs);
+  distributions[2].Train(arma::mat("3 3 0; 2 2 1"));
+
+  arma::mat logProbs;
+  DiscreteDistribution::LogProbability(obs, distributions, logProbs);
+
+  REQUIRE(logProbs.n_rows == 3);
+  REQUIRE(logProbs.n_cols == obs.n_cols);
+
+  // The batched computation must match the single-observation overload.
+  for (size_t d = 0; d < distributions.size(); ++d)
+  {
+    for (size_t i = 0; i < obs.n_cols; ++i)
+    {
+      const double reference = distributions[d].LogProbability(obs.col(i));
+      if (std::isinf(reference))
+        REQUIRE(std::isinf(logProbs(d, i)));
+      else
+        REQUIRE(logProbs(d, i) == Approx(reference).epsilon(1e-10));
+    }
+  }
+}
+
 /**
  * Test the Probability() function, for multiple points in the multivariate
  * Discrete case.
@@ -697,6 +735,60 @@ TEST_CASE("GammaDistributionTrainTest", "[DistributionTest]")
   REQUIRE(gDist.Dimensionality() == d2);
 }
 
+/**
+ * This test verifies that the grouped fit matches separate Train() calls on
+ * each group's data.
+ */
+TEST_CASE("GammaDistributionGroupedTrainTest", "[DistributionTest]")
+{
+  // Create two gamma distribution random generators.
+  std::gamma_distribution<double> dist0(5.3, 1.5);
+  std::gamma_distribution<double> dist1(2.1, 3.4);
+
+  size_t N = 1000;
+  size_t d = 2;
+  arma::mat rdata(d, N);
+  arma::Row<size_t> labels(N);
+
+  // Interleave points from the two distributions.
+  for (size_t i = 0; i < N; ++i)
+  {
+    labels[i] = i % 2;
+    for (size_t j = 0; j < d; ++j)
+      rdata(j, i) = (labels[i] == 0) ? dist0(math::randGen) :
+          dist1(math::randGen);
+  }
+
+  // Fit one distribution per group in a single pass; leave one group empty.
+  std::vector<GammaDistribution> distributions;
+  GammaDistribution::Train(rdata, labels, 3, distributions);
+
+  REQUIRE(distributions.size() == 3);
+
+  // Fit each group separately and compare.
+  for (size_t g = 0; g < 2; ++g)
+  {
+    GammaDistribution ref;
+    ref.Train(rdata.cols(arma::find(labels == g)));
+
+    REQUIRE(distributions[g].Dimensionality() == d);
+    for (size_t j = 0; j < d; ++j)
+    {
+      REQUIRE(distributions[g].Alpha(j) == Approx(ref.Alpha(j)).epsilon(1e-8));
+      REQUIRE(distributions[g].Beta(j) == Approx(ref.Beta(j)).epsilon(1e-8));
+    }
+  }
+
+  // The empty group keeps zero-initialized parameters.
+  REQUIRE(distributions[2].Alpha(0) == 0.0);
+  REQUIRE(distributions[2].Beta(0) == 0.0);
+
+  // Out-of-range labels must be rejected.
+  REQUIRE_THROWS_AS(
+      GammaDistribution::Train(rdata, labels, 1, distributions),
+      std::invalid_argument);
+}
+
 /**
  * This test verifies that the fitting procedure for GammaDistribution works
  * properly when probabilities for each sample is given.
@@ -1264,6 +1356,48 @@ TEST_CASE("RegressionDistributionTest", "[DistributionTest]")
                 binaryRd.Rf().Parameters());
 }
 
+/**
+ * The stacked evaluation of many regression distributions must match the
+ * per-distribution batched evaluation.
+ */
+TEST_CASE("RegressionDistributionStackedLogProbabilityTest",
+          "[DistributionTest]")
+{
+  // Train a few distributions on different random data, so that their
+  // coefficients and error variances differ.
+  std::vector<RegressionDistribution> distributions;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    arma::mat data;
+    data.randn(5, 400);
+    arma::rowvec responses;
+    responses.randn(400);
+
+    distributions.push_back(RegressionDistribution(data, responses));
+  }
+
+  // Observations in HMMR layout: response in the first row, predictors in
+  // the remaining rows.
+  arma::mat observations;
+  observations.randn(6, 100);
+
+  arma::mat stackedLogProb;
+  RegressionDistribution::LogProbability(observations, distributions,
+      stackedLogProb);
+
+  REQUIRE(stackedLogProb.n_rows == distributions.size());
+  REQUIRE(stackedLogProb.n_cols == observations.n_cols);
+
+  for (size_t i = 0; i < distributions.size(); ++i)
+  {
+    arma::vec logProb;
+    distributions[i].LogProbability(observations, logProb);
+
+    CheckMatrices(arma::mat(stackedLogProb.row(i).t()), arma::mat(logProb),
+        1e-10);
+  }
+}
+
 /*****************************************************/
 /** Diagonal Covariance Gaussian Distribution Tests **/
 /*****************************************************/
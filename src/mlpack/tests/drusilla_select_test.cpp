@@ -76,6 +76,36 @@ BOOST_AUTO_TEST_CASE(DrusillaSelectExhaustiveExactTest)
   }
 }
 
+// With more queries than the internal block size, the blocked search must
+// still give the exact result on an exhaustive candidate set.
+BOOST_AUTO_TEST_CASE(DrusillaSelectBlockedExactTest)
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 100);
+  arma::mat querySet = arma::randu<arma::mat>(5, 700);
+
+  // Construct with one projection and 100 points in that projection.
+  DrusillaSelect<> ds(dataset, 100, 1);
+
+  arma::mat distances, distancesTrue;
+  arma::Mat<size_t> neighbors, neighborsTrue;
+
+  ds.Search(querySet, 5, neighbors, distances);
+
+  KFN kfn(dataset);
+  kfn.Search(querySet, 5, neighborsTrue, distancesTrue);
+
+  BOOST_REQUIRE_EQUAL(neighborsTrue.n_cols, neighbors.n_cols);
+  BOOST_REQUIRE_EQUAL(neighborsTrue.n_rows, neighbors.n_rows);
+  BOOST_REQUIRE_EQUAL(distancesTrue.n_cols, distances.n_cols);
+  BOOST_REQUIRE_EQUAL(distancesTrue.n_rows, distances.n_rows);
+
+  for (size_t i = 0; i < distances.n_elem; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(neighbors[i], neighborsTrue[i]);
+    BOOST_REQUIRE_CLOSE(distances[i], distancesTrue[i], 1e-5);
+  }
+}
+
 // Test that we can call Train() after calling the constructor.
 BOOST_AUTO_TEST_CASE(RetrainTest)
 {
@@ -94,6 +94,66 @@ BOOST_AUTO_TEST_CASE(DualTreeVsNaive)
   }
 }
 
+/**
+ * Make sure the blocked naive search gives the same results as direct kernel
+ * evaluations, for both kernels with a blocked specialization.  The sizes are
+ * chosen so the query set spans several blocks.
+ */
+BOOST_AUTO_TEST_CASE(BlockedNaiveSearchTest)
+{
+  arma::mat refData;
+  arma::mat queryData;
+  refData.randn(8, 2000);
+  queryData.randn(8, 1200);
+
+  // For the linear kernel the correct results can be computed directly.
+  LinearKernel lk;
+  FastMKS<LinearKernel> naive(refData, lk, false, true);
+
+  arma::Mat<size_t> indices;
+  arma::mat products;
+  naive.Search(queryData, 5, indices, products);
+
+  for (size_t q = 0; q < queryData.n_cols; ++q)
+  {
+    const arma::vec evals = refData.t() * queryData.col(q);
+    const arma::uvec sorted = arma::sort_index(evals, "descend");
+
+    for (size_t j = 0; j < 5; ++j)
+    {
+      BOOST_REQUIRE_EQUAL(indices(j, q), sorted[j]);
+      BOOST_REQUIRE_CLOSE(products(j, q), evals[sorted[j]], 1e-5);
+    }
+  }
+
+  // For the cosine distance, check each returned value against a pairwise
+  // evaluation and make sure the values are in decreasing order.
+  CosineDistance cd;
+  FastMKS<CosineDistance> cosNaive(refData, cd, false, true);
+  cosNaive.Search(queryData, 5, indices, products);
+
+  for (size_t q = 0; q < queryData.n_cols; ++q)
+  {
+    for (size_t j = 0; j < 5; ++j)
+    {
+      const double eval = CosineDistance::Evaluate(queryData.col(q),
+          refData.col(indices(j, q)));
+      BOOST_REQUIRE_CLOSE(products(j, q), eval, 1e-5);
+
+      if (j > 0)
+        BOOST_REQUIRE_GE(products(j - 1, q), products(j, q));
+    }
+  }
+
+  // In monochromatic mode, a point must not be returned as its own candidate.
+  FastMKS<LinearKernel> mono(refData, lk, false, true);
+  mono.Search(5, indices, products);
+
+  for (size_t q = 0; q < refData.n_cols; ++q)
+    for (size_t j = 0; j < 5; ++j)
+      BOOST_REQUIRE_NE(indices(j, q), q);
+}
+
 /**
  * Compare dual-tree and single-tree on a larger dataset.
  */
@@ -15,6 +15,8 @@
 #include <mlpack/methods/ann/layer/layer.hpp>
 #include <mlpack/methods/ann/loss_functions/mean_squared_error.hpp>
 #include <mlpack/methods/ann/ffn.hpp>
+#include <mlpack/methods/ann/batch_provider.hpp>
+#include <mlpack/methods/ann/distributed_training.hpp>
 #include <mlpack/methods/kmeans/kmeans.hpp>
 
 #include <ensmallen.hpp>
@@ -798,3 +800,256 @@ TEST_CASE("RBFNetworkTest", "[FeedForwardNetworkTest]")
   // RBFN neural net with MeanSquaredError.
   TestNetwork<>(model1, dataset, labels1, dataset, labels, 10, 0.2);
 }
+
+/**
+ * Test that a frozen network produces the same predictions as the ordinary
+ * Predict() path, for batches smaller and larger than the planned batch size.
+ */
+TEST_CASE("FFNFreezeTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(10, 200);
+
+  FFN<MeanSquaredError<>> model;
+  model.Add<Linear<>>(10, 8);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(8, 3);
+
+  arma::mat expected;
+  model.Predict(dataset, expected);
+
+  model.Freeze(64);
+  REQUIRE(model.Frozen() == true);
+
+  arma::mat frozenResults;
+  model.Predict(dataset, frozenResults);
+  CheckMatrices(expected, frozenResults);
+
+  // A second call reuses the warm buffers; results must not change.
+  arma::mat secondResults;
+  model.Predict(dataset, secondResults);
+  CheckMatrices(expected, secondResults);
+
+  // A small batch must work too.
+  arma::mat smallBatch = dataset.cols(0, 9);
+  arma::mat smallResults;
+  model.Predict(smallBatch, smallResults);
+  CheckMatrices(arma::mat(expected.cols(0, 9)), smallResults);
+
+  model.Unfreeze();
+  REQUIRE(model.Frozen() == false);
+
+  arma::mat unfrozenResults;
+  model.Predict(dataset, unfrozenResults);
+  CheckMatrices(expected, unfrozenResults);
+}
+
+/**
+ * Test that the double-buffered BatchProvider covers every point exactly once
+ * per epoch and applies the augmentation hook.
+ */
+TEST_CASE("BatchProviderTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat predictors = arma::randu<arma::mat>(4, 103);
+  arma::mat responses = arma::randu<arma::mat>(2, 103);
+
+  BatchProvider<> provider(predictors, responses, 16);
+
+  for (size_t epoch = 0; epoch < 2; ++epoch)
+  {
+    arma::mat batchPredictors, batchResponses;
+    size_t batches = 0, points = 0;
+    arma::Col<size_t> seen(predictors.n_cols, arma::fill::zeros);
+    while (provider.Next(batchPredictors, batchResponses))
+    {
+      ++batches;
+      points += batchPredictors.n_cols;
+      REQUIRE(batchPredictors.n_cols == batchResponses.n_cols);
+
+      // Every batch column must be some dataset column, with matching
+      // responses.
+      for (size_t i = 0; i < batchPredictors.n_cols; ++i)
+      {
+        size_t j;
+        for (j = 0; j < predictors.n_cols; ++j)
+        {
+          if (arma::approx_equal(batchPredictors.col(i), predictors.col(j),
+              "absdiff", 1e-12))
+            break;
+        }
+        REQUIRE(j < predictors.n_cols);
+        REQUIRE(arma::approx_equal(batchResponses.col(i), responses.col(j),
+            "absdiff", 1e-12));
+        seen(j)++;
+      }
+    }
+
+    REQUIRE(batches == provider.BatchesPerEpoch());
+    REQUIRE(points == predictors.n_cols);
+    for (size_t j = 0; j < predictors.n_cols; ++j)
+      REQUIRE(seen(j) == 1);
+  }
+
+  // Now check that the augmentation hook runs on every batch.
+  BatchProvider<> augmented(predictors, responses, 16);
+  augmented.Augmentation() = [](arma::mat& x, arma::mat& /* y */)
+  {
+    x += 1.0;
+  };
+
+  arma::mat batchPredictors, batchResponses;
+  while (augmented.Next(batchPredictors, batchResponses))
+  {
+    REQUIRE(batchPredictors.min() >= 1.0);
+  }
+}
+
+/**
+ * Test that activation checkpointing produces the same objective and gradient
+ * as the ordinary training path.
+ */
+TEST_CASE("FFNCheckpointingTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(10, 50);
+  arma::mat targets = arma::randu<arma::mat>(4, 50);
+
+  FFN<MeanSquaredError<> > model;
+  model.Add<Linear<> >(10, 16);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(16, 16);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(16, 4);
+  model.Add<SigmoidLayer<> >();
+
+  model.Predictors() = data;
+  model.Responses() = targets;
+
+  arma::mat referenceGradient, checkpointedGradient;
+  const double referenceObjective = model.EvaluateWithGradient(
+      model.Parameters(), 0, referenceGradient, 50);
+
+  model.EnableCheckpointing();
+  REQUIRE(model.Checkpointing());
+  const double checkpointedObjective = model.EvaluateWithGradient(
+      model.Parameters(), 0, checkpointedGradient, 50);
+  model.DisableCheckpointing();
+
+  REQUIRE(checkpointedObjective ==
+      Approx(referenceObjective).epsilon(1e-10));
+  CheckMatrices(referenceGradient, checkpointedGradient, 1e-8);
+
+  // A custom segment count must give the same result, too.
+  model.EnableCheckpointing(3);
+  arma::mat segmentedGradient;
+  const double segmentedObjective = model.EvaluateWithGradient(
+      model.Parameters(), 0, segmentedGradient, 50);
+  model.DisableCheckpointing();
+
+  REQUIRE(segmentedObjective == Approx(referenceObjective).epsilon(1e-10));
+  CheckMatrices(referenceGradient, segmentedGradient, 1e-8);
+}
+
+/**
+ * Test that inference replicas share the parent's weights and predict
+ * identically, and that parent weight updates are visible to them.
+ */
+TEST_CASE("FFNInferenceReplicaTest", "[FeedForwardNetworkTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(10, 100);
+
+  FFN<MeanSquaredError<>> model;
+  model.Add<Linear<>>(10, 8);
+  model.Add<SigmoidLayer<>>();
+  model.Add<Linear<>>(8, 3);
+
+  arma::mat expected;
+  model.Predict(dataset, expected);
+
+  FFN<MeanSquaredError<>> replicaA = model.InferenceReplica();
+  FFN<MeanSquaredError<>> replicaB = model.InferenceReplica();
+
+  // The weights are shared, not copied.
+  REQUIRE(replicaA.Parameters().memptr() == model.Parameters().memptr());
+  REQUIRE(replicaB.Parameters().memptr() == model.Parameters().memptr());
+
+  arma::mat resultsA, resultsB;
+  replicaA.Predict(dataset, resultsA);
+  replicaB.Predict(dataset, resultsB);
+  CheckMatrices(expected, resultsA);
+  CheckMatrices(expected, resultsB);
+
+  // Updating the parent's weights must be visible through the replicas.
+  model.Parameters() += 0.5;
+
+  arma::mat updatedExpected, updatedResults;
+  model.Predict(dataset, updatedExpected);
+  replicaA.Predict(dataset, updatedResults);
+  CheckMatrices(updatedExpected, updatedResults);
+}
+
+/**
+ * Test the distributed training hooks: deterministic sharding, per-step
+ * gradient synchronization, and epoch parameter averaging.
+ */
+TEST_CASE("DistributedTrainingHooksTest", "[FeedForwardNetworkTest]")
+{
+  // The shards must partition the dataset round robin.
+  arma::mat data = arma::randu<arma::mat>(4, 11);
+  arma::mat labels = arma::randu<arma::mat>(1, 11);
+
+  arma::mat shard0Data, shard1Data, shard0Labels, shard1Labels;
+  ShardTrainingData(data, labels, 0, 2, shard0Data, shard0Labels);
+  ShardTrainingData(data, labels, 1, 2, shard1Data, shard1Labels);
+
+  REQUIRE(shard0Data.n_cols == 6);
+  REQUIRE(shard1Data.n_cols == 5);
+  for (size_t i = 0; i < shard0Data.n_cols; ++i)
+  {
+    REQUIRE(arma::approx_equal(shard0Data.col(i), data.col(2 * i),
+        "absdiff", 1e-12));
+    REQUIRE(shard0Labels(0, i) == labels(0, 2 * i));
+  }
+  for (size_t i = 0; i < shard1Data.n_cols; ++i)
+  {
+    REQUIRE(arma::approx_equal(shard1Data.col(i), data.col(2 * i + 1),
+        "absdiff", 1e-12));
+    REQUIRE(shard1Labels(0, i) == labels(0, 2 * i + 1));
+  }
+
+  REQUIRE_THROWS_AS(
+      ShardTrainingData(data, labels, 2, 2, shard0Data, shard0Labels),
+      std::invalid_argument);
+
+  // Train a small network with both hooks attached.  The gradient allreduce
+  // of this single-node "cluster" is the identity, so training proceeds
+  // normally; the hooks must fire and see gradients of the right size.
+  arma::mat trainData = arma::randu<arma::mat>(4, 64);
+  arma::mat trainLabels(1, 64);
+  for (size_t i = 0; i < 64; ++i)
+    trainLabels(0, i) = (i % 2) + 1;
+
+  FFN<NegativeLogLikelihood<> > model;
+  model.Add<Linear<> >(4, 8);
+  model.Add<SigmoidLayer<> >();
+  model.Add<Linear<> >(8, 2);
+  model.Add<LogSoftMax<> >();
+
+  size_t badGradientSizes = 0;
+  GradientAllreduce<> gradientSync(
+      [&badGradientSizes, &model](arma::mat& gradient)
+      {
+        if (model.Parameters().n_elem > 0 &&
+            gradient.n_elem != model.Parameters().n_elem)
+          ++badGradientSizes;
+      });
+
+  size_t epochSyncs = 0;
+  EpochParameterAverage<> parameterSync(
+      [&epochSyncs](arma::mat& /* parameters */) { ++epochSyncs; });
+
+  ens::StandardSGD opt(0.01, 16, 4 * trainData.n_cols, -1.0);
+  model.Train(trainData, trainLabels, opt, gradientSync, parameterSync);
+
+  REQUIRE(gradientSync.Steps() > 0);
+  REQUIRE(badGradientSizes == 0);
+  REQUIRE(epochSyncs > 0);
+}
@@ -129,6 +129,49 @@ BOOST_AUTO_TEST_CASE(GANTest)
   BOOST_REQUIRE_LE(generatedStd - originalStd, 0.2);
 }
 
+/*
+ * Train a small GAN for a few iterations with pipelined fake-batch generation
+ * enabled, and check that training completes with a finite objective and
+ * finite parameters.
+ */
+BOOST_AUTO_TEST_CASE(GANPipelineTest)
+{
+  size_t batchSize = 8;
+  size_t noiseDim = 1;
+
+  arma::mat trainData(1, 256);
+  trainData.imbue( [&]() { return arma::as_scalar(RandNormal(4, 0.5));});
+
+  // Create the Discriminator network.
+  FFN<SigmoidCrossEntropyError<> > discriminator;
+  discriminator.Add<Linear<> >(1, 8);
+  discriminator.Add<ReLULayer<> >();
+  discriminator.Add<Linear<> >(8, 1);
+
+  // Create the Generator network.
+  FFN<SigmoidCrossEntropyError<> > generator;
+  generator.Add<Linear<> >(noiseDim, 8);
+  generator.Add<SoftPlusLayer<> >();
+  generator.Add<Linear<> >(8, 1);
+
+  // Create GAN.
+  GaussianInitialization gaussian(0, 0.1);
+  std::function<double ()> noiseFunction = [](){ return math::Random(-8, 8) +
+      math::RandNormal(0, 1) * 0.01;};
+  GAN<FFN<SigmoidCrossEntropyError<> >,
+      GaussianInitialization,
+      std::function<double()> >
+  gan(generator, discriminator, gaussian, noiseFunction, noiseDim, batchSize,
+      1 /* generatorUpdateStep */, 0 /* discriminatorPreTrain */, 1.0);
+  gan.Pipeline() = true;
+
+  ens::StandardSGD optimizer(0.0003, batchSize, 2 * trainData.n_cols);
+  double objVal = gan.Train(trainData, optimizer);
+
+  BOOST_REQUIRE_EQUAL(std::isfinite(objVal), true);
+  BOOST_REQUIRE_EQUAL(gan.Parameters().is_finite(), true);
+}
+
 /*
  * Tests the GAN implementation of the O'Reilly Test on the MNIST dataset.
  * It's not viable to train on bigger parameters due to time constraints.
@@ -16,6 +16,7 @@
 #include <mlpack/methods/gmm/diagonal_gmm.hpp>
 
 #include <mlpack/methods/gmm/no_constraint.hpp>
+#include <mlpack/methods/gmm/streaming_em.hpp>
 #include <mlpack/methods/gmm/positive_definite_constraint.hpp>
 #include <mlpack/methods/gmm/diagonal_constraint.hpp>
 #include <mlpack/methods/gmm/eigenvalue_ratio_constraint.hpp>
@@ -79,6 +80,34 @@ BOOST_AUTO_TEST_CASE(GMMProbabilityComponentTest)
   BOOST_REQUIRE_CLOSE(gmm.Probability("1.4 0", 1), 0.0067568972024, 1e-5);
 }
 
+/**
+ * Make sure the batched probability overloads of GMM match the
+ * single-observation overloads.
+ */
+BOOST_AUTO_TEST_CASE(GMMBatchLogProbabilityTest)
+{
+  // Create a GMM (same as the last test).
+  GMM gmm(2, 2);
+  gmm.Component(0) = distribution::GaussianDistribution("0 0", "1 0; 0 1");
+  gmm.Component(1) = distribution::GaussianDistribution("3 3", "2 1; 1 2");
+  gmm.Weights() = "0.3 0.7";
+
+  const arma::mat observations = arma::randn<arma::mat>(2, 500);
+
+  arma::vec logProbs, probs;
+  gmm.LogProbability(observations, logProbs);
+  gmm.Probability(observations, probs);
+
+  BOOST_REQUIRE_EQUAL(logProbs.n_elem, observations.n_cols);
+  for (size_t i = 0; i < observations.n_cols; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(logProbs[i],
+        gmm.LogProbability(observations.unsafe_col(i)), 1e-10);
+    BOOST_REQUIRE_CLOSE(probs[i],
+        gmm.Probability(observations.unsafe_col(i)), 1e-10);
+  }
+}
+
 /**
  * Test training a model on only one Gaussian (randomly generated) in two
  * dimensions.  We will vary the dataset size from small to large.  The EM
@@ -831,6 +860,38 @@ BOOST_AUTO_TEST_CASE(DiagonalGMMProbabilityComponentTest)
   BOOST_REQUIRE_CLOSE(gmm.Probability("-4.1 2.1", 1), 8.60082772711e-05, 1e-5);
 }
 
+/**
+ * Make sure the batch scoring kernel of DiagonalGMM matches the
+ * single-observation overloads.
+ */
+BOOST_AUTO_TEST_CASE(DiagonalGMMBatchLogProbabilityTest)
+{
+  // Create DiagonalGMM.
+  DiagonalGMM gmm(3, 4);
+  gmm.Component(0) = distribution::DiagonalGaussianDistribution(
+      arma::vec("0 0 0 0"), arma::vec("1 1 1 1"));
+  gmm.Component(1) = distribution::DiagonalGaussianDistribution(
+      arma::vec("2 3 1 -2"), arma::vec("3 2 1 0.5"));
+  gmm.Component(2) = distribution::DiagonalGaussianDistribution(
+      arma::vec("-1 0.5 4 2"), arma::vec("0.5 2 2 1"));
+  gmm.Weights() = "0.25 0.4 0.35";
+
+  const arma::mat observations = arma::randn<arma::mat>(4, 500);
+
+  arma::vec logProbs, probs;
+  gmm.LogProbability(observations, logProbs);
+  gmm.Probability(observations, probs);
+
+  BOOST_REQUIRE_EQUAL(logProbs.n_elem, observations.n_cols);
+  for (size_t i = 0; i < observations.n_cols; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(logProbs[i],
+        gmm.LogProbability(observations.unsafe_col(i)), 1e-10);
+    BOOST_REQUIRE_CLOSE(probs[i],
+        gmm.Probability(observations.unsafe_col(i)), 1e-10);
+  }
+}
+
 /**
  * Make sure we can train a model on only one Gaussian (randomly generated)
  * in two dimensions.  We will vary the dataset size from small to large.
@@ -1181,4 +1242,66 @@ BOOST_AUTO_TEST_CASE(DiagonalGMMLoadSaveTest)
   }
 }
 
+/**
+ * Make sure that stepwise EM can track two well-separated Gaussians from a
+ * stream of mini-batches, given only a rough initialization.
+ */
+BOOST_AUTO_TEST_CASE(StreamingEMTwoGaussiansTest)
+{
+  // The true generating distributions.
+  distribution::GaussianDistribution d1("0.0 0.0", "1.0 0.2; 0.2 1.0");
+  distribution::GaussianDistribution d2("8.0 8.0", "1.5 0.0; 0.0 0.5");
+
+  // Give the model a rough initialization: perturbed means and spherical
+  // covariances.
+  GMM gmm(2, 2);
+  gmm.Component(0) = distribution::GaussianDistribution("1.0 -1.0",
+      "2.0 0.0; 0.0 2.0");
+  gmm.Component(1) = distribution::GaussianDistribution("7.0 9.0",
+      "2.0 0.0; 0.0 2.0");
+  gmm.Weights() = "0.5 0.5";
+
+  // Feed mini-batches of 250 points, 60% from the first Gaussian.
+  StreamingEM<> streamingEM;
+  for (size_t batchIndex = 0; batchIndex < 100; ++batchIndex)
+  {
+    arma::mat batch(2, 250);
+    for (size_t i = 0; i < 150; ++i)
+      batch.col(i) = d1.Random();
+    for (size_t i = 150; i < 250; ++i)
+      batch.col(i) = d2.Random();
+
+    streamingEM.Step(batch, gmm);
+  }
+
+  BOOST_REQUIRE_EQUAL(streamingEM.NumSteps(), 100);
+
+  // The components may be in either order.
+  const size_t first = (gmm.Component(0).Mean()[0] < 4.0) ? 0 : 1;
+  const size_t second = 1 - first;
+
+  // Check the mixture weights.
+  BOOST_REQUIRE_CLOSE(gmm.Weights()[first], 0.6, 10.0);
+  BOOST_REQUIRE_CLOSE(gmm.Weights()[second], 0.4, 10.0);
+
+  // Check the means.
+  for (size_t j = 0; j < 2; ++j)
+  {
+    BOOST_REQUIRE_SMALL(gmm.Component(first).Mean()[j] - d1.Mean()[j], 0.2);
+    BOOST_REQUIRE_SMALL(gmm.Component(second).Mean()[j] - d2.Mean()[j], 0.2);
+  }
+
+  // Check the covariances, loosely.
+  for (size_t j = 0; j < 2; ++j)
+  {
+    for (size_t k = 0; k < 2; ++k)
+    {
+      BOOST_REQUIRE_SMALL(gmm.Component(first).Covariance()(j, k) -
+          d1.Covariance()(j, k), 0.35);
+      BOOST_REQUIRE_SMALL(gmm.Component(second).Covariance()(j, k) -
+          d2.Covariance()(j, k), 0.35);
+    }
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
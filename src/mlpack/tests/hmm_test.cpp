@@ -593,6 +593,64 @@ BOOST_AUTO_TEST_CASE(GaussianHMMSimpleTest)
   }
 }
 
+/**
+ * The batched Predict() and Filter() overloads must give exactly the same
+ * results as calling the single-sequence versions on each sequence in turn.
+ */
+BOOST_AUTO_TEST_CASE(GaussianHMMBatchPredictFilterTest)
+{
+  GaussianDistribution g1("5.0 5.0", "1.0 0.0; 0.0 1.0");
+  GaussianDistribution g2("-5.0 -5.0", "1.0 0.0; 0.0 1.0");
+
+  arma::vec initial("1 0");
+  arma::mat transition("0.75 0.25; 0.25 0.75");
+
+  std::vector<GaussianDistribution> emission;
+  emission.push_back(g1);
+  emission.push_back(g2);
+
+  HMM<GaussianDistribution> hmm(initial, transition, emission);
+
+  // Generate a batch of sequences of varying lengths.
+  std::vector<arma::mat> observations(25);
+  for (size_t i = 0; i < observations.size(); ++i)
+  {
+    arma::Row<size_t> unusedStates;
+    hmm.Generate(20 + 10 * (i % 4), observations[i], unusedStates);
+  }
+
+  // Decode the whole batch at once.
+  std::vector<arma::Row<size_t>> batchStates;
+  arma::vec batchLogLikelihood;
+  hmm.Predict(observations, batchStates, batchLogLikelihood);
+
+  std::vector<arma::mat> batchFilter;
+  hmm.Filter(observations, batchFilter);
+
+  BOOST_REQUIRE_EQUAL(batchStates.size(), observations.size());
+  BOOST_REQUIRE_EQUAL(batchLogLikelihood.n_elem, observations.size());
+  BOOST_REQUIRE_EQUAL(batchFilter.size(), observations.size());
+
+  for (size_t i = 0; i < observations.size(); ++i)
+  {
+    arma::Row<size_t> states;
+    const double logLikelihood = hmm.Predict(observations[i], states);
+
+    BOOST_REQUIRE_CLOSE(batchLogLikelihood[i], logLikelihood, 1e-10);
+    BOOST_REQUIRE_EQUAL(batchStates[i].n_elem, states.n_elem);
+    for (size_t t = 0; t < states.n_elem; ++t)
+      BOOST_REQUIRE_EQUAL(batchStates[i][t], states[t]);
+
+    arma::mat filterSeq;
+    hmm.Filter(observations[i], filterSeq);
+
+    BOOST_REQUIRE_EQUAL(batchFilter[i].n_rows, filterSeq.n_rows);
+    BOOST_REQUIRE_EQUAL(batchFilter[i].n_cols, filterSeq.n_cols);
+    for (size_t t = 0; t < filterSeq.n_elem; ++t)
+      BOOST_REQUIRE_CLOSE(batchFilter[i][t], filterSeq[t], 1e-10);
+  }
+}
+
 /**
  * Ensure that Gaussian HMMs can be trained properly, for the labeled training
  * case and also for the unlabeled training case.
@@ -16,6 +16,7 @@
 #include <mlpack/methods/hoeffding_trees/hoeffding_categorical_split.hpp>
 #include <mlpack/methods/hoeffding_trees/binary_numeric_split.hpp>
 #include <mlpack/methods/hoeffding_trees/hoeffding_tree_model.hpp>
+#include <mlpack/methods/hoeffding_trees/hoeffding_forest.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -570,6 +571,73 @@ BOOST_AUTO_TEST_CASE(HoeffdingTreeSimpleDatasetTest)
   }
 }
 
+/**
+ * Build a streaming decision tree on the same perfectly separable dataset, but
+ * feed it the points in column chunks with TrainChunk(), and ensure that it
+ * finds the same split and classifies the training points correctly.
+ */
+BOOST_AUTO_TEST_CASE(HoeffdingTreeChunkedTrainingTest)
+{
+  DatasetInfo info(3);
+  info.MapString<size_t>("cat0", 0);
+  info.MapString<size_t>("cat1", 0);
+  info.MapString<size_t>("cat2", 0);
+  info.MapString<size_t>("cat3", 0);
+  info.MapString<size_t>("cat4", 0);
+  info.MapString<size_t>("cat5", 0);
+  info.MapString<size_t>("cat6", 0);
+  info.MapString<size_t>("cat0", 1);
+  info.MapString<size_t>("cat1", 1);
+  info.MapString<size_t>("cat2", 1);
+  info.MapString<size_t>("cat0", 2);
+  info.MapString<size_t>("cat1", 2);
+
+  // Now generate data.
+  arma::Mat<size_t> dataset(3, 9000);
+  arma::Row<size_t> labels(9000);
+  for (size_t i = 0; i < 9000; i += 3)
+  {
+    dataset(0, i) = mlpack::math::RandInt(7);
+    dataset(1, i) = 0;
+    dataset(2, i) = mlpack::math::RandInt(2);
+    labels(i) = 0;
+
+    dataset(0, i + 1) = mlpack::math::RandInt(7);
+    dataset(1, i + 1) = 2;
+    dataset(2, i + 1) = mlpack::math::RandInt(2);
+    labels(i + 1) = 1;
+
+    dataset(0, i + 2) = mlpack::math::RandInt(7);
+    dataset(1, i + 2) = 1;
+    dataset(2, i + 2) = mlpack::math::RandInt(2);
+    labels(i + 2) = 2;
+  }
+
+  // Train on chunks of 500 points, as if consuming a stream in blocks.
+  typedef HoeffdingTree<GiniImpurity, HoeffdingSizeTNumericSplit,
+      HoeffdingCategoricalSplit> TreeType;
+  TreeType chunkTree(info, 3);
+  const size_t chunkSize = 500;
+  for (size_t start = 0; start < 9000; start += chunkSize)
+  {
+    const size_t end = start + chunkSize - 1;
+    arma::Mat<size_t> chunk = dataset.cols(start, end);
+    arma::Row<size_t> chunkLabels = labels.cols(start, end);
+    chunkTree.TrainChunk(chunk, chunkLabels);
+  }
+
+  // The tree should have split on the informative dimension.
+  BOOST_REQUIRE_EQUAL(chunkTree.NumChildren(), 3);
+  BOOST_REQUIRE_EQUAL(chunkTree.SplitDimension(), 1);
+
+  // Now, classify all the points in the dataset.
+  arma::Row<size_t> chunkTreeLabels(9000);
+  chunkTree.Classify(dataset, chunkTreeLabels);
+
+  for (size_t i = 0; i < 9000; ++i)
+    BOOST_REQUIRE_EQUAL(labels[i], chunkTreeLabels[i]);
+}
+
 /**
  * Make sure that a tree that does not split on anything.
  */
@@ -1463,4 +1531,89 @@ BOOST_AUTO_TEST_CASE(HoeffdingTreeModelSerializationTest)
   }
 }
 
+/**
+ * Build a Hoeffding forest point by point on an easy two-class problem and
+ * make sure the majority vote classifies nearly everything correctly.
+ */
+BOOST_AUTO_TEST_CASE(HoeffdingForestTest)
+{
+  // Two noisy but well-separated numeric classes.
+  arma::mat dataset(3, 2000);
+  arma::Row<size_t> labels(2000);
+  for (size_t i = 0; i < 2000; i += 2)
+  {
+    dataset(0, i) = mlpack::math::Random() + 3.0;
+    dataset(1, i) = mlpack::math::Random() - 3.0;
+    dataset(2, i) = mlpack::math::Random();
+    labels[i] = 0;
+
+    dataset(0, i + 1) = mlpack::math::Random() - 3.0;
+    dataset(1, i + 1) = mlpack::math::Random() + 3.0;
+    dataset(2, i + 1) = mlpack::math::Random();
+    labels[i + 1] = 1;
+  }
+
+  data::DatasetInfo info(3);
+  HoeffdingForest<> forest(10, info, 2);
+  BOOST_REQUIRE_EQUAL(forest.NumTrees(), 10);
+
+  // Train in streaming mode, one point at a time.
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    forest.Train(dataset.col(i), labels[i]);
+
+  arma::Row<size_t> predictions;
+  arma::rowvec probabilities;
+  forest.Classify(dataset, predictions, probabilities);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    // The vote fraction must be a valid probability, and the single-point
+    // overload must agree with the batch overload.
+    BOOST_REQUIRE_GT(probabilities[i], 0.0);
+    BOOST_REQUIRE_LE(probabilities[i], 1.0);
+    BOOST_REQUIRE_EQUAL(forest.Classify(dataset.col(i)), predictions[i]);
+
+    if (predictions[i] == labels[i])
+      ++correct;
+  }
+
+  // At least 90% accuracy on this easy problem.
+  BOOST_REQUIRE_GT(correct, 1800);
+}
+
+/**
+ * The batch Train() overload uses one bagging stream per tree; it should
+ * give a forest of the same quality as per-point training.
+ */
+BOOST_AUTO_TEST_CASE(HoeffdingForestBatchStreamTest)
+{
+  arma::mat dataset(2, 1000);
+  arma::Row<size_t> labels(1000);
+  for (size_t i = 0; i < 1000; i += 2)
+  {
+    dataset(0, i) = mlpack::math::Random() + 2.0;
+    dataset(1, i) = mlpack::math::Random() - 2.0;
+    labels[i] = 0;
+
+    dataset(0, i + 1) = mlpack::math::Random() - 2.0;
+    dataset(1, i + 1) = mlpack::math::Random() + 2.0;
+    labels[i + 1] = 1;
+  }
+
+  data::DatasetInfo info(2);
+  HoeffdingForest<> forest(5, info, 2);
+  forest.Train(dataset, labels);
+
+  arma::Row<size_t> predictions;
+  forest.Classify(dataset, predictions);
+
+  size_t correct = 0;
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+    if (predictions[i] == labels[i])
+      ++correct;
+
+  BOOST_REQUIRE_GT(correct, 900);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -287,6 +287,94 @@ BOOST_AUTO_TEST_CASE(GridSearchTest)
       datasetInfo.UnmapString(actualParameters(1, 0), 1), 1e-5);
 }
 
+/**
+ * Test ParallelGridSearch finds the same optimum as the sequential grid
+ * search, and that the best model of the tuner matches the best objective.
+ */
+BOOST_AUTO_TEST_CASE(ParallelGridSearchTest)
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+  arma::vec lambda2Set("0.0 0.05 0.5 5.0");
+
+  double expectedLambda1, expectedLambda2, expectedObjective;
+  FindLARSBestLambdas(xs, ys, validationSize, transposeData, useCholesky,
+      lambda1Set, lambda2Set, expectedLambda1, expectedLambda2,
+      expectedObjective);
+
+  double actualLambda1, actualLambda2;
+  HyperParameterTuner<LARS, MSE, SimpleCV, ParallelGridSearch>
+      hpt(validationSize, xs, ys);
+  std::tie(actualLambda1, actualLambda2) = hpt.Optimize(Fixed(transposeData),
+      Fixed(useCholesky), lambda1Set, lambda2Set);
+
+  BOOST_REQUIRE_CLOSE(expectedObjective, hpt.BestObjective(), 1e-5);
+  BOOST_REQUIRE_CLOSE(expectedLambda1, actualLambda1, 1e-5);
+  BOOST_REQUIRE_CLOSE(expectedLambda2, actualLambda2, 1e-5);
+
+  /* The model retained after the concurrent sweep should come from the
+   * winning configuration. */
+  size_t validationFirstColumn = round(xs.n_cols * (1.0 - validationSize));
+  arma::mat validationXs = xs.cols(validationFirstColumn, xs.n_cols - 1);
+  arma::rowvec validationYs = ys.cols(validationFirstColumn, ys.n_cols - 1);
+  double objective = MSE::Evaluate(hpt.BestModel(), validationXs, validationYs);
+  BOOST_REQUIRE_CLOSE(expectedObjective, objective, 1e-5);
+}
+
+/**
+ * Test random search (ParallelGridSearch with MaxTrials set) returns the
+ * objective of the configuration it reports.
+ */
+BOOST_AUTO_TEST_CASE(ParallelRandomSearchTest)
+{
+  arma::mat xs;
+  arma::rowvec ys;
+  double validationSize;
+  InitProneToOverfittingData(xs, ys, validationSize);
+
+  bool transposeData = true;
+  bool useCholesky = false;
+  arma::vec lambda1Set("0 0.001 0.01 0.1 1.0 10.0 100.0");
+  arma::vec lambda2Set("0.0 0.05 0.5 5.0");
+
+  IncrementPolicy policy(true);
+  DatasetMapper<IncrementPolicy, double> datasetInfo(policy, 2);
+  for (double lambda1 : lambda1Set)
+    datasetInfo.MapString<size_t>(lambda1, 0);
+  for (double lambda2 : lambda2Set)
+    datasetInfo.MapString<size_t>(lambda2, 1);
+
+  SimpleCV<LARS, MSE> cv(validationSize, xs, ys);
+  CVFunction<decltype(cv), LARS, 4, FixedArg<bool, 0>, FixedArg<bool, 1>>
+      cvFun(cv, datasetInfo, 0.0, 0.0, {transposeData}, {useCholesky});
+
+  std::vector<bool> categoricalDimensions(datasetInfo.Dimensionality());
+  arma::Row<size_t> numCategories(datasetInfo.Dimensionality());
+  for (size_t d = 0; d < datasetInfo.Dimensionality(); d++)
+  {
+    numCategories[d] = datasetInfo.NumMappings(d);
+    categoricalDimensions[d] = datasetInfo.Type(d) ==
+        mlpack::data::Datatype::categorical;
+  }
+
+  ParallelGridSearch optimizer(10);
+  arma::mat actualParameters;
+  double actualObjective = optimizer.Optimize(cvFun, actualParameters,
+      categoricalDimensions, numCategories);
+
+  // The reported parameters should lie on the grid, and evaluating them again
+  // should give the reported objective.
+  BOOST_REQUIRE_LT(actualParameters(0, 0), numCategories[0]);
+  BOOST_REQUIRE_LT(actualParameters(1, 0), numCategories[1]);
+  BOOST_REQUIRE_CLOSE(actualObjective, cvFun.Evaluate(actualParameters), 1e-5);
+}
+
 /**
  * Test HyperParameterTuner.
  */
@@ -156,4 +156,92 @@ TEST_CASE("ImageInfoSerialization", "[ImageLoadTest]")
   REQUIRE(info.Quality() == binaryInfo.Quality());
 }
 
+/**
+ * Test that the batch loader gives the same columns as loading each image on
+ * its own.
+ */
+TEST_CASE("LoadImagesBatchTest", "[ImageLoadTest]")
+{
+  arma::Mat<unsigned char> single;
+  data::ImageInfo singleInfo;
+  REQUIRE(data::Load("test_image.png", single, singleInfo, false) == true);
+
+  arma::Mat<unsigned char> batch;
+  data::ImageInfo info;
+  std::vector<std::string> files = {"test_image.png", "test_image.png",
+      "test_image.png"};
+  REQUIRE(data::LoadImages(files, batch, info) == true);
+
+  REQUIRE(batch.n_rows == 50 * 50 * 3);
+  REQUIRE(batch.n_cols == 3);
+  REQUIRE(info.Width() == 50);
+  REQUIRE(info.Height() == 50);
+  REQUIRE(info.Channels() == 3);
+
+  for (size_t i = 0; i < batch.n_cols; ++i)
+    for (size_t j = 0; j < batch.n_rows; ++j)
+      REQUIRE(batch(j, i) == single[j]);
+}
+
+/**
+ * Resizing an image to its own size must reproduce it exactly, with and
+ * without the center crop; an actual downscale must give the target size.
+ */
+TEST_CASE("LoadImagesResizeTest", "[ImageLoadTest]")
+{
+  arma::Mat<unsigned char> single;
+  data::ImageInfo singleInfo;
+  REQUIRE(data::Load("test_image.png", single, singleInfo, false) == true);
+
+  std::vector<std::string> files = {"test_image.png", "test_image.png"};
+
+  arma::Mat<unsigned char> batch;
+  data::ImageInfo info;
+  REQUIRE(data::LoadImages(files, batch, info, 50, 50) == true);
+  for (size_t j = 0; j < batch.n_rows; ++j)
+    REQUIRE(batch(j, 0) == single[j]);
+
+  data::ImageInfo cropInfo;
+  REQUIRE(data::LoadImages(files, batch, cropInfo, 50, 50, true) == true);
+  for (size_t j = 0; j < batch.n_rows; ++j)
+    REQUIRE(batch(j, 1) == single[j]);
+
+  data::ImageInfo smallInfo;
+  REQUIRE(data::LoadImages(files, batch, smallInfo, 16, 8) == true);
+  REQUIRE(batch.n_rows == 16 * 8 * 3);
+  REQUIRE(batch.n_cols == 2);
+  REQUIRE(smallInfo.Width() == 16);
+  REQUIRE(smallInfo.Height() == 8);
+}
+
+/**
+ * Without a target size, images of different dimensions must fail; with one,
+ * they must load.
+ */
+TEST_CASE("LoadImagesMismatchedSizesTest", "[ImageLoadTest]")
+{
+  data::ImageInfo bigInfo(8, 8, 3);
+  arma::Mat<unsigned char> big =
+      arma::randi<arma::Mat<unsigned char>>(8 * 8 * 3, 1);
+  REQUIRE(data::Save("batch_big.bmp", big, bigInfo, false) == true);
+
+  data::ImageInfo smallInfo(4, 4, 3);
+  arma::Mat<unsigned char> small =
+      arma::randi<arma::Mat<unsigned char>>(4 * 4 * 3, 1);
+  REQUIRE(data::Save("batch_small.bmp", small, smallInfo, false) == true);
+
+  std::vector<std::string> files = {"batch_big.bmp", "batch_small.bmp"};
+
+  arma::Mat<unsigned char> batch;
+  data::ImageInfo info;
+  REQUIRE(data::LoadImages(files, batch, info) == false);
+
+  REQUIRE(data::LoadImages(files, batch, info, 8, 8) == true);
+  REQUIRE(batch.n_rows == 8 * 8 * 3);
+  REQUIRE(batch.n_cols == 2);
+
+  remove("batch_big.bmp");
+  remove("batch_small.bmp");
+}
+
 #endif // HAS_STB.
@@ -229,6 +229,144 @@ TEST_CASE("MedianImputationTest", "[ImputationTest]")
   REQUIRE(rowWiseInput(2, 3) == Approx(8.0).epsilon(1e-7));
 }
 
+/**
+ * Make sure the batch overload of MeanImputation handles all requested
+ * dimensions at once and agrees with the one-dimension overload.
+ */
+TEST_CASE("MeanImputationBatchTest", "[ImputationTest]")
+{
+  arma::mat columnWiseInput("3.0 0.0 2.0 0.0;"
+                  "5.0 6.0 0.0 6.0;"
+                  "0.0 8.0 4.0 8.0;");
+  arma::mat rowWiseInput(columnWiseInput);
+  arma::mat columnWiseExpected(columnWiseInput);
+  arma::mat rowWiseExpected(rowWiseInput);
+  double mappedValue = 0.0;
+  std::vector<size_t> dimensions = {0, 1, 2};
+  std::vector<double> mappedValues(dimensions.size(), mappedValue);
+
+  MeanImputation<double> imputer;
+
+  // The expected results come from the one-dimension overload.
+  for (const size_t dimension : dimensions)
+  {
+    imputer.Impute(columnWiseExpected, mappedValue, dimension, true);
+    imputer.Impute(rowWiseExpected, mappedValue, dimension, false);
+  }
+
+  imputer.Impute(columnWiseInput, mappedValues, dimensions, true);
+  imputer.Impute(rowWiseInput, mappedValues, dimensions, false);
+
+  CheckMatrices(columnWiseInput, columnWiseExpected);
+  CheckMatrices(rowWiseInput, rowWiseExpected);
+}
+
+/**
+ * Make sure the batch overload of MedianImputation handles all requested
+ * dimensions at once and agrees with the one-dimension overload.
+ */
+TEST_CASE("MedianImputationBatchTest", "[ImputationTest]")
+{
+  arma::mat columnWiseInput("3.0 0.0 2.0 0.0;"
+                  "5.0 6.0 0.0 6.0;"
+                  "0.0 8.0 4.0 8.0;");
+  arma::mat rowWiseInput(columnWiseInput);
+  arma::mat columnWiseExpected(columnWiseInput);
+  arma::mat rowWiseExpected(rowWiseInput);
+  double mappedValue = 0.0;
+  std::vector<size_t> dimensions = {0, 2};
+  std::vector<double> mappedValues(dimensions.size(), mappedValue);
+
+  MedianImputation<double> imputer;
+
+  for (const size_t dimension : dimensions)
+  {
+    imputer.Impute(columnWiseExpected, mappedValue, dimension, true);
+    imputer.Impute(rowWiseExpected, mappedValue, dimension, false);
+  }
+
+  imputer.Impute(columnWiseInput, mappedValues, dimensions, true);
+  imputer.Impute(rowWiseInput, mappedValues, dimensions, false);
+
+  CheckMatrices(columnWiseInput, columnWiseExpected);
+  CheckMatrices(rowWiseInput, rowWiseExpected);
+}
+
+/**
+ * Make sure the multi-dimension Imputer API works for strategies without a
+ * batch overload by falling back to per-dimension imputation.
+ */
+TEST_CASE("ImputerBatchTest", "[ImputationTest]")
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+  f << "a, 2, 3"  << endl;
+  f << "5, 6, a"  << endl;
+  f << "8, a, 10" << endl;
+  f.close();
+
+  arma::mat input;
+  MissingPolicy policy({"a"});
+  DatasetMapper<MissingPolicy> info(policy);
+  REQUIRE(data::Load("test_file.csv", input, info) == true);
+
+  // Impute all three dimensions at once with a strategy that has no batch
+  // overload.
+  CustomImputation<double> customStrategy(99);
+  Imputer<double,
+          DatasetMapper<MissingPolicy>,
+          CustomImputation<double>> imputer(info, customStrategy);
+  imputer.Impute(input, "a", std::vector<size_t>({0, 1, 2}));
+
+  REQUIRE(input(0, 0) == Approx(99.0).epsilon(1e-7));
+  REQUIRE(input(0, 1) == Approx(5.0).epsilon(1e-7));
+  REQUIRE(input(0, 2) == Approx(8.0).epsilon(1e-7));
+  REQUIRE(input(1, 0) == Approx(2.0).epsilon(1e-7));
+  REQUIRE(input(1, 1) == Approx(6.0).epsilon(1e-7));
+  REQUIRE(input(1, 2) == Approx(99.0).epsilon(1e-7));
+  REQUIRE(input(2, 0) == Approx(3.0).epsilon(1e-7));
+  REQUIRE(input(2, 1) == Approx(99.0).epsilon(1e-7));
+  REQUIRE(input(2, 2) == Approx(10.0).epsilon(1e-7));
+
+  remove("test_file.csv");
+}
+
+/**
+ * Make sure the multi-dimension Imputer API dispatches to the batch overload
+ * of MeanImputation.
+ */
+TEST_CASE("ImputerMeanBatchTest", "[ImputationTest]")
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+  f << "a, 2, 3"  << endl;
+  f << "5, 6, a"  << endl;
+  f << "8, a, 10" << endl;
+  f.close();
+
+  arma::mat input;
+  MissingPolicy policy({"a"});
+  DatasetMapper<MissingPolicy> info(policy);
+  REQUIRE(data::Load("test_file.csv", input, info) == true);
+
+  Imputer<double,
+          DatasetMapper<MissingPolicy>,
+          MeanImputation<double>> imputer(info);
+  imputer.Impute(input, "a", std::vector<size_t>({0, 1, 2}));
+
+  REQUIRE(input(0, 0) == Approx(6.5).epsilon(1e-7));
+  REQUIRE(input(0, 1) == Approx(5.0).epsilon(1e-7));
+  REQUIRE(input(0, 2) == Approx(8.0).epsilon(1e-7));
+  REQUIRE(input(1, 0) == Approx(2.0).epsilon(1e-7));
+  REQUIRE(input(1, 1) == Approx(6.0).epsilon(1e-7));
+  REQUIRE(input(1, 2) == Approx(4.0).epsilon(1e-7));
+  REQUIRE(input(2, 0) == Approx(3.0).epsilon(1e-7));
+  REQUIRE(input(2, 1) == Approx(6.5).epsilon(1e-7));
+  REQUIRE(input(2, 2) == Approx(10.0).epsilon(1e-7));
+
+  remove("test_file.csv");
+}
+
 /**
  * Make sure ListwiseDeletion method deletes the whole column (if column wise)
  * or the row (if row wise) containing value of 0.
@@ -380,4 +380,41 @@ BOOST_AUTO_TEST_CASE(LecunNormalInitTest)
   BOOST_REQUIRE_EQUAL(weights3d.n_slices, slices);
 }
 
+/**
+ * The parallel random fills used by RandomInitialization and
+ * GaussianInitialization must give the same weights for a given random seed
+ * no matter how many threads perform the fill, and the uniform fill must
+ * respect its bounds.
+ */
+BOOST_AUTO_TEST_CASE(ParallelDeterministicInitTest)
+{
+  // Larger than one fill block, so several streams take part.
+  const size_t rows = 100;
+  const size_t cols = 100;
+
+  RandomInitialization randomInit(-2, 3);
+  GaussianInitialization gaussianInit(1, 0.5);
+
+  const size_t threads = Parallel::NumThreads();
+
+  math::RandomSeed(42);
+  arma::mat uniformWeights, gaussianWeights;
+  randomInit.Initialize(uniformWeights, rows, cols);
+  gaussianInit.Initialize(gaussianWeights, rows, cols);
+
+  // Repeat the fills serially from the same seed.
+  Parallel::NumThreads(1);
+  math::RandomSeed(42);
+  arma::mat serialUniformWeights, serialGaussianWeights;
+  randomInit.Initialize(serialUniformWeights, rows, cols);
+  gaussianInit.Initialize(serialGaussianWeights, rows, cols);
+  Parallel::NumThreads(threads);
+
+  CheckMatrices(uniformWeights, serialUniformWeights, 1e-12);
+  CheckMatrices(gaussianWeights, serialGaussianWeights, 1e-12);
+
+  BOOST_REQUIRE_GE(uniformWeights.min(), -2.0);
+  BOOST_REQUIRE_LT(uniformWeights.max(), 3.0);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -164,6 +164,59 @@ BOOST_AUTO_TEST_CASE(GaussianKDEBruteForceTest)
     BOOST_REQUIRE_CLOSE(bfEstimations[i], treeEstimations[i], relError * 100);
 }
 
+/**
+ * Test multi-bandwidth evaluation results against brute force results for
+ * every bandwidth, in both dual-tree and single-tree mode.
+ */
+BOOST_AUTO_TEST_CASE(GaussianKDEMultiBandwidthTest)
+{
+  arma::mat reference = arma::randu(2, 300);
+  arma::mat query = arma::randu(2, 100);
+  const double relError = 0.05;
+
+  // One kernel per bandwidth.
+  std::vector<GaussianKernel> kernels;
+  kernels.push_back(GaussianKernel(0.1));
+  kernels.push_back(GaussianKernel(0.3));
+  kernels.push_back(GaussianKernel(0.8));
+
+  // Brute force KDE for every bandwidth.
+  arma::mat bfEstimations(kernels.size(), query.n_cols, arma::fill::zeros);
+  for (size_t b = 0; b < kernels.size(); ++b)
+  {
+    arma::vec bandwidthEstimations(query.n_cols, arma::fill::zeros);
+    BruteForceKDE<GaussianKernel>(reference,
+                                  query,
+                                  bandwidthEstimations,
+                                  kernels[b]);
+    bfEstimations.row(b) = bandwidthEstimations.t();
+  }
+
+  for (const KDEMode mode : {KDEMode::DUAL_TREE_MODE,
+                             KDEMode::SINGLE_TREE_MODE})
+  {
+    metric::EuclideanDistance metric;
+    KDE<GaussianKernel,
+        metric::EuclideanDistance,
+        arma::mat,
+        tree::KDTree>
+        kde(relError, 0.0, kernels[0], mode, metric);
+    kde.Train(reference);
+
+    arma::mat treeEstimations;
+    kde.Evaluate(query, kernels, treeEstimations);
+
+    BOOST_REQUIRE_EQUAL(treeEstimations.n_rows, kernels.size());
+    BOOST_REQUIRE_EQUAL(treeEstimations.n_cols, query.n_cols);
+
+    // Every bandwidth must satisfy the error tolerance.
+    for (size_t b = 0; b < kernels.size(); ++b)
+      for (size_t i = 0; i < query.n_cols; ++i)
+        BOOST_REQUIRE_CLOSE(bfEstimations(b, i), treeEstimations(b, i),
+            relError * 100);
+  }
+}
+
 /**
  * Test single-tree implementation results against brute force results.
  */
@@ -198,6 +251,47 @@ BOOST_AUTO_TEST_CASE(GaussianSingleKDEBruteForceTest)
     BOOST_REQUIRE_CLOSE(bfEstimations[i], treeEstimations[i], relError * 100);
 }
 
+/**
+ * Test that results stay within the error tolerance when the query set is
+ * large enough for the evaluation to be partitioned across threads, in both
+ * dual-tree and single-tree mode.
+ */
+BOOST_AUTO_TEST_CASE(GaussianKDEPartitionedQueriesTest)
+{
+  arma::mat reference = arma::randu(2, 400);
+  arma::mat query = arma::randu(2, 1500);
+  arma::vec bfEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+  const double kernelBandwidth = 0.25;
+  const double relError = 0.05;
+
+  // Brute force KDE.
+  GaussianKernel kernel(kernelBandwidth);
+  BruteForceKDE<GaussianKernel>(reference,
+                                query,
+                                bfEstimations,
+                                kernel);
+
+  metric::EuclideanDistance metric;
+  const KDEMode modes[] = { KDEMode::DUAL_TREE_MODE,
+                            KDEMode::SINGLE_TREE_MODE };
+  for (size_t m = 0; m < 2; ++m)
+  {
+    arma::vec treeEstimations = arma::vec(query.n_cols, arma::fill::zeros);
+    KDE<GaussianKernel,
+        metric::EuclideanDistance,
+        arma::mat,
+        tree::KDTree>
+        kde(relError, 0.0, kernel, modes[m], metric);
+    kde.Train(reference);
+    kde.Evaluate(query, treeEstimations);
+
+    // Check whether results are equal.
+    for (size_t i = 0; i < query.n_cols; ++i)
+      BOOST_REQUIRE_CLOSE(bfEstimations[i], treeEstimations[i],
+          relError * 100);
+  }
+}
+
 /**
  * Test single-tree implementation results against brute force results using
  * a cover-tree and Epanechnikov kernel.
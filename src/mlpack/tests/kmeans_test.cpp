@@ -18,6 +18,8 @@
 #include <mlpack/methods/kmeans/dual_tree_kmeans.hpp>
 #include <mlpack/methods/kmeans/sample_initialization.hpp>
 #include <mlpack/methods/kmeans/random_partition.hpp>
+#include <mlpack/methods/kmeans/mini_batch_kmeans.hpp>
+#include <mlpack/methods/kmeans/kmeans_parallel_initialization.hpp>
 
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
@@ -533,6 +535,41 @@ TEST_CASE("SparseKMeansTest", "[KMeansTest]")
 
 #endif // ARMA_HAS_SPMAT
 
+/**
+ * With deterministic reductions enabled, repeated NaiveKMeans iterations on
+ * the same input must give bitwise-identical centroids.
+ */
+TEST_CASE("NaiveKMeansDeterministicTest", "[KMeansTest]")
+{
+  arma::mat data = arma::randu<arma::mat>(10, 5000);
+  arma::mat centroids = arma::randu<arma::mat>(10, 8);
+
+  const bool oldDeterministic = Parallel::Deterministic();
+  Parallel::Deterministic() = true;
+
+  metric::EuclideanDistance metric;
+  NaiveKMeans<metric::EuclideanDistance, arma::mat> naive(data, metric);
+
+  arma::mat firstCentroids;
+  arma::Col<size_t> firstCounts;
+  naive.Iterate(centroids, firstCentroids, firstCounts);
+
+  for (size_t trial = 0; trial < 3; ++trial)
+  {
+    arma::mat newCentroids;
+    arma::Col<size_t> counts;
+    naive.Iterate(centroids, newCentroids, counts);
+
+    REQUIRE(newCentroids.n_elem == firstCentroids.n_elem);
+    for (size_t i = 0; i < newCentroids.n_elem; ++i)
+      REQUIRE(newCentroids[i] == firstCentroids[i]);
+    for (size_t i = 0; i < counts.n_elem; ++i)
+      REQUIRE(counts[i] == firstCounts[i]);
+  }
+
+  Parallel::Deterministic() = oldDeterministic;
+}
+
 TEST_CASE("ElkanTest", "[KMeansTest]")
 {
   const size_t trials = 5;
@@ -700,6 +737,51 @@ TEST_CASE("DTNNCoverTreeTest", "[KMeansTest]")
   }
 }
 
+/**
+ * On well-separated clusters, approximate dual-tree k-means must converge to
+ * the same solution as the exact algorithm.
+ */
+TEST_CASE("DTNNApproximateTest", "[KMeansTest]")
+{
+  // Three well-separated clusters of 100 points each.
+  arma::mat dataset(2, 300);
+  dataset.randu();
+  dataset.cols(100, 199) += 10.0;
+  for (size_t i = 200; i < 300; ++i)
+    dataset(1, i) += 10.0;
+
+  // Start the centroids inside each of the three clusters.
+  arma::mat centroids(2, 3);
+  centroids.col(0) = dataset.col(3);
+  centroids.col(1) = dataset.col(103);
+  centroids.col(2) = dataset.col(203);
+
+  metric::EuclideanDistance metric;
+  DualTreeKMeans<metric::EuclideanDistance, arma::mat> exact(dataset, metric);
+  DualTreeKMeans<metric::EuclideanDistance, arma::mat> approximate(dataset,
+      metric, 0.05);
+  REQUIRE(approximate.Epsilon() == Approx(0.05));
+
+  arma::mat exactCentroids(centroids);
+  arma::mat approximateCentroids(centroids);
+  for (size_t i = 0; i < 15; ++i)
+  {
+    arma::mat newExact, newApproximate;
+    arma::Col<size_t> exactCounts, approximateCounts;
+    exact.Iterate(exactCentroids, newExact, exactCounts);
+    approximate.Iterate(approximateCentroids, newApproximate,
+        approximateCounts);
+    exactCentroids = std::move(newExact);
+    approximateCentroids = std::move(newApproximate);
+  }
+
+  // With this much separation, the allowed slack cannot change which cluster
+  // any point belongs to, so the solutions must agree.
+  for (size_t i = 0; i < exactCentroids.n_elem; ++i)
+    REQUIRE(approximateCentroids[i] ==
+        Approx(exactCentroids[i]).margin(1e-5));
+}
+
 /**
  * Make sure that the sample initialization strategy successfully samples points
  * from the dataset.
@@ -733,3 +815,80 @@ TEST_CASE("SampleInitializationTest", "[KMeansTest]")
     REQUIRE(j < dataset.n_cols);
   }
 }
+
+/**
+ * Make sure the mini-batch Lloyd step recovers well-separated clusters.  The
+ * result is stochastic, so we only check that each of the three true groups
+ * ends up in its own cluster, not the exact centroid positions.
+ */
+TEST_CASE("MiniBatchKMeansTest", "[KMeansTest]")
+{
+  KMeans<metric::EuclideanDistance, SampleInitialization,
+      MaxVarianceNewCluster, MiniBatchKMeans> kmeans(500);
+  arma::Row<size_t> assignments;
+  arma::mat centroids;
+  kmeans.Cluster((arma::mat) trans(kMeansData), 3, assignments, centroids);
+
+  // The dataset is 13 points from class 1, 7 points from class 2, and 10
+  // points from class 3; each group must be assigned to a single cluster, and
+  // the three clusters must be distinct.
+  for (size_t i = 1; i < 13; ++i)
+    REQUIRE(assignments[i] == assignments[0]);
+  for (size_t i = 14; i < 20; ++i)
+    REQUIRE(assignments[i] == assignments[13]);
+  for (size_t i = 21; i < 30; ++i)
+    REQUIRE(assignments[i] == assignments[20]);
+
+  REQUIRE(assignments[0] != assignments[13]);
+  REQUIRE(assignments[0] != assignments[20]);
+  REQUIRE(assignments[13] != assignments[20]);
+}
+
+/**
+ * Make sure the k-means|| initialization strategy returns the right number of
+ * centroids, that each centroid is a point from the dataset, and that the
+ * resulting seeding separates well-separated clusters.
+ */
+TEST_CASE("KMeansParallelInitializationTest", "[KMeansTest]")
+{
+  arma::mat dataset = arma::randu<arma::mat>(5, 1000);
+  const size_t clusters = 10;
+  arma::mat centroids;
+
+  KMeansParallelInitialization init;
+  init.Cluster(dataset, clusters, centroids);
+
+  // Check that the size of the matrix is correct.
+  REQUIRE(centroids.n_cols == clusters);
+  REQUIRE(centroids.n_rows == 5);
+
+  // Check that each centroid is some point from the dataset.
+  for (size_t i = 0; i < clusters; ++i)
+  {
+    size_t j;
+    for (j = 0; j < dataset.n_cols; ++j)
+    {
+      const double distance = metric::EuclideanDistance::Evaluate(
+          centroids.col(i), dataset.col(j));
+      if (distance < 1e-10)
+        break;
+    }
+
+    REQUIRE(j < dataset.n_cols);
+  }
+
+  // Now make sure k-means seeded this way recovers three well-separated
+  // clusters.
+  KMeans<metric::EuclideanDistance, KMeansParallelInitialization> kmeans;
+  arma::Row<size_t> assignments;
+  arma::mat threeCentroids;
+  kmeans.Cluster((arma::mat) trans(kMeansData), 3, assignments,
+      threeCentroids);
+
+  for (size_t i = 1; i < 13; ++i)
+    REQUIRE(assignments[i] == assignments[0]);
+  for (size_t i = 14; i < 20; ++i)
+    REQUIRE(assignments[i] == assignments[13]);
+  for (size_t i = 21; i < 30; ++i)
+    REQUIRE(assignments[i] == assignments[20]);
+}
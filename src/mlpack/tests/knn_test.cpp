@@ -12,6 +12,9 @@
 #include <mlpack/methods/neighbor_search/neighbor_search.hpp>
 #include <mlpack/methods/neighbor_search/unmap.hpp>
 #include <mlpack/methods/neighbor_search/ns_model.hpp>
+#include <mlpack/methods/neighbor_search/query_cache.hpp>
+#include <mlpack/methods/neighbor_search/spill_search_tuner.hpp>
+#include <mlpack/methods/neighbor_search/sharded_neighbor_search.hpp>
 #include <mlpack/core/tree/cover_tree.hpp>
 #include <mlpack/core/tree/example_tree.hpp>
 #include "test_catch_tools.hpp"
@@ -753,6 +756,62 @@ TEST_CASE("KNNSingleTreeVsNaive", "[KNNTest]")
   }
 }
 
+/**
+ * Test the time-budgeted greedy-then-refine search.  With an effectively
+ * unlimited budget the best-first refinement runs to completion, so the
+ * results must match naive search exactly and every error bound must report
+ * exactness.  With a tight budget the results are still valid and can never
+ * beat the exact distances.
+ */
+TEST_CASE("KNNTimeBudgetedSearchTest", "[KNNTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 1000);
+  arma::mat queries;
+  queries.randu(8, 50);
+
+  // Exact results for reference.
+  KNN naive(dataset, NAIVE_MODE);
+  arma::Mat<size_t> naiveNeighbors;
+  arma::mat naiveDistances;
+  naive.Search(queries, 5, naiveNeighbors, naiveDistances);
+
+  // With ten seconds of budget per query the refinement exhausts the tree,
+  // so the search is exact.
+  KNN budgeted(dataset, GREEDY_SINGLE_TREE_MODE);
+  budgeted.SearchTimeBudget() = 10000000;
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  budgeted.Search(queries, 5, neighbors, distances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == naiveNeighbors[i]);
+    REQUIRE(distances[i] == Approx(naiveDistances[i]).epsilon(1e-7));
+  }
+
+  REQUIRE(budgeted.ErrorBounds().n_elem == queries.n_cols);
+  for (size_t i = 0; i < queries.n_cols; ++i)
+    REQUIRE(budgeted.ErrorBounds()[i] == DBL_MAX);
+
+  // A one-microsecond budget leaves little or no time for refinement, but
+  // the greedy descent still produces valid candidates: any distance found
+  // must be no better than the exact one, and a bound must be reported for
+  // every query.
+  KNN tight(dataset, GREEDY_SINGLE_TREE_MODE);
+  tight.SearchTimeBudget() = 1;
+  tight.Search(queries, 5, neighbors, distances);
+
+  REQUIRE(neighbors.n_rows == 5);
+  REQUIRE(neighbors.n_cols == queries.n_cols);
+  for (size_t i = 0; i < distances.n_elem; ++i)
+  {
+    if (distances[i] != DBL_MAX)
+      REQUIRE(distances[i] >= naiveDistances[i] - 1e-10);
+  }
+  REQUIRE(tight.ErrorBounds().n_elem == queries.n_cols);
+}
+
 /**
  * Test the cover tree single-tree nearest-neighbors method against the naive
  * method.  This uses only a random reference dataset.
@@ -979,6 +1038,48 @@ TEST_CASE("KNNDuplicatedSpillSearchTest", "[KNNTest]")
   }
 }
 
+/**
+ * Test the spill tree defeatist search tuner.  The simulated candidate sets
+ * are nested across tau values, so recall and candidate counts must be
+ * non-decreasing in tau, and the recommendation must honor the recall
+ * target.
+ */
+TEST_CASE("KNNSpillSearchTunerTest", "[KNNTest]")
+{
+  arma::mat dataset;
+  dataset.randu(8, 500);
+
+  SpillSearchTuner<> tuner(dataset, 0.3 /* maxTau */);
+
+  arma::vec tauValues("0.0 0.1 0.2 0.3");
+  const size_t k = 3;
+  arma::mat results = tuner.Estimate(tauValues, k, 50);
+
+  REQUIRE(results.n_rows == tauValues.n_elem);
+  REQUIRE(results.n_cols == 4);
+  for (size_t t = 0; t < results.n_rows; ++t)
+  {
+    REQUIRE(results(t, 0) == Approx(tauValues[t]));
+    REQUIRE(results(t, 1) >= 0.0);
+    REQUIRE(results(t, 1) <= 1.0);
+
+    if (t > 0)
+    {
+      // Larger overlaps only add candidates, so the exact neighbors found at
+      // a smaller tau are still found.
+      REQUIRE(results(t, 1) >= results(t - 1, 1));
+      REQUIRE(results(t, 2) >= results(t - 1, 2));
+    }
+  }
+
+  // Any tau reaches a recall target of zero, so the smallest must win.
+  REQUIRE(tuner.Recommend(tauValues, k, 0.0, 50) == Approx(0.0));
+
+  // An unattainable target must still return one of the evaluated values.
+  const double fallback = tuner.Recommend(tauValues, k, 1.1, 50);
+  REQUIRE(arma::any(arma::abs(tauValues - fallback) < 1e-12));
+}
+
 /**
  * Make sure sparse nearest neighbors works with kd trees.
  */
@@ -1814,3 +1915,209 @@ TEST_CASE("KNNSpillTreeSearchEnoughResults", "[KNNTest]")
   REQUIRE(arma::accu(distancesGreedy < 0.0 || distancesGreedy > std::sqrt(3.0))
       == 0);
 }
+
+/**
+ * Ensure that incremental insertion and deletion on a rectangle-tree NSModel
+ * keep the index consistent with search results.
+ */
+TEST_CASE("KNNModelIncrementalUpdateTest", "[KNNTest]")
+{
+  typedef NSModel<NearestNeighborSort> KNNModel;
+
+  arma::mat referenceData = arma::randu<arma::mat>(5, 200);
+
+  KNNModel model(KNNModel::TreeTypes::R_TREE, false);
+  model.BuildModel(std::move(referenceData), 20, DUAL_TREE_MODE, 0.0);
+
+  // Insert a point and make sure it is returned as its own nearest neighbor.
+  arma::vec newPoint(5, arma::fill::randu);
+  model.InsertPoint(newPoint);
+  REQUIRE(model.Dataset().n_cols == 201);
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  arma::mat querySet(5, 1);
+  querySet.col(0) = newPoint;
+  model.Search(std::move(querySet), 1, neighbors, distances);
+  REQUIRE(neighbors(0, 0) == 200);
+  REQUIRE(distances(0, 0) == Approx(0.0).margin(1e-10));
+
+  // Now delete the point; it must no longer be returned.
+  model.DeletePoint(200);
+  arma::mat querySet2(5, 1);
+  querySet2.col(0) = newPoint;
+  model.Search(std::move(querySet2), 1, neighbors, distances);
+  REQUIRE(neighbors(0, 0) != 200);
+
+  // Incremental updates must be refused for tree types without dynamic
+  // insertion support.
+  arma::mat kdData = arma::randu<arma::mat>(5, 50);
+  KNNModel kdModel(KNNModel::TreeTypes::KD_TREE, false);
+  kdModel.BuildModel(std::move(kdData), 20, DUAL_TREE_MODE, 0.0);
+  REQUIRE_THROWS_AS(kdModel.InsertPoint(newPoint), std::invalid_argument);
+  REQUIRE_THROWS_AS(kdModel.DeletePoint(0), std::invalid_argument);
+}
+
+/**
+ * Make sure concurrent SearchAsync() calls agree with a synchronous Search().
+ */
+TEST_CASE("KNNSearchAsyncTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(8, 500);
+
+  KNN knn(referenceData);
+
+  // Launch several asynchronous query blocks.
+  std::vector<arma::mat> queryBlocks;
+  std::vector<std::future<std::pair<arma::Mat<size_t>, arma::mat>>> futures;
+  for (size_t b = 0; b < 4; ++b)
+  {
+    queryBlocks.push_back(arma::randu<arma::mat>(8, 25));
+    futures.push_back(knn.SearchAsync(queryBlocks[b], 5));
+  }
+
+  for (size_t b = 0; b < 4; ++b)
+  {
+    std::pair<arma::Mat<size_t>, arma::mat> results = futures[b].get();
+
+    arma::Mat<size_t> expectedNeighbors;
+    arma::mat expectedDistances;
+    knn.Search(queryBlocks[b], 5, expectedNeighbors, expectedDistances);
+
+    REQUIRE(results.first.n_rows == 5);
+    REQUIRE(results.first.n_cols == 25);
+    for (size_t i = 0; i < expectedNeighbors.n_elem; ++i)
+    {
+      REQUIRE(results.first[i] == expectedNeighbors[i]);
+      REQUIRE(results.second[i] == Approx(expectedDistances[i]));
+    }
+  }
+}
+
+/**
+ * A QueryCache layered over KNN must return the same results as a direct
+ * search, and repeated queries must be served entirely from the cache.
+ */
+TEST_CASE("KNNQueryCacheTest", "[KNNTest]")
+{
+  arma::mat referenceData = arma::randu<arma::mat>(5, 300);
+  arma::mat queryData = arma::randu<arma::mat>(5, 100);
+
+  KNN knn(referenceData);
+  // A tolerance far below the query spacing, so no two distinct queries share
+  // a quantization cell.
+  QueryCache<KNN> cache(knn, 1e-8);
+
+  arma::Mat<size_t> neighbors, expectedNeighbors;
+  arma::mat distances, expectedDistances;
+
+  knn.Search(queryData, 3, expectedNeighbors, expectedDistances);
+
+  // The first pass misses on every query.
+  cache.Search(queryData, 3, neighbors, distances);
+  REQUIRE(cache.Misses() == queryData.n_cols);
+  REQUIRE(cache.Hits() == 0);
+
+  for (size_t i = 0; i < expectedNeighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == expectedNeighbors[i]);
+    REQUIRE(distances[i] == Approx(expectedDistances[i]));
+  }
+
+  // The second pass must be served from the cache, with identical results.
+  cache.Search(queryData, 3, neighbors, distances);
+  REQUIRE(cache.Misses() == queryData.n_cols);
+  REQUIRE(cache.Hits() == queryData.n_cols);
+
+  for (size_t i = 0; i < expectedNeighbors.n_elem; ++i)
+  {
+    REQUIRE(neighbors[i] == expectedNeighbors[i]);
+    REQUIRE(distances[i] == Approx(expectedDistances[i]));
+  }
+
+  // A smaller k can be served from the cached results, too.
+  cache.Search(queryData, 2, neighbors, distances);
+  REQUIRE(cache.Hits() == 2 * queryData.n_cols);
+  for (size_t q = 0; q < queryData.n_cols; ++q)
+  {
+    for (size_t j = 0; j < 2; ++j)
+    {
+      REQUIRE(neighbors(j, q) == expectedNeighbors(j, q));
+      REQUIRE(distances(j, q) == Approx(expectedDistances(j, q)));
+    }
+  }
+
+  // After Clear(), the same queries miss again.
+  cache.Clear();
+  cache.Search(queryData, 3, neighbors, distances);
+  REQUIRE(cache.Misses() == 2 * queryData.n_cols);
+}
+
+/**
+ * Test that sharded search returns exactly the same neighbors and distances
+ * as unsharded search, for several shard counts.
+ */
+TEST_CASE("KNNShardedSearchTest", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(8, 1000);
+  arma::mat querySet = arma::randu<arma::mat>(8, 200);
+
+  KNN knn(referenceSet);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(querySet, 7, neighbors, distances);
+
+  for (size_t numShards : { 1, 3, 8 })
+  {
+    ShardedNeighborSearch<> sharded(referenceSet, numShards);
+    REQUIRE(sharded.NumShards() == numShards);
+    REQUIRE(sharded.ReferenceSetSize() == referenceSet.n_cols);
+
+    arma::Mat<size_t> shardedNeighbors;
+    arma::mat shardedDistances;
+    sharded.Search(querySet, 7, shardedNeighbors, shardedDistances);
+
+    REQUIRE(shardedNeighbors.n_rows == 7);
+    REQUIRE(shardedNeighbors.n_cols == querySet.n_cols);
+
+    for (size_t i = 0; i < neighbors.n_elem; ++i)
+    {
+      REQUIRE(shardedNeighbors[i] == neighbors[i]);
+      REQUIRE(shardedDistances[i] == Approx(distances[i]).epsilon(1e-10));
+    }
+  }
+
+  // Asking for more neighbors than there are reference points must fail the
+  // same way as unsharded search.
+  ShardedNeighborSearch<> sharded(referenceSet, 4);
+  REQUIRE_THROWS_AS(
+      sharded.Search(querySet, referenceSet.n_cols + 1, neighbors, distances),
+      std::invalid_argument);
+}
+
+/**
+ * Test that the sharded top-k merge also works for furthest neighbor search,
+ * where "better" means a larger distance.
+ */
+TEST_CASE("KFNShardedSearchTest", "[KNNTest]")
+{
+  arma::mat referenceSet = arma::randu<arma::mat>(5, 400);
+  arma::mat querySet = arma::randu<arma::mat>(5, 50);
+
+  KFN kfn(referenceSet);
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  kfn.Search(querySet, 5, neighbors, distances);
+
+  ShardedNeighborSearch<FurthestNeighborSort> sharded(referenceSet, 3);
+
+  arma::Mat<size_t> shardedNeighbors;
+  arma::mat shardedDistances;
+  sharded.Search(querySet, 5, shardedNeighbors, shardedDistances);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(shardedNeighbors[i] == neighbors[i]);
+    REQUIRE(shardedDistances[i] == Approx(distances[i]).epsilon(1e-10));
+  }
+}
@@ -252,6 +252,48 @@ BOOST_AUTO_TEST_CASE(SingleDatasetSingleSearch)
   BOOST_REQUIRE_EQUAL(distances.n_cols, 2500);
 }
 
+// Test that single-tree rank-approximate search is reproducible: with
+// per-query random streams seeded from the query index, two searches on the
+// same data must return identical results regardless of thread count or the
+// order in which queries are processed.
+BOOST_AUTO_TEST_CASE(SingleSearchReproducibilityTest)
+{
+  arma::mat refData;
+  arma::mat queryData;
+
+  data::Load("rann_test_r_3_900.csv", refData, true);
+  data::Load("rann_test_q_3_100.csv", queryData, true);
+
+  RASearch<> krann(refData, false, true, 1.0, 0.95, false, false);
+
+  arma::Mat<size_t> neighbors, neighborsRepeat;
+  arma::mat distances, distancesRepeat;
+
+  krann.Search(queryData, 1, neighbors, distances);
+  // Scramble the global generator; the result must not depend on it.
+  math::RandomSeed(std::time(NULL));
+  krann.Search(queryData, 1, neighborsRepeat, distancesRepeat);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(neighbors[i], neighborsRepeat[i]);
+    BOOST_REQUIRE_EQUAL(distances[i], distancesRepeat[i]);
+  }
+
+  // The monochromatic overload should be reproducible too.
+  RASearch<> monoKrann(refData, false, true, 1.0, 0.95, false, false);
+
+  monoKrann.Search(1, neighbors, distances);
+  math::RandomSeed(std::time(NULL));
+  monoKrann.Search(1, neighborsRepeat, distancesRepeat);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(neighbors[i], neighborsRepeat[i]);
+    BOOST_REQUIRE_EQUAL(distances[i], distancesRepeat[i]);
+  }
+}
+
 // Test rank-approximate search with just a single dataset in dual-tree mode.
 // These tests just ensure that the method runs okay.
 BOOST_AUTO_TEST_CASE(SingleDatasetSearch)
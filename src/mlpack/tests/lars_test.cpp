@@ -106,6 +106,37 @@ BOOST_AUTO_TEST_CASE(LARSTestElasticNetGram)
   LassoTest(100, 10, true, false);
 }
 
+// Sharing a Gram matrix precomputed with ComputeGram() across several solves
+// on the same design matrix must give the same solutions as letting each
+// model compute the Gram matrix itself.
+BOOST_AUTO_TEST_CASE(LARSSharedGramMatrixTest)
+{
+  arma::mat X;
+  arma::rowvec y;
+  GenerateProblem(X, y, 100, 10);
+
+  arma::mat gram;
+  LARS::ComputeGram(X, gram);
+
+  for (double lambda1 : { 0.0, 0.1, 0.5 })
+  {
+    for (bool useCholesky : { false, true })
+    {
+      LARS lars(useCholesky, lambda1);
+      arma::vec beta;
+      lars.Train(X, y, beta);
+
+      LARS larsShared(useCholesky, gram, lambda1);
+      arma::vec betaShared;
+      larsShared.Train(X, y, betaShared);
+
+      BOOST_REQUIRE_EQUAL(beta.n_elem, betaShared.n_elem);
+      for (size_t i = 0; i < beta.n_elem; ++i)
+        BOOST_REQUIRE_SMALL(beta(i) - betaShared(i), 1e-10);
+    }
+  }
+}
+
 // Ensure that LARS doesn't crash when the data has linearly dependent features
 // (meaning that there is a singularity).  This test uses the Cholesky
 // factorization.
@@ -258,4 +258,73 @@ BOOST_AUTO_TEST_CASE(TestSymKronId)
   }
 }
 
+BOOST_AUTO_TEST_CASE(TestMakePositiveDefiniteAlreadyPD)
+{
+  // A matrix that is already positive definite must not be modified.
+  for (size_t i = 0; i < 10; ++i)
+  {
+    const size_t n = 5 + math::RandInt(20);
+    arma::mat x = arma::randu<arma::mat>(n, n);
+    arma::mat m = x * x.t() + n * arma::eye<arma::mat>(n, n);
+    const arma::mat old(m);
+
+    const double shift = MakePositiveDefinite(m);
+
+    BOOST_REQUIRE_EQUAL(shift, 0.0);
+    for (size_t j = 0; j < m.n_elem; ++j)
+      BOOST_REQUIRE_CLOSE(m[j], old[j], 1e-10);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestMakePositiveDefiniteIndefinite)
+{
+  // Indefinite and rank-deficient matrices must come back
+  // Cholesky-decomposable, changed only on the diagonal and only by the
+  // returned shift.
+  for (size_t i = 0; i < 10; ++i)
+  {
+    const size_t n = 5 + math::RandInt(20);
+    arma::mat x = arma::randu<arma::mat>(n, n);
+    // Symmetric but generally indefinite.
+    arma::mat m = arma::symmatu(x) - 0.5 * arma::eye<arma::mat>(n, n);
+    const arma::mat old = arma::symmatu(m);
+
+    const double shift = MakePositiveDefinite(m);
+
+    BOOST_REQUIRE_GT(shift, 0.0);
+
+    arma::mat c;
+    BOOST_REQUIRE(arma::chol(c, m));
+
+    for (size_t row = 0; row < n; ++row)
+    {
+      for (size_t col = 0; col < n; ++col)
+      {
+        const double expected = (row == col) ? old(row, col) + shift
+                                             : old(row, col);
+        BOOST_REQUIRE_CLOSE(m(row, col), expected, 1e-10);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(TestMakePositiveDefiniteMinimalShift)
+{
+  // For a matrix with known eigenvalues the shift must be close to the
+  // smallest sufficient one: here -lambda is needed, so with the default 10%
+  // tolerance the shift may not be more than about 20% larger.
+  arma::mat eigvec, dummy = arma::randu<arma::mat>(10, 10);
+  arma::mat cov = dummy * dummy.t();
+  arma::vec eigval;
+  arma::eig_sym(eigval, eigvec, cov);
+
+  const double lambda = 2.0;
+  arma::mat m = cov - (eigval[0] + lambda) * arma::eye<arma::mat>(10, 10);
+
+  const double shift = MakePositiveDefinite(m);
+
+  BOOST_REQUIRE_GT(shift, 0.99 * lambda);
+  BOOST_REQUIRE_LT(shift, 1.2 * lambda);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
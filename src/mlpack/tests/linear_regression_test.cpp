@@ -10,6 +10,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/linear_regression/linear_regression.hpp>
+#include <mlpack/methods/linear_regression/linear_regression_accumulator.hpp>
 
 #include "serialization_catch.hpp"
 #include "test_catch_tools.hpp"
@@ -266,3 +267,89 @@ TEST_CASE("LinearRegressionTrainReturnObjective", "[LinearRegressionTest]")
 
   REQUIRE(std::isfinite(error) == true);
 }
+
+/**
+ * A model trained by streaming chunks through a LinearRegressionAccumulator
+ * should match a model trained on the full matrix at once.
+ */
+TEST_CASE("LinearRegressionAccumulatorTest", "[LinearRegressionTest]")
+{
+  arma::mat data(5, 1000, arma::fill::randu);
+  arma::vec coeffs(5, arma::fill::randu);
+  arma::rowvec responses = coeffs.t() * data +
+      0.01 * arma::rowvec(1000, arma::fill::randn);
+
+  // Train on the full matrix at once.
+  LinearRegression batch(data, responses, 0.1);
+
+  // Stream the same data through the accumulator in uneven chunks.
+  LinearRegressionAccumulator acc(data.n_rows, 0.1);
+  size_t start = 0;
+  const size_t chunkSizes[5] = { 100, 350, 1, 249, 300 };
+  for (size_t i = 0; i < 5; ++i)
+  {
+    acc.Accumulate(data.cols(start, start + chunkSizes[i] - 1),
+                   responses.subvec(start, start + chunkSizes[i] - 1));
+    start += chunkSizes[i];
+  }
+  REQUIRE(acc.Count() == data.n_cols);
+
+  LinearRegression streamed;
+  const double error = acc.Train(streamed);
+
+  REQUIRE(streamed.Intercept() == batch.Intercept());
+  REQUIRE(streamed.Parameters().n_elem == batch.Parameters().n_elem);
+  for (size_t i = 0; i < batch.Parameters().n_elem; ++i)
+  {
+    REQUIRE(streamed.Parameters()[i] ==
+        Approx(batch.Parameters()[i]).margin(1e-8));
+  }
+
+  // The returned error is the training MSE, computed without a second pass.
+  REQUIRE(error == Approx(batch.ComputeError(data, responses)).margin(1e-8));
+}
+
+/**
+ * Accumulators built from different parts of the data should merge into the
+ * same model, and shape mismatches should be caught.
+ */
+TEST_CASE("LinearRegressionAccumulatorMergeTest", "[LinearRegressionTest]")
+{
+  arma::mat data(4, 600, arma::fill::randu);
+  arma::rowvec responses(600, arma::fill::randn);
+  arma::rowvec weights(600, arma::fill::randu);
+
+  LinearRegression batch(data, responses, weights, 0.5);
+
+  // Build one accumulator per "file", then fold them into an empty target.
+  LinearRegressionAccumulator first(data.n_rows, 0.5);
+  first.Accumulate(data.cols(0, 399), responses.subvec(0, 399),
+      weights.subvec(0, 399));
+  LinearRegressionAccumulator second(data.n_rows, 0.5);
+  second.Accumulate(data.cols(400, 599), responses.subvec(400, 599),
+      weights.subvec(400, 599));
+
+  LinearRegressionAccumulator merged;
+  merged.Merge(first);
+  merged.Merge(second);
+  REQUIRE(merged.Count() == data.n_cols);
+
+  LinearRegression streamed;
+  merged.Train(streamed);
+
+  for (size_t i = 0; i < batch.Parameters().n_elem; ++i)
+  {
+    REQUIRE(streamed.Parameters()[i] ==
+        Approx(batch.Parameters()[i]).margin(1e-8));
+  }
+
+  // Mismatched shapes must be rejected.
+  LinearRegressionAccumulator wrongDim(data.n_rows + 1, 0.5);
+  REQUIRE_THROWS_AS(merged.Merge(wrongDim), std::invalid_argument);
+  REQUIRE_THROWS_AS(wrongDim.Accumulate(data, responses),
+      std::invalid_argument);
+
+  LinearRegressionAccumulator empty(data.n_rows, 0.5);
+  LinearRegression model;
+  REQUIRE_THROWS_AS(empty.Train(model), std::invalid_argument);
+}
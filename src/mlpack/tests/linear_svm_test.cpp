@@ -1180,4 +1180,132 @@ BOOST_AUTO_TEST_CASE(LinearSVMCallbackTest)
   BOOST_REQUIRE(cb.calledEndOptimization == true);
 }
 
+/**
+ * Test warm-started training along a regularization path.
+ */
+BOOST_AUTO_TEST_CASE(LinearSVMTrainPathTest)
+{
+  const size_t numClasses = 2;
+
+  GaussianDistribution g1(arma::vec("1.0 1.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("9.0 9.0 9.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(3, 500);
+  arma::Row<size_t> labels(500);
+  for (size_t i = 0; i < 250; ++i)
+  {
+    data.col(i) = g1.Random();
+    labels(i) = 0;
+  }
+  for (size_t i = 250; i < 500; ++i)
+  {
+    data.col(i) = g2.Random();
+    labels(i) = 1;
+  }
+
+  // Sweep from the most to the least regularized lambda.
+  arma::vec lambdas("1.0 0.1 0.01 0.001 0.0001");
+
+  LinearSVM<> lsvm(data.n_rows, numClasses);
+  arma::cube pathParameters;
+  arma::vec objectives = lsvm.TrainPath(data, labels, numClasses, lambdas,
+      pathParameters);
+
+  BOOST_REQUIRE_EQUAL(objectives.n_elem, lambdas.n_elem);
+  BOOST_REQUIRE_EQUAL(pathParameters.n_rows, data.n_rows);
+  BOOST_REQUIRE_EQUAL(pathParameters.n_cols, numClasses);
+  BOOST_REQUIRE_EQUAL(pathParameters.n_slices, lambdas.n_elem);
+
+  // With a decreasing lambda sequence the optimal objective cannot increase.
+  for (size_t i = 1; i < objectives.n_elem; ++i)
+    BOOST_REQUIRE_LE(objectives(i), objectives(i - 1) + 1e-5);
+
+  // The model should hold the solution for the last lambda.
+  BOOST_REQUIRE_EQUAL(lsvm.Lambda(), lambdas(lambdas.n_elem - 1));
+  CheckMatrices(lsvm.Parameters(),
+      arma::mat(pathParameters.slice(pathParameters.n_slices - 1)));
+
+  // The dataset is linearly separable, so the final model should classify it
+  // almost perfectly.
+  BOOST_REQUIRE_GE(lsvm.ComputeAccuracy(data, labels), 0.99);
+}
+
+
+/**
+ * Test that the single-precision objective function agrees with the
+ * double-precision objective function at the same parameters.
+ */
+BOOST_AUTO_TEST_CASE(LinearSVMFunctionFloatEvaluate)
+{
+  const size_t points = 500;
+  const size_t inputSize = 5;
+  const size_t numClasses = 3;
+  const double lambda = 0.01;
+
+  // Create a random dataset and random parameters.
+  arma::mat dataset = arma::randu<arma::mat>(inputSize, points);
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+    labels(i) = math::RandInt(0, numClasses);
+  const arma::mat parameters = arma::randu<arma::mat>(inputSize, numClasses);
+
+  // The function keeps an alias of the dataset, so the float copy must
+  // outlive it.
+  const arma::fmat floatDataset = arma::conv_to<arma::fmat>::from(dataset);
+  const arma::fmat floatParameters =
+      arma::conv_to<arma::fmat>::from(parameters);
+
+  LinearSVMFunction<arma::mat> svmf(dataset, labels, numClasses, lambda);
+  LinearSVMFunction<arma::fmat> floatSvmf(floatDataset, labels, numClasses,
+      lambda);
+
+  // The float objective is computed with single-precision elementwise work but
+  // a double accumulator, so it should be close to the double objective.
+  BOOST_REQUIRE_CLOSE(floatSvmf.Evaluate(floatParameters),
+      svmf.Evaluate(parameters), 1e-2);
+}
+
+/**
+ * Test training of linear svm on single-precision data using L-BFGS
+ * optimizer.
+ */
+BOOST_AUTO_TEST_CASE(LinearSVMFMatTest)
+{
+  const size_t numClasses = 2;
+  const double lambda = 0.0001;
+
+  // Generate a linearly separable two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 1.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("9.0 9.0 9.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(3, 500);
+  arma::Row<size_t> labels(500);
+  for (size_t i = 0; i < 250; ++i)
+  {
+    data.col(i) = g1.Random();
+    labels(i) = 0;
+  }
+  for (size_t i = 250; i < 500; ++i)
+  {
+    data.col(i) = g2.Random();
+    labels(i) = 1;
+  }
+
+  const arma::fmat floatData = arma::conv_to<arma::fmat>::from(data);
+
+  // Create a linear svm object using L-BFGS optimizer.
+  LinearSVM<arma::fmat> lsvm(floatData, labels, numClasses, lambda);
+
+  // Compare training accuracy to 1.
+  const double acc = lsvm.ComputeAccuracy(floatData, labels);
+  BOOST_REQUIRE_CLOSE(acc, 1.0, 0.5);
+
+  // The scores should be returned in single precision, one row per class.
+  arma::Row<size_t> predictions;
+  arma::fmat scores;
+  lsvm.Classify(floatData, predictions, scores);
+  BOOST_REQUIRE_EQUAL(scores.n_rows, numClasses);
+  BOOST_REQUIRE_EQUAL(scores.n_cols, floatData.n_cols);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -100,6 +100,49 @@ BOOST_AUTO_TEST_CASE(LMNNImpostorsTest)
   BOOST_REQUIRE_EQUAL(impostors(0, 5), 2);
 }
 
+/**
+ * The impostors function should refresh exactly the requested points and
+ * leave the cached results of all other points untouched, even when some
+ * class has no points to refresh.
+ */
+BOOST_AUTO_TEST_CASE(LMNNPartialImpostorsTest)
+{
+  // Useful but simple dataset with six points and two classes.
+  arma::mat dataset        = "-0.1 -0.1 -0.1  0.1  0.1  0.1;"
+                             " 1.0  0.0 -1.0  1.0  0.0 -1.0 ";
+  arma::Row<size_t> labels = " 0    0    0    1    1    1   ";
+
+  Constraints<> constraint(dataset, labels, 1);
+
+  // Calculate norm of datapoints.
+  arma::vec norm(dataset.n_cols);
+  for (size_t i = 0; i < dataset.n_cols; ++i)
+  {
+    norm(i) = arma::norm(dataset.col(i));
+  }
+
+  // Fill cached results with sentinel values; only the refreshed columns may
+  // change.
+  arma::Mat<size_t> impostors(1, dataset.n_cols);
+  impostors.fill(dataset.n_cols);
+  arma::mat distances(1, dataset.n_cols, arma::fill::ones);
+
+  // Refresh two points of class 0 only; class 1 has nothing to refresh.
+  arma::uvec points("0 2");
+  constraint.Impostors(impostors, distances, dataset, labels, norm, points, 2);
+
+  BOOST_REQUIRE_EQUAL(impostors(0, 0), 3);
+  BOOST_REQUIRE_EQUAL(impostors(0, 2), 5);
+
+  // Cached columns must be untouched.
+  BOOST_REQUIRE_EQUAL(impostors(0, 1), dataset.n_cols);
+  BOOST_REQUIRE_EQUAL(impostors(0, 3), dataset.n_cols);
+  BOOST_REQUIRE_EQUAL(impostors(0, 4), dataset.n_cols);
+  BOOST_REQUIRE_EQUAL(impostors(0, 5), dataset.n_cols);
+  BOOST_REQUIRE_CLOSE(distances(0, 1), 1.0, 1e-10);
+  BOOST_REQUIRE_CLOSE(distances(0, 3), 1.0, 1e-10);
+}
+
 //
 // Tests for the LMNNFunction
 //
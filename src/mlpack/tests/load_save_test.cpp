@@ -13,6 +13,14 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/core/data/load_arff.hpp>
+#include <mlpack/core/data/load_libsvm.hpp>
+#include <mlpack/core/data/async_checkpoint.hpp>
+#include <mlpack/core/data/mmap_load.hpp>
+#include <mlpack/core/data/streaming_dataset.hpp>
+#include <mlpack/core/data/binary_dataset.hpp>
+#include <mlpack/core/data/sectioned_model_file.hpp>
+#include <mlpack/core/data/compressed_archive.hpp>
+#include <mlpack/core/data/huge_page_load.hpp>
 #include <mlpack/core/data/map_policies/missing_policy.hpp>
 #include "catch.hpp"
 #include "test_catch_tools.hpp"
@@ -203,6 +211,96 @@ TEST_CASE("LoadSparseTXTTest", "[LoadSaveTest]")
   remove("test_sparse_file.txt");
 }
 
+/**
+ * Make sure a libsvm-format file is loaded correctly, including comments,
+ * blank lines, qid tokens, and unsorted feature indices.
+ */
+TEST_CASE("LoadLibSVMTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test_file.libsvm", fstream::out);
+
+  f << "# a comment line" << endl;
+  f << "1 1:0.5 3:1.5 7:2.5" << endl;
+  f << "-1 2:3.5 # trailing comment" << endl;
+  f << endl;
+  f << "2.5 qid:4 7:0.25 3:0.75" << endl; // Unsorted indices.
+  f << "3"; // A point with no features and no trailing newline.
+
+  f.close();
+
+  arma::sp_mat test;
+  arma::rowvec labels;
+  REQUIRE(data::LoadLibSVM("test_file.libsvm", test, labels) == true);
+
+  // Indices are 1-based, so the dimensionality is 7.
+  REQUIRE(test.n_rows == 7);
+  REQUIRE(test.n_cols == 4);
+  REQUIRE(test.n_nonzero == 6);
+  REQUIRE(labels.n_elem == 4);
+
+  REQUIRE(labels[0] == Approx(1.0).epsilon(1e-7));
+  REQUIRE(labels[1] == Approx(-1.0).epsilon(1e-7));
+  REQUIRE(labels[2] == Approx(2.5).epsilon(1e-7));
+  REQUIRE(labels[3] == Approx(3.0).epsilon(1e-7));
+
+  REQUIRE((double) test(0, 0) == Approx(0.5).epsilon(1e-7));
+  REQUIRE((double) test(2, 0) == Approx(1.5).epsilon(1e-7));
+  REQUIRE((double) test(6, 0) == Approx(2.5).epsilon(1e-7));
+  REQUIRE((double) test(1, 1) == Approx(3.5).epsilon(1e-7));
+  REQUIRE((double) test(2, 2) == Approx(0.75).epsilon(1e-7));
+  REQUIRE((double) test(6, 2) == Approx(0.25).epsilon(1e-7));
+
+  remove("test_file.libsvm");
+}
+
+/**
+ * A libsvm file that uses a feature index of 0 anywhere must be treated as
+ * 0-based throughout.
+ */
+TEST_CASE("LoadLibSVMZeroBasedTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test_file.libsvm", fstream::out);
+
+  f << "1 0:1.0 2:2.0" << endl;
+  f << "0 1:3.0" << endl;
+
+  f.close();
+
+  arma::sp_mat test;
+  arma::rowvec labels;
+  REQUIRE(data::LoadLibSVM("test_file.libsvm", test, labels) == true);
+
+  REQUIRE(test.n_rows == 3);
+  REQUIRE(test.n_cols == 2);
+  REQUIRE((double) test(0, 0) == Approx(1.0).epsilon(1e-7));
+  REQUIRE((double) test(2, 0) == Approx(2.0).epsilon(1e-7));
+  REQUIRE((double) test(1, 1) == Approx(3.0).epsilon(1e-7));
+
+  remove("test_file.libsvm");
+}
+
+/**
+ * A malformed libsvm file and a nonexistent file must both fail to load.
+ */
+TEST_CASE("LoadLibSVMFailureTest", "[LoadSaveTest]")
+{
+  arma::sp_mat test;
+  arma::rowvec labels;
+  REQUIRE(data::LoadLibSVM("nonexistent.libsvm", test, labels) == false);
+
+  fstream f;
+  f.open("test_file.libsvm", fstream::out);
+  f << "1 3:0.5" << endl;
+  f << "1 nonsense" << endl;
+  f.close();
+
+  REQUIRE(data::LoadLibSVM("test_file.libsvm", test, labels) == false);
+
+  remove("test_file.libsvm");
+}
+
 /**
  * Make sure a TSV is loaded correctly.
  */
@@ -1348,6 +1446,28 @@ TEST_CASE("LoadTextTest", "[LoadSaveTest]")
   REQUIRE(y.inb.s == x.inb.s);
 }
 
+/**
+ * Make sure a binary model archive holding a matrix payload round-trips
+ * correctly; these archives are read through the memory-mapped fast path.
+ */
+TEST_CASE("LoadBinaryMatrixModelTest", "[LoadSaveTest]")
+{
+  arma::mat x = arma::randu<arma::mat>(20, 30);
+
+  REQUIRE(data::Save("test_matrix_model.bin", "x", x, false) == true);
+
+  // Now reload.
+  arma::mat y;
+  REQUIRE(data::Load("test_matrix_model.bin", "x", y, false) == true);
+
+  REQUIRE(y.n_rows == x.n_rows);
+  REQUIRE(y.n_cols == x.n_cols);
+  for (size_t i = 0; i < x.n_elem; ++i)
+    REQUIRE(y[i] == Approx(x[i]).epsilon(1e-10));
+
+  remove("test_matrix_model.bin");
+}
+
 /**
  * Test DatasetInfo by making a map for a dimension.
  */
@@ -1396,6 +1516,46 @@ TEST_CASE("DatasetInfoTest", "[LoadSaveTest]")
   REQUIRE(strThird == "test_mapping_3");
 }
 
+/**
+ * Test merging the mappings of one DatasetInfo into another, as done for the
+ * per-thread mappers of a parallel categorical load.
+ */
+TEST_CASE("DatasetInfoMergeTest", "[LoadSaveTest]")
+{
+  DatasetInfo di(4);
+  di.MapString<size_t>("a", 1);
+  di.MapString<size_t>("b", 1);
+  di.MapString<size_t>("x", 3);
+
+  // The other mapper maps an overlapping set of strings, in a different
+  // order, plus a dimension the first mapper has no mappings for.
+  DatasetInfo other(4);
+  other.MapString<size_t>("b", 1); // Maps to 0 here, 1 in di.
+  other.MapString<size_t>("c", 1); // Maps to 1 here, will get 2 in di.
+  other.MapString<size_t>("a", 1); // Maps to 2 here, 0 in di.
+  other.MapString<size_t>("y", 2); // New dimension for di.
+
+  std::unordered_map<size_t, std::unordered_map<size_t, size_t>> translations;
+  di.Merge(other, translations);
+
+  // The merged mapper must contain all mappings, with di's codes unchanged.
+  REQUIRE(di.NumMappings(1) == 3);
+  REQUIRE(di.UnmapValue("a", 1) == 0);
+  REQUIRE(di.UnmapValue("b", 1) == 1);
+  REQUIRE(di.UnmapValue("c", 1) == 2);
+  REQUIRE(di.NumMappings(2) == 1);
+  REQUIRE(di.Type(2) == Datatype::categorical);
+  REQUIRE(di.UnmapValue("y", 2) == 0);
+  REQUIRE(di.NumMappings(3) == 1);
+
+  // The translations must rewrite the other mapper's codes that changed.
+  REQUIRE(translations[1][0] == 1); // "b"
+  REQUIRE(translations[1][1] == 2); // "c"
+  REQUIRE(translations[1][2] == 0); // "a"
+  // "y" kept its code, so there must be no entry for it.
+  REQUIRE(translations.count(2) == 0);
+}
+
 /**
  * Test loading regular CSV with DatasetInfo.  Everything should be numeric.
  */
@@ -2292,6 +2452,176 @@ TEST_CASE("CategoryCaseTest", "[LoadSaveTest]")
   remove("test.arff");
 }
 
+/**
+ * An ARFF load test mixing quoted and unquoted lines, so that some lines can
+ * be parsed with the fast unquoted path and others need escape-aware
+ * tokenization.
+ */
+TEST_CASE("MixedQuotingARFFTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test.arff", fstream::out);
+  f << "@relation test" << endl;
+  f << endl;
+  f << "@attribute one STRING" << endl;
+  f << "@attribute two NUMERIC" << endl;
+  f << endl;
+  f << "@data" << endl;
+  f << "moo, 1" << endl;
+  f << "\"hello, goodbye\", 2" << endl;
+  f << "moo, 3" << endl;
+  f << "\"hello, goodbye\", 4" << endl;
+  f << "cheese, 5" << endl;
+  f.close();
+
+  arma::mat dataset;
+  DatasetInfo info;
+  data::Load("test.arff", dataset, info);
+
+  REQUIRE(info.Dimensionality() == 2);
+  REQUIRE(info.Type(0) == Datatype::categorical);
+  REQUIRE(info.NumMappings(0) == 3);
+  REQUIRE(info.Type(1) == Datatype::numeric);
+
+  REQUIRE(dataset.n_rows == 2);
+  REQUIRE(dataset.n_cols == 5);
+
+  // The quoted and unquoted cells must map consistently.
+  REQUIRE(dataset(0, 0) == dataset(0, 2));
+  REQUIRE(dataset(0, 1) == dataset(0, 3));
+  REQUIRE(dataset(0, 0) != dataset(0, 1));
+  REQUIRE(dataset(0, 1) != dataset(0, 4));
+  REQUIRE(dataset(0, 0) != dataset(0, 4));
+
+  REQUIRE((double) info.UnmapValue("moo", 0) == dataset(0, 0));
+  REQUIRE((double) info.UnmapValue("hello, goodbye", 0) == dataset(0, 1));
+  REQUIRE((double) info.UnmapValue("cheese", 0) == dataset(0, 4));
+
+  for (size_t i = 0; i < 5; ++i)
+    REQUIRE(dataset(1, i) == Approx(double(i + 1)).epsilon(1e-7));
+
+  remove("test.arff");
+}
+
+/**
+ * Test that a dataset can be loaded into huge-page-backed memory and read
+ * back unchanged (including when the system has no huge pages and the
+ * allocation falls back to ordinary memory).
+ */
+TEST_CASE("HugePageLoadTest", "[LoadSaveTest]")
+{
+  arma::mat test = arma::randu<arma::mat>(5, 40);
+  data::Save("test_file.csv", test);
+
+  HugePageMatrix<double> matrix;
+  REQUIRE(HugePageLoad("test_file.csv", matrix));
+  REQUIRE(matrix.Rows() == 5);
+  REQUIRE(matrix.Cols() == 40);
+
+  arma::mat alias = matrix.Matrix();
+  REQUIRE(alias.n_rows == 5);
+  REQUIRE(alias.n_cols == 40);
+  for (size_t i = 0; i < test.n_elem; ++i)
+    REQUIRE(alias[i] == Approx(test[i]).epsilon(1e-5));
+
+  // The alias writes through to the backing buffer.
+  alias(0, 0) = 37.0;
+  arma::mat alias2 = matrix.Matrix();
+  REQUIRE(alias2(0, 0) == Approx(37.0));
+
+  // Loading a nonexistent file must fail.
+  REQUIRE(!HugePageLoad("nonexistent_file.csv", matrix));
+
+  remove("test_file.csv");
+}
+
+/**
+ * Test that a sectioned model file can be saved and that individual sections
+ * can be lazily loaded in any order.
+ */
+TEST_CASE("SectionedModelFileTest", "[LoadSaveTest]")
+{
+  arma::mat model = arma::randu<arma::mat>(10, 10);
+  arma::mat dataset = arma::randu<arma::mat>(50, 100);
+
+  SectionedModelFile file;
+  file.Add("model", model);
+  file.Add("dataset", dataset);
+  REQUIRE(file.Save("test_sections.bin"));
+
+  // Open the file lazily; only the index is read here.
+  SectionedModelFile loaded("test_sections.bin");
+  REQUIRE(loaded.Has("model"));
+  REQUIRE(loaded.Has("dataset"));
+  REQUIRE(!loaded.Has("labels"));
+  REQUIRE(loaded.SectionNames().size() == 2);
+
+  // Materialize the sections out of order.
+  arma::mat loadedDataset;
+  REQUIRE(loaded.Load("dataset", loadedDataset));
+  CheckMatrices(dataset, loadedDataset);
+
+  arma::mat loadedModel;
+  REQUIRE(loaded.Load("model", loadedModel));
+  CheckMatrices(model, loadedModel);
+
+  // A missing section must fail without being fatal.
+  arma::mat missing;
+  REQUIRE(!loaded.Load("labels", missing));
+
+  // A non-sectioned file must be rejected when opened.
+  arma::mat csvData = arma::randu<arma::mat>(3, 5);
+  data::Save("test_file.csv", csvData);
+  SectionedModelFile bad;
+  REQUIRE(!bad.Open("test_file.csv"));
+
+  remove("test_sections.bin");
+  remove("test_file.csv");
+}
+
+/**
+ * Test that a compressed archive round-trips an object exactly, that a
+ * redundant payload actually shrinks on disk, and that corrupted or missing
+ * files are rejected.
+ */
+TEST_CASE("CompressedArchiveTest", "[LoadSaveTest]")
+{
+  // A redundant matrix (few distinct values) compresses well; random noise
+  // in a corner makes sure mixed compressible/raw content works too.
+  arma::mat model(200, 500);
+  model.fill(1.0);
+  model.submat(0, 0, 49, 49) = arma::randu<arma::mat>(50, 50);
+
+  REQUIRE(data::SaveCompressed("test_compressed.bin", "model", model));
+
+  // The file must be much smaller than the raw element storage.
+  std::ifstream size("test_compressed.bin",
+      std::ifstream::ate | std::ifstream::binary);
+  REQUIRE(size.is_open());
+  REQUIRE((size_t) size.tellg() <
+      (model.n_elem * sizeof(double)) / 2);
+  size.close();
+
+  arma::mat loadedModel;
+  REQUIRE(data::LoadCompressed("test_compressed.bin", "model", loadedModel));
+  CheckMatrices(model, loadedModel);
+
+  // An incompressible payload must still round-trip (via raw chunks).
+  arma::mat noise = arma::randu<arma::mat>(100, 100);
+  REQUIRE(data::SaveCompressed("test_compressed.bin", "model", noise));
+  REQUIRE(data::LoadCompressed("test_compressed.bin", "model", loadedModel));
+  CheckMatrices(noise, loadedModel);
+
+  // A missing file and a file that is not a compressed archive must fail.
+  REQUIRE(!data::LoadCompressed("nonexistent_compressed.bin", "model",
+      loadedModel));
+  data::Save("test_file.csv", noise);
+  REQUIRE(!data::LoadCompressed("test_file.csv", "model", loadedModel));
+
+  remove("test_compressed.bin");
+  remove("test_file.csv");
+}
+
 /**
  * Test that a CSV with the wrong number of columns fails.
  */
@@ -2466,3 +2796,342 @@ TEST_CASE("DatasetMapperNonUniqueTest", "[LoadSaveTest]")
   REQUIRE(dm.UnmapString(nan, 0, 1) == "goodbye");
   REQUIRE(dm.UnmapString(nan, 0, 2) == "cheese");
 }
+
+/**
+ * Make sure MmapLoad() maps a raw binary column-major file without copying.
+ */
+TEST_CASE("MmapLoadTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(10, 50, arma::fill::randu);
+
+  // Write the raw column-major element block to disk.
+  std::ofstream f("mmap_test.bin", std::ios::binary);
+  f.write((const char*) dataset.memptr(),
+      dataset.n_elem * sizeof(double));
+  f.close();
+
+  data::MmapMatrix<double> handle;
+  REQUIRE(data::MmapLoad("mmap_test.bin", 10, 50, handle) == true);
+  REQUIRE(handle.IsMapped() == true);
+  REQUIRE(handle.Rows() == 10);
+  REQUIRE(handle.Cols() == 50);
+
+  arma::mat alias = handle.Matrix();
+  REQUIRE(alias.n_rows == 10);
+  REQUIRE(alias.n_cols == 50);
+  CheckMatrices(alias, dataset);
+
+  // The mapping is private, so writes must not reach the file.
+  alias(0, 0) = 17.0;
+
+  handle.Unmap();
+  REQUIRE(handle.IsMapped() == false);
+
+  data::MmapMatrix<double> handle2;
+  REQUIRE(data::MmapLoad("mmap_test.bin", 10, 50, handle2) == true);
+  REQUIRE(handle2.Matrix()(0, 0) == Approx(dataset(0, 0)));
+
+  // A load of a file that is too small must fail.
+  data::MmapMatrix<double> handle3;
+  REQUIRE(data::MmapLoad("mmap_test.bin", 100, 50, handle3) == false);
+
+  remove("mmap_test.bin");
+}
+
+/**
+ * Make sure StreamingDataset yields the same data as a full load, in chunks.
+ */
+TEST_CASE("StreamingDatasetCSVTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(5, 37, arma::fill::randu);
+  REQUIRE(data::Save("stream_test.csv", dataset) == true);
+
+  data::StreamingDataset<double> stream("stream_test.csv", 10);
+  REQUIRE(stream.Dimensionality() == 5);
+  REQUIRE(stream.ChunkSize() == 10);
+
+  arma::mat reassembled(5, 0);
+  arma::mat chunk;
+  while (stream.Next(chunk))
+  {
+    REQUIRE(chunk.n_rows == 5);
+    REQUIRE(chunk.n_cols <= 10);
+    reassembled = arma::join_rows(reassembled, chunk);
+  }
+
+  REQUIRE(reassembled.n_cols == dataset.n_cols);
+  CheckMatrices(reassembled, dataset, 1e-5);
+
+  // A second epoch after Reset() must produce the same columns.
+  stream.Reset();
+  size_t cols = 0;
+  while (stream.Next(chunk))
+    cols += chunk.n_cols;
+  REQUIRE(cols == dataset.n_cols);
+
+  remove("stream_test.csv");
+}
+
+/**
+ * Test StreamingDataset over a raw binary column-major file.
+ */
+TEST_CASE("StreamingDatasetBinaryTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(8, 25, arma::fill::randu);
+
+  std::ofstream f("stream_test.bin", std::ios::binary);
+  f.write((const char*) dataset.memptr(),
+      dataset.n_elem * sizeof(double));
+  f.close();
+
+  data::StreamingDataset<double> stream("stream_test.bin", 7, 8);
+
+  arma::mat reassembled(8, 0);
+  arma::mat chunk;
+  while (stream.Next(chunk))
+    reassembled = arma::join_rows(reassembled, chunk);
+
+  REQUIRE(reassembled.n_cols == dataset.n_cols);
+  CheckMatrices(reassembled, dataset);
+
+  remove("stream_test.bin");
+}
+
+/**
+ * Test a round trip through the indexed binary dataset format, including a
+ * partial column-range load and a header-only statistics read.
+ */
+TEST_CASE("IndexedBinaryDatasetTest", "[LoadSaveTest]")
+{
+  arma::mat dataset(6, 100, arma::fill::randu);
+
+  // Use a small group size so multiple column groups are exercised.
+  REQUIRE(data::SaveBinaryDataset("indexed_test.bin", dataset, false, 16)
+      == true);
+
+  // Full load.
+  arma::mat reloaded;
+  REQUIRE(data::LoadBinaryDataset("indexed_test.bin", reloaded) == true);
+  CheckMatrices(reloaded, dataset);
+
+  // Partial load spanning a group boundary.
+  arma::mat range;
+  REQUIRE(data::LoadBinaryDataset("indexed_test.bin", range, 10, 20) == true);
+  REQUIRE(range.n_rows == 6);
+  REQUIRE(range.n_cols == 20);
+  CheckMatrices(range, arma::mat(dataset.cols(10, 29)));
+
+  // Header-only statistics read.
+  data::BinaryDatasetInfo info;
+  REQUIRE(data::ReadBinaryDatasetInfo("indexed_test.bin", info) == true);
+  REQUIRE(info.rows == 6);
+  REQUIRE(info.cols == 100);
+  REQUIRE(info.groupCols == 16);
+  for (size_t d = 0; d < 6; ++d)
+  {
+    REQUIRE(info.mins[d] == Approx(dataset.row(d).min()));
+    REQUIRE(info.maxs[d] == Approx(dataset.row(d).max()));
+  }
+
+  // An out-of-range request must fail.
+  arma::mat bad;
+  REQUIRE(data::LoadBinaryDataset("indexed_test.bin", bad, 95, 10) == false);
+
+  // A float load of a double file must fail.
+  arma::fmat wrongType;
+  REQUIRE(data::LoadBinaryDataset("indexed_test.bin", wrongType) == false);
+
+  remove("indexed_test.bin");
+}
+
+/**
+ * Make sure loading only a few dimensions of a CSV gives the right values in
+ * the right order.
+ */
+TEST_CASE("LoadProjectedCSVTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+  f << "1, 2, 3, 4" << endl;
+  f << "5, 6, 7, 8" << endl;
+  f << "9, 10, 11, 12" << endl;
+  f.close();
+
+  // Request dimensions out of order, to check that the output order follows
+  // the request.
+  std::vector<size_t> dimensions;
+  dimensions.push_back(3);
+  dimensions.push_back(1);
+
+  arma::mat test;
+  REQUIRE(data::Load("test_file.csv", test, dimensions) == true);
+
+  REQUIRE(test.n_rows == 2);
+  REQUIRE(test.n_cols == 3);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    REQUIRE(test(0, i) == Approx(4.0 * (i + 1)).epsilon(1e-5));
+    REQUIRE(test(1, i) == Approx(4.0 * i + 2.0).epsilon(1e-5));
+  }
+
+  // Without the transpose, points are rows, like the file.
+  arma::mat untransposed;
+  REQUIRE(data::Load("test_file.csv", untransposed, dimensions, false, false)
+      == true);
+
+  REQUIRE(untransposed.n_rows == 3);
+  REQUIRE(untransposed.n_cols == 2);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    REQUIRE(untransposed(i, 0) == Approx(4.0 * (i + 1)).epsilon(1e-5));
+    REQUIRE(untransposed(i, 1) == Approx(4.0 * i + 2.0).epsilon(1e-5));
+  }
+
+  // A dimension past the end of the points must fail.
+  std::vector<size_t> tooFar;
+  tooFar.push_back(10);
+  REQUIRE(data::Load("test_file.csv", test, tooFar) == false);
+
+  remove("test_file.csv");
+}
+
+/**
+ * Make sure dimension projection works on space-separated files too, and
+ * fails cleanly on binary files.
+ */
+TEST_CASE("LoadProjectedRawASCIITest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test_file.txt", fstream::out);
+  f << "1 2 3" << endl;
+  f << "4 5 6" << endl;
+  f.close();
+
+  std::vector<size_t> dimensions;
+  dimensions.push_back(2);
+
+  arma::mat test;
+  REQUIRE(data::Load("test_file.txt", test, dimensions) == true);
+
+  REQUIRE(test.n_rows == 1);
+  REQUIRE(test.n_cols == 2);
+  REQUIRE(test(0, 0) == Approx(3.0).epsilon(1e-5));
+  REQUIRE(test(0, 1) == Approx(6.0).epsilon(1e-5));
+
+  remove("test_file.txt");
+
+  // Binary formats cannot be projected.
+  arma::mat dataset(4, 10, arma::fill::randu);
+  REQUIRE(data::Save("test_file.bin", dataset) == true);
+  REQUIRE(data::Load("test_file.bin", test, dimensions) == false);
+
+  remove("test_file.bin");
+}
+
+/**
+ * Make sure data::Inspect() reports the size of text and Armadillo-format
+ * files without loading them.
+ */
+TEST_CASE("InspectTest", "[LoadSaveTest]")
+{
+  fstream f;
+  f.open("test_file.csv", fstream::out);
+  f << "1, 2, 3, 4" << endl;
+  f << "5, 6, 7, 8" << endl;
+  f << "9, 10, 11, 12" << endl;
+  f.close();
+
+  size_t rows, cols;
+  REQUIRE(data::Inspect("test_file.csv", rows, cols) == true);
+  REQUIRE(rows == 4);
+  REQUIRE(cols == 3);
+
+  remove("test_file.csv");
+
+  // Space-separated text.
+  f.open("test_file.txt", fstream::out);
+  f << "1 2 3" << endl;
+  f << "4 5 6" << endl;
+  f.close();
+
+  REQUIRE(data::Inspect("test_file.txt", rows, cols) == true);
+  REQUIRE(rows == 3);
+  REQUIRE(cols == 2);
+
+  remove("test_file.txt");
+
+  // Armadillo binary: answered from the header.
+  arma::mat dataset(6, 50, arma::fill::randu);
+  REQUIRE(data::Save("test_file.bin", dataset) == true);
+
+  REQUIRE(data::Inspect("test_file.bin", rows, cols) == true);
+  REQUIRE(rows == 6);
+  REQUIRE(cols == 50);
+
+  remove("test_file.bin");
+
+  // A nonexistent file must fail.
+  REQUIRE(data::Inspect("nonexistentfile_______________.csv", rows, cols)
+      == false);
+}
+
+/**
+ * An asynchronous checkpoint must write the snapshotted model to disk, even
+ * if the model keeps changing after Checkpoint() returns.
+ */
+TEST_CASE("AsyncCheckpointTest", "[LoadSaveTest]")
+{
+  arma::mat model = arma::randu<arma::mat>(10, 10);
+  const arma::mat snapshot(model);
+
+  AsyncCheckpoint<arma::mat> checkpointer(model, "async_checkpoint_test.xml");
+  REQUIRE(checkpointer.Checkpoint() == true);
+
+  // The checkpointer must only read its shadow copy, so modifying the model
+  // immediately must not affect the checkpoint being written.
+  model.randu();
+
+  REQUIRE(checkpointer.Wait() == true);
+
+  arma::mat loaded;
+  REQUIRE(data::Load("async_checkpoint_test.xml", "model", loaded) == true);
+  CheckMatrices(loaded, snapshot);
+
+  remove("async_checkpoint_test.xml");
+}
+
+/**
+ * The StepTaken() callback hook must checkpoint every `interval` steps and
+ * must never ask the optimizer to terminate.
+ */
+TEST_CASE("AsyncCheckpointCallbackTest", "[LoadSaveTest]")
+{
+  arma::mat model = arma::randu<arma::mat>(5, 5);
+
+  AsyncCheckpoint<arma::mat> checkpointer(model,
+      "async_checkpoint_callback_test.bin", "model", 3);
+  REQUIRE(checkpointer.Interval() == 3);
+
+  int dummy = 0;
+
+  // The first two steps must not produce a checkpoint.
+  REQUIRE(checkpointer.StepTaken(dummy, dummy, model) == false);
+  REQUIRE(checkpointer.StepTaken(dummy, dummy, model) == false);
+  REQUIRE(checkpointer.Wait() == true);
+
+  fstream f("async_checkpoint_callback_test.bin");
+  REQUIRE(f.good() == false);
+  f.close();
+
+  // The third step must checkpoint the current model.
+  model.ones();
+  REQUIRE(checkpointer.StepTaken(dummy, dummy, model) == false);
+  REQUIRE(checkpointer.Wait() == true);
+
+  arma::mat loaded;
+  REQUIRE(data::Load("async_checkpoint_callback_test.bin", "model", loaded)
+      == true);
+  CheckMatrices(loaded, model);
+
+  remove("async_checkpoint_callback_test.bin");
+}
@@ -190,4 +190,50 @@ BOOST_AUTO_TEST_CASE(LocalCoordinateCodingTrainReturnObjective)
   BOOST_REQUIRE_EQUAL(std::isfinite(objVal), true);
 }
 
+/**
+ * Test that the nearest-atoms prescreen only assigns weight to the selected
+ * atoms and does not degrade the objective too much.
+ */
+BOOST_AUTO_TEST_CASE(LocalCoordinateCodingNearestAtomsTest)
+{
+  double lambda1 = 0.1;
+  uword nAtoms = 10;
+  uword nearestAtoms = 3;
+
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+  uword nPoints = X.n_cols;
+
+  // Normalize each point since these are images.
+  for (uword i = 0; i < nPoints; ++i)
+  {
+    X.col(i) /= norm(X.col(i), 2);
+  }
+
+  LocalCoordinateCoding lcc(X, nAtoms, lambda1, 10);
+
+  // Code once with all atoms, then again with the prescreen.
+  mat Z;
+  lcc.Encode(X, Z);
+
+  lcc.NearestAtoms() = nearestAtoms;
+  mat zPrescreened;
+  lcc.Encode(X, zPrescreened);
+
+  BOOST_REQUIRE_EQUAL(zPrescreened.n_rows, nAtoms);
+  BOOST_REQUIRE_EQUAL(zPrescreened.n_cols, nPoints);
+
+  // No point may use more than the requested number of atoms.
+  for (uword i = 0; i < nPoints; ++i)
+    BOOST_REQUIRE_LE(accu(zPrescreened.col(i) != 0), nearestAtoms);
+
+  // The prescreened coding is an approximation, but since distant atoms are
+  // heavily penalized anyway it should remain in the same ballpark.
+  const double objFull = lcc.Objective(X, Z, find(Z));
+  const double objPrescreened = lcc.Objective(X, zPrescreened,
+      find(zPrescreened));
+  BOOST_REQUIRE_EQUAL(std::isfinite(objPrescreened), true);
+  BOOST_REQUIRE_LE(objPrescreened, 2.0 * objFull);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
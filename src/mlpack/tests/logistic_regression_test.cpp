@@ -1057,4 +1057,101 @@ BOOST_AUTO_TEST_CASE(IncrementalTraining)
   BOOST_REQUIRE_CLOSE(acc, 100.0, 3.0); // 3% error tolerance.
 }
 
+/**
+ * Test warm-started training along a regularization path.
+ */
+BOOST_AUTO_TEST_CASE(LogisticRegressionTrainPathTest)
+{
+  // Generate a two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 1.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("9.0 9.0 9.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(3, 500);
+  arma::Row<size_t> responses(500);
+  for (size_t i = 0; i < 250; ++i)
+  {
+    data.col(i) = g1.Random();
+    responses(i) = 0;
+  }
+  for (size_t i = 250; i < 500; ++i)
+  {
+    data.col(i) = g2.Random();
+    responses(i) = 1;
+  }
+
+  // Sweep from the most to the least regularized lambda.
+  arma::vec lambdas("10.0 1.0 0.1 0.01 0.0");
+
+  LogisticRegression<> lr(data.n_rows, 0.0);
+  arma::mat pathParameters;
+  arma::vec objectives = lr.TrainPath(data, responses, lambdas,
+      pathParameters);
+
+  BOOST_REQUIRE_EQUAL(objectives.n_elem, lambdas.n_elem);
+  BOOST_REQUIRE_EQUAL(pathParameters.n_rows, lambdas.n_elem);
+  BOOST_REQUIRE_EQUAL(pathParameters.n_cols, data.n_rows + 1);
+
+  // With a decreasing lambda sequence the optimal objective cannot increase.
+  for (size_t i = 1; i < objectives.n_elem; ++i)
+    BOOST_REQUIRE_LE(objectives(i), objectives(i - 1) + 1e-5);
+
+  // The model should hold the solution for the last lambda.
+  BOOST_REQUIRE_EQUAL(lr.Lambda(), lambdas(lambdas.n_elem - 1));
+  CheckMatrices(lr.Parameters(),
+      arma::rowvec(pathParameters.row(pathParameters.n_rows - 1)));
+
+  // The dataset is linearly separable, so the final model should classify it
+  // almost perfectly.
+  BOOST_REQUIRE_CLOSE(lr.ComputeAccuracy(data, responses), 100.0, 1.0);
+}
+
+
+/**
+ * Test that a single-precision model can be trained and used for
+ * classification, and that it agrees with a double-precision model trained on
+ * the same data.
+ */
+BOOST_AUTO_TEST_CASE(LogisticRegressionFMatTest)
+{
+  // Generate a two-Gaussian dataset.
+  GaussianDistribution g1(arma::vec("1.0 1.0 1.0"), arma::eye<arma::mat>(3, 3));
+  GaussianDistribution g2(arma::vec("9.0 9.0 9.0"), arma::eye<arma::mat>(3, 3));
+
+  arma::mat data(3, 500);
+  arma::Row<size_t> responses(500);
+  for (size_t i = 0; i < 250; ++i)
+  {
+    data.col(i) = g1.Random();
+    responses(i) = 0;
+  }
+  for (size_t i = 250; i < 500; ++i)
+  {
+    data.col(i) = g2.Random();
+    responses(i) = 1;
+  }
+
+  const arma::fmat floatData = arma::conv_to<arma::fmat>::from(data);
+
+  LogisticRegression<arma::fmat> lr(floatData, responses);
+  LogisticRegression<arma::mat> lrDouble(data, responses);
+
+  // The dataset is linearly separable, so the model should classify it almost
+  // perfectly.
+  BOOST_REQUIRE_CLOSE(lr.ComputeAccuracy(floatData, responses), 100.0, 1.0);
+
+  // The single-precision model should agree with the double-precision model.
+  arma::Row<size_t> predictions, doublePredictions;
+  arma::fmat probabilities;
+  lr.Classify(floatData, predictions, probabilities);
+  lrDouble.Classify(data, doublePredictions);
+
+  BOOST_REQUIRE_EQUAL(predictions.n_elem, responses.n_elem);
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(predictions(i), doublePredictions(i));
+
+  // The class probabilities of each point should sum to one.
+  for (size_t i = 0; i < probabilities.n_cols; ++i)
+    BOOST_REQUIRE_CLOSE(arma::accu(probabilities.col(i)), 1.0, 1e-3);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
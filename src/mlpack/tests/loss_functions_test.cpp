@@ -32,6 +32,7 @@
 #include <mlpack/methods/ann/loss_functions/cosine_embedding_loss.hpp>
 #include <mlpack/methods/ann/loss_functions/l1_loss.hpp>
 #include <mlpack/methods/ann/loss_functions/soft_margin_loss.hpp>
+#include <mlpack/methods/ann/loss_functions/softmax_cross_entropy.hpp>
 #include <mlpack/methods/ann/loss_functions/mean_absolute_percentage_error.hpp>
 #include <mlpack/methods/ann/init_rules/nguyen_widrow_init.hpp>
 #include <mlpack/methods/ann/ffn.hpp>
@@ -894,3 +895,35 @@ TEST_CASE("MeanAbsolutePercentageErrorTest", "[LossFunctionsTest]")
   REQUIRE(output.n_cols == input.n_cols);
   CheckMatrices(output, expectedOutput, 0.1);
 }
+
+/**
+ * Test that the fused SoftmaxCrossEntropy loss matches a LogSoftMax layer
+ * followed by NegativeLogLikelihood, for both the loss value and the delta
+ * with respect to the logits.
+ */
+TEST_CASE("SoftmaxCrossEntropyTest", "[LossFunctionsTest]")
+{
+  arma::mat logits = arma::randn(4, 6);
+  arma::mat target = arma::mat("1 3 2 4 1 2");
+
+  // Reference: separate log-softmax and negative log-likelihood passes.
+  LogSoftMax<> logSoftMax;
+  NegativeLogLikelihood<> nll;
+  arma::mat logProb;
+  logSoftMax.Forward(logits, logProb);
+  const double refLoss = nll.Forward(logProb, target);
+
+  arma::mat nllDelta, refDelta;
+  nll.Backward(logProb, target, nllDelta);
+  logSoftMax.Backward(logProb, nllDelta, refDelta);
+
+  SoftmaxCrossEntropy<> module;
+  const double loss = module.Forward(logits, target);
+  arma::mat delta;
+  module.Backward(logits, target, delta);
+
+  REQUIRE(loss == Approx(refLoss).epsilon(1e-7));
+  REQUIRE(delta.n_rows == logits.n_rows);
+  REQUIRE(delta.n_cols == logits.n_cols);
+  CheckMatrices(delta, refDelta, 1e-7);
+}
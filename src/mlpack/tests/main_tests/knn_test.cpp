@@ -698,3 +698,84 @@ TEST_CASE_METHOD(KNNTestFixture, "KNNDifferentLeafSizes",
   REQUIRE(IO::GetParam<KNNModel*>("output_model")->LeafSize() == (int) 10);
   delete output_model;
 }
+
+/**
+ * Ensure that streamed block-wise output matches the buffered output.
+ */
+TEST_CASE_METHOD(KNNTestFixture, "KNNStreamedOutputTest",
+                 "[KNNMainTest][BindingTests]")
+{
+  arma::mat referenceData;
+  referenceData.randu(3, 300); // 300 points in 3 dimensions.
+  arma::mat queryData;
+  queryData.randu(3, 100); // 100 points in 3 dimensions.
+
+  // First run the search with buffered output.
+  SetInputParam("reference", referenceData);
+  SetInputParam("query", queryData);
+  SetInputParam("k", (int) 5);
+
+  mlpackMain();
+
+  arma::Mat<size_t> neighbors =
+      std::move(IO::GetParam<arma::Mat<size_t>>("neighbors"));
+  arma::mat distances = std::move(IO::GetParam<arma::mat>("distances"));
+
+  bindings::tests::CleanMemory();
+
+  IO::GetSingleton().Parameters()["reference"].wasPassed = false;
+  IO::GetSingleton().Parameters()["query"].wasPassed = false;
+
+  // Now run the same search with streamed output, using a block size that
+  // does not evenly divide the number of query points.
+  std::string neighborsFile = "knn_test_streamed_neighbors.csv";
+  std::string distancesFile = "knn_test_streamed_distances.csv";
+
+  SetInputParam("reference", std::move(referenceData));
+  SetInputParam("query", std::move(queryData));
+  SetInputParam("stream_block_size", (int) 17);
+  SetInputParam("streamed_neighbors_file", neighborsFile);
+  SetInputParam("streamed_distances_file", distancesFile);
+
+  mlpackMain();
+
+  // The streamed files hold one row per query point; loading transposes, so
+  // we get one column per query point, like the buffered output.
+  arma::mat streamedNeighbors, streamedDistances;
+  REQUIRE(data::Load(neighborsFile, streamedNeighbors));
+  REQUIRE(data::Load(distancesFile, streamedDistances));
+
+  remove(neighborsFile.c_str());
+  remove(distancesFile.c_str());
+
+  REQUIRE(streamedNeighbors.n_rows == neighbors.n_rows);
+  REQUIRE(streamedNeighbors.n_cols == neighbors.n_cols);
+  REQUIRE(streamedDistances.n_rows == distances.n_rows);
+  REQUIRE(streamedDistances.n_cols == distances.n_cols);
+
+  for (size_t i = 0; i < neighbors.n_elem; ++i)
+  {
+    REQUIRE(streamedNeighbors[i] == (double) neighbors[i]);
+    REQUIRE(streamedDistances[i] == Approx(distances[i]).epsilon(1e-5));
+  }
+}
+
+/**
+ * Ensure that streamed output requires a separate query set.
+ */
+TEST_CASE_METHOD(KNNTestFixture, "KNNStreamedOutputNoQueryTest",
+                 "[KNNMainTest][BindingTests]")
+{
+  arma::mat referenceData;
+  referenceData.randu(3, 100); // 100 points in 3 dimensions.
+
+  SetInputParam("reference", std::move(referenceData));
+  SetInputParam("k", (int) 5);
+  SetInputParam("stream_block_size", (int) 10);
+  SetInputParam("streamed_neighbors_file",
+      (std::string) "knn_test_streamed_neighbors.csv");
+
+  Log::Fatal.ignoreInput = true;
+  REQUIRE_THROWS_AS(mlpackMain(), std::runtime_error);
+  Log::Fatal.ignoreInput = false;
+}
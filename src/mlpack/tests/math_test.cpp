@@ -12,6 +12,9 @@
 #include <mlpack/core/math/clamp.hpp>
 #include <mlpack/core/math/random.hpp>
 #include <mlpack/core/math/range.hpp>
+#include <mlpack/core/math/ccov.hpp>
+#include <mlpack/core/math/incremental_covariance.hpp>
+#include <mlpack/core/math/sampling.hpp>
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
 
@@ -1009,4 +1012,215 @@ BOOST_AUTO_TEST_CASE(InplaceSparseShuffleWeightsTest)
   }
 }
 
+/**
+ * IncrementalCovariance fed in chunks must match ColumnCovariance on the full
+ * matrix, for both normalization types.
+ */
+BOOST_AUTO_TEST_CASE(IncrementalCovarianceTest)
+{
+  arma::mat data = arma::randu<arma::mat>(4, 120);
+
+  IncrementalCovariance<> inc;
+  inc.Update(data.cols(0, 49));
+  inc.Update(data.cols(50, 99));
+  inc.Update(data.cols(100, 119));
+
+  BOOST_REQUIRE_EQUAL(inc.Count(), 120);
+
+  const arma::vec mean = arma::mean(data, 1);
+  for (size_t i = 0; i < data.n_rows; ++i)
+    BOOST_REQUIRE_CLOSE(inc.Mean()[i], mean[i], 1e-8);
+
+  CheckMatrices(inc.Covariance(0), ColumnCovariance(data, 0));
+  CheckMatrices(inc.Covariance(1), ColumnCovariance(data, 1));
+}
+
+/**
+ * Merging two independently-updated IncrementalCovariance objects must give
+ * the same result as one pass over all the data.
+ */
+BOOST_AUTO_TEST_CASE(IncrementalCovarianceMergeTest)
+{
+  arma::mat data = arma::randu<arma::mat>(5, 90);
+
+  IncrementalCovariance<> left, right;
+  left.Update(data.cols(0, 39));
+  right.Update(data.cols(40, 89));
+  left.Merge(right);
+
+  BOOST_REQUIRE_EQUAL(left.Count(), 90);
+  CheckMatrices(left.Covariance(), ColumnCovariance(data));
+
+  // Merging into an empty object should behave like a copy.
+  IncrementalCovariance<> empty;
+  empty.Merge(left);
+  BOOST_REQUIRE_EQUAL(empty.Count(), 90);
+  CheckMatrices(empty.Covariance(), left.Covariance());
+}
+
+/**
+ * RandomStream must be deterministic per (seed, stream, counter), produce
+ * values in [0, 1), and give independent sequences for distinct stream ids.
+ */
+BOOST_AUTO_TEST_CASE(RandomStreamTest)
+{
+  RandomStream a(42, 0);
+  RandomStream b(42, 0);
+  RandomStream c(42, 1);
+
+  size_t differing = 0;
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(a.Bits(i), b.Bits(i));
+    BOOST_REQUIRE_GE(a.Uniform(i), 0.0);
+    BOOST_REQUIRE_LT(a.Uniform(i), 1.0);
+    BOOST_REQUIRE_LT(a.RandInt(i, 10), 10);
+
+    if (a.Bits(i) != c.Bits(i))
+      ++differing;
+  }
+
+  // Different stream ids must give (essentially entirely) different values.
+  BOOST_REQUIRE_GT(differing, 990);
+}
+
+/**
+ * Weighted reservoir sampling must return the requested number of distinct
+ * indices, never pick zero-weight indices, be reproducible for a seed, and
+ * favor heavy indices.
+ */
+BOOST_AUTO_TEST_CASE(WeightedReservoirSampleTest)
+{
+  arma::vec weights(1000, arma::fill::ones);
+  weights.subvec(0, 499).zeros(); // The first half can never be chosen.
+  weights[999] = 1e6; // The last index should essentially always be chosen.
+
+  const arma::uvec sample = WeightedReservoirSample(weights, 50, 42);
+  BOOST_REQUIRE_EQUAL(sample.n_elem, 50);
+  BOOST_REQUIRE_EQUAL(arma::uvec(arma::unique(sample)).n_elem, 50);
+  BOOST_REQUIRE_EQUAL(arma::accu(sample < 500), 0);
+  BOOST_REQUIRE_EQUAL(arma::accu(sample == 999), 1);
+
+  // The same seed must reproduce the same sample; a different seed should
+  // give a different one.
+  const arma::uvec repeat = WeightedReservoirSample(weights, 50, 42);
+  BOOST_REQUIRE(arma::all(arma::sort(sample) == arma::sort(repeat)));
+
+  const arma::uvec other = WeightedReservoirSample(weights, 50, 43);
+  BOOST_REQUIRE(arma::any(arma::sort(sample) != arma::sort(other)));
+
+  // Asking for more positive-weight indices than exist returns all of them.
+  const arma::uvec all = WeightedReservoirSample(weights, 1000, 42);
+  BOOST_REQUIRE_EQUAL(all.n_elem, 500);
+}
+
+/**
+ * Stratified sampling must return the requested number of distinct indices
+ * of every class (or the whole class when it is smaller) and be reproducible
+ * for a seed.
+ */
+BOOST_AUTO_TEST_CASE(StratifiedSampleTest)
+{
+  // Class 0: 500 points; class 1: 490 points; class 2: 10 points.
+  arma::Row<size_t> labels(1000);
+  labels.subvec(0, 499).fill(0);
+  labels.subvec(500, 989).fill(1);
+  labels.subvec(990, 999).fill(2);
+
+  const arma::uvec sample = StratifiedSample(labels, 3, 25, 42);
+  BOOST_REQUIRE_EQUAL(sample.n_elem, 25 + 25 + 10);
+  BOOST_REQUIRE_EQUAL(arma::uvec(arma::unique(sample)).n_elem, sample.n_elem);
+
+  arma::Col<size_t> classCounts(3, arma::fill::zeros);
+  for (size_t i = 0; i < sample.n_elem; ++i)
+    classCounts[labels[sample[i]]]++;
+
+  BOOST_REQUIRE_EQUAL(classCounts[0], 25);
+  BOOST_REQUIRE_EQUAL(classCounts[1], 25);
+  BOOST_REQUIRE_EQUAL(classCounts[2], 10); // The whole small class.
+
+  const arma::uvec repeat = StratifiedSample(labels, 3, 25, 42);
+  BOOST_REQUIRE(arma::all(sample == repeat));
+
+  BOOST_REQUIRE_THROW(StratifiedSample(labels, 2, 25, 42),
+      std::invalid_argument);
+}
+
+/**
+ * A RandomStream must be fully determined by its seed and stream id, and
+ * different stream ids must give different sequences.
+ */
+BOOST_AUTO_TEST_CASE(RandomStreamTest)
+{
+  RandomStream a(17, 3);
+  RandomStream b(17, 3);
+  RandomStream c(17, 4);
+
+  bool cDiffers = false;
+  for (size_t i = 0; i < 100; ++i)
+  {
+    const uint64_t value = a();
+    BOOST_REQUIRE_EQUAL(b(), value);
+    if (c() != value)
+      cDiffers = true;
+  }
+  BOOST_REQUIRE(cDiffers);
+
+  // Reseeding must restart the stream from the beginning.
+  b.Seed(17, 3);
+  a.Seed(17, 3);
+  for (size_t i = 0; i < 10; ++i)
+    BOOST_REQUIRE_EQUAL(a(), b());
+}
+
+/**
+ * After RandomSeed(), the Random()/RandInt()/RandNormal() sequences must be
+ * reproducible.
+ */
+BOOST_AUTO_TEST_CASE(RandomSeedStreamReproducibilityTest)
+{
+  math::RandomSeed(1337);
+  arma::vec uniforms(20), normals(5);
+  arma::Col<int> ints(20);
+  for (size_t i = 0; i < 20; ++i)
+    uniforms[i] = math::Random();
+  for (size_t i = 0; i < 20; ++i)
+    ints[i] = math::RandInt(1000);
+  for (size_t i = 0; i < 5; ++i)
+    normals[i] = math::RandNormal();
+
+  math::RandomSeed(1337);
+  for (size_t i = 0; i < 20; ++i)
+    BOOST_REQUIRE_EQUAL(math::Random(), uniforms[i]);
+  for (size_t i = 0; i < 20; ++i)
+    BOOST_REQUIRE_EQUAL(math::RandInt(1000), ints[i]);
+  for (size_t i = 0; i < 5; ++i)
+    BOOST_REQUIRE_EQUAL(math::RandNormal(), normals[i]);
+}
+
+/**
+ * The random functions must respect their ranges.
+ */
+BOOST_AUTO_TEST_CASE(RandomRangeTest)
+{
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    const double u = math::Random();
+    BOOST_REQUIRE_GE(u, 0.0);
+    BOOST_REQUIRE_LT(u, 1.0);
+
+    const double r = math::Random(2.0, 3.0);
+    BOOST_REQUIRE_GE(r, 2.0);
+    BOOST_REQUIRE_LE(r, 3.0);
+
+    const int z = math::RandInt(10);
+    BOOST_REQUIRE_GE(z, 0);
+    BOOST_REQUIRE_LT(z, 10);
+
+    const int y = math::RandInt(5, 10);
+    BOOST_REQUIRE_GE(y, 5);
+    BOOST_REQUIRE_LT(y, 10);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
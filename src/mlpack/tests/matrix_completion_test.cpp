@@ -64,4 +64,55 @@ BOOST_AUTO_TEST_CASE(UniformMatrixCompletionSDP)
   }
 }
 
+/**
+ * An incremental matrix completion test.
+ *
+ * The same problem as above, but only 90% of the samples are given up front;
+ * the rest arrive through AddEntries() and the second solve warm-starts from
+ * the first factorization.  Recovery with all constraints present must still
+ * be exact.
+ */
+BOOST_AUTO_TEST_CASE(IncrementalMatrixCompletionSDP)
+{
+  arma::mat Xorig, values;
+  arma::umat indices;
+
+  data::Load("completion_X.csv", Xorig, true, false);
+  data::Load("completion_indices.csv", indices, true, false);
+
+  values.set_size(indices.n_cols);
+  for (size_t i = 0; i < indices.n_cols; ++i)
+  {
+    values(i) = Xorig(indices(0, i), indices(1, i));
+  }
+
+  // Hold back the last 10% of the observed entries.
+  const size_t split = (indices.n_cols * 9) / 10;
+  arma::umat initialIndices = indices.cols(0, split - 1);
+  arma::vec initialValues = values.rows(0, split - 1);
+  arma::umat newIndices = indices.cols(split, indices.n_cols - 1);
+  arma::vec newValues = values.rows(split, values.n_elem - 1);
+
+  arma::mat recovered;
+  MatrixCompletion mc(Xorig.n_rows, Xorig.n_cols, initialIndices,
+      initialValues);
+  mc.Recover(recovered);
+
+  mc.AddEntries(newIndices, newValues);
+  mc.Recover(recovered);
+
+  const double err =
+    arma::norm(Xorig - recovered, "fro") /
+    arma::norm(Xorig, "fro");
+  BOOST_REQUIRE_SMALL(err, 1e-5);
+
+  for (size_t i = 0; i < indices.n_cols; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(
+      recovered(indices(0, i), indices(1, i)),
+      Xorig(indices(0, i), indices(1, i)),
+      1e-5);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
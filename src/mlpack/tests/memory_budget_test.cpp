@@ -0,0 +1,135 @@
+/**
+ * @file tests/memory_budget_test.cpp
+ * @author Ryan Curtin
+ *
+ * Tests for the process-wide memory budget.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/util/memory_budget.hpp>
+#include <mlpack/core/util/huge_pages.hpp>
+
+#include "test_catch_tools.hpp"
+#include "catch.hpp"
+
+using namespace mlpack;
+
+/**
+ * Registered allocations must be reflected in Used(), and WouldExceed() must
+ * respect the configured budget.
+ */
+TEST_CASE("MemoryBudgetAccountingTest", "[MemoryBudgetTest]")
+{
+  const size_t baseUsed = MemoryBudget::Used();
+
+  MemoryBudget::Register(1000);
+  REQUIRE(MemoryBudget::Used() == baseUsed + 1000);
+
+  // With no budget set, nothing can exceed it.
+  MemoryBudget::Budget(0);
+  REQUIRE(!MemoryBudget::WouldExceed(std::numeric_limits<size_t>::max() / 2));
+
+  MemoryBudget::Budget(baseUsed + 1500);
+  REQUIRE(MemoryBudget::Budget() == baseUsed + 1500);
+  REQUIRE(!MemoryBudget::WouldExceed(500));
+  REQUIRE(MemoryBudget::WouldExceed(501));
+
+  MemoryBudget::Deregister(1000);
+  REQUIRE(MemoryBudget::Used() == baseUsed);
+
+  MemoryBudget::Budget(0);
+}
+
+/**
+ * A threshold callback must fire once when usage rises across its threshold,
+ * be re-armed when usage falls back below it, and fire again on the next
+ * crossing.
+ */
+TEST_CASE("MemoryBudgetCallbackTest", "[MemoryBudgetTest]")
+{
+  const size_t baseUsed = MemoryBudget::Used();
+  MemoryBudget::Budget(baseUsed + 1000);
+
+  size_t calls = 0;
+  size_t lastUsed = 0, lastBudget = 0;
+  const size_t id = MemoryBudget::AddCallback(0.9,
+      [&](const size_t used, const size_t budget)
+      {
+        ++calls;
+        lastUsed = used;
+        lastBudget = budget;
+      });
+
+  // Rising to 50% must not fire.
+  MemoryBudget::Register(500);
+  REQUIRE(calls == 0);
+
+  // Crossing 90% must fire exactly once, even for further allocations above
+  // the threshold.
+  MemoryBudget::Register(450);
+  REQUIRE(calls == 1);
+  REQUIRE(lastUsed == baseUsed + 950);
+  REQUIRE(lastBudget == baseUsed + 1000);
+  MemoryBudget::Register(10);
+  REQUIRE(calls == 1);
+
+  // Falling below the threshold re-arms the callback; the next crossing
+  // fires again.
+  MemoryBudget::Deregister(600);
+  REQUIRE(calls == 1);
+  MemoryBudget::Register(600);
+  REQUIRE(calls == 2);
+
+  MemoryBudget::Deregister(960);
+  MemoryBudget::RemoveCallback(id);
+  MemoryBudget::Budget(0);
+  REQUIRE(MemoryBudget::Used() == baseUsed);
+}
+
+/**
+ * MemoryRegistration must register at construction, deregister at
+ * destruction, transfer ownership on move, and support resizing.
+ */
+TEST_CASE("MemoryRegistrationTest", "[MemoryBudgetTest]")
+{
+  const size_t baseUsed = MemoryBudget::Used();
+
+  {
+    MemoryRegistration registration(2000);
+    REQUIRE(MemoryBudget::Used() == baseUsed + 2000);
+
+    // Moving must not double-count.
+    MemoryRegistration moved(std::move(registration));
+    REQUIRE(MemoryBudget::Used() == baseUsed + 2000);
+    REQUIRE(moved.Bytes() == 2000);
+
+    moved.Reset(500);
+    REQUIRE(MemoryBudget::Used() == baseUsed + 500);
+  }
+
+  REQUIRE(MemoryBudget::Used() == baseUsed);
+}
+
+/**
+ * HugePageBuffer allocations must be accounted against the budget for the
+ * lifetime of the buffer.
+ */
+TEST_CASE("MemoryBudgetHugePageBufferTest", "[MemoryBudgetTest]")
+{
+  const size_t baseUsed = MemoryBudget::Used();
+
+  {
+    HugePageBuffer buffer(1 << 16);
+    REQUIRE(buffer.Memory() != NULL);
+    REQUIRE(MemoryBudget::Used() == baseUsed + (1 << 16));
+
+    buffer.Allocate(1 << 10);
+    REQUIRE(MemoryBudget::Used() == baseUsed + (1 << 10));
+  }
+
+  REQUIRE(MemoryBudget::Used() == baseUsed);
+}
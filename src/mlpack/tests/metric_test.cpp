@@ -14,8 +14,12 @@
 #include <mlpack/core/metrics/iou_metric.hpp>
 #include <mlpack/core/metrics/non_maximal_supression.hpp>
 #include <mlpack/core/metrics/bleu.hpp>
+#include <mlpack/core/metrics/pairwise_distances.hpp>
+#include <mlpack/core/tree/cover_tree.hpp>
 #include "test_tools.hpp"
 
+#include <queue>
+
 using namespace std;
 using namespace mlpack::metric;
 
@@ -360,4 +364,267 @@ BOOST_AUTO_TEST_CASE(BLEUScoreTest)
   }
 }
 
+/**
+ * The batch pairwise distance kernel must agree with pair-at-a-time metric
+ * evaluation for all of its specializations and for the generic fallback.
+ */
+BOOST_AUTO_TEST_CASE(PairwiseDistancesTest)
+{
+  arma::mat a(10, 25, arma::fill::randu);
+  arma::mat b(10, 40, arma::fill::randu);
+
+  // Duplicate a column across the two sets, so that the L2 specialization's
+  // clamping of negative squared distances is exercised.
+  b.col(0) = a.col(0);
+
+  // L2 specialization (rooted and squared), L1, Chebyshev, and the generic
+  // fallback (an L3 metric has no specialization).
+  EuclideanDistance euclidean;
+  SquaredEuclideanDistance squaredEuclidean;
+  ManhattanDistance manhattan;
+  ChebyshevDistance chebyshev;
+  LMetric<3, true> l3;
+
+  arma::mat distances;
+
+  PairwiseDistances(a, b, distances, euclidean);
+  BOOST_REQUIRE_EQUAL(distances.n_rows, a.n_cols);
+  BOOST_REQUIRE_EQUAL(distances.n_cols, b.n_cols);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      BOOST_REQUIRE_SMALL(distances(i, j) -
+          euclidean.Evaluate(a.col(i), b.col(j)), 1e-10);
+
+  PairwiseDistances(a, b, distances, squaredEuclidean);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      BOOST_REQUIRE_SMALL(distances(i, j) -
+          squaredEuclidean.Evaluate(a.col(i), b.col(j)), 1e-10);
+
+  PairwiseDistances(a, b, distances, manhattan);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      BOOST_REQUIRE_SMALL(distances(i, j) -
+          manhattan.Evaluate(a.col(i), b.col(j)), 1e-10);
+
+  PairwiseDistances(a, b, distances, chebyshev);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      BOOST_REQUIRE_SMALL(distances(i, j) -
+          chebyshev.Evaluate(a.col(i), b.col(j)), 1e-10);
+
+  PairwiseDistances(a, b, distances, l3);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      BOOST_REQUIRE_SMALL(distances(i, j) -
+          l3.Evaluate(a.col(i), b.col(j)), 1e-10);
+}
+
+/**
+ * The cached-factor evaluation path of MahalanobisDistance must agree with
+ * the explicit quadratic form, the cache must be invalidated when the
+ * covariance is modified, and a non-positive-definite covariance must fall
+ * back to the quadratic form.
+ */
+BOOST_AUTO_TEST_CASE(MahalanobisFactorTest)
+{
+  // A random symmetric positive definite covariance.
+  arma::mat r(8, 8, arma::fill::randu);
+  arma::mat cov = r * r.t() + 8.0 * arma::eye<arma::mat>(8, 8);
+
+  MahalanobisDistance<false> md(cov);
+
+  // The factor must reproduce the covariance.
+  const arma::mat& factor = md.Factor();
+  BOOST_REQUIRE_EQUAL(factor.n_rows, 8);
+  BOOST_REQUIRE_EQUAL(factor.n_cols, 8);
+  arma::mat reconstructed = factor * factor.t();
+  for (size_t i = 0; i < cov.n_elem; ++i)
+    BOOST_REQUIRE_SMALL(reconstructed[i] - cov[i], 1e-10);
+
+  arma::vec a(8, arma::fill::randu);
+  arma::vec b(8, arma::fill::randu);
+  const arma::vec m = a - b;
+  BOOST_REQUIRE_CLOSE(md.Evaluate(a, b), arma::as_scalar(m.t() * cov * m),
+      1e-8);
+
+  // Modifying the covariance must invalidate the cached factor.
+  md.Covariance() = 4.0 * arma::eye<arma::mat>(8, 8);
+  BOOST_REQUIRE_CLOSE(md.Evaluate(a, b), 4.0 * arma::dot(m, m), 1e-8);
+
+  // An indefinite covariance has no Cholesky factor; Evaluate() must fall
+  // back to the quadratic form and Factor() must throw.
+  arma::mat indefinite = arma::eye<arma::mat>(8, 8);
+  indefinite(0, 0) = -1.0;
+  MahalanobisDistance<false> mdIndefinite(indefinite);
+  BOOST_REQUIRE_CLOSE(mdIndefinite.Evaluate(a, b),
+      arma::as_scalar(m.t() * indefinite * m), 1e-8);
+  BOOST_REQUIRE_THROW(mdIndefinite.Factor(), std::invalid_argument);
+}
+
+/**
+ * Batch-transformed points must reduce Mahalanobis distances to Euclidean
+ * ones, and the Mahalanobis specialization of PairwiseDistances() must agree
+ * with pair-at-a-time evaluation.
+ */
+BOOST_AUTO_TEST_CASE(MahalanobisTransformPairwiseTest)
+{
+  arma::mat r(6, 6, arma::fill::randu);
+  arma::mat cov = r * r.t() + 6.0 * arma::eye<arma::mat>(6, 6);
+
+  arma::mat a(6, 25, arma::fill::randu);
+  arma::mat b(6, 40, arma::fill::randu);
+
+  MahalanobisDistance<false> md(cov);
+  MahalanobisDistance<true> mdRoot(cov);
+
+  // Squared Euclidean distances between transformed columns must equal the
+  // Mahalanobis distances between the original columns.
+  arma::mat aTransformed;
+  md.Transform(a, aTransformed);
+  BOOST_REQUIRE_EQUAL(aTransformed.n_rows, a.n_rows);
+  BOOST_REQUIRE_EQUAL(aTransformed.n_cols, a.n_cols);
+  for (size_t i = 1; i < a.n_cols; ++i)
+  {
+    const arma::vec diff = aTransformed.col(i) - aTransformed.col(0);
+    BOOST_REQUIRE_CLOSE(arma::dot(diff, diff),
+        md.Evaluate(a.col(i), a.col(0)), 1e-8);
+  }
+
+  arma::mat distances;
+  PairwiseDistances(a, b, distances, md);
+  BOOST_REQUIRE_EQUAL(distances.n_rows, a.n_cols);
+  BOOST_REQUIRE_EQUAL(distances.n_cols, b.n_cols);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      BOOST_REQUIRE_SMALL(distances(i, j) -
+          md.Evaluate(a.col(i), b.col(j)), 1e-8);
+
+  PairwiseDistances(a, b, distances, mdRoot);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      BOOST_REQUIRE_SMALL(distances(i, j) -
+          mdRoot.Evaluate(a.col(i), b.col(j)), 1e-8);
+}
+
+/**
+ * The L2 specialization of the batch pairwise distance kernel must also work
+ * on sparse matrices.
+ */
+BOOST_AUTO_TEST_CASE(PairwiseDistancesSparseTest)
+{
+  arma::sp_mat a, b;
+  a.sprandu(50, 20, 0.2);
+  b.sprandu(50, 30, 0.2);
+
+  EuclideanDistance euclidean;
+
+  arma::mat distances;
+  PairwiseDistances(a, b, distances, euclidean);
+
+  BOOST_REQUIRE_EQUAL(distances.n_rows, a.n_cols);
+  BOOST_REQUIRE_EQUAL(distances.n_cols, b.n_cols);
+  for (size_t j = 0; j < b.n_cols; ++j)
+    for (size_t i = 0; i < a.n_cols; ++i)
+      BOOST_REQUIRE_SMALL(distances(i, j) -
+          euclidean.Evaluate(arma::vec(a.col(i)), arma::vec(b.col(j))),
+          1e-10);
+}
+
+/**
+ * When both arguments are sparse, LMetric merges the nonzero index lists
+ * instead of evaluating dense expressions; the result must match the dense
+ * computation for every specialization.
+ */
+BOOST_AUTO_TEST_CASE(SparseLMetricTest)
+{
+  arma::sp_mat data;
+  data.sprandu(500, 10, 0.05);
+  // Give two columns disjoint support, and leave one column empty, to hit the
+  // one-sided branches of the merge.
+  data.col(3).zeros();
+  for (size_t i = 0; i < 500; i += 2)
+    data(i, 4) = 0.0;
+  for (size_t i = 1; i < 500; i += 2)
+    data(i, 5) = 0.0;
+
+  const arma::mat denseData(data);
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    for (size_t j = 0; j < data.n_cols; ++j)
+    {
+      BOOST_REQUIRE_SMALL(
+          LMetric<1>::Evaluate(data.col(i), data.col(j)) -
+          LMetric<1>::Evaluate(denseData.col(i), denseData.col(j)), 1e-10);
+      BOOST_REQUIRE_SMALL(
+          (LMetric<2, true>::Evaluate(data.col(i), data.col(j))) -
+          (LMetric<2, true>::Evaluate(denseData.col(i), denseData.col(j))),
+          1e-10);
+      BOOST_REQUIRE_SMALL(
+          (LMetric<2, false>::Evaluate(data.col(i), data.col(j))) -
+          (LMetric<2, false>::Evaluate(denseData.col(i), denseData.col(j))),
+          1e-10);
+      BOOST_REQUIRE_SMALL(
+          (LMetric<3, false>::Evaluate(data.col(i), data.col(j))) -
+          (LMetric<3, false>::Evaluate(denseData.col(i), denseData.col(j))),
+          1e-10);
+      BOOST_REQUIRE_SMALL(
+          (LMetric<INT_MAX, false>::Evaluate(data.col(i), data.col(j))) -
+          (LMetric<INT_MAX, false>::Evaluate(denseData.col(i),
+                                             denseData.col(j))), 1e-10);
+    }
+  }
+}
+
+/**
+ * Cover tree construction on a sparse matrix goes through the sparse LMetric
+ * path; the resulting tree must be identical to the one built on the dense
+ * copy of the same data.
+ */
+BOOST_AUTO_TEST_CASE(SparseLMetricCoverTreeTest)
+{
+  arma::sp_mat data;
+  data.sprandu(1000, 100, 0.01);
+  const arma::mat denseData(data);
+
+  typedef mlpack::tree::StandardCoverTree<EuclideanDistance,
+      mlpack::tree::EmptyStatistic,
+      arma::sp_mat> SparseCoverTree;
+  typedef mlpack::tree::StandardCoverTree<EuclideanDistance,
+      mlpack::tree::EmptyStatistic,
+      arma::mat> DenseCoverTree;
+
+  SparseCoverTree sparseTree(data);
+  DenseCoverTree denseTree(denseData);
+
+  // Compare the trees level by level.
+  std::queue<const SparseCoverTree*> sparseQueue;
+  std::queue<const DenseCoverTree*> denseQueue;
+  sparseQueue.push(&sparseTree);
+  denseQueue.push(&denseTree);
+
+  while (!sparseQueue.empty())
+  {
+    BOOST_REQUIRE_EQUAL(denseQueue.empty(), false);
+
+    const SparseCoverTree* sparseNode = sparseQueue.front();
+    const DenseCoverTree* denseNode = denseQueue.front();
+    sparseQueue.pop();
+    denseQueue.pop();
+
+    BOOST_REQUIRE_EQUAL(sparseNode->Point(), denseNode->Point());
+    BOOST_REQUIRE_EQUAL(sparseNode->Scale(), denseNode->Scale());
+    BOOST_REQUIRE_EQUAL(sparseNode->NumChildren(), denseNode->NumChildren());
+
+    for (size_t i = 0; i < sparseNode->NumChildren(); ++i)
+    {
+      sparseQueue.push(&sparseNode->Child(i));
+      denseQueue.push(&denseNode->Child(i));
+    }
+  }
+
+  BOOST_REQUIRE_EQUAL(denseQueue.empty(), true);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
@@ -355,4 +355,45 @@ BOOST_AUTO_TEST_CASE(NaiveBayesClassifierHighDimensionsTest)
     BOOST_REQUIRE_EQUAL(calcVec(i), testLabels(i));
 }
 
+
+/**
+ * Make sure single-precision models can be trained with both the two-pass and
+ * the incremental algorithm, and that they agree with a double-precision
+ * model trained on the same data.
+ */
+BOOST_AUTO_TEST_CASE(NaiveBayesClassifierFMatTest)
+{
+  const char* trainFilename = "trainSet.csv";
+  size_t classes = 2;
+
+  arma::mat trainData;
+  data::Load(trainFilename, trainData, true);
+
+  // Get the labels out.
+  arma::Row<size_t> labels(trainData.n_cols);
+  for (size_t i = 0; i < trainData.n_cols; ++i)
+    labels[i] = trainData(trainData.n_rows - 1, i);
+  trainData.shed_row(trainData.n_rows - 1);
+
+  const arma::fmat floatTrainData = arma::conv_to<arma::fmat>::from(trainData);
+
+  NaiveBayesClassifier<> nbc(trainData, labels, classes);
+  NaiveBayesClassifier<arma::fmat> floatNbc(floatTrainData, labels, classes);
+  NaiveBayesClassifier<arma::fmat> floatNbcIncr(floatTrainData, labels,
+      classes, true);
+
+  // The predictions of the single-precision models should agree with the
+  // predictions of the double-precision model.
+  arma::Row<size_t> predictions, floatPredictions, floatIncrPredictions;
+  nbc.Classify(trainData, predictions);
+  floatNbc.Classify(floatTrainData, floatPredictions);
+  floatNbcIncr.Classify(floatTrainData, floatIncrPredictions);
+
+  for (size_t i = 0; i < predictions.n_elem; ++i)
+  {
+    BOOST_REQUIRE_EQUAL(floatPredictions(i), predictions(i));
+    BOOST_REQUIRE_EQUAL(floatIncrPredictions(i), predictions(i));
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END();
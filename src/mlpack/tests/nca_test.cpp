@@ -246,6 +246,58 @@ TEST_CASE("SoftmaxSeparableGradient", "[NCATesT]")
   REQUIRE(gradient(1, 1) == Approx(-2.0 * -0.1435886).epsilon(0.0001));
 }
 
+/**
+ * The approximate (sampled-neighborhood) separable objective and gradient
+ * should closely match the exact ones on clustered data, where the omitted
+ * far points contribute almost nothing to the softmax sums.
+ */
+TEST_CASE("SoftmaxApproximateSeparableObjective", "[NCATesT]")
+{
+  // Two well-separated clusters of 30 points each.
+  arma::mat data(2, 60);
+  arma::Row<size_t> labels(60);
+  for (size_t i = 0; i < 30; ++i)
+  {
+    data.col(i) = 0.1 * arma::randn<arma::vec>(2);
+    labels[i] = 0;
+    data.col(30 + i) = arma::vec("10.0; 10.0") +
+        0.1 * arma::randn<arma::vec>(2);
+    labels[30 + i] = 1;
+  }
+
+  SoftmaxErrorFunction<SquaredEuclideanDistance> exactSef(data, labels);
+  // 35 sampled neighbors cover each point's own cluster; the omitted points
+  // all lie in the other cluster and their softmax terms are negligible.
+  SoftmaxErrorFunction<SquaredEuclideanDistance> approxSef(data, labels,
+      SquaredEuclideanDistance(), 35);
+
+  arma::mat coordinates = arma::eye<arma::mat>(2, 2);
+
+  double exactObjective = 0.0;
+  double approxObjective = 0.0;
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    exactObjective += exactSef.Evaluate(coordinates, i, 1);
+    approxObjective += approxSef.Evaluate(coordinates, i, 1);
+  }
+
+  REQUIRE(approxObjective == Approx(exactObjective).epsilon(1e-5));
+
+  arma::mat exactGradient(2, 2, arma::fill::zeros);
+  arma::mat approxGradient(2, 2, arma::fill::zeros);
+  arma::mat gradient;
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    exactSef.Gradient(coordinates, i, gradient, 1);
+    exactGradient += gradient;
+    approxSef.Gradient(coordinates, i, gradient, 1);
+    approxGradient += gradient;
+  }
+
+  REQUIRE(arma::abs(approxGradient - exactGradient).max() ==
+      Approx(0.0).margin(1e-6));
+}
+
 //
 // Tests for the NCA algorithm.
 //
@@ -48,6 +48,32 @@ BOOST_AUTO_TEST_CASE(NMFDefaultTest)
       0.05);
 }
 
+/**
+ * Check that the multi-restart Apply() overload produces a good
+ * factorization, and that its returned residue matches the termination
+ * criterion of the policy.
+ */
+BOOST_AUTO_TEST_CASE(NMFMultipleRestartTest)
+{
+  mat w = randu<mat>(20, 12);
+  mat h = randu<mat>(12, 20);
+  mat v = w * h;
+  const size_t r = 12;
+
+  SimpleResidueTermination srt(1e-7, 10000);
+  AMF<> nmf(srt);
+  const double residue = nmf.Apply(v, r, w, h, 5);
+
+  // Every restart should converge, so the best residue must satisfy the
+  // termination criterion.
+  BOOST_REQUIRE_LT(residue, 1e-7);
+
+  mat wh = w * h;
+
+  BOOST_REQUIRE_SMALL(arma::norm(v - wh, "fro") / arma::norm(v, "fro"),
+      0.015);
+}
+
 /**
  * Check the if the product of the calculated factorization is close to the
  * input matrix. Random Acol initialization distance minimization update.
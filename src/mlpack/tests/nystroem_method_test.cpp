@@ -67,6 +67,39 @@ BOOST_AUTO_TEST_CASE(FullRankTest)
   }
 }
 
+/**
+ * The blocked Gaussian kernel evaluation assembles the kernel matrices from a
+ * matrix product; make sure it agrees with per-pair kernel evaluations, and
+ * that the diagonal of the mini-kernel is exactly 1.
+ */
+BOOST_AUTO_TEST_CASE(GaussianBlockEvaluationTest)
+{
+  arma::mat data;
+  data.randu(10, 150);
+
+  GaussianKernel gk(0.75);
+  const size_t rank = 30;
+  NystroemMethod<GaussianKernel, OrderedSelection> nm(data, gk, rank);
+
+  arma::Col<size_t> selectedPoints(rank);
+  for (size_t i = 0; i < rank; ++i)
+    selectedPoints(i) = i;
+
+  arma::mat miniKernel(rank, rank);
+  arma::mat semiKernel(data.n_cols, rank);
+  nm.GetKernelMatrix(selectedPoints, miniKernel, semiKernel);
+
+  for (size_t j = 0; j < rank; ++j)
+  {
+    BOOST_REQUIRE_EQUAL(miniKernel(j, j), 1.0);
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      BOOST_REQUIRE_CLOSE(semiKernel(i, j),
+          gk.Evaluate(data.col(i), data.col(j)), 1e-8);
+    }
+  }
+}
+
 /**
  * Can we accurately represent a rank-10 matrix?
  */
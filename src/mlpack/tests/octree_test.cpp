@@ -346,4 +346,92 @@ BOOST_AUTO_TEST_CASE(SerializationTest)
   delete textTree;
 }
 
+/**
+ * Make sure the children of every node partition its contiguous descendant
+ * range, so that each point belongs to exactly one leaf.
+ */
+template<typename TreeType>
+void CheckPartition(TreeType& node)
+{
+  if (node.NumChildren() == 0)
+    return;
+
+  size_t next = node.Descendant(0);
+  size_t total = 0;
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+  {
+    BOOST_REQUIRE_EQUAL(node.Child(i).Descendant(0), next);
+    next += node.Child(i).NumDescendants();
+    total += node.Child(i).NumDescendants();
+    CheckPartition(node.Child(i));
+  }
+
+  BOOST_REQUIRE_EQUAL(total, node.NumDescendants());
+}
+
+/**
+ * Make sure every leaf obeys the maximum leaf size.
+ */
+template<typename TreeType>
+void CheckLeafSizes(TreeType& node, const size_t maxLeafSize)
+{
+  if (node.NumChildren() == 0)
+    BOOST_REQUIRE_LE(node.NumPoints(), maxLeafSize);
+
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    CheckLeafSizes(node.Child(i), maxLeafSize);
+}
+
+/**
+ * A tree built from Morton-sorted points must satisfy the same invariants as
+ * a recursively built tree: non-overlapping siblings, correct furthest point
+ * and descendant distances, no more children than the dimensionality allows,
+ * a valid partition of the points, and leaves that obey the leaf size.
+ */
+BOOST_AUTO_TEST_CASE(MortonBuildTest)
+{
+  arma::mat dataset(3, 500, arma::fill::randu);
+
+  Octree<> t = Octree<>::BuildMorton(dataset, 10);
+
+  BOOST_REQUIRE_EQUAL(t.NumDescendants(), 500);
+  CheckOverlap(t);
+  CheckFurthestDistances(t);
+  CheckNumChildren(t);
+  CheckPartition(t);
+  CheckLeafSizes(t, 10);
+}
+
+/**
+ * Check that the mappings given by the Morton build are correct.
+ */
+BOOST_AUTO_TEST_CASE(MortonBuildMappingsTest)
+{
+  arma::mat dataset(3, 300, arma::fill::randu);
+  arma::mat datacopy(dataset);
+  std::vector<size_t> oldFromNew;
+
+  Octree<> t = Octree<>::BuildMorton(dataset, oldFromNew, 1);
+
+  BOOST_REQUIRE_EQUAL(oldFromNew.size(), 300);
+  for (size_t i = 0; i < oldFromNew.size(); ++i)
+  {
+    BOOST_REQUIRE_SMALL(arma::norm(datacopy.col(oldFromNew[i]) -
+        t.Dataset().col(i)), 1e-3);
+  }
+}
+
+/**
+ * Ensure that the Morton build handles an empty dataset.
+ */
+BOOST_AUTO_TEST_CASE(MortonBuildEmptyTest)
+{
+  arma::mat dataset;
+  Octree<> t = Octree<>::BuildMorton(dataset);
+
+  BOOST_REQUIRE_EQUAL(t.NumChildren(), 0);
+  BOOST_REQUIRE_EQUAL(t.NumDescendants(), 0);
+  BOOST_REQUIRE_EQUAL(t.NumPoints(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
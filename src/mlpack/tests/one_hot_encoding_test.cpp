@@ -229,3 +229,88 @@ TEST_CASE("OneHotEncodingDatasetinfoTest", "[OneHotEncodingTest]")
 
   remove("test.csv");
 }
+
+/**
+ * Test that the sparse output overload agrees with the dense overload.
+ */
+TEST_CASE("OneHotEncodingSparseOutputTest", "[OneHotEncodingTest]")
+{
+  arma::Mat<int> input;
+  input = "1 1 -1 -1 -1 -1 1 1;"
+          "-1 1 -1 -1 -1 -1 1 -1;"
+          "1 1 -1 -1 -1 -1 1 1;"
+          "-1 1 -1 -1 -1 -1 1 -1;"
+          "0 1 -1 0 -1 -1 1 1;";
+
+  arma::Mat<int> dense;
+  arma::SpMat<int> sparse;
+  arma::Col<size_t> indices("1 3");
+  data::OneHotEncoding(input, indices, dense);
+  data::OneHotEncoding(input, indices, sparse);
+
+  REQUIRE(sparse.n_rows == dense.n_rows);
+  REQUIRE(sparse.n_cols == dense.n_cols);
+  for (size_t i = 0; i < dense.n_elem; i++)
+    REQUIRE(sparse.at(i) == dense.at(i));
+
+  // Each encoded dimension holds one nonzero per point; the remaining three
+  // dimensions contribute their nonzero values.
+  REQUIRE(sparse.n_nonzero == 2 * input.n_cols + 8 + 8 + 6);
+}
+
+/**
+ * The sparse output of a high-cardinality dimension must stay proportional
+ * to the number of points, not to the number of categories.
+ */
+TEST_CASE("OneHotEncodingSparseHighCardinalityTest", "[OneHotEncodingTest]")
+{
+  // One dimension where every point has its own category.
+  arma::mat input = arma::conv_to<arma::mat>::from(
+      arma::regspace<arma::rowvec>(0, 499));
+
+  arma::sp_mat output;
+  arma::Col<size_t> indices("0");
+  data::OneHotEncoding(input, indices, output);
+
+  REQUIRE(output.n_rows == 500);
+  REQUIRE(output.n_cols == 500);
+  REQUIRE(output.n_nonzero == 500);
+
+  // Every column holds a single one, and equal inputs share a row.
+  for (size_t col = 0; col < output.n_cols; ++col)
+    REQUIRE(arma::accu(output.col(col)) == Approx(1.0).epsilon(1e-7));
+}
+
+/**
+ * Test the sparse output overload with a DatasetInfo object.
+ */
+TEST_CASE("OneHotEncodingSparseDatasetinfoTest", "[OneHotEncodingTest]")
+{
+  fstream f;
+  f.open("test.csv", fstream::out);
+  f << "1, 2, hello" << endl;
+  f << "3, 4, goodbye" << endl;
+  f << "5, 6, coffee" << endl;
+  f << "7, 8, confusion" << endl;
+  f << "9, 10, hello" << endl;
+  f << "11, 12, confusion" << endl;
+  f << "13, 14, confusion" << endl;
+  f.close();
+
+  // Load the test CSV.
+  arma::umat matrix;
+  DatasetInfo info;
+  data::Load("test.csv", matrix, info);
+
+  arma::umat dense;
+  arma::SpMat<arma::uword> sparse;
+  data::OneHotEncoding(matrix, dense, info);
+  data::OneHotEncoding(matrix, sparse, info);
+
+  REQUIRE(sparse.n_rows == dense.n_rows);
+  REQUIRE(sparse.n_cols == dense.n_cols);
+  for (size_t i = 0; i < dense.n_elem; i++)
+    REQUIRE(sparse.at(i) == dense.at(i));
+
+  remove("test.csv");
+}
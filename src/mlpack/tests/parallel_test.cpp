@@ -0,0 +1,255 @@
+/**
+ * @file tests/parallel_test.cpp
+ * @author Ryan Curtin
+ *
+ * Tests for the Parallel utility class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/util/parallel.hpp>
+#include <mlpack/core/util/numa.hpp>
+
+#include <boost/test/unit_test.hpp>
+#include "test_tools.hpp"
+
+using namespace mlpack;
+
+BOOST_AUTO_TEST_SUITE(ParallelTest);
+
+/**
+ * The thread budget must always be at least one, and setting it must be
+ * reflected by the getter.
+ */
+BOOST_AUTO_TEST_CASE(ParallelNumThreadsTest)
+{
+  const size_t oldNumThreads = Parallel::NumThreads();
+  BOOST_REQUIRE_GE(oldNumThreads, 1);
+
+  Parallel::NumThreads(1);
+  BOOST_REQUIRE_EQUAL(Parallel::NumThreads(), 1);
+
+  // A budget of 0 is treated as 1.
+  Parallel::NumThreads(0);
+  BOOST_REQUIRE_EQUAL(Parallel::NumThreads(), 1);
+
+  // Restore the original budget for any later tests.
+  Parallel::NumThreads(oldNumThreads);
+  BOOST_REQUIRE_EQUAL(Parallel::NumThreads(), oldNumThreads);
+}
+
+/**
+ * Parallel::For() must visit every index in the range exactly once.
+ */
+BOOST_AUTO_TEST_CASE(ParallelForTest)
+{
+  arma::Col<size_t> counts(1000, arma::fill::zeros);
+
+  Parallel::For(10, 990, [&](const size_t i)
+  {
+    #pragma omp atomic
+    counts[i]++;
+  });
+
+  for (size_t i = 0; i < counts.n_elem; ++i)
+  {
+    if (i >= 10 && i < 990)
+      BOOST_REQUIRE_EQUAL(counts[i], 1);
+    else
+      BOOST_REQUIRE_EQUAL(counts[i], 0);
+  }
+
+  // An empty range must call the function zero times.
+  Parallel::For(5, 5, [&](const size_t i) { counts[i] += 10; });
+  BOOST_REQUIRE_EQUAL(counts[5], 0);
+}
+
+/**
+ * The blocked Parallel::For() overload must cover the range with
+ * non-overlapping blocks of at most the given size.
+ */
+BOOST_AUTO_TEST_CASE(ParallelBlockedForTest)
+{
+  arma::Col<size_t> counts(1003, arma::fill::zeros);
+
+  Parallel::For(0, 1003, 64, [&](const size_t begin, const size_t end)
+  {
+    BOOST_REQUIRE_LT(begin, end);
+    BOOST_REQUIRE_LE(end - begin, 64);
+    for (size_t i = begin; i < end; ++i)
+    {
+      #pragma omp atomic
+      counts[i]++;
+    }
+  });
+
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(counts[i], 1);
+}
+
+/**
+ * A Parallel::For() nested inside another one must still visit every index
+ * exactly once (running serially instead of oversubscribing).
+ */
+BOOST_AUTO_TEST_CASE(ParallelNestedForTest)
+{
+  arma::Mat<size_t> counts(50, 50, arma::fill::zeros);
+
+  Parallel::For(0, 50, [&](const size_t i)
+  {
+    Parallel::For(0, 50, [&](const size_t j)
+    {
+      counts(j, i)++;
+    });
+  });
+
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(counts[i], 1);
+}
+
+/**
+ * Parallel::ReduceFor() must visit every block exactly once and combine all
+ * of the partial results.
+ */
+BOOST_AUTO_TEST_CASE(ParallelReduceForTest)
+{
+  // The blocks sum disjoint ranges of integers, so the combined result must
+  // be the sum of the full range regardless of scheduling.
+  const size_t numBlocks = 137;
+  const size_t blockSize = 10;
+
+  const size_t sum = Parallel::ReduceFor(numBlocks, (size_t) 0,
+      [&](size_t& partial, const size_t block)
+      {
+        for (size_t i = 0; i < blockSize; ++i)
+          partial += block * blockSize + i;
+      },
+      [](size_t& to, size_t& from) { to += from; });
+
+  const size_t n = numBlocks * blockSize;
+  BOOST_REQUIRE_EQUAL(sum, (n * (n - 1)) / 2);
+
+  // Zero blocks must return the identity.
+  const size_t empty = Parallel::ReduceFor(0, (size_t) 42,
+      [](size_t& partial, const size_t) { partial = 0; },
+      [](size_t& to, size_t& from) { to += from; });
+  BOOST_REQUIRE_EQUAL(empty, 42);
+}
+
+/**
+ * With deterministic reductions enabled, repeated runs of the same
+ * floating-point reduction must agree bitwise.
+ */
+BOOST_AUTO_TEST_CASE(ParallelDeterministicReduceForTest)
+{
+  // Use summands of wildly different magnitudes so that any change in the
+  // summation order shows up in the low bits of the result.
+  arma::vec values(12800);
+  for (size_t i = 0; i < values.n_elem; ++i)
+    values[i] = std::pow(10.0, (double) (i % 17) - 8) * (1.0 + 1e-13 * i);
+
+  const bool oldDeterministic = Parallel::Deterministic();
+  Parallel::Deterministic() = true;
+
+  const size_t numBlocks = 128;
+  auto run = [&]()
+  {
+    return Parallel::ReduceFor(numBlocks, 0.0,
+        [&](double& partial, const size_t block)
+        {
+          for (size_t i = 0; i < 100; ++i)
+            partial += values[block * 100 + i];
+        },
+        [](double& to, double& from) { to += from; });
+  };
+
+  const double first = run();
+  for (size_t trial = 0; trial < 5; ++trial)
+    BOOST_REQUIRE_EQUAL(run(), first);
+
+  Parallel::Deterministic() = oldDeterministic;
+}
+
+/**
+ * The deterministic flag must be off by default and settable through the
+ * accessor.
+ */
+BOOST_AUTO_TEST_CASE(ParallelDeterministicFlagTest)
+{
+  BOOST_REQUIRE_EQUAL(Parallel::Deterministic(), false);
+
+  Parallel::Deterministic() = true;
+  BOOST_REQUIRE_EQUAL(Parallel::Deterministic(), true);
+
+  Parallel::Deterministic() = false;
+  BOOST_REQUIRE_EQUAL(Parallel::Deterministic(), false);
+}
+
+/**
+ * Parallel::Invoke() must run all of the given tasks before returning.
+ */
+BOOST_AUTO_TEST_CASE(ParallelInvokeTest)
+{
+  size_t a = 0, b = 0, c = 0;
+
+  Parallel::Invoke(
+      [&]() { a = 1; },
+      [&]() { b = 2; },
+      [&]() { c = 3; });
+
+  BOOST_REQUIRE_EQUAL(a, 1);
+  BOOST_REQUIRE_EQUAL(b, 2);
+  BOOST_REQUIRE_EQUAL(c, 3);
+}
+
+/**
+ * The machine must report at least one NUMA node, and the per-node column
+ * ranges must partition the columns in order, balanced to within one column.
+ */
+BOOST_AUTO_TEST_CASE(NumaPartitionColumnsTest)
+{
+  BOOST_REQUIRE_GE(Numa::NumNodes(), 1);
+
+  const size_t cols = 10;
+  const size_t numNodes = 3;
+  size_t covered = 0;
+  for (size_t node = 0; node < numNodes; ++node)
+  {
+    size_t begin, end;
+    Numa::PartitionColumns(cols, node, numNodes, begin, end);
+
+    BOOST_REQUIRE_EQUAL(begin, covered);
+    BOOST_REQUIRE_GE(end, begin);
+    BOOST_REQUIRE_GE(end - begin, cols / numNodes);
+    BOOST_REQUIRE_LE(end - begin, cols / numNodes + 1);
+    covered = end;
+  }
+  BOOST_REQUIRE_EQUAL(covered, cols);
+}
+
+/**
+ * FirstTouch() must zero the matrix, and StaticFor() must visit every index
+ * exactly once.
+ */
+BOOST_AUTO_TEST_CASE(NumaFirstTouchAndStaticForTest)
+{
+  arma::mat matrix = arma::randu<arma::mat>(20, 500);
+  Numa::FirstTouch(matrix);
+  for (size_t i = 0; i < matrix.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(matrix[i], 0.0);
+
+  arma::Col<size_t> counts(500, arma::fill::zeros);
+  Numa::StaticFor(0, 500, [&](const size_t i)
+  {
+    #pragma omp atomic
+    counts[i]++;
+  });
+
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    BOOST_REQUIRE_EQUAL(counts[i], 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END();
@@ -12,6 +12,7 @@
  */
 #include <mlpack/core.hpp>
 #include <mlpack/methods/pca/pca.hpp>
+#include <mlpack/methods/pca/decomposition_policies/blocked_randomized_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/exact_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/quic_svd_method.hpp>
 #include <mlpack/methods/pca/decomposition_policies/randomized_svd_method.hpp>
@@ -204,6 +205,17 @@ TEST_CASE("ArmaComparisonRandomizedPCATest", "[PCATest]")
   ArmaComparisonPCA<RandomizedSVDPolicy>();
 }
 
+/**
+ * Compare the output of our blocked randomized-SVD PCA implementation with
+ * Armadillo's.  A small block size forces many sequential passes over the
+ * column blocks.
+ */
+TEST_CASE("ArmaComparisonBlockedRandomizedPCATest", "[PCATest]")
+{
+  BlockedRandomizedSVDPolicy decomposition(2, 5, 64);
+  ArmaComparisonPCA<BlockedRandomizedSVDPolicy>(false, decomposition);
+}
+
 /**
  * Test that dimensionality reduction with exact-svd PCA works the same way
  * MATLAB does (which should be correct!).
@@ -233,6 +245,17 @@ TEST_CASE("RandomizedPCADimensionalityReductionTest", "[PCATest]")
   PCADimensionalityReduction<RandomizedSVDPolicy>();
 }
 
+/**
+ * Test that dimensionality reduction with blocked randomized-svd PCA works
+ * the same way MATLAB does (which should be correct!).  A block size of two
+ * columns exercises the blocking, including a partial final block.
+ */
+TEST_CASE("BlockedRandomizedPCADimensionalityReductionTest", "[PCATest]")
+{
+  BlockedRandomizedSVDPolicy decomposition(2, 5, 2);
+  PCADimensionalityReduction<BlockedRandomizedSVDPolicy>(false, decomposition);
+}
+
 /**
  * Test that dimensionality reduction with QUIC-SVD PCA works the same way
  * as the Exact-SVD PCA method.
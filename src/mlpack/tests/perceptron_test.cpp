@@ -255,4 +255,28 @@ BOOST_AUTO_TEST_CASE(SecondaryConstructor)
   Perceptron<> p2(p1);
 }
 
+/**
+ * This tests that the mini-batch training mode learns a linearly separable
+ * dataset just like the classical online mode does.
+ */
+BOOST_AUTO_TEST_CASE(MiniBatchTraining)
+{
+  mat trainData;
+  trainData << 0 << 1 << 1 << 4 << 5 << 4 << 1 << 2 << 5 << endr
+            << 1 << 0 << 1 << 1 << 1 << 2 << 4 << 5 << 4 << endr
+            << 1 << 1 << 1 << 1 << 1 << 1 << 1 << 1 << 1 << endr;
+
+  Mat<size_t> labels;
+  labels << 0 << 0 << 0 << 1 << 1 << 1 << 2 << 2 << 2;
+
+  Perceptron<> p(trainData, labels.row(0), 3, 1000, 4 /* batch size */);
+  BOOST_CHECK_EQUAL(p.BatchSize(), 4);
+
+  Row<size_t> predictedLabels(trainData.n_cols);
+  p.Classify(trainData, predictedLabels);
+
+  for (size_t i = 0; i < trainData.n_cols; ++i)
+    BOOST_CHECK_EQUAL(predictedLabels(0, i), labels(0, i));
+}
+
 BOOST_AUTO_TEST_SUITE_END();
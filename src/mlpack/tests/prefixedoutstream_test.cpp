@@ -13,6 +13,8 @@
 #include <sstream>
 
 #include <mlpack/core.hpp>
+#include <mlpack/core/util/async_log_sink.hpp>
+#include <mlpack/core/util/parallel.hpp>
 
 #include <boost/test/unit_test.hpp>
 #include "test_tools.hpp"
@@ -239,4 +241,104 @@ BOOST_AUTO_TEST_CASE(TestArmaCustomPrecision)
       BASH_GREEN "[INFO ] " BASH_CLEAR "   4.0000   4.5000   5.0000\n");
 }
 
+/**
+ * Everything written through an AsyncLogSink must arrive downstream, in
+ * order, once Flush() returns.
+ */
+BOOST_AUTO_TEST_CASE(AsyncLogSinkBasicTest)
+{
+  std::ostringstream downstream;
+  AsyncLogSink sink(downstream.rdbuf(), 16);
+  std::ostream async(sink.Buffer());
+
+  PrefixedOutStream prefixed(async, "[TEST] ");
+  prefixed << "hello " << 42 << std::endl;
+  prefixed << "world" << std::endl;
+  sink.Flush();
+
+  BOOST_REQUIRE_EQUAL(downstream.str(), "[TEST] hello 42\n[TEST] world\n");
+  BOOST_REQUIRE_EQUAL(sink.DroppedMessages(), 0);
+}
+
+/**
+ * A large number of messages must all be delivered when the ring buffer is
+ * big enough to hold them.
+ */
+BOOST_AUTO_TEST_CASE(AsyncLogSinkManyMessagesTest)
+{
+  std::ostringstream downstream;
+  AsyncLogSink sink(downstream.rdbuf(), 1024);
+  std::ostream async(sink.Buffer());
+
+  for (size_t i = 0; i < 500; ++i)
+    async << "message " << i << "\n";
+  sink.Flush();
+
+  std::istringstream lines(downstream.str());
+  std::string line;
+  size_t count = 0;
+  while (std::getline(lines, line))
+  {
+    BOOST_REQUIRE_EQUAL(line, "message " + std::to_string(count));
+    ++count;
+  }
+  BOOST_REQUIRE_EQUAL(count, 500);
+  BOOST_REQUIRE_EQUAL(sink.DroppedMessages(), 0);
+}
+
+/**
+ * Messages written concurrently by several threads must never interleave
+ * mid-line, and every message must either arrive intact or be counted as
+ * dropped.
+ */
+BOOST_AUTO_TEST_CASE(AsyncLogSinkConcurrentTest)
+{
+  std::ostringstream downstream;
+  AsyncLogSink sink(downstream.rdbuf(), 4096);
+
+  const size_t writers = 4;
+  const size_t messages = 100;
+  Parallel::For(0, writers, [&](const size_t i)
+  {
+    // Each thread gets its own ostream object over the shared sink, since
+    // ostream objects themselves are not thread-safe.
+    std::ostream async(sink.Buffer());
+    const std::string line(20, (char) ('a' + i));
+    for (size_t j = 0; j < messages; ++j)
+      async << line << "\n";
+  });
+  sink.Flush();
+
+  std::istringstream lines(downstream.str());
+  std::string line;
+  size_t count = 0;
+  while (std::getline(lines, line))
+  {
+    // Each line must consist of 20 copies of a single writer's character.
+    BOOST_REQUIRE_EQUAL(line.size(), 20);
+    for (size_t i = 1; i < line.size(); ++i)
+      BOOST_REQUIRE_EQUAL(line[i], line[0]);
+    ++count;
+  }
+  BOOST_REQUIRE_EQUAL(count + sink.DroppedMessages(), writers * messages);
+}
+
+/**
+ * Log::EnableAsync() and Log::DisableAsync() must be safe to toggle, and
+ * must report no drops for light logging.
+ */
+BOOST_AUTO_TEST_CASE(LogEnableAsyncTest)
+{
+  BOOST_REQUIRE_EQUAL(Log::AsyncDroppedMessages(), 0);
+
+  Log::EnableAsync();
+  Log::Info << "an asynchronous message" << std::endl;
+  BOOST_REQUIRE_EQUAL(Log::AsyncDroppedMessages(), 0);
+  Log::DisableAsync();
+
+  // Disabling twice (or with nothing enabled) must be harmless.
+  Log::DisableAsync();
+  BOOST_REQUIRE_EQUAL(Log::AsyncDroppedMessages(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
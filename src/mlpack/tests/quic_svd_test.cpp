@@ -12,6 +12,7 @@
 
 #include <mlpack/core.hpp>
 #include <mlpack/methods/quic_svd/quic_svd.hpp>
+#include <mlpack/methods/quic_svd/incremental_quic_svd.hpp>
 
 #include "catch.hpp"
 
@@ -88,3 +89,43 @@ TEST_CASE("QUICSVDSameDimensionTest", "[QUICSVDTest]")
   arma::mat u, v, sigma;
   svd::QUIC_SVD quicsvd(dataset, u, v, sigma);
 }
+
+/**
+ * Feeding a matrix to the incremental variant in column blocks should produce
+ * a sketch whose reconstruction of the whole matrix has small relative error.
+ */
+TEST_CASE("IncrementalQUICSVDReconstructionError", "[QUICSVDTest]")
+{
+  // Load the dataset.
+  arma::mat dataset;
+  data::Load("test_data_3_1000.csv", dataset);
+
+  // The Monte Carlo error calculation is random, so require at least one
+  // success over several trials.
+  size_t successes = 0;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    svd::IncrementalQUICSVD quicsvd(0.01, 0.1);
+
+    // Ingest the dataset in four column blocks.
+    const size_t blockSize = (dataset.n_cols + 3) / 4;
+    for (size_t begin = 0; begin < dataset.n_cols; begin += blockSize)
+    {
+      const size_t end = std::min(begin + blockSize, (size_t) dataset.n_cols);
+      quicsvd.Update(dataset.cols(begin, end - 1));
+    }
+
+    arma::mat u, v, sigma;
+    quicsvd.ExtractSVD(u, v, sigma);
+
+    // Reconstruct the matrix using the SVD of the sketch.
+    arma::mat reconstruct = u * sigma * v.t();
+
+    double relativeError = arma::norm(dataset - reconstruct, "frob") /
+                           arma::norm(dataset, "frob");
+    if (relativeError < 1e-2)
+      ++successes;
+  }
+
+  REQUIRE(successes > 0);
+}
@@ -484,3 +484,56 @@ TEST_CASE("DifferentTreesTest", "[RandomForestTest]")
 
   REQUIRE(success == true);
 }
+
+/**
+ * Test that a compiled FlatForest gives exactly the same predictions and
+ * probabilities as the forest it was compiled from.
+ */
+TEST_CASE("FlatForestPredictionTest", "[RandomForestTest]")
+{
+  // Load the vc2 dataset.
+  arma::mat dataset;
+  data::Load("vc2.csv", dataset);
+  arma::Row<size_t> labels;
+  data::Load("vc2_labels.txt", labels);
+
+  RandomForest<> rf(dataset, labels, 3, 10 /* 10 trees */, 1, 1e-7);
+  FlatForest<RandomForest<>> ff(rf);
+
+  arma::mat testDataset;
+  data::Load("vc2_test.csv", testDataset);
+
+  arma::Row<size_t> rfPredictions, ffPredictions;
+  arma::mat rfProbabilities, ffProbabilities;
+  rf.Classify(testDataset, rfPredictions, rfProbabilities);
+  ff.Classify(testDataset, ffPredictions, ffProbabilities);
+
+  REQUIRE(ffPredictions.n_elem == rfPredictions.n_elem);
+  REQUIRE(arma::accu(ffPredictions == rfPredictions) == rfPredictions.n_elem);
+  CheckMatrices(ffProbabilities, rfProbabilities, 1e-10);
+
+  // The predictions-only overload must agree too.
+  arma::Row<size_t> ffPredictionsOnly;
+  ff.Classify(testDataset, ffPredictionsOnly);
+  REQUIRE(arma::accu(ffPredictionsOnly == ffPredictions) ==
+      ffPredictions.n_elem);
+}
+
+/**
+ * Make sure an empty FlatForest cannot predict and an untrained forest cannot
+ * be compiled.
+ */
+TEST_CASE("FlatForestEmptyTest", "[RandomForestTest]")
+{
+  FlatForest<RandomForest<>> ff; // Nothing compiled.
+
+  arma::mat points(10, 100, arma::fill::randu);
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  REQUIRE_THROWS_AS(ff.Classify(points, predictions), std::invalid_argument);
+  REQUIRE_THROWS_AS(ff.Classify(points, predictions, probabilities),
+      std::invalid_argument);
+
+  RandomForest<> rf; // No training.
+  REQUIRE_THROWS_AS(ff.Compile(rf), std::invalid_argument);
+}
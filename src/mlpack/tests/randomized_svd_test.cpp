@@ -60,3 +60,39 @@ TEST_CASE("RandomizedSVDReconstructionError", "[RandomizedSVDTest]")
       arma::norm(centeredData, "frob");
   REQUIRE(error == Approx(0.0).margin(1e-5));
 }
+
+/**
+ * The blocked, pass-efficient mode sweeps the matrix in column blocks; its
+ * factorization must reconstruct the matrix about as well as a full SVD.
+ */
+TEST_CASE("RandomizedSVDBlockedReconstructionError", "[RandomizedSVDTest]")
+{
+  arma::mat U = arma::randn<arma::mat>(100, 3);
+  arma::mat V = arma::randn<arma::mat>(500, 3);
+
+  arma::mat R;
+  arma::qr_econ(U, R, U);
+  arma::qr_econ(V, R, V);
+
+  arma::vec s("1 0.1 0.01");
+
+  // A rank-3 matrix with 500 columns, swept in blocks of 64 columns (the last
+  // block is partial).
+  arma::mat data = U * arma::diagmat(s) * V.t();
+
+  arma::mat U2, V2;
+  arma::vec s2;
+
+  svd::RandomizedSVD rSVD(0, 10);
+  rSVD.ApplyBlocked(data, U2, s2, V2, 3, 64);
+
+  // The singular value error should be small.
+  double error = arma::norm(s2.head(3) - s, "frob") / arma::norm(s, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-5));
+
+  arma::mat reconstruct = U2 * arma::diagmat(s2) * V2.t();
+
+  // The relative reconstruction error should be small.
+  error = arma::norm(data - reconstruct, "frob") / arma::norm(data, "frob");
+  REQUIRE(error == Approx(0.0).margin(1e-5));
+}
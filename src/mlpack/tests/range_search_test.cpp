@@ -596,6 +596,65 @@ BOOST_AUTO_TEST_CASE(SingleTreeVsNaive)
   }
 }
 
+/**
+ * The CSR-style overloads of Search() must return exactly the same results as
+ * the vector-of-vectors overloads, in every search mode.
+ */
+BOOST_AUTO_TEST_CASE(CSRResultsTest)
+{
+  arma::mat data(3, 300, arma::fill::randu);
+  arma::mat queries(3, 120, arma::fill::randu);
+  const Range range(0.1, 0.6);
+
+  for (size_t mode = 0; mode < 3; ++mode)
+  {
+    const bool naive = (mode == 0);
+    const bool single = (mode == 1);
+    RangeSearch<> rs(data, naive, single);
+
+    // First check the separate-query-set overload.
+    vector<vector<size_t>> neighbors;
+    vector<vector<double>> distances;
+    rs.Search(queries, range, neighbors, distances);
+
+    arma::uvec offsets, flatNeighbors;
+    arma::vec flatDistances;
+    rs.Search(queries, range, offsets, flatNeighbors, flatDistances);
+
+    BOOST_REQUIRE_EQUAL(offsets.n_elem, queries.n_cols + 1);
+    BOOST_REQUIRE_EQUAL(offsets[0], 0);
+    BOOST_REQUIRE_EQUAL(flatNeighbors.n_elem, offsets[queries.n_cols]);
+    BOOST_REQUIRE_EQUAL(flatDistances.n_elem, offsets[queries.n_cols]);
+
+    for (size_t i = 0; i < queries.n_cols; ++i)
+    {
+      BOOST_REQUIRE_EQUAL(offsets[i + 1] - offsets[i], neighbors[i].size());
+      for (size_t j = 0; j < neighbors[i].size(); ++j)
+      {
+        BOOST_REQUIRE_EQUAL(flatNeighbors[offsets[i] + j], neighbors[i][j]);
+        BOOST_REQUIRE_CLOSE(flatDistances[offsets[i] + j], distances[i][j],
+            1e-10);
+      }
+    }
+
+    // Now check the monochromatic overload.
+    rs.Search(range, neighbors, distances);
+    rs.Search(range, offsets, flatNeighbors, flatDistances);
+
+    BOOST_REQUIRE_EQUAL(offsets.n_elem, data.n_cols + 1);
+    for (size_t i = 0; i < data.n_cols; ++i)
+    {
+      BOOST_REQUIRE_EQUAL(offsets[i + 1] - offsets[i], neighbors[i].size());
+      for (size_t j = 0; j < neighbors[i].size(); ++j)
+      {
+        BOOST_REQUIRE_EQUAL(flatNeighbors[offsets[i] + j], neighbors[i][j]);
+        BOOST_REQUIRE_CLOSE(flatDistances[offsets[i] + j], distances[i][j],
+            1e-10);
+      }
+    }
+  }
+}
+
 /**
  * Ensure that dual tree range search with cover trees works by comparing
  * with the kd-tree implementation.
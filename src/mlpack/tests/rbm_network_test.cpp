@@ -120,6 +120,51 @@ TEST_CASE("BinaryRBMClassificationTest", "[RBMNetworkTest]")
 /*
  * Tests the SpikeSlabRBM implementation on the Digits dataset.
  */
+/*
+ * Tests that the positive phase of the BinaryRBM handles a whole mini-batch
+ * at once: the weight gradient must be the sum of the per-sample outer
+ * products and the hidden bias gradient the sum of the per-sample hidden
+ * means.
+ */
+TEST_CASE("BinaryRBMBatchedPhaseTest", "[RBMNetworkTest]")
+{
+  const size_t visibleSize = 5;
+  const size_t hiddenSize = 4;
+  const size_t batchSize = 6;
+
+  arma::mat data = arma::randu<arma::mat>(visibleSize, 2 * batchSize);
+  data = (data > 0.5) % arma::ones<arma::mat>(arma::size(data));
+
+  GaussianInitialization gaussian(0, 0.1);
+  RBM<GaussianInitialization, arma::mat, BinaryRBM> model(data, gaussian,
+      visibleSize, hiddenSize, batchSize);
+  model.Reset();
+
+  const arma::mat batch = data.cols(0, batchSize - 1);
+  arma::mat gradient(model.Parameters().n_rows, 1, arma::fill::zeros);
+  model.Phase(batch, gradient);
+
+  // Reference gradient accumulated one sample at a time.
+  arma::mat refWeightGrad(hiddenSize, visibleSize, arma::fill::zeros);
+  arma::mat refHiddenBiasGrad(hiddenSize, 1, arma::fill::zeros);
+  for (size_t i = 0; i < batchSize; ++i)
+  {
+    arma::mat hiddenMean;
+    model.HiddenMean(arma::mat(batch.col(i)), hiddenMean);
+    refWeightGrad += hiddenMean * batch.col(i).t();
+    refHiddenBiasGrad += hiddenMean;
+  }
+
+  const arma::mat weightGrad(gradient.memptr(), hiddenSize, visibleSize);
+  const arma::mat hiddenBiasGrad(gradient.memptr() + weightGrad.n_elem,
+      hiddenSize, 1);
+
+  REQUIRE(arma::abs(weightGrad - refWeightGrad).max() ==
+      Approx(0.0).margin(1e-10));
+  REQUIRE(arma::abs(hiddenBiasGrad - refHiddenBiasGrad).max() ==
+      Approx(0.0).margin(1e-10));
+}
+
 TEST_CASE("ssRBMClassificationTest", "[RBMNetworkTest]")
 {
   size_t batchSize = 10;
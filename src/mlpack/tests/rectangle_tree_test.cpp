@@ -277,6 +277,44 @@ BOOST_AUTO_TEST_CASE(CheckMinAndMaxFills)
   CheckFills(tree);
 }
 
+/**
+ * A function to count the number of leaves under (and including) this node.
+ *
+ * @param tree The tree whose leaves we want to count.
+ * @return The number of leaves.
+ */
+template<typename TreeType>
+size_t NumLeaves(const TreeType& tree)
+{
+  if (tree.IsLeaf())
+    return 1;
+
+  size_t numLeaves = 0;
+  for (size_t i = 0; i < tree.NumChildren(); ++i)
+    numLeaves += NumLeaves(tree.Child(i));
+  return numLeaves;
+}
+
+// Test that the bulk-loaded R-tree is valid and packs its leaves close to
+// full fanout.
+BOOST_AUTO_TEST_CASE(RectangleTreeBulkLoadPackingTest)
+{
+  arma::mat dataset;
+  dataset.randu(8, 1037); // 1037 points in 8 dimensions.
+
+  typedef RTree<EuclideanDistance, NeighborSearchStat<NearestNeighborSort>,
+      arma::mat> TreeType;
+
+  TreeType tree(dataset, 20, 6, 5, 2, 0);
+
+  BOOST_REQUIRE_EQUAL(tree.NumDescendants(), 1037);
+  CheckFills(tree);
+
+  // A packed tree should use close to the minimum possible number of leaves;
+  // iterated insertion typically needs far more.
+  BOOST_REQUIRE_LE(NumLeaves(tree), 2 * ((1037 + 19) / 20));
+}
+
 /**
  * A function to get the height of this tree.  Though it should equal
  * tree.TreeDepth(), we ensure that every leaf node is on the same level by
@@ -525,6 +563,39 @@ BOOST_AUTO_TEST_CASE(PointDynamicAdd)
   }
 }
 
+// A test to check that the batched insertion API gives a valid tree, using
+// the R* tree so that the shared reinsertion tracking is exercised.
+BOOST_AUTO_TEST_CASE(PointBatchAdd)
+{
+  const size_t numAdded = 300;
+  arma::mat dataset;
+  dataset.randu(8, 1000); // 1000 points in 8 dimensions.
+
+  typedef RStarTree<EuclideanDistance,
+      NeighborSearchStat<NearestNeighborSort>, arma::mat> TreeType;
+  TreeType tree(dataset, 20, 6, 5, 2, 0);
+
+  // Add numAdded new points to the dataset; the batch is clustered in a small
+  // region to provoke repeated splits in the same subtree.
+  tree.Dataset().reshape(8, 1000 + numAdded);
+  arma::mat tmpData;
+  tmpData.randu(8, numAdded);
+  tmpData *= 0.05;
+  std::vector<size_t> pointIndices(numAdded);
+  for (size_t i = 0; i < numAdded; ++i)
+  {
+    tree.Dataset().col(1000 + i) = tmpData.col(i);
+    pointIndices[i] = 1000 + i;
+  }
+
+  tree.InsertPoints(pointIndices);
+
+  BOOST_REQUIRE_EQUAL(tree.NumDescendants(), 1000 + numAdded);
+  CheckContainment(tree);
+  CheckExactContainment(tree);
+  CheckNumDescendants(tree);
+}
+
 // A test to ensure that the SingleTreeTraverser is working correctly by
 // comparing its results to the results of a naive search.
 BOOST_AUTO_TEST_CASE(SingleTreeTraverserTest)
@@ -231,6 +231,67 @@ TEST_CASE("SequenceClassificationTest", "[RecurrentNetworkTest]")
   REQUIRE(successes >= 1);
 }
 
+/**
+ * Train a vanilla network on variable-length sequences with the
+ * length-bucketed Train() overload: the short sequences must be grouped into
+ * their own bucket and unrolled only to their own length, and the original
+ * rho must be restored afterwards.
+ */
+TEST_CASE("BucketedSequenceClassificationTest", "[RecurrentNetworkTest]")
+{
+  const size_t rho = 10;
+
+  // Generate 12 (2 * 6) noisy sines of rho points, then truncate half of
+  // them to 4 valid steps (the tail is zero padding).
+  arma::cube input;
+  arma::mat labelsTemp;
+  GenerateNoisySines(input, labelsTemp, rho, 6);
+
+  arma::cube labels = arma::zeros<arma::cube>(1, labelsTemp.n_cols, rho);
+  for (size_t i = 0; i < labelsTemp.n_cols; ++i)
+  {
+    const int value = arma::as_scalar(arma::find(
+        arma::max(labelsTemp.col(i)) == labelsTemp.col(i), 1)) + 1;
+    labels.tube(0, i).fill(value);
+  }
+
+  arma::urowvec sequenceLengths(input.n_cols);
+  for (size_t i = 0; i < input.n_cols; ++i)
+  {
+    sequenceLengths[i] = (i % 2 == 0) ? rho : 4;
+    if (i % 2 != 0)
+    {
+      for (size_t s = 4; s < rho; ++s)
+        input(0, i, s) = 0;
+    }
+  }
+
+  Add<> add(4);
+  Linear<> lookup(1, 4);
+  SigmoidLayer<> sigmoidLayer;
+  Linear<> linear(4, 4);
+  Recurrent<>* recurrent = new Recurrent<>(
+      add, lookup, linear, sigmoidLayer, rho);
+
+  RNN<> model(rho);
+  model.Add<IdentityLayer<> >();
+  model.Add(recurrent);
+  model.Add<Linear<> >(4, 10);
+  model.Add<LogSoftMax<> >();
+
+  StandardSGD opt(0.1, 1, 50 * input.n_cols, -100);
+  const double objective = model.Train(input, labels, sequenceLengths, opt);
+
+  REQUIRE(std::isfinite(objective));
+  REQUIRE(model.Rho() == rho);
+
+  // The trained model must still predict over the full unrolling depth.
+  arma::cube prediction;
+  model.Predict(input, prediction);
+  REQUIRE(prediction.n_cols == input.n_cols);
+  REQUIRE(prediction.n_slices == rho);
+}
+
 /**
  * Generate a random Reber grammar.
  *
@@ -1472,3 +1533,51 @@ TEST_CASE("LargeRhoValueRnnTest", "[RecurrentNetworkTest]")
   model.Train(inputs[0], targets[0], opt);
   INFO("Training over");
 }
+
+/**
+ * Test that an online prediction session (StartPrediction() followed by one
+ * PredictStep() per time step) produces exactly the same outputs as the batch
+ * Predict() over the whole sequence, and that a new session restarts the
+ * recurrent state.
+ */
+TEST_CASE("RNNPredictStepTest", "[RecurrentNetworkTest]")
+{
+  const size_t rho = 5;
+
+  RNN<MeanSquaredError<> > model(rho);
+  model.Add<IdentityLayer<> >();
+  model.Add<Linear<> >(2, 4);
+  model.Add<LSTM<> >(4, 4, rho);
+  model.Add<Linear<> >(4, 3);
+
+  // Three parallel streams of two-dimensional observations.
+  arma::cube input(2, 3, rho, arma::fill::randu);
+  arma::cube batchOutput;
+  model.Predict(input, batchOutput);
+
+  REQUIRE(batchOutput.n_rows == 3);
+  REQUIRE(batchOutput.n_cols == 3);
+  REQUIRE(batchOutput.n_slices == rho);
+
+  // Step through the same sequence one tick at a time.
+  model.StartPrediction();
+  arma::mat stepOutput;
+  for (size_t t = 0; t < rho; ++t)
+  {
+    model.PredictStep(input.slice(t), stepOutput);
+
+    REQUIRE(stepOutput.n_rows == batchOutput.n_rows);
+    REQUIRE(stepOutput.n_cols == batchOutput.n_cols);
+    for (size_t i = 0; i < stepOutput.n_elem; ++i)
+      REQUIRE(stepOutput[i] == Approx(batchOutput.slice(t)[i]).epsilon(1e-7));
+  }
+
+  // A new session must reset the hidden state: the first step of the new
+  // session has to reproduce the first slice of the batch prediction, not
+  // continue from the previous session.
+  model.StartPrediction();
+  model.PredictStep(input.slice(0), stepOutput);
+  for (size_t i = 0; i < stepOutput.n_elem; ++i)
+    REQUIRE(stepOutput[i] == Approx(batchOutput.slice(0)[i]).epsilon(1e-7));
+}
+
@@ -20,7 +20,9 @@
 #include <mlpack/methods/reinforcement_learning/environment/continuous_double_pole_cart.hpp>
 #include <mlpack/methods/reinforcement_learning/environment/acrobot.hpp>
 #include <mlpack/methods/reinforcement_learning/environment/pendulum.hpp>
+#include <mlpack/methods/reinforcement_learning/environment/vectorized_environment.hpp>
 #include <mlpack/methods/reinforcement_learning/replay/random_replay.hpp>
+#include <mlpack/methods/reinforcement_learning/replay/async_prioritized_replay.hpp>
 #include <mlpack/methods/reinforcement_learning/policy/greedy_policy.hpp>
 
 #include <boost/test/unit_test.hpp>
@@ -273,6 +275,111 @@ BOOST_AUTO_TEST_CASE(RandomReplayTest)
   }
 }
 
+/**
+ * Construct an asynchronous prioritized replay instance and check that
+ * batches prepared by the background thread are consistent with the stored
+ * transitions.
+ */
+BOOST_AUTO_TEST_CASE(AsyncPrioritizedReplayTest)
+{
+  AsyncPrioritizedReplay<MountainCar> replay(2, 8, 0.6);
+  MountainCar env;
+  MountainCar::State state = env.InitialSample();
+  MountainCar::Action action;
+  action.action = MountainCar::Action::actions::forward;
+  MountainCar::State nextState;
+  double reward = env.Sample(state, action, nextState);
+  for (size_t i = 0; i < 5; ++i)
+    replay.Store(state, action, reward, nextState, env.IsTerminal(nextState),
+        0.9);
+
+  BOOST_REQUIRE_EQUAL(5, replay.Size());
+
+  // Sample several batches; every transition in the buffer is identical, so
+  // each batch must reproduce it exactly regardless of which indices the
+  // background thread drew.
+  for (size_t i = 0; i < 10; ++i)
+  {
+    arma::mat sampledStates;
+    std::vector<MountainCar::Action> sampledActions;
+    arma::rowvec sampledRewards;
+    arma::mat sampledNextStates;
+    arma::irowvec sampledTerminal;
+
+    replay.Sample(sampledStates, sampledActions, sampledRewards,
+        sampledNextStates, sampledTerminal);
+
+    BOOST_REQUIRE_EQUAL(sampledActions.size(), 2);
+    for (size_t t = 0; t < sampledActions.size(); ++t)
+    {
+      CheckMatrices(state.Encode(),
+          arma::vec(sampledStates.col(t)));
+      CheckMatrices(nextState.Encode(),
+          arma::vec(sampledNextStates.col(t)));
+      BOOST_REQUIRE_EQUAL(action.action, sampledActions[t].action);
+      BOOST_REQUIRE_CLOSE(reward, sampledRewards(t), 1e-5);
+      BOOST_REQUIRE_EQUAL(false, sampledTerminal(t));
+    }
+
+    // Feed back priorities and check the importance weight scaling; the
+    // weights are normalized by their maximum, so the scaling factor cannot
+    // exceed one.
+    arma::mat target = arma::randu<arma::mat>(MountainCar::Action::size, 2);
+    arma::mat nextActionValues =
+        arma::randu<arma::mat>(MountainCar::Action::size, 2);
+    arma::mat gradients = arma::ones<arma::mat>(4, 4);
+    replay.Update(target, sampledActions, nextActionValues, gradients);
+    BOOST_REQUIRE_LE(gradients.max(), 1.0 + 1e-8);
+    BOOST_REQUIRE_GT(gradients.max(), 0.0);
+  }
+}
+
+/**
+ * Construct a vectorized environment instance and check that stepping all
+ * copies at once keeps the batched state matrix consistent and resets
+ * finished episodes.
+ */
+BOOST_AUTO_TEST_CASE(VectorizedEnvironmentTest)
+{
+  // Use a small step limit so every copy terminates after three steps.
+  VectorizedEnvironment<CartPole> envs(4, CartPole(3));
+
+  BOOST_REQUIRE_EQUAL(envs.NumEnvs(), 4);
+  BOOST_REQUIRE_EQUAL(envs.States().n_rows, CartPole::State::dimension);
+  BOOST_REQUIRE_EQUAL(envs.States().n_cols, 4);
+
+  std::vector<CartPole::Action> actions(envs.NumEnvs());
+  for (size_t i = 0; i < actions.size(); ++i)
+    actions[i].action = CartPole::Action::actions::forward;
+
+  arma::rowvec rewards;
+  arma::irowvec isTerminal;
+  for (size_t step = 1; step <= 3; ++step)
+  {
+    envs.Step(actions, rewards, isTerminal);
+
+    for (size_t i = 0; i < envs.NumEnvs(); ++i)
+    {
+      // The batched state matrix must always mirror the per-copy states.
+      CheckMatrices(envs.State(i).Encode(),
+          arma::vec(envs.States().col(i)));
+      BOOST_REQUIRE_CLOSE(rewards(i), 1.0, 1e-5);
+
+      if (step < 3)
+      {
+        BOOST_REQUIRE_EQUAL(isTerminal(i), 0);
+        BOOST_REQUIRE_EQUAL(envs.Environment(i).StepsPerformed(), step);
+      }
+      else
+      {
+        // The step limit is hit; the copy must be terminal and already reset.
+        BOOST_REQUIRE_EQUAL(isTerminal(i), 1);
+        BOOST_REQUIRE_EQUAL(envs.Environment(i).StepsPerformed(), 0);
+      }
+    }
+  }
+}
+
 /**
  * Construct a greedy policy instance and check if it works as
  * it should be.
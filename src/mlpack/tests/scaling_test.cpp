@@ -73,6 +73,53 @@ TEST_CASE("StandardScalerTest", "[ScalingTest]")
   CheckMatrices(dataset, temp);
 }
 
+/**
+ * Fitting the StandardScaler in chunks with PartialFit(), or merging
+ * partially-fit scalers, should give the same statistics as one Fit() on the
+ * whole dataset.
+ */
+TEST_CASE("StandardScalerPartialFitTest", "[ScalingTest]")
+{
+  arma::mat input = arma::randu<arma::mat>(5, 100);
+
+  data::StandardScaler batch;
+  batch.Fit(input);
+
+  data::StandardScaler streaming;
+  streaming.PartialFit(input.cols(0, 39));
+  streaming.PartialFit(input.cols(40, 74));
+  streaming.PartialFit(input.cols(75, 99));
+
+  REQUIRE(streaming.Count() == 100);
+  for (size_t i = 0; i < input.n_rows; ++i)
+  {
+    REQUIRE(streaming.ItemMean()[i] ==
+        Approx(batch.ItemMean()[i]).epsilon(1e-10));
+    REQUIRE(streaming.ItemStdDev()[i] ==
+        Approx(batch.ItemStdDev()[i]).epsilon(1e-10));
+  }
+
+  // Now fit the two halves separately and merge.
+  data::StandardScaler left, right;
+  left.PartialFit(input.cols(0, 49));
+  right.PartialFit(input.cols(50, 99));
+  left.Merge(right);
+
+  REQUIRE(left.Count() == 100);
+  for (size_t i = 0; i < input.n_rows; ++i)
+  {
+    REQUIRE(left.ItemMean()[i] == Approx(batch.ItemMean()[i]).epsilon(1e-10));
+    REQUIRE(left.ItemStdDev()[i] ==
+        Approx(batch.ItemStdDev()[i]).epsilon(1e-10));
+  }
+
+  // The streamed scaler must transform identically to the batch scaler.
+  arma::mat batchOutput, streamingOutput;
+  batch.Transform(input, batchOutput);
+  streaming.Transform(input, streamingOutput);
+  CheckMatrices(batchOutput, streamingOutput);
+}
+
 /**
  * Test For MeanNormalization Scaler Class.
  */
@@ -184,12 +184,12 @@ BOOST_AUTO_TEST_CASE(BallBoundTest)
 
 BOOST_AUTO_TEST_CASE(MahalanobisBallBoundTest)
 {
-  BallBound<MahalanobisDistance<>, arma::vec> b(100);
+  BallBound<MahalanobisDistance<>, double, arma::vec> b(100);
   b.Center().randu();
   b.Radius() = 14.0;
   b.Metric().Covariance().randu(100, 100);
 
-  BallBound<MahalanobisDistance<>, arma::vec> xmlB, textB, binaryB;
+  BallBound<MahalanobisDistance<>, double, arma::vec> xmlB, textB, binaryB;
 
   SerializeObjectAll(b, xmlB, textB, binaryB);
 
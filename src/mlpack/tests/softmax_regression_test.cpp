@@ -171,6 +171,92 @@ TEST_CASE("SoftmaxRegressionFunctionGradient",
   }
 }
 
+TEST_CASE("SoftmaxRegressionFunctionBlockedEvaluate",
+          "[SoftmaxRegressionTest]")
+{
+  const size_t points = 1000;
+  const size_t inputSize = 10;
+  const size_t numClasses = 5;
+
+  // Initialize a random dataset.
+  arma::mat data;
+  data.randu(inputSize, points);
+
+  // Create random class labels.
+  arma::Row<size_t> labels(points);
+  for (size_t i = 0; i < points; ++i)
+    labels(i) = math::RandInt(0, numClasses);
+
+  // The blocked mode streams over blocks of points; the objective and the
+  // gradient must match the single-pass computation, with and without an
+  // intercept.  A block size that does not divide the number of points
+  // exercises the partial last block.
+  for (size_t intercept = 0; intercept < 2; ++intercept)
+  {
+    SoftmaxRegressionFunction srf(data, labels, numClasses, 0.01,
+        (intercept == 1));
+
+    arma::mat parameters;
+    parameters.randu(numClasses, (intercept == 1) ? inputSize + 1 : inputSize);
+
+    const double cost = srf.Evaluate(parameters);
+    arma::mat gradient;
+    srf.Gradient(parameters, gradient);
+
+    srf.BlockSize() = 128;
+    const double blockedCost = srf.Evaluate(parameters);
+    arma::mat blockedGradient;
+    srf.Gradient(parameters, blockedGradient);
+
+    REQUIRE(blockedCost == Approx(cost).epsilon(1e-10));
+    REQUIRE(arma::abs(blockedGradient - gradient).max() ==
+        Approx(0.0).margin(1e-12));
+  }
+}
+
+TEST_CASE("SoftmaxRegressionClassifyTopKTest", "[SoftmaxRegressionTest]")
+{
+  const size_t points = 100;
+  const size_t inputSize = 8;
+  const size_t numClasses = 25;
+  const size_t k = 5;
+
+  arma::mat data;
+  data.randn(inputSize, points);
+
+  // The pruned top-k search must agree with a full scoring pass, with and
+  // without an intercept term.
+  for (size_t intercept = 0; intercept < 2; ++intercept)
+  {
+    SoftmaxRegression sr(inputSize, numClasses, (intercept == 1));
+    sr.Parameters().randn();
+
+    arma::mat probabilities;
+    sr.Classify(data, probabilities);
+
+    arma::Mat<size_t> labels;
+    arma::mat scores;
+    sr.ClassifyTopK(data, k, labels, scores);
+
+    REQUIRE(labels.n_rows == k);
+    REQUIRE(labels.n_cols == points);
+
+    for (size_t i = 0; i < points; ++i)
+    {
+      // The softmax normalization does not change the class ordering, so the
+      // returned labels must match the k most probable classes.
+      const arma::uvec sorted = arma::sort_index(probabilities.col(i),
+          "descend");
+      for (size_t r = 0; r < k; ++r)
+      {
+        REQUIRE(labels(r, i) == sorted(r));
+        if (r > 0)
+          REQUIRE(scores(r, i) <= scores(r - 1, i));
+      }
+    }
+  }
+}
+
 TEST_CASE("SoftmaxRegressionTwoClasses", "[SoftmaxRegressionTest]")
 {
   const size_t points = 1000;
@@ -214,3 +214,39 @@ TEST_CASE("SparseCodingTrainReturnObjective", "[SparseCodingTest]")
 
   REQUIRE(std::isfinite(objVal) == true);
 }
+
+/**
+ * Test that mini-batch training returns a finite full-dataset objective and a
+ * usable dictionary.
+ */
+TEST_CASE("SparseCodingMiniBatchTrainTest", "[SparseCodingTest]")
+{
+  const double tol = 1e-6;
+
+  double lambda1 = 0.1;
+  uword nAtoms = 25;
+
+  mat X;
+  X.load("mnist_first250_training_4s_and_9s.arm");
+  uword nPoints = X.n_cols;
+
+  // Normalize each point since these are images.
+  for (uword i = 0; i < nPoints; ++i)
+    X.col(i) /= norm(X.col(i), 2);
+
+  SparseCoding sc(nAtoms, lambda1, 0.0, 20, 0.01, tol);
+  sc.BatchSize() = 50;
+  double objVal = sc.Train(X);
+
+  REQUIRE(std::isfinite(objVal) == true);
+  REQUIRE(sc.Dictionary().n_rows == X.n_rows);
+  REQUIRE(sc.Dictionary().n_cols == nAtoms);
+  REQUIRE(sc.Dictionary().is_finite() == true);
+
+  // The learned dictionary must still encode the full dataset.
+  mat codes;
+  sc.Encode(X, codes);
+  REQUIRE(codes.n_rows == nAtoms);
+  REQUIRE(codes.n_cols == nPoints);
+  REQUIRE(codes.is_finite() == true);
+}
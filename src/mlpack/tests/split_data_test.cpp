@@ -192,6 +192,79 @@ TEST_CASE("SplitDataLargerTest", "[SplitDataTest]")
   CheckMatEqual(input, concat);
 }
 
+/**
+ * Check that SplitIndices() returns a permutation of the column indices with
+ * the right part sizes, so it can be used to form views of the data.
+ */
+TEST_CASE("SplitIndicesTest", "[SplitDataTest]")
+{
+  arma::uvec trainIndices, testIndices;
+  SplitIndices(10, trainIndices, testIndices, 0.2);
+
+  REQUIRE(trainIndices.n_elem == 8);
+  REQUIRE(testIndices.n_elem == 2);
+
+  // Together the two parts must be a permutation of 0, ..., 9.
+  arma::uvec counts = arma::zeros<arma::uvec>(10);
+  for (size_t i = 0; i < trainIndices.n_elem; ++i)
+    counts[trainIndices[i]]++;
+  for (size_t i = 0; i < testIndices.n_elem; ++i)
+    counts[testIndices[i]]++;
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    REQUIRE(counts[i] == 1);
+
+  // Without shuffling, the points must be visited in linear order.
+  SplitIndices(10, trainIndices, testIndices, 0.2, false);
+  for (size_t i = 0; i < trainIndices.n_elem; ++i)
+    REQUIRE(trainIndices[i] == i);
+  for (size_t i = 0; i < testIndices.n_elem; ++i)
+    REQUIRE(testIndices[i] == trainIndices.n_elem + i);
+}
+
+/**
+ * Check that StratifiedSplitIndices() preserves the class proportions and
+ * returns a permutation of the column indices.
+ */
+TEST_CASE("StratifiedSplitIndicesTest", "[SplitDataTest]")
+{
+  // 10 points of class 0, 20 points of class 1, and 5 points of class 2.
+  Row<size_t> labels = arma::join_rows(
+      arma::join_rows(arma::Row<size_t>(10, arma::fill::zeros),
+                      arma::Row<size_t>(20, arma::fill::ones)),
+      arma::Row<size_t>(5, arma::fill::ones) * 2);
+
+  arma::uvec trainIndices, testIndices;
+  StratifiedSplitIndices(labels, trainIndices, testIndices, 0.2);
+
+  // Each class contributes 20% of its points (rounded down) to the test set.
+  REQUIRE(testIndices.n_elem == 2 + 4 + 1);
+  REQUIRE(trainIndices.n_elem == 8 + 16 + 4);
+
+  // Together the two parts must be a permutation of the point indices.
+  arma::uvec counts = arma::zeros<arma::uvec>(labels.n_elem);
+  for (size_t i = 0; i < trainIndices.n_elem; ++i)
+    counts[trainIndices[i]]++;
+  for (size_t i = 0; i < testIndices.n_elem; ++i)
+    counts[testIndices[i]]++;
+  for (size_t i = 0; i < counts.n_elem; ++i)
+    REQUIRE(counts[i] == 1);
+
+  // Check the per-class counts of each part.
+  arma::uvec testClassCounts = arma::zeros<arma::uvec>(3);
+  for (size_t i = 0; i < testIndices.n_elem; ++i)
+    testClassCounts[labels[testIndices[i]]]++;
+  REQUIRE(testClassCounts[0] == 2);
+  REQUIRE(testClassCounts[1] == 4);
+  REQUIRE(testClassCounts[2] == 1);
+
+  arma::uvec trainClassCounts = arma::zeros<arma::uvec>(3);
+  for (size_t i = 0; i < trainIndices.n_elem; ++i)
+    trainClassCounts[labels[trainIndices[i]]]++;
+  REQUIRE(trainClassCounts[0] == 8);
+  REQUIRE(trainClassCounts[1] == 16);
+  REQUIRE(trainClassCounts[2] == 4);
+}
+
 TEST_CASE("SplitLabeledDataLargerTest", "[SplitDataTest]")
 {
   mat input(10, 497);
@@ -13,11 +13,13 @@
 #include <mlpack/core.hpp>
 #include <mlpack/core/boost_backport/boost_backport_string_view.hpp>
 #include <mlpack/core/data/tokenizers/split_by_any_of.hpp>
+#include <mlpack/core/data/tokenizers/block_split_by_any_of.hpp>
 #include <mlpack/core/data/tokenizers/char_extract.hpp>
 #include <mlpack/core/data/string_encoding.hpp>
 #include <mlpack/core/data/string_encoding_policies/dictionary_encoding_policy.hpp>
 #include <mlpack/core/data/string_encoding_policies/bag_of_words_encoding_policy.hpp>
 #include <mlpack/core/data/string_encoding_policies/tf_idf_encoding_policy.hpp>
+#include <mlpack/core/data/string_encoding_policies/hashing_encoding_policy.hpp>
 #include <boost/test/unit_test.hpp>
 #include <memory>
 #include "test_tools.hpp"
@@ -242,6 +244,86 @@ BOOST_AUTO_TEST_CASE(SplitByAnyOfTokenizerUnicodeTest)
     BOOST_REQUIRE_EQUAL(tokens[i], expectedUtf8Tokens[i]);
 }
 
+/**
+ * Test the BlockSplitByAnyOf tokenizer.
+ */
+BOOST_AUTO_TEST_CASE(BlockSplitByAnyOfTokenizerTest)
+{
+  std::vector<boost::string_view> tokens;
+  boost::string_view line(stringEncodingInput[0]);
+  BlockSplitByAnyOf tokenizer(" ,.");
+  boost::string_view token = tokenizer(line);
+
+  while (!token.empty())
+  {
+    tokens.push_back(token);
+    token = tokenizer(line);
+  }
+
+  vector<string> expected = { "mlpack", "is", "an", "intuitive", "fast",
+    "and", "flexible", "C++", "machine", "learning", "library", "with",
+    "bindings", "to", "other", "languages"
+  };
+
+  BOOST_REQUIRE_EQUAL(tokens.size(), expected.size());
+
+  for (size_t i = 0; i < tokens.size(); ++i)
+    BOOST_REQUIRE_EQUAL(tokens[i], expected[i]);
+}
+
+/**
+ * The BlockSplitByAnyOf tokenizer has to agree with SplitByAnyOf on any
+ * input, in particular when delimiters cross the eight-byte block
+ * boundaries or when the delimiter set exceeds the blocked-scan limit.
+ */
+BOOST_AUTO_TEST_CASE(BlockSplitByAnyOfConsistencyTest)
+{
+  // The input places delimiters at every possible offset modulo eight.
+  string input;
+  for (size_t i = 0; i < 64; ++i)
+  {
+    input += string(i, 'a' + (char) (i % 26));
+    input += (i % 3 == 0) ? ' ' : ((i % 3 == 1) ? ',' : '.');
+  }
+
+  for (const string& delimiters : { string(" ,."), string(" ,.\";:!?-()") })
+  {
+    SplitByAnyOf tokenizer(delimiters);
+    BlockSplitByAnyOf blockTokenizer(delimiters);
+
+    for (const string& text : { input, stringEncodingInput[1],
+        stringEncodingUtf8Input[2] })
+    {
+      boost::string_view line(text), blockLine(text);
+      boost::string_view token = tokenizer(line);
+      boost::string_view blockToken = blockTokenizer(blockLine);
+
+      while (!token.empty() || !blockToken.empty())
+      {
+        BOOST_REQUIRE_EQUAL(token, blockToken);
+        token = tokenizer(line);
+        blockToken = blockTokenizer(blockLine);
+      }
+    }
+  }
+}
+
+/**
+ * Test the dictionary encoding algorithm with the BlockSplitByAnyOf
+ * tokenizer.
+ */
+BOOST_AUTO_TEST_CASE(BlockSplitByAnyOfDictionaryEncodingTest)
+{
+  arma::mat output, blockOutput;
+  DictionaryEncoding<SplitByAnyOf::TokenType> encoder, blockEncoder;
+
+  encoder.Encode(stringEncodingInput, output, SplitByAnyOf(" .,\""));
+  blockEncoder.Encode(stringEncodingInput, blockOutput,
+      BlockSplitByAnyOf(" .,\""));
+
+  CheckMatrices(output, blockOutput);
+}
+
 /**
  * Test the CharExtract tokenizer.
  */
@@ -1425,5 +1507,126 @@ BOOST_AUTO_TEST_CASE(SplitByAnyOfTfIdfEncodingSerialization)
   CheckMatrices(output, xmlOutput, textOutput, binaryOutput);
 }
 
+/**
+ * Test the hashing encoding algorithm.
+ */
+BOOST_AUTO_TEST_CASE(HashingEncodingTest)
+{
+  arma::mat output;
+  HashingEncoding<SplitByAnyOf::TokenType> encoder;
+  SplitByAnyOf tokenizer(" .,\"");
+
+  encoder.Encode(stringEncodingInput, output, tokenizer);
+
+  const size_t numBuckets = encoder.Dictionary().NumBuckets();
+
+  // The longest line of the input contains 33 tokens.
+  BOOST_REQUIRE_EQUAL(output.n_rows, 33);
+  BOOST_REQUIRE_EQUAL(output.n_cols, stringEncodingInput.size());
+
+  // Every id has to lie in [1, numBuckets]; zero is the padding value.
+  for (size_t i = 0; i < output.n_elem; ++i)
+  {
+    BOOST_REQUIRE_GE(output[i], 0);
+    BOOST_REQUIRE_LE(output[i], numBuckets);
+  }
+
+  // The tokens "machine" and "learning" are repeated across the lines, so
+  // their ids must coincide wherever they appear.  In the first line they
+  // are tokens 9 and 10; in the second line they reappear as tokens 7 and 8.
+  BOOST_REQUIRE_EQUAL(output(8, 0), output(6, 1));
+  BOOST_REQUIRE_EQUAL(output(9, 0), output(7, 1));
+
+  // Hashing is deterministic: a fresh encoder must produce the same output.
+  arma::mat secondOutput;
+  HashingEncoding<SplitByAnyOf::TokenType> secondEncoder;
+  secondEncoder.Encode(stringEncodingInput, secondOutput, tokenizer);
+
+  CheckMatrices(output, secondOutput);
+}
+
+/**
+ * Test the one pass modification of the hashing encoding algorithm and its
+ * consistency with the matrix overload.
+ */
+BOOST_AUTO_TEST_CASE(OnePassHashingEncodingTest)
+{
+  arma::mat matOutput;
+  vector<vector<size_t>> output;
+  HashingEncoding<SplitByAnyOf::TokenType> encoder;
+  SplitByAnyOf tokenizer(" .,\"");
+
+  encoder.Encode(stringEncodingInput, matOutput, tokenizer);
+  encoder.Encode(stringEncodingInput, output, tokenizer);
+
+  BOOST_REQUIRE_EQUAL(output.size(), stringEncodingInput.size());
+
+  // Apart from the padding, both overloads have to agree.
+  for (size_t i = 0; i < output.size(); ++i)
+  {
+    for (size_t j = 0; j < output[i].size(); ++j)
+      BOOST_REQUIRE_EQUAL((size_t) matOutput(j, i), output[i][j]);
+
+    for (size_t j = output[i].size(); j < matOutput.n_rows; ++j)
+      BOOST_REQUIRE_EQUAL(matOutput(j, i), 0);
+  }
+}
+
+/**
+ * Test the hashing encoding algorithm with a small bucket count.
+ */
+BOOST_AUTO_TEST_CASE(SmallBucketHashingEncodingTest)
+{
+  vector<vector<size_t>> output;
+  HashingEncoding<SplitByAnyOf::TokenType> encoder;
+  SplitByAnyOf tokenizer(" .,\"");
+
+  encoder.Dictionary().NumBuckets() = 16;
+
+  encoder.Encode(stringEncodingInput, output, tokenizer);
+
+  BOOST_REQUIRE_EQUAL(encoder.Dictionary().Size(), 16);
+
+  for (size_t i = 0; i < output.size(); ++i)
+  {
+    for (size_t j = 0; j < output[i].size(); ++j)
+    {
+      BOOST_REQUIRE_GE(output[i][j], 1);
+      BOOST_REQUIRE_LE(output[i][j], 16);
+    }
+  }
+}
+
+/**
+ * Serialization test for the hashing encoding algorithm with
+ * the SplitByAnyOf tokenizer.
+ */
+BOOST_AUTO_TEST_CASE(SplitByAnyOfHashingEncodingSerialization)
+{
+  using EncoderType = HashingEncoding<SplitByAnyOf::TokenType>;
+
+  EncoderType encoder;
+  SplitByAnyOf tokenizer(" ,.\"");
+  arma::mat output;
+
+  encoder.Dictionary().NumBuckets() = 4096;
+  encoder.Encode(stringEncodingInput, output, tokenizer);
+
+  EncoderType xmlEncoder, textEncoder, binaryEncoder;
+  arma::mat xmlOutput, textOutput, binaryOutput;
+
+  SerializeObjectAll(encoder, xmlEncoder, textEncoder, binaryEncoder);
+
+  BOOST_REQUIRE_EQUAL(xmlEncoder.Dictionary().NumBuckets(), 4096);
+  BOOST_REQUIRE_EQUAL(textEncoder.Dictionary().NumBuckets(), 4096);
+  BOOST_REQUIRE_EQUAL(binaryEncoder.Dictionary().NumBuckets(), 4096);
+
+  xmlEncoder.Encode(stringEncodingInput, xmlOutput, tokenizer);
+  textEncoder.Encode(stringEncodingInput, textOutput, tokenizer);
+  binaryEncoder.Encode(stringEncodingInput, binaryOutput, tokenizer);
+
+  CheckMatrices(output, xmlOutput, textOutput, binaryOutput);
+}
+
 BOOST_AUTO_TEST_SUITE_END();
 
@@ -547,4 +547,116 @@ TEST_CASE("SVDPlusPlusFunctionParallelOptimize", "[SVDPlusPlusTest]")
   REQUIRE(relativeError == Approx(0.0).margin(1e-2));
 }
 
+// Test SVDPlusPlus with the sharded parallel SGD specialization, where each
+// thread owns a disjoint set of users and the per-user implicit-feedback sum
+// is cached.
+TEST_CASE("SVDPlusPlusFunctionShardedParallelOptimize", "[SVDPlusPlusTest]")
+{
+  // Define useful constants.
+  const size_t numUsers = 100;
+  const size_t numItems = 100;
+  const size_t numRatings = 1000;
+  const size_t iterations = 30;
+  const size_t rank = 5;
+  const double alpha = 0.01;
+  const double lambda = 0;
+
+  // Initiate random parameters.
+  arma::mat parameters = arma::randu(rank + 1, numUsers + 2 * numItems);
+
+  // Make a random rating dataset.
+  arma::mat data = arma::randu(3, numRatings);
+  data.row(0) = floor(data.row(0) * numUsers);
+  data.row(1) = floor(data.row(1) * numItems);
+
+  // Manually set last row to maximum user and maximum item.
+  data(0, numRatings - 1) = numUsers - 1;
+  data(1, numRatings - 1) = numItems - 1;
+
+  // Make a random implicit dataset.
+  arma::sp_mat implicitData = arma::sprandu(numItems, numUsers, 0.05);
+
+  // Make rating entries based on the parameters.
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    const size_t user = data(0, i);
+    const size_t item = data(1, i) + numUsers;
+    const size_t implicitStart = numUsers + numItems;
+
+    const double userBias = parameters(rank, user);
+    const double itemBias = parameters(rank, item);
+
+    // Iterate through each item which the user interacted with to calculate
+    // user vector.
+    arma::vec userVec(rank, arma::fill::zeros);
+    arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+    arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+    size_t implicitCount = 0;
+    for (; it != it_end; ++it)
+    {
+      userVec += parameters.col(implicitStart + it.row()).subvec(0, rank - 1);
+      implicitCount += 1;
+    }
+    if (implicitCount != 0)
+      userVec /= std::sqrt(implicitCount);
+    userVec += parameters.col(user).subvec(0, rank - 1);
+
+    data(2, i) = userBias + itemBias +
+        arma::dot(userVec, parameters.col(item).subvec(0, rank - 1));
+  }
+
+  // Make the SVD++ function and the optimizer.
+  SVDPlusPlusFunction<arma::mat> svdPPFunc(data, implicitData, rank, lambda);
+
+  ens::ExponentialBackoff decayPolicy(50, alpha, 0.1);
+
+  // Iterate till convergence; the thread share size is unused by the sharded
+  // specialization, which partitions the ratings by user instead.
+  ens::ParallelSGD<ens::ExponentialBackoff> optimizer(iterations,
+      std::ceil((float) svdPPFunc.NumFunctions() / omp_get_max_threads()), 1e-5,
+      true, decayPolicy);
+
+  // Obtain optimized parameters after training.
+  arma::mat optParameters = arma::randu(rank + 1, numUsers + 2 * numItems);
+  optimizer.Optimize(svdPPFunc, optParameters);
+
+  // Get predicted ratings from optimized parameters.
+  arma::mat predictedData(1, numRatings);
+  for (size_t i = 0; i < numRatings; ++i)
+  {
+    const size_t user = data(0, i);
+    const size_t item = data(1, i) + numUsers;
+    const size_t implicitStart = numUsers + numItems;
+
+    const double userBias = optParameters(rank, user);
+    const double itemBias = optParameters(rank, item);
+
+    // Iterate through each item which the user interacted with to calculate
+    // user vector.
+    arma::vec userVec(rank, arma::fill::zeros);
+    arma::sp_mat::const_iterator it = implicitData.begin_col(user);
+    arma::sp_mat::const_iterator it_end = implicitData.end_col(user);
+    size_t implicitCount = 0;
+    for (; it != it_end; ++it)
+    {
+      userVec +=
+          optParameters.col(implicitStart + it.row()).subvec(0, rank - 1);
+      implicitCount += 1;
+    }
+    if (implicitCount != 0)
+      userVec /= std::sqrt(implicitCount);
+    userVec += optParameters.col(user).subvec(0, rank - 1);
+
+    predictedData(0, i) = userBias + itemBias +
+        arma::dot(userVec, optParameters.col(item).subvec(0, rank - 1));
+  }
+
+  // Calculate relative error.
+  const double relativeError = arma::norm(data.row(2) - predictedData, "frob") /
+                               arma::norm(data, "frob");
+
+  // Relative error should be small.
+  REQUIRE(relativeError == Approx(0.0).margin(1e-2));
+}
+
 #endif
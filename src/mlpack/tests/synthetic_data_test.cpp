@@ -0,0 +1,180 @@
+/**
+ * @file tests/synthetic_data_test.cpp
+ * @author Ryan Curtin
+ *
+ * Tests for the parametric synthetic dataset generators.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include <mlpack/core.hpp>
+#include <mlpack/core/data/synthetic_data.hpp>
+#include <mlpack/core/util/parallel.hpp>
+
+#include "test_catch_tools.hpp"
+#include "catch.hpp"
+
+using namespace mlpack;
+using namespace mlpack::data;
+
+/**
+ * Gaussian clusters should have the requested shape, valid labels, and points
+ * near the center of their cluster when the separation is large.
+ */
+TEST_CASE("GaussianClustersTest", "[SyntheticDataTest]")
+{
+  arma::mat data;
+  arma::Row<size_t> labels;
+  GaussianClusters(10, 2000, 5, 100.0, data, labels, 42);
+
+  REQUIRE(data.n_rows == 10);
+  REQUIRE(data.n_cols == 2000);
+  REQUIRE(labels.n_elem == 2000);
+  REQUIRE(labels.max() < 5);
+
+  // With a separation of 100 and unit-variance noise, two points with the
+  // same label must be far closer to each other than the expected distance
+  // between different centers; check that the within-cluster spread is
+  // bounded.
+  arma::mat centroids(10, 5, arma::fill::zeros);
+  arma::vec counts(5, arma::fill::zeros);
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    centroids.col(labels[i]) += data.col(i);
+    ++counts[labels[i]];
+  }
+  for (size_t c = 0; c < 5; ++c)
+  {
+    REQUIRE(counts[c] > 0);
+    centroids.col(c) /= counts[c];
+  }
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+    REQUIRE(arma::norm(data.col(i) - centroids.col(labels[i])) < 15.0);
+}
+
+/**
+ * The generators must be deterministic in the seed, and different seeds must
+ * give different data.
+ */
+TEST_CASE("SyntheticDataDeterminismTest", "[SyntheticDataTest]")
+{
+  arma::mat dataA, dataB, dataC;
+  arma::Row<size_t> labelsA, labelsB, labelsC;
+
+  GaussianClusters(5, 500, 3, 10.0, dataA, labelsA, 7);
+  GaussianClusters(5, 500, 3, 10.0, dataB, labelsB, 7);
+  GaussianClusters(5, 500, 3, 10.0, dataC, labelsC, 8);
+
+  CheckMatrices(dataA, dataB);
+  for (size_t i = 0; i < labelsA.n_elem; ++i)
+    REQUIRE(labelsA[i] == labelsB[i]);
+  REQUIRE(arma::any(arma::vectorise(dataA != dataC)));
+
+  // The output must not depend on the thread budget either.
+  const size_t threads = Parallel::NumThreads();
+  Parallel::NumThreads(1);
+  arma::mat dataSerial;
+  arma::Row<size_t> labelsSerial;
+  GaussianClusters(5, 500, 3, 10.0, dataSerial, labelsSerial, 7);
+  Parallel::NumThreads(threads);
+
+  CheckMatrices(dataA, dataSerial);
+}
+
+/**
+ * Points from EmbeddedManifold() should lie near a low-dimensional subspace:
+ * the singular values past the intrinsic dimensionality should be at the
+ * noise level.
+ */
+TEST_CASE("EmbeddedManifoldTest", "[SyntheticDataTest]")
+{
+  arma::mat data;
+  EmbeddedManifold(3, 30, 1000, 0.01, data, 42);
+
+  REQUIRE(data.n_rows == 30);
+  REQUIRE(data.n_cols == 1000);
+
+  const arma::vec s = arma::svd(data);
+  // The first three singular values carry the manifold; the rest only carry
+  // the noise, orders of magnitude smaller.
+  REQUIRE(s[3] < 0.01 * s[2]);
+}
+
+/**
+ * PowerLawSparse() should produce the requested shape, respect the nonzero
+ * bound per column, leave no empty columns, and produce a skewed density
+ * distribution.
+ */
+TEST_CASE("PowerLawSparseTest", "[SyntheticDataTest]")
+{
+  arma::sp_mat data;
+  PowerLawSparse(1000, 2000, 2.0, 100, data, 42);
+
+  REQUIRE(data.n_rows == 1000);
+  REQUIRE(data.n_cols == 2000);
+  REQUIRE(data.n_nonzero > 0);
+
+  size_t maxNonzeros = 0;
+  for (size_t c = 0; c < data.n_cols; ++c)
+  {
+    const size_t nonzeros = data.col_ptrs[c + 1] - data.col_ptrs[c];
+    REQUIRE(nonzeros >= 1);
+    REQUIRE(nonzeros <= 100);
+    maxNonzeros = std::max(maxNonzeros, nonzeros);
+  }
+
+  // With exponent 2, most columns have a single nonzero but a few are much
+  // denser; the mean density must be well below the maximum.
+  REQUIRE(maxNonzeros > 10 * (data.n_nonzero / data.n_cols));
+}
+
+/**
+ * DriftingStream() labels must be valid, and the class means at the end of
+ * the stream must be displaced by roughly the drift distance from the class
+ * means at the start.
+ */
+TEST_CASE("DriftingStreamTest", "[SyntheticDataTest]")
+{
+  const size_t points = 10000;
+  const double drift = 50.0;
+  arma::mat data;
+  arma::Row<size_t> labels;
+  DriftingStream(8, points, 4, drift, data, labels, 42);
+
+  REQUIRE(data.n_rows == 8);
+  REQUIRE(data.n_cols == points);
+  REQUIRE(labels.max() < 4);
+
+  // Compare per-class means of the first and last tenth of the stream; they
+  // should be separated by roughly 0.9 * drift.
+  for (size_t c = 0; c < 4; ++c)
+  {
+    arma::vec headMean(8, arma::fill::zeros), tailMean(8, arma::fill::zeros);
+    size_t headCount = 0, tailCount = 0;
+    for (size_t i = 0; i < points / 10; ++i)
+    {
+      if (labels[i] == c)
+      {
+        headMean += data.col(i);
+        ++headCount;
+      }
+    }
+    for (size_t i = points - points / 10; i < points; ++i)
+    {
+      if (labels[i] == c)
+      {
+        tailMean += data.col(i);
+        ++tailCount;
+      }
+    }
+    REQUIRE(headCount > 0);
+    REQUIRE(tailCount > 0);
+
+    const double displacement =
+        arma::norm(tailMean / tailCount - headMean / headCount);
+    REQUIRE(displacement == Approx(0.9 * drift).epsilon(0.15));
+  }
+}
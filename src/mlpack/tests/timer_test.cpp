@@ -131,6 +131,133 @@ BOOST_AUTO_TEST_CASE(MultithreadTimerTest)
   BOOST_REQUIRE(Timer::Get("thread_timer") > std::chrono::microseconds(50000));
 }
 
+/**
+ * A scoped timer should stop its timer when it goes out of scope.
+ */
+BOOST_AUTO_TEST_CASE(ScopedTimerTest)
+{
+  Timer::EnableTiming();
+  Timer::ResetAll();
+
+  {
+    MLPACK_SCOPED_TIMER("scoped_timer");
+
+    #ifdef _WIN32
+    Sleep(10);
+    #else
+    usleep(10000);
+    #endif
+  }
+
+  BOOST_REQUIRE_GE(Timer::Get("scoped_timer").count(), 10000);
+
+  // The timer must have been stopped, so stopping it again must throw.
+  BOOST_REQUIRE_THROW(Timer::Stop("scoped_timer"), std::runtime_error);
+
+  Timer::DisableTiming();
+}
+
+/**
+ * Nested scoped timers with the same name should count elapsed time exactly
+ * once, attributed to the outermost scope.
+ */
+BOOST_AUTO_TEST_CASE(NestedScopedTimerTest)
+{
+  Timer::EnableTiming();
+  Timer::ResetAll();
+
+  {
+    MLPACK_SCOPED_TIMER("nested_timer");
+    {
+      MLPACK_SCOPED_TIMER("nested_timer");
+
+      #ifdef _WIN32
+      Sleep(10);
+      #else
+      usleep(10000);
+      #endif
+    }
+
+    // The timer is still running (the outer scope has not ended), so nothing
+    // has been accumulated yet.
+    BOOST_REQUIRE_EQUAL(Timer::Get("nested_timer").count(), 0);
+
+    #ifdef _WIN32
+    Sleep(10);
+    #else
+    usleep(10000);
+    #endif
+  }
+
+  // Both sleeps happened inside the outermost scope, and must be counted
+  // exactly once.
+  BOOST_REQUIRE_GE(Timer::Get("nested_timer").count(), 20000);
+
+  // The outermost scope has ended, so the timer is no longer running.
+  BOOST_REQUIRE_THROW(Timer::Pop("nested_timer"), std::runtime_error);
+
+  Timer::DisableTiming();
+}
+
+/**
+ * Counters should accumulate increments, and ignore them when counting is
+ * disabled.
+ */
+BOOST_AUTO_TEST_CASE(CounterTest)
+{
+  Counter::ResetAll();
+  Counter::EnableCounting();
+
+  BOOST_REQUIRE_EQUAL(Counter::Get("test_counter"), 0);
+
+  Counter::Increment("test_counter");
+  Counter::Increment("test_counter", 41);
+  MLPACK_COUNTER_ADD("test_counter", 8);
+
+  BOOST_REQUIRE_EQUAL(Counter::Get("test_counter"), 50);
+
+  // When counting is disabled, increments must be ignored.
+  Counter::DisableCounting();
+  Counter::Increment("test_counter", 100);
+  BOOST_REQUIRE_EQUAL(Counter::Get("test_counter"), 50);
+
+  Counter::EnableCounting();
+  Counter::ResetAll();
+  BOOST_REQUIRE_EQUAL(Counter::Get("test_counter"), 0);
+  Counter::DisableCounting();
+}
+
+/**
+ * The JSON dump should contain all timers and counters.
+ */
+BOOST_AUTO_TEST_CASE(DumpJSONTest)
+{
+  Timer::EnableTiming();
+  Timer::ResetAll();
+  Counter::EnableCounting();
+  Counter::ResetAll();
+
+  Timer::Start("json_timer");
+  Timer::Stop("json_timer");
+  Counter::Increment("json_counter", 7);
+
+  std::ostringstream stream;
+  Timer::DumpJSON(stream);
+  const std::string dump = stream.str();
+
+  BOOST_REQUIRE(dump.find("\"timers\"") != std::string::npos);
+  BOOST_REQUIRE(dump.find("\"json_timer\":") != std::string::npos);
+  BOOST_REQUIRE(dump.find("\"counters\"") != std::string::npos);
+  BOOST_REQUIRE(dump.find("\"json_counter\": 7") != std::string::npos);
+  BOOST_REQUIRE_EQUAL(dump.front(), '{');
+  BOOST_REQUIRE_EQUAL(dump.back(), '}');
+
+  Counter::ResetAll();
+  Counter::DisableCounting();
+  Timer::ResetAll();
+  Timer::DisableTiming();
+}
+
 BOOST_AUTO_TEST_CASE(DisabledTimingTest)
 {
   // It should be disabled by default but let's be paranoid.
@@ -15,6 +15,7 @@
 #include <mlpack/core/metrics/mahalanobis_distance.hpp>
 #include <mlpack/core/tree/cover_tree/cover_tree.hpp>
 #include <mlpack/core/tree/rectangle_tree.hpp>
+#include <mlpack/core/tree/tree_index_cache.hpp>
 
 #include <queue>
 #include <stack>
@@ -691,6 +692,42 @@ BOOST_AUTO_TEST_CASE(TestBallBound)
   BOOST_REQUIRE_CLOSE(b1.MaxDistance(b2.Center()), 1 + 0.3, 1e-5);
 }
 
+/**
+ * When an HRectBound stores its limits at lower precision than the data, the
+ * narrowing must round outward, so that every point stays covered and
+ * pruning stays correct.
+ */
+BOOST_AUTO_TEST_CASE(HRectBoundLowPrecisionTest)
+{
+  // Large values make the narrowing rounding visible.
+  arma::mat data(5, 500, arma::fill::randn);
+  data *= 1e6;
+
+  HRectBound<EuclideanDistance, float> b(5);
+  b |= data;
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    BOOST_REQUIRE(b.Contains(data.col(i)));
+    BOOST_REQUIRE_SMALL((double) b.MinDistance(data.col(i)), 1e-7);
+  }
+}
+
+/**
+ * A BallBound with a float element type must cover all of the points it is
+ * expanded with.
+ */
+BOOST_AUTO_TEST_CASE(BallBoundLowPrecisionTest)
+{
+  arma::fmat data(5, 500, arma::fill::randn);
+
+  BallBound<EuclideanDistance, float> b;
+  b |= data;
+
+  for (size_t i = 0; i < data.n_cols; ++i)
+    BOOST_REQUIRE_SMALL((double) b.MinDistance(data.col(i)), 1e-3);
+}
+
 BOOST_AUTO_TEST_CASE(BallBoundMoveConstructor)
 {
   BallBound<> b1(2.0, arma::vec("2 1 1"));
@@ -2285,4 +2322,235 @@ BOOST_AUTO_TEST_CASE(CoverTreeDescendantTest)
   CheckDescendants(&tree);
 }
 
+/**
+ * Make sure that rearranging a cover tree's dataset into traversal order
+ * preserves the tree and produces a correct mapping for unmapping results.
+ */
+BOOST_AUTO_TEST_CASE(CoverTreeRearrangeDatasetTest)
+{
+  typedef StandardCoverTree<EuclideanDistance, EmptyStatistic, arma::mat>
+      TreeType;
+
+  arma::mat dataset;
+  dataset.randu(5, 500);
+
+  TreeType tree(dataset);
+
+  std::vector<size_t> oldFromNew;
+  tree.RearrangeDataset(oldFromNew);
+
+  // The mapping must be a permutation of the point indices.
+  BOOST_REQUIRE_EQUAL(oldFromNew.size(), 500);
+  std::vector<size_t> counts(500, 0);
+  for (size_t i = 0; i < 500; ++i)
+    counts[oldFromNew[i]]++;
+  for (size_t i = 0; i < 500; ++i)
+    BOOST_REQUIRE_EQUAL(counts[i], 1);
+
+  // The rearranged dataset must hold the same points, in the mapped order.
+  for (size_t i = 0; i < 500; ++i)
+  {
+    for (size_t j = 0; j < 5; ++j)
+    {
+      BOOST_REQUIRE_CLOSE(tree.Dataset()(j, i), dataset(j, oldFromNew[i]),
+          1e-10);
+    }
+  }
+
+  // The points are now held in traversal order, so the descendants of the
+  // root are exactly 0, 1, ..., 499, in order.
+  for (size_t i = 0; i < 500; ++i)
+    BOOST_REQUIRE_EQUAL(tree.Descendant(i), i);
+
+  // The tree invariants must still hold after the rearrangement.
+  CheckSelfChild<TreeType>(tree);
+  CheckCovering<TreeType, LMetric<2, true>>(tree);
+  CheckDescendants(&tree);
+}
+
+/**
+ * Ensure that a parallel KD-tree build produces exactly the same tree (and
+ * point permutation) as a serial build.
+ */
+BOOST_AUTO_TEST_CASE(KdTreeParallelBuildTest)
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset;
+  dataset.randu(5, 5000);
+
+  std::vector<size_t> serialOldFromNew, parallelOldFromNew;
+  TreeType serialTree(dataset, serialOldFromNew, 20);
+  TreeType parallelTree(dataset, parallelOldFromNew, 20, true);
+
+  // The splits are deterministic, so the permutation must be identical.
+  BOOST_REQUIRE_EQUAL(serialOldFromNew.size(), parallelOldFromNew.size());
+  for (size_t i = 0; i < serialOldFromNew.size(); ++i)
+    BOOST_REQUIRE_EQUAL(serialOldFromNew[i], parallelOldFromNew[i]);
+
+  // The reordered datasets must match too.
+  for (size_t i = 0; i < dataset.n_elem; ++i)
+  {
+    BOOST_REQUIRE_CLOSE(serialTree.Dataset()[i], parallelTree.Dataset()[i],
+        1e-10);
+  }
+}
+
+
+/**
+ * Make sure the packed (flattened) tree reproduces the structure of the
+ * source tree and returns exact nearest neighbors.
+ */
+BOOST_AUTO_TEST_CASE(PackedTreeTest)
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset;
+  dataset.randu(4, 700);
+
+  TreeType tree(dataset, 20);
+  PackedTree<TreeType> packed(tree);
+
+  // The root must span the whole dataset.
+  BOOST_REQUIRE_EQUAL(packed.Begin(0), 0);
+  BOOST_REQUIRE_EQUAL(packed.Count(0), 700);
+
+  // Search for the 3 nearest neighbors of a few query points and check
+  // against brute force over the reordered dataset.
+  for (size_t trial = 0; trial < 10; ++trial)
+  {
+    arma::vec query(4, arma::fill::randu);
+
+    arma::Col<size_t> neighbors;
+    arma::vec distances;
+    packed.Search(query, 3, neighbors, distances);
+
+    arma::vec trueDistances(700);
+    for (size_t i = 0; i < 700; ++i)
+      trueDistances[i] = arma::norm(query - tree.Dataset().col(i));
+    arma::uvec order = arma::sort_index(trueDistances);
+
+    for (size_t j = 0; j < 3; ++j)
+    {
+      BOOST_REQUIRE_EQUAL(neighbors[j], order[j]);
+      BOOST_REQUIRE_CLOSE(distances[j], trueDistances[order[j]], 1e-8);
+    }
+  }
+}
+
+/**
+ * Recursively check that two kd-trees have the same structure.
+ */
+template<typename TreeType>
+void CheckSameStructure(const TreeType& a, const TreeType& b)
+{
+  BOOST_REQUIRE_EQUAL(a.Begin(), b.Begin());
+  BOOST_REQUIRE_EQUAL(a.Count(), b.Count());
+  BOOST_REQUIRE_EQUAL(a.NumChildren(), b.NumChildren());
+
+  BOOST_REQUIRE_EQUAL(a.Bound().Dim(), b.Bound().Dim());
+  for (size_t d = 0; d < a.Bound().Dim(); ++d)
+  {
+    BOOST_REQUIRE_CLOSE(a.Bound()[d].Lo(), b.Bound()[d].Lo(), 1e-8);
+    BOOST_REQUIRE_CLOSE(a.Bound()[d].Hi(), b.Bound()[d].Hi(), 1e-8);
+  }
+
+  BOOST_REQUIRE_EQUAL((a.Left() == NULL), (b.Left() == NULL));
+  BOOST_REQUIRE_EQUAL((a.Right() == NULL), (b.Right() == NULL));
+  if (a.Left())
+    CheckSameStructure(*a.Left(), *b.Left());
+  if (a.Right())
+    CheckSameStructure(*a.Right(), *b.Right());
+}
+
+/**
+ * A tree loaded from the TreeIndexCache must have the same structure as the
+ * tree that was stored, and the attached dataset must be permuted the same
+ * way the original build permuted it.
+ */
+BOOST_AUTO_TEST_CASE(TreeIndexCacheTest)
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(5, 300, arma::fill::randu);
+
+  std::vector<size_t> oldFromNew;
+  TreeType tree(dataset, oldFromNew);
+
+  TreeIndexCache cache(".");
+  const std::string key = TreeIndexCache::Fingerprint(dataset);
+
+  BOOST_REQUIRE(!cache.Has(key));
+  BOOST_REQUIRE(cache.Save(key, tree, oldFromNew));
+  BOOST_REQUIRE(cache.Has(key));
+
+  // Saving must leave the tree's dataset intact.
+  BOOST_REQUIRE_EQUAL(tree.Dataset().n_cols, 300);
+  for (size_t i = 0; i < oldFromNew.size(); ++i)
+  {
+    BOOST_REQUIRE_SMALL(arma::norm(dataset.col(oldFromNew[i]) -
+        tree.Dataset().col(i)), 1e-10);
+  }
+
+  // Load the tree back, attaching the original-order dataset.
+  std::vector<size_t> cachedOldFromNew;
+  TreeType* cached = cache.Load<TreeType>(key, dataset, cachedOldFromNew);
+  BOOST_REQUIRE(cached != NULL);
+
+  BOOST_REQUIRE_EQUAL(cachedOldFromNew.size(), oldFromNew.size());
+  for (size_t i = 0; i < oldFromNew.size(); ++i)
+    BOOST_REQUIRE_EQUAL(cachedOldFromNew[i], oldFromNew[i]);
+
+  CheckSameStructure(tree, *cached);
+
+  // The attached dataset must match the one the original build produced.
+  BOOST_REQUIRE_EQUAL(cached->Dataset().n_cols, 300);
+  for (size_t i = 0; i < 300; ++i)
+  {
+    BOOST_REQUIRE_SMALL(arma::norm(tree.Dataset().col(i) -
+        cached->Dataset().col(i)), 1e-10);
+  }
+
+  delete cached;
+  remove((key + ".tree").c_str());
+}
+
+/**
+ * A lookup under an unknown key, or with a dataset of the wrong size, must
+ * miss; and the fingerprint must change when the data changes.
+ */
+BOOST_AUTO_TEST_CASE(TreeIndexCacheMissTest)
+{
+  typedef KDTree<EuclideanDistance, EmptyStatistic, arma::mat> TreeType;
+
+  arma::mat dataset(3, 100, arma::fill::randu);
+
+  std::vector<size_t> oldFromNew;
+  TreeType tree(dataset, oldFromNew);
+
+  TreeIndexCache cache(".");
+  const std::string key = TreeIndexCache::Fingerprint(dataset);
+  BOOST_REQUIRE(cache.Save(key, tree, oldFromNew));
+
+  // Unknown key: miss.
+  std::vector<size_t> cachedOldFromNew;
+  BOOST_REQUIRE(cache.Load<TreeType>("no-such-key", dataset,
+      cachedOldFromNew) == NULL);
+
+  // Dataset with a different number of points: stale entry, miss.
+  arma::mat smaller(3, 50, arma::fill::randu);
+  BOOST_REQUIRE(cache.Load<TreeType>(key, smaller, cachedOldFromNew) == NULL);
+
+  // Changing a single element must change the fingerprint.
+  arma::mat modified(dataset);
+  modified(0, 0) += 1.0;
+  BOOST_REQUIRE_NE(TreeIndexCache::Fingerprint(modified), key);
+
+  // Identical contents must give identical fingerprints.
+  arma::mat copy(dataset);
+  BOOST_REQUIRE_EQUAL(TreeIndexCache::Fingerprint(copy), key);
+
+  remove((key + ".tree").c_str());
+}
+
 BOOST_AUTO_TEST_SUITE_END();